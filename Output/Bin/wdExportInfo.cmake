@@ -1,5 +1,5 @@
 
-set(EXPINP_OUTPUT_DIRECTORY_DLL D:/HMachine/Output/Bin)
-set(EXPINP_OUTPUT_DIRECTORY_LIB D:/HMachine/Output/Lib)
-set(EXPINP_BINARY_DIR D:/HMachine/sln)
-set(EXPINP_SOURCE_DIR D:/HMachine)
+set(EXPINP_OUTPUT_DIRECTORY_DLL /root/repo/Output/Bin)
+set(EXPINP_OUTPUT_DIRECTORY_LIB /root/repo/Output/Lib)
+set(EXPINP_BINARY_DIR /tmp/_gate_build)
+set(EXPINP_SOURCE_DIR /root/repo)
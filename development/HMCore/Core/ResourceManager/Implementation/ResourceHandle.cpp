@@ -1,6 +1,7 @@
 #include <Core/CorePCH.h>
 
 #include <Core/ResourceManager/Resource.h>
+#include <Core/ResourceManager/ResourceHandleReadContext.h>
 
 wdTypelessResourceHandle::wdTypelessResourceHandle(wdResource* pResource)
 {
@@ -103,7 +104,16 @@ void wdResourceHandleStreamOperations::ReadHandle(wdStreamReader& Stream, wdType
 
   if (pRtti != nullptr)
   {
-    ResourceHandle = wdResourceManager::LoadResourceByType(pRtti, sTemp);
+    if (wdResourceHandleReadContext* pContext = wdResourceHandleReadContext::GetContext())
+    {
+      // the resource is requested later on a thread that may access the resource manager
+      ResourceHandle.Invalidate();
+      pContext->RecordHandle(&ResourceHandle, pRtti, sTemp);
+    }
+    else
+    {
+      ResourceHandle = wdResourceManager::LoadResourceByType(pRtti, sTemp);
+    }
   }
 }
 
@@ -0,0 +1,43 @@
+#include <Core/CorePCH.h>
+
+#include <Core/ResourceManager/ResourceHandleReadContext.h>
+#include <Core/ResourceManager/ResourceManager.h>
+
+WD_IMPLEMENT_SERIALIZATION_CONTEXT(wdResourceHandleReadContext)
+
+wdResourceHandleReadContext::wdResourceHandleReadContext() = default;
+
+wdResourceHandleReadContext::~wdResourceHandleReadContext()
+{
+  WD_ASSERT_DEV(m_PendingHandles.IsEmpty(), "{0} resource handles were read but never resolved", m_PendingHandles.GetCount());
+}
+
+void wdResourceHandleReadContext::ResolveHandles()
+{
+  WD_LOCK(m_Mutex);
+
+  for (PendingHandle& pending : m_PendingHandles)
+  {
+    *pending.m_pHandle = wdResourceManager::LoadResourceByType(pending.m_pResourceType, pending.m_sResourceID);
+  }
+
+  m_PendingHandles.Clear();
+}
+
+wdUInt32 wdResourceHandleReadContext::GetNumPendingHandles() const
+{
+  WD_LOCK(m_Mutex);
+  return m_PendingHandles.GetCount();
+}
+
+void wdResourceHandleReadContext::RecordHandle(wdTypelessResourceHandle* pHandle, const wdRTTI* pResourceType, wdStringView sResourceID)
+{
+  WD_LOCK(m_Mutex);
+
+  PendingHandle& pending = m_PendingHandles.ExpandAndGetRef();
+  pending.m_pHandle = pHandle;
+  pending.m_pResourceType = pResourceType;
+  pending.m_sResourceID = sResourceID;
+}
+
+WD_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceHandleReadContext);
@@ -128,29 +128,6 @@ void wdResourceManager::RunWorkerTask(wdResource* pResource)
   }
 }
 
-void wdResourceManager::ReverseBubbleSortStep(wdDeque<LoadingInfo>& data)
-{
-  // Yep, it's really bubble sort!
-  // This will move the entry with the smallest value to the front and move all other values closer to their correct position,
-  // which is exactly what we need for the priority queue.
-  // We do this once a frame, which gives us nice iterative sorting, with relatively deterministic performance characteristics.
-
-  WD_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "Calling code must acquire s_ResourceMutex");
-
-  const wdUInt32 uiCount = data.GetCount();
-
-  for (wdUInt32 i = uiCount; i > 1; --i)
-  {
-    const wdUInt32 idx2 = i - 1;
-    const wdUInt32 idx1 = i - 2;
-
-    if (data[idx1].m_fPriority > data[idx2].m_fPriority)
-    {
-      wdMath::Swap(data[idx1], data[idx2]);
-    }
-  }
-}
-
 void wdResourceManager::UpdateLoadingDeadlines()
 {
   if (s_pState->m_LoadingQueue.IsEmpty())
@@ -160,36 +137,32 @@ void wdResourceManager::UpdateLoadingDeadlines()
 
   WD_PROFILE_SCOPE("UpdateLoadingDeadlines");
 
-  const wdUInt32 uiCount = s_pState->m_LoadingQueue.GetCount();
-  s_pState->m_uiLastResourcePriorityUpdateIdx = wdMath::Min(s_pState->m_uiLastResourcePriorityUpdateIdx, uiCount);
+  wdResourceLoadingQueue& queue = s_pState->m_LoadingQueue;
 
-  wdUInt32 uiUpdateCount = wdMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
+  const wdUInt32 uiCount = queue.GetHeapCount();
+  if (s_pState->m_uiLastResourcePriorityUpdateIdx >= uiCount)
+    s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
+
+  const wdUInt32 uiUpdateCount = wdMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
 
   if (uiUpdateCount == 0)
-  {
-    s_pState->m_uiLastResourcePriorityUpdateIdx = 0;
-    uiUpdateCount = wdMath::Min(50u, uiCount - s_pState->m_uiLastResourcePriorityUpdateIdx);
-  }
+    return;
 
-  if (uiUpdateCount > 0)
+  // Updating a priority moves the entry within the heap, so collect the resources first.
+  // Entries may be visited twice or skipped in one round this way, which is fine, since this only refreshes the priorities over time.
+  wdHybridArray<wdResource*, 50> resources;
+  for (wdUInt32 i = 0; i < uiUpdateCount; ++i)
   {
-    {
-      WD_PROFILE_SCOPE("EvalLoadingDeadlines");
+    resources.PushBack(queue.GetHeapEntry(s_pState->m_uiLastResourcePriorityUpdateIdx + i));
+  }
 
-      const wdTime tNow = wdTime::Now();
+  s_pState->m_uiLastResourcePriorityUpdateIdx += uiUpdateCount;
 
-      for (wdUInt32 i = 0; i < uiUpdateCount; ++i)
-      {
-        auto& element = s_pState->m_LoadingQueue[s_pState->m_uiLastResourcePriorityUpdateIdx];
-        element.m_fPriority = element.m_pResource->GetLoadingPriority(tNow);
-        ++s_pState->m_uiLastResourcePriorityUpdateIdx;
-      }
-    }
+  const wdTime tNow = wdTime::Now();
 
-    {
-      WD_PROFILE_SCOPE("SortLoadingDeadlines");
-      ReverseBubbleSortStep(s_pState->m_LoadingQueue);
-    }
+  for (wdResource* pResource : resources)
+  {
+    queue.UpdatePriority(pResource, pResource->GetLoadingPriority(tNow));
   }
 }
 
@@ -221,10 +194,7 @@ wdResult wdResourceManager::RemoveFromLoadingQueue(wdResource* pResource)
   if (!IsQueuedForLoading(pResource))
     return WD_SUCCESS;
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
-  if (s_pState->m_LoadingQueue.RemoveAndSwap(li))
+  if (s_pState->m_LoadingQueue.Remove(pResource))
   {
     pResource->m_Flags.Remove(wdResourceFlags::IsQueuedForLoading);
     return WD_SUCCESS;
@@ -240,19 +210,14 @@ void wdResourceManager::AddToLoadingQueue(wdResource* pResource, bool bHighestPr
 
   pResource->m_Flags.Add(wdResourceFlags::IsQueuedForLoading);
 
-  LoadingInfo li;
-  li.m_pResource = pResource;
-
   if (bHighestPriority)
   {
     pResource->SetPriority(wdResourcePriority::Critical);
-    li.m_fPriority = 0.0f;
-    s_pState->m_LoadingQueue.PushFront(li);
+    s_pState->m_LoadingQueue.Push(pResource, 0.0f, true, wdTime::Now());
   }
   else
   {
-    li.m_fPriority = pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate);
-    s_pState->m_LoadingQueue.PushBack(li);
+    s_pState->m_LoadingQueue.Push(pResource, pResource->GetLoadingPriority(s_pState->m_LastFrameUpdate), false, wdTime::Now());
   }
 }
 
@@ -285,10 +250,7 @@ bool wdResourceManager::ReloadResource(wdResource* pResource, bool bForce)
   {
     bAllowPreloading = false;
 
-    LoadingInfo li;
-    li.m_pResource = pResource;
-
-    if (s_pState->m_LoadingQueue.IndexOf(li) == wdInvalidIndex)
+    if (!s_pState->m_LoadingQueue.Contains(pResource))
     {
       // the resource is marked as 'loading' but it is not in the queue anymore
       // that means some task is already working on loading it
@@ -0,0 +1,267 @@
+#include <Core/CorePCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
+#include <Foundation/Utilities/Stats.h>
+
+wdResourceLoadingQueue::wdResourceLoadingQueue() = default;
+wdResourceLoadingQueue::~wdResourceLoadingQueue() = default;
+
+void wdResourceLoadingQueue::Push(wdResource* pResource, float fPriority, bool bFirstInLine, wdTime now)
+{
+  WD_ASSERT_DEV(!Contains(pResource), "Resource is already in the loading queue");
+
+  Entry entry;
+  entry.m_fPriority = fPriority;
+  entry.m_iSequence = bFirstInLine ? m_iNextFirstInLineSequence-- : m_iNextSequence++;
+  entry.m_pResource = pResource;
+  entry.m_QueuedTime = now;
+
+  PushEntry(entry);
+}
+
+bool wdResourceLoadingQueue::Remove(wdResource* pResource)
+{
+  const wdUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+
+  if (uiIndex == wdInvalidIndex)
+    return false;
+
+  if (uiIndex == OverBudgetIndex)
+  {
+    for (wdUInt32 i = 0; i < m_OverBudget.GetCount(); ++i)
+    {
+      if (m_OverBudget[i].m_pResource == pResource)
+      {
+        m_OverBudget.RemoveAtAndSwap(i);
+        break;
+      }
+    }
+  }
+  else
+  {
+    RemoveAt(uiIndex);
+  }
+
+  pResource->m_uiLoadingQueueIndex = wdInvalidIndex;
+  m_bStatsChanged = true;
+  return true;
+}
+
+void wdResourceLoadingQueue::UpdatePriority(wdResource* pResource, float fPriority)
+{
+  const wdUInt32 uiIndex = pResource->m_uiLoadingQueueIndex;
+  WD_ASSERT_DEV(uiIndex != wdInvalidIndex, "Resource is not in the loading queue");
+
+  if (uiIndex == OverBudgetIndex)
+  {
+    for (Entry& entry : m_OverBudget)
+    {
+      if (entry.m_pResource == pResource)
+      {
+        entry.m_fPriority = fPriority;
+        break;
+      }
+    }
+
+    return;
+  }
+
+  const float fOldPriority = m_Heap[uiIndex].m_fPriority;
+  m_Heap[uiIndex].m_fPriority = fPriority;
+
+  if (fPriority < fOldPriority)
+    SiftUp(uiIndex);
+  else if (fPriority > fOldPriority)
+    SiftDown(uiIndex);
+}
+
+wdResource* wdResourceLoadingQueue::Pop(wdTime now)
+{
+  while (!m_Heap.IsEmpty())
+  {
+    Entry entry = RemoveAt(0);
+
+    // resources that someone explicitly waits for are never held back
+    const bool bFirstInLine = entry.m_iSequence < 0;
+
+    TypeBudget* pBudget = nullptr;
+    if (!bFirstInLine && m_TypeBudgets.TryGetValue(entry.m_pResource->GetDynamicRTTI(), pBudget) && pBudget->m_uiMaxLoadsPerFrame > 0)
+    {
+      if (pBudget->m_uiLoadsThisFrame >= pBudget->m_uiMaxLoadsPerFrame)
+      {
+        entry.m_pResource->m_uiLoadingQueueIndex = OverBudgetIndex;
+        m_OverBudget.PushBack(entry);
+        continue;
+      }
+
+      ++pBudget->m_uiLoadsThisFrame;
+    }
+
+    entry.m_pResource->m_uiLoadingQueueIndex = wdInvalidIndex;
+
+    m_TimeInQueueSamples[m_uiNextTimeInQueueSample] = (float)(now - entry.m_QueuedTime).GetMilliseconds();
+    m_uiNextTimeInQueueSample = (m_uiNextTimeInQueueSample + 1) % NumTimeInQueueSamples;
+    m_uiNumTimeInQueueSamples = wdMath::Min(m_uiNumTimeInQueueSamples + 1, NumTimeInQueueSamples);
+    m_bStatsChanged = true;
+
+    return entry.m_pResource;
+  }
+
+  return nullptr;
+}
+
+void wdResourceLoadingQueue::Clear()
+{
+  for (const Entry& entry : m_Heap)
+  {
+    entry.m_pResource->m_uiLoadingQueueIndex = wdInvalidIndex;
+    entry.m_pResource->m_Flags.Remove(wdResourceFlags::IsQueuedForLoading);
+  }
+
+  for (const Entry& entry : m_OverBudget)
+  {
+    entry.m_pResource->m_uiLoadingQueueIndex = wdInvalidIndex;
+    entry.m_pResource->m_Flags.Remove(wdResourceFlags::IsQueuedForLoading);
+  }
+
+  m_Heap.Clear();
+  m_OverBudget.Clear();
+  m_bStatsChanged = true;
+}
+
+void wdResourceLoadingQueue::SetTypeBudget(const wdRTTI* pResourceType, wdUInt32 uiMaxLoadsPerFrame)
+{
+  m_TypeBudgets[pResourceType].m_uiMaxLoadsPerFrame = uiMaxLoadsPerFrame;
+}
+
+bool wdResourceLoadingQueue::StartNewFrame()
+{
+  for (auto it = m_TypeBudgets.GetIterator(); it.IsValid(); ++it)
+  {
+    it.Value().m_uiLoadsThisFrame = 0;
+  }
+
+  if (m_OverBudget.IsEmpty())
+    return false;
+
+  for (const Entry& entry : m_OverBudget)
+  {
+    PushEntry(entry);
+  }
+
+  m_OverBudget.Clear();
+  return true;
+}
+
+void wdResourceLoadingQueue::UpdateStats()
+{
+  if (!m_bStatsChanged)
+    return;
+
+  m_bStatsChanged = false;
+
+  wdStats::SetStat("ResourceManager/Loading Queue/Queued", GetCount());
+  wdStats::SetStat("ResourceManager/Loading Queue/Over Budget", m_OverBudget.GetCount());
+
+  if (m_uiNumTimeInQueueSamples == 0)
+    return;
+
+  float sortedSamples[NumTimeInQueueSamples];
+  wdMemoryUtils::Copy(sortedSamples, m_TimeInQueueSamples, m_uiNumTimeInQueueSamples);
+
+  wdArrayPtr<float> samples(sortedSamples, m_uiNumTimeInQueueSamples);
+  wdSorting::QuickSort(samples, wdCompareHelper<float>());
+
+  auto GetPercentile = [&](wdUInt32 uiPercent) { return samples[(samples.GetCount() - 1) * uiPercent / 100]; };
+
+  wdStats::SetStat("ResourceManager/Loading Queue/Time In Queue P50 (ms)", GetPercentile(50));
+  wdStats::SetStat("ResourceManager/Loading Queue/Time In Queue P90 (ms)", GetPercentile(90));
+  wdStats::SetStat("ResourceManager/Loading Queue/Time In Queue P99 (ms)", GetPercentile(99));
+}
+
+void wdResourceLoadingQueue::PushEntry(const Entry& entry)
+{
+  m_Heap.PushBack(entry);
+  entry.m_pResource->m_uiLoadingQueueIndex = m_Heap.GetCount() - 1;
+  SiftUp(m_Heap.GetCount() - 1);
+
+  m_bStatsChanged = true;
+}
+
+wdResourceLoadingQueue::Entry wdResourceLoadingQueue::RemoveAt(wdUInt32 uiIndex)
+{
+  const Entry removed = m_Heap[uiIndex];
+  const wdUInt32 uiLastIndex = m_Heap.GetCount() - 1;
+
+  if (uiIndex != uiLastIndex)
+  {
+    const Entry last = m_Heap[uiLastIndex];
+    m_Heap.PopBack();
+    SetEntry(uiIndex, last);
+
+    // the moved entry may need to go either way
+    if (uiIndex > 0 && last < m_Heap[(uiIndex - 1) / 2])
+      SiftUp(uiIndex);
+    else
+      SiftDown(uiIndex);
+  }
+  else
+  {
+    m_Heap.PopBack();
+  }
+
+  removed.m_pResource->m_uiLoadingQueueIndex = wdInvalidIndex;
+  return removed;
+}
+
+void wdResourceLoadingQueue::SiftUp(wdUInt32 uiIndex)
+{
+  const Entry entry = m_Heap[uiIndex];
+
+  while (uiIndex > 0)
+  {
+    const wdUInt32 uiParent = (uiIndex - 1) / 2;
+
+    if (!(entry < m_Heap[uiParent]))
+      break;
+
+    SetEntry(uiIndex, m_Heap[uiParent]);
+    uiIndex = uiParent;
+  }
+
+  SetEntry(uiIndex, entry);
+}
+
+void wdResourceLoadingQueue::SiftDown(wdUInt32 uiIndex)
+{
+  const Entry entry = m_Heap[uiIndex];
+  const wdUInt32 uiCount = m_Heap.GetCount();
+
+  while (true)
+  {
+    wdUInt32 uiChild = uiIndex * 2 + 1;
+
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && m_Heap[uiChild + 1] < m_Heap[uiChild])
+      ++uiChild;
+
+    if (!(m_Heap[uiChild] < entry))
+      break;
+
+    SetEntry(uiIndex, m_Heap[uiChild]);
+    uiIndex = uiChild;
+  }
+
+  SetEntry(uiIndex, entry);
+}
+
+void wdResourceLoadingQueue::SetEntry(wdUInt32 uiIndex, const Entry& entry)
+{
+  m_Heap[uiIndex] = entry;
+  entry.m_pResource->m_uiLoadingQueueIndex = uiIndex;
+}
+
+
+WD_STATICLINK_FILE(Core, Core_ResourceManager_Implementation_ResourceLoadingQueue);
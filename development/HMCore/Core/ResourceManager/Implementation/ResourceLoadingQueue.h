@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Core/ResourceManager/Resource.h>
+#include <Foundation/Containers/HashTable.h>
+
+/// \brief [internal] The queue of resources that wait for a data load task.
+///
+/// Implemented as a binary min-heap, ordered by loading priority (lower values get loaded first) and then by the order in which the
+/// resources were queued. Every resource stores its own position in the heap, so that removing it or changing its priority is O(log n).
+///
+/// Additionally a budget can be set per resource type, which limits how many resources of that type are taken from the queue per frame.
+/// Resources that are over budget are put aside until the next call to StartNewFrame(). Resources that were queued with highest priority
+/// ignore the budget.
+///
+/// The queue is not thread-safe, the resource manager only accesses its queue with wdResourceManager::s_ResourceMutex locked.
+/// Only the resource manager uses this class, it is exported for the unit tests.
+class WD_CORE_DLL wdResourceLoadingQueue
+{
+public:
+  wdResourceLoadingQueue();
+  ~wdResourceLoadingQueue();
+
+  /// \brief Returns the number of queued resources, including the ones that are currently over budget.
+  wdUInt32 GetCount() const { return m_Heap.GetCount() + m_OverBudget.GetCount(); }
+
+  /// \brief Returns whether no resource is queued at all.
+  bool IsEmpty() const { return GetCount() == 0; }
+
+  /// \brief Returns whether the given resource is in the queue and has not been taken out by a data load task yet.
+  bool Contains(const wdResource* pResource) const { return pResource->m_uiLoadingQueueIndex != wdInvalidIndex; }
+
+  /// \brief Adds the resource with the given priority. If bFirstInLine is set, it will be taken before all other resources of the same
+  /// priority, even ones that were also queued with bFirstInLine before.
+  void Push(wdResource* pResource, float fPriority, bool bFirstInLine, wdTime now);
+
+  /// \brief Removes the resource from the queue. Returns false, if it was not queued.
+  bool Remove(wdResource* pResource);
+
+  /// \brief Changes the priority of an already queued resource and moves it to its new position.
+  void UpdatePriority(wdResource* pResource, float fPriority);
+
+  /// \brief Removes and returns the resource with the lowest priority value, whose type is still within its budget for this frame.
+  ///
+  /// Returns nullptr, if there is no such resource.
+  wdResource* Pop(wdTime now);
+
+  /// \brief Returns the resource at the given position in the heap. Used to re-evaluate the priorities incrementally.
+  wdResource* GetHeapEntry(wdUInt32 uiIndex) const { return m_Heap[uiIndex].m_pResource; }
+  wdUInt32 GetHeapCount() const { return m_Heap.GetCount(); }
+
+  /// \brief Removes all resources from the queue and clears their IsQueuedForLoading flag.
+  void Clear();
+
+  /// \brief Limits how many resources of exactly this type may be taken from the queue per frame. Zero means no limit.
+  void SetTypeBudget(const wdRTTI* pResourceType, wdUInt32 uiMaxLoadsPerFrame);
+
+  /// \brief Resets the per-type budgets and puts all resources that were over budget back into the queue.
+  ///
+  /// Returns true, if any resources were put back.
+  bool StartNewFrame();
+
+  /// \brief Publishes the queue depth and the time resources spent in the queue (percentiles over the last loads) through wdStats.
+  void UpdateStats();
+
+private:
+  struct Entry
+  {
+    float m_fPriority;
+    wdInt64 m_iSequence;
+    wdResource* m_pResource;
+    wdTime m_QueuedTime;
+
+    WD_ALWAYS_INLINE bool operator<(const Entry& rhs) const
+    {
+      if (m_fPriority != rhs.m_fPriority)
+        return m_fPriority < rhs.m_fPriority;
+
+      return m_iSequence < rhs.m_iSequence;
+    }
+  };
+
+  struct TypeBudget
+  {
+    wdUInt32 m_uiMaxLoadsPerFrame = 0;
+    wdUInt32 m_uiLoadsThisFrame = 0;
+  };
+
+  // stored in wdResource::m_uiLoadingQueueIndex for resources in m_OverBudget
+  static constexpr wdUInt32 OverBudgetIndex = wdInvalidIndex - 1;
+
+  void PushEntry(const Entry& entry);
+  Entry RemoveAt(wdUInt32 uiIndex);
+  void SiftUp(wdUInt32 uiIndex);
+  void SiftDown(wdUInt32 uiIndex);
+  void SetEntry(wdUInt32 uiIndex, const Entry& entry);
+
+  wdDynamicArray<Entry> m_Heap;
+  wdDynamicArray<Entry> m_OverBudget;
+  wdHashTable<const wdRTTI*, TypeBudget> m_TypeBudgets;
+
+  wdInt64 m_iNextSequence = 0;
+  wdInt64 m_iNextFirstInLineSequence = -1;
+
+  // ring buffer of the most recent times that resources spent in the queue, in milliseconds
+  static constexpr wdUInt32 NumTimeInQueueSamples = 256;
+  float m_TimeInQueueSamples[NumTimeInQueueSamples];
+  wdUInt32 m_uiNumTimeInQueueSamples = 0;
+  wdUInt32 m_uiNextTimeInQueueSample = 0;
+  bool m_bStatsChanged = true;
+};
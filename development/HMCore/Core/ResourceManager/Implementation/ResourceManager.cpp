@@ -109,6 +109,12 @@ void wdResourceManager::ExecuteAllResourceCleanupCallbacks()
   WD_ASSERT_DEV(s_pState->m_ResourceCleanupCallbacks.IsEmpty(), "During resource cleanup, new resource cleanup callbacks were registered.");
 }
 
+void wdResourceManager::SetResourceTypeLoadingBudget(const wdRTTI* pResourceType, wdUInt32 uiMaxLoadsPerFrame)
+{
+  WD_LOCK(s_ResourceMutex);
+  s_pState->m_LoadingQueue.SetTypeBudget(pResourceType, uiMaxLoadsPerFrame);
+}
+
 wdMap<const wdRTTI*, wdResourcePriority>& wdResourceManager::GetResourceTypePriorities()
 {
   return s_pState->m_ResourceTypePriorities;
@@ -498,6 +504,18 @@ void wdResourceManager::PerFrameUpdate()
     s_pState->m_ResourcesToUnloadOnMainThread.Clear();
   }
 
+  {
+    WD_LOCK(s_ResourceMutex);
+
+    // resources that were over their type budget last frame are available again
+    if (s_pState->m_LoadingQueue.StartNewFrame())
+    {
+      RunWorkerTask(nullptr);
+    }
+
+    s_pState->m_LoadingQueue.UpdateStats();
+  }
+
   if (s_pState->m_AutoFreeUnusedTimeout.IsPositive())
   {
     FreeUnusedResources(s_pState->m_AutoFreeUnusedTimeout, s_pState->m_AutoFreeUnusedThreshold);
@@ -575,11 +593,6 @@ void wdResourceManager::EngineAboutToShutdown()
   {
     WD_LOCK(s_ResourceMutex);
 
-    for (auto entry : s_pState->m_LoadingQueue)
-    {
-      entry.m_pResource->m_Flags.Remove(wdResourceFlags::IsQueuedForLoading);
-    }
-
     s_pState->m_LoadingQueue.Clear();
 
     // Since we just canceled all loading tasks above and cleared the loading queue,
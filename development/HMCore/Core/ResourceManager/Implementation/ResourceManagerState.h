@@ -3,6 +3,7 @@
 #include <Core/CoreInternal.h>
 WD_CORE_INTERNAL_HEADER
 
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
 #include <Core/ResourceManager/ResourceManager.h>
 
 class wdResourceManagerState
@@ -51,7 +52,7 @@ private:
   wdUInt32 m_uiForceNoFallbackAcquisition = 0;
 
   // resources in this queue are waiting for a task to load them
-  wdDeque<wdResourceManager::LoadingInfo> m_LoadingQueue;
+  wdResourceLoadingQueue m_LoadingQueue;
 
   wdHashTable<const wdRTTI*, wdResourceManager::LoadedResources> m_LoadedResources;
 
@@ -2,17 +2,42 @@
 
 #include <Core/ResourceManager/Resource.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
-#include <Foundation/Containers/Blob.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/MappedFileContent.h>
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
-struct FileResourceLoadData
+namespace
 {
-  wdBlob m_Storage;
-  wdRawMemoryStreamReader m_Reader;
-};
+  /// \brief Reads the small header that the loader writes in front of the file, followed by the file content, which is not copied.
+  class FileResourceStreamReader : public wdStreamReader
+  {
+  public:
+    virtual wdUInt64 ReadBytes(void* pReadBuffer, wdUInt64 uiBytesToRead) override
+    {
+      const wdUInt64 uiHeaderBytes = m_Header.ReadBytes(pReadBuffer, uiBytesToRead);
+      wdUInt8* pContentBuffer = pReadBuffer != nullptr ? static_cast<wdUInt8*>(pReadBuffer) + uiHeaderBytes : nullptr;
+      return uiHeaderBytes + m_Content.ReadBytes(pContentBuffer, uiBytesToRead - uiHeaderBytes);
+    }
+
+    virtual wdUInt64 SkipBytes(wdUInt64 uiBytesToSkip) override
+    {
+      const wdUInt64 uiHeaderBytes = m_Header.SkipBytes(uiBytesToSkip);
+      return uiHeaderBytes + m_Content.SkipBytes(uiBytesToSkip - uiHeaderBytes);
+    }
+
+    wdRawMemoryStreamReader m_Header;
+    wdRawMemoryStreamReader m_Content;
+  };
+
+  struct FileResourceLoadData
+  {
+    wdMappedFileContent m_File;
+    wdHybridArray<wdUInt8, 256> m_Header;
+    FileResourceStreamReader m_Reader;
+  };
+} // namespace
 
 wdResourceLoadData wdResourceLoaderFromFile::OpenDataStream(const wdResource* pResource)
 {
@@ -20,11 +45,16 @@ wdResourceLoadData wdResourceLoaderFromFile::OpenDataStream(const wdResource* pR
 
   wdResourceLoadData res;
 
-  wdFileReader File;
-  if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  FileResourceLoadData* pData = WD_DEFAULT_NEW(FileResourceLoadData);
+
+  // the file is mapped into memory if possible, so it is neither copied nor held in memory twice while the resource reads it
+  if (pData->m_File.Open(pResource->GetResourceID()).Failed())
+  {
+    WD_DEFAULT_DELETE(pData);
     return res;
+  }
 
-  res.m_sResourceDescription = File.GetFilePathRelative().GetData();
+  res.m_sResourceDescription = pData->m_File.GetFilePathRelative();
 
 #if WD_ENABLED(WD_SUPPORTS_FILE_STATS)
   wdFileStats stat;
@@ -35,25 +65,16 @@ wdResourceLoadData wdResourceLoaderFromFile::OpenDataStream(const wdResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = WD_DEFAULT_NEW(FileResourceLoadData);
-
-  const wdUInt64 uiFileSize = File.GetFileSize();
-
-  const wdUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
-  pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
-
-  wdUInt8* pBlobPtr = pData->m_Storage.GetBlobPtr<wdUInt8>().GetPtr();
-
-  wdRawMemoryStreamWriter w(pBlobPtr, uiBlobCapacity);
-
-  // write the absolute path to the read file into the memory stream
-  w << File.GetFilePathAbsolute();
-
-  const wdUInt64 uiOffset = w.GetNumWrittenBytes();
+  // write the absolute path to the read file in front of the file content
+  {
+    wdMemoryStreamContainerWrapperStorage<wdHybridArray<wdUInt8, 256>> storage(&pData->m_Header);
+    wdMemoryStreamWriter w(&storage);
+    w << pData->m_File.GetFilePathAbsolute();
+  }
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  pData->m_Reader.m_Header.Reset(pData->m_Header);
+  pData->m_Reader.m_Content.Reset(pData->m_File.GetData().GetPtr(), pData->m_File.GetData().GetCount());
 
-  pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
   res.m_pDataStream = &pData->m_Reader;
   res.m_pCustomLoaderData = pData;
 
@@ -19,18 +19,17 @@ void wdResourceManagerWorkerDataLoad::Execute()
   {
     WD_LOCK(wdResourceManager::s_ResourceMutex);
 
-    if (wdResourceManager::s_pState->m_LoadingQueue.IsEmpty())
+    wdResourceManager::UpdateLoadingDeadlines();
+
+    pResourceToLoad = wdResourceManager::s_pState->m_LoadingQueue.Pop(wdTime::Now());
+
+    // either the queue is empty or all remaining resources are over their type budget for this frame
+    if (pResourceToLoad == nullptr)
     {
       wdResourceManager::s_pState->m_bAllowLaunchDataLoadTask = true;
       return;
     }
 
-    wdResourceManager::UpdateLoadingDeadlines();
-
-    auto it = wdResourceManager::s_pState->m_LoadingQueue.PeekFront();
-    pResourceToLoad = it.m_pResource;
-    wdResourceManager::s_pState->m_LoadingQueue.PopFront();
-
     if (pResourceToLoad->m_Flags.IsSet(wdResourceFlags::HasCustomDataLoader))
     {
       pCustomLoader = std::move(wdResourceManager::s_pState->m_CustomLoaders[pResourceToLoad]);
@@ -163,8 +163,13 @@ private:
   virtual wdResourceTypeLoader* GetDefaultResourceTypeLoader() const;
 
 private:
+  friend class wdResourceLoadingQueue;
+
   volatile wdResourceState m_LoadingState = wdResourceState::Unloaded;
 
+  /// Position in the resource manager's loading queue, wdInvalidIndex if the resource is not waiting to be loaded.
+  wdUInt32 m_uiLoadingQueueIndex = wdInvalidIndex;
+
   wdUInt8 m_uiQualityLevelsDiscardable = 0;
   wdUInt8 m_uiQualityLevelsLoadable = 0;
 
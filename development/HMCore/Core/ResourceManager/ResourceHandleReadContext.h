@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Core/ResourceManager/ResourceHandle.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/SerializationContext.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief While this context is active on a thread, resource handles that are read from a stream on that thread are only recorded.
+///
+/// The handles stay invalid until ResolveHandles() requests all recorded resources from the resource manager at once.
+/// This allows to read resource handles on threads that must not access the resource manager, e.g. when wdWorldReader deserializes
+/// components in parallel. The same context may be active on several threads at the same time.
+///
+/// The recorded handles must neither be used nor moved in memory until ResolveHandles() has been called.
+class WD_CORE_DLL wdResourceHandleReadContext : public wdSerializationContext<wdResourceHandleReadContext>
+{
+  WD_DECLARE_SERIALIZATION_CONTEXT(wdResourceHandleReadContext);
+
+public:
+  /// \brief Like all serialization contexts, the context is active on the creating thread after construction.
+  wdResourceHandleReadContext();
+  ~wdResourceHandleReadContext();
+
+  /// \brief Requests the recorded resources and stores them in their handles. Must be called on a thread that may access the resource manager.
+  void ResolveHandles();
+
+  /// \brief Returns how many handles were recorded since the last call to ResolveHandles().
+  wdUInt32 GetNumPendingHandles() const;
+
+private:
+  friend class wdResourceHandleStreamOperations;
+
+  void RecordHandle(wdTypelessResourceHandle* pHandle, const wdRTTI* pResourceType, wdStringView sResourceID);
+
+  struct PendingHandle
+  {
+    wdTypelessResourceHandle* m_pHandle = nullptr;
+    const wdRTTI* m_pResourceType = nullptr;
+    wdString m_sResourceID;
+  };
+
+  mutable wdMutex m_Mutex;
+  wdDynamicArray<PendingHandle> m_PendingHandles;
+};
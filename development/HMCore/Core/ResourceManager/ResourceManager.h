@@ -417,6 +417,19 @@ public:
     GetResourceTypePriorities()[wdGetStaticRTTI<RESOURCE_TYPE>()] = priority;
   }
 
+  /// \brief Limits how many resources of the given type are taken from the loading queue per frame.
+  ///
+  /// This prevents a flood of requests of one type (e.g. textures during level streaming) from delaying everything else.
+  /// The budget applies to exactly this type, not to derived types. Zero removes the limit.
+  template <typename RESOURCE_TYPE>
+  static void SetResourceTypeLoadingBudget(wdUInt32 uiMaxLoadsPerFrame)
+  {
+    SetResourceTypeLoadingBudget(wdGetStaticRTTI<RESOURCE_TYPE>(), uiMaxLoadsPerFrame);
+  }
+
+  /// \sa SetResourceTypeLoadingBudget()
+  static void SetResourceTypeLoadingBudget(const wdRTTI* pResourceType, wdUInt32 uiMaxLoadsPerFrame);
+
 private:
   static wdMap<const wdRTTI*, wdResourcePriority>& GetResourceTypePriorities();
   ///@}
@@ -454,14 +467,6 @@ private:
     wdHashTable<wdTempHashedString, wdResource*> m_Resources;
   };
 
-  struct LoadingInfo
-  {
-    float m_fPriority = 0;
-    wdResource* m_pResource = nullptr;
-
-    WD_ALWAYS_INLINE bool operator==(const LoadingInfo& rhs) const { return m_pResource == rhs.m_pResource; }
-    WD_ALWAYS_INLINE bool operator<(const LoadingInfo& rhs) const { return m_fPriority < rhs.m_fPriority; }
-  };
   static void EnsureResourceLoadingState(wdResource* pResource, const wdResourceState RequestedState);
   static void PreloadResource(wdResource* pResource);
   static void InternalPreloadResource(wdResource* pResource, bool bHighestPriority);
@@ -471,7 +476,6 @@ private:
   static wdResource* GetResource(const wdRTTI* pRtti, wdStringView sResourceID, bool bIsReloadable);
   static void RunWorkerTask(wdResource* pResource);
   static void UpdateLoadingDeadlines();
-  static void ReverseBubbleSortStep(wdDeque<LoadingInfo>& data);
   static bool ReloadResource(wdResource* pResource, bool bForce);
 
   static void SetupWorkerTasks();
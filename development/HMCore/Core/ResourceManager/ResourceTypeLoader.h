@@ -53,7 +53,8 @@ public:
 
 /// \brief A default implementation of wdResourceTypeLoader for standard file loading.
 ///
-/// The loader will interpret the wdResource 'resource ID' as a path, read that full file into a memory stream.
+/// The loader will interpret the wdResource 'resource ID' as a path and provide the full file content through a stream.
+/// Large files and uncompressed archive entries are mapped into memory instead of being copied, see wdMappedFileContent.
 /// The file modification data is stored as well.
 /// Resources that use this loader can update their data as if they were reading the file directly.
 class WD_CORE_DLL wdResourceLoaderFromFile : public wdResourceTypeLoader
@@ -104,6 +104,17 @@ public:
   /// will be initialized after creation, even if they were already in an initialized state when they were serialized.
   virtual void DeserializeComponent(wdWorldReader& inout_stream);
 
+  /// \brief Override this to return true if DeserializeComponent() of this component type may run on a worker thread.
+  ///
+  /// If this returns true, wdWorldReader may deserialize all components of this type in parallel to components of other types
+  /// (see wdPrefabInstantiationOptions::m_bParallelComponentDeserialization). The deserialization code must then only read from the stream
+  /// and write into the component itself. It must not access the world, other components, game objects or the resource manager.
+  /// Resource handles may be read from the stream, but they are only valid once the deserialization step has finished
+  /// (see wdResourceHandleReadContext), so they must not be used in DeserializeComponent().
+  /// The opt-in is meant for one exact type, derived types may deserialize more data. Return GetDynamicRTTI() == GetStaticRTTI()
+  /// so that derived types have to opt in themselves.
+  virtual bool CanBeDeserializedInParallel() const;
+
 
   /// \brief Ensures that the component is initialized. Must only be called from another component's Initialize callback.
   void EnsureInitialized();
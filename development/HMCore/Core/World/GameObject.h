@@ -589,6 +589,10 @@ private:
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(wdSpatialSystem& ref_spatialSystem);
 
+    /// \brief Same as UpdateGlobalBoundsAndSpatialData but only uses wdSpatialSystem::UpdateSpatialDataBoundsInPlace, thus it is safe to call from multiple threads.
+    /// Returns false, if the spatial data still needs to be updated through wdSpatialSystem::UpdateSpatialDataBounds.
+    bool UpdateGlobalBoundsAndSpatialDataInPlace(wdSpatialSystem& ref_spatialSystem);
+
     void UpdateVelocity(const wdSimdFloat& fInvDeltaSeconds);
 
     void RecreateSpatialData(wdSpatialSystem& ref_spatialSystem);
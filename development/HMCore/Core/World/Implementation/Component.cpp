@@ -59,6 +59,11 @@ void wdComponent::DeserializeComponent(wdWorldReader& inout_stream)
 {
 }
 
+bool wdComponent::CanBeDeserializedInParallel() const
+{
+  return false;
+}
+
 void wdComponent::EnsureInitialized()
 {
   WD_ASSERT_DEV(m_pOwner != nullptr, "Owner must not be null");
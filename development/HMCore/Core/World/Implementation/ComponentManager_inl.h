@@ -151,6 +151,11 @@ WD_FORCE_INLINE void wdComponentManager<T, StorageType>::RegisterUpdateFunction(
     desc.m_uiGranularity = static_cast<wdUInt16>(
       wdMath::RoundUp(static_cast<wdInt32>(desc.m_uiGranularity), wdDataBlock<ComponentType, wdInternal::DEFAULT_BLOCK_SIZE>::CAPACITY));
 
+  // a concurrent update function always modifies the components of its own manager
+  const wdRTTI* pComponentType = wdGetStaticRTTI<ComponentType>();
+  if (desc.m_bCanRunConcurrently && !desc.m_WriteComponentTypes.Contains(pComponentType))
+    desc.m_WriteComponentTypes.PushBack(pComponentType);
+
   wdComponentManagerBase::RegisterUpdateFunction(desc);
 }
 
@@ -1103,6 +1103,21 @@ void wdGameObject::TransformationData::UpdateGlobalBoundsAndSpatialData(wdSpatia
   }
 }
 
+bool wdGameObject::TransformationData::UpdateGlobalBoundsAndSpatialDataInPlace(wdSpatialSystem& ref_spatialSystem)
+{
+  wdSimdBBoxSphere oldGlobalBounds = m_globalBounds;
+
+  UpdateGlobalBounds();
+
+  const bool bIsAlwaysVisible = m_localBounds.m_BoxHalfExtents.w() != wdSimdFloat::Zero();
+  if (m_hSpatialData.IsInvalidated() == false && bIsAlwaysVisible == false && m_globalBounds != oldGlobalBounds)
+  {
+    return ref_spatialSystem.UpdateSpatialDataBoundsInPlace(m_hSpatialData, m_globalBounds);
+  }
+
+  return true;
+}
+
 void wdGameObject::TransformationData::RecreateSpatialData(wdSpatialSystem& ref_spatialSystem)
 {
   if (m_hSpatialData.IsInvalidated() == false)
@@ -19,6 +19,11 @@ void wdSpatialSystem::StartNewFrame()
   ++m_uiFrameCounter;
 }
 
+bool wdSpatialSystem::UpdateSpatialDataBoundsInPlace(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds)
+{
+  return false;
+}
+
 void wdSpatialSystem::FindObjectsInSphere(const wdBoundingSphere& sphere, const QueryParams& queryParams, wdDynamicArray<wdGameObject*>& out_objects) const
 {
   out_objects.Clear();
@@ -0,0 +1,460 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/System/SystemInformation.h>
+
+#if WD_SIMD_IMPLEMENTATION == WD_SIMD_IMPLEMENTATION_SSE && WD_ENABLED(WD_PLATFORM_ARCH_X86)
+#  include <immintrin.h>
+#endif
+
+/// Shared building blocks of the spatial system implementations: the SoA object storage of a cell or node and the SIMD culling kernels.
+
+namespace wdInternal
+{
+  inline bool FilterByTags(const wdTagSet& tags, const wdTagSet& includeTags, const wdTagSet& excludeTags)
+  {
+    if (!excludeTags.IsEmpty() && excludeTags.IsAnySet(tags))
+      return true;
+
+    if (!includeTags.IsEmpty() && !includeTags.IsAnySet(tags))
+      return true;
+
+    return false;
+  }
+
+  struct PlaneData
+  {
+    wdSimdVec4f m_x0x1x2x3;
+    wdSimdVec4f m_y0y1y2y3;
+    wdSimdVec4f m_z0z1z2z3;
+    wdSimdVec4f m_w0w1w2w3;
+
+    wdSimdVec4f m_x4x5x4x5;
+    wdSimdVec4f m_y4y5y4y5;
+    wdSimdVec4f m_z4z5z4z5;
+    wdSimdVec4f m_w4w5w4w5;
+  };
+
+  WD_FORCE_INLINE bool SphereFrustumIntersect(const wdSimdBSphere& sphere, const PlaneData& planeData)
+  {
+    wdSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    wdSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    wdSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    wdSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    wdSimdVec4f dot_0123;
+    dot_0123 = wdSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = wdSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = wdSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    wdSimdVec4f dot_4545;
+    dot_4545 = wdSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = wdSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = wdSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    wdSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
+    wdSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
+    return (cmp_0123 || cmp_4545).NoneSet<4>();
+  }
+
+  /// Bounding spheres of 8 objects in SoA layout, so that the culling kernels can test 4 or 8 objects with one instruction.
+  struct alignas(32) SphereBlock
+  {
+    WD_DECLARE_POD_TYPE();
+
+    float m_fX[8];
+    float m_fY[8];
+    float m_fZ[8];
+    float m_fRadius[8];
+  };
+
+  // Unused slots in the last block of a cell get this radius, which makes them fail every plane test.
+  constexpr float s_fInvalidRadius = -3.402823466e+38f;
+
+  // The six frustum planes as (nx, ny, nz, w). A sphere is outside if dot(center, n) + w > radius for any plane.
+  using FrustumPlanes = wdVec4[6];
+
+  // Tests up to 4 sphere blocks, i.e. 32 objects, against the frustum and returns a bit mask of the intersecting objects.
+  using FrustumCullFunc = wdUInt32 (*)(const SphereBlock* pBlocks, wdUInt32 uiNumBlocks, const FrustumPlanes& planes);
+
+  inline wdUInt32 FrustumCullBlocks4(const SphereBlock* pBlocks, wdUInt32 uiNumBlocks, const FrustumPlanes& planes)
+  {
+    wdSimdVec4f planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (wdUInt32 p = 0; p < 6; ++p)
+    {
+      planeX[p].Set(planes[p].x);
+      planeY[p].Set(planes[p].y);
+      planeZ[p].Set(planes[p].z);
+      planeW[p].Set(planes[p].w);
+    }
+
+    wdUInt32 uiMask = 0;
+
+    for (wdUInt32 b = 0; b < uiNumBlocks; ++b)
+    {
+      const SphereBlock& block = pBlocks[b];
+
+      for (wdUInt32 uiOffset = 0; uiOffset < 8; uiOffset += 4)
+      {
+        wdSimdVec4f x, y, z, r;
+        x.Load<4>(block.m_fX + uiOffset);
+        y.Load<4>(block.m_fY + uiOffset);
+        z.Load<4>(block.m_fZ + uiOffset);
+        r.Load<4>(block.m_fRadius + uiOffset);
+
+        wdSimdVec4b outside(false);
+        for (wdUInt32 p = 0; p < 6; ++p)
+        {
+          wdSimdVec4f dot = wdSimdVec4f::MulAdd(x, planeX[p], planeW[p]);
+          dot = wdSimdVec4f::MulAdd(y, planeY[p], dot);
+          dot = wdSimdVec4f::MulAdd(z, planeZ[p], dot);
+
+          outside = outside || (dot > r);
+        }
+
+        uiMask |= (~outside.GetMask() & 0xFu) << (b * 8 + uiOffset);
+      }
+    }
+
+    return uiMask;
+  }
+
+#if WD_SIMD_IMPLEMENTATION == WD_SIMD_IMPLEMENTATION_SSE && WD_ENABLED(WD_PLATFORM_ARCH_X86)
+#  define WD_FRUSTUM_CULL_AVX2 WD_ON
+
+#  if WD_ENABLED(WD_COMPILER_MSVC)
+#    define WD_TARGET_AVX2
+#  else
+#    define WD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#  endif
+
+  WD_TARGET_AVX2 inline wdUInt32 FrustumCullBlocks8(const SphereBlock* pBlocks, wdUInt32 uiNumBlocks, const FrustumPlanes& planes)
+  {
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (wdUInt32 p = 0; p < 6; ++p)
+    {
+      planeX[p] = _mm256_set1_ps(planes[p].x);
+      planeY[p] = _mm256_set1_ps(planes[p].y);
+      planeZ[p] = _mm256_set1_ps(planes[p].z);
+      planeW[p] = _mm256_set1_ps(planes[p].w);
+    }
+
+    wdUInt32 uiMask = 0;
+
+    for (wdUInt32 b = 0; b < uiNumBlocks; ++b)
+    {
+      const SphereBlock& block = pBlocks[b];
+
+      const __m256 x = _mm256_load_ps(block.m_fX);
+      const __m256 y = _mm256_load_ps(block.m_fY);
+      const __m256 z = _mm256_load_ps(block.m_fZ);
+      const __m256 r = _mm256_load_ps(block.m_fRadius);
+
+      __m256 outside = _mm256_setzero_ps();
+      for (wdUInt32 p = 0; p < 6; ++p)
+      {
+        __m256 dot = _mm256_fmadd_ps(x, planeX[p], planeW[p]);
+        dot = _mm256_fmadd_ps(y, planeY[p], dot);
+        dot = _mm256_fmadd_ps(z, planeZ[p], dot);
+
+        outside = _mm256_or_ps(outside, _mm256_cmp_ps(dot, r, _CMP_GT_OQ));
+      }
+
+      uiMask |= (~static_cast<wdUInt32>(_mm256_movemask_ps(outside)) & 0xFFu) << (b * 8);
+    }
+
+    return uiMask;
+  }
+
+#  undef WD_TARGET_AVX2
+#else
+#  define WD_FRUSTUM_CULL_AVX2 WD_OFF
+#endif
+
+  inline FrustumCullFunc GetFrustumCullFunc()
+  {
+#if WD_ENABLED(WD_FRUSTUM_CULL_AVX2)
+    static const FrustumCullFunc s_Func = []() -> FrustumCullFunc {
+      const wdCpuFeatures& cpuFeatures = wdSystemInformation::Get().GetCpuFeatures();
+      return (cpuFeatures.IsAvx2Available() && cpuFeatures.HW_FMA3) ? &FrustumCullBlocks8 : &FrustumCullBlocks4;
+    }();
+
+    return s_Func;
+#else
+    return &FrustumCullBlocks4;
+#endif
+  }
+
+  /// The frustum in the two layouts used for culling: transposed for single spheres and broadcast per plane for the block kernels.
+  struct FrustumCullData
+  {
+    void SetFrustum(const wdFrustum& frustum)
+    {
+      // Compiler is too stupid to properly unroll a constant loop so we do it by hand
+      wdSimdVec4f plane0 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
+      wdSimdVec4f plane1 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
+      wdSimdVec4f plane2 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
+      wdSimdVec4f plane3 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
+      wdSimdVec4f plane4 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
+      wdSimdVec4f plane5 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
+
+      wdSimdMat4f helperMat;
+      helperMat.SetRows(plane0, plane1, plane2, plane3);
+
+      m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
+      m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
+      m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
+      m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
+
+      helperMat.SetRows(plane4, plane5, plane4, plane5);
+
+      m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
+      m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
+      m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
+      m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
+
+      for (wdUInt32 i = 0; i < 6; ++i)
+      {
+        const wdPlane& plane = frustum.GetPlane(i);
+        m_Planes[i].Set(plane.m_vNormal.x, plane.m_vNormal.y, plane.m_vNormal.z, plane.m_fNegDistance);
+      }
+
+      m_CullFunc = GetFrustumCullFunc();
+    }
+
+    PlaneData m_PlaneData;
+    FrustumPlanes m_Planes;
+    FrustumCullFunc m_CullFunc = nullptr;
+  };
+
+  /// The objects of a grid cell or tree node. Bounding spheres are stored in blocks of 8, everything else in parallel arrays.
+  struct SpatialCellData
+  {
+    SpatialCellData(wdAllocatorBase* pAlignedAlloctor, wdAllocatorBase* pAllocator)
+      : m_SphereBlocks(pAlignedAlloctor)
+      , m_BoundingBoxHalfExtents(pAlignedAlloctor)
+      , m_TagSets(pAllocator)
+      , m_ObjectPointers(pAllocator)
+      , m_DataIndices(pAllocator)
+    {
+    }
+
+    WD_FORCE_INLINE wdUInt32 AddData(const wdSimdBBoxSphere& bounds, const wdTagSet& tags, wdGameObject* pObject, wdUInt64 uiLastVisibleFrameIdxAndVisType, wdUInt32 uiDataIndex)
+    {
+      const wdUInt32 uiCellDataIndex = m_DataIndices.GetCount();
+      if ((uiCellDataIndex % 8) == 0)
+      {
+        AddEmptyBlock();
+      }
+
+      SetSphere(uiCellDataIndex, bounds.GetSphere());
+      m_BoundingBoxHalfExtents.PushBack(bounds.m_BoxHalfExtents);
+      m_TagSets.PushBack(tags);
+      m_ObjectPointers.PushBack(pObject);
+      m_DataIndices.PushBack(uiDataIndex);
+      m_LastVisibleFrameIdxAndVisType.PushBack(uiLastVisibleFrameIdxAndVisType);
+
+      return uiCellDataIndex;
+    }
+
+    // Returns the data index of the moved data
+    WD_FORCE_INLINE wdUInt32 RemoveData(wdUInt32 uiCellDataIndex)
+    {
+      wdUInt32 uiMovedDataIndex = m_DataIndices.PeekBack();
+
+      const wdUInt32 uiLastIndex = m_DataIndices.GetCount() - 1;
+      SetSphere(uiCellDataIndex, GetSphere(uiLastIndex));
+      ClearSphere(uiLastIndex);
+
+      if ((uiLastIndex % 8) == 0)
+      {
+        m_SphereBlocks.PopBack();
+      }
+
+      m_BoundingBoxHalfExtents.RemoveAtAndSwap(uiCellDataIndex);
+      m_TagSets.RemoveAtAndSwap(uiCellDataIndex);
+      m_ObjectPointers.RemoveAtAndSwap(uiCellDataIndex);
+      m_DataIndices.RemoveAtAndSwap(uiCellDataIndex);
+      m_LastVisibleFrameIdxAndVisType.RemoveAtAndSwap(uiCellDataIndex);
+
+      WD_ASSERT_DEBUG(m_DataIndices.GetCount() == uiCellDataIndex || m_DataIndices[uiCellDataIndex] == uiMovedDataIndex, "Implementation error");
+
+      return uiMovedDataIndex;
+    }
+
+    WD_ALWAYS_INLINE wdUInt32 GetCount() const { return m_DataIndices.GetCount(); }
+
+    WD_FORCE_INLINE wdSimdBSphere GetSphere(wdUInt32 uiCellDataIndex) const
+    {
+      const SphereBlock& block = m_SphereBlocks[uiCellDataIndex / 8];
+      const wdUInt32 i = uiCellDataIndex % 8;
+
+      wdSimdBSphere sphere;
+      sphere.m_CenterAndRadius.Set(block.m_fX[i], block.m_fY[i], block.m_fZ[i], block.m_fRadius[i]);
+      return sphere;
+    }
+
+    WD_FORCE_INLINE void SetSphere(wdUInt32 uiCellDataIndex, const wdSimdBSphere& sphere)
+    {
+      SphereBlock& block = m_SphereBlocks[uiCellDataIndex / 8];
+      const wdUInt32 i = uiCellDataIndex % 8;
+
+      block.m_fX[i] = sphere.m_CenterAndRadius.x();
+      block.m_fY[i] = sphere.m_CenterAndRadius.y();
+      block.m_fZ[i] = sphere.m_CenterAndRadius.z();
+      block.m_fRadius[i] = sphere.m_CenterAndRadius.w();
+    }
+
+    // The bounding spheres in blocks of 8, the unused slots of the last block are always culled.
+    wdDynamicArray<SphereBlock> m_SphereBlocks;
+    wdDynamicArray<wdSimdVec4f> m_BoundingBoxHalfExtents;
+    wdDynamicArray<wdTagSet> m_TagSets;
+    wdDynamicArray<wdGameObject*> m_ObjectPointers;
+    mutable wdDynamicArray<wdAtomicInteger64> m_LastVisibleFrameIdxAndVisType;
+    wdDynamicArray<wdUInt32> m_DataIndices;
+
+  private:
+    void AddEmptyBlock()
+    {
+      const wdUInt32 uiFirstIndex = m_SphereBlocks.GetCount() * 8;
+      m_SphereBlocks.ExpandAndGetRef();
+
+      for (wdUInt32 i = 0; i < 8; ++i)
+      {
+        ClearSphere(uiFirstIndex + i);
+      }
+    }
+
+    WD_FORCE_INLINE void ClearSphere(wdUInt32 uiCellDataIndex)
+    {
+      SphereBlock& block = m_SphereBlocks[uiCellDataIndex / 8];
+      const wdUInt32 i = uiCellDataIndex % 8;
+
+      block.m_fX[i] = 0.0f;
+      block.m_fY[i] = 0.0f;
+      block.m_fZ[i] = 0.0f;
+      block.m_fRadius[i] = s_fInvalidRadius;
+    }
+  };
+
+  /// Calls the callback for all objects in the cell that overlap the given shape. Returns Stop if the callback requested it.
+  template <typename T, bool UseTagsFilter, typename Stats>
+  wdVisitorExecution::Enum FindObjectsInCellData(const SpatialCellData& cell, const T& shape, const wdSpatialSystem::QueryParams& queryParams, const wdSpatialSystem::QueryCallback& callback, Stats& ref_stats)
+  {
+    auto tagSets = cell.m_TagSets.GetData();
+    auto objectPointers = cell.m_ObjectPointers.GetData();
+
+    const wdUInt32 numSpheres = cell.GetCount();
+    ref_stats.m_uiNumObjectsTested += numSpheres;
+
+    for (wdUInt32 i = 0; i < numSpheres; ++i)
+    {
+      if (!shape.Overlaps(cell.GetSphere(i)))
+        continue;
+
+      if constexpr (UseTagsFilter)
+      {
+        if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
+        {
+          ref_stats.m_uiNumObjectsFiltered++;
+          continue;
+        }
+      }
+
+      ref_stats.m_uiNumObjectsPassed++;
+
+      if (callback(objectPointers[i]) == wdVisitorExecution::Stop)
+        return wdVisitorExecution::Stop;
+    }
+
+    return wdVisitorExecution::Continue;
+  }
+
+  /// Tests a single cell or node box with the batch occlusion callback.
+  inline bool IsBoxOccluded(const wdSpatialSystem::IsOccludedFunc& isOccluded, const wdSimdBBox& box)
+  {
+    bool bOccluded = false;
+    isOccluded(wdMakeArrayPtr(&box, 1), wdMakeArrayPtr(&bOccluded, 1));
+    return bOccluded;
+  }
+
+  /// Adds all objects in the cell that intersect the frustum and are not occluded to the output and marks them as visible.
+  template <bool UseTagsFilter, bool UseOcclusionCallback, typename Stats>
+  void FindVisibleObjectsInCellData(const SpatialCellData& cell, const FrustumCullData& cullData, const wdSpatialSystem::QueryParams& queryParams, const wdSpatialSystem::IsOccludedFunc& isOccluded, wdUInt64 uiFrameIdxAndType, wdDynamicArray<const wdGameObject*>& out_objects, Stats& ref_stats)
+  {
+    auto sphereBlocks = cell.m_SphereBlocks.GetData();
+    auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
+    auto tagSets = cell.m_TagSets.GetData();
+    auto objectPointers = cell.m_ObjectPointers.GetData();
+    auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
+
+    const wdUInt32 numSpheres = cell.GetCount();
+    const wdUInt32 numBlocks = cell.m_SphereBlocks.GetCount();
+    ref_stats.m_uiNumObjectsTested += numSpheres;
+
+    const FrustumCullFunc cullFunc = cullData.m_CullFunc;
+
+    // candidates that passed the frustum and tag tests, occlusion is tested for all of them with one callback
+    wdSimdBBox candidateBoxes[32];
+    wdUInt32 candidateIndices[32];
+    bool candidateOccluded[32];
+
+    // Up to 4 blocks of 8 objects are tested at once, the padding in the last block never passes the test.
+    for (wdUInt32 uiBlockIndex = 0; uiBlockIndex < numBlocks; uiBlockIndex += 4)
+    {
+      const wdUInt32 currentIndex = uiBlockIndex * 8;
+      wdUInt32 mask = cullFunc(sphereBlocks + uiBlockIndex, wdMath::Min(numBlocks - uiBlockIndex, 4u), cullData.m_Planes);
+      wdUInt32 uiNumCandidates = 0;
+
+      while (mask > 0)
+      {
+        wdUInt32 i = wdMath::FirstBitLow(mask) + currentIndex;
+        mask &= mask - 1;
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
+          {
+            ref_stats.m_uiNumObjectsFiltered++;
+            continue;
+          }
+        }
+
+        if constexpr (UseOcclusionCallback)
+        {
+          candidateBoxes[uiNumCandidates].SetCenterAndHalfExtents(cell.GetSphere(i).GetCenter(), boundingBoxHalfExtents[i]);
+          candidateIndices[uiNumCandidates] = i;
+          ++uiNumCandidates;
+        }
+        else
+        {
+          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
+          out_objects.PushBack(objectPointers[i]);
+
+          ref_stats.m_uiNumObjectsPassed++;
+        }
+      }
+
+      if constexpr (UseOcclusionCallback)
+      {
+        if (uiNumCandidates == 0)
+          continue;
+
+        isOccluded(wdMakeArrayPtr(candidateBoxes, uiNumCandidates), wdMakeArrayPtr(candidateOccluded, uiNumCandidates));
+
+        for (wdUInt32 c = 0; c < uiNumCandidates; ++c)
+        {
+          if (candidateOccluded[c])
+            continue;
+
+          const wdUInt32 i = candidateIndices[c];
+          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
+          out_objects.PushBack(objectPointers[i]);
+
+          ref_stats.m_uiNumObjectsPassed++;
+        }
+      }
+    }
+  }
+} // namespace wdInternal
@@ -0,0 +1,723 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/Implementation/SpatialSystemHelper.h>
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+
+struct wdSpatialSystem_LooseOctree::NodeDataMapping
+{
+  WD_DECLARE_POD_TYPE();
+
+  wdUInt32 m_uiNodeIndex = wdInvalidIndex;
+  wdUInt32 m_uiNodeDataIndex = wdInvalidIndex;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct wdSpatialSystem_LooseOctree::Node : public wdInternal::SpatialCellData
+{
+  Node(wdAllocatorBase* pAlignedAlloctor, wdAllocatorBase* pAllocator)
+    : wdInternal::SpatialCellData(pAlignedAlloctor, pAllocator)
+  {
+    for (wdUInt32 i = 0; i < 8; ++i)
+    {
+      m_ChildIndices[i] = wdInvalidIndex;
+    }
+  }
+
+  void SetCell(const wdSimdVec4f& vCenter, float fHalfSize, wdUInt32 uiDepth, wdUInt32 uiParentIndex)
+  {
+    m_vCenter = vCenter;
+    m_fHalfSize = fHalfSize;
+    m_uiDepth = uiDepth;
+    m_uiParentIndex = uiParentIndex;
+
+    // the loose bounds are twice as large as the cell
+    m_LooseBox.SetCenterAndHalfExtents(vCenter, wdSimdVec4f(fHalfSize * 2.0f));
+    m_LooseSphere = wdSimdBSphere(vCenter, fHalfSize * 2.0f * wdMath::Sqrt(3.0f));
+  }
+
+  WD_ALWAYS_INLINE bool IsRoot() const { return m_uiParentIndex == wdInvalidIndex; }
+
+  // The root node also takes all objects that are outside of the tree.
+  WD_ALWAYS_INLINE bool CanContain(const wdSimdBBoxSphere& bounds) const
+  {
+    return IsRoot() || (m_LooseBox.Contains(bounds.GetBox()) && m_LooseBox.Contains(bounds.GetSphere()));
+  }
+
+  WD_ALWAYS_INLINE wdBoundingBox GetBoundingBox() const { return wdSimdConversion::ToBBox(m_LooseBox); }
+
+  wdSimdBBox m_LooseBox;
+  wdSimdBSphere m_LooseSphere;
+  wdSimdVec4f m_vCenter;
+  float m_fHalfSize = 0.0f; ///< half the edge length of the regular octree cell
+  wdUInt32 m_uiDepth = 0;
+  wdUInt32 m_uiParentIndex = wdInvalidIndex;
+  wdUInt32 m_uiNumChildren = 0;
+  wdUInt32 m_ChildIndices[8];
+  bool m_bIsSplit = false; ///< Set once the node held more objects than the split threshold, from then on objects go into its children where possible.
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct wdSpatialSystem_LooseOctree::Stats
+{
+  wdUInt32 m_uiNumObjectsTested = 0;
+  wdUInt32 m_uiNumObjectsPassed = 0;
+  wdUInt32 m_uiNumObjectsFiltered = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+struct wdSpatialSystem_LooseOctree::Tree
+{
+  Tree(wdSpatialSystem_LooseOctree& ref_system, wdSpatialData::Category category)
+    : m_System(ref_system)
+    , m_Nodes(&ref_system.m_Allocator)
+    , m_FreeNodeIndices(&ref_system.m_Allocator)
+    , m_NodeDataMappings(&ref_system.m_Allocator)
+    , m_Category(category)
+  {
+    AllocateNode(wdSimdVec4f::ZeroVector(), ref_system.m_fRootHalfSize, 0, wdInvalidIndex);
+  }
+
+  wdUInt32 AllocateNode(const wdSimdVec4f& vCenter, float fHalfSize, wdUInt32 uiDepth, wdUInt32 uiParentIndex)
+  {
+    wdUInt32 uiNodeIndex = 0;
+    if (!m_FreeNodeIndices.IsEmpty())
+    {
+      uiNodeIndex = m_FreeNodeIndices.PeekBack();
+      m_FreeNodeIndices.PopBack();
+    }
+    else
+    {
+      uiNodeIndex = m_Nodes.GetCount();
+      m_Nodes.ExpandAndGetRef();
+    }
+
+    m_Nodes[uiNodeIndex] = WD_NEW(&m_System.m_AlignedAllocator, Node, &m_System.m_AlignedAllocator, &m_System.m_Allocator);
+    m_Nodes[uiNodeIndex]->SetCell(vCenter, fHalfSize, uiDepth, uiParentIndex);
+
+    return uiNodeIndex;
+  }
+
+  // Returns the child of the node that can contain the bounds, or wdInvalidIndex if there is none. A missing child is only created if bCreate is set.
+  wdUInt32 GetChildNode(wdUInt32 uiNodeIndex, const wdSimdBBoxSphere& bounds, bool bCreate)
+  {
+    // nodes don't move in memory when m_Nodes grows
+    Node& node = *m_Nodes[uiNodeIndex];
+    if (node.m_uiDepth >= m_System.m_uiMaxDepth)
+      return wdInvalidIndex;
+
+    const wdSimdBSphere sphere = bounds.GetSphere();
+    const wdUInt32 uiOctant = (sphere.GetCenter() >= node.m_vCenter).GetMask() & 7u;
+    const float fChildHalfSize = node.m_fHalfSize * 0.5f;
+
+    wdSimdVec4f vChildOffset;
+    vChildOffset.Set((uiOctant & 1u) ? fChildHalfSize : -fChildHalfSize, (uiOctant & 2u) ? fChildHalfSize : -fChildHalfSize, (uiOctant & 4u) ? fChildHalfSize : -fChildHalfSize, 0.0f);
+    const wdSimdVec4f vChildCenter = node.m_vCenter + vChildOffset;
+
+    wdSimdBBox childLooseBox;
+    childLooseBox.SetCenterAndHalfExtents(vChildCenter, wdSimdVec4f(fChildHalfSize * 2.0f));
+
+    if (!childLooseBox.Contains(bounds.GetBox()) || !childLooseBox.Contains(sphere))
+      return wdInvalidIndex;
+
+    wdUInt32 uiChildIndex = node.m_ChildIndices[uiOctant];
+    if (uiChildIndex == wdInvalidIndex && bCreate)
+    {
+      uiChildIndex = AllocateNode(vChildCenter, fChildHalfSize, node.m_uiDepth + 1, uiNodeIndex);
+      node.m_ChildIndices[uiOctant] = uiChildIndex;
+      ++node.m_uiNumChildren;
+    }
+
+    return uiChildIndex;
+  }
+
+  // Returns the deepest node that can contain the bounds. Missing children are only created for nodes that have been split.
+  wdUInt32 GetOrCreateNode(const wdSimdBBoxSphere& bounds)
+  {
+    wdUInt32 uiNodeIndex = m_uiRootIndex;
+
+    while (true)
+    {
+      const wdUInt32 uiChildIndex = GetChildNode(uiNodeIndex, bounds, m_Nodes[uiNodeIndex]->m_bIsSplit);
+      if (uiChildIndex == wdInvalidIndex)
+        break;
+
+      uiNodeIndex = uiChildIndex;
+    }
+
+    return uiNodeIndex;
+  }
+
+  // Moves all objects of the node that fit into one of its children down into that child, and splits the children that get too full as well.
+  void SplitNode(wdUInt32 uiNodeIndex)
+  {
+    Node& node = *m_Nodes[uiNodeIndex];
+    node.m_bIsSplit = true;
+
+    // backwards, since removing an object moves the last one into its place
+    for (wdUInt32 i = node.GetCount(); i-- > 0;)
+    {
+      wdSimdBBoxSphere bounds;
+      bounds.m_CenterAndRadius = node.GetSphere(i).m_CenterAndRadius;
+      bounds.m_BoxHalfExtents = node.m_BoundingBoxHalfExtents[i];
+
+      const wdUInt32 uiChildIndex = GetChildNode(uiNodeIndex, bounds, true);
+      if (uiChildIndex == wdInvalidIndex)
+        continue;
+
+      const wdUInt32 uiDataIndex = node.m_DataIndices[i];
+      const wdUInt32 uiChildDataIndex = m_Nodes[uiChildIndex]->AddData(bounds, node.m_TagSets[i], node.m_ObjectPointers[i], node.m_LastVisibleFrameIdxAndVisType[i], uiDataIndex);
+
+      const wdUInt32 uiMovedDataIndex = node.RemoveData(i);
+      if (uiMovedDataIndex != uiDataIndex)
+      {
+        m_NodeDataMappings[uiMovedDataIndex].m_uiNodeDataIndex = i;
+      }
+
+      m_NodeDataMappings[uiDataIndex] = {uiChildIndex, uiChildDataIndex};
+    }
+
+    for (wdUInt32 uiChildIndex : node.m_ChildIndices)
+    {
+      if (uiChildIndex != wdInvalidIndex)
+      {
+        SplitNodeIfFull(uiChildIndex);
+      }
+    }
+  }
+
+  WD_ALWAYS_INLINE void SplitNodeIfFull(wdUInt32 uiNodeIndex)
+  {
+    const Node& node = *m_Nodes[uiNodeIndex];
+    if (!node.m_bIsSplit && node.GetCount() > m_System.m_uiSplitThreshold && node.m_uiDepth < m_System.m_uiMaxDepth)
+    {
+      SplitNode(uiNodeIndex);
+    }
+  }
+
+  // Removes the node and its parents as long as they are empty leaves. The root node is never removed.
+  void RemoveEmptyNodes(wdUInt32 uiNodeIndex)
+  {
+    while (uiNodeIndex != m_uiRootIndex)
+    {
+      Node& node = *m_Nodes[uiNodeIndex];
+      if (node.GetCount() > 0 || node.m_uiNumChildren > 0)
+        return;
+
+      const wdUInt32 uiParentIndex = node.m_uiParentIndex;
+      Node& parent = *m_Nodes[uiParentIndex];
+
+      for (wdUInt32 i = 0; i < 8; ++i)
+      {
+        if (parent.m_ChildIndices[i] == uiNodeIndex)
+        {
+          parent.m_ChildIndices[i] = wdInvalidIndex;
+          --parent.m_uiNumChildren;
+          break;
+        }
+      }
+
+      m_Nodes[uiNodeIndex].Clear();
+      m_FreeNodeIndices.PushBack(uiNodeIndex);
+
+      uiNodeIndex = uiParentIndex;
+    }
+  }
+
+  void AddSpatialData(const wdSimdBBoxSphere& bounds, const wdTagSet& tags, wdGameObject* pObject, wdUInt64 uiLastVisibleFrameIdxAndVisType, const wdSpatialDataHandle& hData)
+  {
+    wdUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+    wdUInt32 uiNodeIndex = GetOrCreateNode(bounds);
+    wdUInt32 uiNodeDataIndex = m_Nodes[uiNodeIndex]->AddData(bounds, tags, pObject, uiLastVisibleFrameIdxAndVisType, uiDataIndex);
+
+    m_NodeDataMappings.EnsureCount(uiDataIndex + 1);
+    WD_ASSERT_DEBUG(m_NodeDataMappings[uiDataIndex].m_uiNodeIndex == wdInvalidIndex, "data has already been added to a node");
+    m_NodeDataMappings[uiDataIndex] = {uiNodeIndex, uiNodeDataIndex};
+
+    SplitNodeIfFull(uiNodeIndex);
+  }
+
+  void RemoveSpatialData(const wdSpatialDataHandle& hData)
+  {
+    wdUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+    auto& mapping = m_NodeDataMappings[uiDataIndex];
+    const wdUInt32 uiNodeIndex = mapping.m_uiNodeIndex;
+
+    wdUInt32 uiMovedDataIndex = m_Nodes[uiNodeIndex]->RemoveData(mapping.m_uiNodeDataIndex);
+    if (uiMovedDataIndex != uiDataIndex)
+    {
+      m_NodeDataMappings[uiMovedDataIndex].m_uiNodeDataIndex = mapping.m_uiNodeDataIndex;
+    }
+
+    mapping = {};
+
+    RemoveEmptyNodes(uiNodeIndex);
+  }
+
+  // Visits all nodes that pass the node test, depth first. The root node is always visited since it also holds the objects outside of the tree.
+  template <typename NodeTest, typename Functor>
+  WD_FORCE_INLINE void ForEachNode(NodeTest nodeTest, Functor func) const
+  {
+    wdHybridArray<wdUInt32, 64> nodesToVisit;
+    nodesToVisit.PushBack(m_uiRootIndex);
+
+    while (!nodesToVisit.IsEmpty())
+    {
+      const Node& node = *m_Nodes[nodesToVisit.PeekBack()];
+      nodesToVisit.PopBack();
+
+      if (!node.IsRoot() && !nodeTest(node))
+        continue;
+
+      if (func(node) == wdVisitorExecution::Stop)
+        return;
+
+      if (node.m_uiNumChildren > 0)
+      {
+        for (wdUInt32 i = 0; i < 8; ++i)
+        {
+          if (node.m_ChildIndices[i] != wdInvalidIndex)
+          {
+            nodesToVisit.PushBack(node.m_ChildIndices[i]);
+          }
+        }
+      }
+    }
+  }
+
+  template <typename T, bool UseTagsFilter>
+  wdVisitorExecution::Enum FindObjectsInShape(const T& shape, const QueryParams& queryParams, const QueryCallback& callback, Stats& ref_stats) const
+  {
+    wdVisitorExecution::Enum result = wdVisitorExecution::Continue;
+
+    ForEachNode([&](const Node& node) { return node.m_LooseBox.Overlaps(shape); },
+      [&](const Node& node) {
+        result = wdInternal::FindObjectsInCellData<T, UseTagsFilter>(node, shape, queryParams, callback, ref_stats);
+        return result;
+      });
+
+    return result;
+  }
+
+  template <bool UseTagsFilter, bool UseOcclusionCallback>
+  void FindVisibleObjects(const wdInternal::FrustumCullData& cullData, const QueryParams& queryParams, const IsOccludedFunc& isOccluded, wdUInt64 uiFrameIdxAndType, wdDynamicArray<const wdGameObject*>& out_objects, Stats& ref_stats) const
+  {
+    ForEachNode(
+      [&](const Node& node) {
+        if (!wdInternal::SphereFrustumIntersect(node.m_LooseSphere, cullData.m_PlaneData))
+          return false;
+
+        if constexpr (UseOcclusionCallback)
+        {
+          if (wdInternal::IsBoxOccluded(isOccluded, node.m_LooseBox))
+            return false;
+        }
+
+        return true;
+      },
+      [&](const Node& node) {
+        wdInternal::FindVisibleObjectsInCellData<UseTagsFilter, UseOcclusionCallback>(node, cullData, queryParams, isOccluded, uiFrameIdxAndType, out_objects, ref_stats);
+        return wdVisitorExecution::Continue;
+      });
+  }
+
+  wdSpatialSystem_LooseOctree& m_System;
+  wdDynamicArray<wdUniquePtr<Node>> m_Nodes;
+  wdDynamicArray<wdUInt32> m_FreeNodeIndices;
+  static constexpr wdUInt32 m_uiRootIndex = 0;
+
+  wdDynamicArray<NodeDataMapping> m_NodeDataMappings;
+
+  const wdSpatialData::Category m_Category;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdSpatialSystem_LooseOctree, 1, wdRTTINoAllocator)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+wdSpatialSystem_LooseOctree::wdSpatialSystem_LooseOctree(float fWorldSize /*= 65536.0f*/, float fMinNodeSize /*= 16.0f*/, wdUInt32 uiSplitThreshold /*= 32*/)
+  : m_AlignedAllocator("Spatial System Aligned", wdFoundation::GetAlignedAllocator())
+  , m_uiSplitThreshold(wdMath::Max(uiSplitThreshold, 1u))
+  , m_Trees(&m_Allocator)
+  , m_DataTable(&m_Allocator)
+{
+  WD_CHECK_AT_COMPILETIME(sizeof(Data) == 8);
+
+  const float fRootSize = static_cast<float>(wdMath::PowerOfTwo_Ceil(wdMath::Max(static_cast<wdUInt32>(fWorldSize), 1u)));
+  m_fRootHalfSize = fRootSize * 0.5f;
+
+  m_uiMaxDepth = 0;
+  for (float fChildSize = fRootSize * 0.5f; fChildSize >= fMinNodeSize && m_uiMaxDepth < 24; fChildSize *= 0.5f)
+  {
+    ++m_uiMaxDepth;
+  }
+
+  m_Trees.SetCount(MAX_NUM_TREES);
+}
+
+wdSpatialSystem_LooseOctree::~wdSpatialSystem_LooseOctree() = default;
+
+wdResult wdSpatialSystem_LooseOctree::GetNodeBoxForSpatialData(const wdSpatialDataHandle& hData, wdBoundingBox& out_boundingBox) const
+{
+  Data* pData = nullptr;
+  if (!m_DataTable.TryGetValue(hData.GetInternalID(), pData))
+    return WD_FAILURE;
+
+  ForEachTree(*pData, hData,
+    [&](Tree& ref_tree, const NodeDataMapping& mapping) {
+      out_boundingBox = ref_tree.m_Nodes[mapping.m_uiNodeIndex]->GetBoundingBox();
+      return wdVisitorExecution::Stop;
+    });
+
+  return WD_SUCCESS;
+}
+
+void wdSpatialSystem_LooseOctree::GetAllNodeBoxes(wdDynamicArray<wdBoundingBox>& out_boundingBoxes, wdSpatialData::Category filterCategory /*= wdInvalidSpatialDataCategory*/) const
+{
+  for (wdUInt32 uiTreeIndex = 0; uiTreeIndex < m_Trees.GetCount(); ++uiTreeIndex)
+  {
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr || (filterCategory != wdInvalidSpatialDataCategory && filterCategory != pTree->m_Category))
+      continue;
+
+    for (auto& pNode : pTree->m_Nodes)
+    {
+      if (pNode != nullptr && !pNode->IsRoot())
+      {
+        out_boundingBoxes.PushBack(pNode->GetBoundingBox());
+      }
+    }
+  }
+}
+
+wdSpatialDataHandle wdSpatialSystem_LooseOctree::CreateSpatialData(const wdSimdBBoxSphere& bounds, wdGameObject* pObject, wdUInt32 uiCategoryBitmask, const wdTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return wdSpatialDataHandle();
+
+  return AddSpatialDataToTrees(bounds, pObject, uiCategoryBitmask, tags, false);
+}
+
+wdSpatialDataHandle wdSpatialSystem_LooseOctree::CreateSpatialDataAlwaysVisible(wdGameObject* pObject, wdUInt32 uiCategoryBitmask, const wdTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return wdSpatialDataHandle();
+
+  // ends up in the root node
+  wdSimdBBox hugeBox;
+  hugeBox.SetCenterAndHalfExtents(wdSimdVec4f::ZeroVector(), wdSimdVec4f(m_fRootHalfSize * 4.0f));
+
+  return AddSpatialDataToTrees(hugeBox, pObject, uiCategoryBitmask, tags, true);
+}
+
+void wdSpatialSystem_LooseOctree::DeleteSpatialData(const wdSpatialDataHandle& hData)
+{
+  Data oldData;
+  WD_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  ForEachTree(oldData, hData,
+    [&](Tree& ref_tree, const NodeDataMapping& mapping) {
+      ref_tree.RemoveSpatialData(hData);
+      return wdVisitorExecution::Continue;
+    });
+}
+
+void wdSpatialSystem_LooseOctree::UpdateSpatialDataBounds(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  WD_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_uiAlwaysVisible != 0)
+    return;
+
+  ForEachTree(*pData, hData,
+    [&](Tree& ref_tree, const NodeDataMapping& mapping) {
+      auto& pOldNode = ref_tree.m_Nodes[mapping.m_uiNodeIndex];
+
+      if (pOldNode->CanContain(bounds))
+      {
+        pOldNode->SetSphere(mapping.m_uiNodeDataIndex, bounds.GetSphere());
+        pOldNode->m_BoundingBoxHalfExtents[mapping.m_uiNodeDataIndex] = bounds.m_BoxHalfExtents;
+      }
+      else
+      {
+        const wdTagSet tags = pOldNode->m_TagSets[mapping.m_uiNodeDataIndex];
+        wdGameObject* objectPointer = pOldNode->m_ObjectPointers[mapping.m_uiNodeDataIndex];
+
+        const wdUInt64 uiLastVisibleFrameIdxAndVisType = pOldNode->m_LastVisibleFrameIdxAndVisType[mapping.m_uiNodeDataIndex];
+
+        ref_tree.RemoveSpatialData(hData);
+
+        ref_tree.AddSpatialData(bounds, tags, objectPointer, uiLastVisibleFrameIdxAndVisType, hData);
+      }
+
+      return wdVisitorExecution::Continue;
+    });
+}
+
+void wdSpatialSystem_LooseOctree::UpdateSpatialDataObject(const wdSpatialDataHandle& hData, wdGameObject* pObject)
+{
+  Data* pData = nullptr;
+  WD_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  ForEachTree(*pData, hData,
+    [&](Tree& ref_tree, const NodeDataMapping& mapping) {
+      ref_tree.m_Nodes[mapping.m_uiNodeIndex]->m_ObjectPointers[mapping.m_uiNodeDataIndex] = pObject;
+      return wdVisitorExecution::Continue;
+    });
+}
+
+bool wdSpatialSystem_LooseOctree::UpdateSpatialDataBoundsInPlace(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  WD_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_uiAlwaysVisible != 0)
+    return true;
+
+  bool bUpdatedInPlace = true;
+
+  // Only the entries of this spatial data are written, so this is safe to do from multiple threads as long as no data is added or removed
+  ForEachTree(*pData, hData,
+    [&](Tree& ref_tree, const NodeDataMapping& mapping) {
+      auto& pNode = ref_tree.m_Nodes[mapping.m_uiNodeIndex];
+
+      if (!pNode->CanContain(bounds))
+      {
+        bUpdatedInPlace = false;
+        return wdVisitorExecution::Stop;
+      }
+
+      pNode->SetSphere(mapping.m_uiNodeDataIndex, bounds.GetSphere());
+      pNode->m_BoundingBoxHalfExtents[mapping.m_uiNodeDataIndex] = bounds.m_BoxHalfExtents;
+      return wdVisitorExecution::Continue;
+    });
+
+  return bUpdatedInPlace;
+}
+
+void wdSpatialSystem_LooseOctree::FindObjectsInSphere(const wdBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  WD_PROFILE_SCOPE("FindObjectsInSphere");
+
+  const wdSimdBSphere simdSphere(wdSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+  const bool bUseTagsFilter = !queryParams.m_IncludeTags.IsEmpty() || !queryParams.m_ExcludeTags.IsEmpty();
+
+  ForEachTreeInQuery(queryParams,
+    [&](const Tree& tree, Stats& ref_stats) {
+      return bUseTagsFilter ? tree.FindObjectsInShape<wdSimdBSphere, true>(simdSphere, queryParams, callback, ref_stats)
+                            : tree.FindObjectsInShape<wdSimdBSphere, false>(simdSphere, queryParams, callback, ref_stats);
+    });
+}
+
+void wdSpatialSystem_LooseOctree::FindObjectsInBox(const wdBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  WD_PROFILE_SCOPE("FindObjectsInBox");
+
+  const wdSimdBBox simdBox(wdSimdConversion::ToVec3(box.m_vMin), wdSimdConversion::ToVec3(box.m_vMax));
+  const bool bUseTagsFilter = !queryParams.m_IncludeTags.IsEmpty() || !queryParams.m_ExcludeTags.IsEmpty();
+
+  ForEachTreeInQuery(queryParams,
+    [&](const Tree& tree, Stats& ref_stats) {
+      return bUseTagsFilter ? tree.FindObjectsInShape<wdSimdBBox, true>(simdBox, queryParams, callback, ref_stats)
+                            : tree.FindObjectsInShape<wdSimdBBox, false>(simdBox, queryParams, callback, ref_stats);
+    });
+}
+
+void wdSpatialSystem_LooseOctree::FindVisibleObjects(const wdFrustum& frustum, const QueryParams& queryParams, wdDynamicArray<const wdGameObject*>& out_Objects, wdSpatialSystem::IsOccludedFunc IsOccluded, wdVisibilityState visType) const
+{
+  WD_PROFILE_SCOPE("FindVisibleObjects");
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  wdStopwatch timer;
+#endif
+
+  wdInternal::FrustumCullData cullData;
+  cullData.SetFrustum(frustum);
+
+  const wdUInt64 uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<wdUInt64>(visType);
+  const bool bUseTagsFilter = !queryParams.m_IncludeTags.IsEmpty() || !queryParams.m_ExcludeTags.IsEmpty();
+  const bool bUseOcclusionCallback = IsOccluded.IsValid();
+
+  ForEachTreeInQuery(queryParams,
+    [&](const Tree& tree, Stats& ref_stats) {
+      if (bUseOcclusionCallback)
+      {
+        if (bUseTagsFilter)
+          tree.FindVisibleObjects<true, true>(cullData, queryParams, IsOccluded, uiFrameIdxAndType, out_Objects, ref_stats);
+        else
+          tree.FindVisibleObjects<false, true>(cullData, queryParams, IsOccluded, uiFrameIdxAndType, out_Objects, ref_stats);
+      }
+      else
+      {
+        if (bUseTagsFilter)
+          tree.FindVisibleObjects<true, false>(cullData, queryParams, IsOccluded, uiFrameIdxAndType, out_Objects, ref_stats);
+        else
+          tree.FindVisibleObjects<false, false>(cullData, queryParams, IsOccluded, uiFrameIdxAndType, out_Objects, ref_stats);
+      }
+
+      return wdVisitorExecution::Continue;
+    });
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+wdVisibilityState wdSpatialSystem_LooseOctree::GetVisibilityState(const wdSpatialDataHandle& hData, wdUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  WD_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_uiAlwaysVisible != 0)
+    return wdVisibilityState::Direct;
+
+  wdUInt64 uiLastVisibleFrameIdxAndVisType = 0;
+  ForEachTree(*pData, hData,
+    [&](const Tree& tree, const NodeDataMapping& mapping) {
+      auto& pNode = tree.m_Nodes[mapping.m_uiNodeIndex];
+      uiLastVisibleFrameIdxAndVisType = wdMath::Max<wdUInt64>(uiLastVisibleFrameIdxAndVisType, pNode->m_LastVisibleFrameIdxAndVisType[mapping.m_uiNodeDataIndex]);
+      return wdVisitorExecution::Continue;
+    });
+
+  const wdUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const wdUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<wdUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return wdVisibilityState::Invisible;
+
+  return static_cast<wdVisibilityState>(uiLastVisibilityType);
+}
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+void wdSpatialSystem_LooseOctree::GetInternalStats(wdStringBuilder& sb) const
+{
+  sb = "Loose Octree:\n";
+
+  for (auto& pTree : m_Trees)
+  {
+    if (pTree == nullptr)
+      continue;
+
+    wdUInt32 uiNumNodes = 0;
+    wdUInt32 uiNumObjects = 0;
+    wdUInt32 uiNumObjectsInRoot = 0;
+    wdUInt32 uiMaxDepth = 0;
+
+    for (auto& pNode : pTree->m_Nodes)
+    {
+      if (pNode == nullptr)
+        continue;
+
+      ++uiNumNodes;
+      uiNumObjects += pNode->GetCount();
+      uiMaxDepth = wdMath::Max(uiMaxDepth, pNode->m_uiDepth);
+
+      if (pNode->IsRoot())
+      {
+        uiNumObjectsInRoot = pNode->GetCount();
+      }
+    }
+
+    sb.AppendFormat(" \nCategory: {}\nObjects: {} ({} in root)\nNodes: {}\nMax Depth: {}\n", pTree->m_Category.m_uiValue, uiNumObjects, uiNumObjectsInRoot, uiNumNodes, uiMaxDepth);
+  }
+}
+#endif
+
+wdSpatialDataHandle wdSpatialSystem_LooseOctree::AddSpatialDataToTrees(const wdSimdBBoxSphere& bounds, wdGameObject* pObject, wdUInt32 uiCategoryBitmask, const wdTagSet& tags, bool bAlwaysVisible)
+{
+  Data data;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+  data.m_uiAlwaysVisible = bAlwaysVisible ? 1 : 0;
+
+  auto hData = wdSpatialDataHandle(m_DataTable.Insert(data));
+
+  wdUInt32 uiTreeBitmask = uiCategoryBitmask;
+  while (uiTreeBitmask > 0)
+  {
+    wdUInt32 uiTreeIndex = wdMath::FirstBitLow(uiTreeBitmask);
+    uiTreeBitmask &= uiTreeBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+    {
+      pTree = WD_NEW(&m_Allocator, Tree, *this, wdSpatialData::Category(uiTreeIndex));
+    }
+
+    pTree->AddSpatialData(bounds, tags, pObject, m_uiFrameCounter, hData);
+  }
+
+  return hData;
+}
+
+template <typename Functor>
+WD_FORCE_INLINE void wdSpatialSystem_LooseOctree::ForEachTree(const Data& data, const wdSpatialDataHandle& hData, Functor func) const
+{
+  wdUInt32 uiTreeBitmask = data.m_uiCategoryBitmask;
+  wdUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  while (uiTreeBitmask > 0)
+  {
+    wdUInt32 uiTreeIndex = wdMath::FirstBitLow(uiTreeBitmask);
+    uiTreeBitmask &= uiTreeBitmask - 1;
+
+    auto& tree = *m_Trees[uiTreeIndex];
+    auto& mapping = tree.m_NodeDataMappings[uiDataIndex];
+
+    if (func(tree, mapping) == wdVisitorExecution::Stop)
+      break;
+  }
+}
+
+template <typename TreeFunctor>
+void wdSpatialSystem_LooseOctree::ForEachTreeInQuery(const QueryParams& queryParams, TreeFunctor func) const
+{
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+  }
+#endif
+
+  wdUInt32 uiTreeBitmask = queryParams.m_uiCategoryBitmask;
+  while (uiTreeBitmask > 0)
+  {
+    wdUInt32 uiTreeIndex = wdMath::FirstBitLow(uiTreeBitmask);
+    uiTreeBitmask &= uiTreeBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+      continue;
+
+    Stats stats;
+    const wdVisitorExecution::Enum result = func(*pTree, stats);
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+    if (queryParams.m_pStats != nullptr)
+    {
+      queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+      queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    }
+#endif
+
+    if (result == wdVisitorExecution::Stop)
+      break;
+  }
+}
+
+WD_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_LooseOctree);
@@ -1,5 +1,6 @@
 #include <Core/CorePCH.h>
 
+#include <Core/World/Implementation/SpatialSystemHelper.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
@@ -52,17 +53,6 @@ namespace
     return (uiCategoryBitmask & uiQueryBitmask) == 0;
   }
 
-  WD_ALWAYS_INLINE bool FilterByTags(const wdTagSet& tags, const wdTagSet& includeTags, const wdTagSet& excludeTags)
-  {
-    if (!excludeTags.IsEmpty() && excludeTags.IsAnySet(tags))
-      return true;
-
-    if (!includeTags.IsEmpty() && !includeTags.IsAnySet(tags))
-      return true;
-
-    return false;
-  }
-
   WD_ALWAYS_INLINE bool CanBeCached(wdSpatialData::Category category)
   {
     return wdSpatialData::GetCategoryFlags(category).IsSet(wdSpatialData::Flags::FrequentChanges) == false;
@@ -85,86 +75,6 @@ namespace
 
     out_sSb.Append(" }");
   }
-
-  struct PlaneData
-  {
-    wdSimdVec4f m_x0x1x2x3;
-    wdSimdVec4f m_y0y1y2y3;
-    wdSimdVec4f m_z0z1z2z3;
-    wdSimdVec4f m_w0w1w2w3;
-
-    wdSimdVec4f m_x4x5x4x5;
-    wdSimdVec4f m_y4y5y4y5;
-    wdSimdVec4f m_z4z5z4z5;
-    wdSimdVec4f m_w4w5w4w5;
-  };
-
-  WD_FORCE_INLINE bool SphereFrustumIntersect(const wdSimdBSphere& sphere, const PlaneData& planeData)
-  {
-    wdSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
-    wdSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
-    wdSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
-    wdSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
-
-    wdSimdVec4f dot_0123;
-    dot_0123 = wdSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dot_0123 = wdSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
-    dot_0123 = wdSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
-
-    wdSimdVec4f dot_4545;
-    dot_4545 = wdSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_4545 = wdSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
-    dot_4545 = wdSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
-
-    wdSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
-    wdSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
-    return (cmp_0123 || cmp_4545).NoneSet<4>();
-  }
-
-  WD_FORCE_INLINE wdUInt32 SphereFrustumIntersect(const wdSimdBSphere& sphereA, const wdSimdBSphere& sphereB, const PlaneData& planeData)
-  {
-    wdSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    wdSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    wdSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    wdSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    wdSimdVec4f dotA_0123;
-    dotA_0123 = wdSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = wdSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = wdSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    wdSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    wdSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    wdSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    wdSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    wdSimdVec4f dotB_0123;
-    dotB_0123 = wdSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = wdSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = wdSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    wdSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<wdSwizzle::XXXX>(posB_xxxx);
-    wdSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<wdSwizzle::XXXX>(posB_yyyy);
-    wdSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<wdSwizzle::XXXX>(posB_zzzz);
-    wdSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<wdSwizzle::XXXX>(posB_rrrr);
-
-    wdSimdVec4f dot_A45B45;
-    dot_A45B45 = wdSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = wdSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = wdSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    wdSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    wdSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    wdSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    wdSimdVec4b cmp_A45 = cmp_A45B45.Get<wdSwizzle::XYXY>();
-    wdSimdVec4b cmp_B45 = cmp_A45B45.Get<wdSwizzle::ZWZW>();
-
-    wdUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
-  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -177,56 +87,16 @@ struct CellDataMapping
   wdUInt32 m_uiCellDataIndex = wdInvalidIndex;
 };
 
-struct wdSpatialSystem_RegularGrid::Cell
+struct wdSpatialSystem_RegularGrid::Cell : public wdInternal::SpatialCellData
 {
   Cell(wdAllocatorBase* pAlignedAlloctor, wdAllocatorBase* pAllocator)
-    : m_BoundingSpheres(pAlignedAlloctor)
-    , m_BoundingBoxHalfExtents(pAlignedAlloctor)
-    , m_TagSets(pAllocator)
-    , m_ObjectPointers(pAllocator)
-    , m_DataIndices(pAllocator)
-  {
-  }
-
-  WD_FORCE_INLINE wdUInt32 AddData(const wdSimdBBoxSphere& bounds, const wdTagSet& tags, wdGameObject* pObject, wdUInt64 uiLastVisibleFrameIdxAndVisType, wdUInt32 uiDataIndex)
+    : wdInternal::SpatialCellData(pAlignedAlloctor, pAllocator)
   {
-    m_BoundingSpheres.PushBack(bounds.GetSphere());
-    m_BoundingBoxHalfExtents.PushBack(bounds.m_BoxHalfExtents);
-    m_TagSets.PushBack(tags);
-    m_ObjectPointers.PushBack(pObject);
-    m_DataIndices.PushBack(uiDataIndex);
-    m_LastVisibleFrameIdxAndVisType.PushBack(uiLastVisibleFrameIdxAndVisType);
-
-    return m_BoundingSpheres.GetCount() - 1;
-  }
-
-  // Returns the data index of the moved data
-  WD_FORCE_INLINE wdUInt32 RemoveData(wdUInt32 uiCellDataIndex)
-  {
-    wdUInt32 uiMovedDataIndex = m_DataIndices.PeekBack();
-
-    m_BoundingSpheres.RemoveAtAndSwap(uiCellDataIndex);
-    m_BoundingBoxHalfExtents.RemoveAtAndSwap(uiCellDataIndex);
-    m_TagSets.RemoveAtAndSwap(uiCellDataIndex);
-    m_ObjectPointers.RemoveAtAndSwap(uiCellDataIndex);
-    m_DataIndices.RemoveAtAndSwap(uiCellDataIndex);
-    m_LastVisibleFrameIdxAndVisType.RemoveAtAndSwap(uiCellDataIndex);
-
-    WD_ASSERT_DEBUG(m_DataIndices.GetCount() == uiCellDataIndex || m_DataIndices[uiCellDataIndex] == uiMovedDataIndex, "Implementation error");
-
-    return uiMovedDataIndex;
   }
 
   WD_ALWAYS_INLINE wdBoundingBox GetBoundingBox() const { return wdSimdConversion::ToBBoxSphere(m_Bounds).GetBox(); }
 
   wdSimdBBoxSphere m_Bounds;
-
-  wdDynamicArray<wdSimdBSphere> m_BoundingSpheres;
-  wdDynamicArray<wdSimdVec4f> m_BoundingBoxHalfExtents;
-  wdDynamicArray<wdTagSet> m_TagSets;
-  wdDynamicArray<wdGameObject*> m_ObjectPointers;
-  mutable wdDynamicArray<wdAtomicInteger64> m_LastVisibleFrameIdxAndVisType;
-  wdDynamicArray<wdUInt32> m_DataIndices;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -332,11 +202,11 @@ struct wdSpatialSystem_RegularGrid::Grid
     auto& pOtherCell = other.m_Cells[mapping.m_uiCellIndex];
 
     const wdTagSet& tags = pOtherCell->m_TagSets[mapping.m_uiCellDataIndex];
-    if (FilterByTags(tags, m_IncludeTags, m_ExcludeTags))
+    if (wdInternal::FilterByTags(tags, m_IncludeTags, m_ExcludeTags))
       return false;
 
     wdSimdBBoxSphere bounds;
-    bounds.m_CenterAndRadius = pOtherCell->m_BoundingSpheres[mapping.m_uiCellDataIndex].m_CenterAndRadius;
+    bounds.m_CenterAndRadius = pOtherCell->GetSphere(mapping.m_uiCellDataIndex).m_CenterAndRadius;
     bounds.m_BoxHalfExtents = pOtherCell->m_BoundingBoxHalfExtents[mapping.m_uiCellDataIndex];
     wdGameObject* objectPointer = pOtherCell->m_ObjectPointers[mapping.m_uiCellDataIndex];
     const wdUInt64 uiLastVisibleFrameIdxAndVisType = pOtherCell->m_LastVisibleFrameIdxAndVisType[mapping.m_uiCellDataIndex];
@@ -444,39 +314,12 @@ namespace wdInternal
       if (!cellBox.Overlaps(shape))
         return wdVisitorExecution::Continue;
 
-      auto boundingSpheres = cell.m_BoundingSpheres.GetData();
-      auto tagSets = cell.m_TagSets.GetData();
-      auto objectPointers = cell.m_ObjectPointers.GetData();
-
-      const wdUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
-      ref_stats.m_uiNumObjectsTested += numSpheres;
-
-      for (wdUInt32 i = 0; i < numSpheres; ++i)
-      {
-        if (!shape.Overlaps(boundingSpheres[i]))
-          continue;
-
-        if constexpr (UseTagsFilter)
-        {
-          if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
-          {
-            ref_stats.m_uiNumObjectsFiltered++;
-            continue;
-          }
-        }
-
-        ref_stats.m_uiNumObjectsPassed++;
-
-        if (pQueryData->m_Callback(objectPointers[i]) == wdVisitorExecution::Stop)
-          return wdVisitorExecution::Stop;
-      }
-
-      return wdVisitorExecution::Continue;
+      return FindObjectsInCellData<T, UseTagsFilter>(cell, shape, queryParams, pQueryData->m_Callback, ref_stats);
     }
 
     struct FrustumQueryData
     {
-      PlaneData m_PlaneData;
+      FrustumCullData m_CullData;
       wdDynamicArray<const wdGameObject*>* m_pOutObjects;
       wdUInt64 m_uiFrameCounter;
       wdSpatialSystem::IsOccludedFunc m_IsOccludedCB;
@@ -486,111 +329,22 @@ namespace wdInternal
     static wdVisitorExecution::Enum FrustumQueryCallback(const wdSpatialSystem_RegularGrid::Cell& cell, const wdSpatialSystem::QueryParams& queryParams, wdSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, wdVisibilityState visType)
     {
       auto pQueryData = static_cast<FrustumQueryData*>(pUserData);
-      PlaneData planeData = pQueryData->m_PlaneData;
 
       wdSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
-      if (!SphereFrustumIntersect(cellSphere, planeData))
+      if (!SphereFrustumIntersect(cellSphere, pQueryData->m_CullData.m_PlaneData))
         return wdVisitorExecution::Continue;
 
       if constexpr (UseOcclusionCallback)
       {
-        if (pQueryData->m_IsOccludedCB(cell.m_Bounds.GetBox()))
+        if (IsBoxOccluded(pQueryData->m_IsOccludedCB, cell.m_Bounds.GetBox()))
         {
           return wdVisitorExecution::Continue;
         }
       }
 
-      wdSimdBBox bbox;
-      auto boundingSpheres = cell.m_BoundingSpheres.GetData();
-      auto boundingBoxHalfExtents = cell.m_BoundingBoxHalfExtents.GetData();
-      auto tagSets = cell.m_TagSets.GetData();
-      auto objectPointers = cell.m_ObjectPointers.GetData();
-      auto lastVisibleFrameIdxAndVisType = cell.m_LastVisibleFrameIdxAndVisType.GetData();
-
-      const wdUInt32 numSpheres = cell.m_BoundingSpheres.GetCount();
-      ref_stats.m_uiNumObjectsTested += numSpheres;
-
-      wdUInt32 currentIndex = 0;
       const wdUInt64 uiFrameIdxAndType = (pQueryData->m_uiFrameCounter << 4) | static_cast<wdUInt64>(visType);
 
-      while (currentIndex < numSpheres)
-      {
-        if (numSpheres - currentIndex >= 32)
-        {
-          wdUInt32 mask = 0;
-
-          for (wdUInt32 i = 0; i < 32; i += 2)
-          {
-            auto& objectSphereA = boundingSpheres[currentIndex + i + 0];
-            auto& objectSphereB = boundingSpheres[currentIndex + i + 1];
-
-            mask |= SphereFrustumIntersect(objectSphereA, objectSphereB, planeData) << i;
-          }
-
-          while (mask > 0)
-          {
-            wdUInt32 i = wdMath::FirstBitLow(mask) + currentIndex;
-            mask &= mask - 1;
-
-            if constexpr (UseTagsFilter)
-            {
-              if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
-              {
-                ref_stats.m_uiNumObjectsFiltered++;
-                continue;
-              }
-            }
-
-            if constexpr (UseOcclusionCallback)
-            {
-              bbox.SetCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-              if (pQueryData->m_IsOccludedCB(bbox))
-              {
-                continue;
-              }
-            }
-
-            lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-            pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
-
-            ref_stats.m_uiNumObjectsPassed++;
-          }
-
-          currentIndex += 32;
-        }
-        else
-        {
-          wdUInt32 i = currentIndex;
-          ++currentIndex;
-
-          if (!SphereFrustumIntersect(boundingSpheres[i], planeData))
-            continue;
-
-          if constexpr (UseTagsFilter)
-          {
-            if (FilterByTags(tagSets[i], queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
-            {
-              ref_stats.m_uiNumObjectsFiltered++;
-              continue;
-            }
-          }
-
-          if constexpr (UseOcclusionCallback)
-          {
-            bbox.SetCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-
-            if (pQueryData->m_IsOccludedCB(bbox))
-            {
-              continue;
-            }
-          }
-
-          lastVisibleFrameIdxAndVisType[i].Max(uiFrameIdxAndType);
-          pQueryData->m_pOutObjects->PushBack(objectPointers[i]);
-
-          ref_stats.m_uiNumObjectsPassed++;
-        }
-      }
+      FindVisibleObjectsInCellData<UseTagsFilter, UseOcclusionCallback>(cell, pQueryData->m_CullData, queryParams, pQueryData->m_IsOccludedCB, uiFrameIdxAndType, *pQueryData->m_pOutObjects, ref_stats);
 
       return wdVisitorExecution::Continue;
     }
@@ -769,7 +523,7 @@ void wdSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const wdSpatialDataHan
 
       if (pOldCell->m_Bounds.GetBox().Contains(bounds.GetBox()))
       {
-        pOldCell->m_BoundingSpheres[mapping.m_uiCellDataIndex] = bounds.GetSphere();
+        pOldCell->SetSphere(mapping.m_uiCellDataIndex, bounds.GetSphere());
         pOldCell->m_BoundingBoxHalfExtents[mapping.m_uiCellDataIndex] = bounds.m_BoxHalfExtents;
       }
       else
@@ -788,6 +542,36 @@ void wdSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const wdSpatialDataHan
     });
 }
 
+bool wdSpatialSystem_RegularGrid::UpdateSpatialDataBoundsInPlace(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  WD_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (IsAlwaysVisibleData(*pData))
+    return true;
+
+  bool bUpdatedInPlace = true;
+
+  // Only the entries of this spatial data are written, so this is safe to do from multiple threads as long as no data is added or removed
+  ForEachGrid(*pData, hData,
+    [&](Grid& ref_grid, const CellDataMapping& mapping) {
+      auto& pCell = ref_grid.m_Cells[mapping.m_uiCellIndex];
+
+      if (!pCell->m_Bounds.GetBox().Contains(bounds.GetBox()))
+      {
+        bUpdatedInPlace = false;
+        return wdVisitorExecution::Stop;
+      }
+
+      pCell->SetSphere(mapping.m_uiCellDataIndex, bounds.GetSphere());
+      pCell->m_BoundingBoxHalfExtents[mapping.m_uiCellDataIndex] = bounds.m_BoxHalfExtents;
+      return wdVisitorExecution::Continue;
+    });
+
+  return bUpdatedInPlace;
+}
+
 void wdSpatialSystem_RegularGrid::UpdateSpatialDataObject(const wdSpatialDataHandle& hData, wdGameObject* pObject)
 {
   Data* pData = nullptr;
@@ -853,28 +637,7 @@ void wdSpatialSystem_RegularGrid::FindVisibleObjects(const wdFrustum& frustum, c
 
   wdInternal::QueryHelper::FrustumQueryData queryData;
   {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    wdSimdVec4f plane0 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    wdSimdVec4f plane1 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    wdSimdVec4f plane2 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    wdSimdVec4f plane3 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    wdSimdVec4f plane4 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    wdSimdVec4f plane5 = wdSimdConversion::ToVec4(*reinterpret_cast<const wdVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    wdSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    queryData.m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    queryData.m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
+    queryData.m_CullData.SetFrustum(frustum);
 
     queryData.m_pOutObjects = &out_Objects;
     queryData.m_uiFrameCounter = m_uiFrameCounter;
@@ -984,7 +747,7 @@ wdSpatialDataHandle wdSpatialSystem_RegularGrid::AddSpatialDataToGrids(const wdS
       continue;
 
     if ((pGrid->m_Category.GetBitmask() & uiCategoryBitmask) == 0 ||
-        FilterByTags(tags, pGrid->m_IncludeTags, pGrid->m_ExcludeTags))
+        wdInternal::FilterByTags(tags, pGrid->m_IncludeTags, pGrid->m_ExcludeTags))
       continue;
 
     data.m_uiGridBitmask |= WD_BIT(uiCachedGridIndex);
@@ -391,8 +391,8 @@ void wdWorld::PostMessage(const wdGameObjectHandle& receiverObject, const wdMess
   }
   else
   {
-    wdMessage* pMsgCopy = pMsgRTTIAllocator->Clone<wdMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    wdMessage* pMsgCopy = pMsgRTTIAllocator->Clone<wdMessage>(&msg, m_Data.m_MessageAllocator.GetCurrentAllocator());
+    m_Data.EnqueueMessage(pMsgCopy, metaData, queueType);
   }
 }
 
@@ -417,8 +417,8 @@ void wdWorld::PostMessage(const wdComponentHandle& hReceiverComponent, const wdM
   }
   else
   {
-    wdMessage* pMsgCopy = pMsgRTTIAllocator->Clone<wdMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    wdMessage* pMsgCopy = pMsgRTTIAllocator->Clone<wdMessage>(&msg, m_Data.m_MessageAllocator.GetCurrentAllocator());
+    m_Data.EnqueueMessage(pMsgCopy, metaData, queueType);
   }
 }
 
@@ -479,7 +479,7 @@ void wdWorld::Update()
   {
     WD_PROFILE_SCOPE("Pre-Async Phase");
     ProcessQueuedMessages(wdObjectMsgQueueType::NextFrame);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[wdComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync]);
+    UpdateSynchronous(wdComponentManagerBase::UpdateFunctionDesc::Phase::PreAsync);
   }
 
   // async phase
@@ -498,7 +498,7 @@ void wdWorld::Update()
   {
     WD_PROFILE_SCOPE("Post-Async Phase");
     ProcessQueuedMessages(wdObjectMsgQueueType::PostAsync);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[wdComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync]);
+    UpdateSynchronous(wdComponentManagerBase::UpdateFunctionDesc::Phase::PostAsync);
   }
 
   // delete dead objects and update the object hierarchy
@@ -525,7 +525,7 @@ void wdWorld::Update()
   {
     WD_PROFILE_SCOPE("Post-Transform Phase");
     ProcessQueuedMessages(wdObjectMsgQueueType::PostTransform);
-    UpdateSynchronous(m_Data.m_UpdateFunctions[wdComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform]);
+    UpdateSynchronous(wdComponentManagerBase::UpdateFunctionDesc::Phase::PostTransform);
   }
 
   // Process again so new component can receive render messages, otherwise we introduce a frame delay.
@@ -538,8 +538,9 @@ void wdWorld::Update()
     ProcessQueuedMessages(wdObjectMsgQueueType::AfterInitialized);
   }
 
-  // Swap our double buffered stack allocator
+  // Swap our double buffered stack allocators
   m_Data.m_StackAllocator.Swap();
+  m_Data.m_MessageAllocator.Swap();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -826,6 +827,98 @@ void wdWorld::ProcessQueuedMessage(const wdInternal::WorldData::MessageQueue::En
   }
 }
 
+void wdWorld::DeliverQueuedMessages(wdArrayPtr<const wdInternal::WorldData::SortedMessage> messages)
+{
+  // runs of messages with the same due time and sorting key that are at least this long are delivered in parallel,
+  // if all their message types allow it
+  constexpr wdUInt32 uiMinParallelMessages = 64;
+
+  wdUInt32 uiStart = 0;
+  while (uiStart < messages.GetCount())
+  {
+    const wdInternal::WorldData::SortedMessage& first = messages[uiStart];
+    bool bCanBeDeliveredInParallel = first.m_bCanBeDeliveredInParallel;
+
+    auto IsSameRun = [&first](const wdInternal::WorldData::SortedMessage& msg) {
+      return msg.m_Entry.m_MetaData.m_Due == first.m_Entry.m_MetaData.m_Due && msg.m_iSortingKey == first.m_iSortingKey;
+    };
+
+    wdUInt32 uiEnd = uiStart + 1;
+    while (uiEnd < messages.GetCount() && IsSameRun(messages[uiEnd]))
+    {
+      bCanBeDeliveredInParallel &= messages[uiEnd].m_bCanBeDeliveredInParallel;
+      ++uiEnd;
+    }
+
+    if (bCanBeDeliveredInParallel && uiEnd - uiStart >= uiMinParallelMessages)
+    {
+      DeliverQueuedMessagesInParallel(messages.GetSubArray(uiStart, uiEnd - uiStart));
+    }
+    else
+    {
+      for (wdUInt32 i = uiStart; i < uiEnd; ++i)
+      {
+        ProcessQueuedMessage(messages[i].m_Entry);
+      }
+    }
+
+    uiStart = uiEnd;
+  }
+}
+
+void wdWorld::DeliverQueuedMessagesInParallel(wdArrayPtr<const wdInternal::WorldData::SortedMessage> messages)
+{
+  WD_PROFILE_SCOPE("Deliver Messages In Parallel");
+
+  // all messages to the same receiver are sorted next to each other, they are delivered in order by the same task
+  wdDynamicArray<wdUInt32> receiverStarts(m_Data.m_StackAllocator.GetCurrentAllocator());
+
+  // the receivers are looked up up front, looking them up needs write access to the world which the tasks don't have
+  wdDynamicArray<wdComponent*> receivers(m_Data.m_StackAllocator.GetCurrentAllocator());
+  receivers.SetCountUninitialized(messages.GetCount());
+
+  for (wdUInt32 i = 0; i < messages.GetCount(); ++i)
+  {
+    if (i == 0 || messages[i].m_uiReceiverKey != messages[i - 1].m_uiReceiverKey)
+    {
+      receiverStarts.PushBack(i);
+    }
+
+    wdComponentHandle hComponent(wdComponentId(messages[i].m_Entry.m_MetaData.m_uiReceiverObjectOrComponent));
+    if (!TryGetComponent(hComponent, receivers[i]))
+    {
+      receivers[i] = nullptr;
+    }
+  }
+
+  const wdUInt32 uiNumReceivers = receiverStarts.GetCount();
+  receiverStarts.PushBack(messages.GetCount());
+
+  wdParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 16;
+  parallelForParams.m_pTaskAllocator = m_Data.m_StackAllocator.GetCurrentAllocator();
+
+  // remove write marker but keep the read marker, same as in the async phase
+  m_Data.m_WriteThreadID = (wdThreadID)0;
+
+  wdTaskSystem::ParallelForIndexed(
+    0u, uiNumReceivers,
+    [messages, &receiverStarts, &receivers](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+      for (wdUInt32 i = receiverStarts[uiStartIndex]; i < receiverStarts[uiEndIndex]; ++i)
+      {
+        // components can't be deleted while the world is not marked for writing, so the pointers stay valid
+        if (receivers[i] != nullptr)
+        {
+          receivers[i]->SendMessageInternal(*messages[i].m_Entry.m_pMessage, true);
+        }
+      }
+    },
+    "Deliver Queued Messages", parallelForParams);
+
+  // restore write marker
+  m_Data.m_WriteThreadID = wdThreadUtils::GetCurrentThreadID();
+}
+
 void wdWorld::ProcessQueuedMessages(wdObjectMsgQueueType::Enum queueType)
 {
   WD_PROFILE_SCOPE("Process Queued Messages");
@@ -864,17 +957,17 @@ void wdWorld::ProcessQueuedMessages(wdObjectMsgQueueType::Enum queueType)
 
   // regular messages
   {
-    wdInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
-    queue.Sort(MessageComparer());
-
-    for (wdUInt32 i = 0; i < queue.GetCount(); ++i)
+    // Messages that are posted to the same queue during delivery end up in the next batch, which is still delivered in this call.
+    // There is no need to deallocate these messages, they are allocated through a frame allocator.
+    while (true)
     {
-      ProcessQueuedMessage(queue[i]);
+      m_Data.CollectQueuedMessages(queueType);
 
-      // no need to deallocate these messages, they are allocated through a frame allocator
-    }
+      if (m_Data.m_MessageBatch.IsEmpty())
+        break;
 
-    queue.Clear();
+      DeliverQueuedMessages(m_Data.m_MessageBatch);
+    }
   }
 
   // timed messages
@@ -982,6 +1075,7 @@ void wdWorld::RegisterUpdateFunction(const wdComponentManagerBase::UpdateFunctio
 
   WD_ASSERT_DEV(desc.m_Phase == wdComponentManagerBase::UpdateFunctionDesc::Phase::Async || desc.m_uiGranularity == 0, "Granularity must be 0 for synchronous update functions");
   WD_ASSERT_DEV(desc.m_Phase != wdComponentManagerBase::UpdateFunctionDesc::Phase::Async || desc.m_DependsOn.GetCount() == 0, "Asynchronous update functions must not have dependencies");
+  WD_ASSERT_DEV(desc.m_Phase != wdComponentManagerBase::UpdateFunctionDesc::Phase::Async || !desc.m_bCanRunConcurrently, "Only synchronous update functions can be marked to run concurrently");
   WD_ASSERT_DEV(desc.m_Function.IsComparable(), "Delegates with captures are not allowed as wdWorld update functions.");
 
   m_Data.m_UpdateFunctionsToRegister.PushBack(desc);
@@ -998,6 +1092,7 @@ void wdWorld::DeregisterUpdateFunction(const wdComponentManagerBase::UpdateFunct
     if (updateFunctions[i].m_Function.IsEqualIfComparable(desc.m_Function))
     {
       updateFunctions.RemoveAtAndCopy(i);
+      m_Data.m_UpdateGraphs[desc.m_Phase.GetValue()].m_bDirty = true;
     }
   }
 }
@@ -1015,6 +1110,7 @@ void wdWorld::DeregisterUpdateFunctions(wdWorldModule* pModule)
       if (updateFunctions[i].m_Function.GetClassInstance() == pModule)
       {
         updateFunctions.RemoveAtAndCopy(i);
+        m_Data.m_UpdateGraphs[phase].m_bDirty = true;
       }
     }
   }
@@ -1032,22 +1128,157 @@ void wdWorld::UpdateFromThread()
   Update();
 }
 
-void wdWorld::UpdateSynchronous(const wdArrayPtr<wdInternal::WorldData::RegisteredUpdateFunction>& updateFunctions)
+void wdWorld::UpdateSynchronous(wdWorldModule::UpdateFunctionDesc::Phase::Enum phase)
 {
+  const wdDynamicArrayBase<wdInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[phase];
+  const wdInternal::WorldData::UpdateGraph& graph = m_Data.m_UpdateGraphs[phase];
+
+  if (graph.m_bDirty)
+  {
+    m_Data.BuildUpdateGraph(phase);
+  }
+
   wdWorldModule::UpdateContext context;
   context.m_uiFirstComponentIndex = 0;
   context.m_uiComponentCount = wdInvalidIndex;
 
-  for (auto& updateFunction : updateFunctions)
+  bool bAnyConcurrentFunctions = false;
+  wdTime criticalPath;
+  wdTime totalConcurrentTime;
+
+  for (wdUInt32 i = 0; i < updateFunctions.GetCount();)
   {
+    const wdUInt32 uiSegmentEnd = graph.m_Nodes[i].m_uiSegmentEnd;
+    if (uiSegmentEnd > i + 1)
+    {
+      UpdateConcurrently(phase, i, uiSegmentEnd, criticalPath, totalConcurrentTime);
+      bAnyConcurrentFunctions = true;
+      i = uiSegmentEnd;
+      continue;
+    }
+
+    const auto& updateFunction = updateFunctions[i];
+    ++i;
+
     if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
       continue;
 
     {
       WD_PROFILE_SCOPE(updateFunction.m_sFunctionName);
+
+      const wdTime startTime = wdTime::Now();
       updateFunction.m_Function(context);
+
+      // functions that run on the main thread are always part of the critical path
+      criticalPath += wdTime::Now() - startTime;
+    }
+  }
+
+  if (bAnyConcurrentFunctions)
+  {
+    static const char* s_szPhaseNames[] = {"Pre-Async", "Async", "Post-Async", "Post-Transform"};
+    static_assert(WD_ARRAY_SIZE(s_szPhaseNames) == wdWorldModule::UpdateFunctionDesc::Phase::COUNT);
+
+    wdStringBuilder sStatName;
+    sStatName.Format("World Update/{0}/{1} Phase/Critical Path", m_Data.m_sName, s_szPhaseNames[phase]);
+    wdStats::SetStat(sStatName, criticalPath);
+
+    sStatName.Format("World Update/{0}/{1} Phase/Concurrent Functions Time", m_Data.m_sName, s_szPhaseNames[phase]);
+    wdStats::SetStat(sStatName, totalConcurrentTime);
+  }
+}
+
+void wdWorld::UpdateConcurrently(wdWorldModule::UpdateFunctionDesc::Phase::Enum phase, wdUInt32 uiFirstFunction, wdUInt32 uiEndFunction, wdTime& inout_criticalPath, wdTime& inout_totalTime)
+{
+  WD_PROFILE_SCOPE("Concurrent Update Functions");
+
+  const wdDynamicArrayBase<wdInternal::WorldData::RegisteredUpdateFunction>& updateFunctions = m_Data.m_UpdateFunctions[phase];
+  const wdInternal::WorldData::UpdateGraph& graph = m_Data.m_UpdateGraphs[phase];
+
+  const wdUInt32 uiNumFunctions = uiEndFunction - uiFirstFunction;
+
+  wdHybridArray<wdTaskGroupID, 32> taskGroups;
+  taskGroups.SetCount(uiNumFunctions);
+
+  wdHybridArray<wdTaskGroupDependency, 64> dependencies;
+
+  for (wdUInt32 i = 0; i < uiNumFunctions; ++i)
+  {
+    const auto& updateFunction = updateFunctions[uiFirstFunction + i];
+
+    wdSharedPtr<wdInternal::WorldData::UpdateTask> pTask;
+    if (i < m_Data.m_UpdateTasks.GetCount())
+    {
+      pTask = m_Data.m_UpdateTasks[i];
+    }
+    else
+    {
+      pTask = WD_NEW(&m_Data.m_Allocator, wdInternal::WorldData::UpdateTask);
+      m_Data.m_UpdateTasks.PushBack(pTask);
+    }
+
+    pTask->ConfigureTask(updateFunction.m_sFunctionName, wdTaskNesting::Maybe);
+    pTask->m_uiStartIndex = 0;
+    pTask->m_uiCount = wdInvalidIndex;
+
+    // skipped functions still get a task, otherwise the dependencies that go through them would be lost
+    if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
+      pTask->m_Function = wdWorldModule::UpdateFunction();
+    else
+      pTask->m_Function = updateFunction.m_Function;
+
+    taskGroups[i] = wdTaskSystem::CreateTaskGroup(wdTaskPriority::EarlyThisFrame);
+    wdTaskSystem::AddTaskToGroup(taskGroups[i], pTask);
+
+    const wdInternal::WorldData::UpdateGraph::Node& node = graph.m_Nodes[uiFirstFunction + i];
+    for (wdUInt32 d = 0; d < node.m_uiNumDependencies; ++d)
+    {
+      auto& dependency = dependencies.ExpandAndGetRef();
+      dependency.m_TaskGroup = taskGroups[i];
+      dependency.m_DependsOn = taskGroups[graph.m_Dependencies[node.m_uiFirstDependency + d] - uiFirstFunction];
     }
   }
+
+  wdTaskSystem::AddTaskGroupDependencyBatch(dependencies);
+
+  // remove write marker but keep the read marker, same as in the async phase
+  m_Data.m_WriteThreadID = (wdThreadID)0;
+
+  wdTaskSystem::StartTaskGroupBatch(taskGroups);
+
+  for (const wdTaskGroupID& taskGroup : taskGroups)
+  {
+    wdTaskSystem::WaitForGroup(taskGroup);
+  }
+
+  // restore write marker
+  m_Data.m_WriteThreadID = wdThreadUtils::GetCurrentThreadID();
+
+  // The longest chain of dependent functions determines how long this segment takes at least, no matter how many threads are available.
+  wdTime criticalPath;
+  {
+    wdHybridArray<wdTime, 32> finishTimes;
+    finishTimes.SetCount(uiNumFunctions);
+
+    for (wdUInt32 i = 0; i < uiNumFunctions; ++i)
+    {
+      const wdInternal::WorldData::UpdateGraph::Node& node = graph.m_Nodes[uiFirstFunction + i];
+
+      wdTime startTime;
+      for (wdUInt32 d = 0; d < node.m_uiNumDependencies; ++d)
+      {
+        startTime = wdMath::Max(startTime, finishTimes[graph.m_Dependencies[node.m_uiFirstDependency + d] - uiFirstFunction]);
+      }
+
+      const wdTime duration = m_Data.m_UpdateTasks[i]->m_Duration;
+      finishTimes[i] = startTime + duration;
+
+      criticalPath = wdMath::Max(criticalPath, finishTimes[i]);
+      inout_totalTime += duration;
+    }
+  }
+
+  inout_criticalPath += criticalPath;
 }
 
 void wdWorld::UpdateAsynchronous()
@@ -1301,6 +1532,7 @@ wdResult wdWorld::RegisterUpdateFunctionInternal(const wdWorldModule::UpdateFunc
   }
 
   updateFunctions.Insert(newFunction, uiInsertionIndex);
+  m_Data.m_UpdateGraphs[desc.m_Phase.GetValue()].m_bDirty = true;
 
   return WD_SUCCESS;
 }
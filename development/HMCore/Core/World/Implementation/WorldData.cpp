@@ -1,5 +1,6 @@
 #include <Core/CorePCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 
@@ -31,7 +32,95 @@ namespace wdInternal
     context.m_uiFirstComponentIndex = m_uiStartIndex;
     context.m_uiComponentCount = m_uiCount;
 
-    m_Function(context);
+    const wdTime startTime = wdTime::Now();
+
+    // the function is invalid if it is skipped this frame but other tasks still depend on this one
+    if (m_Function.IsValid())
+    {
+      m_Function(context);
+    }
+
+    m_Duration = wdTime::Now() - startTime;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  namespace
+  {
+    bool HasRelatedType(const wdArrayPtr<const wdRTTI* const>& types, const wdArrayPtr<const wdRTTI* const>& otherTypes)
+    {
+      for (const wdRTTI* pType : types)
+      {
+        for (const wdRTTI* pOtherType : otherTypes)
+        {
+          if (pType->IsDerivedFrom(pOtherType) || pOtherType->IsDerivedFrom(pType))
+            return true;
+        }
+      }
+
+      return false;
+    }
+
+    bool HasAccessConflict(wdBitflags<wdUpdateFunctionDataAccess> a, wdBitflags<wdUpdateFunctionDataAccess> b, wdUpdateFunctionDataAccess::Enum read, wdUpdateFunctionDataAccess::Enum write)
+    {
+      return (a.IsSet(write) && b.IsAnySet(read | write)) || (b.IsSet(write) && a.IsSet(read));
+    }
+  } // namespace
+
+  bool WorldData::RegisteredUpdateFunction::ConflictsWith(const RegisteredUpdateFunction& other) const
+  {
+    if (HasAccessConflict(m_DataAccess, other.m_DataAccess, wdUpdateFunctionDataAccess::ReadTransforms, wdUpdateFunctionDataAccess::WriteTransforms) ||
+        HasAccessConflict(m_DataAccess, other.m_DataAccess, wdUpdateFunctionDataAccess::ReadSpatialData, wdUpdateFunctionDataAccess::WriteSpatialData))
+    {
+      return true;
+    }
+
+    return HasRelatedType(m_WriteComponentTypes, other.m_WriteComponentTypes) ||
+           HasRelatedType(m_WriteComponentTypes, other.m_ReadComponentTypes) ||
+           HasRelatedType(m_ReadComponentTypes, other.m_WriteComponentTypes);
+  }
+
+  void WorldData::BuildUpdateGraph(wdWorldModule::UpdateFunctionDesc::Phase::Enum phase)
+  {
+    const auto& updateFunctions = m_UpdateFunctions[phase];
+    UpdateGraph& graph = m_UpdateGraphs[phase];
+
+    graph.m_Nodes.SetCountUninitialized(updateFunctions.GetCount());
+    graph.m_Dependencies.Clear();
+    graph.m_bDirty = false;
+
+    wdUInt32 uiSegmentStart = 0;
+    for (wdUInt32 i = 0; i < updateFunctions.GetCount(); ++i)
+    {
+      const RegisteredUpdateFunction& updateFunction = updateFunctions[i];
+      UpdateGraph::Node& node = graph.m_Nodes[i];
+      node.m_uiFirstDependency = graph.m_Dependencies.GetCount();
+      node.m_uiNumDependencies = 0;
+
+      if (!updateFunction.m_bCanRunConcurrently)
+      {
+        node.m_uiSegmentEnd = i + 1;
+        uiSegmentStart = i + 1;
+        continue;
+      }
+
+      // functions outside of the segment have already been executed at this point
+      for (wdUInt32 j = uiSegmentStart; j < i; ++j)
+      {
+        const RegisteredUpdateFunction& otherFunction = updateFunctions[j];
+
+        if (updateFunction.m_DependsOn.Contains(otherFunction.m_sFunctionName) || updateFunction.ConflictsWith(otherFunction))
+        {
+          graph.m_Dependencies.PushBack(j);
+          ++node.m_uiNumDependencies;
+        }
+      }
+
+      for (wdUInt32 j = uiSegmentStart; j <= i; ++j)
+      {
+        graph.m_Nodes[j].m_uiSegmentEnd = i + 1;
+      }
+    }
   }
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -42,6 +131,7 @@ namespace wdInternal
     , m_AllocatorWrapper(&m_Allocator)
     , m_BlockAllocator(desc.m_sName, &m_Allocator)
     , m_StackAllocator(desc.m_sName, wdFoundation::GetAlignedAllocator())
+    , m_MessageAllocator(wdStringBuilder(desc.m_sName.GetView(), " Messages"), wdFoundation::GetAlignedAllocator())
     , m_ObjectStorage(&m_BlockAllocator, &m_Allocator)
     , m_MaxInitializationTimePerFrame(desc.m_MaxComponentInitializationTimePerFrame)
     , m_Clock(desc.m_sName)
@@ -86,7 +176,14 @@ namespace wdInternal
 
     if (m_pSpatialSystem == nullptr && desc.m_bAutoCreateSpatialSystem)
     {
-      m_pSpatialSystem = WD_NEW(wdFoundation::GetAlignedAllocator(), wdSpatialSystem_RegularGrid);
+      if (desc.m_AutoCreatedSpatialSystemType == wdSpatialSystemType::LooseOctree)
+      {
+        m_pSpatialSystem = WD_NEW(wdFoundation::GetAlignedAllocator(), wdSpatialSystem_LooseOctree);
+      }
+      else
+      {
+        m_pSpatialSystem = WD_NEW(wdFoundation::GetAlignedAllocator(), wdSpatialSystem_RegularGrid);
+      }
     }
 
     if (m_pCoordinateSystemProvider == nullptr)
@@ -167,6 +264,11 @@ namespace wdInternal
 
         // The messages in this queue are allocated through a frame allocator and thus mustn't (and don't need to be) deallocated
         queue.Clear();
+
+        for (MessagePostBuffer& buffer : m_MessagePostBuffers)
+        {
+          buffer.m_Messages[i].Clear();
+        }
       }
 
       {
@@ -182,6 +284,153 @@ namespace wdInternal
     }
   }
 
+  namespace
+  {
+    // Every thread that posts messages claims one slot, which is the index of its post buffer in all worlds.
+    // The slot is released when the thread exits. The next thread that claims it appends to the same buffers, messages that are still
+    // in there are delivered as usual.
+    wdAtomicInteger64 s_iUsedMessagePostSlots;
+
+    static_assert(WorldData::MAX_MESSAGE_POST_THREADS <= 64, "The used message post slots are stored in a 64 bit mask");
+    constexpr wdUInt64 AllMessagePostSlotsUsed = WorldData::MAX_MESSAGE_POST_THREADS == 64 ? ~0ull : (1ull << WorldData::MAX_MESSAGE_POST_THREADS) - 1;
+
+    wdUInt32 ClaimMessagePostSlot()
+    {
+      wdInt64 iUsedSlots = s_iUsedMessagePostSlots;
+
+      while (static_cast<wdUInt64>(iUsedSlots) != AllMessagePostSlotsUsed)
+      {
+        const wdUInt32 uiSlot = wdMath::FirstBitLow(~static_cast<wdUInt64>(iUsedSlots));
+        const wdInt64 iPrevUsedSlots = s_iUsedMessagePostSlots.CompareAndSwap(iUsedSlots, iUsedSlots | static_cast<wdInt64>(1ull << uiSlot));
+
+        if (iPrevUsedSlots == iUsedSlots)
+          return uiSlot;
+
+        iUsedSlots = iPrevUsedSlots;
+      }
+
+      return WorldData::MAX_MESSAGE_POST_THREADS;
+    }
+
+    struct ThreadMessagePostSlot
+    {
+      ~ThreadMessagePostSlot()
+      {
+        if (m_uiSlot < WorldData::MAX_MESSAGE_POST_THREADS)
+        {
+          s_iUsedMessagePostSlots.And(~static_cast<wdInt64>(1ull << m_uiSlot));
+        }
+      }
+
+      wdUInt32 m_uiSlot = wdInvalidIndex;
+    };
+
+    thread_local ThreadMessagePostSlot tl_MessagePostSlot;
+
+    WD_ALWAYS_INLINE wdUInt32 GetMessagePostSlot()
+    {
+      ThreadMessagePostSlot& slot = tl_MessagePostSlot;
+
+      // threads that use the locked message queues take over a slot of their own as soon as one becomes free
+      if (slot.m_uiSlot >= WorldData::MAX_MESSAGE_POST_THREADS && (slot.m_uiSlot == wdInvalidIndex || static_cast<wdUInt64>(s_iUsedMessagePostSlots) != AllMessagePostSlotsUsed))
+      {
+        slot.m_uiSlot = ClaimMessagePostSlot();
+      }
+
+      return slot.m_uiSlot;
+    }
+  } // namespace
+
+  void WorldData::EnqueueMessage(wdMessage* pMessage, const QueuedMsgMetaData& metaData, wdObjectMsgQueueType::Enum queueType) const
+  {
+    const wdUInt32 uiSlot = GetMessagePostSlot();
+    if (uiSlot < MAX_MESSAGE_POST_THREADS)
+    {
+      MessageQueue::Entry& entry = m_MessagePostBuffers[uiSlot].m_Messages[queueType].ExpandAndGetRef();
+      entry.m_pMessage = pMessage;
+      entry.m_MetaData = metaData;
+      entry.m_uiMessageHash = 0;
+    }
+    else
+    {
+      m_MessageQueues[queueType].Enqueue(pMessage, metaData);
+    }
+  }
+
+  void WorldData::CollectQueuedMessages(wdObjectMsgQueueType::Enum queueType)
+  {
+    struct MessageComparer
+    {
+      // Messages with the same due time and sorting key are grouped by receiver, i.e. by component type and then by storage index,
+      // so that delivery walks through the component managers in memory order. The message type and the full receiver data
+      // (including the generation) only break ties to keep the order deterministic.
+      WD_FORCE_INLINE bool Less(const SortedMessage& a, const SortedMessage& b) const
+      {
+        if (a.m_Entry.m_MetaData.m_Due != b.m_Entry.m_MetaData.m_Due)
+          return a.m_Entry.m_MetaData.m_Due < b.m_Entry.m_MetaData.m_Due;
+
+        if (a.m_iSortingKey != b.m_iSortingKey)
+          return a.m_iSortingKey < b.m_iSortingKey;
+
+        if (a.m_uiReceiverKey != b.m_uiReceiverKey)
+          return a.m_uiReceiverKey < b.m_uiReceiverKey;
+
+        if (a.m_MessageId != b.m_MessageId)
+          return a.m_MessageId < b.m_MessageId;
+
+        if (a.m_Entry.m_MetaData.m_uiReceiverData != b.m_Entry.m_MetaData.m_uiReceiverData)
+          return a.m_Entry.m_MetaData.m_uiReceiverData < b.m_Entry.m_MetaData.m_uiReceiverData;
+
+        if (a.m_Entry.m_uiMessageHash == 0)
+        {
+          a.m_Entry.m_uiMessageHash = a.m_Entry.m_pMessage->GetHash();
+        }
+
+        if (b.m_Entry.m_uiMessageHash == 0)
+        {
+          b.m_Entry.m_uiMessageHash = b.m_Entry.m_pMessage->GetHash();
+        }
+
+        return a.m_Entry.m_uiMessageHash < b.m_Entry.m_uiMessageHash;
+      }
+    };
+
+    m_MessageBatch.Clear();
+
+    auto AddToBatch = [this](const MessageQueue::Entry& entry) {
+      // game object and component ids both store the generation in the 8 bits above the instance index,
+      // the component type id is stored above that, so the remaining bits order by type first and then by index
+      constexpr wdUInt64 uiReceiverGenerationMask = wdUInt64(0xFF) << 32;
+
+      SortedMessage& sortedMessage = m_MessageBatch.ExpandAndGetRef();
+      sortedMessage.m_iSortingKey = entry.m_pMessage->GetSortingKey();
+      sortedMessage.m_MessageId = entry.m_pMessage->GetId();
+      sortedMessage.m_uiReceiverKey = entry.m_MetaData.m_uiReceiverData & ~uiReceiverGenerationMask;
+      sortedMessage.m_bCanBeDeliveredInParallel = entry.m_MetaData.m_uiReceiverIsComponent && entry.m_pMessage->CanBeDeliveredInParallel();
+      sortedMessage.m_Entry = entry;
+    };
+
+    for (MessagePostBuffer& buffer : m_MessagePostBuffers)
+    {
+      for (const MessageQueue::Entry& entry : buffer.m_Messages[queueType])
+      {
+        AddToBatch(entry);
+      }
+
+      buffer.m_Messages[queueType].Clear();
+    }
+
+    MessageQueue& queue = m_MessageQueues[queueType];
+    for (wdUInt32 i = 0; i < queue.GetCount(); ++i)
+    {
+      AddToBatch(queue[i]);
+    }
+
+    queue.Clear();
+
+    m_MessageBatch.Sort(MessageComparer());
+  }
+
   wdGameObject::TransformationData* WorldData::CreateTransformationData(bool bDynamic, wdUInt32 uiHierarchyLevel)
   {
     Hierarchy& hierarchy = m_Hierarchies[GetHierarchyType(bDynamic)];
@@ -306,11 +555,13 @@ namespace wdInternal
     {
       wdSimdFloat m_fInvDt;
       wdSpatialSystem* m_pSpatialSystem;
+      DeferredSpatialDataUpdates* m_pDeferredUpdates;
     };
 
     UserData userData;
     userData.m_fInvDt = fInvDeltaSeconds;
     userData.m_pSpatialSystem = m_pSpatialSystem.Borrow();
+    userData.m_pDeferredUpdates = &m_DeferredSpatialDataUpdates;
 
     struct RootLevel
     {
@@ -334,7 +585,8 @@ namespace wdInternal
     {
       WD_ALWAYS_INLINE static wdVisitorExecution::Enum Visit(wdGameObject::TransformationData* pData, void* pUserData)
       {
-        WorldData::UpdateGlobalTransformAndSpatialData(pData, static_cast<UserData*>(pUserData)->m_fInvDt, *static_cast<UserData*>(pUserData)->m_pSpatialSystem);
+        UserData* pData2 = static_cast<UserData*>(pUserData);
+        WorldData::UpdateGlobalTransformAndSpatialData(pData, pData2->m_fInvDt, *pData2->m_pSpatialSystem, *pData2->m_pDeferredUpdates);
         return wdVisitorExecution::Continue;
       }
     };
@@ -343,7 +595,8 @@ namespace wdInternal
     {
       WD_ALWAYS_INLINE static wdVisitorExecution::Enum Visit(wdGameObject::TransformationData* pData, void* pUserData)
       {
-        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, static_cast<UserData*>(pUserData)->m_fInvDt, *static_cast<UserData*>(pUserData)->m_pSpatialSystem);
+        UserData* pData2 = static_cast<UserData*>(pUserData);
+        WorldData::UpdateGlobalTransformWithParentAndSpatialData(pData, pData2->m_fInvDt, *pData2->m_pSpatialSystem, *pData2->m_pDeferredUpdates);
         return wdVisitorExecution::Continue;
       }
     };
@@ -353,8 +606,6 @@ namespace wdInternal
     {
       auto dataPtr = hierarchy.m_Data.GetData();
 
-      // If we have no spatial system, we perform multi-threaded update as we do not
-      // have to acquire a write lock in the process.
       if (m_pSpatialSystem == nullptr)
       {
         TraverseHierarchyLevelMultiThreaded<RootLevel>(*dataPtr[0], &userData);
@@ -366,16 +617,53 @@ namespace wdInternal
       }
       else
       {
-        TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
+        // Transforms and bounds are computed in parallel. Spatial data that stays within its cell is updated in place,
+        // everything else needs a write access to the spatial system and is applied afterwards on this thread.
+        wdUInt32 uiNumObjects = 0;
+        for (wdUInt32 i = 0; i < hierarchy.m_Data.GetCount(); ++i)
+        {
+          for (const auto& block : *dataPtr[i])
+          {
+            uiNumObjects += block.m_uiCount;
+          }
+        }
+
+        m_DeferredSpatialDataUpdates.m_Data.SetCountUninitialized(uiNumObjects);
+        m_DeferredSpatialDataUpdates.m_iCount = 0;
+
+        TraverseHierarchyLevelMultiThreaded<RootLevelWithSpatialData>(*dataPtr[0], &userData);
 
         for (wdUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
         {
-          TraverseHierarchyLevel<WithParentWithSpatialData>(*dataPtr[i], &userData);
+          TraverseHierarchyLevelMultiThreaded<WithParentWithSpatialData>(*dataPtr[i], &userData);
         }
+
+        ApplyDeferredSpatialDataUpdates();
       }
     }
   }
 
+  void WorldData::ApplyDeferredSpatialDataUpdates()
+  {
+    const wdUInt32 uiNumUpdates = m_DeferredSpatialDataUpdates.m_iCount;
+    if (uiNumUpdates == 0)
+      return;
+
+    WD_PROFILE_SCOPE("ApplyDeferredSpatialDataUpdates");
+
+    wdArrayPtr<wdGameObject::TransformationData*> updates = m_DeferredSpatialDataUpdates.m_Data.GetArrayPtr().GetSubArray(0, uiNumUpdates);
+
+    // The order in which the tasks found these depends on thread timing,
+    // sort them so that the spatial system ends up in the same state every time.
+    wdSorting::QuickSort(updates, [](const wdGameObject::TransformationData* a, const wdGameObject::TransformationData* b)
+      { return a->m_hSpatialData.GetInternalID() < b->m_hSpatialData.GetInternalID(); });
+
+    for (wdGameObject::TransformationData* pData : updates)
+    {
+      m_pSpatialSystem->UpdateSpatialDataBounds(pData->m_hSpatialData, pData->m_globalBounds);
+    }
+  }
+
 } // namespace wdInternal
 
 
@@ -29,6 +29,7 @@ namespace wdInternal
     wdLocalAllocatorWrapper m_AllocatorWrapper;
     wdInternal::WorldLargeBlockAllocator m_BlockAllocator;
     wdDoubleBufferedStackAllocator m_StackAllocator;
+    mutable wdDoubleBufferedThreadLocalStackAllocator m_MessageAllocator; ///< Posted messages without a delay, every thread allocates without a lock.
 
     enum
     {
@@ -136,10 +137,23 @@ namespace wdInternal
     static void UpdateGlobalTransform(wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds);
     static void UpdateGlobalTransformWithParent(wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds);
 
-    static void UpdateGlobalTransformAndSpatialData(wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem);
-    static void UpdateGlobalTransformWithParentAndSpatialData(wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem);
+    // Spatial data that could not be updated in place during the multi-threaded global transform update.
+    // The array is sized up front to the number of dynamic objects, so tasks only need to atomically reserve a slot.
+    struct DeferredSpatialDataUpdates
+    {
+      wdDynamicArray<wdGameObject::TransformationData*> m_Data;
+      wdAtomicInteger32 m_iCount;
+
+      void Add(wdGameObject::TransformationData* pData) { m_Data[m_iCount.PostIncrement()] = pData; }
+    };
+
+    static void UpdateGlobalTransformAndSpatialData(wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem, DeferredSpatialDataUpdates& ref_deferredUpdates);
+    static void UpdateGlobalTransformWithParentAndSpatialData(wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem, DeferredSpatialDataUpdates& ref_deferredUpdates);
 
     void UpdateGlobalTransforms(float fInvDeltaSeconds);
+    void ApplyDeferredSpatialDataUpdates();
+
+    DeferredSpatialDataUpdates m_DeferredSpatialDataUpdates;
 
     // game object lookups
     wdHashTable<wdUInt64, wdGameObjectId, wdHashHelper<wdUInt64>, wdLocalAllocatorWrapper> m_GlobalKeyToIdTable;
@@ -178,9 +192,17 @@ namespace wdInternal
       float m_fPriority;
       wdUInt16 m_uiGranularity;
       bool m_bOnlyUpdateWhenSimulating;
+      bool m_bCanRunConcurrently;
+      wdBitflags<wdUpdateFunctionDataAccess> m_DataAccess;
+      wdHybridArray<wdHashedString, 4> m_DependsOn;
+      wdHybridArray<const wdRTTI*, 2> m_ReadComponentTypes;
+      wdHybridArray<const wdRTTI*, 2> m_WriteComponentTypes;
 
       void FillFromDesc(const wdWorldModule::UpdateFunctionDesc& desc);
       bool operator<(const RegisteredUpdateFunction& other) const;
+
+      /// \brief Returns true if both functions access the same data and at least one of them writes it.
+      bool ConflictsWith(const RegisteredUpdateFunction& other) const;
     };
 
     struct UpdateTask final : public wdTask
@@ -190,9 +212,31 @@ namespace wdInternal
       wdWorldModule::UpdateFunction m_Function;
       wdUInt32 m_uiStartIndex;
       wdUInt32 m_uiCount;
+      wdTime m_Duration;
+    };
+
+    // Dependency graph of the synchronous update functions of one phase. Consecutive functions that can run concurrently form a segment,
+    // within a segment a function depends on all earlier functions it conflicts with. Rebuilt whenever the update functions change.
+    struct UpdateGraph
+    {
+      struct Node
+      {
+        WD_DECLARE_POD_TYPE();
+
+        wdUInt32 m_uiSegmentEnd;
+        wdUInt32 m_uiFirstDependency;
+        wdUInt32 m_uiNumDependencies;
+      };
+
+      wdDynamicArray<Node, wdLocalAllocatorWrapper> m_Nodes;
+      wdDynamicArray<wdUInt32, wdLocalAllocatorWrapper> m_Dependencies;
+      bool m_bDirty = true;
     };
 
+    void BuildUpdateGraph(wdWorldModule::UpdateFunctionDesc::Phase::Enum phase);
+
     wdDynamicArray<RegisteredUpdateFunction, wdLocalAllocatorWrapper> m_UpdateFunctions[wdWorldModule::UpdateFunctionDesc::Phase::COUNT];
+    UpdateGraph m_UpdateGraphs[wdWorldModule::UpdateFunctionDesc::Phase::COUNT];
     wdDynamicArray<wdWorldModule::UpdateFunctionDesc, wdLocalAllocatorWrapper> m_UpdateFunctionsToRegister;
 
     wdDynamicArray<wdSharedPtr<UpdateTask>, wdLocalAllocatorWrapper> m_UpdateTasks;
@@ -232,6 +276,43 @@ namespace wdInternal
     mutable MessageQueue m_MessageQueues[wdObjectMsgQueueType::COUNT];
     mutable MessageQueue m_TimedMessageQueues[wdObjectMsgQueueType::COUNT];
 
+    /// \brief The messages without a delay that one thread has posted. Only that thread adds to it, so posting does not need a lock.
+    ///
+    /// The buffers of all threads are emptied when a queue is processed, no other thread may post messages at that time.
+    struct MessagePostBuffer
+    {
+      wdDynamicArray<MessageQueue::Entry, wdLocalAllocatorWrapper> m_Messages[wdObjectMsgQueueType::COUNT];
+    };
+
+  public:
+    enum
+    {
+      MAX_MESSAGE_POST_THREADS = 64
+    };
+
+  private:
+    // Only MAX_MESSAGE_POST_THREADS threads that post messages at the same time get a buffer, all others use the locked message queues.
+    mutable MessagePostBuffer m_MessagePostBuffers[MAX_MESSAGE_POST_THREADS];
+
+    void EnqueueMessage(wdMessage* pMessage, const QueuedMsgMetaData& metaData, wdObjectMsgQueueType::Enum queueType) const;
+
+    /// \brief A queued message together with its sorting keys, which are computed once before sorting.
+    struct SortedMessage
+    {
+      WD_DECLARE_POD_TYPE();
+
+      wdInt32 m_iSortingKey;
+      wdMessageId m_MessageId;
+      wdUInt64 m_uiReceiverKey; ///< The receiver data without the generation, so receivers are ordered by component type and storage index.
+      bool m_bCanBeDeliveredInParallel;
+      MessageQueue::Entry m_Entry;
+    };
+
+    wdDynamicArray<SortedMessage, wdLocalAllocatorWrapper> m_MessageBatch;
+
+    /// \brief Moves all messages that were posted to the given queue into m_MessageBatch and sorts them for delivery.
+    void CollectQueuedMessages(wdObjectMsgQueueType::Enum queueType);
+
     wdThreadID m_WriteThreadID;
     wdInt32 m_iWriteCounter = 0;
     mutable wdAtomicInteger32 m_iReadCounter;
@@ -77,20 +77,28 @@ namespace wdInternal
 
   // static
   WD_FORCE_INLINE void WorldData::UpdateGlobalTransformAndSpatialData(
-    wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem)
+    wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem, DeferredSpatialDataUpdates& ref_deferredUpdates)
   {
     pData->UpdateGlobalTransformWithoutParent();
     pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+
+    if (!pData->UpdateGlobalBoundsAndSpatialDataInPlace(spatialSystem))
+    {
+      ref_deferredUpdates.Add(pData);
+    }
   }
 
   // static
   WD_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndSpatialData(
-    wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem)
+    wdGameObject::TransformationData* pData, const wdSimdFloat& fInvDeltaSeconds, wdSpatialSystem& spatialSystem, DeferredSpatialDataUpdates& ref_deferredUpdates)
   {
     pData->UpdateGlobalTransformWithParent();
     pData->UpdateVelocity(fInvDeltaSeconds);
-    pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
+
+    if (!pData->UpdateGlobalBoundsAndSpatialDataInPlace(spatialSystem))
+    {
+      ref_deferredUpdates.Add(pData);
+    }
   }
 
   ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -174,6 +182,17 @@ namespace wdInternal
     m_fPriority = desc.m_fPriority;
     m_uiGranularity = desc.m_uiGranularity;
     m_bOnlyUpdateWhenSimulating = desc.m_bOnlyUpdateWhenSimulating;
+    m_bCanRunConcurrently = desc.m_bCanRunConcurrently;
+    m_DataAccess = desc.m_DataAccess;
+    m_DependsOn = desc.m_DependsOn;
+    m_ReadComponentTypes = desc.m_ReadComponentTypes;
+    m_WriteComponentTypes = desc.m_WriteComponentTypes;
+
+    // moving a static object immediately updates its spatial data
+    if (m_DataAccess.IsSet(wdUpdateFunctionDataAccess::WriteTransforms))
+    {
+      m_DataAccess.Add(wdUpdateFunctionDataAccess::WriteSpatialData);
+    }
   }
 
   WD_FORCE_INLINE bool WorldData::RegisteredUpdateFunction::operator<(const RegisteredUpdateFunction& other) const
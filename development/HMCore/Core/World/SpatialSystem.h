@@ -27,6 +27,15 @@ public:
   virtual void UpdateSpatialDataBounds(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds) = 0;
   virtual void UpdateSpatialDataObject(const wdSpatialDataHandle& hData, wdGameObject* pObject) = 0;
 
+  /// \brief Tries to update the bounds of the given spatial data without modifying any internal structures of the spatial system.
+  ///
+  /// This is called from multiple threads at the same time during the world's global transform update, though never for the same spatial data
+  /// and never concurrently with any other function of the spatial system.
+  /// Returns false, if the bounds could not be updated in place (e.g. because the data has to move to another cell).
+  /// In that case UpdateSpatialDataBounds() gets called afterwards from a single thread.
+  /// The default implementation always returns false.
+  virtual bool UpdateSpatialDataBoundsInPlace(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds);
+
   ///@}
   /// \name Simple Queries
   ///@{
@@ -63,7 +72,10 @@ public:
   /// \name Visibility Queries
   ///@{
 
-  using IsOccludedFunc = wdDelegate<bool(const wdSimdBBox&)>;
+  /// \brief Tests a batch of boxes for occlusion and writes true into out_occluded for every box that is fully hidden.
+  ///
+  /// The spatial systems pass the candidates of a whole group of objects at once, cells and nodes are tested one at a time.
+  using IsOccludedFunc = wdDelegate<void(wdArrayPtr<const wdSimdBBox> boxes, wdArrayPtr<bool> out_occluded)>;
 
   virtual void FindVisibleObjects(const wdFrustum& frustum, const QueryParams& queryParams, wdDynamicArray<const wdGameObject*>& out_objects, IsOccludedFunc isOccluded, wdVisibilityState visType) const = 0;
 
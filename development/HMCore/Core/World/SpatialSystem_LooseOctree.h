@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief A spatial system that stores objects in a sparse loose octree per spatial data category.
+///
+/// Every node's bounds are twice as large as its regular octree cell, so an object is stored in the deepest node that contains its center
+/// and is at least as large as the object. Nodes are only subdivided once they hold more than a given number of objects and empty leaf nodes
+/// are removed again, so the tree adapts to the local object density: dense areas get deep trees, sparse areas only a few large nodes.
+/// This avoids both the overfull cells and the many nearly empty cells that a fixed cell size produces when the density varies a lot.
+///
+/// Objects that are not contained in the root node are kept in the root node.
+class WD_CORE_DLL wdSpatialSystem_LooseOctree : public wdSpatialSystem
+{
+  WD_ADD_DYNAMIC_REFLECTION(wdSpatialSystem_LooseOctree, wdSpatialSystem);
+
+public:
+  /// \brief Creates the spatial system.
+  ///
+  /// \param fWorldSize The edge length of the root node's cell, which is centered at the origin.
+  /// \param fMinNodeSize Nodes with a smaller cell edge length are not subdivided any further.
+  /// \param uiSplitThreshold A node only gets children once it holds more objects than this.
+  wdSpatialSystem_LooseOctree(float fWorldSize = 65536.0f, float fMinNodeSize = 16.0f, wdUInt32 uiSplitThreshold = 32);
+  ~wdSpatialSystem_LooseOctree();
+
+  /// \brief Returns the loose bounding box of the node that contains the given spatial data. Useful for debug visualizations.
+  wdResult GetNodeBoxForSpatialData(const wdSpatialDataHandle& hData, wdBoundingBox& out_boundingBox) const;
+
+  /// \brief Returns the loose bounding boxes of all existing nodes except the root node.
+  void GetAllNodeBoxes(wdDynamicArray<wdBoundingBox>& out_boundingBoxes, wdSpatialData::Category filterCategory = wdInvalidSpatialDataCategory) const;
+
+private:
+  // wdSpatialSystem implementation
+  wdSpatialDataHandle CreateSpatialData(const wdSimdBBoxSphere& bounds, wdGameObject* pObject, wdUInt32 uiCategoryBitmask, const wdTagSet& tags) override;
+  wdSpatialDataHandle CreateSpatialDataAlwaysVisible(wdGameObject* pObject, wdUInt32 uiCategoryBitmask, const wdTagSet& tags) override;
+
+  void DeleteSpatialData(const wdSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataObject(const wdSpatialDataHandle& hData, wdGameObject* pObject) override;
+  bool UpdateSpatialDataBoundsInPlace(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds) override;
+
+  void FindObjectsInSphere(const wdBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const wdBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindVisibleObjects(const wdFrustum& frustum, const QueryParams& queryParams, wdDynamicArray<const wdGameObject*>& out_Objects, wdSpatialSystem::IsOccludedFunc IsOccluded, wdVisibilityState visType) const override;
+
+  wdVisibilityState GetVisibilityState(const wdSpatialDataHandle& hData, wdUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(wdStringBuilder& sb) const override;
+#endif
+
+  wdProxyAllocator m_AlignedAllocator;
+
+  float m_fRootHalfSize;
+  wdUInt32 m_uiMaxDepth;
+  wdUInt32 m_uiSplitThreshold;
+
+  enum
+  {
+    MAX_NUM_TREES = (sizeof(wdSpatialData::Category::m_uiValue) * 8)
+  };
+
+  struct Node;
+  struct Tree;
+  wdDynamicArray<wdUniquePtr<Tree>> m_Trees;
+
+  struct Data
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiCategoryBitmask;
+    wdUInt32 m_uiAlwaysVisible;
+  };
+
+  wdIdTable<wdSpatialDataId, Data, wdLocalAllocatorWrapper> m_DataTable;
+
+  struct NodeDataMapping;
+
+  wdSpatialDataHandle AddSpatialDataToTrees(const wdSimdBBoxSphere& bounds, wdGameObject* pObject, wdUInt32 uiCategoryBitmask, const wdTagSet& tags, bool bAlwaysVisible);
+
+  template <typename Functor>
+  void ForEachTree(const Data& data, const wdSpatialDataHandle& hData, Functor func) const;
+
+  struct Stats;
+
+  template <typename TreeFunctor>
+  void ForEachTreeInQuery(const QueryParams& queryParams, TreeFunctor func) const;
+};
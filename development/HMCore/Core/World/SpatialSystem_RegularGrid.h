@@ -37,6 +37,7 @@ private:
 
   void UpdateSpatialDataBounds(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds) override;
   void UpdateSpatialDataObject(const wdSpatialDataHandle& hData, wdGameObject* pObject) override;
+  bool UpdateSpatialDataBoundsInPlace(const wdSpatialDataHandle& hData, const wdSimdBBoxSphere& bounds) override;
 
   void FindObjectsInSphere(const wdBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
   void FindObjectsInBox(const wdBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
@@ -18,6 +18,9 @@ class wdEventMessageHandlerComponent;
 /// * Actual deletion of dead objects and components are done now.
 /// * Transform update: The global transformation of dynamic objects is updated.
 /// * Post-transform phase: Another synchronous phase like the pre-async phase after the transformation has been updated.
+///
+/// Synchronous update functions that are marked with wdWorldModule::UpdateFunctionDesc::m_bCanRunConcurrently are executed on multiple
+/// threads, as long as they don't depend on each other or access the same data.
 class WD_CORE_DLL wdWorld final
 {
 public:
@@ -369,6 +372,8 @@ private:
   void PostMessage(const wdGameObjectHandle& receiverObject, const wdMessage& msg, wdObjectMsgQueueType::Enum queueType, wdTime delay, bool bRecursive) const;
   void ProcessQueuedMessage(const wdInternal::WorldData::MessageQueue::Entry& entry);
   void ProcessQueuedMessages(wdObjectMsgQueueType::Enum queueType);
+  void DeliverQueuedMessages(wdArrayPtr<const wdInternal::WorldData::SortedMessage> messages);
+  void DeliverQueuedMessagesInParallel(wdArrayPtr<const wdInternal::WorldData::SortedMessage> messages);
 
   template <typename World, typename GameObject, typename Component>
   static void FindEventMsgHandlers(World& world, const wdMessage& msg, GameObject pSearchObject, wdDynamicArray<Component>& out_components);
@@ -381,7 +386,8 @@ private:
   void AddComponentToInitialize(wdComponentHandle hComponent);
 
   void UpdateFromThread();
-  void UpdateSynchronous(const wdArrayPtr<wdInternal::WorldData::RegisteredUpdateFunction>& updateFunctions);
+  void UpdateSynchronous(wdWorldModule::UpdateFunctionDesc::Phase::Enum phase);
+  void UpdateConcurrently(wdWorldModule::UpdateFunctionDesc::Phase::Enum phase, wdUInt32 uiFirstFunction, wdUInt32 uiEndFunction, wdTime& inout_criticalPath, wdTime& inout_totalTime);
   void UpdateAsynchronous();
 
   // returns if the batch was completely initialized
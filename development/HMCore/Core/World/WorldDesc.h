@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Types/Enum.h>
 #include <Foundation/Types/SharedPtr.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -9,6 +10,20 @@
 
 class wdTimeStepSmoothing;
 
+/// \brief Which spatial system a world creates when it is not given one.
+struct wdSpatialSystemType
+{
+  using StorageType = wdUInt8;
+
+  enum Enum
+  {
+    RegularGrid, ///< wdSpatialSystem_RegularGrid, fits worlds with an evenly distributed object density
+    LooseOctree, ///< wdSpatialSystem_LooseOctree, adapts to worlds with very dense and very sparse areas
+
+    Default = RegularGrid
+  };
+};
+
 /// \brief Describes the initial state of a world.
 struct wdWorldDesc
 {
@@ -21,6 +36,7 @@ struct wdWorldDesc
 
   wdUniquePtr<wdSpatialSystem> m_pSpatialSystem;
   bool m_bAutoCreateSpatialSystem = true; ///< automatically create a default spatial system if none is set
+  wdEnum<wdSpatialSystemType> m_AutoCreatedSpatialSystemType; ///< the type of the automatically created spatial system
 
   wdSharedPtr<wdCoordinateSystemProvider> m_pCoordinateSystemProvider;
   wdUniquePtr<wdTimeStepSmoothing> m_pTimeStepSmoothing; ///< if nullptr, wdDefaultTimeStepSmoothing will be used
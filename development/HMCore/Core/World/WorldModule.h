@@ -6,6 +6,33 @@
 
 class wdWorld;
 
+/// \brief Describes which shared world data an update function accesses. See wdWorldModule::UpdateFunctionDesc::m_bCanRunConcurrently.
+struct wdUpdateFunctionDataAccess
+{
+  using StorageType = wdUInt8;
+
+  enum Enum
+  {
+    None = 0,
+    ReadTransforms = WD_BIT(0),   ///< Reads local or global transforms of game objects.
+    WriteTransforms = WD_BIT(1),  ///< Modifies local or global transforms of game objects.
+    ReadSpatialData = WD_BIT(2),  ///< Queries the spatial system.
+    WriteSpatialData = WD_BIT(3), ///< Modifies bounds or spatial data of game objects.
+
+    Default = None
+  };
+
+  struct Bits
+  {
+    StorageType ReadTransforms : 1;
+    StorageType WriteTransforms : 1;
+    StorageType ReadSpatialData : 1;
+    StorageType WriteSpatialData : 1;
+  };
+};
+
+WD_DECLARE_FLAGS_OPERATORS(wdUpdateFunctionDataAccess);
+
 class WD_CORE_DLL wdWorldModule : public wdReflectedClass
 {
   WD_ADD_DYNAMIC_REFLECTION(wdWorldModule, wdReflectedClass);
@@ -74,6 +101,24 @@ protected:
     wdUInt16 m_uiGranularity = 0;                 ///< The granularity in which batch updates should happen during the asynchronous phase. Has to be 0 for
                                                   ///< synchronous functions.
     float m_fPriority = 0.0f;                     ///< Higher priority (higher number) means that this function is called earlier than a function with lower priority.
+
+    /// \name Concurrent execution of synchronous update functions
+    ///
+    /// By default synchronous update functions are executed one after another on the main thread.
+    /// If m_bCanRunConcurrently is set, the function may instead be executed on a worker thread at the same time as other such functions
+    /// of the same phase. The world builds a dependency graph out of m_DependsOn and the declared data accesses below. Two functions that write
+    /// the same data or where one reads what the other writes are always executed in their regular order, which keeps the update
+    /// deterministic. Functions that are not marked as concurrent act as a barrier.
+    /// While running concurrently the world is only marked for reading, same as in the async phase. Thus it is not allowed to create or
+    /// delete objects or components, use messages that are queued instead.
+    ///@{
+
+    bool m_bCanRunConcurrently = false;                    ///< The function only accesses its own components and the data declared below.
+    wdBitflags<wdUpdateFunctionDataAccess> m_DataAccess;   ///< Which shared world data the function reads or writes.
+    wdHybridArray<const wdRTTI*, 2> m_ReadComponentTypes;  ///< Components of these types (and derived types) of other managers are read.
+    wdHybridArray<const wdRTTI*, 2> m_WriteComponentTypes; ///< Components of these types (and derived types) of other managers are modified.
+
+    ///@}
   };
 
   /// \brief Registers the given update function at the world.
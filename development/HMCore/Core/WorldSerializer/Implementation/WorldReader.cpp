@@ -1,13 +1,24 @@
 #include <Core/CorePCH.h>
 
+#include <Core/ResourceManager/ResourceHandleReadContext.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Foundation/IO/StringDeduplicationContext.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/Progress.h>
 
 wdWorldReader::FindComponentTypeCallback wdWorldReader::s_FindComponentTypeCallback;
 
 wdWorldReader::wdWorldReader() = default;
+
+wdWorldReader::wdWorldReader(const wdWorldReader& sharedReader, wdStreamReader& inout_stream)
+  : m_pStream(&inout_stream)
+  , m_pWorld(sharedReader.m_pWorld)
+  , m_pSharedReader(&sharedReader)
+  , m_uiVersion(sharedReader.m_uiVersion)
+{
+}
+
 wdWorldReader::~wdWorldReader() = default;
 
 wdResult wdWorldReader::ReadWorldDescription(wdStreamReader& inout_stream, bool bWarningOnUknownSkip)
@@ -98,6 +109,9 @@ wdGameObjectHandle wdWorldReader::ReadGameObjectHandle()
   wdUInt32 idx = 0;
   *m_pStream >> idx;
 
+  if (m_pSharedReader != nullptr)
+    return m_pSharedReader->m_IndexToGameObjectHandle[idx];
+
   return m_IndexToGameObjectHandle[idx];
 }
 
@@ -111,9 +125,10 @@ void wdWorldReader::ReadComponentHandle(wdComponentHandle& out_hComponent)
 
   out_hComponent.Invalidate();
 
-  if (uiTypeIndex < m_ComponentTypes.GetCount())
+  const auto& componentTypes = m_pSharedReader != nullptr ? m_pSharedReader->m_ComponentTypes : m_ComponentTypes;
+  if (uiTypeIndex < componentTypes.GetCount())
   {
-    auto& indexToHandle = m_ComponentTypes[uiTypeIndex].m_ComponentIndexToHandle;
+    auto& indexToHandle = componentTypes[uiTypeIndex].m_ComponentIndexToHandle;
     if (uiIndex < indexToHandle.GetCount())
     {
       out_hComponent = indexToHandle[uiIndex];
@@ -123,6 +138,9 @@ void wdWorldReader::ReadComponentHandle(wdComponentHandle& out_hComponent)
 
 wdUInt32 wdWorldReader::GetComponentTypeVersion(const wdRTTI* pRtti) const
 {
+  if (m_pSharedReader != nullptr)
+    return m_pSharedReader->GetComponentTypeVersion(pRtti);
+
   wdUInt32 uiVersion = 0xFFFFFFFF;
   m_ComponentTypeVersions.TryGetValue(pRtti, uiVersion);
 
@@ -268,6 +286,11 @@ void wdWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
 
           m_uiTotalNumComponents += compTypeInfo.m_uiNumComponents;
         }
+        else
+        {
+          // remember where the data of each type starts, so that types can be deserialized independently of each other
+          compTypeInfo.m_uiDataStreamOffset = ref_writer.GetWritePosition();
+        }
 
         while (uiAllComponentsSize > 0)
         {
@@ -372,7 +395,11 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
 
   WD_LOCK(m_WorldReader.m_pWorld->GetWriteMarker());
 
-  wdTime endTime = wdTime::Now() + m_Options.m_MaxStepTime;
+  // only the time spent in Step() counts towards the phases, not the time between steps
+  m_CurrentPhaseStartTime = wdTime::Now();
+  WD_SCOPE_EXIT(if (m_Phase != Phase::Invalid) { FinishCurrentPhase(); });
+
+  wdTime endTime = m_CurrentPhaseStartTime + m_Options.m_MaxStepTime;
 
   if (m_Phase == Phase::CreateRootObjects)
   {
@@ -409,8 +436,7 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
         return StepResult::Continue;
     }
 
-    m_Phase = Phase::CreateChildObjects;
-    BeginNextProgressStep("CreateChildObjects");
+    AdvancePhase(Phase::CreateChildObjects);
   }
 
   if (m_Phase == Phase::CreateChildObjects)
@@ -419,8 +445,7 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
       return StepResult::Continue;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
-    m_Phase = Phase::CreateComponents;
-    BeginNextProgressStep("CreateComponents");
+    AdvancePhase(Phase::CreateComponents);
   }
 
   if (m_Phase == Phase::CreateComponents)
@@ -439,14 +464,19 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
     }
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
-    m_Phase = Phase::DeserializeComponents;
-    BeginNextProgressStep("DeserializeComponents");
+    AdvancePhase(Phase::DeserializeComponents);
   }
 
   if (m_Phase == Phase::DeserializeComponents)
   {
     if (m_WorldReader.m_ComponentDataStream.GetStorageSize64() > 0)
     {
+      if (m_Options.m_bParallelComponentDeserialization)
+      {
+        if (!DeserializeComponentsInParallel(endTime))
+          return StepResult::Continue;
+      }
+
       m_WorldReader.m_pStringDedupReadContext->SetActive(true);
 
       wdStreamReader* pPrevReader = m_WorldReader.m_pStream;
@@ -459,8 +489,7 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
     }
 
     m_CurrentReader.SetStorage(nullptr);
-    m_Phase = Phase::AddComponentsToBatch;
-    BeginNextProgressStep("AddComponentsToBatch");
+    AdvancePhase(Phase::AddComponentsToBatch);
   }
 
   if (m_Phase == Phase::AddComponentsToBatch)
@@ -468,8 +497,7 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
     if (!AddComponentsToBatch(endTime))
       return StepResult::Continue;
 
-    m_Phase = Phase::InitComponents;
-    BeginNextProgressStep("InitComponents");
+    AdvancePhase(Phase::InitComponents);
   }
 
   if (m_Phase == Phase::InitComponents)
@@ -484,8 +512,12 @@ wdWorldReader::InstantiationContext::StepResult wdWorldReader::InstantiationCont
       }
     }
 
+    FinishCurrentPhase();
     m_Phase = Phase::Invalid;
+
+    // report the durations of all phases, including the last one
     m_pSubProgressRange = nullptr;
+    BeginNextProgressStep("Finished", 0);
     m_pOverallProgressRange = nullptr;
   }
 
@@ -504,6 +536,8 @@ void wdWorldReader::InstantiationContext::Cancel()
   m_pOverallProgressRange = nullptr;
 }
 
+static const char* s_szInstantiationPhaseNames[] = {"CreateRootObjects", "CreateChildObjects", "CreateComponents", "DeserializeComponents", "AddComponentsToBatch", "InitComponents"};
+
 // a super simple, but also efficient random number generator
 inline static wdUInt32 NextStableRandomSeed(wdUInt32& ref_uiSeed)
 {
@@ -629,6 +663,11 @@ bool wdWorldReader::InstantiationContext::CreateComponents(wdTime endTime)
 
       pComponent->SetActiveFlag(bActive);
 
+      if (m_uiCurrentIndex == 0)
+      {
+        compTypeInfo.m_bDeserializeInParallel = m_Options.m_bParallelComponentDeserialization && pComponent->CanBeDeserializedInParallel();
+      }
+
       for (wdUInt8 j = 0; j < 8; ++j)
       {
         pComponent->SetUserFlag(j, (userFlags & WD_BIT(j)) != 0);
@@ -667,9 +706,15 @@ bool wdWorldReader::InstantiationContext::DeserializeComponents(wdTime endTime)
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
-    if (compTypeInfo.m_pRtti == nullptr)
+    if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_bDeserializeInParallel)
       continue;
 
+    if (m_uiCurrentIndex == 0)
+    {
+      // the data of types that were deserialized in parallel is skipped
+      m_CurrentReader.SetReadPosition(compTypeInfo.m_uiDataStreamOffset);
+    }
+
     while (m_uiCurrentIndex < compTypeInfo.m_ComponentIndexToHandle.GetCount())
     {
       wdComponent* pComponent = nullptr;
@@ -698,6 +743,98 @@ bool wdWorldReader::InstantiationContext::DeserializeComponents(wdTime endTime)
   return true;
 }
 
+bool wdWorldReader::InstantiationContext::DeserializeComponentsInParallel(wdTime endTime)
+{
+  WD_PROFILE_SCOPE("wdWorldReader::DeserializeComponentsInParallel");
+
+  if (!m_bParallelDeserializationStarted)
+  {
+    m_bParallelDeserializationStarted = true;
+
+    for (const auto& compTypeInfo : m_WorldReader.m_ComponentTypes)
+    {
+      if (compTypeInfo.m_pRtti == nullptr || !compTypeInfo.m_bDeserializeInParallel)
+        continue;
+
+      auto& state = m_ParallelDeserializationStates.ExpandAndGetRef();
+      state.m_pTypeInfo = &compTypeInfo;
+      state.m_pManager = m_WorldReader.m_pWorld->GetManagerForComponentType(compTypeInfo.m_pRtti);
+      state.m_uiReadPosition = compTypeInfo.m_uiDataStreamOffset;
+      state.m_uiCurrentIndex = 0;
+    }
+  }
+
+  if (m_ParallelDeserializationStates.IsEmpty())
+    return true;
+
+  wdAtomicInteger32 iNumProcessed = 0;
+
+  // the tasks only record the resource handles that they read, the resources are requested on this thread once all tasks are done
+  wdResourceHandleReadContext resourceHandleReadContext;
+  resourceHandleReadContext.SetActive(false);
+
+  // Every type reads from its own section of the data stream through its own reader, so the types are independent of each other.
+  // The components are not initialized yet, thus nothing else in the world can access them while they are written.
+  auto deserializeTypes = [&](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+    // the active context is thread local, every task gets its own one that reads from the shared string table
+    wdStringDeduplicationReadContext stringDedupReadContext(m_WorldReader.m_pStringDedupReadContext.Borrow());
+
+    resourceHandleReadContext.SetActive(true);
+    WD_SCOPE_EXIT(resourceHandleReadContext.SetActive(false));
+
+    for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      ParallelDeserializationState& state = m_ParallelDeserializationStates[i];
+      const auto& indexToHandle = state.m_pTypeInfo->m_ComponentIndexToHandle;
+
+      wdMemoryStreamReader reader(&m_WorldReader.m_ComponentDataStream);
+      reader.SetReadPosition(state.m_uiReadPosition);
+
+      wdWorldReader taskReader(m_WorldReader, reader);
+
+      while (state.m_uiCurrentIndex < indexToHandle.GetCount())
+      {
+        wdComponent* pComponent = nullptr;
+        if (state.m_pManager->TryGetComponent(indexToHandle[state.m_uiCurrentIndex++], pComponent))
+        {
+          pComponent->DeserializeComponent(taskReader);
+
+          iNumProcessed.Increment();
+
+          // exit here to ensure that we at least did some work
+          if (wdTime::Now() >= endTime)
+            break;
+        }
+      }
+
+      state.m_uiReadPosition = reader.GetReadPosition();
+    }
+  };
+
+  wdParallelForParams parallelForParams;
+  parallelForParams.m_uiBinSize = 1;
+  parallelForParams.m_uiMaxTasksPerThread = 2;
+
+  wdTaskSystem::ParallelForIndexed(0, m_ParallelDeserializationStates.GetCount(), deserializeTypes, "DeserializeComponents", parallelForParams);
+
+  resourceHandleReadContext.ResolveHandles();
+
+  m_uiCurrentNumComponentsProcessed += iNumProcessed;
+
+  for (wdUInt32 i = m_ParallelDeserializationStates.GetCount(); i-- > 0;)
+  {
+    const ParallelDeserializationState& state = m_ParallelDeserializationStates[i];
+    if (state.m_uiCurrentIndex >= state.m_pTypeInfo->m_ComponentIndexToHandle.GetCount())
+    {
+      m_ParallelDeserializationStates.RemoveAtAndSwap(i);
+    }
+  }
+
+  SetSubProgressCompletion((double)m_uiCurrentNumComponentsProcessed / m_WorldReader.m_uiTotalNumComponents);
+
+  return m_ParallelDeserializationStates.IsEmpty();
+}
+
 bool wdWorldReader::InstantiationContext::AddComponentsToBatch(wdTime endTime)
 {
   WD_PROFILE_SCOPE("wdWorldReader::AddComponentsToBatch");
@@ -764,16 +901,46 @@ wdTime wdWorldReader::InstantiationContext::GetMaxStepTime() const
   return m_Options.m_MaxStepTime;
 }
 
-void wdWorldReader::InstantiationContext::BeginNextProgressStep(wdStringView sName)
+void wdWorldReader::InstantiationContext::BeginNextProgressStep(wdStringView sName, wdUInt32 uiNumSteps)
 {
   if (m_pOverallProgressRange != nullptr)
   {
-    m_pOverallProgressRange->BeginNextStep(sName);
+    // append the time spent in all finished phases, so that it can be inspected through the progress bar
+    wdStringBuilder sStepText = sName;
+    for (wdUInt32 i = 0; i < Phase::Count; ++i)
+    {
+      if (m_Phase != Phase::Invalid && i >= (wdUInt32)m_Phase)
+        break;
+
+      sStepText.AppendFormat("{} {}: {} ms", i == 0 ? " |" : ",", s_szInstantiationPhaseNames[i], wdArgF(m_PhaseDurations[i].GetMilliseconds(), 2));
+    }
+
     m_pSubProgressRange = nullptr;
-    m_pSubProgressRange = WD_DEFAULT_NEW(wdProgressRange, sName, false, m_pOverallProgressRange->GetProgressbar());
+    m_pOverallProgressRange->BeginNextStep(sStepText, uiNumSteps);
+
+    if (uiNumSteps > 0)
+    {
+      m_pSubProgressRange = WD_DEFAULT_NEW(wdProgressRange, sName, false, m_pOverallProgressRange->GetProgressbar());
+    }
   }
 }
 
+void wdWorldReader::InstantiationContext::FinishCurrentPhase()
+{
+  const wdTime now = wdTime::Now();
+  m_PhaseDurations[m_Phase] += now - m_CurrentPhaseStartTime;
+  m_CurrentPhaseStartTime = now;
+}
+
+void wdWorldReader::InstantiationContext::AdvancePhase(Phase::Enum nextPhase)
+{
+  static_assert(WD_ARRAY_SIZE(s_szInstantiationPhaseNames) == Phase::Count);
+
+  FinishCurrentPhase();
+  m_Phase = nextPhase;
+  BeginNextProgressStep(s_szInstantiationPhaseNames[nextPhase]);
+}
+
 void wdWorldReader::InstantiationContext::SetSubProgressCompletion(double fCompletion)
 {
   if (m_pSubProgressRange != nullptr)
@@ -36,6 +36,17 @@ struct wdPrefabInstantiationOptions
 
   wdTime m_MaxStepTime = wdTime::Zero();
 
+  /// \brief If set, components whose type returns true from wdComponent::CanBeDeserializedInParallel() are deserialized on worker threads.
+  ///
+  /// Every such component type is deserialized by its own task from its own section of the component data, while the components are not yet
+  /// initialized. Initialization and all other component types are still processed on the calling thread afterwards.
+  /// The tasks stop once m_MaxStepTime is used up and continue where they left off in the next Step().
+  bool m_bParallelComponentDeserialization = false;
+
+  /// \brief If valid, the progress is reported through it.
+  ///
+  /// The step display text additionally lists the time spent in every finished phase. Once instantiation is finished, a last step
+  /// with the durations of all phases is reported, it can be read in the wdProgressEvent::Type::ProgressEnded event.
   wdProgress* m_pProgress = nullptr;
 };
 
@@ -156,6 +167,11 @@ public:
   static wdTime GetMaxStepTime(InstantiationContextBase* pContext);
 
 private:
+  /// \brief Creates a reader that reads component data from its own stream, but takes everything else from sharedReader.
+  ///
+  /// Used to deserialize components on worker threads.
+  wdWorldReader(const wdWorldReader& sharedReader, wdStreamReader& inout_stream);
+
   struct GameObjectToCreate
   {
     wdGameObjectDesc m_Desc;
@@ -171,6 +187,7 @@ private:
 
   wdStreamReader* m_pStream = nullptr;
   wdWorld* m_pWorld = nullptr;
+  const wdWorldReader* m_pSharedReader = nullptr;
 
   wdUInt8 m_uiVersion = 0;
   wdDynamicArray<wdGameObjectHandle> m_IndexToGameObjectHandle;
@@ -183,6 +200,8 @@ private:
     const wdRTTI* m_pRtti = nullptr;
     wdDynamicArray<wdComponentHandle> m_ComponentIndexToHandle;
     wdUInt32 m_uiNumComponents = 0;
+    wdUInt64 m_uiDataStreamOffset = 0;
+    bool m_bDeserializeInParallel = false;
   };
 
   wdDynamicArray<ComponentTypeInfo> m_ComponentTypes;
@@ -207,13 +226,14 @@ private:
 
     bool CreateComponents(wdTime endTime);
     bool DeserializeComponents(wdTime endTime);
+    bool DeserializeComponentsInParallel(wdTime endTime);
     bool AddComponentsToBatch(wdTime endTime);
 
     void SetMaxStepTime(wdTime stepTime);
     wdTime GetMaxStepTime() const;
 
   private:
-    void BeginNextProgressStep(wdStringView sName);
+    void BeginNextProgressStep(wdStringView sName, wdUInt32 uiNumSteps = 1);
     void SetSubProgressCompletion(double fCompletion);
 
     friend class wdWorldReader;
@@ -243,7 +263,25 @@ private:
       };
     };
 
+    void FinishCurrentPhase();
+    void AdvancePhase(Phase::Enum nextPhase);
+
+    /// Where the deserialization of a component type that is deserialized in parallel currently is.
+    struct ParallelDeserializationState
+    {
+      WD_DECLARE_POD_TYPE();
+
+      const ComponentTypeInfo* m_pTypeInfo;
+      wdComponentManagerBase* m_pManager;
+      wdUInt64 m_uiReadPosition;
+      wdUInt32 m_uiCurrentIndex;
+    };
+
     Phase::Enum m_Phase = Phase::Invalid;
+    wdTime m_CurrentPhaseStartTime;
+    wdTime m_PhaseDurations[Phase::Count];
+    bool m_bParallelDeserializationStarted = false;
+    wdDynamicArray<ParallelDeserializationState> m_ParallelDeserializationStates;
     wdUInt32 m_uiCurrentIndex = 0; // object or component
     wdUInt32 m_uiCurrentComponentTypeIndex = 0;
     wdUInt64 m_uiCurrentNumComponentsProcessed = 0;
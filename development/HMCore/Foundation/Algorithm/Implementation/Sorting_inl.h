@@ -35,6 +35,68 @@ void wdSorting::InsertionSort(wdArrayPtr<T>& inout_arrayPtr, const Comparer& com
   InsertionSort(inout_arrayPtr, 0, inout_arrayPtr.GetCount() - 1, comparer);
 }
 
+template <typename T, typename KeyFunc>
+void wdSorting::RadixSort(wdArrayPtr<T> inout_arrayPtr, wdArrayPtr<T> scratch, const KeyFunc& keyFunc)
+{
+  using KeyType = typename std::decay<decltype(keyFunc(inout_arrayPtr[0]))>::type;
+  static_assert(std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value, "The radix sort key has to be an unsigned integer");
+
+  constexpr wdUInt32 uiNumDigits = sizeof(KeyType);
+
+  const wdUInt32 uiCount = inout_arrayPtr.GetCount();
+  if (uiCount <= 1)
+    return;
+
+  WD_ASSERT_DEV(scratch.GetCount() >= uiCount, "The scratch buffer is too small, {} elements are required", uiCount);
+
+  // gather the histograms for all digits in one go
+  wdUInt32 histograms[uiNumDigits][256] = {};
+
+  T* pSource = inout_arrayPtr.GetPtr();
+  T* pTarget = scratch.GetPtr();
+
+  for (wdUInt32 i = 0; i < uiCount; ++i)
+  {
+    const wdUInt64 uiKey = keyFunc(pSource[i]);
+
+    for (wdUInt32 uiDigit = 0; uiDigit < uiNumDigits; ++uiDigit)
+    {
+      ++histograms[uiDigit][(uiKey >> (uiDigit * 8)) & 0xFF];
+    }
+  }
+
+  for (wdUInt32 uiDigit = 0; uiDigit < uiNumDigits; ++uiDigit)
+  {
+    wdUInt32* pHistogram = histograms[uiDigit];
+    const wdUInt32 uiShift = uiDigit * 8;
+
+    // all keys have the same value in this digit, the pass would not change anything
+    if (pHistogram[(static_cast<wdUInt64>(keyFunc(pSource[0])) >> uiShift) & 0xFF] == uiCount)
+      continue;
+
+    wdUInt32 uiOffset = 0;
+    for (wdUInt32 uiBucket = 0; uiBucket < 256; ++uiBucket)
+    {
+      const wdUInt32 uiBucketSize = pHistogram[uiBucket];
+      pHistogram[uiBucket] = uiOffset;
+      uiOffset += uiBucketSize;
+    }
+
+    for (wdUInt32 i = 0; i < uiCount; ++i)
+    {
+      const wdUInt32 uiBucket = (static_cast<wdUInt64>(keyFunc(pSource[i])) >> uiShift) & 0xFF;
+      pTarget[pHistogram[uiBucket]++] = pSource[i];
+    }
+
+    wdMath::Swap(pSource, pTarget);
+  }
+
+  if (pSource != inout_arrayPtr.GetPtr())
+  {
+    wdMemoryUtils::Copy(inout_arrayPtr.GetPtr(), pSource, uiCount);
+  }
+}
+
 template <typename Container, typename Comparer>
 void wdSorting::QuickSort(Container& inout_container, wdUInt32 uiStartIndex, wdUInt32 uiEndIndex, const Comparer& in_comparer)
 {
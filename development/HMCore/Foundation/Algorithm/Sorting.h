@@ -27,6 +27,17 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(wdArrayPtr<T>& inout_arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+
+  /// \brief Sorts the elements in the array by an unsigned integer key using a LSD radix sort (stable, but not in-place).
+  ///
+  /// \a keyFunc has to return the key of an element as an unsigned integer (8 to 64 bit). It is called once for every element and
+  /// once more for every key byte that needs sorting, so it should be cheap. Bytes in which all keys are identical are skipped.
+  /// Since the sort is stable, sorting by a secondary key first and then by the primary key sorts by both keys.
+  ///
+  /// \a scratch needs at least as many elements as \a inout_arrayPtr, its content is undefined afterwards.
+  template <typename T, typename KeyFunc>
+  static void RadixSort(wdArrayPtr<T> inout_arrayPtr, wdArrayPtr<T> scratch, const KeyFunc& keyFunc); // [tested]
+
 private:
   enum
   {
@@ -36,7 +36,17 @@ const wdTokenizer* wdTokenizedFileCache::Tokenize(const wdString& sFileName, wdA
 {
   WD_LOCK(m_Mutex);
 
-  auto& data = m_Cache[sFileName];
+  bool bExisted = false;
+  auto it = m_Cache.FindOrAdd(sFileName, &bExisted);
+
+  if (bExisted)
+  {
+    // another preprocessor sharing this cache has tokenized the file in the meantime
+    // other threads may already read these tokens, so they must not be modified anymore
+    return &it.Value().m_Tokens;
+  }
+
+  auto& data = it.Value();
 
   data.m_Timestamp = fileTimeStamp;
   wdTokenizer* pTokenizer = &data.m_Tokens;
@@ -34,6 +34,9 @@ public:
   ///
   //// The file content is tokenized first and all #line directives are evaluated, to update the line number and file origin for each token.
   /// Any errors are written to the given log.
+  ///
+  /// If the file is already in the cache, e.g. because another preprocessor on a different thread tokenized it in the meantime,
+  /// the existing data is returned unchanged. Call Remove() first to replace an entry.
   const wdTokenizer* Tokenize(const wdString& sFileName, wdArrayPtr<const wdUInt8> fileContent, const wdTimestamp& fileTimeStamp, wdLogInterface* pLog);
 
 private:
@@ -44,6 +44,12 @@ public:
   /// \brief Derived message types can override this method to influence sorting order. Smaller keys are processed first.
   virtual wdInt32 GetSortingKey() const { return 0; }
 
+  /// \brief Derived message types can return true, if posted messages of this type may be delivered to different components concurrently.
+  ///
+  /// The message handlers must then only modify the receiving component and only read from the world, the same as in the async update phase.
+  /// Posting further messages is fine. Messages that are posted to game objects are always delivered one after the other.
+  virtual bool CanBeDeliveredInParallel() const { return false; }
+
   /// \brief Returns the id for this message type.
   WD_ALWAYS_INLINE wdMessageId GetId() const { return m_Id; }
 
@@ -80,6 +80,7 @@ WD_STATICLINK_LIBRARY(Foundation)
   WD_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileReader);
   WD_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileSystem);
   WD_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileWriter);
+  WD_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_MappedFileContent);
   WD_STATICLINK_REFERENCE(Foundation_IO_Implementation_ChunkStream);
   WD_STATICLINK_REFERENCE(Foundation_IO_Implementation_CompressedStreamZstd);
   WD_STATICLINK_REFERENCE(Foundation_IO_Implementation_DeduplicationContext);
@@ -22,6 +22,16 @@ public:
   // all the source files from disk that should be put into the wdArchive
   wdDeque<SourceEntry> m_Entries;
 
+  /// \brief How many compressed entries may be prepared ahead of the one that is currently written to the output.
+  ///
+  /// Compression runs on the long running task system workers, the output is always written on the calling thread in the order of
+  /// m_Entries. Every prepared entry keeps its compressed data in memory until it is written, so this also limits the memory usage.
+  /// Zero uses twice the number of long running worker threads.
+  wdUInt32 m_uiMaxEntriesInFlight = 0;
+
+  /// \brief Files that are at least this large are compressed with multiple zstd threads, all other files use a single thread each.
+  wdUInt64 m_uiMultiThreadedCompressionThreshold = 32 * 1024 * 1024;
+
   enum class InclusionMode
   {
     Exclude,               ///< Do not add this file to the archive
@@ -46,6 +56,8 @@ public:
   wdResult WriteArchive(wdStringView sFile) const;
 
   /// \brief Writes the previously gathered files to the file stream
+  ///
+  /// Entries are compressed in parallel, but the output is identical to compressing them one after another.
   wdResult WriteArchive(wdStreamWriter& inout_stream) const;
 
 protected:
@@ -30,6 +30,9 @@ public:
   /// \brief Sets up \a memReader for reading the raw (potentially compressed) data that is stored for the given entry in the archive.
   void ConfigureRawMemoryStreamReader(wdUInt32 uiEntryIdx, wdRawMemoryStreamReader& ref_memReader) const;
 
+  /// \brief Returns the raw (potentially compressed) data that is stored for the given entry. It points directly into the mapped archive file.
+  wdArrayPtr<const wdUInt8> GetStoredEntryData(wdUInt32 uiEntryIdx) const;
+
   /// \brief Creates a reader that will decompress the given file entry.
   wdUniquePtr<wdStreamReader> CreateEntryReader(wdUInt32 uiEntryIdx) const;
 
@@ -63,6 +63,7 @@ namespace wdDataDirectory
 
     virtual wdUInt64 Read(void* pBuffer, wdUInt64 uiBytes) override;
     virtual wdUInt64 GetFileSize() const override;
+    virtual wdArrayPtr<const wdUInt8> GetMappedData() const override;
 
   protected:
     virtual wdResult InternalOpen(wdFileShareMode::Enum FileShareMode) override;
@@ -72,6 +73,7 @@ namespace wdDataDirectory
 
     wdUInt64 m_uiUncompressedSize = 0;
     wdUInt64 m_uiCompressedSize = 0;
+    wdArrayPtr<const wdUInt8> m_StoredData;
     wdRawMemoryStreamReader m_MemStreamReader;
   };
 
@@ -85,6 +87,7 @@ namespace wdDataDirectory
     ~ArchiveReaderZstd();
 
     virtual wdUInt64 Read(void* pBuffer, wdUInt64 uiBytes) override;
+    virtual wdArrayPtr<const wdUInt8> GetMappedData() const override;
 
   protected:
     virtual wdResult InternalOpen(wdFileShareMode::Enum FileShareMode) override;
@@ -3,10 +3,97 @@
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/ScopeExit.h>
+
+namespace
+{
+  /// Reads one source file and compresses it into memory, so that the result only needs to be copied into the archive.
+  class wdArchiveCompressEntryTask final : public wdTask
+  {
+  public:
+    wdArchiveCompressEntryTask() { ConfigureTask("Compress Archive Entry", wdTaskNesting::Never); }
+
+    void Prepare(const wdArchiveBuilder::SourceEntry* pEntry, wdUInt32 uiMaxCompressionThreads, wdUInt64 uiMultiThreadedCompressionThreshold)
+    {
+      m_pEntry = pEntry;
+      m_uiMaxCompressionThreads = uiMaxCompressionThreads;
+      m_uiMultiThreadedCompressionThreshold = uiMultiThreadedCompressionThreshold;
+      m_Storage.Clear();
+      m_Result = WD_FAILURE;
+      m_bStoreUncompressed = false;
+      m_uiUncompressedSize = 0;
+      m_uiStoredSize = 0;
+    }
+
+    wdDefaultMemoryStreamStorage m_Storage;
+    wdResult m_Result = WD_FAILURE;
+    bool m_bStoreUncompressed = false;
+    wdUInt64 m_uiUncompressedSize = 0;
+    wdUInt64 m_uiStoredSize = 0;
+    wdTime m_Duration;
+
+  private:
+    virtual void Execute() override
+    {
+      wdStopwatch sw;
+      m_Result = Compress();
+      m_Duration = sw.GetRunningTotal();
+    }
+
+    wdResult Compress()
+    {
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      wdFileReader file;
+      WD_SUCCEED_OR_RETURN(file.Open(m_pEntry->m_sAbsSourcePath, 1024 * 1024));
+
+      wdMemoryStreamWriter writer(&m_Storage);
+
+      wdCompressedStreamWriterZstd zstdWriter;
+      zstdWriter.SetMaxCompressionThreads(file.GetFileSize() >= m_uiMultiThreadedCompressionThreshold ? m_uiMaxCompressionThreads : 1);
+      zstdWriter.SetOutputStream(&writer, (wdCompressedStreamWriterZstd::Compression)m_pEntry->m_iCompressionLevel);
+
+      wdUInt8 uiTemp[1024 * 8];
+
+      while (true)
+      {
+        const wdUInt64 uiRead = file.ReadBytes(uiTemp, WD_ARRAY_SIZE(uiTemp));
+
+        if (uiRead == 0)
+          break;
+
+        m_uiUncompressedSize += uiRead;
+        WD_SUCCEED_OR_RETURN(zstdWriter.WriteBytes(uiTemp, uiRead));
+      }
+
+      WD_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
+      m_uiStoredSize = zstdWriter.GetWrittenBytes();
+
+      // same rule as wdArchiveUtils::WriteEntryOptimal: less than 20% size saving -> go uncompressed
+      if (m_uiStoredSize * 12 >= m_uiUncompressedSize * 10)
+      {
+        m_bStoreUncompressed = true;
+        m_Storage.Clear();
+        m_Storage.Compact();
+      }
+#else
+      m_bStoreUncompressed = true;
+#endif
+
+      return WD_SUCCESS;
+    }
+
+    const wdArchiveBuilder::SourceEntry* m_pEntry = nullptr;
+    wdUInt32 m_uiMaxCompressionThreads = 0;
+    wdUInt64 m_uiMultiThreadedCompressionThreshold = 0;
+  };
+} // namespace
 
 void wdArchiveBuilder::AddFolder(wdStringView sAbsFolderPath, wdArchiveCompressionMode defaultMode /*= wdArchiveCompressionMode::Uncompressed*/, InclusionCallback callback /*= InclusionCallback()*/)
 {
@@ -105,8 +192,56 @@ wdResult wdArchiveBuilder::WriteArchive(wdStreamWriter& inout_stream) const
 
   wdStopwatch sw;
 
+  // Compressed entries are prepared by tasks in a sliding window ahead of the entry that is currently written.
+  // Each slot of the ring buffer belongs to one entry in the window, entries that are stored uncompressed don't need a task.
+  const wdUInt32 uiNumWorkers = wdMath::Max(1u, wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::LongTasks));
+  const wdUInt32 uiMaxInFlight = m_uiMaxEntriesInFlight > 0 ? m_uiMaxEntriesInFlight : uiNumWorkers * 2;
+
+  struct Slot
+  {
+    wdSharedPtr<wdArchiveCompressEntryTask> m_pTask;
+    wdTaskGroupID m_TaskGroup;
+  };
+
+  wdDynamicArray<Slot> slots;
+  slots.SetCount(uiMaxInFlight);
+
+  auto WaitForAllTasks = [&]() {
+    for (const Slot& slot : slots)
+    {
+      wdTaskSystem::WaitForGroup(slot.m_TaskGroup);
+    }
+  };
+
+  // never leave with tasks still referencing this data
+  WD_SCOPE_EXIT(WaitForAllTasks());
+
+  wdUInt32 uiNextEntryToSchedule = 0;
+
+  auto ScheduleEntries = [&](wdUInt32 uiUpToEntry) {
+    for (; uiNextEntryToSchedule < uiUpToEntry; ++uiNextEntryToSchedule)
+    {
+      const SourceEntry& e = m_Entries[uiNextEntryToSchedule];
+
+      if (e.m_CompressionMode != wdArchiveCompressionMode::Compressed_zstd)
+        continue;
+
+      Slot& slot = slots[uiNextEntryToSchedule % uiMaxInFlight];
+
+      if (slot.m_pTask == nullptr)
+      {
+        slot.m_pTask = WD_DEFAULT_NEW(wdArchiveCompressEntryTask);
+      }
+
+      slot.m_pTask->Prepare(&e, wdMath::Min(uiNumWorkers, 12u), m_uiMultiThreadedCompressionThreshold);
+      slot.m_TaskGroup = wdTaskSystem::StartSingleTask(slot.m_pTask, wdTaskPriority::LongRunning);
+    }
+  };
+
   for (wdUInt32 i = 0; i < uiNumEntries; ++i)
   {
+    ScheduleEntries(wdMath::Min(i + uiMaxInFlight, uiNumEntries));
+
     const SourceEntry& e = m_Entries[i];
 
     const wdUInt32 uiPathStringOffset = toc.m_AllPathStrings.GetCount();
@@ -122,9 +257,47 @@ wdResult wdArchiveBuilder::WriteArchive(wdStreamWriter& inout_stream) const
 
     wdArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
 
-    WD_SUCCEED_OR_RETURN(wdArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, wdMakeDelegate(&wdArchiveBuilder::WriteFileProgressCallback, this)));
+    const wdArchiveCompressEntryTask* pCompressed = nullptr;
+    wdTime duration;
+
+    if (e.m_CompressionMode == wdArchiveCompressionMode::Compressed_zstd)
+    {
+      const Slot& slot = slots[i % uiMaxInFlight];
+      wdTaskSystem::WaitForGroup(slot.m_TaskGroup);
+
+      WD_SUCCEED_OR_RETURN(slot.m_pTask->m_Result);
+
+      if (!slot.m_pTask->m_bStoreUncompressed)
+        pCompressed = slot.m_pTask.Borrow();
+
+      // report the time it took to compress the entry, not how long we had to wait for it
+      duration = slot.m_pTask->m_Duration;
+    }
+
+    sw.Checkpoint();
+
+    if (pCompressed != nullptr)
+    {
+      tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+      tocEntry.m_uiDataStartOffset = uiStreamSize;
+      tocEntry.m_uiUncompressedDataSize = pCompressed->m_uiUncompressedSize;
+      tocEntry.m_uiStoredDataSize = pCompressed->m_uiStoredSize;
+      tocEntry.m_CompressionMode = wdArchiveCompressionMode::Compressed_zstd;
+
+      WD_SUCCEED_OR_RETURN(pCompressed->m_Storage.CopyToStream(inout_stream));
+      uiStreamSize += tocEntry.m_uiStoredDataSize;
+
+      if (!WriteFileProgressCallback(tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiUncompressedDataSize))
+        return WD_FAILURE;
+    }
+    else
+    {
+      WD_SUCCEED_OR_RETURN(wdArchiveUtils::WriteEntry(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, wdArchiveCompressionMode::Uncompressed, e.m_iCompressionLevel, tocEntry, uiStreamSize, wdMakeDelegate(&wdArchiveBuilder::WriteFileProgressCallback, this)));
+    }
+
+    duration += sw.Checkpoint();
 
-    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
+    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, duration);
   }
 
   WD_SUCCEED_OR_RETURN(wdArchiveUtils::AppendTOC(inout_stream, toc));
@@ -104,6 +104,13 @@ void wdArchiveReader::ConfigureRawMemoryStreamReader(wdUInt32 uiEntryIdx, wdRawM
   wdArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, ref_memReader);
 }
 
+wdArrayPtr<const wdUInt8> wdArchiveReader::GetStoredEntryData(wdUInt32 uiEntryIdx) const
+{
+  const wdArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+  const wdUInt8* pData = static_cast<const wdUInt8*>(wdMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset)));
+  return wdArrayPtr<const wdUInt8>(pData, static_cast<wdUInt32>(entry.m_uiStoredDataSize));
+}
+
 wdUniquePtr<wdStreamReader> wdArchiveReader::CreateEntryReader(wdUInt32 uiEntryIdx) const
 {
   return wdArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
@@ -98,6 +98,7 @@ wdDataDirectoryReader* wdDataDirectory::ArchiveType::OpenFileToRead(wdStringView
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
+  pReader->m_StoredData = m_ArchiveReader.GetStoredEntryData(uiEntryIndex);
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
@@ -245,6 +246,11 @@ wdUInt64 wdDataDirectory::ArchiveReaderUncompressed::GetFileSize() const
   return m_uiUncompressedSize;
 }
 
+wdArrayPtr<const wdUInt8> wdDataDirectory::ArchiveReaderUncompressed::GetMappedData() const
+{
+  return m_StoredData;
+}
+
 wdResult wdDataDirectory::ArchiveReaderUncompressed::InternalOpen(wdFileShareMode::Enum FileShareMode)
 {
   WD_ASSERT_DEBUG(FileShareMode != wdFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
@@ -274,6 +280,12 @@ wdUInt64 wdDataDirectory::ArchiveReaderZstd::Read(void* pBuffer, wdUInt64 uiByte
   return m_CompressedStreamReader.ReadBytes(pBuffer, uiBytes);
 }
 
+wdArrayPtr<const wdUInt8> wdDataDirectory::ArchiveReaderZstd::GetMappedData() const
+{
+  // the stored data is compressed
+  return {};
+}
+
 wdResult wdDataDirectory::ArchiveReaderZstd::InternalOpen(wdFileShareMode::Enum FileShareMode)
 {
   WD_ASSERT_DEBUG(FileShareMode != wdFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
@@ -94,6 +94,12 @@ public:
   /// allocate internal structures once that final decision is made.
   void SetOutputStream(wdStreamWriter* pOutputStream, Compression ratio = Compression::Default, wdUInt32 uiCompressionCacheSizeKB = 4); // [tested]
 
+  /// \brief Limits how many threads zstd uses internally to compress the data. Only takes effect with the next call to SetOutputStream().
+  ///
+  /// By default as many threads as there are CPU cores are used (at most 12). The compressed output does not depend on this value, so it
+  /// can be reduced when many streams are compressed in parallel anyway. Zero restores the default.
+  void SetMaxCompressionThreads(wdUInt32 uiNumThreads) { m_uiMaxCompressionThreads = uiNumThreads; }
+
   /// \brief Compresses \a uiBytesToWrite from \a pWriteBuffer.
   ///
   /// Will output bursts of 256 bytes to the output stream every once in a while.
@@ -138,6 +144,7 @@ private:
   wdUInt64 m_uiUncompressedSize = 0;
   wdUInt64 m_uiCompressedSize = 0;
   wdUInt64 m_uiWrittenBytes = 0;
+  wdUInt32 m_uiMaxCompressionThreads = 0;
 
   // local declaration to reduce #include dependencies
   struct OutBufferImpl
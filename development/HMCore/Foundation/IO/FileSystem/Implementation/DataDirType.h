@@ -163,6 +163,11 @@ public:
   }
 
   virtual wdUInt64 Read(void* pBuffer, wdUInt64 uiBytes) = 0;
+
+  /// \brief Returns the entire file content, if the data directory already holds it in memory, e.g. in a memory mapped archive.
+  ///
+  /// The memory stays valid until the data directory is removed. Returns an empty array, if the content can only be accessed through Read().
+  virtual wdArrayPtr<const wdUInt8> GetMappedData() const { return {}; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
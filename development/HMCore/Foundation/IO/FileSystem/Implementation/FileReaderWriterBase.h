@@ -36,6 +36,9 @@ public:
   /// \brief Returns the current total size of the file.
   wdUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns the entire file content without reading it, if the data directory holds it in memory already. See wdDataDirectoryReader::GetMappedData().
+  wdArrayPtr<const wdUInt8> GetMappedData() const { return m_pDataDirReader->GetMappedData(); }
+
 protected:
   wdDataDirectoryReader* GetFileReader(wdStringView sFile, wdFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
@@ -0,0 +1,90 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/FileSystem/MappedFileContent.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Profiling/Profiling.h>
+
+wdUInt64 wdMappedFileContent::s_uiMinMappedFileSize = 64 * 1024;
+
+wdMappedFileContent::wdMappedFileContent() = default;
+
+wdMappedFileContent::~wdMappedFileContent()
+{
+  Close();
+}
+
+wdResult wdMappedFileContent::Open(wdStringView sFile, wdFileShareMode::Enum fileShareMode)
+{
+  Close();
+
+  // no read cache needed, the content is either accessed in place or read in one go
+  if (m_File.Open(sFile, 0, fileShareMode).Failed())
+    return WD_FAILURE;
+
+  m_sFilePathAbsolute = m_File.GetFilePathAbsolute().GetView();
+  m_sFilePathRelative = m_File.GetFilePathRelative().GetView();
+
+  const wdUInt64 uiFileSize = m_File.GetFileSize();
+  if (uiFileSize > wdMath::MaxValue<wdUInt32>())
+  {
+    wdLog::Error("File '{}' is too large to be accessed as one block of memory", m_sFilePathAbsolute);
+    Close();
+    return WD_FAILURE;
+  }
+
+  // uncompressed archive entries are already in memory
+  m_Data = m_File.GetMappedData();
+  if (!m_Data.IsEmpty() || uiFileSize == 0)
+  {
+    m_bMapped = true;
+    return WD_SUCCESS;
+  }
+
+#if WD_ENABLED(WD_SUPPORTS_MEMORY_MAPPED_FILE)
+  if (uiFileSize >= s_uiMinMappedFileSize && wdOSFile::ExistsFile(m_sFilePathAbsolute))
+  {
+    WD_PROFILE_SCOPE("MapFile");
+
+    if (m_MappedFile.Open(m_sFilePathAbsolute, wdMemoryMappedFile::Mode::ReadOnly).Succeeded())
+    {
+      m_Data = wdArrayPtr<const wdUInt8>(static_cast<const wdUInt8*>(m_MappedFile.GetReadPointer()), static_cast<wdUInt32>(m_MappedFile.GetFileSize()));
+      m_bMapped = true;
+
+      // the mapping stays valid without the file handle
+      m_File.Close();
+      return WD_SUCCESS;
+    }
+  }
+#endif
+
+  WD_PROFILE_SCOPE("ReadFile");
+
+  m_Storage.SetCountUninitialized(uiFileSize);
+  wdUInt8* pStorage = m_Storage.GetBlobPtr<wdUInt8>().GetPtr();
+
+  if (m_File.ReadBytes(pStorage, uiFileSize) != uiFileSize)
+  {
+    wdLog::Error("Failed to read file '{}'", m_sFilePathAbsolute);
+    Close();
+    return WD_FAILURE;
+  }
+
+  m_Data = wdArrayPtr<const wdUInt8>(pStorage, static_cast<wdUInt32>(uiFileSize));
+  m_File.Close();
+  return WD_SUCCESS;
+}
+
+void wdMappedFileContent::Close()
+{
+  m_Data.Clear();
+  m_bMapped = false;
+  m_Storage.Clear();
+  m_File.Close();
+
+#if WD_ENABLED(WD_SUPPORTS_MEMORY_MAPPED_FILE)
+  m_MappedFile.Close();
+#endif
+}
+
+WD_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_MappedFileContent);
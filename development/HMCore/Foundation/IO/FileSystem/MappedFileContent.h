@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Foundation/Containers/Blob.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryMappedFile.h>
+
+/// \brief Provides the entire content of a file as one contiguous block of memory, without copying it where possible.
+///
+/// Files in uncompressed archive entries are accessed directly in the memory mapped archive.
+/// Other files that exist on disk are mapped into memory, if they are at least s_uiMinMappedFileSize bytes large.
+/// Everything else is read into internal storage.
+///
+/// The content stays valid until Close() is called or the object is destroyed.
+class WD_FOUNDATION_DLL wdMappedFileContent
+{
+  WD_DISALLOW_COPY_AND_ASSIGN(wdMappedFileContent);
+
+public:
+  wdMappedFileContent();
+  ~wdMappedFileContent();
+
+  /// \brief Opens the given file through wdFileSystem and makes its content accessible.
+  wdResult Open(wdStringView sFile, wdFileShareMode::Enum fileShareMode = wdFileShareMode::Default);
+
+  /// \brief Releases the content.
+  void Close();
+
+  /// \brief Returns the entire content of the file.
+  wdArrayPtr<const wdUInt8> GetData() const { return m_Data; }
+
+  /// \brief Returns true, if the content is accessed in place, instead of being read into internal storage.
+  bool IsMapped() const { return m_bMapped; }
+
+  /// \brief Returns the absolute path with which the file was opened (including the prefix of the data directory).
+  const wdString& GetFilePathAbsolute() const { return m_sFilePathAbsolute; }
+
+  /// \brief Returns the relative path of the file within its data directory.
+  const wdString& GetFilePathRelative() const { return m_sFilePathRelative; }
+
+  /// \brief Files smaller than this are read instead of mapped, since mapping them costs more than reading them.
+  static wdUInt64 s_uiMinMappedFileSize;
+
+private:
+  wdFileReader m_File;
+#if WD_ENABLED(WD_SUPPORTS_MEMORY_MAPPED_FILE)
+  wdMemoryMappedFile m_MappedFile;
+#endif
+  wdBlob m_Storage;
+  wdArrayPtr<const wdUInt8> m_Data;
+  bool m_bMapped = false;
+  wdString m_sFilePathAbsolute;
+  wdString m_sFilePathRelative;
+};
@@ -183,7 +183,11 @@ void wdCompressedStreamWriterZstd::SetOutputStream(wdStreamWriter* pOutputStream
       m_pZstdCStream = ZSTD_createCStream();
     }
 
-    const wdUInt32 uiCoreCount = wdMath::Clamp(wdSystemInformation::Get().GetCPUCoreCount(), 1u, 12u);
+    wdUInt32 uiCoreCount = wdMath::Clamp(wdSystemInformation::Get().GetCPUCoreCount(), 1u, 12u);
+
+    // always keep at least one worker, zstd produces different output in single-threaded mode
+    if (m_uiMaxCompressionThreads > 0)
+      uiCoreCount = wdMath::Min(uiCoreCount, m_uiMaxCompressionThreads);
 
     ZSTD_CCtx_reset(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), ZSTD_reset_session_only);
     ZSTD_CCtx_refCDict(reinterpret_cast<ZSTD_CStream*>(m_pZstdCStream), nullptr);
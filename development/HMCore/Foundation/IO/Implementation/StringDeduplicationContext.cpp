@@ -99,6 +99,12 @@ wdStringDeduplicationReadContext::wdStringDeduplicationReadContext(wdStreamReade
   SetContext(this);
 }
 
+wdStringDeduplicationReadContext::wdStringDeduplicationReadContext(const wdStringDeduplicationReadContext* pSharedContext)
+  : wdSerializationContext()
+  , m_pSharedContext(pSharedContext)
+{
+}
+
 wdStringDeduplicationReadContext::~wdStringDeduplicationReadContext() = default;
 
 wdStringView wdStringDeduplicationReadContext::DeserializeString(wdStreamReader& ref_reader)
@@ -106,6 +112,9 @@ wdStringView wdStringDeduplicationReadContext::DeserializeString(wdStreamReader&
   wdUInt32 uiIndex;
   ref_reader >> uiIndex;
 
+  if (m_pSharedContext != nullptr)
+    return m_pSharedContext->m_DeduplicatedStrings[uiIndex].GetView();
+
   return m_DeduplicatedStrings[uiIndex].GetView();
 }
 
@@ -56,11 +56,17 @@ class WD_FOUNDATION_DLL wdStringDeduplicationReadContext : public wdSerializatio
 public:
   /// \brief Setup the string table used internally.
   wdStringDeduplicationReadContext(wdStreamReader& inout_stream);
+
+  /// \brief Uses the string table of pSharedContext instead of reading one, e.g. to deserialize on multiple threads at the same time.
+  ///
+  /// The shared context must outlive this one. Its string table is only read.
+  explicit wdStringDeduplicationReadContext(const wdStringDeduplicationReadContext* pSharedContext);
   ~wdStringDeduplicationReadContext();
 
   /// \brief Internal method to deserialize a string.
   wdStringView DeserializeString(wdStreamReader& ref_reader);
 
 protected:
+  const wdStringDeduplicationReadContext* m_pSharedContext = nullptr;
   wdDynamicArray<wdHybridString<64>> m_DeduplicatedStrings;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Memory/ThreadLocalStackAllocator.h>
 
 /// \brief A double buffered stack allocator
 class WD_FOUNDATION_DLL wdDoubleBufferedStackAllocator
@@ -21,6 +22,32 @@ private:
   StackAllocatorType* m_pOtherAllocator;
 };
 
+/// \brief A double buffered stack allocator where every thread allocates from its own memory without taking a lock.
+///
+/// \see wdThreadLocalStackAllocator
+class WD_FOUNDATION_DLL wdDoubleBufferedThreadLocalStackAllocator
+{
+public:
+  wdDoubleBufferedThreadLocalStackAllocator(const char* szName, wdAllocatorBase* pParent);
+  ~wdDoubleBufferedThreadLocalStackAllocator();
+
+  WD_ALWAYS_INLINE wdAllocatorBase* GetCurrentAllocator() const { return m_pCurrentAllocator; }
+
+  void Swap();
+  void Reset();
+
+  /// \brief Returns the per thread memory usage of the current allocator.
+  void GetThreadStats(wdDynamicArray<wdThreadLocalStackAllocator::ThreadStats>& out_stats) const { m_pCurrentAllocator->GetThreadStats(out_stats); }
+
+private:
+  wdThreadLocalStackAllocator* m_pCurrentAllocator;
+  wdThreadLocalStackAllocator* m_pOtherAllocator;
+};
+
+/// \brief Global allocator for memory that only needs to live until the end of the next frame.
+///
+/// Allocations are lock-free for every thread. Swap() publishes how much memory every thread needed in the frame that just ended
+/// through wdStats ("FrameAllocator/Thread N/..."), which helps to size memory budgets.
 class WD_FOUNDATION_DLL wdFrameAllocator
 {
 public:
@@ -35,5 +62,7 @@ private:
   static void Startup();
   static void Shutdown();
 
-  static wdDoubleBufferedStackAllocator* s_pAllocator;
+  static void PublishThreadStats();
+
+  static wdDoubleBufferedThreadLocalStackAllocator* s_pAllocator;
 };
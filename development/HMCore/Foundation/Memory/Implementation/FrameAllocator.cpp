@@ -4,6 +4,7 @@
 #include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Utilities/Stats.h>
 
 wdDoubleBufferedStackAllocator::wdDoubleBufferedStackAllocator(const char* szName, wdAllocatorBase* pParent)
 {
@@ -37,6 +38,38 @@ void wdDoubleBufferedStackAllocator::Reset()
   m_pOtherAllocator->Reset();
 }
 
+wdDoubleBufferedThreadLocalStackAllocator::wdDoubleBufferedThreadLocalStackAllocator(const char* szName, wdAllocatorBase* pParent)
+{
+  wdStringBuilder sName = szName;
+  sName.Append("0");
+
+  m_pCurrentAllocator = WD_DEFAULT_NEW(wdThreadLocalStackAllocator, sName, pParent);
+
+  sName = szName;
+  sName.Append("1");
+
+  m_pOtherAllocator = WD_DEFAULT_NEW(wdThreadLocalStackAllocator, sName, pParent);
+}
+
+wdDoubleBufferedThreadLocalStackAllocator::~wdDoubleBufferedThreadLocalStackAllocator()
+{
+  WD_DEFAULT_DELETE(m_pCurrentAllocator);
+  WD_DEFAULT_DELETE(m_pOtherAllocator);
+}
+
+void wdDoubleBufferedThreadLocalStackAllocator::Swap()
+{
+  wdMath::Swap(m_pCurrentAllocator, m_pOtherAllocator);
+
+  m_pCurrentAllocator->Reset();
+}
+
+void wdDoubleBufferedThreadLocalStackAllocator::Reset()
+{
+  m_pCurrentAllocator->Reset();
+  m_pOtherAllocator->Reset();
+}
+
 
 // clang-format off
 WD_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FrameAllocator)
@@ -54,13 +87,15 @@ WD_BEGIN_SUBSYSTEM_DECLARATION(Foundation, FrameAllocator)
 WD_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
-wdDoubleBufferedStackAllocator* wdFrameAllocator::s_pAllocator;
+wdDoubleBufferedThreadLocalStackAllocator* wdFrameAllocator::s_pAllocator;
 
 // static
 void wdFrameAllocator::Swap()
 {
   WD_PROFILE_SCOPE("FrameAllocator.Swap");
 
+  PublishThreadStats();
+
   s_pAllocator->Swap();
 }
 
@@ -76,7 +111,7 @@ void wdFrameAllocator::Reset()
 // static
 void wdFrameAllocator::Startup()
 {
-  s_pAllocator = WD_DEFAULT_NEW(wdDoubleBufferedStackAllocator, "FrameAllocator", wdFoundation::GetAlignedAllocator());
+  s_pAllocator = WD_DEFAULT_NEW(wdDoubleBufferedThreadLocalStackAllocator, "FrameAllocator", wdFoundation::GetAlignedAllocator());
 }
 
 // static
@@ -85,4 +120,28 @@ void wdFrameAllocator::Shutdown()
   WD_DEFAULT_DELETE(s_pAllocator);
 }
 
+// static
+void wdFrameAllocator::PublishThreadStats()
+{
+  wdHybridArray<wdThreadLocalStackAllocator::ThreadStats, wdThreadLocalStackAllocator::MaxThreadArenas + 1> threadStats;
+  s_pAllocator->GetThreadStats(threadStats);
+
+  wdStringBuilder sStatName;
+
+  for (const auto& stats : threadStats)
+  {
+    sStatName.Format("FrameAllocator/Thread {}/Used Memory", stats.m_uiArenaIndex);
+    wdStats::SetStat(sStatName, stats.m_uiUsedMemory);
+
+    sStatName.Format("FrameAllocator/Thread {}/Peak Used Memory", stats.m_uiArenaIndex);
+    wdStats::SetStat(sStatName, stats.m_uiPeakUsedMemory);
+
+    sStatName.Format("FrameAllocator/Thread {}/Reserved Memory", stats.m_uiArenaIndex);
+    wdStats::SetStat(sStatName, stats.m_uiReservedMemory);
+
+    sStatName.Format("FrameAllocator/Thread {}/Allocations", stats.m_uiArenaIndex);
+    wdStats::SetStat(sStatName, stats.m_uiNumAllocations);
+  }
+}
+
 WD_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_FrameAllocator);
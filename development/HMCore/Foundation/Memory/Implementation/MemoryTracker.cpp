@@ -7,6 +7,7 @@
 #include <Foundation/Memory/Policies/HeapAllocation.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -36,9 +37,68 @@ namespace
 
     wdAllocatorId m_ParentId;
 
+    // stats that were set directly or folded in from threads that have exited, the thread local deltas have to be added on top
     wdAllocatorBase::Stats m_Stats;
 
-    wdHashTable<const void*, wdMemoryTracker::AllocationInfo, wdHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    // m_Stats plus the deltas of all threads, updated whenever the stats are queried
+    wdAllocatorBase::Stats m_MergedStats;
+  };
+
+  struct AllocationEntry
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdMemoryTracker::AllocationInfo m_Info;
+    wdAllocatorId m_AllocatorId;
+  };
+
+  // A proxy allocator tracks the same address as its parent, so an allocation is only unique together with its allocator.
+  struct AllocationKey
+  {
+    WD_DECLARE_POD_TYPE();
+
+    const void* m_pPtr;
+    wdAllocatorId m_AllocatorId;
+  };
+
+  struct AllocationKeyHashHelper
+  {
+    WD_ALWAYS_INLINE static wdUInt32 Hash(const AllocationKey& key)
+    {
+      return wdHashHelper<const void*>::Hash(key.m_pPtr) ^ (key.m_AllocatorId.m_Data * 2654435761u);
+    }
+
+    WD_ALWAYS_INLINE static bool Equal(const AllocationKey& a, const AllocationKey& b) { return a.m_pPtr == b.m_pPtr && a.m_AllocatorId == b.m_AllocatorId; }
+  };
+
+  // The live allocations of all allocators are distributed over several tables by their address, so that allocating on different
+  // threads rarely needs the same lock.
+  struct alignas(64) AllocationShard
+  {
+    WD_ALWAYS_INLINE void Lock() { m_Mutex.Lock(); }
+    WD_ALWAYS_INLINE void Unlock() { m_Mutex.Unlock(); }
+
+    wdMutex m_Mutex;
+    wdHashTable<AllocationKey, AllocationEntry, AllocationKeyHashHelper, TrackerDataAllocatorWrapper> m_Allocations;
+  };
+
+  constexpr wdUInt32 NumAllocationShards = 64;
+
+  WD_ALWAYS_INLINE wdUInt32 GetShardIndex(const void* pPtr)
+  {
+    const size_t uiAddress = reinterpret_cast<size_t>(pPtr);
+    return static_cast<wdUInt32>((uiAddress >> 4) ^ (uiAddress >> 10) ^ (uiAddress >> 16)) & (NumAllocationShards - 1);
+  }
+
+  // Allocators with a smaller instance index count their allocations in thread local stats, which are merged when the stats are queried.
+  // All other allocators update their stats under the tracker lock.
+  constexpr wdUInt32 MaxThreadLocalAllocators = 512;
+
+  struct ThreadStats
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdAllocatorBase::Stats m_Stats[MaxThreadLocalAllocators];
   };
 
   struct TrackerData
@@ -52,6 +112,13 @@ namespace
     AllocatorTable m_AllocatorData;
 
     wdAllocatorId m_StaticAllocatorId;
+
+    wdDynamicArray<ThreadStats*, TrackerDataAllocatorWrapper> m_ThreadStats;
+    wdDynamicArray<ThreadStats*, TrackerDataAllocatorWrapper> m_UnusedThreadStats;
+
+    AllocationShard m_Shards[NumAllocationShards];
+
+    wdAtomicInteger32 m_iStackTraceSampleRate = 1;
   };
 
   static TrackerData* s_pTrackerData;
@@ -84,6 +151,98 @@ namespace
     s_bIsInitializing = false;
   }
 
+  static void AddStats(wdAllocatorBase::Stats& ref_stats, const wdAllocatorBase::Stats& delta)
+  {
+    // the sizes are unsigned, but deltas may 'underflow' when memory is freed on another thread than where it was allocated
+    ref_stats.m_uiNumAllocations += delta.m_uiNumAllocations;
+    ref_stats.m_uiNumDeallocations += delta.m_uiNumDeallocations;
+    ref_stats.m_uiAllocationSize += delta.m_uiAllocationSize;
+    ref_stats.m_uiPerFrameAllocationSize += delta.m_uiPerFrameAllocationSize;
+    ref_stats.m_PerFrameAllocationTime += delta.m_PerFrameAllocationTime;
+  }
+
+  // s_pTrackerData has to be locked
+  static const wdAllocatorBase::Stats& MergeStats(wdAllocatorId allocatorId, AllocatorData& ref_data)
+  {
+    ref_data.m_MergedStats = ref_data.m_Stats;
+
+    if (allocatorId.m_InstanceIndex < MaxThreadLocalAllocators)
+    {
+      for (const ThreadStats* pThreadStats : s_pTrackerData->m_ThreadStats)
+      {
+        AddStats(ref_data.m_MergedStats, pThreadStats->m_Stats[allocatorId.m_InstanceIndex]);
+      }
+    }
+
+    return ref_data.m_MergedStats;
+  }
+
+  // Gives every thread its own stats, which are folded back into the allocator data when the thread exits.
+  struct ThreadStatsHolder
+  {
+    ~ThreadStatsHolder();
+
+    ThreadStats* m_pStats = nullptr;
+  };
+
+  thread_local ThreadStatsHolder tl_ThreadStats;
+  thread_local bool tl_bThreadStatsReleased = false;
+  thread_local wdUInt32 tl_uiStackTraceCounter = 0;
+
+  ThreadStatsHolder::~ThreadStatsHolder()
+  {
+    tl_bThreadStatsReleased = true;
+
+    if (m_pStats == nullptr)
+      return;
+
+    WD_LOCK(*s_pTrackerData);
+
+    for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
+    {
+      if (it.Id().m_InstanceIndex < MaxThreadLocalAllocators)
+      {
+        AddStats(it.Value().m_Stats, m_pStats->m_Stats[it.Id().m_InstanceIndex]);
+      }
+    }
+
+    wdMemoryUtils::ZeroFill(m_pStats, 1);
+
+    s_pTrackerData->m_ThreadStats.RemoveAndSwap(m_pStats);
+    s_pTrackerData->m_UnusedThreadStats.PushBack(m_pStats);
+    m_pStats = nullptr;
+  }
+
+  /// Returns the stats of this thread for the given allocator, or nullptr if they have to be updated under the tracker lock.
+  static wdAllocatorBase::Stats* GetThreadStats(wdAllocatorId allocatorId)
+  {
+    if (allocatorId.m_InstanceIndex >= MaxThreadLocalAllocators || tl_bThreadStatsReleased)
+      return nullptr;
+
+    ThreadStats* pStats = tl_ThreadStats.m_pStats;
+
+    if (pStats == nullptr)
+    {
+      WD_LOCK(*s_pTrackerData);
+
+      if (!s_pTrackerData->m_UnusedThreadStats.IsEmpty())
+      {
+        pStats = s_pTrackerData->m_UnusedThreadStats.PeekBack();
+        s_pTrackerData->m_UnusedThreadStats.PopBack();
+      }
+      else
+      {
+        pStats = WD_NEW(s_pTrackerDataAllocator, ThreadStats);
+        wdMemoryUtils::ZeroFill(pStats, 1);
+      }
+
+      s_pTrackerData->m_ThreadStats.PushBack(pStats);
+      tl_ThreadStats.m_pStats = pStats;
+    }
+
+    return &pStats->m_Stats[allocatorId.m_InstanceIndex];
+  }
+
   static void DumpLeak(const wdMemoryTracker::AllocationInfo& info, const char* szAllocatorName)
   {
     char szBuffer[512];
@@ -121,7 +280,7 @@ wdAllocatorId wdMemoryTracker::Iterator::ParentId() const
 
 const wdAllocatorBase::Stats& wdMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  return CAST_ITER(m_pData)->Value().m_MergedStats;
 }
 
 void wdMemoryTracker::Iterator::Next()
@@ -169,19 +328,37 @@ void wdMemoryTracker::DeregisterAllocator(wdAllocatorId allocatorId)
 {
   WD_LOCK(*s_pTrackerData);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  const wdAllocatorBase::Stats& stats = MergeStats(allocatorId, data);
 
-  wdUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
-  if (uiLiveAllocations != 0)
+  const wdUInt64 uiLiveAllocations = stats.m_uiNumAllocations - stats.m_uiNumDeallocations;
+  if (uiLiveAllocations != 0 && data.m_Flags.IsSet(wdMemoryTrackingFlags::EnableAllocationTracking))
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    for (AllocationShard& shard : s_pTrackerData->m_Shards)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      WD_LOCK(shard);
+
+      for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+      {
+        if (it.Value().m_AllocatorId == allocatorId)
+        {
+          DumpLeak(it.Value().m_Info, data.m_sName.GetData());
+        }
+      }
     }
 
     WD_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
   }
 
+  // the instance index may be reused by another allocator
+  if (allocatorId.m_InstanceIndex < MaxThreadLocalAllocators)
+  {
+    for (ThreadStats* pThreadStats : s_pTrackerData->m_ThreadStats)
+    {
+      wdMemoryUtils::ZeroFill(&pThreadStats->m_Stats[allocatorId.m_InstanceIndex], 1);
+    }
+  }
+
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
 }
 
@@ -195,14 +372,40 @@ void wdMemoryTracker::AddAllocation(wdAllocatorId allocatorId, wdBitflags<wdMemo
   wdArrayPtr<void*> stackTrace;
   if (flags.IsSet(wdMemoryTrackingFlags::EnableStackTrace))
   {
-    void* pBuffer[64];
-    wdArrayPtr<void*> tempTrace(pBuffer);
-    const wdUInt32 uiNumTraces = wdStackTracer::GetStackTrace(tempTrace);
+    const wdUInt32 uiSampleRate = static_cast<wdUInt32>((wdInt32)s_pTrackerData->m_iStackTraceSampleRate);
+
+    if (uiSampleRate > 0 && ++tl_uiStackTraceCounter >= uiSampleRate)
+    {
+      tl_uiStackTraceCounter = 0;
+
+      void* pBuffer[64];
+      wdArrayPtr<void*> tempTrace(pBuffer);
+      const wdUInt32 uiNumTraces = wdStackTracer::GetStackTrace(tempTrace);
 
-    stackTrace = WD_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
-    wdMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
+      stackTrace = WD_NEW_ARRAY(s_pTrackerDataAllocator, void*, uiNumTraces);
+      wdMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
+    }
   }
 
+  {
+    AllocationShard& shard = s_pTrackerData->m_Shards[GetShardIndex(pPtr)];
+    WD_LOCK(shard);
+
+    AllocationEntry& entry = shard.m_Allocations[AllocationKey{pPtr, allocatorId}];
+    entry.m_AllocatorId = allocatorId;
+    entry.m_Info.m_uiSize = uiSize;
+    entry.m_Info.m_uiAlignment = (wdUInt16)uiAlign;
+    entry.m_Info.SetStackTrace(stackTrace);
+  }
+
+  if (wdAllocatorBase::Stats* pStats = GetThreadStats(allocatorId))
+  {
+    pStats->m_uiNumAllocations++;
+    pStats->m_uiAllocationSize += uiSize;
+    pStats->m_uiPerFrameAllocationSize += uiSize;
+    pStats->m_PerFrameAllocationTime += allocationTime;
+  }
+  else
   {
     WD_LOCK(*s_pTrackerData);
 
@@ -213,37 +416,40 @@ void wdMemoryTracker::AddAllocation(wdAllocatorId allocatorId, wdBitflags<wdMemo
     data.m_Stats.m_PerFrameAllocationTime += allocationTime;
 
     WD_ASSERT_DEBUG(data.m_Flags == flags, "Given flags have to be identical to allocator flags");
-    auto pInfo = &data.m_Allocations[pPtr];
-    pInfo->m_uiSize = uiSize;
-    pInfo->m_uiAlignment = (wdUInt16)uiAlign;
-    pInfo->SetStackTrace(stackTrace);
   }
 }
 
 // static
 void wdMemoryTracker::RemoveAllocation(wdAllocatorId allocatorId, const void* pPtr)
 {
-  wdArrayPtr<void*> stackTrace;
+  AllocationEntry entry;
 
   {
-    WD_LOCK(*s_pTrackerData);
-
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    AllocationShard& shard = s_pTrackerData->m_Shards[GetShardIndex(pPtr)];
+    WD_LOCK(shard);
 
-    AllocationInfo info;
-    if (data.m_Allocations.Remove(pPtr, &info))
+    if (!shard.m_Allocations.Remove(AllocationKey{pPtr, allocatorId}, &entry))
     {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
-
-      stackTrace = info.GetStackTrace();
-    }
-    else
-    {
-      WD_REPORT_FAILURE("Invalid Allocation '{0}'. Memory corruption?", wdArgP(pPtr));
+      WD_REPORT_FAILURE("Invalid Allocation '{0}'. Memory corruption or freed through a different allocator than it was allocated with?", wdArgP(pPtr));
+      return;
     }
   }
 
+  if (wdAllocatorBase::Stats* pStats = GetThreadStats(allocatorId))
+  {
+    pStats->m_uiNumDeallocations++;
+    pStats->m_uiAllocationSize -= entry.m_Info.m_uiSize;
+  }
+  else
+  {
+    WD_LOCK(*s_pTrackerData);
+
+    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+    data.m_Stats.m_uiNumDeallocations++;
+    data.m_Stats.m_uiAllocationSize -= entry.m_Info.m_uiSize;
+  }
+
+  wdArrayPtr<void*> stackTrace = entry.m_Info.GetStackTrace();
   WD_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
 }
 
@@ -252,15 +458,33 @@ void wdMemoryTracker::RemoveAllAllocations(wdAllocatorId allocatorId)
 {
   WD_LOCK(*s_pTrackerData);
   AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+
+  const wdAllocatorBase::Stats& stats = MergeStats(allocatorId, data);
+  if (stats.m_uiNumAllocations == stats.m_uiNumDeallocations)
+    return;
+
+  for (AllocationShard& shard : s_pTrackerData->m_Shards)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    WD_LOCK(shard);
+
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid();)
+    {
+      if (it.Value().m_AllocatorId == allocatorId)
+      {
+        auto& info = it.Value().m_Info;
+        data.m_Stats.m_uiNumDeallocations++;
+        data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
 
-    WD_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+        WD_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+
+        it = shard.m_Allocations.Remove(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
   }
-  data.m_Allocations.Clear();
 }
 
 // static
@@ -269,6 +493,14 @@ void wdMemoryTracker::SetAllocatorStats(wdAllocatorId allocatorId, const wdAlloc
   WD_LOCK(*s_pTrackerData);
 
   s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+
+  if (allocatorId.m_InstanceIndex < MaxThreadLocalAllocators)
+  {
+    for (ThreadStats* pThreadStats : s_pTrackerData->m_ThreadStats)
+    {
+      wdMemoryUtils::ZeroFill(&pThreadStats->m_Stats[allocatorId.m_InstanceIndex], 1);
+    }
+  }
 }
 
 // static
@@ -282,6 +514,32 @@ void wdMemoryTracker::ResetPerFrameAllocatorStats()
     data.m_Stats.m_uiPerFrameAllocationSize = 0;
     data.m_Stats.m_PerFrameAllocationTime.SetZero();
   }
+
+  // other threads may still add to these concurrently, per frame stats are only meant to be approximate
+  for (ThreadStats* pThreadStats : s_pTrackerData->m_ThreadStats)
+  {
+    for (wdAllocatorBase::Stats& stats : pThreadStats->m_Stats)
+    {
+      stats.m_uiPerFrameAllocationSize = 0;
+      stats.m_PerFrameAllocationTime.SetZero();
+    }
+  }
+}
+
+// static
+void wdMemoryTracker::SetStackTraceSampleRate(wdUInt32 uiSampleRate)
+{
+  Initialize();
+
+  s_pTrackerData->m_iStackTraceSampleRate = static_cast<wdInt32>(uiSampleRate);
+}
+
+// static
+wdUInt32 wdMemoryTracker::GetStackTraceSampleRate()
+{
+  Initialize();
+
+  return static_cast<wdUInt32>((wdInt32)s_pTrackerData->m_iStackTraceSampleRate);
 }
 
 // static
@@ -297,7 +555,7 @@ const wdAllocatorBase::Stats& wdMemoryTracker::GetAllocatorStats(wdAllocatorId a
 {
   WD_LOCK(*s_pTrackerData);
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+  return MergeStats(allocatorId, s_pTrackerData->m_AllocatorData[allocatorId]);
 }
 
 // static
@@ -311,13 +569,13 @@ wdAllocatorId wdMemoryTracker::GetAllocatorParentId(wdAllocatorId allocatorId)
 // static
 const wdMemoryTracker::AllocationInfo& wdMemoryTracker::GetAllocationInfo(wdAllocatorId allocatorId, const void* pPtr)
 {
-  WD_LOCK(*s_pTrackerData);
+  AllocationShard& shard = s_pTrackerData->m_Shards[GetShardIndex(pPtr)];
+  WD_LOCK(shard);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(pPtr, info))
+  const AllocationEntry* pEntry = nullptr;
+  if (shard.m_Allocations.TryGetValue(AllocationKey{pPtr, allocatorId}, pEntry))
   {
-    return *info;
+    return pEntry->m_Info;
   }
 
   static AllocationInfo invalidInfo;
@@ -349,17 +607,18 @@ void wdMemoryTracker::DumpMemoryLeaks()
   leakTable.Clear();
 
   // first collect all leaks
-  for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
+  for (AllocationShard& shard : s_pTrackerData->m_Shards)
   {
-    const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    WD_LOCK(shard);
+
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
     {
       LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
+      leak.m_AllocatorId = it.Value().m_AllocatorId;
+      leak.m_uiSize = it.Value().m_Info.m_uiSize;
       leak.m_pParentLeak = nullptr;
 
-      leakTable.Insert(it2.Key(), leak);
+      leakTable.Insert(it.Key().m_pPtr, leak);
     }
   }
 
@@ -404,10 +663,14 @@ void wdMemoryTracker::DumpMemoryLeaks()
       }
 
       const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
-      wdMemoryTracker::AllocationInfo info;
-      data.m_Allocations.TryGetValue(ptr, info);
+      AllocationEntry entry;
+      {
+        AllocationShard& shard = s_pTrackerData->m_Shards[GetShardIndex(ptr)];
+        WD_LOCK(shard);
+        shard.m_Allocations.TryGetValue(AllocationKey{ptr, leak.m_AllocatorId}, entry);
+      }
 
-      DumpLeak(info, data.m_sName.GetData());
+      DumpLeak(entry.m_Info, data.m_sName.GetData());
 
       ++uiNumLeaks;
     }
@@ -427,6 +690,15 @@ void wdMemoryTracker::DumpMemoryLeaks()
 // static
 wdMemoryTracker::Iterator wdMemoryTracker::GetIterator()
 {
+  {
+    WD_LOCK(*s_pTrackerData);
+
+    for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
+    {
+      MergeStats(it.Id(), it.Value());
+    }
+  }
+
   auto pInnerIt = WD_NEW(s_pTrackerDataAllocator, TrackerData::AllocatorTable::Iterator, s_pTrackerData->m_AllocatorData.GetIterator());
   return Iterator(pInnerIt);
 }
@@ -0,0 +1,347 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Memory/ThreadLocalStackAllocator.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  // Every thread that allocates from any wdThreadLocalStackAllocator claims one slot, which is the index of its arena in all allocators.
+  // The slot is released when the thread exits. The next thread that claims it continues to use the arenas of the old thread, so neither
+  // the arenas nor their chunks are lost.
+  wdAtomicInteger64 s_iUsedArenaSlots;
+
+  static_assert(wdThreadLocalStackAllocator::MaxThreadArenas <= 64, "The used arena slots are stored in a 64 bit mask");
+  constexpr wdUInt64 AllArenaSlotsUsed = wdThreadLocalStackAllocator::MaxThreadArenas == 64 ? ~0ull : (1ull << wdThreadLocalStackAllocator::MaxThreadArenas) - 1;
+
+  wdUInt32 ClaimArenaSlot()
+  {
+    wdInt64 iUsedSlots = s_iUsedArenaSlots;
+
+    while (static_cast<wdUInt64>(iUsedSlots) != AllArenaSlotsUsed)
+    {
+      const wdUInt32 uiSlot = wdMath::FirstBitLow(~static_cast<wdUInt64>(iUsedSlots));
+      const wdInt64 iPrevUsedSlots = s_iUsedArenaSlots.CompareAndSwap(iUsedSlots, iUsedSlots | static_cast<wdInt64>(1ull << uiSlot));
+
+      if (iPrevUsedSlots == iUsedSlots)
+        return uiSlot;
+
+      iUsedSlots = iPrevUsedSlots;
+    }
+
+    return wdThreadLocalStackAllocator::MaxThreadArenas;
+  }
+
+  struct ThreadArenaSlot
+  {
+    ~ThreadArenaSlot()
+    {
+      if (m_uiSlot < wdThreadLocalStackAllocator::MaxThreadArenas)
+      {
+        s_iUsedArenaSlots.And(~static_cast<wdInt64>(1ull << m_uiSlot));
+      }
+    }
+
+    wdUInt32 m_uiSlot = wdInvalidIndex;
+  };
+
+  thread_local ThreadArenaSlot tl_ArenaSlot;
+
+  WD_ALWAYS_INLINE wdUInt32 GetArenaSlot()
+  {
+    ThreadArenaSlot& slot = tl_ArenaSlot;
+
+    // threads that use the shared arena take over a slot of their own as soon as one becomes free
+    if (slot.m_uiSlot >= wdThreadLocalStackAllocator::MaxThreadArenas && (slot.m_uiSlot == wdInvalidIndex || static_cast<wdUInt64>(s_iUsedArenaSlots) != AllArenaSlotsUsed))
+    {
+      slot.m_uiSlot = ClaimArenaSlot();
+    }
+
+    return slot.m_uiSlot;
+  }
+
+  constexpr wdUInt32 InitialChunkSize = 4096;
+} // namespace
+
+struct wdThreadLocalStackAllocator::Arena
+{
+  Arena(wdAllocatorBase* pParent)
+    : m_Chunks(pParent)
+    , m_Destructors(pParent)
+    , m_Deallocations(pParent)
+  {
+  }
+
+  wdThreadID m_ThreadID;
+
+  wdDynamicArray<wdArrayPtr<wdUInt8>> m_Chunks;
+  wdUInt32 m_uiCurrentChunk = 0;
+  wdUInt32 m_uiNextChunkSize = InitialChunkSize;
+  wdUInt8* m_pNextAllocation = nullptr;
+
+  wdDynamicArray<DestructData> m_Destructors;
+
+  // deallocations that were made by this thread, the memory may have been allocated by any thread
+  wdDynamicArray<void*> m_Deallocations;
+
+  wdUInt64 m_uiNumAllocations = 0;
+  wdUInt64 m_uiUsedMemory = 0;
+  wdUInt64 m_uiPeakUsedMemory = 0;
+  wdUInt64 m_uiReservedMemory = 0;
+};
+
+wdThreadLocalStackAllocator::wdThreadLocalStackAllocator(const char* szName, wdAllocatorBase* pParent)
+  : m_pParent(pParent)
+  , m_DeallocatedPtrs(pParent)
+{
+  wdBitflags<wdMemoryTrackingFlags> flags;
+  flags.SetValue(wdMemoryTrackingFlags::RegisterAllocator);
+
+  m_Id = wdMemoryTracker::RegisterAllocator(szName, flags, pParent->GetId());
+}
+
+wdThreadLocalStackAllocator::~wdThreadLocalStackAllocator()
+{
+  Reset();
+
+  for (Arena*& pArena : m_Arenas)
+  {
+    if (pArena == nullptr)
+      continue;
+
+    for (auto& chunk : pArena->m_Chunks)
+    {
+      m_pParent->Deallocate(chunk.GetPtr());
+    }
+
+    WD_DELETE(m_pParent, pArena);
+  }
+
+  wdMemoryTracker::DeregisterAllocator(m_Id);
+}
+
+void* wdThreadLocalStackAllocator::Allocate(size_t uiSize, size_t uiAlign, wdMemoryUtils::DestructorFunction destructorFunc)
+{
+  // zero size allocations always return nullptr, same as all other allocators
+  if (uiSize == 0)
+    return nullptr;
+
+  WD_ASSERT_DEV(wdMath::IsPowerOf2(static_cast<wdUInt32>(uiAlign)), "Alignment {0} is not a power of two", ((wdUInt32)uiAlign));
+
+  const wdUInt32 uiSlot = GetArenaSlot();
+
+  if (uiSlot < MaxThreadArenas)
+  {
+    // only this thread ever accesses its own arena while allocating
+    Arena* pArena = m_Arenas[uiSlot];
+    if (pArena == nullptr)
+    {
+      pArena = CreateArena();
+      m_Arenas[uiSlot] = pArena;
+    }
+
+    // the arena may have been taken over from a thread that has exited
+    pArena->m_ThreadID = wdThreadUtils::GetCurrentThreadID();
+
+    return AllocateFromArena(*pArena, uiSize, uiAlign, destructorFunc);
+  }
+
+  WD_LOCK(m_SharedArenaMutex);
+
+  if (m_Arenas[MaxThreadArenas] == nullptr)
+  {
+    m_Arenas[MaxThreadArenas] = CreateArena();
+  }
+
+  return AllocateFromArena(*m_Arenas[MaxThreadArenas], uiSize, uiAlign, destructorFunc);
+}
+
+void wdThreadLocalStackAllocator::Deallocate(void* pPtr)
+{
+  // Individual deallocation does not free any memory. The pointer is only remembered, so that Reset() does not call its destructor
+  // a second time. This works the same for memory that was allocated by another thread.
+  if (pPtr == nullptr)
+    return;
+
+  const wdUInt32 uiSlot = GetArenaSlot();
+
+  if (uiSlot < MaxThreadArenas)
+  {
+    Arena* pArena = m_Arenas[uiSlot];
+    if (pArena == nullptr)
+    {
+      pArena = CreateArena();
+      m_Arenas[uiSlot] = pArena;
+    }
+
+    pArena->m_Deallocations.PushBack(pPtr);
+    return;
+  }
+
+  WD_LOCK(m_SharedArenaMutex);
+
+  if (m_Arenas[MaxThreadArenas] == nullptr)
+  {
+    m_Arenas[MaxThreadArenas] = CreateArena();
+  }
+
+  m_Arenas[MaxThreadArenas]->m_Deallocations.PushBack(pPtr);
+}
+
+size_t wdThreadLocalStackAllocator::AllocatedSize(const void* pPtr)
+{
+  if (pPtr == nullptr)
+    return 0;
+
+  // see AllocateFromArena()
+  return *reinterpret_cast<const size_t*>(static_cast<const wdUInt8*>(pPtr) - sizeof(size_t));
+}
+
+wdAllocatorId wdThreadLocalStackAllocator::GetId() const
+{
+  return m_Id;
+}
+
+wdAllocatorBase::Stats wdThreadLocalStackAllocator::GetStats() const
+{
+  return wdMemoryTracker::GetAllocatorStats(m_Id);
+}
+
+void wdThreadLocalStackAllocator::Reset()
+{
+  m_DeallocatedPtrs.Clear();
+
+  for (Arena* pArena : m_Arenas)
+  {
+    if (pArena == nullptr)
+      continue;
+
+    for (void* pPtr : pArena->m_Deallocations)
+    {
+      m_DeallocatedPtrs.Insert(pPtr);
+    }
+
+    pArena->m_Deallocations.Clear();
+  }
+
+  wdAllocatorBase::Stats stats;
+
+  for (wdUInt32 uiArena = WD_ARRAY_SIZE(m_Arenas); uiArena-- > 0;)
+  {
+    Arena* pArena = m_Arenas[uiArena];
+    if (pArena == nullptr)
+      continue;
+
+    for (wdUInt32 i = pArena->m_Destructors.GetCount(); i-- > 0;)
+    {
+      const DestructData& data = pArena->m_Destructors[i];
+
+      if (m_DeallocatedPtrs.IsEmpty() || !m_DeallocatedPtrs.Contains(data.m_Ptr))
+      {
+        data.m_Func(data.m_Ptr);
+      }
+    }
+
+    pArena->m_Destructors.Clear();
+
+    pArena->m_uiCurrentChunk = 0;
+    pArena->m_pNextAllocation = !pArena->m_Chunks.IsEmpty() ? pArena->m_Chunks[0].GetPtr() : nullptr;
+    pArena->m_uiPeakUsedMemory = wdMath::Max(pArena->m_uiPeakUsedMemory, pArena->m_uiUsedMemory);
+    pArena->m_uiUsedMemory = 0;
+    pArena->m_uiNumAllocations = 0;
+
+    stats.m_uiNumAllocations += pArena->m_Chunks.GetCount();
+    stats.m_uiAllocationSize += pArena->m_uiReservedMemory;
+  }
+
+  wdMemoryTracker::SetAllocatorStats(m_Id, stats);
+}
+
+void wdThreadLocalStackAllocator::GetThreadStats(wdDynamicArray<ThreadStats>& out_stats) const
+{
+  for (wdUInt32 uiArena = 0; uiArena < WD_ARRAY_SIZE(m_Arenas); ++uiArena)
+  {
+    const Arena* pArena = m_Arenas[uiArena];
+    if (pArena == nullptr)
+      continue;
+
+    ThreadStats& stats = out_stats.ExpandAndGetRef();
+    stats.m_uiArenaIndex = uiArena;
+    stats.m_ThreadID = pArena->m_ThreadID;
+    stats.m_uiNumAllocations = pArena->m_uiNumAllocations;
+    stats.m_uiUsedMemory = pArena->m_uiUsedMemory;
+    stats.m_uiPeakUsedMemory = wdMath::Max(pArena->m_uiPeakUsedMemory, pArena->m_uiUsedMemory);
+    stats.m_uiReservedMemory = pArena->m_uiReservedMemory;
+  }
+}
+
+wdThreadLocalStackAllocator::Arena* wdThreadLocalStackAllocator::CreateArena()
+{
+  Arena* pArena = WD_NEW(m_pParent, Arena, m_pParent);
+  pArena->m_ThreadID = wdThreadUtils::GetCurrentThreadID();
+  return pArena;
+}
+
+void* wdThreadLocalStackAllocator::AllocateFromArena(Arena& ref_arena, size_t uiSize, size_t uiAlign, wdMemoryUtils::DestructorFunction destructorFunc)
+{
+  // Every allocation is preceded by a header that stores its size for AllocatedSize().
+  // All chunks and sizes are multiples of Alignment, so larger alignments need at most uiAlign - Alignment bytes of additional padding.
+  uiAlign = wdMath::Max<size_t>(uiAlign, Alignment);
+  uiSize = wdMemoryUtils::AlignSize(uiSize, (size_t)Alignment);
+
+  wdUInt8* ptr = ref_arena.m_pNextAllocation != nullptr ? wdMemoryUtils::AlignForwards(ref_arena.m_pNextAllocation + HeaderSize, uiAlign) : nullptr;
+
+  if (ptr == nullptr || ptr + uiSize > ref_arena.m_Chunks[ref_arena.m_uiCurrentChunk].GetEndPtr())
+  {
+    AddChunk(ref_arena, HeaderSize + (uiAlign - Alignment) + uiSize);
+    ptr = wdMemoryUtils::AlignForwards(ref_arena.m_pNextAllocation + HeaderSize, uiAlign);
+  }
+
+  *reinterpret_cast<size_t*>(ptr - sizeof(size_t)) = uiSize;
+
+  ref_arena.m_uiUsedMemory += (ptr + uiSize) - ref_arena.m_pNextAllocation;
+  ref_arena.m_pNextAllocation = ptr + uiSize;
+  ++ref_arena.m_uiNumAllocations;
+
+  if (destructorFunc != nullptr)
+  {
+    auto& data = ref_arena.m_Destructors.ExpandAndGetRef();
+    data.m_Func = destructorFunc;
+    data.m_Ptr = ptr;
+  }
+
+  return ptr;
+}
+
+void wdThreadLocalStackAllocator::AddChunk(Arena& ref_arena, size_t uiSize)
+{
+  // reuse a chunk from a previous frame, if there is one that fits
+  const wdUInt32 uiFirstCandidate = ref_arena.m_pNextAllocation != nullptr ? ref_arena.m_uiCurrentChunk + 1 : 0;
+  for (wdUInt32 i = uiFirstCandidate; i < ref_arena.m_Chunks.GetCount(); ++i)
+  {
+    if (uiSize <= ref_arena.m_Chunks[i].GetCount())
+    {
+      ref_arena.m_uiCurrentChunk = i;
+      ref_arena.m_pNextAllocation = ref_arena.m_Chunks[i].GetPtr();
+      return;
+    }
+  }
+
+  while (uiSize > ref_arena.m_uiNextChunkSize)
+  {
+    ref_arena.m_uiNextChunkSize *= 2;
+  }
+
+  const wdUInt32 uiChunkSize = ref_arena.m_uiNextChunkSize;
+  ref_arena.m_uiNextChunkSize *= 2;
+
+  auto chunk = wdArrayPtr<wdUInt8>(static_cast<wdUInt8*>(m_pParent->Allocate(uiChunkSize, Alignment)), uiChunkSize);
+
+  ref_arena.m_uiCurrentChunk = ref_arena.m_Chunks.GetCount();
+  ref_arena.m_Chunks.PushBack(chunk);
+  ref_arena.m_pNextAllocation = chunk.GetPtr();
+  ref_arena.m_uiReservedMemory += uiChunkSize;
+}
+
+WD_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_ThreadLocalStackAllocator);
@@ -40,6 +40,9 @@ struct wdMemoryTrackingFlags
 #define WD_STATIC_ALLOCATOR_NAME "Statics"
 
 /// \brief Memory tracker which keeps track of all allocations and constructions
+///
+/// The live allocations are stored in several tables that are selected by address, each with its own lock, so that threads rarely block
+/// each other. The allocation stats are counted per thread and merged whenever they are queried.
 class WD_FOUNDATION_DLL wdMemoryTracker
 {
 public:
@@ -109,6 +112,13 @@ public:
 
   static void ResetPerFrameAllocatorStats();
 
+  /// \brief Allocators with wdMemoryTrackingFlags::EnableStackTrace only capture the stack trace of every n-th allocation per thread.
+  ///
+  /// Capturing stack traces is by far the most expensive part of tracking. A sample rate of 1 (the default) captures every allocation,
+  /// 0 disables stack traces completely. Leaks of allocations without a stack trace are still reported, just without call stack.
+  static void SetStackTraceSampleRate(wdUInt32 uiSampleRate);
+  static wdUInt32 GetStackTraceSampleRate();
+
   static const char* GetAllocatorName(wdAllocatorId allocatorId);
   static const wdAllocatorBase::Stats& GetAllocatorStats(wdAllocatorId allocatorId);
   static wdAllocatorId GetAllocatorParentId(wdAllocatorId allocatorId);
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashSet.h>
+#include <Foundation/Memory/AllocatorBase.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+/// \brief A stack allocator that gives every thread its own memory, so that allocating never requires a lock.
+///
+/// Every thread that allocates gets its own arena, a list of memory chunks from which it allocates by just incrementing a pointer.
+/// Like with wdStackAllocator individual deallocations don't free any memory, but they may happen on any thread.
+/// Reset() frees all allocations at once, calls the destructors of all objects that have not been deallocated before and keeps the
+/// chunks of every thread around, so that they can be reused without going to the parent allocator again.
+///
+/// At most MaxThreadArenas threads have an arena of their own at the same time, all other threads share one arena that is protected by a
+/// mutex. When a thread exits, its arena is handed over to the next thread that needs one.
+///
+/// Every allocation is preceded by a header of Alignment bytes that stores its size. Alignments larger than Alignment are supported,
+/// but need additional padding.
+///
+/// Reset() and GetThreadStats() must not be called while other threads allocate from this allocator.
+/// Destructors are called in reverse allocation order per thread, but there is no defined order between different threads.
+class WD_FOUNDATION_DLL wdThreadLocalStackAllocator : public wdAllocatorBase
+{
+public:
+  enum
+  {
+    Alignment = 16,
+    HeaderSize = Alignment,
+    MaxThreadArenas = 64,
+  };
+
+  /// \brief Memory usage of a single thread since the last Reset().
+  struct ThreadStats
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiArenaIndex = 0;     ///< Stable index of the thread, MaxThreadArenas for the arena that is shared by all remaining threads.
+    wdThreadID m_ThreadID;           ///< The thread that allocated from the arena most recently.
+    wdUInt64 m_uiNumAllocations = 0; ///< Number of allocations since the last Reset().
+    wdUInt64 m_uiUsedMemory = 0;     ///< Bytes allocated since the last Reset().
+    wdUInt64 m_uiPeakUsedMemory = 0; ///< Highest value of m_uiUsedMemory before any Reset().
+    wdUInt64 m_uiReservedMemory = 0; ///< Bytes that the arena holds in its chunks.
+  };
+
+  wdThreadLocalStackAllocator(const char* szName, wdAllocatorBase* pParent);
+  ~wdThreadLocalStackAllocator();
+
+  // wdAllocatorBase implementation
+  virtual void* Allocate(size_t uiSize, size_t uiAlign, wdMemoryUtils::DestructorFunction destructorFunc = nullptr) override;
+  virtual void Deallocate(void* pPtr) override;
+  virtual size_t AllocatedSize(const void* pPtr) override;
+  virtual wdAllocatorId GetId() const override;
+  virtual Stats GetStats() const override;
+
+  /// \brief Frees all allocations of all threads at once and calls the outstanding destructors. The memory chunks are kept for reuse.
+  void Reset();
+
+  /// \brief Appends the memory usage of every thread that has allocated from this allocator so far.
+  void GetThreadStats(wdDynamicArray<ThreadStats>& out_stats) const;
+
+private:
+  struct Arena;
+
+  struct DestructData
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdMemoryUtils::DestructorFunction m_Func;
+    void* m_Ptr;
+  };
+
+  Arena* CreateArena();
+  void* AllocateFromArena(Arena& ref_arena, size_t uiSize, size_t uiAlign, wdMemoryUtils::DestructorFunction destructorFunc);
+  void AddChunk(Arena& ref_arena, size_t uiSize);
+
+  wdAllocatorBase* m_pParent = nullptr;
+  wdAllocatorId m_Id;
+
+  // the last one is the shared arena
+  Arena* m_Arenas[MaxThreadArenas + 1] = {};
+  wdMutex m_SharedArenaMutex;
+
+  wdHashSet<void*> m_DeallocatedPtrs;
+};
@@ -8,6 +8,7 @@
 #include <Foundation/Containers/StaticRingBuffer.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
+#include <Foundation/Profiling/Implementation/ProfilingTraceStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
@@ -43,6 +44,7 @@ WD_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   ON_CORESYSTEMS_SHUTDOWN
   {
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
+    wdProfilingSystem::StopTraceStream();
     wdProfilingSystem::Reset();
   }
 
@@ -135,6 +137,9 @@ void wdProfilingSystem::ProfilingData::Clear()
   m_FrameStartTimes.Clear();
   m_GPUScopes.Clear();
   m_ThreadInfos.Clear();
+  m_CounterSamples.Clear();
+  m_FlowEvents.Clear();
+  m_TraceStrings.Clear();
 }
 
 void wdProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, wdArrayPtr<const ProfilingData*> inputs)
@@ -170,6 +175,14 @@ void wdProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, wdArrayP
     }
   }
 
+  // concatenate the data that is only recorded by trace streams
+  for (const auto& pd : inputs)
+  {
+    out_merged.m_CounterSamples.PushBackRange(pd->m_CounterSamples);
+    out_merged.m_FlowEvents.PushBackRange(pd->m_FlowEvents);
+    out_merged.m_TraceStrings.PushBackRange(pd->m_TraceStrings);
+  }
+
   // merge m_ThreadInfos
   {
     auto threadInfoAlreadyKnown = [out_merged](wdUInt64 uiThreadId) -> bool {
@@ -521,6 +534,60 @@ wdResult wdProfilingSystem::ProfilingData::Write(wdStreamWriter& ref_outputStrea
       }
     }
 
+    // counter tracks
+    for (const CounterSample& sample : m_CounterSamples)
+    {
+      writer.BeginObject();
+      writer.AddVariableString("name", sample.m_sName);
+      writer.AddVariableUInt32("pid", m_uiProcessID);
+      writer.AddVariableUInt64("ts", static_cast<wdUInt64>(sample.m_Time.GetMicroseconds()));
+      writer.AddVariableString("ph", "C");
+
+      writer.BeginObject("args");
+      writer.AddVariableDouble("value", sample.m_fValue);
+      writer.EndObject();
+
+      writer.EndObject();
+
+      if (writer.HadWriteError())
+      {
+        return WD_FAILURE;
+      }
+    }
+
+    // flow events, they are bound to the scope that encloses them on the same thread
+    {
+      const char* szFlowPhases[] = {"s", "t", "f"};
+      wdStringBuilder sFlowId;
+
+      for (const FlowEvent& flow : m_FlowEvents)
+      {
+        // ids are strings, so that 64 bit values don't lose precision
+        sFlowId.Format("0x{}", wdArgU(flow.m_uiFlowId, 1, false, 16));
+
+        writer.BeginObject();
+        writer.AddVariableString("name", flow.m_sName);
+        writer.AddVariableString("cat", "flow");
+        writer.AddVariableString("id", sFlowId);
+        writer.AddVariableUInt32("pid", m_uiProcessID);
+        writer.AddVariableUInt64("tid", flow.m_uiThreadId + uiGpuCount + 1);
+        writer.AddVariableUInt64("ts", static_cast<wdUInt64>(flow.m_Time.GetMicroseconds()));
+        writer.AddVariableString("ph", szFlowPhases[flow.m_Type]);
+
+        if (flow.m_Type == FlowEventType::End)
+        {
+          writer.AddVariableString("bp", "e");
+        }
+
+        writer.EndObject();
+
+        if (writer.HadWriteError())
+        {
+          return WD_FAILURE;
+        }
+      }
+    }
+
     writer.EndArray();
   }
 
@@ -671,7 +738,13 @@ void wdProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(wdTime::Now());
+  const wdTime now = wdTime::Now();
+  s_FrameStartTimes.PushBack(now);
+
+  if (IsTraceStreamActive())
+  {
+    wdProfilingTraceStream::AddFrame(s_uiFrameCount, now);
+  }
 }
 
 // static
@@ -732,6 +805,11 @@ void wdProfilingSystem::AddCPUScope(wdStringView sName, const char* szFunctionNa
     pOtherThreadBuffer->m_Data.PushBack(scope);
   }
 
+  if (IsTraceStreamActive())
+  {
+    wdProfilingTraceStream::AddCPUScope(sName, szFunctionName, beginTime, endTime);
+  }
+
   if (scopeTimeout.IsPositive() && duration > scopeTimeout && s_ScopeTimeoutCallback.IsValid())
   {
     s_ScopeTimeoutCallback(sName, szFunctionName, duration);
@@ -791,14 +869,20 @@ void wdProfilingSystem::SetThreadName(wdStringView sThreadName)
   ThreadInfo& info = s_ThreadInfos.ExpandAndGetRef();
   info.m_uiThreadId = (wdUInt64)wdThreadUtils::GetCurrentThreadID();
   info.m_sName = sThreadName;
+
+  wdProfilingTraceStream::SetThreadName(sThreadName);
 }
 
 // static
 void wdProfilingSystem::RemoveThread()
 {
-  WD_LOCK(s_ThreadInfosMutex);
+  {
+    WD_LOCK(s_ThreadInfosMutex);
+
+    s_DeadThreadIDs.PushBack((wdUInt64)wdThreadUtils::GetCurrentThreadID());
+  }
 
-  s_DeadThreadIDs.PushBack((wdUInt64)wdThreadUtils::GetCurrentThreadID());
+  wdProfilingTraceStream::RemoveThread();
 }
 
 // static
@@ -835,6 +919,11 @@ void wdProfilingSystem::AddGPUScope(wdStringView sName, wdTime beginTime, wdTime
   wdStringUtils::Copy(scope.m_szName, WD_ARRAY_SIZE(scope.m_szName), sName.GetStartPointer(), sName.GetEndPointer());
 
   s_GPUScopes[uiGpuIndex]->PushBack(scope);
+
+  if (IsTraceStreamActive())
+  {
+    wdProfilingTraceStream::AddGPUScope(sName, beginTime, endTime, uiGpuIndex);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,1028 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Profiling/Implementation/ProfilingTraceStream.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+#if WD_ENABLED(WD_USE_PROFILING)
+
+#  include <atomic>
+
+// Layout of a trace stream:
+//
+// Header: magic (wdUInt32), version (wdUInt8), process ID (wdUInt32)
+// Followed by blocks, each starting with a TraceBlockType (wdUInt8):
+//  Strings:    count (wdUInt32), count x [ID (wdUInt32), string]
+//  ThreadInfo: thread ID (wdUInt64), name (string)
+//  Events:     thread ID (wdUInt64), number of discarded events (wdUInt32), size in bytes (wdUInt32), the events of one thread
+//  End:        written by StopTraceStream(), a stream without it was cut off, e.g. because the process crashed
+//
+// Events are packed without padding in native byte order, each starting with a TraceEventType (wdUInt8).
+// Strings are referenced by ID, 0 means no string. Time stamps are wdInt64 nanoseconds.
+//  Scope:    name, function name (wdUInt32 each), begin, end (wdInt64 each)
+//  GPUScope: name, GPU index (wdUInt32 each), begin, end (wdInt64 each)
+//  Frame:    frame count (wdUInt64), start time (wdInt64)
+//  Counter:  name (wdUInt32), time (wdInt64), value (double)
+//  Flow:     name (wdUInt32), flow event type (wdUInt8), flow ID (wdUInt64), time (wdInt64)
+
+namespace
+{
+  constexpr wdUInt32 s_uiTraceMagic = 0x53544457; // 'WDTS'
+  constexpr wdUInt8 s_uiTraceVersion = 1;
+
+  enum class TraceBlockType : wdUInt8
+  {
+    Strings = 1,
+    ThreadInfo,
+    Events,
+    End,
+  };
+
+  enum class TraceEventType : wdUInt8
+  {
+    Scope = 1,
+    GPUScope,
+    Frame,
+    Counter,
+    Flow,
+  };
+
+  constexpr wdUInt32 s_uiMaxEventSize = 32;
+  constexpr wdUInt32 s_uiTraceChunkSize = 64 * 1024 - 16;
+
+  // upper bound for GPU indices read from a trace, protects against allocating huge arrays for corrupt streams
+  constexpr wdUInt32 s_uiMaxTraceGpuCount = 64;
+
+  struct TraceChunk
+  {
+    wdUInt32 m_uiSize = 0;
+    wdUInt8 m_Data[s_uiTraceChunkSize];
+  };
+
+  struct TraceThreadBuffer
+  {
+    wdMutex m_Mutex;
+    wdUInt64 m_uiThreadId = 0;
+    wdString m_sName;
+
+    // the stream generation for which m_StringIds is valid and for which the thread name has been written
+    wdUInt32 m_uiGeneration = 0;
+    wdUInt32 m_uiNameGeneration = 0;
+
+    // the string IDs this thread already knows, so it only needs to take the global lock for new strings
+    wdHashTable<wdUInt64, wdUInt32> m_StringIds;
+
+    TraceChunk* m_pChunk = nullptr;
+    wdDynamicArray<TraceChunk*> m_FullChunks;
+    wdUInt32 m_uiDiscardedEvents = 0;
+
+    bool m_bThreadIsDead = false;
+  };
+
+  struct PendingString
+  {
+    wdUInt32 m_uiId;
+    wdString m_sString;
+  };
+
+  class TraceStreamThread : public wdThread
+  {
+  public:
+    TraceStreamThread(wdTime flushInterval)
+      : wdThread("Profiling Trace Stream")
+      , m_FlushInterval(flushInterval)
+    {
+    }
+
+    wdThreadSignal m_Signal;
+    std::atomic<bool> m_bStop = false;
+
+  private:
+    virtual wdUInt32 Run() override;
+
+    wdTime m_FlushInterval;
+  };
+
+  std::atomic<bool> s_bTraceStreamActive = false;
+  std::atomic<wdUInt32> s_uiTraceGeneration = 0;
+
+  // protects starting and stopping
+  wdMutex s_TraceStreamMutex;
+  wdStreamWriter* s_pTraceStream = nullptr;
+  TraceStreamThread* s_pTraceStreamThread = nullptr;
+
+  thread_local TraceThreadBuffer* s_pTraceThreadBuffer = nullptr;
+  wdDynamicArray<TraceThreadBuffer*> s_TraceThreadBuffers;
+  wdMutex s_TraceThreadBuffersMutex;
+
+  wdHashTable<wdUInt64, wdUInt32> s_TraceStringIds;
+  wdDynamicArray<PendingString> s_PendingTraceStrings;
+  wdUInt32 s_uiNextTraceStringId = 1;
+  wdMutex s_TraceStringsMutex;
+
+  wdDynamicArray<TraceChunk*> s_FreeTraceChunks;
+  wdUInt32 s_uiNumAllocatedTraceChunks = 0;
+  wdUInt32 s_uiMaxTraceChunks = 0;
+  wdMutex s_TraceChunksMutex;
+
+  WD_ALWAYS_INLINE wdInt64 ToTraceTime(wdTime time)
+  {
+    return static_cast<wdInt64>(time.GetNanoseconds());
+  }
+
+  WD_ALWAYS_INLINE wdTime FromTraceTime(wdInt64 iTime)
+  {
+    return wdTime::Nanoseconds(static_cast<double>(iTime));
+  }
+
+  /// Packs one event on the stack, before it is copied into the buffer of the thread.
+  struct TraceEvent
+  {
+    TraceEvent(TraceEventType type) { Add(static_cast<wdUInt8>(type)); }
+
+    template <typename T>
+    WD_ALWAYS_INLINE void Add(T value)
+    {
+      static_assert(sizeof(T) <= 8);
+      memcpy(m_Data + m_uiSize, &value, sizeof(T));
+      m_uiSize += sizeof(T);
+    }
+
+    wdUInt8 m_Data[s_uiMaxEventSize];
+    wdUInt32 m_uiSize = 0;
+  };
+
+  TraceThreadBuffer* GetTraceThreadBuffer()
+  {
+    TraceThreadBuffer* pBuffer = s_pTraceThreadBuffer;
+
+    if (pBuffer == nullptr)
+    {
+      pBuffer = WD_DEFAULT_NEW(TraceThreadBuffer);
+      pBuffer->m_uiThreadId = (wdUInt64)wdThreadUtils::GetCurrentThreadID();
+      s_pTraceThreadBuffer = pBuffer;
+
+      WD_LOCK(s_TraceThreadBuffersMutex);
+      s_TraceThreadBuffers.PushBack(pBuffer);
+    }
+
+    return pBuffer;
+  }
+
+  /// Has to be called while holding the lock of the buffer. Returns false if the trace stream has been stopped in the mean time.
+  bool BeginTraceEvent(TraceThreadBuffer& ref_buffer)
+  {
+    if (!s_bTraceStreamActive)
+      return false;
+
+    const wdUInt32 uiGeneration = s_uiTraceGeneration;
+    if (ref_buffer.m_uiGeneration != uiGeneration)
+    {
+      // a new stream has been started, the strings have to be written again
+      ref_buffer.m_StringIds.Clear();
+      ref_buffer.m_uiGeneration = uiGeneration;
+    }
+
+    return true;
+  }
+
+  wdUInt32 InternTraceString(TraceThreadBuffer& ref_buffer, wdStringView sString)
+  {
+    // Strings are identified by their 64 bit hash only, a collision would merge two names in the trace, which is acceptable.
+    const wdUInt64 uiHash = wdHashingUtils::StringHash(sString);
+
+    wdUInt32 uiId = 0;
+    if (ref_buffer.m_StringIds.TryGetValue(uiHash, uiId))
+      return uiId;
+
+    {
+      WD_LOCK(s_TraceStringsMutex);
+
+      if (!s_TraceStringIds.TryGetValue(uiHash, uiId))
+      {
+        uiId = s_uiNextTraceStringId++;
+        s_TraceStringIds.Insert(uiHash, uiId);
+
+        PendingString& pending = s_PendingTraceStrings.ExpandAndGetRef();
+        pending.m_uiId = uiId;
+        pending.m_sString = sString;
+      }
+    }
+
+    ref_buffer.m_StringIds.Insert(uiHash, uiId);
+    return uiId;
+  }
+
+  TraceChunk* AllocateTraceChunk()
+  {
+    WD_LOCK(s_TraceChunksMutex);
+
+    if (!s_FreeTraceChunks.IsEmpty())
+    {
+      TraceChunk* pChunk = s_FreeTraceChunks.PeekBack();
+      s_FreeTraceChunks.PopBack();
+      pChunk->m_uiSize = 0;
+      return pChunk;
+    }
+
+    if (s_uiNumAllocatedTraceChunks >= s_uiMaxTraceChunks)
+      return nullptr;
+
+    ++s_uiNumAllocatedTraceChunks;
+    return WD_DEFAULT_NEW(TraceChunk);
+  }
+
+  /// Has to be called while holding the lock of the buffer.
+  void AppendTraceEvent(TraceThreadBuffer& ref_buffer, const TraceEvent& event)
+  {
+    if (ref_buffer.m_pChunk != nullptr && ref_buffer.m_pChunk->m_uiSize + event.m_uiSize > s_uiTraceChunkSize)
+    {
+      ref_buffer.m_FullChunks.PushBack(ref_buffer.m_pChunk);
+      ref_buffer.m_pChunk = nullptr;
+
+      // the stream thread can't be destroyed while we hold the lock of an active buffer, see StopTraceStream()
+      s_pTraceStreamThread->m_Signal.RaiseSignal();
+    }
+
+    if (ref_buffer.m_pChunk == nullptr)
+    {
+      ref_buffer.m_pChunk = AllocateTraceChunk();
+
+      if (ref_buffer.m_pChunk == nullptr)
+      {
+        // the stream thread doesn't keep up, rather lose events than stall this thread
+        ++ref_buffer.m_uiDiscardedEvents;
+        return;
+      }
+    }
+
+    memcpy(ref_buffer.m_pChunk->m_Data + ref_buffer.m_pChunk->m_uiSize, event.m_Data, event.m_uiSize);
+    ref_buffer.m_pChunk->m_uiSize += event.m_uiSize;
+  }
+
+  template <typename T>
+  void WriteTraceValue(wdStreamWriter& inout_stream, T value)
+  {
+    inout_stream.WriteBytes(&value, sizeof(T)).IgnoreResult();
+  }
+
+  void WriteTraceBlockType(wdStreamWriter& inout_stream, TraceBlockType type)
+  {
+    WriteTraceValue(inout_stream, static_cast<wdUInt8>(type));
+  }
+
+  /// Writes all events that have been recorded so far. Only called by the stream thread.
+  void FlushTraceStream()
+  {
+    struct CollectedChunks
+    {
+      wdUInt64 m_uiThreadId;
+      wdUInt32 m_uiDiscardedEvents;
+      wdHybridArray<TraceChunk*, 4> m_Chunks;
+    };
+
+    struct CollectedThreadInfo
+    {
+      wdUInt64 m_uiThreadId;
+      wdString m_sName;
+    };
+
+    wdHybridArray<CollectedChunks, 16> collected;
+    wdHybridArray<CollectedThreadInfo, 4> threadInfos;
+    wdHybridArray<TraceThreadBuffer*, 4> deadBuffers;
+
+    // Take the chunks of all threads first and the strings afterwards,
+    // so that every string that is referenced by the collected events is written before them.
+    {
+      const wdUInt32 uiGeneration = s_uiTraceGeneration;
+
+      WD_LOCK(s_TraceThreadBuffersMutex);
+
+      for (wdUInt32 i = 0; i < s_TraceThreadBuffers.GetCount();)
+      {
+        TraceThreadBuffer* pBuffer = s_TraceThreadBuffers[i];
+
+        {
+          WD_LOCK(pBuffer->m_Mutex);
+
+          if (!pBuffer->m_sName.IsEmpty() && pBuffer->m_uiNameGeneration != uiGeneration)
+          {
+            pBuffer->m_uiNameGeneration = uiGeneration;
+
+            CollectedThreadInfo& info = threadInfos.ExpandAndGetRef();
+            info.m_uiThreadId = pBuffer->m_uiThreadId;
+            info.m_sName = pBuffer->m_sName;
+          }
+
+          const bool bHasPartialChunk = pBuffer->m_pChunk != nullptr && pBuffer->m_pChunk->m_uiSize > 0;
+
+          if (bHasPartialChunk || !pBuffer->m_FullChunks.IsEmpty() || pBuffer->m_uiDiscardedEvents > 0)
+          {
+            CollectedChunks& chunks = collected.ExpandAndGetRef();
+            chunks.m_uiThreadId = pBuffer->m_uiThreadId;
+            chunks.m_uiDiscardedEvents = pBuffer->m_uiDiscardedEvents;
+            chunks.m_Chunks.PushBackRange(pBuffer->m_FullChunks);
+
+            if (bHasPartialChunk)
+            {
+              chunks.m_Chunks.PushBack(pBuffer->m_pChunk);
+              pBuffer->m_pChunk = nullptr;
+            }
+
+            pBuffer->m_FullChunks.Clear();
+            pBuffer->m_uiDiscardedEvents = 0;
+          }
+        }
+
+        if (pBuffer->m_bThreadIsDead)
+        {
+          deadBuffers.PushBack(pBuffer);
+          s_TraceThreadBuffers.RemoveAtAndSwap(i);
+        }
+        else
+        {
+          ++i;
+        }
+      }
+    }
+
+    for (TraceThreadBuffer* pBuffer : deadBuffers)
+    {
+      WD_DEFAULT_DELETE(pBuffer);
+    }
+
+    wdDynamicArray<PendingString> strings;
+    {
+      WD_LOCK(s_TraceStringsMutex);
+      strings.Swap(s_PendingTraceStrings);
+    }
+
+    wdStreamWriter& stream = *s_pTraceStream;
+
+    if (!strings.IsEmpty())
+    {
+      WriteTraceBlockType(stream, TraceBlockType::Strings);
+      WriteTraceValue(stream, strings.GetCount());
+
+      for (const PendingString& string : strings)
+      {
+        WriteTraceValue(stream, string.m_uiId);
+        stream.WriteString(string.m_sString).IgnoreResult();
+      }
+    }
+
+    for (const CollectedThreadInfo& info : threadInfos)
+    {
+      WriteTraceBlockType(stream, TraceBlockType::ThreadInfo);
+      WriteTraceValue(stream, info.m_uiThreadId);
+      stream.WriteString(info.m_sName).IgnoreResult();
+    }
+
+    for (const CollectedChunks& chunks : collected)
+    {
+      wdUInt32 uiSize = 0;
+      for (const TraceChunk* pChunk : chunks.m_Chunks)
+      {
+        uiSize += pChunk->m_uiSize;
+      }
+
+      WriteTraceBlockType(stream, TraceBlockType::Events);
+      WriteTraceValue(stream, chunks.m_uiThreadId);
+      WriteTraceValue(stream, chunks.m_uiDiscardedEvents);
+      WriteTraceValue(stream, uiSize);
+
+      for (const TraceChunk* pChunk : chunks.m_Chunks)
+      {
+        stream.WriteBytes(pChunk->m_Data, pChunk->m_uiSize).IgnoreResult();
+      }
+    }
+
+    {
+      WD_LOCK(s_TraceChunksMutex);
+
+      for (const CollectedChunks& chunks : collected)
+      {
+        s_FreeTraceChunks.PushBackRange(chunks.m_Chunks);
+      }
+    }
+
+    stream.Flush().IgnoreResult();
+  }
+
+  wdUInt32 TraceStreamThread::Run()
+  {
+    while (!m_bStop)
+    {
+      m_Signal.WaitForSignal(m_FlushInterval);
+      FlushTraceStream();
+    }
+
+    // write everything that was recorded until the stream was stopped
+    FlushTraceStream();
+    return 0;
+  }
+} // namespace
+
+void wdProfilingTraceStream::AddCPUScope(wdStringView sName, const char* szFunctionName, wdTime beginTime, wdTime endTime)
+{
+  TraceThreadBuffer* pBuffer = GetTraceThreadBuffer();
+  WD_LOCK(pBuffer->m_Mutex);
+
+  if (!BeginTraceEvent(*pBuffer))
+    return;
+
+  TraceEvent event(TraceEventType::Scope);
+  event.Add(InternTraceString(*pBuffer, sName));
+  event.Add(szFunctionName != nullptr ? InternTraceString(*pBuffer, szFunctionName) : 0u);
+  event.Add(ToTraceTime(beginTime));
+  event.Add(ToTraceTime(endTime));
+
+  AppendTraceEvent(*pBuffer, event);
+}
+
+void wdProfilingTraceStream::AddGPUScope(wdStringView sName, wdTime beginTime, wdTime endTime, wdUInt32 uiGpuIndex)
+{
+  TraceThreadBuffer* pBuffer = GetTraceThreadBuffer();
+  WD_LOCK(pBuffer->m_Mutex);
+
+  if (!BeginTraceEvent(*pBuffer))
+    return;
+
+  TraceEvent event(TraceEventType::GPUScope);
+  event.Add(InternTraceString(*pBuffer, sName));
+  event.Add(uiGpuIndex);
+  event.Add(ToTraceTime(beginTime));
+  event.Add(ToTraceTime(endTime));
+
+  AppendTraceEvent(*pBuffer, event);
+}
+
+void wdProfilingTraceStream::AddFrame(wdUInt64 uiFrameCount, wdTime startTime)
+{
+  TraceThreadBuffer* pBuffer = GetTraceThreadBuffer();
+  WD_LOCK(pBuffer->m_Mutex);
+
+  if (!BeginTraceEvent(*pBuffer))
+    return;
+
+  TraceEvent event(TraceEventType::Frame);
+  event.Add(uiFrameCount);
+  event.Add(ToTraceTime(startTime));
+
+  AppendTraceEvent(*pBuffer, event);
+}
+
+void wdProfilingTraceStream::AddCounterValue(wdStringView sName, double fValue)
+{
+  const wdTime now = wdTime::Now();
+
+  TraceThreadBuffer* pBuffer = GetTraceThreadBuffer();
+  WD_LOCK(pBuffer->m_Mutex);
+
+  if (!BeginTraceEvent(*pBuffer))
+    return;
+
+  TraceEvent event(TraceEventType::Counter);
+  event.Add(InternTraceString(*pBuffer, sName));
+  event.Add(ToTraceTime(now));
+  event.Add(fValue);
+
+  AppendTraceEvent(*pBuffer, event);
+}
+
+void wdProfilingTraceStream::AddFlowEvent(wdStringView sName, wdUInt64 uiFlowId, wdProfilingSystem::FlowEventType::Enum type)
+{
+  const wdTime now = wdTime::Now();
+
+  TraceThreadBuffer* pBuffer = GetTraceThreadBuffer();
+  WD_LOCK(pBuffer->m_Mutex);
+
+  if (!BeginTraceEvent(*pBuffer))
+    return;
+
+  TraceEvent event(TraceEventType::Flow);
+  event.Add(InternTraceString(*pBuffer, sName));
+  event.Add(static_cast<wdUInt8>(type));
+  event.Add(uiFlowId);
+  event.Add(ToTraceTime(now));
+
+  AppendTraceEvent(*pBuffer, event);
+}
+
+void wdProfilingTraceStream::SetThreadName(wdStringView sThreadName)
+{
+  TraceThreadBuffer* pBuffer = GetTraceThreadBuffer();
+  WD_LOCK(pBuffer->m_Mutex);
+
+  pBuffer->m_sName = sThreadName;
+  pBuffer->m_uiNameGeneration = 0;
+}
+
+void wdProfilingTraceStream::RemoveThread()
+{
+  TraceThreadBuffer* pBuffer = s_pTraceThreadBuffer;
+  if (pBuffer == nullptr)
+    return;
+
+  s_pTraceThreadBuffer = nullptr;
+
+  WD_LOCK(s_TraceThreadBuffersMutex);
+
+  {
+    WD_LOCK(pBuffer->m_Mutex);
+
+    // Events are only recorded while a stream is active and stopping the stream writes all of them.
+    // So if there are events left, the stream thread will still pick them up and delete the buffer afterwards.
+    if (pBuffer->m_pChunk != nullptr || !pBuffer->m_FullChunks.IsEmpty() || pBuffer->m_uiDiscardedEvents > 0)
+    {
+      pBuffer->m_bThreadIsDead = true;
+      return;
+    }
+  }
+
+  s_TraceThreadBuffers.RemoveAndSwap(pBuffer);
+  WD_DEFAULT_DELETE(pBuffer);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+// static
+wdResult wdProfilingSystem::StartTraceStream(wdStreamWriter* pStream, wdUInt32 uiMaxBufferedBytes, wdTime flushInterval)
+{
+  WD_LOCK(s_TraceStreamMutex);
+
+  if (s_pTraceStreamThread != nullptr)
+  {
+    wdLog::Error("A profiling trace stream is already active.");
+    return WD_FAILURE;
+  }
+
+  WriteTraceValue(*pStream, s_uiTraceMagic);
+  WriteTraceValue(*pStream, s_uiTraceVersion);
+#  if WD_ENABLED(WD_SUPPORTS_PROCESSES)
+  WriteTraceValue(*pStream, static_cast<wdUInt32>(wdProcess::GetCurrentProcessID()));
+#  else
+  WriteTraceValue(*pStream, static_cast<wdUInt32>(0));
+#  endif
+
+  s_pTraceStream = pStream;
+  s_uiMaxTraceChunks = wdMath::Max<wdUInt32>(uiMaxBufferedBytes / sizeof(TraceChunk), 2);
+
+  {
+    WD_LOCK(s_TraceStringsMutex);
+    s_TraceStringIds.Clear();
+    s_PendingTraceStrings.Clear();
+    s_uiNextTraceStringId = 1;
+  }
+
+  // invalidates the strings that all threads know and makes them write their names again
+  ++s_uiTraceGeneration;
+
+  s_pTraceStreamThread = WD_DEFAULT_NEW(TraceStreamThread, flushInterval);
+  s_pTraceStreamThread->Start();
+
+  s_bTraceStreamActive = true;
+  return WD_SUCCESS;
+}
+
+// static
+void wdProfilingSystem::StopTraceStream()
+{
+  WD_LOCK(s_TraceStreamMutex);
+
+  if (s_pTraceStreamThread == nullptr)
+    return;
+
+  s_bTraceStreamActive = false;
+
+  // wait for all threads that are currently recording an event, afterwards nobody will add new events
+  {
+    WD_LOCK(s_TraceThreadBuffersMutex);
+
+    for (TraceThreadBuffer* pBuffer : s_TraceThreadBuffers)
+    {
+      WD_LOCK(pBuffer->m_Mutex);
+    }
+  }
+
+  s_pTraceStreamThread->m_bStop = true;
+  s_pTraceStreamThread->m_Signal.RaiseSignal();
+  s_pTraceStreamThread->Join();
+  WD_DEFAULT_DELETE(s_pTraceStreamThread);
+
+  WriteTraceBlockType(*s_pTraceStream, TraceBlockType::End);
+  s_pTraceStream->Flush().IgnoreResult();
+  s_pTraceStream = nullptr;
+
+  {
+    WD_LOCK(s_TraceChunksMutex);
+
+    for (TraceChunk* pChunk : s_FreeTraceChunks)
+    {
+      WD_DEFAULT_DELETE(pChunk);
+    }
+
+    s_FreeTraceChunks.Clear();
+    s_FreeTraceChunks.Compact();
+    s_uiNumAllocatedTraceChunks = 0;
+  }
+}
+
+// static
+bool wdProfilingSystem::IsTraceStreamActive()
+{
+  return s_bTraceStreamActive.load(std::memory_order_relaxed);
+}
+
+// static
+void wdProfilingSystem::AddCounterValue(wdStringView sName, double fValue)
+{
+  if (IsTraceStreamActive())
+  {
+    wdProfilingTraceStream::AddCounterValue(sName, fValue);
+  }
+}
+
+// static
+void wdProfilingSystem::AddFlowEvent(wdStringView sName, wdUInt64 uiFlowId, FlowEventType::Enum type)
+{
+  if (IsTraceStreamActive())
+  {
+    wdProfilingTraceStream::AddFlowEvent(sName, uiFlowId, type);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  /// Reads the packed events of one Events block.
+  class TraceEventReader
+  {
+  public:
+    TraceEventReader(const wdDynamicArray<wdUInt8>& data)
+      : m_pCur(data.GetData())
+      , m_pEnd(data.GetData() + data.GetCount())
+    {
+    }
+
+    bool HasMore() const { return m_pCur < m_pEnd; }
+
+    template <typename T>
+    bool Read(T& out_value)
+    {
+      if (m_pCur + sizeof(T) > m_pEnd)
+        return false;
+
+      memcpy(&out_value, m_pCur, sizeof(T));
+      m_pCur += sizeof(T);
+      return true;
+    }
+
+  private:
+    const wdUInt8* m_pCur;
+    const wdUInt8* m_pEnd;
+  };
+
+  template <typename T>
+  bool ReadTraceValue(wdStreamReader& inout_stream, T& out_value)
+  {
+    return inout_stream.ReadBytes(&out_value, sizeof(T)) == sizeof(T);
+  }
+
+  /// \brief Makes the last event of every flow without an explicit end terminate it and removes flows that consist of a single event.
+  ///
+  /// The task system only begins and continues flows, and a trace may be cut off in the middle of a flow.
+  /// Without an end event, viewers draw the arrows of these flows into nowhere.
+  void TerminateTraceFlows(wdDynamicArray<wdProfilingSystem::FlowEvent>& ref_flowEvents)
+  {
+    using FlowEventType = wdProfilingSystem::FlowEventType;
+
+    struct FlowInfo
+    {
+      wdUInt32 m_uiLastEvent = 0;
+      wdUInt32 m_uiNumEvents = 0;
+      bool m_bHasEnd = false;
+    };
+
+    wdHashTable<wdUInt64, FlowInfo> flows;
+
+    for (wdUInt32 i = 0; i < ref_flowEvents.GetCount(); ++i)
+    {
+      const wdProfilingSystem::FlowEvent& flow = ref_flowEvents[i];
+
+      // the events of a flow are spread over the blocks of several threads, so they are not sorted by time
+      FlowInfo& info = flows[flow.m_uiFlowId];
+      if (info.m_uiNumEvents == 0 || flow.m_Time >= ref_flowEvents[info.m_uiLastEvent].m_Time)
+      {
+        info.m_uiLastEvent = i;
+      }
+
+      ++info.m_uiNumEvents;
+      info.m_bHasEnd |= flow.m_Type == FlowEventType::End;
+    }
+
+    for (auto it = flows.GetIterator(); it.IsValid(); ++it)
+    {
+      if (!it.Value().m_bHasEnd)
+      {
+        ref_flowEvents[it.Value().m_uiLastEvent].m_Type = FlowEventType::End;
+      }
+    }
+
+    wdUInt32 uiNumKept = 0;
+    for (wdUInt32 i = 0; i < ref_flowEvents.GetCount(); ++i)
+    {
+      if (flows[ref_flowEvents[i].m_uiFlowId].m_uiNumEvents > 1)
+      {
+        if (uiNumKept != i)
+        {
+          ref_flowEvents[uiNumKept] = std::move(ref_flowEvents[i]);
+        }
+
+        ++uiNumKept;
+      }
+    }
+
+    ref_flowEvents.SetCount(uiNumKept);
+  }
+} // namespace
+
+wdResult wdProfilingSystem::ProfilingData::ReadTraceStream(wdStreamReader& inout_stream)
+{
+  Clear();
+
+  wdUInt32 uiMagic = 0;
+  wdUInt8 uiVersion = 0;
+  wdUInt32 uiProcessID = 0;
+  if (!ReadTraceValue(inout_stream, uiMagic) || uiMagic != s_uiTraceMagic || !ReadTraceValue(inout_stream, uiVersion) || !ReadTraceValue(inout_stream, uiProcessID))
+  {
+    wdLog::Error("The stream doesn't contain a profiling trace.");
+    return WD_FAILURE;
+  }
+
+  if (uiVersion != s_uiTraceVersion)
+  {
+    wdLog::Error("Unsupported profiling trace version {0}.", uiVersion);
+    return WD_FAILURE;
+  }
+
+  m_uiProcessID = static_cast<wdOsProcessID>(uiProcessID);
+
+  // string IDs are assigned in order, index 0 is the 'no string' ID
+  m_TraceStrings.SetCount(1);
+
+  wdHashTable<wdUInt64, wdUInt32> threadIdToEventBuffer;
+  wdDynamicArray<wdUInt8> events;
+  wdStringBuilder sTmp;
+  wdUInt64 uiDiscardedEvents = 0;
+  bool bComplete = false;
+
+  auto GetString = [&](wdUInt32 uiId) -> const wdHashedString& { return m_TraceStrings[uiId < m_TraceStrings.GetCount() ? uiId : 0]; };
+
+  wdUInt8 uiBlockType = 0;
+  while (!bComplete && ReadTraceValue(inout_stream, uiBlockType))
+  {
+    switch (static_cast<TraceBlockType>(uiBlockType))
+    {
+      case TraceBlockType::Strings:
+      {
+        wdUInt32 uiCount = 0;
+        ReadTraceValue(inout_stream, uiCount);
+
+        for (wdUInt32 i = 0; i < uiCount; ++i)
+        {
+          wdUInt32 uiId = 0;
+          if (!ReadTraceValue(inout_stream, uiId) || inout_stream.ReadString(sTmp).Failed())
+            break;
+
+          // IDs are written in the order they are assigned, so a new ID always directly follows the known ones
+          if (uiId == 0 || uiId > m_TraceStrings.GetCount())
+          {
+            wdLog::Error("Invalid string ID {0} in profiling trace.", uiId);
+            return WD_FAILURE;
+          }
+
+          if (uiId == m_TraceStrings.GetCount())
+          {
+            m_TraceStrings.SetCount(uiId + 1);
+          }
+
+          m_TraceStrings[uiId].Assign(sTmp);
+        }
+      }
+      break;
+
+      case TraceBlockType::ThreadInfo:
+      {
+        wdUInt64 uiThreadId = 0;
+        if (!ReadTraceValue(inout_stream, uiThreadId) || inout_stream.ReadString(sTmp).Failed())
+          break;
+
+        ThreadInfo* pInfo = nullptr;
+        for (ThreadInfo& info : m_ThreadInfos)
+        {
+          if (info.m_uiThreadId == uiThreadId)
+            pInfo = &info;
+        }
+
+        if (pInfo == nullptr)
+        {
+          pInfo = &m_ThreadInfos.ExpandAndGetRef();
+          pInfo->m_uiThreadId = uiThreadId;
+        }
+
+        pInfo->m_sName = sTmp;
+      }
+      break;
+
+      case TraceBlockType::Events:
+      {
+        wdUInt64 uiThreadId = 0;
+        wdUInt32 uiDiscarded = 0;
+        wdUInt32 uiSize = 0;
+        if (!ReadTraceValue(inout_stream, uiThreadId) || !ReadTraceValue(inout_stream, uiDiscarded) || !ReadTraceValue(inout_stream, uiSize))
+          break;
+
+        uiDiscardedEvents += uiDiscarded;
+
+        events.SetCountUninitialized(uiSize);
+        if (inout_stream.ReadBytes(events.GetData(), uiSize) != uiSize)
+        {
+          // the stream was cut off in the middle of a block, use what we got so far
+          break;
+        }
+
+        wdUInt32 uiEventBuffer = 0;
+        if (!threadIdToEventBuffer.TryGetValue(uiThreadId, uiEventBuffer))
+        {
+          uiEventBuffer = m_AllEventBuffers.GetCount();
+          m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+          threadIdToEventBuffer.Insert(uiThreadId, uiEventBuffer);
+        }
+
+        TraceEventReader reader(events);
+        while (reader.HasMore())
+        {
+          wdUInt8 uiEventType = 0;
+          reader.Read(uiEventType);
+
+          switch (static_cast<TraceEventType>(uiEventType))
+          {
+            case TraceEventType::Scope:
+            {
+              wdUInt32 uiName = 0, uiFunction = 0;
+              wdInt64 iBegin = 0, iEnd = 0;
+              if (!reader.Read(uiName) || !reader.Read(uiFunction) || !reader.Read(iBegin) || !reader.Read(iEnd))
+                return WD_FAILURE;
+
+              CPUScope& scope = m_AllEventBuffers[uiEventBuffer].m_Data.ExpandAndGetRef();
+              scope.m_szFunctionName = uiFunction != 0 ? GetString(uiFunction).GetData() : nullptr;
+              scope.m_BeginTime = FromTraceTime(iBegin);
+              scope.m_EndTime = FromTraceTime(iEnd);
+              wdStringUtils::Copy(scope.m_szName, CPUScope::NAME_SIZE, GetString(uiName).GetData());
+            }
+            break;
+
+            case TraceEventType::GPUScope:
+            {
+              wdUInt32 uiName = 0, uiGpuIndex = 0;
+              wdInt64 iBegin = 0, iEnd = 0;
+              if (!reader.Read(uiName) || !reader.Read(uiGpuIndex) || !reader.Read(iBegin) || !reader.Read(iEnd))
+                return WD_FAILURE;
+
+              if (uiGpuIndex >= s_uiMaxTraceGpuCount)
+              {
+                wdLog::Error("Invalid GPU index {0} in profiling trace.", uiGpuIndex);
+                return WD_FAILURE;
+              }
+
+              if (uiGpuIndex >= m_GPUScopes.GetCount())
+              {
+                m_GPUScopes.SetCount(uiGpuIndex + 1);
+              }
+
+              GPUScope& scope = m_GPUScopes[uiGpuIndex].ExpandAndGetRef();
+              scope.m_BeginTime = FromTraceTime(iBegin);
+              scope.m_EndTime = FromTraceTime(iEnd);
+              wdStringUtils::Copy(scope.m_szName, GPUScope::NAME_SIZE, GetString(uiName).GetData());
+            }
+            break;
+
+            case TraceEventType::Frame:
+            {
+              wdUInt64 uiFrameCount = 0;
+              wdInt64 iTime = 0;
+              if (!reader.Read(uiFrameCount) || !reader.Read(iTime))
+                return WD_FAILURE;
+
+              m_uiFrameCount = wdMath::Max(m_uiFrameCount, uiFrameCount);
+              m_FrameStartTimes.PushBack(FromTraceTime(iTime));
+            }
+            break;
+
+            case TraceEventType::Counter:
+            {
+              wdUInt32 uiName = 0;
+              wdInt64 iTime = 0;
+              double fValue = 0.0;
+              if (!reader.Read(uiName) || !reader.Read(iTime) || !reader.Read(fValue))
+                return WD_FAILURE;
+
+              CounterSample& sample = m_CounterSamples.ExpandAndGetRef();
+              sample.m_sName = GetString(uiName).GetView();
+              sample.m_Time = FromTraceTime(iTime);
+              sample.m_fValue = fValue;
+            }
+            break;
+
+            case TraceEventType::Flow:
+            {
+              wdUInt32 uiName = 0;
+              wdUInt8 uiType = 0;
+              wdUInt64 uiFlowId = 0;
+              wdInt64 iTime = 0;
+              if (!reader.Read(uiName) || !reader.Read(uiType) || !reader.Read(uiFlowId) || !reader.Read(iTime))
+                return WD_FAILURE;
+
+              if (uiType > FlowEventType::End)
+              {
+                wdLog::Error("Invalid flow event type {0} in profiling trace.", uiType);
+                return WD_FAILURE;
+              }
+
+              FlowEvent& flow = m_FlowEvents.ExpandAndGetRef();
+              flow.m_sName = GetString(uiName).GetView();
+              flow.m_uiThreadId = uiThreadId;
+              flow.m_uiFlowId = uiFlowId;
+              flow.m_Time = FromTraceTime(iTime);
+              flow.m_Type = static_cast<FlowEventType::Enum>(uiType);
+            }
+            break;
+
+            default:
+              wdLog::Error("Invalid event type {0} in profiling trace.", uiEventType);
+              return WD_FAILURE;
+          }
+        }
+      }
+      break;
+
+      case TraceBlockType::End:
+        bComplete = true;
+        break;
+
+      default:
+        wdLog::Error("Invalid block type {0} in profiling trace.", uiBlockType);
+        return WD_FAILURE;
+    }
+  }
+
+  if (!bComplete)
+  {
+    wdLog::Warning("The profiling trace is incomplete, it may have been cut off.");
+  }
+
+  TerminateTraceFlows(m_FlowEvents);
+
+  if (uiDiscardedEvents > 0)
+  {
+    wdLog::Warning("{0} events were discarded while recording the profiling trace.", uiDiscardedEvents);
+  }
+
+  return WD_SUCCESS;
+}
+
+#else
+
+wdResult wdProfilingSystem::StartTraceStream(wdStreamWriter* pStream, wdUInt32 uiMaxBufferedBytes, wdTime flushInterval)
+{
+  return WD_FAILURE;
+}
+
+void wdProfilingSystem::StopTraceStream() {}
+
+bool wdProfilingSystem::IsTraceStreamActive()
+{
+  return false;
+}
+
+void wdProfilingSystem::AddCounterValue(wdStringView sName, double fValue) {}
+
+void wdProfilingSystem::AddFlowEvent(wdStringView sName, wdUInt64 uiFlowId, FlowEventType::Enum type) {}
+
+wdResult wdProfilingSystem::ProfilingData::ReadTraceStream(wdStreamReader& inout_stream)
+{
+  return WD_FAILURE;
+}
+
+#endif
+
+WD_STATICLINK_FILE(Foundation, Foundation_Profiling_Implementation_ProfilingTraceStream);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Foundation/Profiling/Profiling.h>
+
+#if WD_ENABLED(WD_USE_PROFILING)
+
+/// \brief Records the events of the profiling system into per-thread buffers while a trace stream is active.
+///
+/// This is the internal counterpart of wdProfilingSystem::StartTraceStream(). All functions except SetThreadName() and RemoveThread()
+/// may only be called when wdProfilingSystem::IsTraceStreamActive() returned true, they are still safe to call when the stream
+/// has been stopped in the mean time.
+class wdProfilingTraceStream
+{
+public:
+  static void AddCPUScope(wdStringView sName, const char* szFunctionName, wdTime beginTime, wdTime endTime);
+  static void AddGPUScope(wdStringView sName, wdTime beginTime, wdTime endTime, wdUInt32 uiGpuIndex);
+  static void AddFrame(wdUInt64 uiFrameCount, wdTime startTime);
+  static void AddCounterValue(wdStringView sName, double fValue);
+  static void AddFlowEvent(wdStringView sName, wdUInt64 uiFlowId, wdProfilingSystem::FlowEventType::Enum type);
+
+  /// \brief Stores the name of the calling thread, it is written to the trace when the thread records its first events.
+  static void SetThreadName(wdStringView sThreadName);
+
+  /// \brief Releases the buffer of the calling thread once all of its events have been written.
+  static void RemoveThread();
+};
+
+#endif
@@ -3,9 +3,11 @@
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/Strings/HashedString.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Time/Time.h>
 
+class wdStreamReader;
 class wdStreamWriter;
 class wdThread;
 
@@ -95,6 +97,39 @@ public:
     char m_szName[NAME_SIZE];
   };
 
+  /// \brief The kind of a flow event, see AddFlowEvent().
+  struct FlowEventType
+  {
+    using StorageType = wdUInt8;
+
+    enum Enum : wdUInt8
+    {
+      Begin, ///< Starts a flow, e.g. where work is scheduled.
+      Step,  ///< Continues a flow, e.g. where a part of the scheduled work is executed.
+      End,   ///< Terminates a flow.
+
+      Default = Begin
+    };
+  };
+
+  /// \brief One sample of a counter track, only recorded while a trace stream is active.
+  struct CounterSample
+  {
+    wdString m_sName;
+    wdTime m_Time;
+    double m_fValue = 0.0;
+  };
+
+  /// \brief A flow event that links scopes on different threads, only recorded while a trace stream is active.
+  struct FlowEvent
+  {
+    wdString m_sName;
+    wdUInt64 m_uiThreadId = 0;
+    wdUInt64 m_uiFlowId = 0;
+    wdTime m_Time;
+    FlowEventType::Enum m_Type = FlowEventType::Begin;
+  };
+
   struct WD_FOUNDATION_DLL ProfilingData
   {
     wdUInt32 m_uiFramesThreadID = 0;
@@ -110,6 +145,12 @@ public:
 
     wdDynamicArray<wdDynamicArray<GPUScope>> m_GPUScopes;
 
+    wdDynamicArray<CounterSample> m_CounterSamples;
+    wdDynamicArray<FlowEvent> m_FlowEvents;
+
+    /// \brief Keeps the strings of a trace stream alive, the function names of the scopes read by ReadTraceStream() point into them.
+    wdDynamicArray<wdHashedString> m_TraceStrings;
+
     /// \brief Writes profiling data as JSON to the output stream.
     wdResult Write(wdStreamWriter& ref_outputStream) const;
 
@@ -117,6 +158,11 @@ public:
 
     /// \brief Concatenates all given ProfilingData instances into one merge struct
     static void Merge(ProfilingData& out_merged, wdArrayPtr<const ProfilingData*> inputs);
+
+    /// \brief Reads a binary trace that was written by wdProfilingSystem::StartTraceStream().
+    ///
+    /// Together with Write() this converts a binary trace into the same JSON format as a regular capture.
+    wdResult ReadTraceStream(wdStreamReader& inout_stream);
   };
 
 public:
@@ -141,6 +187,38 @@ public:
   /// \brief Get current frame counter
   static wdUInt64 GetFrameCount();
 
+  /// \brief Starts streaming all profiling events to the given stream in a compact binary format.
+  ///
+  /// In contrast to Capture(), which only returns what is still in the ring buffers, a trace stream records continuously, which is
+  /// meant for long running sessions. Events are written into per-thread buffers and a background thread writes them to the stream,
+  /// so the stream may be anything, e.g. a file or a network connection, and doesn't need to be thread-safe.
+  /// Scope names are interned and only written once, time stamps are stored as 64 bit nanosecond values.
+  ///
+  /// uiMaxBufferedBytes limits how much memory is used for events that haven't been written yet. If the background thread can't keep up,
+  /// new events are discarded instead of stalling the recording threads. The number of discarded events is stored in the trace.
+  ///
+  /// Counter samples and flow events are only recorded while a trace stream is active.
+  /// The stream must stay valid until StopTraceStream() has been called.
+  /// Use ProfilingData::ReadTraceStream() to convert the trace.
+  static wdResult StartTraceStream(wdStreamWriter* pStream, wdUInt32 uiMaxBufferedBytes = 16 * 1024 * 1024, wdTime flushInterval = wdTime::Milliseconds(100));
+
+  /// \brief Writes all outstanding events to the trace stream and stops the background thread.
+  static void StopTraceStream();
+
+  /// \brief Returns whether a trace stream is currently recording.
+  static bool IsTraceStreamActive();
+
+  /// \brief Adds a sample to the counter track with the given name. Ignored if no trace stream is active.
+  ///
+  /// Can be used to track values like the number of allocations or the depth of a queue over time.
+  static void AddCounterValue(wdStringView sName, double fValue);
+
+  /// \brief Adds a flow event for the calling thread. Ignored if no trace stream is active.
+  ///
+  /// All flow events with the same uiFlowId are connected, which can be used to link work to the code that scheduled it.
+  /// Flow events are attached to the scope that encloses them on the same thread.
+  static void AddFlowEvent(wdStringView sName, wdUInt64 uiFlowId, FlowEventType::Enum type);
+
 private:
   WD_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend wdUInt32 RunThread(wdThread* pThread);
@@ -204,6 +282,16 @@ public:
 /// \sa WD_PROFILE_LIST_SCOPE
 #  define WD_PROFILE_LIST_NEXT_SECTION(szNextSectionName) wdProfilingListScope::StartNextSection(szNextSectionName)
 
+/// \brief Adds a sample to a counter track, if a trace stream is active.
+///
+/// \sa wdProfilingSystem::AddCounterValue
+#  define WD_PROFILE_COUNTER(szCounterName, value)                          \
+    do                                                                      \
+    {                                                                       \
+      if (wdProfilingSystem::IsTraceStreamActive())                         \
+        wdProfilingSystem::AddCounterValue(szCounterName, (double)(value)); \
+    } while (false)
+
 #else
 
 #  define WD_PROFILE_SCOPE(Name) /*empty*/
@@ -214,4 +302,6 @@ public:
 
 #  define WD_PROFILE_LIST_NEXT_SECTION(szNextSectionName) /*empty*/
 
+#  define WD_PROFILE_COUNTER(szCounterName, value) /*empty*/
+
 #endif
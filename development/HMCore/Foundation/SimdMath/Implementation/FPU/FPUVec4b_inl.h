@@ -142,6 +142,11 @@ WD_ALWAYS_INLINE bool wdSimdVec4b::NoneSet() const
   return !AnySet<N>();
 }
 
+WD_ALWAYS_INLINE wdUInt32 wdSimdVec4b::GetMask() const
+{
+  return (m_v.x ? 1u : 0u) | (m_v.y ? 2u : 0u) | (m_v.z ? 4u : 0u) | (m_v.w ? 8u : 0u);
+}
+
 // static
 WD_ALWAYS_INLINE wdSimdVec4b wdSimdVec4b::Select(const wdSimdVec4b& cmp, const wdSimdVec4b& ifTrue, const wdSimdVec4b& ifFalse)
 {
@@ -106,6 +106,11 @@ WD_ALWAYS_INLINE bool wdSimdVec4b::NoneSet() const
   return (_mm_movemask_ps(m_v) & mask) == 0;
 }
 
+WD_ALWAYS_INLINE wdUInt32 wdSimdVec4b::GetMask() const
+{
+  return static_cast<wdUInt32>(_mm_movemask_ps(m_v));
+}
+
 // static
 WD_ALWAYS_INLINE wdSimdVec4b wdSimdVec4b::Select(const wdSimdVec4b& vCmp, const wdSimdVec4b& vTrue, const wdSimdVec4b& vFalse)
 {
@@ -42,6 +42,9 @@ public:
   template <int N = 4>
   bool NoneSet() const; // [tested]
 
+  /// \brief Returns a bit mask with one bit per component, i.e. bit 0 is set if x is true, bit 1 if y is true and so on.
+  wdUInt32 GetMask() const; // [tested]
+
   static wdSimdVec4b Select(const wdSimdVec4b& vCmp, const wdSimdVec4b& vTrue, const wdSimdVec4b& vFalse); // [tested]
 
 public:
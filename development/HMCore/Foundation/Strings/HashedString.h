@@ -14,7 +14,8 @@ class wdTempHashedString;
 /// (it's a pointer comparison).\n
 /// Copying wdHashedString objects around and assigning between them is very fast as well.\n
 /// \n
-/// Assigning from some other string type is rather slow though, as it requires thread synchronization.\n
+/// Assigning from some other string type is rather slow though, as it requires a look up in the central storage. Strings that already
+/// exist there are found without taking a lock, adding new ones only locks the one shard of the storage that the hash maps to.\n
 /// You can also get access to the actual string data via GetString().\n
 /// \n
 /// You should use wdHashedString whenever the size of the encapsulating object is important and when changes to the string itself
@@ -29,12 +30,12 @@ public:
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
     wdAtomicInteger32 m_iRefCount;
 #endif
+    wdUInt64 m_uiHash = 0;
     wdString m_sString;
   };
 
-  // Do NOT use a hash-table! The map does not relocate memory when it resizes, which is a vital aspect for the hashed strings to work.
-  typedef wdMap<wdUInt64, HashedData, wdCompareHelper<wdUInt64>, wdStaticAllocatorWrapper> StringStorage;
-  typedef StringStorage::Iterator HashedType;
+  // The central storage never moves or frees an entry while it is in use, which is vital for the hashed strings to work.
+  using HashedType = HashedData*;
 
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
   /// \brief This will remove all hashed strings from the central storage, that are not referenced anymore.
@@ -49,6 +50,12 @@ public:
   static wdUInt32 ClearUnusedStrings();
 #endif
 
+  /// \brief Adds all given strings to the central storage in one go, e.g. the string table of an asset file.
+  ///
+  /// This is much cheaper than assigning every string individually, because each part of the central storage is locked and grown
+  /// at most once. If out_hashedStrings is not empty, it must have as many elements as strings and receives the hashed strings.
+  static void PreInternStrings(wdArrayPtr<const wdStringView> strings, wdArrayPtr<wdHashedString> out_hashedStrings = {});
+
   WD_DECLARE_MEM_RELOCATABLE_TYPE();
 
   /// \brief Initializes this string to the empty string.
@@ -1,16 +1,202 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Strings/HashedString.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
-struct HashedStringData
+#include <atomic>
+
+namespace
 {
-  wdMutex m_Mutex;
-  wdHashedString::StringStorage m_Storage;
-  wdHashedString::HashedType m_Empty;
-};
+  using HashedData = wdHashedString::HashedData;
+
+  // The storage is split into shards by the lowest bits of the hash, so that threads which add different strings rarely wait for each other.
+  constexpr wdUInt32 s_uiHashedStringShardBits = 4;
+  constexpr wdUInt32 s_uiNumHashedStringShards = 1 << s_uiHashedStringShardBits;
+  constexpr wdUInt32 s_uiInitialHashedStringSlots = 256;
+
+  // Open addressing table with linear probing, which only stores pointers to the entries. It is never filled more than half.
+  // Slots only ever go from empty to an entry (except in ClearUnusedStrings), so readers can search it without taking the lock.
+  struct SlotTable
+  {
+    wdUInt32 m_uiMask = 0;
+    std::atomic<HashedData*>* m_pSlots = nullptr;
+  };
+
+  // aligned to a cache line, so that threads working on neighboring shards do not interfere
+  struct alignas(64) HashedStringShard
+  {
+    wdMutex m_Mutex;
+    std::atomic<SlotTable*> m_pTable = {nullptr};
+    wdUInt32 m_uiNumEntries = 0;
+
+    // the deque allocates the entries in chunks and never moves them around
+    wdDeque<HashedData, wdStaticAllocatorWrapper> m_Entries;
+
+#if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
+    wdDynamicArray<HashedData*, wdStaticAllocatorWrapper> m_FreeEntries;
+#else
+    // Tables that were replaced by a larger one, lock-free readers might still be searching them.
+    // Since every table is twice as large as the one before, these never take up more memory than the current table.
+    wdDynamicArray<SlotTable*, wdStaticAllocatorWrapper> m_RetiredTables;
+#endif
+  };
+
+  // Like the entries, the shards are never destroyed, so that hashed strings stay valid during static deinitialization.
+  struct HashedStringData
+  {
+    HashedStringShard m_Shards[s_uiNumHashedStringShards];
+    wdHashedString::HashedType m_Empty = nullptr;
+  };
+
+  WD_ALWAYS_INLINE wdUInt32 GetShardIndex(wdUInt64 uiHash)
+  {
+    return static_cast<wdUInt32>(uiHash) & (s_uiNumHashedStringShards - 1);
+  }
+
+  WD_ALWAYS_INLINE wdUInt32 GetFirstSlot(wdUInt64 uiHash)
+  {
+    return static_cast<wdUInt32>(uiHash >> s_uiHashedStringShardBits);
+  }
+
+  SlotTable* CreateSlotTable(wdUInt32 uiNumSlots)
+  {
+    wdAllocatorBase* pAllocator = wdStaticAllocatorWrapper::GetAllocator();
+
+    SlotTable* pTable = WD_NEW(pAllocator, SlotTable);
+    pTable->m_uiMask = uiNumSlots - 1;
+    pTable->m_pSlots = WD_NEW_RAW_BUFFER(pAllocator, std::atomic<HashedData*>, uiNumSlots);
+
+    for (wdUInt32 i = 0; i < uiNumSlots; ++i)
+    {
+      new (&pTable->m_pSlots[i]) std::atomic<HashedData*>(nullptr);
+    }
+
+    return pTable;
+  }
+
+#if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
+  void DestroySlotTable(SlotTable* pTable)
+  {
+    wdAllocatorBase* pAllocator = wdStaticAllocatorWrapper::GetAllocator();
+
+    WD_DELETE_RAW_BUFFER(pAllocator, pTable->m_pSlots);
+    WD_DELETE(pAllocator, pTable);
+  }
+#endif
+
+  WD_ALWAYS_INLINE HashedData* FindEntry(const SlotTable* pTable, wdUInt64 uiHash)
+  {
+    for (wdUInt32 uiSlot = GetFirstSlot(uiHash);; ++uiSlot)
+    {
+      HashedData* pEntry = pTable->m_pSlots[uiSlot & pTable->m_uiMask].load(std::memory_order_acquire);
+
+      if (pEntry == nullptr || pEntry->m_uiHash == uiHash)
+        return pEntry;
+    }
+  }
+
+  // The entry must be fully set up before, as readers may see it as soon as it is stored. Requires the shard lock.
+  void InsertEntry(SlotTable* pTable, HashedData* pEntry)
+  {
+    for (wdUInt32 uiSlot = GetFirstSlot(pEntry->m_uiHash);; ++uiSlot)
+    {
+      std::atomic<HashedData*>& slot = pTable->m_pSlots[uiSlot & pTable->m_uiMask];
+
+      if (slot.load(std::memory_order_relaxed) == nullptr)
+      {
+        slot.store(pEntry, std::memory_order_release);
+        return;
+      }
+    }
+  }
+
+  // Makes sure the table of the shard can hold uiNumEntries. Requires the shard lock.
+  void ReserveEntries(HashedStringShard& ref_shard, wdUInt32 uiNumEntries)
+  {
+    SlotTable* pOldTable = ref_shard.m_pTable.load(std::memory_order_relaxed);
+
+    const wdUInt32 uiOldNumSlots = pOldTable->m_uiMask + 1;
+    if (uiNumEntries * 2 <= uiOldNumSlots)
+      return;
+
+    wdUInt32 uiNumSlots = uiOldNumSlots;
+    while (uiNumEntries * 2 > uiNumSlots)
+    {
+      uiNumSlots *= 2;
+    }
+
+    SlotTable* pNewTable = CreateSlotTable(uiNumSlots);
+
+    for (wdUInt32 i = 0; i < uiOldNumSlots; ++i)
+    {
+      if (HashedData* pEntry = pOldTable->m_pSlots[i].load(std::memory_order_relaxed))
+      {
+        InsertEntry(pNewTable, pEntry);
+      }
+    }
+
+    ref_shard.m_pTable.store(pNewTable, std::memory_order_release);
+
+#if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
+    // with ref counting all look ups take the shard lock, so nobody can still be searching the old table
+    DestroySlotTable(pOldTable);
+#else
+    // readers that already hold the old table can still finish their search in it, it contains a subset of the new one
+    ref_shard.m_RetiredTables.PushBack(pOldTable);
+#endif
+  }
+
+  WD_ALWAYS_INLINE void CheckForHashCollision(const HashedData* pEntry, wdStringView sString)
+  {
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+    if (pEntry->m_sString != sString)
+    {
+      // TODO: I think this should be a more serious issue
+      wdLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", wdArgSensitive(pEntry->m_sString), wdArgSensitive(sString), pEntry->m_uiHash);
+    }
+#endif
+  }
+
+  // Returns the existing entry or adds a new one. Requires the shard lock.
+  HashedData* FindOrAddEntry(HashedStringShard& ref_shard, wdStringView sString, wdUInt64 uiHash)
+  {
+    if (HashedData* pEntry = FindEntry(ref_shard.m_pTable.load(std::memory_order_relaxed), uiHash))
+    {
+      CheckForHashCollision(pEntry, sString);
+      return pEntry;
+    }
+
+    ReserveEntries(ref_shard, ref_shard.m_uiNumEntries + 1);
+
+    HashedData* pEntry = nullptr;
+
+#if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
+    if (!ref_shard.m_FreeEntries.IsEmpty())
+    {
+      pEntry = ref_shard.m_FreeEntries.PeekBack();
+      ref_shard.m_FreeEntries.PopBack();
+    }
+    else
+#endif
+    {
+      pEntry = &ref_shard.m_Entries.ExpandAndGetRef();
+    }
+
+#if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
+    pEntry->m_iRefCount = 0;
+#endif
+    pEntry->m_uiHash = uiHash;
+    pEntry->m_sString = sString;
+
+    InsertEntry(ref_shard.m_pTable.load(std::memory_order_relaxed), pEntry);
+    ++ref_shard.m_uiNumEntries;
+
+    return pEntry;
+  }
+} // namespace
 
 static HashedStringData* s_pHSData;
 
@@ -23,37 +209,118 @@ wdHashedString::HashedType wdHashedString::AddHashedString(wdStringView sString,
   if (s_pHSData == nullptr)
     InitHashedString();
 
-  WD_LOCK(s_pHSData->m_Mutex);
-
-  // try to find the existing string
-  bool bExisted = false;
-  auto ret = s_pHSData->m_Storage.FindOrAdd(uiHash, &bExisted);
+  HashedStringShard& shard = s_pHSData->m_Shards[GetShardIndex(uiHash)];
 
-  // if it already exists, just increase the refcount
-  if (bExisted)
+#if WD_DISABLED(WD_HASHED_STRING_REF_COUNTING)
+  // most strings already exist, finding those doesn't need the lock
+  // with ref counting this is not possible, as ClearUnusedStrings() may remove entries at any time
+  if (HashedData* pEntry = FindEntry(shard.m_pTable.load(std::memory_order_acquire), uiHash))
   {
-#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-    if (ret.Value().m_sString != sString)
-    {
-      // TODO: I think this should be a more serious issue
-      wdLog::Error("Hash collision encountered: Strings \"{}\" and \"{}\" both hash to {}.", wdArgSensitive(ret.Value().m_sString), wdArgSensitive(sString), uiHash);
-    }
+    CheckForHashCollision(pEntry, sString);
+    return pEntry;
+  }
 #endif
 
+  WD_LOCK(shard.m_Mutex);
+
+  HashedData* pEntry = FindOrAddEntry(shard, sString, uiHash);
+
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
-    ret.Value().m_iRefCount.Increment();
+  pEntry->m_iRefCount.Increment();
 #endif
+
+  return pEntry;
+}
+
+// static
+void wdHashedString::PreInternStrings(wdArrayPtr<const wdStringView> strings, wdArrayPtr<wdHashedString> out_hashedStrings)
+{
+  WD_ASSERT_DEV(out_hashedStrings.IsEmpty() || out_hashedStrings.GetCount() == strings.GetCount(), "The output array must be empty or have as many elements as the input array.");
+
+  if (strings.IsEmpty())
+    return;
+
+  if (s_pHSData == nullptr)
+    InitHashedString();
+
+  struct PendingString
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt64 m_uiHash;
+    wdUInt32 m_uiIndex;
+  };
+
+  const wdUInt32 uiNumStrings = strings.GetCount();
+
+  wdDynamicArray<PendingString> hashes;
+  hashes.SetCountUninitialized(uiNumStrings);
+
+  wdUInt32 uiShardOffsets[s_uiNumHashedStringShards + 1] = {};
+
+  for (wdUInt32 i = 0; i < uiNumStrings; ++i)
+  {
+    hashes[i].m_uiHash = wdHashingUtils::StringHash(strings[i]);
+    hashes[i].m_uiIndex = i;
+
+    ++uiShardOffsets[GetShardIndex(hashes[i].m_uiHash) + 1];
   }
-  else
+
+  for (wdUInt32 uiShard = 0; uiShard < s_uiNumHashedStringShards; ++uiShard)
+  {
+    uiShardOffsets[uiShard + 1] += uiShardOffsets[uiShard];
+  }
+
+  // group the strings by shard, so that every shard is locked only once
+  wdDynamicArray<PendingString> sorted;
+  sorted.SetCountUninitialized(uiNumStrings);
+
   {
-    wdHashedString::HashedData& d = ret.Value();
+    wdUInt32 uiWriteOffsets[s_uiNumHashedStringShards];
+    wdMemoryUtils::Copy(uiWriteOffsets, uiShardOffsets, s_uiNumHashedStringShards);
+
+    for (const PendingString& pending : hashes)
+    {
+      sorted[uiWriteOffsets[GetShardIndex(pending.m_uiHash)]++] = pending;
+    }
+  }
+
+  for (wdUInt32 uiShard = 0; uiShard < s_uiNumHashedStringShards; ++uiShard)
+  {
+    const wdUInt32 uiFirst = uiShardOffsets[uiShard];
+    const wdUInt32 uiEnd = uiShardOffsets[uiShard + 1];
+
+    if (uiFirst == uiEnd)
+      continue;
+
+    HashedStringShard& shard = s_pHSData->m_Shards[uiShard];
+
+    WD_LOCK(shard.m_Mutex);
+
+    // grow the table at most once, duplicates only make this reserve a bit more than necessary
+    ReserveEntries(shard, shard.m_uiNumEntries + (uiEnd - uiFirst));
+
+    for (wdUInt32 i = uiFirst; i < uiEnd; ++i)
+    {
+      HashedData* pEntry = FindOrAddEntry(shard, strings[sorted[i].m_uiIndex], sorted[i].m_uiHash);
+
+      if (out_hashedStrings.IsEmpty())
+        continue;
+
+      wdHashedString& sTarget = out_hashedStrings[sorted[i].m_uiIndex];
+
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
-    d.m_iRefCount = 1;
+      pEntry->m_iRefCount.Increment();
+
+      if (sTarget.m_Data != nullptr)
+      {
+        sTarget.m_Data->m_iRefCount.Decrement();
+      }
 #endif
-    d.m_sString = sString;
-  }
 
-  return ret;
+      sTarget.m_Data = pEntry;
+    }
+  }
 }
 
 WD_MSVC_ANALYSIS_WARNING_POP
@@ -67,31 +334,61 @@ void wdHashedString::InitHashedString()
   alignas(WD_ALIGNMENT_OF(HashedStringData)) static wdUInt8 HashedStringDataBuffer[sizeof(HashedStringData)];
   s_pHSData = new (HashedStringDataBuffer) HashedStringData();
 
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
+  {
+    shard.m_pTable.store(CreateSlotTable(s_uiInitialHashedStringSlots), std::memory_order_release);
+  }
+
   // makes sure the empty string exists for the default constructor to use
   s_pHSData->m_Empty = AddHashedString("", wdHashingUtils::StringHash(""));
 
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
   // this one should never get deleted, so make sure its refcount is 2
-  s_pHSData->m_Empty.Value().m_iRefCount.Increment();
+  s_pHSData->m_Empty->m_iRefCount.Increment();
 #endif
 }
 
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
 wdUInt32 wdHashedString::ClearUnusedStrings()
 {
-  WD_LOCK(s_pHSData->m_Mutex);
-
   wdUInt32 uiDeleted = 0;
 
-  for (auto it = s_pHSData->m_Storage.GetIterator(); it.IsValid();)
+  wdDynamicArray<HashedData*> usedEntries;
+
+  for (HashedStringShard& shard : s_pHSData->m_Shards)
   {
-    if (it.Value().m_iRefCount == 0)
+    WD_LOCK(shard.m_Mutex);
+
+    SlotTable* pTable = shard.m_pTable.load(std::memory_order_relaxed);
+    usedEntries.Clear();
+
+    for (wdUInt32 i = 0; i <= pTable->m_uiMask; ++i)
     {
-      it = s_pHSData->m_Storage.Remove(it);
-      ++uiDeleted;
+      HashedData* pEntry = pTable->m_pSlots[i].load(std::memory_order_relaxed);
+      if (pEntry == nullptr)
+        continue;
+
+      if (pEntry->m_iRefCount == 0)
+      {
+        pEntry->m_sString.Clear();
+        shard.m_FreeEntries.PushBack(pEntry);
+        ++uiDeleted;
+      }
+      else
+      {
+        usedEntries.PushBack(pEntry);
+      }
+
+      pTable->m_pSlots[i].store(nullptr, std::memory_order_relaxed);
     }
-    else
-      ++it;
+
+    // with ref counting all look ups take the shard lock, so the table can simply be rebuilt in place
+    for (HashedData* pEntry : usedEntries)
+    {
+      InsertEntry(pTable, pEntry);
+    }
+
+    shard.m_uiNumEntries = usedEntries.GetCount();
   }
 
   return uiDeleted;
@@ -112,7 +409,7 @@ wdHashedString::wdHashedString()
 
   m_Data = s_pHSData->m_Empty;
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
-  m_Data.Value().m_iRefCount.Increment();
+  m_Data->m_iRefCount.Increment();
 #endif
 }
 
@@ -131,9 +428,9 @@ void wdHashedString::Clear()
     HashedType tmp = m_Data;
 
     m_Data = s_pHSData->m_Empty;
-    m_Data.Value().m_iRefCount.Increment();
+    m_Data->m_iRefCount.Increment();
 
-    tmp.Value().m_iRefCount.Decrement();
+    tmp->m_iRefCount.Decrement();
   }
 #else
   m_Data = s_pHSData->m_Empty;
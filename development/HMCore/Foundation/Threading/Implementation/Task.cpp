@@ -46,6 +46,11 @@ void wdTask::Run(wdUInt32 uiInvocation)
 
     WD_PROFILE_SCOPE(scopeName.GetData());
 
+    if (wdProfilingSystem::IsTraceStreamActive())
+    {
+      wdProfilingSystem::AddFlowEvent("TaskGroup", m_BelongsToGroup.GetProfilingFlowId(), wdProfilingSystem::FlowEventType::Step);
+    }
+
     if (m_bUsesMultiplicity)
     {
       ExecuteWithMultiplicity(uiInvocation);
@@ -127,6 +127,13 @@ public:
 private:
   friend class wdTaskSystem;
   friend class wdTaskGroup;
+  friend class wdTask;
+
+  /// \brief Identifies the group in profiling flow events, which link the code that started the group to the execution of its tasks.
+  WD_ALWAYS_INLINE wdUInt64 GetProfilingFlowId() const
+  {
+    return (static_cast<wdUInt64>(reinterpret_cast<std::uintptr_t>(m_pTaskGroup)) << 16) ^ m_uiGroupCounter;
+  }
 
   // the counter is used to determine whether this group id references the 'same' group, as m_pTaskGroup.
   // if m_pTaskGroup->m_uiGroupCounter is different to this->m_uiGroupCounter, then the group ID is not valid anymore.
@@ -80,6 +80,11 @@ void wdTaskSystem::StartTaskGroup(wdTaskGroupID groupID)
 
   wdTaskGroup::DebugCheckTaskGroup(groupID, s_TaskSystemMutex);
 
+  if (wdProfilingSystem::IsTraceStreamActive())
+  {
+    wdProfilingSystem::AddFlowEvent("TaskGroup", groupID.GetProfilingFlowId(), wdProfilingSystem::FlowEventType::Begin);
+  }
+
   wdInt32 iActiveDependencies = 0;
 
   {
@@ -161,12 +166,32 @@ void wdTaskSystem::ScheduleGroupTasks(wdTaskGroup* pGroup, bool bHighPriority)
     pGroup->m_iNumRemainingTasks = iRemainingTasks;
 
 
+    // short tasks for this frame that are scheduled from a worker thread go into that thread's local queue
+    // the thread will most likely work on them itself, but idle threads can steal them without taking the lock
+    wdTaskWorkerThread* pLocalThread = (pGroup->m_Priority <= wdTaskPriority::LateThisFrame) ? tl_TaskWorkerInfo.m_pWorkerThread : nullptr;
+
     for (wdUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
     {
       auto& pTask = pGroup->m_Tasks[task];
 
       for (wdUInt32 mult = 0; mult < wdMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
       {
+        if (pLocalThread != nullptr)
+        {
+          wdTaskLocalQueueEntry entry;
+          entry.m_pBelongsToGroup = pGroup;
+          entry.m_uiTaskIndex = task;
+          entry.m_uiInvocation = mult;
+          entry.m_bNeverWaits = pTask->m_NestingMode == wdTaskNesting::Never;
+
+          pTask->m_bTaskIsScheduled = true;
+
+          if (pLocalThread->GetLocalQueue(pGroup->m_Priority).Push(entry))
+            continue;
+
+          // the local queue is full, fall back to the shared list
+        }
+
         TaskData td;
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
@@ -180,6 +205,8 @@ void wdTaskSystem::ScheduleGroupTasks(wdTaskGroup* pGroup, bool bHighPriority)
       }
     }
 
+    s_pState->UpdateTaskListState(pGroup->m_Priority);
+
     // send the proper thread signal, to make sure one of the correct worker threads is awake
     switch (pGroup->m_Priority)
     {
@@ -30,5 +30,19 @@ private:
   wdDeque<wdTaskGroup> m_TaskGroups;
 
   // The lists of all scheduled tasks, for each priority.
+  // Short tasks that are scheduled from a worker thread for this frame go into that worker's local queue instead (see wdTaskWorkerThread).
   wdList<wdTaskSystem::TaskData> m_Tasks[wdTaskPriority::ENUM_COUNT];
+
+  // One bit per priority, set when the corresponding list in m_Tasks is not empty.
+  // Only modified while holding the task system mutex, but read without it, so that threads can skip the lock when there is nothing to do.
+  wdAtomicInteger32 m_iNonEmptyTaskLists;
+
+  // Has to be called while holding the task system mutex, whenever m_Tasks[uiPriority] has been modified.
+  void UpdateTaskListState(wdUInt32 uiPriority)
+  {
+    if (m_Tasks[uiPriority].IsEmpty())
+      m_iNonEmptyTaskLists.And(~static_cast<wdInt32>(WD_BIT(uiPriority)));
+    else
+      m_iNonEmptyTaskLists.Or(static_cast<wdInt32>(WD_BIT(uiPriority)));
+  }
 };
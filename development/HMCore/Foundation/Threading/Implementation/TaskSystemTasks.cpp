@@ -91,29 +91,182 @@ wdTaskSystem::TaskData wdTaskSystem::GetNextTask(wdTaskPriority::Enum FirstPrior
   WD_ASSERT_DEV(FirstPriority >= wdTaskPriority::EarlyThisFrame && LastPriority < wdTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
-  WD_LOCK(s_TaskSystemMutex);
+  TaskData td;
 
-  // go through all the task lists that this thread is willing to work on
-  for (wdUInt32 prio = FirstPriority; prio <= (wdUInt32)LastPriority; ++prio)
+  while (true)
   {
-    for (auto it = s_pState->m_Tasks[prio].GetIterator(); it.IsValid(); ++it)
+    const wdInt32 iNonEmptyTaskLists = s_pState->m_iNonEmptyTaskLists;
+
+    // go through all the task queues that this thread is willing to work on
+    for (wdUInt32 prio = FirstPriority; prio <= (wdUInt32)LastPriority; ++prio)
     {
-      if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == wdTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+      // prefer the local queues, they don't require any lock
+      if (prio <= wdTaskPriority::LateThisFrame && GetLocalTask(prio, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+        return td;
+
+      if ((iNonEmptyTaskLists & static_cast<wdInt32>(WD_BIT(prio))) != 0)
       {
-        TaskData td = *it;
+        WD_LOCK(s_TaskSystemMutex);
 
-        s_pState->m_Tasks[prio].Remove(it);
-        return td;
+        if (GetSharedTask(prio, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+          return td;
+      }
+    }
+
+    if (pWorkerState == nullptr)
+      return td;
+
+    {
+      WD_LOCK(s_TaskSystemMutex);
+
+      // tasks are only added to the shared lists while holding the lock
+      // so if there is still nothing to do, anyone adding a task after this point will see that this thread is idle and wake it up
+      for (wdUInt32 prio = FirstPriority; prio <= (wdUInt32)LastPriority; ++prio)
+      {
+        if (GetSharedTask(prio, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+          return td;
       }
+
+      WD_VERIFY(pWorkerState->Set((int)wdTaskWorkerState::Idle) == (int)wdTaskWorkerState::Active, "Corrupt Worker State");
     }
+
+    // tasks are pushed into the local queues without holding the lock
+    // therefore check them again after this thread has been marked as idle:
+    // either we see the new task here, or the thread that pushed it sees the idle state and wakes this thread up
+    if (!HasLocalTasks(FirstPriority, LastPriority))
+      return td;
+
+    // if someone else already woke up this thread, the wake up signal is raised and the thread will just continue after WaitForWork()
+    if (!pWorkerState->TestAndSet((int)wdTaskWorkerState::Idle, (int)wdTaskWorkerState::Active))
+      return td;
   }
+}
+
+bool wdTaskSystem::GetLocalTask(wdUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const wdTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  // the entries may not be dereferenced before they have been claimed, see wdTaskWorkStealingDeque
+  auto filter = [&](const wdTaskLocalQueueEntry& entry)
+  { return !bOnlyTasksThatNeverWait || entry.m_bNeverWaits || entry.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup; };
+
+  wdTaskWorkerThread* pOwnThread = tl_TaskWorkerInfo.m_pWorkerThread;
+  wdTaskLocalQueueEntry entry;
 
-  if (pWorkerState)
+  bool bFound = false;
+
+  if (pOwnThread != nullptr)
   {
-    WD_VERIFY(pWorkerState->Set((int)wdTaskWorkerState::Idle) == (int)wdTaskWorkerState::Active, "Corrupt Worker State");
+    wdTaskWorkerThread::LocalQueue& localQueue = pOwnThread->GetLocalQueue(uiPriority);
+
+    bFound = localQueue.Pop(entry, filter);
+
+    // A thread that waits for a group only takes tasks from its own queue that can't wait themselves or that belong to that group.
+    // If such a task is buried below others, no thread might ever take it (other threads only steal from the top), and the waiting
+    // thread would spin forever. Therefore move the tasks above it to the shared list, where anyone can pick them up.
+    if (!bFound && bOnlyTasksThatNeverWait && localQueue.ContainsMatching(filter))
+    {
+      WD_LOCK(s_TaskSystemMutex);
+
+      wdUInt32 uiNumMoved = 0;
+      bFound = localQueue.PopMatching(entry, filter, [&](const wdTaskLocalQueueEntry& rejected)
+        {
+          TaskData td;
+          td.m_pBelongsToGroup = rejected.m_pBelongsToGroup;
+          td.m_pTask = rejected.m_pBelongsToGroup->m_Tasks[rejected.m_uiTaskIndex];
+          td.m_uiInvocation = rejected.m_uiInvocation;
+
+          s_pState->m_Tasks[uiPriority].PushFront(td);
+          ++uiNumMoved;
+        });
+
+      if (uiNumMoved > 0)
+      {
+        s_pState->UpdateTaskListState(uiPriority);
+        WakeUpThreads(wdWorkerThreadType::ShortTasks, uiNumMoved);
+      }
+    }
   }
 
-  return TaskData();
+  if (!bFound)
+  {
+    const wdUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[wdWorkerThreadType::ShortTasks];
+
+    // start with the next thread, so that not all threads try to steal from the same one
+    const wdUInt32 uiFirstVictim = pOwnThread != nullptr ? tl_TaskWorkerInfo.m_iWorkerIndex + 1 : 0;
+
+    for (wdUInt32 i = 0; i < uiNumWorkers && !bFound; ++i)
+    {
+      wdTaskWorkerThread* pVictim = s_pThreadState->m_Workers[wdWorkerThreadType::ShortTasks][(uiFirstVictim + i) % uiNumWorkers];
+
+      if (pVictim != pOwnThread)
+      {
+        bFound = pVictim->GetLocalQueue(uiPriority).Steal(entry, filter);
+      }
+    }
+
+    if (!bFound)
+      return false;
+  }
+
+  // the task group keeps the task alive until all its tasks have finished
+  out_task.m_pBelongsToGroup = entry.m_pBelongsToGroup;
+  out_task.m_pTask = entry.m_pBelongsToGroup->m_Tasks[entry.m_uiTaskIndex];
+  out_task.m_uiInvocation = entry.m_uiInvocation;
+  return true;
+}
+
+bool wdTaskSystem::GetSharedTask(wdUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const wdTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  for (auto it = s_pState->m_Tasks[uiPriority].GetIterator(); it.IsValid(); ++it)
+  {
+    if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == wdTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+    {
+      out_task = *it;
+
+      s_pState->m_Tasks[uiPriority].Remove(it);
+      s_pState->UpdateTaskListState(uiPriority);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool wdTaskSystem::HasLocalTasks(wdTaskPriority::Enum FirstPriority, wdTaskPriority::Enum LastPriority)
+{
+  if (FirstPriority > wdTaskPriority::LateThisFrame)
+    return false;
+
+  const wdUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[wdWorkerThreadType::ShortTasks];
+
+  for (wdUInt32 i = 0; i < uiNumWorkers; ++i)
+  {
+    if (s_pThreadState->m_Workers[wdWorkerThreadType::ShortTasks][i]->HasLocalTasks(FirstPriority, LastPriority))
+      return true;
+  }
+
+  return false;
+}
+
+void wdTaskSystem::MoveLocalTasksToSharedLists(wdTaskWorkerThread* pWorkerThread)
+{
+  WD_LOCK(s_TaskSystemMutex);
+
+  for (wdUInt32 prio = wdTaskPriority::EarlyThisFrame; prio <= wdTaskPriority::LateThisFrame; ++prio)
+  {
+    wdTaskLocalQueueEntry entry;
+    while (pWorkerThread->GetLocalQueue(prio).Pop(entry, [](const wdTaskLocalQueueEntry&)
+      { return true; }))
+    {
+      TaskData td;
+      td.m_pBelongsToGroup = entry.m_pBelongsToGroup;
+      td.m_pTask = entry.m_pBelongsToGroup->m_Tasks[entry.m_uiTaskIndex];
+      td.m_uiInvocation = entry.m_uiInvocation;
+
+      s_pState->m_Tasks[prio].PushFront(td);
+    }
+
+    s_pState->UpdateTaskListState(prio);
+  }
 }
 
 bool wdTaskSystem::ExecuteTask(wdTaskPriority::Enum FirstPriority, wdTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
@@ -181,13 +334,16 @@ wdResult wdTaskSystem::CancelTask(const wdSharedPtr<wdTask>& pTask, wdOnTaskRunn
         {
           if (it->m_pTask == pTask)
           {
+            TaskData td = *it;
+
             s_pState->m_Tasks[i].Remove(it);
+            s_pState->UpdateTaskListState(i);
 
             // we set the task to finished, even though it was not executed
             pTask->m_iRemainingRuns = 0;
 
             // tell the system that one task of that group is 'finished', to ensure its dependencies will get scheduled
-            TaskHasFinished(std::move(it->m_pTask), it->m_pBelongsToGroup);
+            TaskHasFinished(std::move(td.m_pTask), td.m_pBelongsToGroup);
             return WD_SUCCESS;
           }
 
@@ -274,6 +430,11 @@ void wdTaskSystem::ReprioritizeFrameTasks()
     // remove the tasks from their current queue
     s_pState->m_Tasks[i].Clear();
   }
+
+  for (wdUInt32 i = 0; i < wdTaskPriority::ENUM_COUNT; ++i)
+  {
+    s_pState->UpdateTaskListState(i);
+  }
 }
 
 void wdTaskSystem::ExecuteSomeFrameTasks(wdTime smoothFrameTime)
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+
+/// \internal A bounded, lock-free work-stealing deque (Chase-Lev).
+///
+/// The owning thread pushes and pops items at the 'bottom' end (LIFO), which keeps recently scheduled (and thus cache-hot) work on the
+/// same thread. Any other thread may steal items from the 'top' end (FIFO), which is the only operation that has to synchronize with
+/// other threads.
+///
+/// The capacity is fixed. Push() returns false when the deque is full, in which case the caller has to put the item somewhere else.
+/// Items must be trivially copyable, because stealing threads may read an item that is concurrently being overwritten. Such a torn
+/// read is always detected (the following compare-and-swap fails) and discarded, but it means that an item must never be dereferenced
+/// before it has been successfully claimed. The filter functions passed to Pop() and Steal() therefore may only inspect the item itself.
+template <typename T, wdUInt32 Capacity>
+class wdTaskWorkStealingDeque
+{
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  /// \brief Adds an item at the bottom end. May only be called by the owning thread. Returns false if the deque is full.
+  bool Push(const T& item)
+  {
+    const wdInt64 b = m_iBottom;
+    const wdInt64 t = m_iTop;
+
+    // t can only be too small here (never too large), so in the worst case we report 'full' too early
+    if (b - t >= (wdInt64)Capacity)
+      return false;
+
+    m_Items[b & Mask] = item;
+
+    // publishes the item (full barrier)
+    m_iBottom.Set(b + 1);
+    return true;
+  }
+
+  /// \brief Takes the most recently pushed item from the bottom end. May only be called by the owning thread.
+  ///
+  /// If \a filter rejects the bottom-most item, nothing is taken and false is returned.
+  template <typename Filter>
+  bool Pop(T& out_item, Filter filter)
+  {
+    const wdInt64 b = m_iBottom - 1;
+
+    if (m_iTop > b)
+      return false;
+
+    // only the owner writes items, so this one stays valid, even if another thread steals it in between
+    if (!filter(m_Items[b & Mask]))
+      return false;
+
+    m_iBottom.Set(b);
+
+    const wdInt64 t = m_iTop;
+
+    if (t > b)
+    {
+      // someone stole the last item
+      m_iBottom.Set(b + 1);
+      return false;
+    }
+
+    out_item = m_Items[b & Mask];
+
+    if (t == b)
+    {
+      // this is the last item, race against the stealing threads for it
+      const bool bWon = m_iTop.TestAndSet(t, t + 1);
+      m_iBottom.Set(b + 1);
+      return bWon;
+    }
+
+    return true;
+  }
+
+  /// \brief Takes the most recently pushed item that \a filter accepts. May only be called by the owning thread.
+  ///
+  /// All items below the accepted one are taken out as well and passed to \a onRejected, which has to put them somewhere else.
+  /// If no item is accepted, the deque is empty afterwards and false is returned.
+  template <typename Filter, typename RejectFunc>
+  bool PopMatching(T& out_item, Filter filter, RejectFunc onRejected)
+  {
+    T item;
+    while (Pop(item, [](const T&) { return true; }))
+    {
+      if (filter(item))
+      {
+        out_item = item;
+        return true;
+      }
+
+      onRejected(item);
+    }
+
+    return false;
+  }
+
+  /// \brief Returns whether \a filter accepts any of the items. May only be called by the owning thread.
+  ///
+  /// Items that are stolen concurrently may still be reported.
+  template <typename Filter>
+  bool ContainsMatching(Filter filter) const
+  {
+    // only the owner writes items, so all items between top and bottom stay valid while they are inspected
+    for (wdInt64 i = m_iBottom - 1; i >= m_iTop; --i)
+    {
+      if (filter(m_Items[i & Mask]))
+        return true;
+    }
+
+    return false;
+  }
+
+  /// \brief Takes the oldest item from the top end. May be called from any thread.
+  ///
+  /// Returns false if the deque is empty, \a filter rejected the top-most item or another thread was faster.
+  template <typename Filter>
+  bool Steal(T& out_item, Filter filter)
+  {
+    const wdInt64 t = m_iTop;
+    const wdInt64 b = m_iBottom;
+
+    if (t >= b)
+      return false;
+
+    const T item = m_Items[t & Mask];
+
+    if (!filter(item))
+      return false;
+
+    if (!m_iTop.TestAndSet(t, t + 1))
+      return false;
+
+    out_item = item;
+    return true;
+  }
+
+  /// \brief Returns whether the deque currently contains any items. The result may be outdated immediately.
+  bool IsEmpty() const { return m_iTop >= m_iBottom; }
+
+private:
+  static constexpr wdUInt32 Mask = Capacity - 1;
+
+  wdAtomicInteger64 m_iTop;
+  wdAtomicInteger64 m_iBottom;
+  T m_Items[Capacity];
+};
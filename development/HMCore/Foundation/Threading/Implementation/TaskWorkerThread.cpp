@@ -50,6 +50,11 @@ wdUInt32 wdTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_iWorkerState;
 
+  if (m_WorkerType == wdWorkerThreadType::ShortTasks)
+  {
+    tl_TaskWorkerInfo.m_pWorkerThread = this;
+  }
+
   const bool bIsReserve = m_uiWorkerThreadNumber >= wdTaskSystem::s_pThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
   wdTaskPriority::Enum FirstPriority;
@@ -90,6 +95,9 @@ wdUInt32 wdTaskWorkerThread::Run()
     }
   }
 
+  // don't lose the tasks that other threads did not steal yet
+  wdTaskSystem::MoveLocalTasksToSharedLists(this);
+
   return 0;
 }
 
@@ -137,6 +145,19 @@ void wdTaskWorkerThread::UpdateThreadUtilization(wdTime timePassed)
   m_uiNumTasksExecuted = 0;
 }
 
+bool wdTaskWorkerThread::HasLocalTasks(wdUInt32 uiFirstPriority, wdUInt32 uiLastPriority) const
+{
+  uiLastPriority = wdMath::Min<wdUInt32>(uiLastPriority, wdTaskPriority::LateThisFrame);
+
+  for (wdUInt32 prio = uiFirstPriority; prio <= uiLastPriority; ++prio)
+  {
+    if (!m_LocalQueues[prio].IsEmpty())
+      return true;
+  }
+
+  return false;
+}
+
 double wdTaskWorkerThread::GetThreadUtilization(wdUInt32* pNumTasksExecuted /*= nullptr*/)
 {
   if (pNumTasksExecuted)
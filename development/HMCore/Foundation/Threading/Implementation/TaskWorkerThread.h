@@ -1,10 +1,23 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkStealingDeque.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
 
+/// \internal An entry in the local queue of a worker thread.
+///
+/// Does not hold a reference to the task, the task group keeps the task alive until all its tasks are finished.
+/// Entries may be read while they are being overwritten (see wdTaskWorkStealingDeque), so they have to be trivially copyable.
+struct wdTaskLocalQueueEntry
+{
+  wdTaskGroup* m_pBelongsToGroup;
+  wdUInt32 m_uiTaskIndex;       // index into wdTaskGroup::m_Tasks
+  wdUInt32 m_uiInvocation : 31; // see wdTask::SetMultiplicity
+  wdUInt32 m_bNeverWaits : 1;   // whether the task uses wdTaskNesting::Never
+};
+
 /// \internal Internal task worker thread class.
 class wdTaskWorkerThread final : public wdThread
 {
@@ -53,6 +66,26 @@ private:
 
   ///@}
 
+  /// \name Work Stealing
+  ///@{
+
+public:
+  static constexpr wdUInt32 LocalQueueCapacity = 512;
+  using LocalQueue = wdTaskWorkStealingDeque<wdTaskLocalQueueEntry, LocalQueueCapacity>;
+
+  /// \brief Returns the local queue for the given priority, which must be one of the 'this frame' priorities.
+  LocalQueue& GetLocalQueue(wdUInt32 uiPriority) { return m_LocalQueues[uiPriority]; }
+
+  /// \brief Returns whether any of the local queues in the given priority range contains tasks.
+  bool HasLocalTasks(wdUInt32 uiFirstPriority, wdUInt32 uiLastPriority) const;
+
+private:
+  // Tasks that were scheduled by this thread. This thread pushes and pops at one end, all other threads may steal from the other end.
+  // Only short tasks that need to be done this frame use these queues, all others go through the (locked) lists in wdTaskSystemState.
+  LocalQueue m_LocalQueues[wdTaskPriority::LateThisFrame + 1];
+
+  ///@}
+
   /// \name Idle State
   ///@{
 
@@ -85,6 +118,7 @@ struct wdTaskWorkerInfo
   bool m_bAllowNestedTasks = true;
   const char* m_szTaskName = nullptr;
   wdAtomicInteger32* m_pWorkerState = nullptr;
+  wdTaskWorkerThread* m_pWorkerThread = nullptr; ///< Only set for short task worker threads, which own local task queues.
 };
 
 extern thread_local wdTaskWorkerInfo tl_TaskWorkerInfo;
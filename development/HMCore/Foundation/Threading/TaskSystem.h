@@ -72,6 +72,10 @@ public:
   /// Therefore when bWaitForIt is true, this function might block for a very long time.
   /// It is advised to implement tasks that need to be canceled regularly (e.g. path searches for units that might die)
   /// in a way that allows for quick canceling.
+  ///
+  /// Short tasks that were scheduled from a worker thread for execution this frame live in that worker's local queue and
+  /// cannot be removed from there. Such tasks are treated as if they were already running, i.e. they are flagged as canceled
+  /// (and skipped once dequeued) and WD_FAILURE is returned.
   static wdResult CancelTask(const wdSharedPtr<wdTask>& pTask, wdOnTaskRunning::Enum onTaskRunning = wdOnTaskRunning::WaitTillFinished); // [tested]
 
   struct TaskData
@@ -90,6 +94,18 @@ private:
   static bool ExecuteTask(wdTaskPriority::Enum FirstPriority, wdTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const wdTaskGroupID& WaitingForGroup, wdAtomicInteger32* pWorkerState);
 
+  /// \brief Takes a task of priority \a uiPriority from the local queue of the calling worker thread or steals one from another worker.
+  static bool GetLocalTask(wdUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const wdTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Takes a task of priority \a uiPriority from the shared task lists. Must be called while holding s_TaskSystemMutex.
+  static bool GetSharedTask(wdUInt32 uiPriority, bool bOnlyTasksThatNeverWait, const wdTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Returns whether the local queue of any worker thread contains tasks of priority between \a FirstPriority and \a LastPriority.
+  static bool HasLocalTasks(wdTaskPriority::Enum FirstPriority, wdTaskPriority::Enum LastPriority);
+
+  /// \brief Moves all tasks from the local queues of the given worker thread into the shared task lists. Called when a worker shuts down.
+  static void MoveLocalTasksToSharedLists(wdTaskWorkerThread* pWorkerThread);
+
   /// \brief Called whenever a task has been finished/canceled. Makes sure that groups are marked as finished when all tasks are done.
   static void TaskHasFinished(wdSharedPtr<wdTask>&& pTask, wdTaskGroup* pGroup);
 
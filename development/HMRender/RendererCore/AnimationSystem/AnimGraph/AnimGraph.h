@@ -8,6 +8,7 @@
 #include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraphNode.h>
 #include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
 
 #include <Foundation/Containers/HashTable.h>
 #include <Foundation/Types/SharedPtr.h>
@@ -61,6 +62,14 @@ public:
 
   const wdSharedPtr<wdBlackboard>& GetBlackboard() { return m_pBlackboard; }
 
+  /// \brief Configures how often the graph is updated, depending on the visibility of the target and its distance to the LOD camera.
+  ///
+  /// In frames in which the graph isn't updated, the root motion of the last update is continued and, if enabled, the pose is interpolated.
+  /// The settings are serialized together with the graph, so they are configured where the graph is authored and every instance
+  /// created through wdAnimGraphResource::DeserializeAnimGraphState() uses them. wdAnimationLodSettings is reflected, so it can be exposed as a property.
+  void SetLodSettings(const wdAnimationLodSettings& settings);
+  const wdAnimationLodSettings& GetLodSettings() const { return m_LodSettings; }
+
   wdResult Serialize(wdStreamWriter& inout_stream) const;
   wdResult Deserialize(wdStreamReader& inout_stream);
 
@@ -76,6 +85,8 @@ public:
   void SetRootMotion(const wdVec3& vTranslation, wdAngle rotationX, wdAngle rotationY, wdAngle rotationZ);
 
 private:
+  void ApplyRootMotionRate(wdTime diff);
+
   wdDynamicArray<wdUniquePtr<wdAnimGraphNode>> m_Nodes;
   wdSkeletonResourceHandle m_hSkeleton;
 
@@ -95,6 +106,15 @@ private:
   wdAngle m_RootRotationY;
   wdAngle m_RootRotationZ;
 
+  wdAnimationLodSettings m_LodSettings;
+  wdAnimationLodState m_LodState;
+
+  // the root motion of the last update, continued in the frames that are skipped due to LOD
+  wdVec3 m_vRootMotionPerSecond = wdVec3::ZeroVector();
+  wdAngle m_RootRotationXPerSecond;
+  wdAngle m_RootRotationYPerSecond;
+  wdAngle m_RootRotationZPerSecond;
+
 private:
   friend class wdAnimationControllerAssetDocument;
   friend class wdAnimGraphTriggerOutputPin;
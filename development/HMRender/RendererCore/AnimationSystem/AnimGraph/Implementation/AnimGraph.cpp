@@ -2,6 +2,7 @@
 
 #include <Core/World/GameObject.h>
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraph.h>
+#include <RendererCore/AnimationSystem/AnimPoseGeneratorWorldModule.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
 
 #include <ozz/animation/runtime/skeleton.h>
@@ -40,6 +41,38 @@ void wdAnimGraph::Update(wdTime diff, wdGameObject* pTarget)
     }
   }
 
+  wdAnimPoseGeneratorWorldModule* pPoseModule = pTarget->GetWorld()->GetModule<wdAnimPoseGeneratorWorldModule>();
+
+  wdVec3 vLodReferencePosition;
+  const bool bHasLodReferencePosition = pPoseModule != nullptr && pPoseModule->GetLodReferencePosition(vLodReferencePosition);
+
+  if (!m_LodState.Update(m_LodSettings, diff, pTarget, bHasLodReferencePosition ? &vLodReferencePosition : nullptr))
+  {
+    ApplyRootMotionRate(diff);
+
+    if (pPoseModule != nullptr)
+    {
+      // sent together with the generated poses, so that the target receives its pose in the same phase in every frame
+      pPoseModule->QueueInterpolatedPose(GetPoseGenerator(), pTarget, m_hSkeleton, m_LodState);
+      return;
+    }
+
+    if (auto pose = m_LodState.GetInterpolatedPose(); !pose.IsEmpty())
+    {
+      wdMsgAnimationPoseUpdated msg;
+      msg.m_pRootTransform = &pSkeleton->GetDescriptor().m_RootTransform;
+      msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
+      msg.m_ModelTransforms = pose;
+
+      pTarget->SendMessageRecursive(msg);
+    }
+
+    return;
+  }
+
+  // with LOD the graph is advanced by all the time that passed since its last update
+  const wdTime stepTime = m_LodState.GetStepTime();
+
   m_pCurrentModelTransforms = nullptr;
 
   m_pPoseGenerator->Reset(pSkeleton.GetPointer());
@@ -74,10 +107,37 @@ void wdAnimGraph::Update(wdTime diff, wdGameObject* pTarget)
 
   for (const auto& pNode : m_Nodes)
   {
-    pNode->Step(*this, diff, pSkeleton.GetPointer(), pTarget);
+    pNode->Step(*this, stepTime, pSkeleton.GetPointer(), pTarget);
+  }
+
+  // remember the root motion as a rate, so that it can be continued in the frames that are skipped due to LOD
+  {
+    const float fInvStepTime = stepTime.IsPositive() ? 1.0f / stepTime.AsFloatInSeconds() : 0.0f;
+
+    m_vRootMotionPerSecond = m_vRootMotion * fInvStepTime;
+    m_RootRotationXPerSecond = m_RootRotationX * fInvStepTime;
+    m_RootRotationYPerSecond = m_RootRotationY * fInvStepTime;
+    m_RootRotationZPerSecond = m_RootRotationZ * fInvStepTime;
+  }
+
+  if (stepTime != diff)
+  {
+    // spread the root motion of the whole step over the frames until the next update
+    ApplyRootMotionRate(diff);
+  }
+
+  // invisible targets only advance their animation state
+  if (!m_LodState.ShouldGeneratePose())
+    return;
+
+  if (pPoseModule != nullptr)
+  {
+    // the pose is generated later together with all other poses of this world
+    pPoseModule->QueuePoseGeneration(GetPoseGenerator(), pTarget, m_hSkeleton, &m_LodState);
+    return;
   }
 
-  if (auto newPose = GetPoseGenerator().GeneratePose(pTarget); !newPose.IsEmpty())
+  if (auto newPose = m_LodState.AddGeneratedPose(GetPoseGenerator().GeneratePose(pTarget)); !newPose.IsEmpty())
   {
     wdMsgAnimationPoseUpdated msg;
     msg.m_pRootTransform = &pSkeleton->GetDescriptor().m_RootTransform;
@@ -88,6 +148,18 @@ void wdAnimGraph::Update(wdTime diff, wdGameObject* pTarget)
   }
 }
 
+void wdAnimGraph::SetLodSettings(const wdAnimationLodSettings& settings)
+{
+  m_LodSettings = settings;
+  m_LodState.Reset();
+}
+
+void wdAnimGraph::ApplyRootMotionRate(wdTime diff)
+{
+  const float fSeconds = diff.AsFloatInSeconds();
+  SetRootMotion(m_vRootMotionPerSecond * fSeconds, m_RootRotationXPerSecond * fSeconds, m_RootRotationYPerSecond * fSeconds, m_RootRotationZPerSecond * fSeconds);
+}
+
 void wdAnimGraph::GetRootMotion(wdVec3& ref_vTranslation, wdAngle& ref_rotationX, wdAngle& ref_rotationY, wdAngle& ref_rotationZ) const
 {
   ref_vTranslation = m_vRootMotion;
@@ -98,7 +170,7 @@ void wdAnimGraph::GetRootMotion(wdVec3& ref_vTranslation, wdAngle& ref_rotationX
 
 wdResult wdAnimGraph::Serialize(wdStreamWriter& inout_stream) const
 {
-  inout_stream.WriteVersion(5);
+  inout_stream.WriteVersion(6);
 
   const wdUInt32 uiNumNodes = m_Nodes.GetCount();
   inout_stream << uiNumNodes;
@@ -159,12 +231,14 @@ wdResult wdAnimGraph::Serialize(wdStreamWriter& inout_stream) const
   }
   // EXTEND THIS if a new type is introduced
 
+  WD_SUCCEED_OR_RETURN(m_LodSettings.Serialize(inout_stream));
+
   return WD_SUCCESS;
 }
 
 wdResult wdAnimGraph::Deserialize(wdStreamReader& inout_stream)
 {
-  const auto uiVersion = inout_stream.ReadVersion(5);
+  const auto uiVersion = inout_stream.ReadVersion(6);
 
   wdUInt32 uiNumNodes = 0;
   inout_stream >> uiNumNodes;
@@ -250,6 +324,13 @@ wdResult wdAnimGraph::Deserialize(wdStreamReader& inout_stream)
   }
   // EXTEND THIS if a new type is introduced
 
+  if (uiVersion >= 6)
+  {
+    wdAnimationLodSettings lodSettings;
+    WD_SUCCEED_OR_RETURN(lodSettings.Deserialize(inout_stream));
+    SetLodSettings(lodSettings);
+  }
+
   return WD_SUCCESS;
 }
 
@@ -13,6 +13,7 @@ WD_DEFINE_AS_POD_TYPE(ozz::math::SoaTransform);
 
 class wdSkeletonResource;
 class wdAnimPoseGenerator;
+class wdAnimPoseGeneratorWorldModule;
 class wdGameObject;
 
 using wdAnimationClipResourceHandle = wdTypedResourceHandle<class wdAnimationClipResource>;
@@ -176,7 +177,21 @@ public:
 
   wdArrayPtr<wdMat4> GeneratePose(const wdGameObject* pSendAnimationEventsTo);
 
+  /// \brief Returns false if any command needs to send a message while the pose is generated, in which case GeneratePoseDeferred() must not be used.
+  bool CanGeneratePoseDeferred() const;
+
+  /// \brief Same as GeneratePose(), but doesn't send any messages.
+  ///
+  /// Since no other objects are accessed, the poses of different generators can be generated on different threads at the same time.
+  /// The sampled animation events are stored and have to be sent afterwards through SendDeferredAnimationEvents().
+  wdArrayPtr<wdMat4> GeneratePoseDeferred();
+
+  /// \brief Sends the animation events that were sampled by the last call to GeneratePoseDeferred().
+  void SendDeferredAnimationEvents(const wdGameObject* pSendAnimationEventsTo);
+
 private:
+  friend class wdAnimPoseGeneratorWorldModule;
+
   void Validate() const;
 
   void Execute(wdAnimPoseGeneratorCommand& cmd, const wdGameObject* pSendAnimationEventsTo);
@@ -207,4 +222,11 @@ private:
   wdHybridArray<wdAnimPoseGeneratorCommandSampleEventTrack, 2> m_CommandsSampleEventTrack;
 
   wdArrayMap<wdUInt32, ozz::animation::SamplingJob::Context*> m_SamplingCaches;
+
+  bool m_bDeferAnimationEvents = false;
+  wdHybridArray<wdHashedString, 4> m_DeferredAnimationEvents;
+
+  // set while the generator is queued in a wdAnimPoseGeneratorWorldModule
+  wdAnimPoseGeneratorWorldModule* m_pQueuedInModule = nullptr;
+  wdUInt32 m_uiQueueIndex = 0;
 };
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Core/ResourceManager/ResourceHandle.h>
+#include <Core/World/World.h>
+#include <RendererCore/RendererCoreDLL.h>
+
+class wdAnimPoseGenerator;
+class wdAnimationLodState;
+
+using wdSkeletonResourceHandle = wdTypedResourceHandle<class wdSkeletonResource>;
+
+/// \brief Collects the pose generators of all animated objects in a world and generates their poses in parallel.
+///
+/// If this module exists in a world, wdAnimGraph::Update() queues its pose generator here instead of generating the pose right away.
+/// In frames that are skipped due to LOD, the interpolated pose is queued instead, so poses are always sent in the same phase.
+/// Once per frame, in the PostAsync phase, the poses of all queued generators are generated on worker threads.
+/// Afterwards the animation events and the wdMsgAnimationPoseUpdated messages are sent on the main thread in the order in which the generators were queued.
+/// Generators that need to send messages while their pose is generated (see wdAnimPoseGenerator::CanGeneratePoseDeferred()) are
+/// processed on the main thread instead.
+///
+/// Every generator is processed by a single task, so its sampling caches are only ever used by one thread at a time.
+/// The module is created automatically once a wdSkeletonComponent starts simulating, other worlds can use wdWorld::GetOrCreateModule() to enable this.
+///
+/// The module also provides the position of the LOD camera, which animation graphs use to reduce their update rate, see wdAnimationLodSettings.
+class WD_RENDERERCORE_DLL wdAnimPoseGeneratorWorldModule : public wdWorldModule
+{
+  WD_DECLARE_WORLD_MODULE();
+  WD_ADD_DYNAMIC_REFLECTION(wdAnimPoseGeneratorWorldModule, wdWorldModule);
+
+public:
+  wdAnimPoseGeneratorWorldModule(wdWorld* pWorld);
+  ~wdAnimPoseGeneratorWorldModule();
+
+  virtual void Initialize() override;
+  virtual void Deinitialize() override;
+
+  /// \brief Queues the pose generation of the given generator. Once the pose is generated, wdMsgAnimationPoseUpdated is sent to pTarget.
+  ///
+  /// The commands of the generator must not be modified until then. Queuing the same generator again only updates the target.
+  /// If the generator is destroyed before its pose was generated, it is removed from the queue automatically.
+  /// If pLodState is given, the generated pose is passed through wdAnimationLodState::AddGeneratedPose() before it is sent.
+  /// The LOD state must stay alive as long as the generator is queued.
+  void QueuePoseGeneration(wdAnimPoseGenerator& ref_poseGenerator, wdGameObject* pTarget, const wdSkeletonResourceHandle& hSkeleton, wdAnimationLodState* pLodState = nullptr);
+
+  /// \brief Queues sending the interpolated pose of the given LOD state to pTarget, for a frame in which the generator doesn't generate a new pose.
+  ///
+  /// The pose is taken from wdAnimationLodState::GetInterpolatedPose() and sent together with the generated poses of this frame,
+  /// so that a target receives its poses in the same phase, no matter whether its animation was updated in that frame.
+  void QueueInterpolatedPose(wdAnimPoseGenerator& ref_poseGenerator, wdGameObject* pTarget, const wdSkeletonResourceHandle& hSkeleton, wdAnimationLodState& ref_lodState);
+
+  /// \brief Removes the given generator from the queue, if it is queued.
+  void CancelPoseGeneration(wdAnimPoseGenerator& ref_poseGenerator);
+
+  /// \brief Generates the poses of all queued generators and sends the results to their targets.
+  ///
+  /// This is done automatically once per frame, but can also be called manually, e.g. when the poses are needed earlier.
+  void GenerateQueuedPoses();
+
+  /// \brief Returns the number of currently queued generators.
+  wdUInt32 GetNumQueuedPoses() const { return m_QueuedPoses.GetCount(); }
+
+  /// \brief Overrides the position that animation LOD distances are measured from.
+  ///
+  /// By default the position of the LOD camera of the main view that renders this world is used.
+  void SetLodReferencePosition(const wdVec3& vPosition);
+
+  /// \brief Reverts to using the position of the main view's LOD camera.
+  void ClearLodReferencePosition();
+
+  /// \brief Returns false if there is no LOD reference position, e.g. because the world is not rendered in any view.
+  bool GetLodReferencePosition(wdVec3& out_vPosition) const;
+
+private:
+  void UpdatePoses(const wdWorldModule::UpdateContext& context);
+  void UpdateLodReferencePosition(const wdWorldModule::UpdateContext& context);
+
+  struct QueuedPose
+  {
+    wdAnimPoseGenerator* m_pPoseGenerator = nullptr;
+    wdGameObjectHandle m_hTarget;
+    wdSkeletonResourceHandle m_hSkeleton;
+    wdAnimationLodState* m_pLodState = nullptr;
+    wdArrayPtr<const wdMat4> m_Pose;
+    bool m_bGeneratePose = true;
+    bool m_bDeferred = false;
+  };
+
+  QueuedPose& QueuePose(wdAnimPoseGenerator& ref_poseGenerator, wdGameObject* pTarget, const wdSkeletonResourceHandle& hSkeleton, wdAnimationLodState* pLodState);
+
+  wdDynamicArray<QueuedPose> m_QueuedPoses;
+
+  wdVec3 m_vLodReferencePosition = wdVec3::ZeroVector();
+  bool m_bHasLodReferencePosition = false;
+  bool m_bLodReferencePositionOverridden = false;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+#include <Foundation/Reflection/Reflection.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/RendererCoreDLL.h>
+
+class wdGameObject;
+
+/// \brief Describes how often an animated skeleton is updated up to a certain distance from the LOD camera.
+struct wdAnimationLodLevel
+{
+  /// \brief The level is used for skeletons that are at most this far away from the LOD camera.
+  float m_fMaxDistance = wdMath::HighValue<float>();
+
+  /// \brief The animation is only updated every N-th frame.
+  wdUInt8 m_uiUpdateInterval = 1;
+};
+
+WD_DECLARE_REFLECTABLE_TYPE(WD_RENDERERCORE_DLL, wdAnimationLodLevel);
+
+/// \brief Configures how animated skeletons reduce their update rate when they are far away or not visible.
+///
+/// The default settings disable LOD, i.e. the animation is updated every frame.
+struct WD_RENDERERCORE_DLL wdAnimationLodSettings
+{
+  /// \brief The distance based levels, sorted by ascending distance.
+  ///
+  /// Skeletons that are farther away than the last level use the last level.
+  /// Distances are only evaluated if the world has an wdAnimPoseGeneratorWorldModule that knows the position of the LOD camera.
+  wdHybridArray<wdAnimationLodLevel, 4> m_Levels;
+
+  /// \brief The animation of skeletons that are not visible in any view is only updated every N-th frame.
+  wdUInt8 m_uiInvisibleUpdateInterval = 1;
+
+  /// \brief How many frames a skeleton has to be not visible before it is treated as invisible. See wdGameObject::GetVisibilityState().
+  wdUInt8 m_uiNumFramesBeforeInvisible = 5;
+
+  /// \brief If set, no pose is generated for invisible skeletons. Their animation state is still advanced, but animation events are not sent.
+  bool m_bSkipPoseWhenInvisible = false;
+
+  /// \brief If set, the pose is blended from the previous to the new pose over the frames until the next update, instead of jumping.
+  ///
+  /// This hides the reduced update rate, but delays the visible animation by up to one update interval.
+  bool m_bInterpolatePoses = true;
+
+  wdResult Serialize(wdStreamWriter& inout_stream) const;
+  wdResult Deserialize(wdStreamReader& inout_stream);
+};
+
+WD_DECLARE_REFLECTABLE_TYPE(WD_RENDERERCORE_DLL, wdAnimationLodSettings);
+
+/// \brief Tracks the LOD of a single animated skeleton and decides in which frames it has to be updated.
+///
+/// Call Update() every frame. If it returns true, advance the animation by GetStepTime() and generate a new pose,
+/// if ShouldGeneratePose() returns true. Pass that pose through AddGeneratedPose() and forward the result.
+/// In all other frames, forward the result of GetInterpolatedPose(), if it isn't empty.
+class WD_RENDERERCORE_DLL wdAnimationLodState
+{
+public:
+  wdAnimationLodState();
+  ~wdAnimationLodState();
+
+  /// \brief Returns true if the animation has to be updated in this frame.
+  ///
+  /// pLodReferencePosition is the position distances are measured from. If it is null, the distance based levels are ignored.
+  bool Update(const wdAnimationLodSettings& settings, wdTime diff, const wdGameObject* pTarget, const wdVec3* pLodReferencePosition);
+
+  /// \brief The time that passed since the last update. Only valid when Update() returned true.
+  wdTime GetStepTime() const { return m_StepTime; }
+
+  /// \brief Whether a pose needs to be generated in this update.
+  bool ShouldGeneratePose() const { return m_bGeneratePose; }
+
+  /// \brief The current update interval in frames.
+  wdUInt8 GetUpdateInterval() const { return m_uiUpdateInterval; }
+
+  /// \brief Takes a newly generated pose and returns the pose that should be displayed in this frame.
+  wdArrayPtr<const wdMat4> AddGeneratedPose(wdArrayPtr<const wdMat4> pose);
+
+  /// \brief Returns the pose that should be displayed in a frame without update, or an empty array if the displayed pose doesn't change.
+  wdArrayPtr<const wdMat4> GetInterpolatedPose();
+
+  /// \brief Forgets all state, the next call to Update() will always request an update.
+  void Reset();
+
+private:
+  wdUInt32 SelectLevel(const wdAnimationLodSettings& settings, float fDistance) const;
+
+  wdTime m_AccumulatedTime;
+  wdTime m_StepTime;
+  wdUInt32 m_uiFramesSinceUpdate = 0;
+  wdUInt32 m_uiCurrentLevel = 0;
+  wdUInt8 m_uiUpdateInterval = 1;
+  bool m_bInitialized = false;
+  bool m_bGeneratePose = true;
+  bool m_bInterpolate = false;
+  bool m_bSnapToNextPose = true;
+
+  wdUInt32 m_uiInterpolationStep = 0;
+  wdUInt32 m_uiInterpolationSteps = 0;
+  wdDynamicArray<wdMat4, wdAlignedAllocatorWrapper> m_StartPose;
+  wdDynamicArray<wdMat4, wdAlignedAllocatorWrapper> m_TargetPose;
+  wdDynamicArray<wdMat4, wdAlignedAllocatorWrapper> m_DisplayedPose;
+};
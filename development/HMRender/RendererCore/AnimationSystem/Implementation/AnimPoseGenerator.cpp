@@ -3,6 +3,7 @@
 #include <Core/Messages/CommonMessages.h>
 #include <Core/World/GameObject.h>
 #include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/AnimPoseGeneratorWorldModule.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/Declarations.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
@@ -101,6 +102,11 @@ wdAnimPoseGenerator::wdAnimPoseGenerator() = default;
 
 wdAnimPoseGenerator::~wdAnimPoseGenerator()
 {
+  if (m_pQueuedInModule != nullptr)
+  {
+    m_pQueuedInModule->CancelPoseGeneration(*this);
+  }
+
   for (wdUInt32 i = 0; i < m_SamplingCaches.GetCount(); ++i)
   {
     WD_DEFAULT_DELETE(m_SamplingCaches.GetValue(i));
@@ -210,6 +216,44 @@ wdArrayPtr<wdMat4> wdAnimPoseGenerator::GeneratePose(const wdGameObject* pSendAn
   return pPose;
 }
 
+bool wdAnimPoseGenerator::CanGeneratePoseDeferred() const
+{
+  for (auto& cmd : m_CommandsLocalToModelPose)
+  {
+    if (cmd.m_pSendLocalPoseMsgTo != nullptr)
+      return false;
+  }
+
+  return true;
+}
+
+wdArrayPtr<wdMat4> wdAnimPoseGenerator::GeneratePoseDeferred()
+{
+  WD_ASSERT_DEBUG(CanGeneratePoseDeferred(), "The pose generation needs to send messages and thus can't be deferred.");
+
+  m_DeferredAnimationEvents.Clear();
+
+  m_bDeferAnimationEvents = true;
+  auto pPose = GeneratePose(nullptr);
+  m_bDeferAnimationEvents = false;
+
+  return pPose;
+}
+
+void wdAnimPoseGenerator::SendDeferredAnimationEvents(const wdGameObject* pSendAnimationEventsTo)
+{
+  wdMsgGenericEvent msg;
+
+  for (const auto& hs : m_DeferredAnimationEvents)
+  {
+    msg.m_sMessage = hs;
+
+    pSendAnimationEventsTo->SendEventMessage(msg, nullptr);
+  }
+
+  m_DeferredAnimationEvents.Clear();
+}
+
 void wdAnimPoseGenerator::Execute(wdAnimPoseGeneratorCommand& cmd, const wdGameObject* pSendAnimationEventsTo)
 {
   if (cmd.m_bExecuted)
@@ -460,6 +504,12 @@ void wdAnimPoseGenerator::SampleEventTrack(const wdAnimationClipResource* pResou
       WD_DEFAULT_CASE_NOT_IMPLEMENTED;
   }
 
+  if (m_bDeferAnimationEvents)
+  {
+    m_DeferredAnimationEvents.PushBackRange(events);
+    return;
+  }
+
   wdMsgGenericEvent msg;
 
   for (const auto& hs : events)
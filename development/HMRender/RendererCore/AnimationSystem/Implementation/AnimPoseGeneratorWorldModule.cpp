@@ -0,0 +1,249 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/AnimPoseGeneratorWorldModule.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+#include <RendererCore/AnimationSystem/Declarations.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+// clang-format off
+WD_IMPLEMENT_WORLD_MODULE(wdAnimPoseGeneratorWorldModule);
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdAnimPoseGeneratorWorldModule, 1, wdRTTINoAllocator)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+wdAnimPoseGeneratorWorldModule::wdAnimPoseGeneratorWorldModule(wdWorld* pWorld)
+  : wdWorldModule(pWorld)
+{
+}
+
+wdAnimPoseGeneratorWorldModule::~wdAnimPoseGeneratorWorldModule() = default;
+
+void wdAnimPoseGeneratorWorldModule::Initialize()
+{
+  SUPER::Initialize();
+
+  {
+    auto updateDesc = WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdAnimPoseGeneratorWorldModule::UpdateLodReferencePosition, this);
+    updateDesc.m_Phase = wdWorldModule::UpdateFunctionDesc::Phase::PreAsync;
+    // run before any animation graph is updated
+    updateDesc.m_fPriority = 10000.0f;
+
+    RegisterUpdateFunction(updateDesc);
+  }
+
+  {
+    auto updateDesc = WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdAnimPoseGeneratorWorldModule::UpdatePoses, this);
+    updateDesc.m_Phase = wdWorldModule::UpdateFunctionDesc::Phase::PostAsync;
+    // run after everything else in this phase, so that animation graphs that are updated in PostAsync don't lag one frame behind
+    updateDesc.m_fPriority = -10000.0f;
+
+    RegisterUpdateFunction(updateDesc);
+  }
+}
+
+void wdAnimPoseGeneratorWorldModule::Deinitialize()
+{
+  for (auto& queuedPose : m_QueuedPoses)
+  {
+    if (queuedPose.m_pPoseGenerator != nullptr)
+    {
+      queuedPose.m_pPoseGenerator->m_pQueuedInModule = nullptr;
+    }
+  }
+
+  m_QueuedPoses.Clear();
+
+  SUPER::Deinitialize();
+}
+
+void wdAnimPoseGeneratorWorldModule::QueuePoseGeneration(wdAnimPoseGenerator& ref_poseGenerator, wdGameObject* pTarget, const wdSkeletonResourceHandle& hSkeleton, wdAnimationLodState* pLodState /*= nullptr*/)
+{
+  QueuePose(ref_poseGenerator, pTarget, hSkeleton, pLodState).m_bGeneratePose = true;
+}
+
+void wdAnimPoseGeneratorWorldModule::QueueInterpolatedPose(wdAnimPoseGenerator& ref_poseGenerator, wdGameObject* pTarget, const wdSkeletonResourceHandle& hSkeleton, wdAnimationLodState& ref_lodState)
+{
+  QueuePose(ref_poseGenerator, pTarget, hSkeleton, &ref_lodState).m_bGeneratePose = false;
+}
+
+void wdAnimPoseGeneratorWorldModule::CancelPoseGeneration(wdAnimPoseGenerator& ref_poseGenerator)
+{
+  if (ref_poseGenerator.m_pQueuedInModule != this)
+    return;
+
+  // keep the entry, so that the queue indices of the other generators stay valid
+  m_QueuedPoses[ref_poseGenerator.m_uiQueueIndex].m_pPoseGenerator = nullptr;
+  ref_poseGenerator.m_pQueuedInModule = nullptr;
+}
+
+wdAnimPoseGeneratorWorldModule::QueuedPose& wdAnimPoseGeneratorWorldModule::QueuePose(wdAnimPoseGenerator& ref_poseGenerator, wdGameObject* pTarget, const wdSkeletonResourceHandle& hSkeleton, wdAnimationLodState* pLodState)
+{
+  WD_ASSERT_DEV(ref_poseGenerator.m_pQueuedInModule == nullptr || ref_poseGenerator.m_pQueuedInModule == this, "The pose generator is already queued in another world.");
+
+  QueuedPose* pQueuedPose = nullptr;
+
+  if (ref_poseGenerator.m_pQueuedInModule == this)
+  {
+    pQueuedPose = &m_QueuedPoses[ref_poseGenerator.m_uiQueueIndex];
+  }
+  else
+  {
+    ref_poseGenerator.m_pQueuedInModule = this;
+    ref_poseGenerator.m_uiQueueIndex = m_QueuedPoses.GetCount();
+
+    pQueuedPose = &m_QueuedPoses.ExpandAndGetRef();
+    pQueuedPose->m_pPoseGenerator = &ref_poseGenerator;
+  }
+
+  pQueuedPose->m_hTarget = pTarget->GetHandle();
+  pQueuedPose->m_hSkeleton = hSkeleton;
+  pQueuedPose->m_pLodState = pLodState;
+
+  return *pQueuedPose;
+}
+
+void wdAnimPoseGeneratorWorldModule::GenerateQueuedPoses()
+{
+  // generators that are queued while the results are sent are processed by the next call
+  const wdUInt32 uiNumPoses = m_QueuedPoses.GetCount();
+  if (uiNumPoses == 0)
+    return;
+
+  WD_PROFILE_SCOPE("GenerateQueuedPoses");
+
+  for (wdUInt32 i = 0; i < uiNumPoses; ++i)
+  {
+    QueuedPose& queuedPose = m_QueuedPoses[i];
+    queuedPose.m_bDeferred = queuedPose.m_pPoseGenerator != nullptr && queuedPose.m_bGeneratePose && queuedPose.m_pPoseGenerator->CanGeneratePoseDeferred();
+  }
+
+  {
+    WD_PROFILE_SCOPE("GeneratePosesInParallel");
+
+    wdParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 4;
+    parallelForParams.m_uiMaxTasksPerThread = 4;
+
+    wdTaskSystem::ParallelForIndexed(
+      0, uiNumPoses,
+      [this](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+        for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          QueuedPose& queuedPose = m_QueuedPoses[i];
+          if (queuedPose.m_bDeferred)
+          {
+            queuedPose.m_Pose = queuedPose.m_pPoseGenerator->GeneratePoseDeferred();
+          }
+        }
+      },
+      "GenerateAnimationPoses", parallelForParams);
+  }
+
+  for (wdUInt32 i = 0; i < uiNumPoses; ++i)
+  {
+    // don't hold a reference into the queue, sending messages may queue more generators
+    QueuedPose queuedPose = m_QueuedPoses[i];
+    if (queuedPose.m_pPoseGenerator == nullptr)
+      continue;
+
+    queuedPose.m_pPoseGenerator->m_pQueuedInModule = nullptr;
+
+    wdGameObject* pTarget = nullptr;
+    if (!m_pWorld->TryGetObject(queuedPose.m_hTarget, pTarget))
+      continue;
+
+    if (!queuedPose.m_bGeneratePose)
+    {
+      // a frame that was skipped due to LOD, only the interpolated pose is sent
+      queuedPose.m_Pose = queuedPose.m_pLodState->GetInterpolatedPose();
+    }
+    else
+    {
+      if (queuedPose.m_bDeferred)
+      {
+        queuedPose.m_pPoseGenerator->SendDeferredAnimationEvents(pTarget);
+      }
+      else
+      {
+        queuedPose.m_Pose = queuedPose.m_pPoseGenerator->GeneratePose(pTarget);
+      }
+
+      if (queuedPose.m_pLodState != nullptr)
+      {
+        queuedPose.m_Pose = queuedPose.m_pLodState->AddGeneratedPose(queuedPose.m_Pose);
+      }
+    }
+
+    if (queuedPose.m_Pose.IsEmpty())
+      continue;
+
+    wdResourceLock<wdSkeletonResource> pSkeleton(queuedPose.m_hSkeleton, wdResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pSkeleton.GetAcquireResult() != wdResourceAcquireResult::Final)
+      continue;
+
+    wdMsgAnimationPoseUpdated msg;
+    msg.m_pRootTransform = &pSkeleton->GetDescriptor().m_RootTransform;
+    msg.m_pSkeleton = &pSkeleton->GetDescriptor().m_Skeleton;
+    msg.m_ModelTransforms = queuedPose.m_Pose;
+
+    pTarget->SendMessageRecursive(msg);
+  }
+
+  m_QueuedPoses.RemoveAtAndCopy(0, uiNumPoses);
+
+  for (wdUInt32 i = 0; i < m_QueuedPoses.GetCount(); ++i)
+  {
+    if (m_QueuedPoses[i].m_pPoseGenerator != nullptr)
+    {
+      m_QueuedPoses[i].m_pPoseGenerator->m_uiQueueIndex = i;
+    }
+  }
+}
+
+void wdAnimPoseGeneratorWorldModule::SetLodReferencePosition(const wdVec3& vPosition)
+{
+  m_vLodReferencePosition = vPosition;
+  m_bHasLodReferencePosition = true;
+  m_bLodReferencePositionOverridden = true;
+}
+
+void wdAnimPoseGeneratorWorldModule::ClearLodReferencePosition()
+{
+  m_bHasLodReferencePosition = false;
+  m_bLodReferencePositionOverridden = false;
+}
+
+bool wdAnimPoseGeneratorWorldModule::GetLodReferencePosition(wdVec3& out_vPosition) const
+{
+  out_vPosition = m_vLodReferencePosition;
+  return m_bHasLodReferencePosition;
+}
+
+void wdAnimPoseGeneratorWorldModule::UpdatePoses(const wdWorldModule::UpdateContext& context)
+{
+  GenerateQueuedPoses();
+}
+
+void wdAnimPoseGeneratorWorldModule::UpdateLodReferencePosition(const wdWorldModule::UpdateContext& context)
+{
+  if (m_bLodReferencePositionOverridden)
+    return;
+
+  m_bHasLodReferencePosition = false;
+
+  if (const wdView* pView = wdRenderWorld::GetViewByUsageHint(wdCameraUsageHint::MainView, wdCameraUsageHint::EditorView, GetWorld()))
+  {
+    if (const wdCamera* pLodCamera = pView->GetLodCamera())
+    {
+      m_vLodReferencePosition = pLodCamera->GetCenterPosition();
+      m_bHasLodReferencePosition = true;
+    }
+  }
+}
+
+
+WD_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_AnimPoseGeneratorWorldModule);
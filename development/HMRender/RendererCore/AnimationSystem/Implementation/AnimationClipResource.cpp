@@ -1,6 +1,7 @@
 #include <RendererCore/RendererCorePCH.h>
 
 #include <Core/Assets/AssetFileHeader.h>
+#include <Foundation/Threading/Mutex.h>
 #include <RendererCore/AnimationSystem/AnimationClipResource.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <RendererCore/AnimationSystem/Skeleton.h>
@@ -103,6 +104,8 @@ struct wdAnimationClipResourceDescriptor::OzzImpl
     ozz::unique_ptr<ozz::animation::Animation> m_pAnim;
   };
 
+  // the mapped animations are created on demand, potentially by multiple threads at the same time
+  wdMutex m_MappedOzzAnimationsMutex;
   wdMap<const wdSkeletonResource*, CachedAnim> m_MappedOzzAnimations;
 };
 
@@ -258,6 +261,8 @@ WD_FORCE_INLINE void wd2ozz(const wdQuat& qIn, ozz::math::Quaternion& ref_out)
 
 const ozz::animation::Animation& wdAnimationClipResourceDescriptor::GetMappedOzzAnimation(const wdSkeletonResource& skeleton) const
 {
+  WD_LOCK(m_pOzzImpl->m_MappedOzzAnimationsMutex);
+
   auto it = m_pOzzImpl->m_MappedOzzAnimations.Find(&skeleton);
   if (it.IsValid())
   {
@@ -0,0 +1,241 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <Core/World/GameObject.h>
+#include <Core/World/SpatialData.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+
+// clang-format off
+WD_BEGIN_STATIC_REFLECTED_TYPE(wdAnimationLodLevel, wdNoBase, 1, wdRTTIDefaultAllocator<wdAnimationLodLevel>)
+{
+  WD_BEGIN_PROPERTIES
+  {
+    WD_MEMBER_PROPERTY("MaxDistance", m_fMaxDistance)->AddAttributes(new wdDefaultValueAttribute(wdMath::HighValue<float>()), new wdClampValueAttribute(0.0f, wdVariant())),
+    WD_MEMBER_PROPERTY("UpdateInterval", m_uiUpdateInterval)->AddAttributes(new wdDefaultValueAttribute(1), new wdClampValueAttribute(1, 255)),
+  }
+  WD_END_PROPERTIES;
+}
+WD_END_STATIC_REFLECTED_TYPE;
+
+WD_BEGIN_STATIC_REFLECTED_TYPE(wdAnimationLodSettings, wdNoBase, 1, wdRTTIDefaultAllocator<wdAnimationLodSettings>)
+{
+  WD_BEGIN_PROPERTIES
+  {
+    WD_ARRAY_MEMBER_PROPERTY("Levels", m_Levels),
+    WD_MEMBER_PROPERTY("InvisibleUpdateInterval", m_uiInvisibleUpdateInterval)->AddAttributes(new wdDefaultValueAttribute(1), new wdClampValueAttribute(1, 255)),
+    WD_MEMBER_PROPERTY("NumFramesBeforeInvisible", m_uiNumFramesBeforeInvisible)->AddAttributes(new wdDefaultValueAttribute(5)),
+    WD_MEMBER_PROPERTY("SkipPoseWhenInvisible", m_bSkipPoseWhenInvisible),
+    WD_MEMBER_PROPERTY("InterpolatePoses", m_bInterpolatePoses)->AddAttributes(new wdDefaultValueAttribute(true)),
+  }
+  WD_END_PROPERTIES;
+}
+WD_END_STATIC_REFLECTED_TYPE;
+// clang-format on
+
+static wdTypeVersion s_AnimationLodSettingsVersion = 1;
+wdResult wdAnimationLodSettings::Serialize(wdStreamWriter& inout_stream) const
+{
+  inout_stream.WriteVersion(s_AnimationLodSettingsVersion);
+
+  inout_stream << m_Levels.GetCount();
+  for (const auto& level : m_Levels)
+  {
+    inout_stream << level.m_fMaxDistance;
+    inout_stream << level.m_uiUpdateInterval;
+  }
+
+  inout_stream << m_uiInvisibleUpdateInterval;
+  inout_stream << m_uiNumFramesBeforeInvisible;
+  inout_stream << m_bSkipPoseWhenInvisible;
+  inout_stream << m_bInterpolatePoses;
+
+  return WD_SUCCESS;
+}
+
+wdResult wdAnimationLodSettings::Deserialize(wdStreamReader& inout_stream)
+{
+  const wdTypeVersion version = inout_stream.ReadVersion(s_AnimationLodSettingsVersion);
+
+  wdUInt32 uiNumLevels = 0;
+  inout_stream >> uiNumLevels;
+  m_Levels.SetCount(uiNumLevels);
+  for (auto& level : m_Levels)
+  {
+    inout_stream >> level.m_fMaxDistance;
+    inout_stream >> level.m_uiUpdateInterval;
+  }
+
+  inout_stream >> m_uiInvisibleUpdateInterval;
+  inout_stream >> m_uiNumFramesBeforeInvisible;
+  inout_stream >> m_bSkipPoseWhenInvisible;
+  inout_stream >> m_bInterpolatePoses;
+
+  return WD_SUCCESS;
+}
+
+namespace
+{
+  // a skeleton only switches back to a finer level once it is this much closer than the level's maximum distance,
+  // so that it doesn't flicker between two levels when it moves along the boundary
+  constexpr float s_fAnimationLodHysteresis = 0.9f;
+} // namespace
+
+wdAnimationLodState::wdAnimationLodState() = default;
+wdAnimationLodState::~wdAnimationLodState() = default;
+
+bool wdAnimationLodState::Update(const wdAnimationLodSettings& settings, wdTime diff, const wdGameObject* pTarget, const wdVec3* pLodReferencePosition)
+{
+  m_AccumulatedTime += diff;
+  ++m_uiFramesSinceUpdate;
+
+  bool bVisible = true;
+  if (settings.m_uiInvisibleUpdateInterval > 1 || settings.m_bSkipPoseWhenInvisible)
+  {
+    bVisible = pTarget->GetVisibilityState(settings.m_uiNumFramesBeforeInvisible) != wdVisibilityState::Invisible;
+  }
+
+  wdUInt8 uiUpdateInterval = 1;
+  if (!bVisible)
+  {
+    uiUpdateInterval = settings.m_uiInvisibleUpdateInterval;
+  }
+  else if (!settings.m_Levels.IsEmpty() && pLodReferencePosition != nullptr)
+  {
+    const float fDistance = (pTarget->GetGlobalPosition() - *pLodReferencePosition).GetLength();
+
+    m_uiCurrentLevel = SelectLevel(settings, fDistance);
+    uiUpdateInterval = settings.m_Levels[m_uiCurrentLevel].m_uiUpdateInterval;
+  }
+
+  uiUpdateInterval = wdMath::Max<wdUInt8>(uiUpdateInterval, 1);
+
+  const bool bGeneratePose = bVisible || !settings.m_bSkipPoseWhenInvisible;
+
+  // a skeleton that becomes visible again must not show its outdated pose
+  const bool bForceUpdate = !m_bInitialized || (bGeneratePose && !m_bGeneratePose);
+
+  if (!bForceUpdate && m_uiFramesSinceUpdate < uiUpdateInterval)
+    return false;
+
+  if (!m_bInitialized)
+  {
+    m_bInitialized = true;
+
+    // spread the updates of skeletons that were created in the same frame over the update interval
+    m_uiFramesSinceUpdate = pTarget->GetHandle().GetInternalID().m_InstanceIndex % uiUpdateInterval;
+  }
+  else
+  {
+    m_uiFramesSinceUpdate = 0;
+  }
+
+  if (bGeneratePose && !m_bGeneratePose)
+  {
+    m_bSnapToNextPose = true;
+  }
+
+  m_StepTime = m_AccumulatedTime;
+  m_AccumulatedTime.SetZero();
+  m_uiUpdateInterval = uiUpdateInterval;
+  m_bGeneratePose = bGeneratePose;
+  m_bInterpolate = settings.m_bInterpolatePoses && uiUpdateInterval > 1;
+
+  if (!m_bGeneratePose)
+  {
+    m_uiInterpolationSteps = 0;
+  }
+
+  return true;
+}
+
+wdArrayPtr<const wdMat4> wdAnimationLodState::AddGeneratedPose(wdArrayPtr<const wdMat4> pose)
+{
+  const bool bCanInterpolate = m_bInterpolate && !m_bSnapToNextPose && m_DisplayedPose.GetCount() == pose.GetCount();
+  m_bSnapToNextPose = false;
+
+  if (!bCanInterpolate)
+  {
+    m_uiInterpolationStep = 0;
+    m_uiInterpolationSteps = 0;
+
+    if (!m_bInterpolate)
+    {
+      // the pose is updated every frame, no need to keep a copy
+      m_DisplayedPose.Clear();
+      return pose;
+    }
+
+    m_DisplayedPose = pose;
+    return m_DisplayedPose;
+  }
+
+  m_StartPose = m_DisplayedPose;
+  m_TargetPose = pose;
+  m_uiInterpolationStep = 0;
+  m_uiInterpolationSteps = m_uiUpdateInterval;
+
+  return GetInterpolatedPose();
+}
+
+wdArrayPtr<const wdMat4> wdAnimationLodState::GetInterpolatedPose()
+{
+  if (m_uiInterpolationStep >= m_uiInterpolationSteps)
+    return {};
+
+  ++m_uiInterpolationStep;
+
+  const float fLerp = (float)m_uiInterpolationStep / (float)m_uiInterpolationSteps;
+
+  // blending the matrices directly slightly shrinks rotating bones, which is not noticeable for the small steps between two updates
+  for (wdUInt32 i = 0; i < m_DisplayedPose.GetCount(); ++i)
+  {
+    const float* pStart = m_StartPose[i].m_fElementsCM;
+    const float* pTarget = m_TargetPose[i].m_fElementsCM;
+    float* pResult = m_DisplayedPose[i].m_fElementsCM;
+
+    for (wdUInt32 e = 0; e < 16; ++e)
+    {
+      pResult[e] = wdMath::Lerp(pStart[e], pTarget[e], fLerp);
+    }
+  }
+
+  return m_DisplayedPose;
+}
+
+void wdAnimationLodState::Reset()
+{
+  m_AccumulatedTime.SetZero();
+  m_StepTime.SetZero();
+  m_uiFramesSinceUpdate = 0;
+  m_uiCurrentLevel = 0;
+  m_uiUpdateInterval = 1;
+  m_bInitialized = false;
+  m_bGeneratePose = true;
+  m_bInterpolate = false;
+  m_bSnapToNextPose = true;
+  m_uiInterpolationStep = 0;
+  m_uiInterpolationSteps = 0;
+  m_StartPose.Clear();
+  m_TargetPose.Clear();
+  m_DisplayedPose.Clear();
+}
+
+wdUInt32 wdAnimationLodState::SelectLevel(const wdAnimationLodSettings& settings, float fDistance) const
+{
+  const wdUInt32 uiNumLevels = settings.m_Levels.GetCount();
+  wdUInt32 uiLevel = wdMath::Min(m_uiCurrentLevel, uiNumLevels - 1);
+
+  while (uiLevel + 1 < uiNumLevels && fDistance > settings.m_Levels[uiLevel].m_fMaxDistance)
+  {
+    ++uiLevel;
+  }
+
+  while (uiLevel > 0 && fDistance < settings.m_Levels[uiLevel - 1].m_fMaxDistance * s_fAnimationLodHysteresis)
+  {
+    --uiLevel;
+  }
+
+  return uiLevel;
+}
+
+
+WD_STATICLINK_FILE(RendererCore, RendererCore_AnimationSystem_Implementation_AnimationLod);
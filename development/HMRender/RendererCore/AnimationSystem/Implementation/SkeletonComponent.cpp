@@ -2,6 +2,7 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <RendererCore/AnimationSystem/AnimPoseGeneratorWorldModule.h>
 #include <RendererCore/AnimationSystem/AnimationPose.h>
 #include <RendererCore/AnimationSystem/SkeletonComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
@@ -150,6 +151,14 @@ void wdSkeletonComponent::OnActivated()
   VisualizeSkeletonDefaultState();
 }
 
+void wdSkeletonComponent::OnSimulationStarted()
+{
+  SUPER::OnSimulationStarted();
+
+  // the animation graphs that drive this skeleton queue their poses in this module, so make sure it exists in every animated world
+  GetWorld()->GetOrCreateModule<wdAnimPoseGeneratorWorldModule>();
+}
+
 void wdSkeletonComponent::SetSkeletonFile(const char* szFile)
 {
   wdSkeletonResourceHandle hResource;
@@ -22,6 +22,7 @@ public:
 
 protected:
   virtual void OnActivated() override;
+  virtual void OnSimulationStarted() override;
 
 
   //////////////////////////////////////////////////////////////////////////
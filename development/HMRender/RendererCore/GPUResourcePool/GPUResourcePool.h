@@ -1,18 +1,36 @@
 #pragma once
 
-#include <Foundation/Containers/Map.h>
 #include <Foundation/Containers/Set.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Mutex.h>
+#include <RendererCore/GPUResourcePool/PooledResourceBuckets.h>
 #include <RendererCore/RendererCoreDLL.h>
 #include <RendererFoundation/Resources/ResourceFormats.h>
 
 struct wdGALDeviceEvent;
 
 /// \brief This class serves as a pool for GPU related resources (e.g. buffers and textures required for rendering).
-/// Note that the functions creating and returning render targets are thread safe (by using a mutex).
+///
+/// Available resources are kept in lock-free free lists, bucketed by the hash of their creation description, so getting and returning
+/// resources is thread safe and doesn't block other threads. Unused resources are garbage collected incrementally, a few buckets per frame.
 class WD_RENDERERCORE_DLL wdGPUResourcePool
 {
 public:
+  /// \brief Statistics about how well the pool is used, e.g. for memory budgets.
+  struct Stats
+  {
+    wdUInt64 m_uiNumHits = 0;        ///< How many requests were served by a pooled resource.
+    wdUInt64 m_uiNumMisses = 0;      ///< How many requests required creating a new resource.
+    wdUInt64 m_uiNumEvictions = 0;   ///< How many pooled resources were destroyed by the GC or because the pool was full.
+    wdUInt64 m_uiBytesAllocated = 0; ///< The memory of all resources that were created by the pool and not destroyed yet, whether they are in use or not.
+    wdUInt64 m_uiBytesPooled = 0;    ///< The memory of all resources that are currently available in the pool.
+    wdUInt32 m_uiNumPooled = 0;      ///< How many resources are currently available in the pool.
+    wdUInt32 m_uiNumInUse = 0;       ///< How many resources are currently handed out by the pool.
+
+    /// \brief Returns the fraction of requests that were served by a pooled resource.
+    float GetHitRate() const { return (m_uiNumHits + m_uiNumMisses) > 0 ? float(double(m_uiNumHits) / double(m_uiNumHits + m_uiNumMisses)) : 0.0f; }
+  };
+
   wdGPUResourcePool();
   ~wdGPUResourcePool();
 
@@ -42,42 +60,43 @@ public:
   /// \param uiMinimumAge How many frames at least the resource needs to have been unused before it will be GCed.
   void RunGC(wdUInt32 uiMinimumAge);
 
+  /// \brief Returns the current statistics of the pool.
+  Stats GetStats() const;
+
 
   static wdGPUResourcePool* GetDefaultInstance();
   static void SetDefaultInstance(wdGPUResourcePool* pDefaultInstance);
 
 protected:
   void CheckAndPotentiallyRunGC();
+  wdUInt32 EvictResources(wdUInt32 uiMinimumAge, wdUInt32 uiFirstBucket, wdUInt32 uiNumBuckets);
   void UpdateMemoryStats() const;
   void GALDeviceEventHandler(const wdGALDeviceEvent& e);
 
-  struct TextureHandleWithAge
-  {
-    wdGALTextureHandle m_hTexture;
-    wdUInt64 m_uiLastUsed = 0;
-  };
-
-  struct BufferHandleWithAge
-  {
-    wdGALBufferHandle m_hBuffer;
-    wdUInt64 m_uiLastUsed = 0;
-  };
-
   wdEventSubscriptionID m_GALDeviceEventSubscriptionID = 0;
   wdUInt64 m_uiMemoryThresholdForGC = 256 * 1024 * 1024;
-  wdUInt64 m_uiCurrentlyAllocatedMemory = 0;
+  wdAtomicInteger64 m_iCurrentlyAllocatedMemory;
   wdUInt16 m_uiNumAllocationsThresholdForGC = 128;
-  wdUInt16 m_uiNumAllocationsSinceLastGC = 0;
-  wdUInt16 m_uiFramesThresholdSinceLastGC = 60; ///< Every 60 frames resources unused for more than 10 frames in a row are GCed.
-  wdUInt16 m_uiFramesSinceLastGC = 0;
+  wdAtomicInteger32 m_iNumAllocationsSinceLastGC;
+  wdUInt16 m_uiFramesThresholdSinceLastGC = 60; ///< All buckets are checked once within 60 frames, resources unused for more than 10 frames are GCed.
+  wdUInt32 m_uiNextBucketToGC = 0;
 
-  wdMap<wdUInt32, wdDynamicArray<TextureHandleWithAge>> m_AvailableTextures;
-  wdSet<wdGALTextureHandle> m_TexturesInUse;
+  wdPooledResourceBuckets<wdGALTextureHandle> m_AvailableTextures;
+  wdPooledResourceBuckets<wdGALBufferHandle> m_AvailableBuffers;
 
-  wdMap<wdUInt32, wdDynamicArray<BufferHandleWithAge>> m_AvailableBuffers;
-  wdSet<wdGALBufferHandle> m_BuffersInUse;
+  wdAtomicInteger32 m_iNumTexturesInUse;
+  wdAtomicInteger32 m_iNumBuffersInUse;
 
-  wdMutex m_Lock;
+  wdAtomicInteger64 m_iNumHits;
+  wdAtomicInteger64 m_iNumMisses;
+  wdAtomicInteger64 m_iNumEvictions;
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  // only used to validate that returned resources came from this pool
+  wdSet<wdGALTextureHandle> m_TexturesInUse;
+  wdSet<wdGALBufferHandle> m_BuffersInUse;
+  wdMutex m_InUseLock;
+#endif
 
   wdGALDevice* m_pDevice;
 
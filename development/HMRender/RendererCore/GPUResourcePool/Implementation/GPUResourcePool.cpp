@@ -13,7 +13,17 @@
 
 wdGPUResourcePool* wdGPUResourcePool::s_pDefaultInstance = nullptr;
 
+namespace
+{
+  // the number of distinct descriptions is usually small, but each of them may be pooled many times (e.g. one per view)
+  // the GC releases the buckets of descriptions that have nothing pooled anymore, so this only limits how many are pooled at the same time
+  constexpr wdUInt32 s_uiNumBuckets = 256;
+  constexpr wdUInt32 s_uiMaxPooledResources = 4096;
+} // namespace
+
 wdGPUResourcePool::wdGPUResourcePool()
+  : m_AvailableTextures(s_uiNumBuckets, s_uiMaxPooledResources)
+  , m_AvailableBuffers(s_uiNumBuckets, s_uiMaxPooledResources)
 {
   m_pDevice = wdGALDevice::GetDefaultDevice();
 
@@ -23,7 +33,7 @@ wdGPUResourcePool::wdGPUResourcePool()
 wdGPUResourcePool::~wdGPUResourcePool()
 {
   m_pDevice->m_Events.RemoveEventHandler(m_GALDeviceEventSubscriptionID);
-  if (!m_TexturesInUse.IsEmpty())
+  if (m_iNumTexturesInUse > 0)
   {
     wdLog::SeriousWarning("Destructing a GPU resource pool of which textures are still in use!");
   }
@@ -34,8 +44,6 @@ wdGPUResourcePool::~wdGPUResourcePool()
 
 wdGALTextureHandle wdGPUResourcePool::GetRenderTarget(const wdGALTextureCreationDescription& textureDesc)
 {
-  WD_LOCK(m_Lock);
-
   if (!textureDesc.m_bCreateRenderTarget)
   {
     wdLog::Error("Texture description for render target usage has not set bCreateRenderTarget!");
@@ -45,23 +53,24 @@ wdGALTextureHandle wdGPUResourcePool::GetRenderTarget(const wdGALTextureCreation
   const wdUInt32 uiTextureDescHash = textureDesc.CalculateHash();
 
   // Check if there is a fitting texture available
-  auto it = m_AvailableTextures.Find(uiTextureDescHash);
-  if (it.IsValid())
+  wdGALTextureHandle hTexture;
+  if (m_AvailableTextures.Pop(uiTextureDescHash, hTexture))
   {
-    wdDynamicArray<TextureHandleWithAge>& textures = it.Value();
-    if (!textures.IsEmpty())
-    {
-      wdGALTextureHandle hTexture = textures.PeekBack().m_hTexture;
-      textures.PopBack();
+    WD_ASSERT_DEV(m_pDevice->GetTexture(hTexture) != nullptr, "Invalid texture in resource pool");
 
-      WD_ASSERT_DEV(m_pDevice->GetTexture(hTexture) != nullptr, "Invalid texture in resource pool");
+    m_iNumHits.Increment();
+    m_iNumTexturesInUse.Increment();
 
-      m_TexturesInUse.Insert(hTexture);
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+    WD_LOCK(m_InUseLock);
+    m_TexturesInUse.Insert(hTexture);
+#endif
 
-      return hTexture;
-    }
+    return hTexture;
   }
 
+  m_iNumMisses.Increment();
+
   // Since we found no matching texture we need to create a new one, but we check if we should run a GC
   // first since we need to allocate memory now
   CheckAndPotentiallyRunGC();
@@ -76,10 +85,17 @@ wdGALTextureHandle wdGPUResourcePool::GetRenderTarget(const wdGALTextureCreation
   }
 
   // Also track the new created texture
-  m_TexturesInUse.Insert(hNewTexture);
+  m_iNumTexturesInUse.Increment();
 
-  m_uiNumAllocationsSinceLastGC++;
-  m_uiCurrentlyAllocatedMemory += m_pDevice->GetMemoryConsumptionForTexture(textureDesc);
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  {
+    WD_LOCK(m_InUseLock);
+    m_TexturesInUse.Insert(hNewTexture);
+  }
+#endif
+
+  m_iNumAllocationsSinceLastGC.Increment();
+  m_iCurrentlyAllocatedMemory.Add(static_cast<wdInt64>(m_pDevice->GetMemoryConsumptionForTexture(textureDesc)));
 
   UpdateMemoryStats();
 
@@ -104,59 +120,59 @@ wdGALTextureHandle wdGPUResourcePool::GetRenderTarget(
 
 void wdGPUResourcePool::ReturnRenderTarget(wdGALTextureHandle hRenderTarget)
 {
-  WD_LOCK(m_Lock);
-
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-
-  // First check if this texture actually came from the pool
-  if (!m_TexturesInUse.Contains(hRenderTarget))
   {
-    wdLog::Error("Returning a texture to the GPU resource pool which wasn't created by the pool is not valid!");
-    return;
-  }
+    WD_LOCK(m_InUseLock);
 
+    // First check if this texture actually came from the pool
+    if (!m_TexturesInUse.Remove(hRenderTarget))
+    {
+      wdLog::Error("Returning a texture to the GPU resource pool which wasn't created by the pool is not valid!");
+      return;
+    }
+  }
 #endif
 
-  m_TexturesInUse.Remove(hRenderTarget);
+  m_iNumTexturesInUse.Decrement();
 
   if (const wdGALTexture* pTexture = m_pDevice->GetTexture(hRenderTarget))
   {
-    const wdUInt32 uiTextureDescHash = pTexture->GetDescription().CalculateHash();
+    const wdGALTextureCreationDescription& desc = pTexture->GetDescription();
+    const wdUInt64 uiMemory = m_pDevice->GetMemoryConsumptionForTexture(desc);
 
-    auto it = m_AvailableTextures.Find(uiTextureDescHash);
-    if (!it.IsValid())
+    if (!m_AvailableTextures.Push(desc.CalculateHash(), hRenderTarget, uiMemory, wdRenderWorld::GetFrameCounter()))
     {
-      it = m_AvailableTextures.Insert(uiTextureDescHash, wdDynamicArray<TextureHandleWithAge>());
+      // the pool is full, don't keep the texture around
+      m_pDevice->DestroyTexture(hRenderTarget);
+      m_iCurrentlyAllocatedMemory.Subtract(static_cast<wdInt64>(uiMemory));
+      m_iNumEvictions.Increment();
     }
-
-    it.Value().PushBack({hRenderTarget, wdRenderWorld::GetFrameCounter()});
   }
 }
 
 wdGALBufferHandle wdGPUResourcePool::GetBuffer(const wdGALBufferCreationDescription& bufferDesc)
 {
-  WD_LOCK(m_Lock);
-
   const wdUInt32 uiBufferDescHash = bufferDesc.CalculateHash();
 
   // Check if there is a fitting buffer available
-  auto it = m_AvailableBuffers.Find(uiBufferDescHash);
-  if (it.IsValid())
+  wdGALBufferHandle hBuffer;
+  if (m_AvailableBuffers.Pop(uiBufferDescHash, hBuffer))
   {
-    wdDynamicArray<BufferHandleWithAge>& buffers = it.Value();
-    if (!buffers.IsEmpty())
-    {
-      wdGALBufferHandle hBuffer = buffers.PeekBack().m_hBuffer;
-      buffers.PopBack();
+    WD_ASSERT_DEV(m_pDevice->GetBuffer(hBuffer) != nullptr, "Invalid buffer in resource pool");
 
-      WD_ASSERT_DEV(m_pDevice->GetBuffer(hBuffer) != nullptr, "Invalid buffer in resource pool");
+    m_iNumHits.Increment();
+    m_iNumBuffersInUse.Increment();
 
-      m_BuffersInUse.Insert(hBuffer);
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+    WD_LOCK(m_InUseLock);
+    m_BuffersInUse.Insert(hBuffer);
+#endif
 
-      return hBuffer;
-    }
+    return hBuffer;
   }
 
+  m_iNumMisses.Increment();
+
   // Since we found no matching buffer we need to create a new one, but we check if we should run a GC
   // first since we need to allocate memory now
   CheckAndPotentiallyRunGC();
@@ -170,10 +186,17 @@ wdGALBufferHandle wdGPUResourcePool::GetBuffer(const wdGALBufferCreationDescript
   }
 
   // Also track the new created buffer
-  m_BuffersInUse.Insert(hNewBuffer);
+  m_iNumBuffersInUse.Increment();
+
+#if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
+  {
+    WD_LOCK(m_InUseLock);
+    m_BuffersInUse.Insert(hNewBuffer);
+  }
+#endif
 
-  m_uiNumAllocationsSinceLastGC++;
-  m_uiCurrentlyAllocatedMemory += m_pDevice->GetMemoryConsumptionForBuffer(bufferDesc);
+  m_iNumAllocationsSinceLastGC.Increment();
+  m_iCurrentlyAllocatedMemory.Add(static_cast<wdInt64>(m_pDevice->GetMemoryConsumptionForBuffer(bufferDesc)));
 
   UpdateMemoryStats();
 
@@ -182,121 +205,78 @@ wdGALBufferHandle wdGPUResourcePool::GetBuffer(const wdGALBufferCreationDescript
 
 void wdGPUResourcePool::ReturnBuffer(wdGALBufferHandle hBuffer)
 {
-  WD_LOCK(m_Lock);
-
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-
-  // First check if this texture actually came from the pool
-  if (!m_BuffersInUse.Contains(hBuffer))
   {
-    wdLog::Error("Returning a buffer to the GPU resource pool which wasn't created by the pool is not valid!");
-    return;
-  }
+    WD_LOCK(m_InUseLock);
 
+    // First check if this buffer actually came from the pool
+    if (!m_BuffersInUse.Remove(hBuffer))
+    {
+      wdLog::Error("Returning a buffer to the GPU resource pool which wasn't created by the pool is not valid!");
+      return;
+    }
+  }
 #endif
 
-  m_BuffersInUse.Remove(hBuffer);
+  m_iNumBuffersInUse.Decrement();
 
   if (const wdGALBuffer* pBuffer = m_pDevice->GetBuffer(hBuffer))
   {
-    const wdUInt32 uiBufferDescHash = pBuffer->GetDescription().CalculateHash();
+    const wdGALBufferCreationDescription& desc = pBuffer->GetDescription();
+    const wdUInt64 uiMemory = m_pDevice->GetMemoryConsumptionForBuffer(desc);
 
-    auto it = m_AvailableBuffers.Find(uiBufferDescHash);
-    if (!it.IsValid())
+    if (!m_AvailableBuffers.Push(desc.CalculateHash(), hBuffer, uiMemory, wdRenderWorld::GetFrameCounter()))
     {
-      it = m_AvailableBuffers.Insert(uiBufferDescHash, wdDynamicArray<BufferHandleWithAge>());
+      // the pool is full, don't keep the buffer around
+      m_pDevice->DestroyBuffer(hBuffer);
+      m_iCurrentlyAllocatedMemory.Subtract(static_cast<wdInt64>(uiMemory));
+      m_iNumEvictions.Increment();
     }
-
-    it.Value().PushBack({hBuffer, wdRenderWorld::GetFrameCounter()});
   }
 }
 
 void wdGPUResourcePool::RunGC(wdUInt32 uiMinimumAge)
 {
-  WD_LOCK(m_Lock);
-
   WD_PROFILE_SCOPE("RunGC");
-  wdUInt64 uiCurrentFrame = wdRenderWorld::GetFrameCounter();
-  // Destroy all available textures older than uiMinimumAge frames
-  {
-    for (auto it = m_AvailableTextures.GetIterator(); it.IsValid();)
-    {
-      auto& textures = it.Value();
-      for (wdInt32 i = (wdInt32)textures.GetCount() - 1; i >= 0; i--)
-      {
-        TextureHandleWithAge& texture = textures[i];
-        if (texture.m_uiLastUsed + uiMinimumAge <= uiCurrentFrame)
-        {
-          if (const wdGALTexture* pTexture = m_pDevice->GetTexture(texture.m_hTexture))
-          {
-            m_uiCurrentlyAllocatedMemory -= m_pDevice->GetMemoryConsumptionForTexture(pTexture->GetDescription());
-          }
-
-          m_pDevice->DestroyTexture(texture.m_hTexture);
-          textures.RemoveAtAndCopy(i);
-        }
-        else
-        {
-          // The available textures are used as a stack. Thus they are ordered by last used.
-          break;
-        }
-      }
-      if (textures.IsEmpty())
-      {
-        auto itCopy = it;
-        ++it;
-        m_AvailableTextures.Remove(itCopy);
-      }
-      else
-      {
-        ++it;
-      }
-    }
-  }
 
-  // Destroy all available buffers older than uiMinimumAge frames
-  {
-    for (auto it = m_AvailableBuffers.GetIterator(); it.IsValid();)
-    {
-      auto& buffers = it.Value();
-      for (wdInt32 i = (wdInt32)buffers.GetCount() - 1; i >= 0; i--)
-      {
-        BufferHandleWithAge& buffer = buffers[i];
-        if (buffer.m_uiLastUsed + uiMinimumAge <= uiCurrentFrame)
-        {
-          if (const wdGALBuffer* pBuffer = m_pDevice->GetBuffer(buffer.m_hBuffer))
-          {
-            m_uiCurrentlyAllocatedMemory -= m_pDevice->GetMemoryConsumptionForBuffer(pBuffer->GetDescription());
-          }
-
-          m_pDevice->DestroyBuffer(buffer.m_hBuffer);
-          buffers.RemoveAtAndCopy(i);
-        }
-        else
-        {
-          // The available buffers are used as a stack. Thus they are ordered by last used.
-          break;
-        }
-      }
-      if (buffers.IsEmpty())
-      {
-        auto itCopy = it;
-        ++it;
-        m_AvailableBuffers.Remove(itCopy);
-      }
-      else
-      {
-        ++it;
-      }
-    }
-  }
+  // Destroy all available textures and buffers older than uiMinimumAge frames
+  EvictResources(uiMinimumAge, 0, m_AvailableTextures.GetNumBuckets());
 
-  m_uiNumAllocationsSinceLastGC = 0;
+  m_iNumAllocationsSinceLastGC = 0;
 
   UpdateMemoryStats();
 }
 
+wdUInt32 wdGPUResourcePool::EvictResources(wdUInt32 uiMinimumAge, wdUInt32 uiFirstBucket, wdUInt32 uiNumBuckets)
+{
+  const wdUInt64 uiCurrentFrame = wdRenderWorld::GetFrameCounter();
+
+  wdUInt32 uiNumEvicted = m_AvailableTextures.Evict(uiCurrentFrame, uiMinimumAge, uiFirstBucket, uiNumBuckets, [this](wdGALTextureHandle hTexture, wdUInt64 uiMemory) {
+    m_pDevice->DestroyTexture(hTexture);
+    m_iCurrentlyAllocatedMemory.Subtract(static_cast<wdInt64>(uiMemory));
+  });
+
+  uiNumEvicted += m_AvailableBuffers.Evict(uiCurrentFrame, uiMinimumAge, uiFirstBucket, uiNumBuckets, [this](wdGALBufferHandle hBuffer, wdUInt64 uiMemory) {
+    m_pDevice->DestroyBuffer(hBuffer);
+    m_iCurrentlyAllocatedMemory.Subtract(static_cast<wdInt64>(uiMemory));
+  });
 
+  m_iNumEvictions.Add(uiNumEvicted);
+  return uiNumEvicted;
+}
+
+wdGPUResourcePool::Stats wdGPUResourcePool::GetStats() const
+{
+  Stats stats;
+  stats.m_uiNumHits = static_cast<wdUInt64>(m_iNumHits);
+  stats.m_uiNumMisses = static_cast<wdUInt64>(m_iNumMisses);
+  stats.m_uiNumEvictions = static_cast<wdUInt64>(m_iNumEvictions);
+  stats.m_uiBytesAllocated = static_cast<wdUInt64>(m_iCurrentlyAllocatedMemory);
+  stats.m_uiBytesPooled = m_AvailableTextures.GetMemory() + m_AvailableBuffers.GetMemory();
+  stats.m_uiNumPooled = m_AvailableTextures.GetCount() + m_AvailableBuffers.GetCount();
+  stats.m_uiNumInUse = static_cast<wdUInt32>(m_iNumTexturesInUse + m_iNumBuffersInUse);
+  return stats;
+}
 
 wdGPUResourcePool* wdGPUResourcePool::GetDefaultInstance()
 {
@@ -312,7 +292,7 @@ void wdGPUResourcePool::SetDefaultInstance(wdGPUResourcePool* pDefaultInstance)
 
 void wdGPUResourcePool::CheckAndPotentiallyRunGC()
 {
-  if ((m_uiNumAllocationsSinceLastGC >= m_uiNumAllocationsThresholdForGC) || (m_uiCurrentlyAllocatedMemory >= m_uiMemoryThresholdForGC))
+  if ((m_iNumAllocationsSinceLastGC >= m_uiNumAllocationsThresholdForGC) || (static_cast<wdUInt64>(m_iCurrentlyAllocatedMemory) >= m_uiMemoryThresholdForGC))
   {
     // Only try to collect resources unused for 3 or more frames. Using a smaller number will result in constant memory thrashing.
     RunGC(3);
@@ -323,12 +303,20 @@ void wdGPUResourcePool::UpdateMemoryStats() const
 {
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
 
-  float fMegaBytes = float(m_uiCurrentlyAllocatedMemory) / (1024.0f * 1024.0f);
+  const Stats stats = GetStats();
 
   wdStringBuilder sOut;
-  sOut.Format("{0} (Mb)", wdArgF(fMegaBytes, 4));
+  sOut.Format("{0} (Mb)", wdArgF(stats.m_uiBytesAllocated / (1024.0 * 1024.0), 4));
   wdStats::SetStat("GPU Resource Pool/Memory Consumption", sOut.GetData());
 
+  sOut.Format("{0} (Mb)", wdArgF(stats.m_uiBytesPooled / (1024.0 * 1024.0), 4));
+  wdStats::SetStat("GPU Resource Pool/Pooled Memory", sOut.GetData());
+
+  sOut.Format("{0}%", wdArgF(stats.GetHitRate() * 100.0, 1));
+  wdStats::SetStat("GPU Resource Pool/Hit Rate", sOut.GetData());
+
+  wdStats::SetStat("GPU Resource Pool/Evictions", stats.m_uiNumEvictions);
+
 #endif
 }
 
@@ -336,11 +324,19 @@ void wdGPUResourcePool::GALDeviceEventHandler(const wdGALDeviceEvent& e)
 {
   if (e.m_Type == wdGALDeviceEvent::AfterEndFrame)
   {
-    ++m_uiFramesSinceLastGC;
-    if (m_uiFramesSinceLastGC >= m_uiFramesThresholdSinceLastGC)
+    WD_PROFILE_SCOPE("IncrementalGC");
+
+    // check a few buckets every frame instead of all of them at once, to spread the cost of destroying resources
+    const wdUInt32 uiNumBuckets = m_AvailableTextures.GetNumBuckets();
+    const wdUInt32 uiBucketsPerFrame = wdMath::Max<wdUInt32>((uiNumBuckets + m_uiFramesThresholdSinceLastGC - 1) / m_uiFramesThresholdSinceLastGC, 1);
+
+    const wdUInt32 uiNumEvicted = EvictResources(10, m_uiNextBucketToGC, uiBucketsPerFrame);
+
+    m_uiNextBucketToGC = (m_uiNextBucketToGC + uiBucketsPerFrame) % uiNumBuckets;
+
+    if (uiNumEvicted > 0)
     {
-      m_uiFramesSinceLastGC = 0;
-      RunGC(10);
+      UpdateMemoryStats();
     }
   }
 }
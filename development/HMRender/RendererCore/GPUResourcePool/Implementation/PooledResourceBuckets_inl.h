@@ -0,0 +1,304 @@
+template <typename HandleType>
+wdPooledResourceBuckets<HandleType>::wdPooledResourceBuckets(wdUInt32 uiNumBuckets, wdUInt32 uiMaxResources)
+{
+  m_Buckets.SetCount(wdMath::PowerOfTwo_Ceil(wdMath::Max(uiNumBuckets, 1u)));
+  m_Entries.SetCount(uiMaxResources);
+
+  // all entries start out in the free list, chained in order
+  for (wdUInt32 i = 0; i < uiMaxResources; ++i)
+  {
+    m_Entries[i].m_iNext = (i + 1 < uiMaxResources) ? static_cast<wdInt32>(i + 2) : 0;
+  }
+
+  m_iFreeEntries = MakeHead(uiMaxResources > 0 ? 1 : 0, 0);
+}
+
+template <typename HandleType>
+bool wdPooledResourceBuckets<HandleType>::Push(wdUInt32 uiDescHash, HandleType hResource, wdUInt64 uiMemory, wdUInt64 uiFrame)
+{
+  Bucket* pBucket = AcquireBucket(uiDescHash, true);
+  if (pBucket == nullptr)
+    return false;
+
+  const wdUInt32 uiEntry = PopEntry(m_iFreeEntries);
+  if (uiEntry == 0)
+  {
+    ReleaseBucket(pBucket);
+    return false;
+  }
+
+  Entry& entry = GetEntryData(uiEntry);
+  entry.m_hResource = hResource;
+  entry.m_uiMemory = uiMemory;
+  entry.m_uiLastUsed = uiFrame;
+
+  m_iCount.Increment();
+  m_iMemory.Add(static_cast<wdInt64>(uiMemory));
+
+  PushList(pBucket->m_iHead, uiEntry, uiEntry);
+  ReleaseBucket(pBucket);
+  return true;
+}
+
+template <typename HandleType>
+bool wdPooledResourceBuckets<HandleType>::Pop(wdUInt32 uiDescHash, HandleType& out_hResource)
+{
+  Bucket* pBucket = AcquireBucket(uiDescHash, false);
+  if (pBucket == nullptr)
+    return false;
+
+  const wdUInt32 uiEntry = PopEntry(pBucket->m_iHead);
+  ReleaseBucket(pBucket);
+
+  if (uiEntry == 0)
+    return false;
+
+  Entry& entry = GetEntryData(uiEntry);
+  out_hResource = entry.m_hResource;
+
+  m_iCount.Decrement();
+  m_iMemory.Subtract(static_cast<wdInt64>(entry.m_uiMemory));
+
+  PushList(m_iFreeEntries, uiEntry, uiEntry);
+  return true;
+}
+
+template <typename HandleType>
+template <typename EvictFunc>
+wdUInt32 wdPooledResourceBuckets<HandleType>::Evict(wdUInt64 uiCurrentFrame, wdUInt32 uiMinimumAge, wdUInt32 uiFirstBucket, wdUInt32 uiNumBuckets, EvictFunc evictFunc)
+{
+  const wdUInt32 uiMask = m_Buckets.GetCount() - 1;
+  uiNumBuckets = wdMath::Min(uiNumBuckets, m_Buckets.GetCount());
+
+  wdUInt32 uiNumEvicted = 0;
+
+  for (wdUInt32 b = 0; b < uiNumBuckets; ++b)
+  {
+    Bucket& bucket = m_Buckets[(uiFirstBucket + b) & uiMask];
+
+    const wdInt32 iKey = bucket.m_iKey;
+    if (!IsClaimed(iKey))
+      continue;
+
+    if (GetEntry(bucket.m_iHead) == 0)
+    {
+      TryReleaseBucket(bucket, iKey);
+      continue;
+    }
+
+    // take the whole list, so that it can be filtered without any interference from other threads
+    wdUInt32 uiEntry = PopAll(bucket.m_iHead);
+
+    wdUInt32 uiKeepFirst = 0;
+    wdUInt32 uiKeepLast = 0;
+
+    while (uiEntry != 0)
+    {
+      Entry& entry = GetEntryData(uiEntry);
+      const wdUInt32 uiNext = static_cast<wdUInt32>(entry.m_iNext);
+
+      if (entry.m_uiLastUsed + uiMinimumAge <= uiCurrentFrame)
+      {
+        evictFunc(entry.m_hResource, entry.m_uiMemory);
+
+        m_iCount.Decrement();
+        m_iMemory.Subtract(static_cast<wdInt64>(entry.m_uiMemory));
+        ++uiNumEvicted;
+
+        PushList(m_iFreeEntries, uiEntry, uiEntry);
+      }
+      else
+      {
+        if (uiKeepLast != 0)
+        {
+          GetEntryData(uiKeepLast).m_iNext = static_cast<wdInt32>(uiEntry);
+        }
+        else
+        {
+          uiKeepFirst = uiEntry;
+        }
+
+        uiKeepLast = uiEntry;
+      }
+
+      uiEntry = uiNext;
+    }
+
+    // resources that were returned in the meantime stay below the ones that are kept, which only affects the order in which they are reused
+    if (uiKeepFirst != 0)
+    {
+      PushList(bucket.m_iHead, uiKeepFirst, uiKeepLast);
+    }
+    else
+    {
+      TryReleaseBucket(bucket, iKey);
+    }
+  }
+
+  return uiNumEvicted;
+}
+
+template <typename HandleType>
+void wdPooledResourceBuckets<HandleType>::PushList(wdAtomicInteger64& ref_iHead, wdUInt32 uiFirst, wdUInt32 uiLast)
+{
+  Entry& last = GetEntryData(uiLast);
+
+  wdInt64 iOldHead = ref_iHead;
+  while (true)
+  {
+    last.m_iNext = static_cast<wdInt32>(GetEntry(iOldHead));
+
+    const wdInt64 iNewHead = MakeHead(uiFirst, GetTag(iOldHead) + 1);
+    const wdInt64 iPrevHead = ref_iHead.CompareAndSwap(iOldHead, iNewHead);
+
+    if (iPrevHead == iOldHead)
+      return;
+
+    iOldHead = iPrevHead;
+  }
+}
+
+template <typename HandleType>
+wdUInt32 wdPooledResourceBuckets<HandleType>::PopEntry(wdAtomicInteger64& ref_iHead)
+{
+  wdInt64 iOldHead = ref_iHead;
+  while (true)
+  {
+    const wdUInt32 uiEntry = GetEntry(iOldHead);
+    if (uiEntry == 0)
+      return 0;
+
+    // the entry may be popped and modified by another thread at the same time, in that case the tag has changed and the swap fails
+    const wdUInt32 uiNext = static_cast<wdUInt32>(GetEntryData(uiEntry).m_iNext);
+
+    const wdInt64 iNewHead = MakeHead(uiNext, GetTag(iOldHead) + 1);
+    const wdInt64 iPrevHead = ref_iHead.CompareAndSwap(iOldHead, iNewHead);
+
+    if (iPrevHead == iOldHead)
+      return uiEntry;
+
+    iOldHead = iPrevHead;
+  }
+}
+
+template <typename HandleType>
+wdUInt32 wdPooledResourceBuckets<HandleType>::PopAll(wdAtomicInteger64& ref_iHead)
+{
+  wdInt64 iOldHead = ref_iHead;
+  while (true)
+  {
+    const wdInt64 iNewHead = MakeHead(0, GetTag(iOldHead) + 1);
+    const wdInt64 iPrevHead = ref_iHead.CompareAndSwap(iOldHead, iNewHead);
+
+    if (iPrevHead == iOldHead)
+      return GetEntry(iOldHead);
+
+    iOldHead = iPrevHead;
+  }
+}
+
+template <typename HandleType>
+typename wdPooledResourceBuckets<HandleType>::Bucket* wdPooledResourceBuckets<HandleType>::AcquireBucket(wdUInt32 uiDescHash, bool bCreate)
+{
+  const wdInt32 iKey = GetKey(uiDescHash);
+  const wdUInt32 uiHome = static_cast<wdUInt32>(iKey);
+  const wdUInt32 uiMask = m_Buckets.GetCount() - 1;
+
+  while (true)
+  {
+    Bucket* pFound = nullptr;
+    Bucket* pFirstReleased = nullptr;
+    Bucket* pUnused = nullptr;
+    bool bRetry = false;
+
+    // linear probing, released buckets keep the probe sequences of other keys intact, so a lookup can only stop at an unused bucket
+    for (wdUInt32 i = 0; i < m_Buckets.GetCount(); ++i)
+    {
+      Bucket& bucket = m_Buckets[(uiHome + i) & uiMask];
+
+      const wdInt32 iBucketKey = bucket.m_iKey;
+
+      if (iBucketKey == iKey)
+      {
+        pFound = &bucket;
+        break;
+      }
+
+      if (iBucketKey == KeyReleasing)
+      {
+        // this might be our bucket, which may be kept after all
+        bRetry = true;
+        break;
+      }
+
+      if (iBucketKey == KeyReleased && pFirstReleased == nullptr)
+      {
+        pFirstReleased = &bucket;
+      }
+      else if (iBucketKey == KeyUnused)
+      {
+        pUnused = &bucket;
+        break;
+      }
+    }
+
+    if (pFound == nullptr && !bRetry)
+    {
+      if (!bCreate)
+        return nullptr;
+
+      // prefer the first released bucket in the probe sequence, so that lookups stay short
+      if (pFirstReleased != nullptr)
+      {
+        if (pFirstReleased->m_iKey.TestAndSet(KeyReleased, iKey))
+          pFound = pFirstReleased;
+        else
+          bRetry = true;
+      }
+      else if (pUnused != nullptr)
+      {
+        if (pUnused->m_iKey.TestAndSet(KeyUnused, iKey))
+          pFound = pUnused;
+        else
+          bRetry = true;
+      }
+      else
+      {
+        // all buckets are in use
+        return nullptr;
+      }
+    }
+
+    if (pFound != nullptr)
+    {
+      // the bucket could have been released between finding it and incrementing the user count,
+      // TryReleaseBucket() checks the user count after marking the bucket, so one of the two always notices the other
+      pFound->m_iUsers.Increment();
+
+      if (pFound->m_iKey == iKey)
+        return pFound;
+
+      pFound->m_iUsers.Decrement();
+    }
+
+    // another thread changed the table in the meantime
+    wdThreadUtils::YieldTimeSlice();
+  }
+}
+
+template <typename HandleType>
+void wdPooledResourceBuckets<HandleType>::TryReleaseBucket(Bucket& ref_bucket, wdInt32 iKey)
+{
+  if (!ref_bucket.m_iKey.TestAndSet(iKey, KeyReleasing))
+    return;
+
+  // a thread that acquired the bucket before it was marked may still push to it
+  if (ref_bucket.m_iUsers == 0 && GetEntry(ref_bucket.m_iHead) == 0)
+  {
+    ref_bucket.m_iKey = KeyReleased;
+  }
+  else
+  {
+    ref_bucket.m_iKey = iKey;
+  }
+}
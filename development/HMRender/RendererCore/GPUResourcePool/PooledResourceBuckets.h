@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/ThreadUtils.h>
+#include <RendererCore/RendererCoreDLL.h>
+
+/// \brief A fixed size table of free lists for pooled GPU resources, bucketed by the hash of their creation description.
+///
+/// Push() and Pop() are lock-free and can be called from any thread at the same time. Each bucket is a stack, so Pop() returns the resource
+/// that was returned last. The table never allocates after construction. Buckets whose free list is empty are released by Evict() and can
+/// then be claimed for other descriptions, so the number of buckets only limits how many distinct descriptions can be pooled at the same
+/// time. If all buckets or all entries are in use, Push() fails and the caller has to destroy the resource instead.
+///
+/// The table only does the bookkeeping, it never touches the GPU device. Evicted resources are handed to a callback for destruction.
+template <typename HandleType>
+class wdPooledResourceBuckets
+{
+public:
+  /// \brief The number of buckets is rounded up to a power of two. \a uiMaxResources is the maximum number of resources that can be pooled.
+  wdPooledResourceBuckets(wdUInt32 uiNumBuckets, wdUInt32 uiMaxResources);
+
+  /// \brief Adds a resource to the bucket for \a uiDescHash. \a uiMemory is only used for statistics, \a uiFrame is used to evict old resources.
+  ///
+  /// Returns false if the table is full.
+  bool Push(wdUInt32 uiDescHash, HandleType hResource, wdUInt64 uiMemory, wdUInt64 uiFrame);
+
+  /// \brief Removes the most recently pushed resource from the bucket for \a uiDescHash. Returns false if there is none.
+  bool Pop(wdUInt32 uiDescHash, HandleType& out_hResource);
+
+  /// \brief Removes all resources from the buckets [uiFirstBucket; uiFirstBucket + uiNumBuckets) that have not been used for at least
+  /// \a uiMinimumAge frames.
+  ///
+  /// Every removed resource is passed to \a evictFunc as (HandleType hResource, wdUInt64 uiMemory), which has to destroy it.
+  /// Buckets in the range that end up empty are released for reuse.
+  /// The bucket range wraps around, so the whole table can be processed incrementally over several frames.
+  /// Returns the number of evicted resources.
+  template <typename EvictFunc>
+  wdUInt32 Evict(wdUInt64 uiCurrentFrame, wdUInt32 uiMinimumAge, wdUInt32 uiFirstBucket, wdUInt32 uiNumBuckets, EvictFunc evictFunc);
+
+  /// \brief Returns the number of buckets.
+  wdUInt32 GetNumBuckets() const { return m_Buckets.GetCount(); }
+
+  /// \brief Returns how many resources are currently in the table.
+  wdUInt32 GetCount() const { return static_cast<wdUInt32>(m_iCount); }
+
+  /// \brief Returns the sum of the memory of all resources that are currently in the table.
+  wdUInt64 GetMemory() const { return static_cast<wdUInt64>(m_iMemory); }
+
+private:
+  // Special values of Bucket::m_iKey. Description hashes that are equal to them are remapped in GetKey().
+  enum : wdInt32
+  {
+    KeyUnused = 0,    ///< the bucket was never claimed, probing can stop here
+    KeyReleased = 1,  ///< the bucket was released and can be claimed again, probing has to continue
+    KeyReleasing = 2, ///< the bucket is being released right now
+    NumSpecialKeys = 3,
+  };
+
+  struct Bucket
+  {
+    wdAtomicInteger32 m_iKey;
+    wdAtomicInteger64 m_iHead;
+    wdAtomicInteger32 m_iUsers; ///< the number of threads that currently push to or pop from this bucket
+  };
+
+  struct Entry
+  {
+    HandleType m_hResource;
+    wdUInt64 m_uiMemory = 0;
+    wdUInt64 m_uiLastUsed = 0;
+    wdAtomicInteger32 m_iNext;
+  };
+
+  // A list head stores the index + 1 of the first entry in the lower 32 bits and a tag in the upper 32 bits.
+  // The tag is changed with every modification, which prevents the ABA problem when an entry is popped and pushed again concurrently.
+  static WD_ALWAYS_INLINE wdInt64 MakeHead(wdUInt32 uiEntry, wdUInt32 uiTag) { return static_cast<wdInt64>((static_cast<wdUInt64>(uiTag) << 32) | uiEntry); }
+  static WD_ALWAYS_INLINE wdUInt32 GetEntry(wdInt64 iHead) { return static_cast<wdUInt32>(iHead & 0xFFFFFFFF); }
+  static WD_ALWAYS_INLINE wdUInt32 GetTag(wdInt64 iHead) { return static_cast<wdUInt32>(static_cast<wdUInt64>(iHead) >> 32); }
+
+  void PushList(wdAtomicInteger64& ref_iHead, wdUInt32 uiFirst, wdUInt32 uiLast);
+  wdUInt32 PopEntry(wdAtomicInteger64& ref_iHead);
+  wdUInt32 PopAll(wdAtomicInteger64& ref_iHead);
+
+  // Like any other hash collision, the remapped hashes share a bucket with the hashes they are remapped to.
+  static WD_ALWAYS_INLINE wdInt32 GetKey(wdUInt32 uiDescHash) { return static_cast<wdInt32>(uiDescHash < NumSpecialKeys ? uiDescHash | 0x80000000u : uiDescHash); }
+  static WD_ALWAYS_INLINE bool IsClaimed(wdInt32 iKey) { return static_cast<wdUInt32>(iKey) >= NumSpecialKeys; }
+
+  /// \brief Returns the bucket for \a uiDescHash with its user count incremented, which prevents it from being released until ReleaseBucket() is called.
+  Bucket* AcquireBucket(wdUInt32 uiDescHash, bool bCreate);
+  void ReleaseBucket(Bucket* pBucket) { pBucket->m_iUsers.Decrement(); }
+
+  /// \brief Releases the bucket for reuse if its free list is empty and no other thread is using it.
+  void TryReleaseBucket(Bucket& ref_bucket, wdInt32 iKey);
+
+  Entry& GetEntryData(wdUInt32 uiEntry) { return m_Entries[uiEntry - 1]; }
+
+  wdDynamicArray<Bucket> m_Buckets;
+  wdDynamicArray<Entry> m_Entries;
+  wdAtomicInteger64 m_iFreeEntries;
+
+  wdAtomicInteger32 m_iCount;
+  wdAtomicInteger64 m_iMemory;
+};
+
+#include <RendererCore/GPUResourcePool/Implementation/PooledResourceBuckets_inl.h>
@@ -25,6 +25,7 @@ class WD_RENDERERCORE_DLL wdDirectionalLightComponent : public wdLightComponent
 public:
   virtual void SerializeComponent(wdWorldWriter& inout_stream) const override;
   virtual void DeserializeComponent(wdWorldReader& inout_stream) override;
+  virtual bool CanBeDeserializedInParallel() const override;
 
   //////////////////////////////////////////////////////////////////////////
   // wdRenderComponent
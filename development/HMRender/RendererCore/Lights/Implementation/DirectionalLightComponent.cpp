@@ -154,6 +154,12 @@ void wdDirectionalLightComponent::DeserializeComponent(wdWorldReader& inout_stre
   }
 }
 
+bool wdDirectionalLightComponent::CanBeDeserializedInParallel() const
+{
+  // the light settings are plain values, derived types have to opt in themselves
+  return GetDynamicRTTI() == GetStaticRTTI();
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////
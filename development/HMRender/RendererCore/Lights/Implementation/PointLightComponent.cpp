@@ -145,6 +145,12 @@ void wdPointLightComponent::DeserializeComponent(wdWorldReader& inout_stream)
   s >> m_hProjectedTexture;
 }
 
+bool wdPointLightComponent::CanBeDeserializedInParallel() const
+{
+  // besides plain values only the projected texture handle is read, derived types have to opt in themselves
+  return GetDynamicRTTI() == GetStaticRTTI();
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdPointLightVisualizerAttribute, 1, wdRTTIDefaultAllocator<wdPointLightVisualizerAttribute>)
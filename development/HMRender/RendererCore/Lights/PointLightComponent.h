@@ -28,6 +28,7 @@ class WD_RENDERERCORE_DLL wdPointLightComponent : public wdLightComponent
 public:
   virtual void SerializeComponent(wdWorldWriter& inout_stream) const override;
   virtual void DeserializeComponent(wdWorldReader& inout_stream) override;
+  virtual bool CanBeDeserializedInParallel() const override;
 
 
   //////////////////////////////////////////////////////////////////////////
@@ -27,6 +27,12 @@ WD_END_COMPONENT_TYPE
 wdMeshComponent::wdMeshComponent() = default;
 wdMeshComponent::~wdMeshComponent() = default;
 
+bool wdMeshComponent::CanBeDeserializedInParallel() const
+{
+  // wdMeshComponentBase only reads resource handles and plain values, derived types have to opt in themselves
+  return GetDynamicRTTI() == GetStaticRTTI();
+}
+
 void wdMeshComponent::OnMsgExtractGeometry(wdMsgExtractGeometry& ref_msg) const
 {
   if (ref_msg.m_Mode != wdWorldGeoExtractionUtil::ExtractionMode::RenderMesh)
@@ -1,12 +1,76 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Core/Graphics/Camera.h>
 #include <Core/Messages/SetColorMessage.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
 #include <RendererCore/Meshes/MeshComponentBase.h>
+#include <RendererCore/Pipeline/View.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererFoundation/Device/Device.h>
 
+wdCVarInt cvar_RenderingMeshLodForce("Rendering.MeshLod.Force", -1, wdCVarFlags::Default, "Renders all meshes with the given LOD, -1 selects the LOD by screen size");
+wdCVarFloat cvar_RenderingMeshLodHysteresis("Rendering.MeshLod.Hysteresis", 0.1f, wdCVarFlags::Save, "Relative amount by which the screen size has to move past a LOD threshold before the LOD of a mesh is switched");
+wdCVarFloat cvar_RenderingMeshLodScreenSizeScale("Rendering.MeshLod.ScreenSizeScale", 1.0f, wdCVarFlags::Save, "Scales the screen size used for mesh LOD selection, smaller values switch to coarser LODs earlier");
+
+namespace
+{
+  // the lower bits of a LOD slot store the LOD + 1, the upper bits a key of the view
+  constexpr wdUInt32 s_uiMeshLodSlotLodMask = 0xFF;
+
+  /// \brief Returns the slot that stores the last LOD of the given view, or an empty or evicted slot if the view doesn't have one yet.
+  ///
+  /// Two views that claim the same slot at the same time only lose their hysteresis for a frame, the selected LOD is still correct.
+  wdAtomicInteger32& GetMeshLodSlot(wdArrayPtr<wdAtomicInteger32> slots, wdUInt32 uiViewKey)
+  {
+    wdAtomicInteger32* pEmptySlot = nullptr;
+
+    for (wdAtomicInteger32& slot : slots)
+    {
+      const wdUInt32 uiValue = static_cast<wdUInt32>(static_cast<wdInt32>(slot));
+
+      if (uiValue == 0)
+      {
+        if (pEmptySlot == nullptr)
+          pEmptySlot = &slot;
+      }
+      else if ((uiValue & ~s_uiMeshLodSlotLodMask) == uiViewKey)
+      {
+        return slot;
+      }
+    }
+
+    if (pEmptySlot != nullptr)
+      return *pEmptySlot;
+
+    return slots[(uiViewKey >> 8) % slots.GetCount()];
+  }
+
+  /// \brief Returns the diameter of the sphere projected by the LOD camera of the view, relative to the screen height.
+  float ComputeMeshLodScreenSize(const wdView& view, const wdBoundingSphere& sphere)
+  {
+    const wdCamera* pCamera = view.GetLodCamera();
+    const wdRectFloat& viewport = view.GetViewport();
+
+    if (pCamera == nullptr || viewport.height <= 0.0f)
+      return wdMath::MaxValue<float>();
+
+    const float fAspectRatio = viewport.width / viewport.height;
+
+    if (pCamera->IsOrthographic())
+    {
+      return (2.0f * sphere.m_fRadius) / pCamera->GetDimensionY(fAspectRatio);
+    }
+
+    const float fDistance = (sphere.m_vCenter - pCamera->GetPosition()).GetLength();
+    if (fDistance <= sphere.m_fRadius)
+      return wdMath::MaxValue<float>();
+
+    return sphere.m_fRadius / (fDistance * wdMath::Tan(pCamera->GetFovY(fAspectRatio) * 0.5f));
+  }
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
@@ -168,7 +232,16 @@ void wdMeshComponentBase::OnMsgExtractRenderData(wdMsgExtractRenderData& msg) co
   wdResourceLock<wdMeshResource> pMesh(m_hMesh, wdResourceAcquireMode::AllowLoadingFallback);
   wdArrayPtr<const wdMeshResourceDescriptor::SubMesh> parts = pMesh->GetSubMeshes();
 
-  for (wdUInt32 uiPartIndex = 0; uiPartIndex < parts.GetCount(); ++uiPartIndex)
+  // The selected LOD depends on the camera, so render data of meshes with LODs can't be cached.
+  // Cached render data is shared by all views and only extracted again when the component is invalidated,
+  // so every view would keep rendering the LOD that happened to be selected when the data was cached.
+  const bool bHasLods = pMesh->GetLods().GetCount() > 1;
+
+  wdUInt32 uiFirstPart = 0;
+  wdUInt32 uiNumParts = 0;
+  pMesh->GetLodSubMeshRange(bHasLods ? SelectLod(msg, *pMesh.GetPointer()) : 0, uiFirstPart, uiNumParts);
+
+  for (wdUInt32 uiPartIndex = uiFirstPart; uiPartIndex < uiFirstPart + uiNumParts; ++uiPartIndex)
   {
     const wdUInt32 uiMaterialIndex = parts[uiPartIndex].m_uiMaterialIndex;
     wdMaterialResourceHandle hMaterial;
@@ -225,8 +298,39 @@ void wdMeshComponentBase::OnMsgExtractRenderData(wdMsgExtractRenderData& msg) co
       }
     }
 
-    msg.AddRenderData(pRenderData, category, bDontCacheYet ? wdRenderData::Caching::Never : wdRenderData::Caching::IfStatic);
+    msg.AddRenderData(pRenderData, category, (bDontCacheYet || bHasLods) ? wdRenderData::Caching::Never : wdRenderData::Caching::IfStatic);
+  }
+}
+
+wdUInt32 wdMeshComponentBase::SelectLod(const wdMsgExtractRenderData& msg, const wdMeshResource& mesh) const
+{
+  if (cvar_RenderingMeshLodForce >= 0)
+    return wdMath::Min<wdUInt32>(cvar_RenderingMeshLodForce, mesh.GetLods().GetCount() - 1);
+
+  if (msg.m_pView == nullptr)
+    return 0;
+
+  const wdBoundingBoxSphere& bounds = GetOwner()->GetGlobalBounds();
+  if (!bounds.IsValid())
+    return 0;
+
+  const float fScreenSize = ComputeMeshLodScreenSize(*msg.m_pView, bounds.GetSphere()) * cvar_RenderingMeshLodScreenSizeScale;
+
+  const wdUInt32 uiViewKey = wdHashHelper<wdViewHandle>::Hash(msg.m_pView->GetHandle()) & ~s_uiMeshLodSlotLodMask;
+  wdAtomicInteger32& slot = GetMeshLodSlot(wdMakeArrayPtr(m_LastSelectedLods), uiViewKey);
+
+  const wdUInt32 uiSlotValue = static_cast<wdUInt32>(static_cast<wdInt32>(slot));
+  const bool bHasLastLod = uiSlotValue != 0 && (uiSlotValue & ~s_uiMeshLodSlotLodMask) == uiViewKey;
+  const wdUInt32 uiLastLod = bHasLastLod ? (uiSlotValue & s_uiMeshLodSlotLodMask) - 1 : wdInvalidIndex;
+
+  const wdUInt32 uiLod = wdMeshResourceDescriptor::SelectLod(mesh.GetLods(), fScreenSize, uiLastLod, cvar_RenderingMeshLodHysteresis);
+
+  if (uiLod < s_uiMeshLodSlotLodMask)
+  {
+    slot = static_cast<wdInt32>(uiViewKey | (uiLod + 1));
   }
+
+  return uiLod;
 }
 
 void wdMeshComponentBase::SetMesh(const wdMeshResourceHandle& hMesh)
@@ -235,6 +339,11 @@ void wdMeshComponentBase::SetMesh(const wdMeshResourceHandle& hMesh)
   {
     m_hMesh = hMesh;
 
+    for (wdAtomicInteger32& slot : m_LastSelectedLods)
+    {
+      slot = 0;
+    }
+
     TriggerLocalBoundsUpdate();
     InvalidateCachedRenderData();
   }
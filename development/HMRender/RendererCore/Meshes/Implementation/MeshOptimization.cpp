@@ -0,0 +1,514 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <RendererCore/Meshes/MeshBufferResource.h>
+#include <RendererCore/Meshes/MeshOptimization.h>
+#include <RendererCore/Meshes/MeshResourceDescriptor.h>
+#include <meshoptimizer/meshoptimizer.h>
+
+WD_DEFINE_AS_POD_TYPE(meshopt_Meshlet);
+
+namespace
+{
+  struct PrimitiveRange
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiFirstPrimitive;
+    wdUInt32 m_uiPrimitiveCount;
+  };
+
+  struct LodRange
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiFirstSubMesh;
+    wdUInt32 m_uiSubMeshCount;
+    float m_fError;
+  };
+
+  struct LodSubMesh
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiFirstIndex;
+    wdUInt32 m_uiIndexCount;
+    wdUInt32 m_uiMaterialIndex;
+  };
+
+  void ReadIndices(const wdMeshBufferResourceDescriptor& meshBuffer, wdDynamicArray<wdUInt32>& out_indices)
+  {
+    const wdUInt32 uiNumIndices = meshBuffer.GetPrimitiveCount() * 3;
+    out_indices.SetCountUninitialized(uiNumIndices);
+
+    if (meshBuffer.Uses32BitIndices())
+    {
+      const wdUInt32* pIndices = reinterpret_cast<const wdUInt32*>(meshBuffer.GetIndexBufferData().GetPtr());
+      wdMemoryUtils::Copy(out_indices.GetData(), pIndices, uiNumIndices);
+    }
+    else
+    {
+      const wdUInt16* pIndices = reinterpret_cast<const wdUInt16*>(meshBuffer.GetIndexBufferData().GetPtr());
+      for (wdUInt32 i = 0; i < uiNumIndices; ++i)
+      {
+        out_indices[i] = pIndices[i];
+      }
+    }
+  }
+
+  wdGALResourceFormat::Enum GetQuantizedFormat(const wdVertexStreamInfo& si, const wdMeshOptimizationSettings& settings)
+  {
+    if (!settings.m_bQuantizeStreams)
+      return si.m_Format;
+
+    // only full precision streams are quantized, already compressed streams are left as they are
+    switch (si.m_Semantic)
+    {
+      case wdGALVertexAttributeSemantic::Normal:
+        if (si.m_Format == wdGALResourceFormat::XYZFloat)
+          return wdMeshNormalPrecision::ToResourceFormatNormal(settings.m_NormalPrecision);
+        break;
+
+      case wdGALVertexAttributeSemantic::Tangent:
+        if (si.m_Format == wdGALResourceFormat::XYZWFloat)
+          return wdMeshNormalPrecision::ToResourceFormatTangent(settings.m_NormalPrecision);
+        break;
+
+      case wdGALVertexAttributeSemantic::TexCoord0:
+      case wdGALVertexAttributeSemantic::TexCoord1:
+        if (si.m_Format == wdGALResourceFormat::UVFloat)
+          return wdMeshTexCoordPrecision::ToResourceFormat(settings.m_TexCoordPrecision);
+        break;
+
+      default:
+        break;
+    }
+
+    return si.m_Format;
+  }
+
+  wdResult ConvertVertexElement(wdGALVertexAttributeSemantic::Enum semantic, wdArrayPtr<const wdUInt8> source, wdGALResourceFormat::Enum sourceFormat, wdArrayPtr<wdUInt8> dest, wdGALResourceFormat::Enum destFormat)
+  {
+    switch (semantic)
+    {
+      case wdGALVertexAttributeSemantic::Normal:
+      {
+        wdVec3 vNormal;
+        WD_SUCCEED_OR_RETURN(wdMeshBufferUtils::DecodeNormal(source, sourceFormat, vNormal));
+        return wdMeshBufferUtils::EncodeNormal(vNormal, dest, destFormat);
+      }
+
+      case wdGALVertexAttributeSemantic::Tangent:
+      {
+        wdVec3 vTangent;
+        float fBiTangentSign;
+        WD_SUCCEED_OR_RETURN(wdMeshBufferUtils::DecodeTangent(source, sourceFormat, vTangent, fBiTangentSign));
+        return wdMeshBufferUtils::EncodeTangent(vTangent, fBiTangentSign, dest, destFormat);
+      }
+
+      case wdGALVertexAttributeSemantic::TexCoord0:
+      case wdGALVertexAttributeSemantic::TexCoord1:
+      {
+        wdVec2 vTexCoord;
+        WD_SUCCEED_OR_RETURN(wdMeshBufferUtils::DecodeTexCoord(source, sourceFormat, vTexCoord));
+        return wdMeshBufferUtils::EncodeTexCoord(vTexCoord, dest, destFormat);
+      }
+
+      default:
+        return WD_FAILURE;
+    }
+  }
+
+  /// \brief Creates a new mesh buffer with the given vertex and index data. Streams are converted to their quantized formats on the way.
+  wdResult RebuildMeshBuffer(wdMeshBufferResourceDescriptor& ref_meshBuffer, wdArrayPtr<const wdUInt8> vertexData, wdUInt32 uiVertexCount, wdArrayPtr<const wdUInt32> indices, const wdMeshOptimizationSettings& settings)
+  {
+    const wdUInt32 uiSourceVertexSize = ref_meshBuffer.GetVertexDataSize();
+    const auto& sourceStreams = ref_meshBuffer.GetVertexDeclaration().m_VertexStreams;
+
+    wdMeshBufferResourceDescriptor result;
+
+    bool bSameLayout = true;
+    for (const wdVertexStreamInfo& si : sourceStreams)
+    {
+      const wdGALResourceFormat::Enum format = GetQuantizedFormat(si, settings);
+      bSameLayout &= (format == si.m_Format);
+
+      result.AddStream(si.m_Semantic, format);
+    }
+
+    result.AllocateStreams(uiVertexCount, wdGALPrimitiveTopology::Triangles, indices.GetCount() / 3);
+
+    if (bSameLayout)
+    {
+      wdMemoryUtils::Copy(result.GetVertexBufferData().GetData(), vertexData.GetPtr(), vertexData.GetCount());
+    }
+    else
+    {
+      const auto& destStreams = result.GetVertexDeclaration().m_VertexStreams;
+
+      for (wdUInt32 s = 0; s < sourceStreams.GetCount(); ++s)
+      {
+        const wdVertexStreamInfo& sourceStream = sourceStreams[s];
+        const wdVertexStreamInfo& destStream = destStreams[s];
+
+        for (wdUInt32 v = 0; v < uiVertexCount; ++v)
+        {
+          auto source = vertexData.GetSubArray(v * uiSourceVertexSize + sourceStream.m_uiOffset, sourceStream.m_uiElementSize);
+          auto dest = result.GetVertexData(s, v);
+
+          if (sourceStream.m_Format == destStream.m_Format)
+          {
+            wdMemoryUtils::Copy(dest.GetPtr(), source.GetPtr(), sourceStream.m_uiElementSize);
+          }
+          else if (ConvertVertexElement(sourceStream.m_Semantic, source, sourceStream.m_Format, dest, destStream.m_Format).Failed())
+          {
+            wdLog::Error("Failed to convert vertex stream {} from format {} to {}", (int)sourceStream.m_Semantic, (int)sourceStream.m_Format, (int)destStream.m_Format);
+            return WD_FAILURE;
+          }
+        }
+      }
+    }
+
+    for (wdUInt32 t = 0; t < indices.GetCount() / 3; ++t)
+    {
+      result.SetTriangleIndices(t, indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2]);
+    }
+
+    ref_meshBuffer = result;
+    return WD_SUCCESS;
+  }
+
+  void BuildMeshlets(const wdMeshBufferResourceDescriptor& meshBuffer, wdArrayPtr<const wdUInt32> indices, wdArrayPtr<const PrimitiveRange> ranges, const wdMeshOptimizationSettings& settings, wdMeshletData& out_meshlets)
+  {
+    const wdVec3* pPositions = nullptr;
+    wdUInt32 uiPositionStride = 0;
+    wdMeshBufferUtils::GetPositionStream(meshBuffer, pPositions, uiPositionStride).IgnoreResult();
+
+    const wdUInt32 uiVertexCount = meshBuffer.GetVertexCount();
+    const wdUInt32 uiMaxVertices = wdMath::Clamp<wdUInt32>(settings.m_uiMaxMeshletVertices, 3, 255);
+    const wdUInt32 uiMaxTriangles = wdMath::Clamp<wdUInt32>(settings.m_uiMaxMeshletTriangles & ~3u, 4, 512);
+
+    out_meshlets.m_Meshlets.Clear();
+    out_meshlets.m_Vertices.Clear();
+    out_meshlets.m_Triangles.Clear();
+
+    wdDynamicArray<meshopt_Meshlet> meshlets;
+    wdDynamicArray<wdUInt32> meshletVertices;
+    wdDynamicArray<wdUInt8> meshletTriangles;
+
+    for (wdUInt32 uiRange = 0; uiRange < ranges.GetCount(); ++uiRange)
+    {
+      const wdUInt32* pIndices = indices.GetPtr() + ranges[uiRange].m_uiFirstPrimitive * 3;
+      const wdUInt32 uiNumIndices = ranges[uiRange].m_uiPrimitiveCount * 3;
+
+      const size_t uiMaxMeshlets = meshopt_buildMeshletsBound(uiNumIndices, uiMaxVertices, uiMaxTriangles);
+      meshlets.SetCountUninitialized(static_cast<wdUInt32>(uiMaxMeshlets));
+      meshletVertices.SetCountUninitialized(static_cast<wdUInt32>(uiMaxMeshlets * uiMaxVertices));
+      meshletTriangles.SetCountUninitialized(static_cast<wdUInt32>(uiMaxMeshlets * uiMaxTriangles * 3));
+
+      const wdUInt32 uiNumMeshlets = static_cast<wdUInt32>(meshopt_buildMeshlets(meshlets.GetData(), meshletVertices.GetData(), meshletTriangles.GetData(), pIndices, uiNumIndices,
+        &pPositions->x, uiVertexCount, uiPositionStride, uiMaxVertices, uiMaxTriangles, settings.m_fMeshletConeWeight));
+
+      for (wdUInt32 m = 0; m < uiNumMeshlets; ++m)
+      {
+        const meshopt_Meshlet& meshlet = meshlets[m];
+
+        const meshopt_Bounds bounds = meshopt_computeMeshletBounds(&meshletVertices[meshlet.vertex_offset], &meshletTriangles[meshlet.triangle_offset],
+          meshlet.triangle_count, &pPositions->x, uiVertexCount, uiPositionStride);
+
+        wdMeshlet& result = out_meshlets.m_Meshlets.ExpandAndGetRef();
+        result.m_uiFirstVertex = out_meshlets.m_Vertices.GetCount();
+        result.m_uiFirstTriangle = out_meshlets.m_Triangles.GetCount() / 3;
+        result.m_uiVertexCount = static_cast<wdUInt16>(meshlet.vertex_count);
+        result.m_uiTriangleCount = static_cast<wdUInt16>(meshlet.triangle_count);
+        result.m_uiSubMeshIndex = uiRange;
+        result.m_Bounds.SetElements(wdVec3(bounds.center[0], bounds.center[1], bounds.center[2]), bounds.radius);
+        result.m_vConeAxis.Set(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+        result.m_fConeCutoff = bounds.cone_cutoff;
+
+        out_meshlets.m_Vertices.PushBackRange(meshletVertices.GetArrayPtr().GetSubArray(meshlet.vertex_offset, meshlet.vertex_count));
+        out_meshlets.m_Triangles.PushBackRange(meshletTriangles.GetArrayPtr().GetSubArray(meshlet.triangle_offset, meshlet.triangle_count * 3));
+      }
+    }
+  }
+
+  wdResult OptimizeRanges(wdMeshBufferResourceDescriptor& ref_meshBuffer, wdArrayPtr<const PrimitiveRange> ranges, const wdMeshOptimizationSettings& settings, wdMeshletData* out_pMeshlets)
+  {
+    if (ref_meshBuffer.GetTopology() != wdGALPrimitiveTopology::Triangles || !ref_meshBuffer.HasIndexBuffer())
+    {
+      wdLog::Error("Mesh optimization requires an indexed triangle mesh");
+      return WD_FAILURE;
+    }
+
+    const wdUInt32 uiVertexSize = ref_meshBuffer.GetVertexDataSize();
+    const wdUInt32 uiVertexCount = ref_meshBuffer.GetVertexCount();
+    const bool bGenerateMeshlets = settings.m_bGenerateMeshlets && out_pMeshlets != nullptr;
+
+    const wdVec3* pPositions = nullptr;
+    wdUInt32 uiPositionStride = 0;
+    if (settings.m_bOptimizeOverdraw || bGenerateMeshlets)
+    {
+      WD_SUCCEED_OR_RETURN(wdMeshBufferUtils::GetPositionStream(ref_meshBuffer, pPositions, uiPositionStride));
+    }
+
+    wdDynamicArray<wdUInt32> indices;
+    ReadIndices(ref_meshBuffer, indices);
+
+    for (const PrimitiveRange& range : ranges)
+    {
+      wdUInt32* pIndices = indices.GetData() + range.m_uiFirstPrimitive * 3;
+      const wdUInt32 uiNumIndices = range.m_uiPrimitiveCount * 3;
+
+      WD_ASSERT_DEV(range.m_uiFirstPrimitive * 3 + uiNumIndices <= indices.GetCount(), "Sub-mesh range is out of bounds");
+
+      if (settings.m_bOptimizeVertexCache)
+      {
+        meshopt_optimizeVertexCache(pIndices, pIndices, uiNumIndices, uiVertexCount);
+      }
+
+      // overdraw optimization works on clusters of the cache optimized order, so it has to run afterwards
+      if (settings.m_bOptimizeOverdraw)
+      {
+        meshopt_optimizeOverdraw(pIndices, pIndices, uiNumIndices, &pPositions->x, uiVertexCount, uiPositionStride, settings.m_fOverdrawThreshold);
+      }
+    }
+
+    wdArrayPtr<const wdUInt8> vertexData = ref_meshBuffer.GetVertexBufferData();
+    wdUInt32 uiNewVertexCount = uiVertexCount;
+
+    wdDynamicArray<wdUInt8> remappedVertexData;
+    if (settings.m_bOptimizeVertexFetch)
+    {
+      if (uiVertexSize <= 256)
+      {
+        wdDynamicArray<wdUInt32> remap;
+        remap.SetCountUninitialized(uiVertexCount);
+
+        uiNewVertexCount = static_cast<wdUInt32>(meshopt_optimizeVertexFetchRemap(remap.GetData(), indices.GetData(), indices.GetCount(), uiVertexCount));
+        meshopt_remapIndexBuffer(indices.GetData(), indices.GetData(), indices.GetCount(), remap.GetData());
+
+        remappedVertexData.SetCountUninitialized(uiNewVertexCount * uiVertexSize);
+        meshopt_remapVertexBuffer(remappedVertexData.GetData(), vertexData.GetPtr(), uiVertexCount, uiVertexSize, remap.GetData());
+
+        vertexData = remappedVertexData;
+      }
+      else
+      {
+        wdLog::Warning("Vertex fetch optimization is skipped, vertex size {} exceeds the maximum of 256 bytes", uiVertexSize);
+      }
+    }
+
+    WD_SUCCEED_OR_RETURN(RebuildMeshBuffer(ref_meshBuffer, vertexData, uiNewVertexCount, indices, settings));
+
+    if (bGenerateMeshlets)
+    {
+      BuildMeshlets(ref_meshBuffer, indices, ranges, settings, *out_pMeshlets);
+    }
+
+    return WD_SUCCESS;
+  }
+} // namespace
+
+// static
+wdResult wdMeshOptimization::Optimize(wdMeshResourceDescriptor& ref_mesh, const wdMeshOptimizationSettings& settings, wdMeshletData* out_pMeshlets)
+{
+  if (ref_mesh.GetExistingMeshBuffer().IsValid())
+  {
+    wdLog::Error("Meshes that reference an existing mesh buffer can't be optimized");
+    return WD_FAILURE;
+  }
+
+  wdHybridArray<PrimitiveRange, 8> ranges;
+  for (const auto& subMesh : ref_mesh.GetSubMeshes())
+  {
+    ranges.PushBack({subMesh.m_uiFirstPrimitive, subMesh.m_uiPrimitiveCount});
+  }
+
+  if (ranges.IsEmpty())
+  {
+    ranges.PushBack({0, ref_mesh.MeshBufferDesc().GetPrimitiveCount()});
+  }
+
+  WD_SUCCEED_OR_RETURN(OptimizeRanges(ref_mesh.MeshBufferDesc(), ranges, settings, out_pMeshlets));
+
+  // unreferenced vertices may have been removed
+  ref_mesh.ComputeBounds();
+  return WD_SUCCESS;
+}
+
+// static
+wdResult wdMeshOptimization::Optimize(wdMeshBufferResourceDescriptor& ref_meshBuffer, const wdMeshOptimizationSettings& settings, wdMeshletData* out_pMeshlets)
+{
+  const PrimitiveRange range = {0, ref_meshBuffer.GetPrimitiveCount()};
+  return OptimizeRanges(ref_meshBuffer, wdMakeArrayPtr(&range, 1), settings, out_pMeshlets);
+}
+
+// static
+wdResult wdMeshOptimization::GenerateLods(wdMeshResourceDescriptor& ref_mesh, const wdMeshLodSettings& settings)
+{
+  if (!ref_mesh.GetLods().IsEmpty())
+  {
+    wdLog::Error("LODs can't be generated for a mesh that already has LODs");
+    return WD_FAILURE;
+  }
+
+  if (ref_mesh.GetExistingMeshBuffer().IsValid())
+  {
+    wdLog::Error("LODs can't be generated for meshes that reference an existing mesh buffer");
+    return WD_FAILURE;
+  }
+
+  wdMeshBufferResourceDescriptor& meshBuffer = ref_mesh.MeshBufferDesc();
+  if (meshBuffer.GetTopology() != wdGALPrimitiveTopology::Triangles || !meshBuffer.HasIndexBuffer())
+  {
+    wdLog::Error("LOD generation requires an indexed triangle mesh");
+    return WD_FAILURE;
+  }
+
+  const wdVec3* pPositions = nullptr;
+  wdUInt32 uiPositionStride = 0;
+  WD_SUCCEED_OR_RETURN(wdMeshBufferUtils::GetPositionStream(meshBuffer, pPositions, uiPositionStride));
+
+  if (ref_mesh.GetSubMeshes().IsEmpty())
+  {
+    ref_mesh.AddSubMesh(meshBuffer.GetPrimitiveCount(), 0, 0);
+  }
+
+  // AddSubMesh() may reallocate the sub-mesh array
+  wdHybridArray<wdMeshResourceDescriptor::SubMesh, 8> lod0SubMeshes;
+  lod0SubMeshes = ref_mesh.GetSubMeshes();
+
+  wdHybridArray<LodRange, 8> lodRanges;
+  lodRanges.PushBack({0, lod0SubMeshes.GetCount(), 0.0f});
+
+  wdDynamicArray<wdUInt32> indices;
+  ReadIndices(meshBuffer, indices);
+
+  const wdUInt32 uiVertexCount = meshBuffer.GetVertexCount();
+
+  // sub-meshes usually don't share vertices, locking their borders prevents cracks between them
+  const unsigned int uiOptions = lod0SubMeshes.GetCount() > 1 ? meshopt_SimplifyLockBorder : 0;
+
+  wdUInt32 uiPrevTriangleCount = 0;
+  for (const auto& subMesh : lod0SubMeshes)
+  {
+    uiPrevTriangleCount += subMesh.m_uiPrimitiveCount;
+  }
+
+  wdDynamicArray<wdUInt32> lodIndices;
+  wdDynamicArray<wdUInt32> simplifiedIndices;
+  wdHybridArray<LodSubMesh, 8> lodSubMeshes;
+  float fTriangleRatio = 1.0f;
+
+  for (wdUInt32 uiLod = 1; uiLod < settings.m_uiMaxLods; ++uiLod)
+  {
+    fTriangleRatio *= settings.m_fTriangleRatio;
+
+    lodIndices.Clear();
+    lodSubMeshes.Clear();
+    float fLodError = 0.0f;
+
+    // every LOD is simplified from the original triangles, so the errors don't accumulate
+    for (const auto& subMesh : lod0SubMeshes)
+    {
+      const wdUInt32* pSourceIndices = indices.GetData() + subMesh.m_uiFirstPrimitive * 3;
+      const wdUInt32 uiNumIndices = subMesh.m_uiPrimitiveCount * 3;
+      const size_t uiTargetIndexCount = static_cast<size_t>(subMesh.m_uiPrimitiveCount * fTriangleRatio) * 3;
+
+      simplifiedIndices.SetCountUninitialized(uiNumIndices);
+
+      float fError = 0.0f;
+      const wdUInt32 uiNumSimplified = static_cast<wdUInt32>(meshopt_simplify(simplifiedIndices.GetData(), pSourceIndices, uiNumIndices, &pPositions->x, uiVertexCount, uiPositionStride, uiTargetIndexCount, settings.m_fMaxError, uiOptions, &fError));
+
+      fLodError = wdMath::Max(fLodError, fError);
+
+      if (uiNumSimplified == 0)
+        continue;
+
+      lodSubMeshes.PushBack({lodIndices.GetCount(), uiNumSimplified, subMesh.m_uiMaterialIndex});
+      lodIndices.PushBackRange(simplifiedIndices.GetArrayPtr().GetSubArray(0, uiNumSimplified));
+    }
+
+    const wdUInt32 uiTriangleCount = lodIndices.GetCount() / 3;
+    if (uiTriangleCount == 0 || uiTriangleCount > uiPrevTriangleCount * settings.m_fMinReduction)
+      break;
+
+    const wdUInt32 uiFirstTriangle = meshBuffer.GetPrimitiveCount();
+    const wdUInt32 uiIndexSize = meshBuffer.Uses32BitIndices() ? sizeof(wdUInt32) : sizeof(wdUInt16);
+    auto& indexData = meshBuffer.GetIndexBufferData();
+    indexData.SetCountUninitialized(indexData.GetCount() + lodIndices.GetCount() * uiIndexSize);
+
+    for (wdUInt32 t = 0; t < uiTriangleCount; ++t)
+    {
+      meshBuffer.SetTriangleIndices(uiFirstTriangle + t, lodIndices[t * 3 + 0], lodIndices[t * 3 + 1], lodIndices[t * 3 + 2]);
+    }
+
+    lodRanges.PushBack({ref_mesh.GetSubMeshes().GetCount(), lodSubMeshes.GetCount(), fLodError});
+
+    for (const LodSubMesh& lodSubMesh : lodSubMeshes)
+    {
+      ref_mesh.AddSubMesh(lodSubMesh.m_uiIndexCount / 3, uiFirstTriangle + lodSubMesh.m_uiFirstIndex / 3, lodSubMesh.m_uiMaterialIndex);
+    }
+
+    uiPrevTriangleCount = uiTriangleCount;
+  }
+
+  ref_mesh.ComputeBounds();
+
+  // A LOD with the relative error e deviates by e * scale in object space. For a bounding sphere with radius r that covers the screen size s
+  // (diameter relative to the screen height), that is e * scale * s / (2 * r) on screen, so the previous LOD is needed above the screen size
+  // 2 * r * maxScreenSpaceError / (e * scale).
+  const float fScale = meshopt_simplifyScale(&pPositions->x, uiVertexCount, uiPositionStride);
+  const float fRadius = ref_mesh.GetBounds().m_fSphereRadius;
+
+  float fPrevScreenSize = wdMath::MaxValue<float>();
+  for (wdUInt32 i = 0; i < lodRanges.GetCount(); ++i)
+  {
+    float fMinScreenSize = 0.0f;
+
+    if (i + 1 < lodRanges.GetCount())
+    {
+      const float fNextError = wdMath::Max(lodRanges[i + 1].m_fError * fScale, wdMath::SmallEpsilon<float>());
+      fMinScreenSize = wdMath::Min(fPrevScreenSize, 2.0f * fRadius * settings.m_fMaxScreenSpaceError / fNextError);
+    }
+
+    ref_mesh.AddLod(lodRanges[i].m_uiFirstSubMesh, lodRanges[i].m_uiSubMeshCount, fMinScreenSize);
+    fPrevScreenSize = fMinScreenSize;
+  }
+
+  return WD_SUCCESS;
+}
+
+// static
+wdResult wdMeshOptimization::Analyze(const wdMeshBufferResourceDescriptor& meshBuffer, wdMeshOptimizationStatistics& out_statistics)
+{
+  if (meshBuffer.GetTopology() != wdGALPrimitiveTopology::Triangles || !meshBuffer.HasIndexBuffer())
+  {
+    wdLog::Error("Mesh analysis requires an indexed triangle mesh");
+    return WD_FAILURE;
+  }
+
+  const wdVec3* pPositions = nullptr;
+  wdUInt32 uiPositionStride = 0;
+  WD_SUCCEED_OR_RETURN(wdMeshBufferUtils::GetPositionStream(meshBuffer, pPositions, uiPositionStride));
+
+  wdDynamicArray<wdUInt32> indices;
+  ReadIndices(meshBuffer, indices);
+
+  const wdUInt32 uiVertexCount = meshBuffer.GetVertexCount();
+
+  const meshopt_VertexCacheStatistics vertexCache = meshopt_analyzeVertexCache(indices.GetData(), indices.GetCount(), uiVertexCount, s_uiAnalyzeVertexCacheSize, 0, 0);
+  const meshopt_OverdrawStatistics overdraw = meshopt_analyzeOverdraw(indices.GetData(), indices.GetCount(), &pPositions->x, uiVertexCount, uiPositionStride);
+  const meshopt_VertexFetchStatistics vertexFetch = meshopt_analyzeVertexFetch(indices.GetData(), indices.GetCount(), uiVertexCount, meshBuffer.GetVertexDataSize());
+
+  out_statistics.m_fACMR = vertexCache.acmr;
+  out_statistics.m_fATVR = vertexCache.atvr;
+  out_statistics.m_fOverdraw = overdraw.overdraw;
+  out_statistics.m_uiVertexFetchBytes = vertexFetch.bytes_fetched;
+  out_statistics.m_fVertexFetchOverfetch = vertexFetch.overfetch;
+  out_statistics.m_uiVertexBufferBytes = meshBuffer.GetVertexBufferData().GetCount();
+  out_statistics.m_uiIndexBufferBytes = meshBuffer.GetIndexBufferData().GetCount();
+
+  return WD_SUCCESS;
+}
+
+WD_STATICLINK_FILE(RendererCore, RendererCore_Meshes_Implementation_MeshOptimization);
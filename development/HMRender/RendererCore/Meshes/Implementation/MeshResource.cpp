@@ -19,6 +19,20 @@ wdMeshResource::wdMeshResource()
   m_Bounds.SetInvalid();
 }
 
+void wdMeshResource::GetLodSubMeshRange(wdUInt32 uiLod, wdUInt32& out_uiFirstSubMesh, wdUInt32& out_uiSubMeshCount) const
+{
+  if (m_Lods.IsEmpty())
+  {
+    out_uiFirstSubMesh = 0;
+    out_uiSubMeshCount = m_SubMeshes.GetCount();
+    return;
+  }
+
+  const wdMeshResourceDescriptor::Lod& lod = m_Lods[wdMath::Min(uiLod, m_Lods.GetCount() - 1)];
+  out_uiFirstSubMesh = lod.m_uiFirstSubMesh;
+  out_uiSubMeshCount = lod.m_uiSubMeshCount;
+}
+
 wdResourceLoadDesc wdMeshResource::UnloadData(Unload WhatToUnload)
 {
   wdResourceLoadDesc res;
@@ -31,6 +45,8 @@ wdResourceLoadDesc wdMeshResource::UnloadData(Unload WhatToUnload)
   {
     m_SubMeshes.Clear();
     m_SubMeshes.Compact();
+    m_Lods.Clear();
+    m_Lods.Compact();
     m_Materials.Clear();
     m_Materials.Compact();
     m_Bones.Clear();
@@ -80,7 +96,7 @@ wdResourceLoadDesc wdMeshResource::UpdateContent(wdStreamReader* Stream)
 
 void wdMeshResource::UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage)
 {
-  out_NewMemoryUsage.m_uiMemoryCPU = sizeof(wdMeshResource) + (wdUInt32)m_SubMeshes.GetHeapMemoryUsage() + (wdUInt32)m_Materials.GetHeapMemoryUsage();
+  out_NewMemoryUsage.m_uiMemoryCPU = sizeof(wdMeshResource) + (wdUInt32)m_SubMeshes.GetHeapMemoryUsage() + (wdUInt32)m_Lods.GetHeapMemoryUsage() + (wdUInt32)m_Materials.GetHeapMemoryUsage();
   out_NewMemoryUsage.m_uiMemoryGPU = 0;
 }
 
@@ -107,6 +123,7 @@ WD_RESOURCE_IMPLEMENT_CREATEABLE(wdMeshResource, wdMeshResourceDescriptor)
   }
 
   m_SubMeshes = descriptor.GetSubMeshes();
+  m_Lods = descriptor.GetLods();
 
   m_Materials.Clear();
   m_Materials.Reserve(descriptor.GetMaterials().GetCount());
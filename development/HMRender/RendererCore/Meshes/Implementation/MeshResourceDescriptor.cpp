@@ -22,6 +22,7 @@ void wdMeshResourceDescriptor::Clear()
   m_Materials.Clear();
   m_MeshBufferDescriptor.Clear();
   m_SubMeshes.Clear();
+  m_Lods.Clear();
 }
 
 wdMeshBufferResourceDescriptor& wdMeshResourceDescriptor::MeshBufferDesc()
@@ -56,6 +57,14 @@ wdArrayPtr<const wdMeshResourceDescriptor::SubMesh> wdMeshResourceDescriptor::Ge
 
 void wdMeshResourceDescriptor::CollapseSubMeshes()
 {
+  if (!m_Lods.IsEmpty())
+  {
+    // the primitives of the other LODs stay in the index buffer, but are not referenced anymore
+    m_SubMeshes.SetCount(m_Lods[0].m_uiFirstSubMesh + m_Lods[0].m_uiSubMeshCount);
+    m_SubMeshes.RemoveAtAndCopy(0, m_Lods[0].m_uiFirstSubMesh);
+    m_Lods.Clear();
+  }
+
   for (wdUInt32 idx = 1; idx < m_SubMeshes.GetCount(); ++idx)
   {
     m_SubMeshes[0].m_uiFirstPrimitive = wdMath::Min(m_SubMeshes[0].m_uiFirstPrimitive, m_SubMeshes[idx].m_uiFirstPrimitive);
@@ -89,6 +98,49 @@ void wdMeshResourceDescriptor::AddSubMesh(wdUInt32 uiPrimitiveCount, wdUInt32 ui
   m_SubMeshes.PushBack(p);
 }
 
+void wdMeshResourceDescriptor::AddLod(wdUInt32 uiFirstSubMesh, wdUInt32 uiSubMeshCount, float fMinScreenSize)
+{
+  WD_ASSERT_DEV(m_Lods.IsEmpty() || m_Lods.PeekBack().m_fMinScreenSize >= fMinScreenSize, "LODs have to be added with decreasing screen sizes");
+
+  Lod lod;
+  lod.m_uiFirstSubMesh = uiFirstSubMesh;
+  lod.m_uiSubMeshCount = uiSubMeshCount;
+  lod.m_fMinScreenSize = fMinScreenSize;
+
+  m_Lods.PushBack(lod);
+}
+
+wdArrayPtr<const wdMeshResourceDescriptor::Lod> wdMeshResourceDescriptor::GetLods() const
+{
+  return m_Lods;
+}
+
+// static
+wdUInt32 wdMeshResourceDescriptor::SelectLod(wdArrayPtr<const Lod> lods, float fScreenSize, wdUInt32 uiCurrentLod, float fHysteresis)
+{
+  if (lods.GetCount() <= 1)
+    return 0;
+
+  if (uiCurrentLod >= lods.GetCount())
+  {
+    fHysteresis = 0.0f;
+  }
+
+  wdUInt32 uiLod = 0;
+  while (uiLod + 1 < lods.GetCount())
+  {
+    // switching to a more detailed LOD requires a larger screen size than staying at the current one
+    const float fScale = uiLod < uiCurrentLod ? (1.0f + fHysteresis) : (1.0f - fHysteresis);
+
+    if (fScreenSize >= lods[uiLod].m_fMinScreenSize * fScale)
+      break;
+
+    ++uiLod;
+  }
+
+  return uiLod;
+}
+
 void wdMeshResourceDescriptor::SetMaterial(wdUInt32 uiMaterialIndex, const char* szPathToMaterial)
 {
   m_Materials.EnsureCount(uiMaterialIndex + 1);
@@ -164,6 +216,22 @@ void wdMeshResourceDescriptor::Save(wdStreamWriter& inout_stream)
     chunk.EndChunk();
   }
 
+  if (!m_Lods.IsEmpty())
+  {
+    chunk.BeginChunk("Lods", 1);
+
+    chunk << m_Lods.GetCount();
+
+    for (const Lod& lod : m_Lods)
+    {
+      chunk << lod.m_uiFirstSubMesh;
+      chunk << lod.m_uiSubMeshCount;
+      chunk << lod.m_fMinScreenSize;
+    }
+
+    chunk.EndChunk();
+  }
+
   {
     chunk.BeginChunk("MeshInfo", 4);
 
@@ -385,6 +453,34 @@ wdResult wdMeshResourceDescriptor::Load(wdStreamReader& inout_stream)
       }
     }
 
+    if (ci.m_sChunkName == "Lods")
+    {
+      if (ci.m_uiChunkVersion != 1)
+      {
+        wdLog::Error("Version of chunk '{0}' is invalid ({1})", ci.m_sChunkName, ci.m_uiChunkVersion);
+        return WD_FAILURE;
+      }
+
+      chunk >> count;
+
+      // every LOD needs at least one sub-mesh, the sub-meshes are read before, so this rejects corrupt counts before allocating
+      if (count > m_SubMeshes.GetCount())
+      {
+        wdLog::Warning("Mesh has {0} LODs, but only {1} sub-meshes. LODs are ignored.", count, m_SubMeshes.GetCount());
+      }
+      else
+      {
+        m_Lods.SetCount(count);
+
+        for (Lod& lod : m_Lods)
+        {
+          chunk >> lod.m_uiFirstSubMesh;
+          chunk >> lod.m_uiSubMeshCount;
+          chunk >> lod.m_fMinScreenSize;
+        }
+      }
+    }
+
     if (ci.m_sChunkName == "MeshInfo")
     {
       if (ci.m_uiChunkVersion > 4)
@@ -508,6 +604,17 @@ wdResult wdMeshResourceDescriptor::Load(wdStreamReader& inout_stream)
 
   chunk.EndStream();
 
+  // the LODs index into the sub-meshes, a corrupt or outdated file must not make the mesh components read past them
+  for (const Lod& lod : m_Lods)
+  {
+    if (lod.m_uiSubMeshCount == 0 || lod.m_uiFirstSubMesh > m_SubMeshes.GetCount() || lod.m_uiSubMeshCount > m_SubMeshes.GetCount() - lod.m_uiFirstSubMesh)
+    {
+      wdLog::Warning("Mesh LOD references sub-meshes {0} to {1}, but the mesh only has {2} sub-meshes. LODs are ignored.", lod.m_uiFirstSubMesh, lod.m_uiFirstSubMesh + lod.m_uiSubMeshCount, m_SubMeshes.GetCount());
+      m_Lods.Clear();
+      break;
+    }
+  }
+
   if (bCalculateBounds)
   {
     ComputeBounds();
@@ -46,7 +46,8 @@ void wdSkinnedMeshRenderer::SetAdditionalData(const wdRenderViewContext& renderV
       s_uiSkinningBufferUpdates++;
     }
 
-    pContext->BindBuffer("skinningTransforms", pDevice->GetDefaultResourceView(pSkinnedRenderData->m_hSkinningTransforms));
+    static const wdShaderBindingSlot s_SkinningTransformsSlot = wdRenderContext::GetBindingSlot("skinningTransforms");
+    pContext->BindBuffer(s_SkinningTransformsSlot, pDevice->GetDefaultResourceView(pSkinnedRenderData->m_hSkinningTransforms));
   }
 }
 
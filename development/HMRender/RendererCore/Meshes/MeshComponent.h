@@ -18,4 +18,6 @@ public:
 
   /// \brief Extracts the render geometry for export etc.
   void OnMsgExtractGeometry(wdMsgExtractGeometry& ref_msg) const; // [ msg handler ]
+
+  virtual bool CanBeDeserializedInParallel() const override;
 };
@@ -110,8 +110,18 @@ protected:
 
   void OnMsgExtractRenderData(wdMsgExtractRenderData& msg) const;
 
+  /// \brief Selects the LOD of the mesh based on the projected size of the owner's bounds in the LOD camera of the view.
+  ///
+  /// The last LOD is remembered per view for hysteresis, since extraction may run for several views in parallel and each of them needs its own LOD.
+  wdUInt32 SelectLod(const wdMsgExtractRenderData& msg, const wdMeshResource& mesh) const;
+
   wdRenderData::Category m_RenderDataCategory = wdInvalidRenderDataCategory;
   wdMeshResourceHandle m_hMesh;
   wdDynamicArray<wdMaterialResourceHandle> m_Materials;
   wdColor m_Color = wdColor::White;
+
+  static constexpr wdUInt32 s_uiNumLodViewSlots = 4;
+
+  // the LOD that was selected last in a few views, each slot packs a key of the view and the LOD + 1, 0 marks an empty slot
+  mutable wdAtomicInteger32 m_LastSelectedLods[s_uiNumLodViewSlots];
 };
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <Foundation/Math/BoundingSphere.h>
+#include <RendererCore/Meshes/MeshBufferUtils.h>
+
+struct wdMeshBufferResourceDescriptor;
+class wdMeshResourceDescriptor;
+
+/// \brief Selects which optimization steps wdMeshOptimization::Optimize() applies to a mesh.
+struct wdMeshOptimizationSettings
+{
+  /// Reorders the triangles of each sub-mesh to improve the post-transform vertex cache hit rate.
+  bool m_bOptimizeVertexCache = true;
+
+  /// Reorders the triangles of each sub-mesh to reduce overdraw. Requires a float position stream.
+  bool m_bOptimizeOverdraw = true;
+
+  /// How much the vertex cache efficiency may get worse to reduce overdraw. 1.05 allows a 5% degradation.
+  float m_fOverdrawThreshold = 1.05f;
+
+  /// Reorders the vertices in the order in which they are referenced, to improve the locality of vertex fetches.
+  /// Vertices that are not referenced by any triangle are removed.
+  bool m_bOptimizeVertexFetch = true;
+
+  /// Converts float normal, tangent and texcoord streams to the formats that match the precisions below.
+  bool m_bQuantizeStreams = false;
+  wdEnum<wdMeshNormalPrecision> m_NormalPrecision = wdMeshNormalPrecision::Default;
+  wdEnum<wdMeshTexCoordPrecision> m_TexCoordPrecision = wdMeshTexCoordPrecision::Default;
+
+  /// Splits each sub-mesh into meshlets. Only done when a wdMeshletData object is passed to wdMeshOptimization::Optimize().
+  bool m_bGenerateMeshlets = false;
+  wdUInt8 m_uiMaxMeshletVertices = 64;
+  wdUInt16 m_uiMaxMeshletTriangles = 124; ///< Must be divisible by 4.
+  float m_fMeshletConeWeight = 0.0f;      ///< Values above 0 favor meshlets that can be cone culled over tightly packed meshlets.
+};
+
+/// \brief Configures how wdMeshOptimization::GenerateLods() simplifies a mesh.
+struct wdMeshLodSettings
+{
+  /// The maximum number of LODs, including the original mesh.
+  wdUInt32 m_uiMaxLods = 4;
+
+  /// Each LOD targets this fraction of the triangle count of the previous one.
+  float m_fTriangleRatio = 0.5f;
+
+  /// The maximum deviation of a LOD from the original mesh, relative to the mesh extents. No further LODs are generated once this is reached.
+  float m_fMaxError = 0.05f;
+
+  /// The deviation that is acceptable on screen, relative to the screen height. Determines down to which screen size each LOD is used.
+  float m_fMaxScreenSpaceError = 1.0f / 1080.0f;
+
+  /// A LOD is only added if it has at most this fraction of the triangles of the previous one.
+  float m_fMinReduction = 0.8f;
+};
+
+/// \brief GPU agnostic metrics that describe how efficiently a mesh can be processed by the vertex pipeline.
+struct wdMeshOptimizationStatistics
+{
+  /// Average cache miss ratio: transformed vertices per triangle. 0.5 is ideal for large grids, 3.0 is the worst case.
+  float m_fACMR = 0.0f;
+
+  /// Average transformed vertex ratio: transformed vertices per vertex. 1.0 is ideal.
+  float m_fATVR = 0.0f;
+
+  /// Pixels shaded per covered pixel, measured by rasterizing the mesh from several directions. 1.0 is ideal.
+  float m_fOverdraw = 0.0f;
+
+  /// Bytes read from the vertex buffer, assuming 64 byte cache lines.
+  wdUInt32 m_uiVertexFetchBytes = 0;
+
+  /// Bytes fetched relative to the size of the vertex buffer. 1.0 is ideal.
+  float m_fVertexFetchOverfetch = 0.0f;
+
+  wdUInt32 m_uiVertexBufferBytes = 0;
+  wdUInt32 m_uiIndexBufferBytes = 0;
+};
+
+/// \brief A small cluster of triangles that can be culled and processed as one unit.
+struct wdMeshlet
+{
+  WD_DECLARE_POD_TYPE();
+
+  wdUInt32 m_uiFirstVertex = 0;   ///< Offset into wdMeshletData::m_Vertices.
+  wdUInt32 m_uiFirstTriangle = 0; ///< Offset into wdMeshletData::m_Triangles, in triangles.
+  wdUInt16 m_uiVertexCount = 0;
+  wdUInt16 m_uiTriangleCount = 0;
+  wdUInt32 m_uiSubMeshIndex = 0;
+
+  wdBoundingSphere m_Bounds;
+  wdVec3 m_vConeAxis;
+  float m_fConeCutoff = 1.0f; ///< The meshlet is back-facing if dot(normalize(center - cameraPos), coneAxis) >= coneCutoff.
+};
+
+/// \brief The meshlets of a mesh.
+struct wdMeshletData
+{
+  wdDynamicArray<wdMeshlet> m_Meshlets;
+
+  /// Indices into the vertex buffer of the mesh, referenced by wdMeshlet::m_uiFirstVertex.
+  wdDynamicArray<wdUInt32> m_Vertices;
+
+  /// Three local vertex indices per triangle, relative to the meshlet's first vertex.
+  wdDynamicArray<wdUInt8> m_Triangles;
+};
+
+/// \brief Optimizes mesh data for rendering using the meshoptimizer library.
+///
+/// This is meant to be used by asset processors before a mesh is written to disk, since the optimizations are too expensive to run at load time.
+struct WD_RENDERERCORE_DLL wdMeshOptimization
+{
+  /// \brief Optimizes the mesh buffer of the given mesh. Triangles are only reordered within each sub-mesh, so the sub-mesh ranges stay valid.
+  ///
+  /// Fails if the mesh references an existing mesh buffer instead of owning its data.
+  static wdResult Optimize(wdMeshResourceDescriptor& ref_mesh, const wdMeshOptimizationSettings& settings, wdMeshletData* out_pMeshlets = nullptr);
+
+  /// \brief Optimizes the given mesh buffer, treating all of its triangles as one sub-mesh.
+  static wdResult Optimize(wdMeshBufferResourceDescriptor& ref_meshBuffer, const wdMeshOptimizationSettings& settings, wdMeshletData* out_pMeshlets = nullptr);
+
+  /// \brief Adds simplified versions of the mesh as levels of detail.
+  ///
+  /// The existing sub-meshes become LOD 0. For every further LOD each of them is simplified and appended as a new sub-mesh with the same material,
+  /// all LODs share the vertex buffer. The screen size thresholds are derived from the simplification error and settings.m_fMaxScreenSpaceError.
+  /// Fails if the mesh already has LODs, references an existing mesh buffer or is not an indexed triangle mesh with a float position stream.
+  static wdResult GenerateLods(wdMeshResourceDescriptor& ref_mesh, const wdMeshLodSettings& settings);
+
+  /// \brief Computes the vertex cache, overdraw and vertex fetch metrics of the given indexed triangle mesh.
+  static wdResult Analyze(const wdMeshBufferResourceDescriptor& meshBuffer, wdMeshOptimizationStatistics& out_statistics);
+
+  /// \brief The size of the FIFO vertex cache that is simulated by Analyze().
+  static constexpr wdUInt32 s_uiAnalyzeVertexCacheSize = 16;
+};
@@ -17,6 +17,12 @@ public:
   /// \brief Returns the array of sub-meshes in this mesh.
   wdArrayPtr<const wdMeshResourceDescriptor::SubMesh> GetSubMeshes() const { return m_SubMeshes; }
 
+  /// \brief Returns the levels of detail of this mesh. Empty if the mesh has no LODs, in which case all sub-meshes are rendered.
+  wdArrayPtr<const wdMeshResourceDescriptor::Lod> GetLods() const { return m_Lods; }
+
+  /// \brief Returns the index of the first sub-mesh and the number of sub-meshes that make up the given LOD.
+  void GetLodSubMeshRange(wdUInt32 uiLod, wdUInt32& out_uiFirstSubMesh, wdUInt32& out_uiSubMeshCount) const;
+
   /// \brief Returns the mesh buffer that is used by this resource.
   const wdMeshBufferResourceHandle& GetMeshBuffer() const { return m_hMeshBuffer; }
 
@@ -37,6 +43,7 @@ private:
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
   wdDynamicArray<wdMeshResourceDescriptor::SubMesh> m_SubMeshes;
+  wdDynamicArray<wdMeshResourceDescriptor::Lod> m_Lods;
   wdMeshBufferResourceHandle m_hMeshBuffer;
   wdDynamicArray<wdMaterialResourceHandle> m_Materials;
 
@@ -24,6 +24,18 @@ public:
     wdString m_sPath;
   };
 
+  /// \brief A level of detail of the mesh, made up of a consecutive range of sub-meshes.
+  struct Lod
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiFirstSubMesh;
+    wdUInt32 m_uiSubMeshCount;
+
+    /// The LOD is used as long as the projected diameter of the mesh bounds is at least this fraction of the screen height.
+    float m_fMinScreenSize;
+  };
+
   wdMeshResourceDescriptor();
 
   void Clear();
@@ -50,9 +62,21 @@ public:
 
   wdArrayPtr<const SubMesh> GetSubMeshes() const;
 
-  /// \brief Merges all submeshes into just one.
+  /// \brief Merges all submeshes into just one. If the mesh has LODs, only the sub-meshes of the first LOD are kept and the LODs are removed.
   void CollapseSubMeshes();
 
+  /// \brief Adds a level of detail. LODs have to be added from the most to the least detailed one, with decreasing screen sizes.
+  void AddLod(wdUInt32 uiFirstSubMesh, wdUInt32 uiSubMeshCount, float fMinScreenSize);
+
+  /// \brief Returns the levels of detail of this mesh. If there are none, all sub-meshes are rendered at every distance.
+  wdArrayPtr<const Lod> GetLods() const;
+
+  /// \brief Returns the index of the LOD to use for the given projected screen size.
+  ///
+  /// uiCurrentLod is the LOD that was used before, or an invalid index if there is none. A LOD is only left once the screen size
+  /// has moved past its threshold by the relative amount fHysteresis, which prevents flickering between two LODs.
+  static wdUInt32 SelectLod(wdArrayPtr<const Lod> lods, float fScreenSize, wdUInt32 uiCurrentLod, float fHysteresis);
+
   void ComputeBounds();
   const wdBoundingBoxSphere& GetBounds() const;
   void SetBounds(const wdBoundingBoxSphere& bounds) { m_Bounds = bounds; }
@@ -73,6 +97,7 @@ public:
 private:
   wdHybridArray<Material, 8> m_Materials;
   wdHybridArray<SubMesh, 8> m_SubMeshes;
+  wdHybridArray<Lod, 4> m_Lods;
   wdMeshBufferResourceDescriptor m_MeshBufferDescriptor;
   wdMeshBufferResourceHandle m_hMeshBuffer;
   wdBoundingBoxSphere m_Bounds;
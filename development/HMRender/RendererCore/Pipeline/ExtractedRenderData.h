@@ -32,6 +32,11 @@ public:
   void AddRenderData(const wdRenderData* pRenderData, wdRenderData::Category category);
   void AddFrameData(const wdRenderData* pFrameData);
 
+  /// \brief Appends all render data of the given object, e.g. the result of one extraction task.
+  ///
+  /// The sorting keys are not recomputed, so both objects need to use the same camera.
+  void AddRenderData(const wdExtractedRenderData& other);
+
   void SortAndBatch();
 
   void Clear();
@@ -54,6 +59,8 @@ private:
     wdDynamicArray<wdRenderDataBatch::SortableRenderData> m_SortableRenderData;
   };
 
+  static void SortAndBatchCategory(DataPerCategory& ref_dataPerCategory);
+
   wdCamera m_Camera;
   wdCamera m_LodCamera; // Temporary until we have a real LOD system
   wdViewData m_ViewData;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
 class WD_RENDERERCORE_DLL wdExtractor : public wdReflectedClass
@@ -27,6 +29,9 @@ protected:
   bool FilterByViewTags(const wdView& view, const wdGameObject* pObject) const;
 
   /// \brief extracts the render data for the given object.
+  ///
+  /// This function may be called for different objects from multiple threads at the same time, as long as every thread uses its own
+  /// message and extracted render data.
   void ExtractRenderData(const wdView& view, const wdGameObject* pObject, wdMsgExtractRenderData& msg, wdExtractedRenderData& extractedRenderData) const;
 
 private:
@@ -40,8 +45,8 @@ protected:
   wdHybridArray<wdHashedString, 4> m_DependsOn;
 
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-  mutable wdUInt32 m_uiNumCachedRenderData;
-  mutable wdUInt32 m_uiNumUncachedRenderData;
+  mutable wdAtomicInteger32 m_uiNumCachedRenderData;
+  mutable wdAtomicInteger32 m_uiNumUncachedRenderData;
 #endif
 };
 
@@ -55,6 +60,11 @@ public:
   ~wdVisibleObjectsExtractor();
 
   virtual void Extract(const wdView& view, const wdDynamicArray<const wdGameObject*>& visibleObjects, wdExtractedRenderData& ref_extractedRenderData) override;
+
+private:
+  // Large visible sets are extracted in chunks on multiple threads, each chunk into its own buffer. The buffers are merged in order
+  // afterwards and kept around, so that they don't need to grow again every frame.
+  wdDynamicArray<wdExtractedRenderData> m_ChunkRenderData;
 };
 
 class WD_RENDERERCORE_DLL wdSelectedObjectsExtractorBase : public wdExtractor
@@ -1,6 +1,9 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 
 wdExtractedRenderData::wdExtractedRenderData() = default;
@@ -14,58 +17,59 @@ void wdExtractedRenderData::AddRenderData(const wdRenderData* pRenderData, wdRen
   sortableRenderData.m_uiSortingKey = pRenderData->GetCategorySortingKey(category, m_Camera);
 }
 
+void wdExtractedRenderData::AddRenderData(const wdExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (wdUInt32 uiCategory = 0; uiCategory < other.m_DataPerCategory.GetCount(); ++uiCategory)
+  {
+    m_DataPerCategory[uiCategory].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[uiCategory].m_SortableRenderData);
+  }
+
+  for (auto pFrameData : other.m_FrameData)
+  {
+    m_FrameData.PushBack(pFrameData);
+  }
+}
+
 void wdExtractedRenderData::AddFrameData(const wdRenderData* pFrameData)
 {
   m_FrameData.PushBack(pFrameData);
 }
 
+namespace
+{
+  // Below this many render data items per category a comparison sort is faster than the radix sort passes.
+  constexpr wdUInt32 s_uiRadixSortThreshold = 256;
+
+  // Below this many render data items overall it is not worth it to sort the categories in parallel.
+  constexpr wdUInt32 s_uiParallelSortThreshold = 4096;
+} // namespace
+
 void wdExtractedRenderData::SortAndBatch()
 {
   WD_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
-  {
-    WD_FORCE_INLINE bool Less(const wdRenderDataBatch::SortableRenderData& a, const wdRenderDataBatch::SortableRenderData& b) const
-    {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
-      {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
-      }
-
-      return a.m_uiSortingKey < b.m_uiSortingKey;
-    }
-  };
+  wdUInt32 uiTotalCount = 0;
+  wdUInt32 uiNumNonEmptyCategories = 0;
 
   for (auto& dataPerCategory : m_DataPerCategory)
   {
-    if (dataPerCategory.m_SortableRenderData.IsEmpty())
-      continue;
-
-    auto& data = dataPerCategory.m_SortableRenderData;
-
-    // Sort
-    data.Sort(RenderDataComparer());
-
-    // Find batches
-    wdUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
-    wdUInt32 uiCurrentBatchStartIndex = 0;
-    const wdRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+    const wdUInt32 uiCount = dataPerCategory.m_SortableRenderData.GetCount();
+    uiTotalCount += uiCount;
+    uiNumNonEmptyCategories += uiCount > 0 ? 1 : 0;
+  }
 
-    for (wdUInt32 i = 1; i < data.GetCount(); ++i)
+  if (uiTotalCount >= s_uiParallelSortThreshold && uiNumNonEmptyCategories > 1)
+  {
+    wdTaskSystem::ParallelForSingle(m_DataPerCategory.GetArrayPtr(), [](DataPerCategory& dataPerCategory) { SortAndBatchCategory(dataPerCategory); }, "SortAndBatch");
+  }
+  else
+  {
+    for (auto& dataPerCategory : m_DataPerCategory)
     {
-      auto pRenderData = data[i].m_pRenderData;
-
-      if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
-      {
-        dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = wdMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
-
-        uiCurrentBatchId = pRenderData->m_uiBatchId;
-        uiCurrentBatchStartIndex = i;
-        pCurrentBatchType = pRenderData->GetDynamicRTTI();
-      }
+      SortAndBatchCategory(dataPerCategory);
     }
-
-    dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = wdMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
   }
 }
 
@@ -109,4 +113,62 @@ const wdRenderData* wdExtractedRenderData::GetFrameData(const wdRTTI* pRtti) con
   return nullptr;
 }
 
+// static
+void wdExtractedRenderData::SortAndBatchCategory(DataPerCategory& ref_dataPerCategory)
+{
+  if (ref_dataPerCategory.m_SortableRenderData.IsEmpty())
+    return;
+
+  auto& data = ref_dataPerCategory.m_SortableRenderData;
+
+  // Sort by sorting key, then by batch id
+  if (data.GetCount() < s_uiRadixSortThreshold)
+  {
+    struct RenderDataComparer
+    {
+      WD_FORCE_INLINE bool Less(const wdRenderDataBatch::SortableRenderData& a, const wdRenderDataBatch::SortableRenderData& b) const
+      {
+        if (a.m_uiSortingKey == b.m_uiSortingKey)
+        {
+          return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
+        }
+
+        return a.m_uiSortingKey < b.m_uiSortingKey;
+      }
+    };
+
+    data.Sort(RenderDataComparer());
+  }
+  else
+  {
+    wdDynamicArray<wdRenderDataBatch::SortableRenderData> scratch(wdFrameAllocator::GetCurrentAllocator());
+    scratch.SetCountUninitialized(data.GetCount());
+
+    // the radix sort is stable, so sorting by the secondary key first gives the same order as the comparer above
+    wdSorting::RadixSort(data.GetArrayPtr(), scratch.GetArrayPtr(), [](const wdRenderDataBatch::SortableRenderData& d) { return d.m_pRenderData->m_uiBatchId; });
+    wdSorting::RadixSort(data.GetArrayPtr(), scratch.GetArrayPtr(), [](const wdRenderDataBatch::SortableRenderData& d) { return d.m_uiSortingKey; });
+  }
+
+  // Find batches
+  wdUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
+  wdUInt32 uiCurrentBatchStartIndex = 0;
+  const wdRTTI* pCurrentBatchType = data[0].m_pRenderData->GetDynamicRTTI();
+
+  for (wdUInt32 i = 1; i < data.GetCount(); ++i)
+  {
+    auto pRenderData = data[i].m_pRenderData;
+
+    if (pRenderData->m_uiBatchId != uiCurrentBatchId || pRenderData->GetDynamicRTTI() != pCurrentBatchType)
+    {
+      ref_dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = wdMakeArrayPtr(&data[uiCurrentBatchStartIndex], i - uiCurrentBatchStartIndex);
+
+      uiCurrentBatchId = pRenderData->m_uiBatchId;
+      uiCurrentBatchStartIndex = i;
+      pCurrentBatchType = pRenderData->GetDynamicRTTI();
+    }
+  }
+
+  ref_dataPerCategory.m_Batches.ExpandAndGetRef().m_Data = wdMakeArrayPtr(&data[uiCurrentBatchStartIndex], data.GetCount() - uiCurrentBatchStartIndex);
+}
+
 WD_STATICLINK_FILE(RendererCore, RendererCore_Pipeline_Implementation_ExtractedRenderData);
@@ -1,8 +1,10 @@
 #include <RendererCore/RendererCorePCH.h>
 
+#include <Core/World/SpatialSystem_LooseOctree.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/Extractor.h>
@@ -22,23 +24,30 @@ wdCVarBool cvar_SpatialExtractionShowStats("Spatial.Extraction.ShowStats", false
 
 namespace
 {
+  // Visible sets with more objects than this are extracted on multiple threads.
+  constexpr wdUInt32 s_uiExtractionChunkSize = 128;
+
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
   void VisualizeSpatialData(const wdView& view)
   {
     if (cvar_SpatialVisData && cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() && !cvar_SpatialVisDataOnlySelected)
     {
       const wdSpatialSystem& spatialSystem = *view.GetWorld()->GetSpatialSystem();
+      wdSpatialData::Category filterCategory = wdSpatialData::FindCategory(cvar_SpatialVisDataOnlyCategory.GetValue());
+
+      wdHybridArray<wdBoundingBox, 16> boxes;
       if (auto pSpatialSystemGrid = wdDynamicCast<const wdSpatialSystem_RegularGrid*>(&spatialSystem))
       {
-        wdSpatialData::Category filterCategory = wdSpatialData::FindCategory(cvar_SpatialVisDataOnlyCategory.GetValue());
-
-        wdHybridArray<wdBoundingBox, 16> boxes;
         pSpatialSystemGrid->GetAllCellBoxes(boxes, filterCategory);
+      }
+      else if (auto pSpatialSystemOctree = wdDynamicCast<const wdSpatialSystem_LooseOctree*>(&spatialSystem))
+      {
+        pSpatialSystemOctree->GetAllNodeBoxes(boxes, filterCategory);
+      }
 
-        for (auto& box : boxes)
-        {
-          wdDebugRenderer::DrawLineBox(view.GetHandle(), box, wdColor::Cyan);
-        }
+      for (auto& box : boxes)
+      {
+        wdDebugRenderer::DrawLineBox(view.GetHandle(), box, wdColor::Cyan);
       }
     }
   }
@@ -70,13 +79,21 @@ namespace
     if (cvar_SpatialVisData && cvar_SpatialVisDataOnlyCategory.GetValue().IsEmpty())
     {
       const wdSpatialSystem& spatialSystem = *view.GetWorld()->GetSpatialSystem();
+      wdBoundingBox box;
+      wdResult res = WD_FAILURE;
+
       if (auto pSpatialSystemGrid = wdDynamicCast<const wdSpatialSystem_RegularGrid*>(&spatialSystem))
       {
-        wdBoundingBox box;
-        if (pSpatialSystemGrid->GetCellBoxForSpatialData(pObject->GetSpatialData(), box).Succeeded())
-        {
-          wdDebugRenderer::DrawLineBox(view.GetHandle(), box, wdColor::Cyan);
-        }
+        res = pSpatialSystemGrid->GetCellBoxForSpatialData(pObject->GetSpatialData(), box);
+      }
+      else if (auto pSpatialSystemOctree = wdDynamicCast<const wdSpatialSystem_LooseOctree*>(&spatialSystem))
+      {
+        res = pSpatialSystemOctree->GetNodeBoxForSpatialData(pObject->GetSpatialData(), box);
+      }
+
+      if (res.Succeeded())
+      {
+        wdDebugRenderer::DrawLineBox(view.GetHandle(), box, wdColor::Cyan);
       }
     }
   }
@@ -159,7 +176,7 @@ void wdExtractor::ExtractRenderData(const wdView& view, const wdGameObject* pObj
     }
 
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    m_uiNumUncachedRenderData.Add(msg.m_ExtractedRenderData.GetCount());
 #endif
   };
 
@@ -195,7 +212,7 @@ void wdExtractor::ExtractRenderData(const wdView& view, const wdGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != wdInvalidRenderDataCategory ? msg.m_OverrideCategory : wdRenderData::Category(cacheEntry.m_uiCategory));
 
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          m_uiNumCachedRenderData.Increment();
 #endif
         }
         ++uiCacheIndex;
@@ -281,9 +298,6 @@ wdVisibleObjectsExtractor::~wdVisibleObjectsExtractor() = default;
 void wdVisibleObjectsExtractor::Extract(
   const wdView& view, const wdDynamicArray<const wdGameObject*>& visibleObjects, wdExtractedRenderData& ref_extractedRenderData)
 {
-  wdMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   WD_LOCK(view.GetWorld()->GetReadMarker());
 
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
@@ -293,12 +307,61 @@ void wdVisibleObjectsExtractor::Extract(
   m_uiNumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  const wdUInt32 uiNumObjects = visibleObjects.GetCount();
+  const wdUInt32 uiNumChunks = (uiNumObjects + s_uiExtractionChunkSize - 1) / s_uiExtractionChunkSize;
+
+  if (uiNumChunks <= 1)
   {
-    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    wdMsgExtractRenderData msg;
+    msg.m_pView = &view;
+
+    for (auto pObject : visibleObjects)
+    {
+      ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    }
+  }
+  else
+  {
+    m_ChunkRenderData.EnsureCount(uiNumChunks);
+
+    wdParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_NestingMode = wdTaskNesting::Maybe; // components may wait for resources during extraction
+
+    wdTaskSystem::ParallelForIndexed(
+      0u, uiNumChunks,
+      [&](wdUInt32 uiStartChunk, wdUInt32 uiEndChunk) {
+        wdMsgExtractRenderData msg;
+        msg.m_pView = &view;
+
+        for (wdUInt32 uiChunk = uiStartChunk; uiChunk < uiEndChunk; ++uiChunk)
+        {
+          wdExtractedRenderData& chunkRenderData = m_ChunkRenderData[uiChunk];
+          chunkRenderData.SetCamera(ref_extractedRenderData.GetCamera());
+
+          const wdUInt32 uiStartIndex = uiChunk * s_uiExtractionChunkSize;
+          const wdUInt32 uiEndIndex = wdMath::Min(uiStartIndex + s_uiExtractionChunkSize, uiNumObjects);
+
+          for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+          {
+            ExtractRenderData(view, visibleObjects[i], msg, chunkRenderData);
+          }
+        }
+      },
+      "ExtractRenderData", params);
+
+    // merge in chunk order, so that the result is the same as with serial extraction
+    for (wdUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+    {
+      ref_extractedRenderData.AddRenderData(m_ChunkRenderData[uiChunk]);
+      m_ChunkRenderData[uiChunk].Clear();
+    }
+  }
 
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
-    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+  {
+    for (auto pObject : visibleObjects)
     {
       if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
             pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
@@ -307,8 +370,8 @@ void wdVisibleObjectsExtractor::Extract(
         VisualizeObject(view, pObject);
       }
     }
-#endif
   }
+#endif
 
 #if WD_ENABLED(WD_COMPILE_FOR_DEVELOPMENT)
   const bool bIsMainView = (view.GetCameraUsageHint() == wdCameraUsageHint::MainView || view.GetCameraUsageHint() == wdCameraUsageHint::EditorView);
@@ -321,10 +384,10 @@ void wdVisibleObjectsExtractor::Extract(
 
     wdDebugRenderer::DrawInfoText(hView, wdDebugRenderer::ScreenPlacement::TopLeft, "ExtractionStats", "Extraction Stats:");
 
-    sb.Format("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.Format("Num Cached Render Data: {0}", (wdInt32)m_uiNumCachedRenderData);
     wdDebugRenderer::DrawInfoText(hView, wdDebugRenderer::ScreenPlacement::TopLeft, "ExtractionStats", sb);
 
-    sb.Format("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.Format("Num Uncached Render Data: {0}", (wdInt32)m_uiNumUncachedRenderData);
     wdDebugRenderer::DrawInfoText(hView, wdDebugRenderer::ScreenPlacement::TopLeft, "ExtractionStats", sb);
   }
 #endif
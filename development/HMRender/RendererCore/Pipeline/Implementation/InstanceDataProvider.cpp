@@ -26,10 +26,14 @@ wdInstanceData::~wdInstanceData()
 
 void wdInstanceData::BindResources(wdRenderContext* pRenderContext)
 {
+  // called for every render data batch, so the binding slots are only looked up once
+  static const wdShaderBindingSlot s_PerInstanceDataSlot = wdRenderContext::GetBindingSlot("perInstanceData");
+  static const wdShaderBindingSlot s_ObjectConstantsSlot = wdRenderContext::GetBindingSlot("wdObjectConstants");
+
   wdGALDevice* pDevice = wdGALDevice::GetDefaultDevice();
 
-  pRenderContext->BindBuffer("perInstanceData", pDevice->GetDefaultResourceView(m_hInstanceDataBuffer));
-  pRenderContext->BindConstantBuffer("wdObjectConstants", m_hConstantBuffer);
+  pRenderContext->BindBuffer(s_PerInstanceDataSlot, pDevice->GetDefaultResourceView(m_hInstanceDataBuffer));
+  pRenderContext->BindConstantBuffer(s_ObjectConstantsSlot, m_hConstantBuffer);
 }
 
 wdArrayPtr<wdPerInstanceData> wdInstanceData::GetInstanceData(wdUInt32 uiCount, wdUInt32& out_uiOffset)
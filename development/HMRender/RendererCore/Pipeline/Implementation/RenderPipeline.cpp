@@ -998,15 +998,24 @@ void wdRenderPipeline::FindVisibleObjects(const wdView& view)
   {
     WD_PROFILE_SCOPE("Occlusion::FindVisibleObjects");
 
-    auto IsOccluded = [=](const wdSimdBBox& aabb) {
-      // grow the bbox by some percent to counter the lower precision of the occlusion buffer
+    auto IsOccluded = [=](wdArrayPtr<const wdSimdBBox> boxes, wdArrayPtr<bool> out_occluded) {
+      // grow the bboxes by some percent to counter the lower precision of the occlusion buffer
+      const wdSimdVec4f vInflation(1.0f + cvar_SpatialCullingOcclusionBoundsInlation);
 
-      wdSimdBBox aabb2;
-      const wdSimdVec4f c = aabb.GetCenter();
-      const wdSimdVec4f e = aabb.GetHalfExtents();
-      aabb2.SetCenterAndHalfExtents(c, e.CompMul(wdSimdVec4f(1.0f + cvar_SpatialCullingOcclusionBoundsInlation)));
+      wdHybridArray<wdSimdBBox, 32> inflatedBoxes;
+      inflatedBoxes.SetCountUninitialized(boxes.GetCount());
 
-      return !pRasterizer->IsVisible(aabb2);
+      for (wdUInt32 i = 0; i < boxes.GetCount(); ++i)
+      {
+        inflatedBoxes[i].SetCenterAndHalfExtents(boxes[i].GetCenter(), boxes[i].GetHalfExtents().CompMul(vInflation));
+      }
+
+      pRasterizer->IsVisible(inflatedBoxes.GetArrayPtr(), out_occluded);
+
+      for (bool& bOccluded : out_occluded)
+      {
+        bOccluded = !bOccluded;
+      }
     };
 
     m_VisibleObjects.Clear();
@@ -5,13 +5,24 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
 #include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
 #include <RendererCore/Rasterizer/Thirdparty/Rasterizer.h>
 
 wdCVarInt cvar_SpatialCullingOcclusionMaxResolution("Spatial.Occlusion.MaxResolution", 512, wdCVarFlags::Default, "Max resolution for occlusion buffers.");
-wdCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, wdCVarFlags::Default, "Max number of occluders to rasterize per frame.");
+wdCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, wdCVarFlags::Default, "Max number of on-screen occluders to rasterize per frame. Occluders that end up hidden behind closer ones still count towards this limit.");
+
+namespace
+{
+  // Height of a tile in 8x8 pixel blocks. Tiles are rasterized in parallel, each one only touches the depth buffer rows that it covers.
+  // Every tile transforms all occluders that overlap it again, so smaller tiles cost more in total.
+  constexpr wdUInt32 s_uiOcclusionTileBlockRows = 8;
+
+  // With fewer occluders the overhead of the tasks outweighs the gain.
+  constexpr wdUInt32 s_uiMinOccludersForParallelRasterization = 4;
+} // namespace
 
 wdRasterizerView::wdRasterizerView() = default;
 wdRasterizerView::~wdRasterizerView() = default;
@@ -64,41 +75,118 @@ void wdRasterizerView::EndScene()
   UpdateViewProjectionMatrix();
 
   // only rasterize a limited number of the closest objects
-  RasterizeObjects(cvar_SpatialCullingOcclusionMaxOccluders);
+  BinObjects(cvar_SpatialCullingOcclusionMaxOccluders);
+
+  RasterizeObjects();
 
   m_Instances.Clear();
+  m_BinnedObjects.Clear();
 
   m_pRasterizer->setModelViewProjection(m_mViewProjection.m_fElementsCM);
 }
 
-void wdRasterizerView::RasterizeObjects(wdUInt32 uiMaxObjects)
+void wdRasterizerView::BinObjects(wdUInt32 uiMaxObjects)
 {
 #if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
 
-  WD_PROFILE_SCOPE("Occlusion::RasterizeObjects");
+  WD_PROFILE_SCOPE("Occlusion::BinObjects");
+
+  m_BinnedObjects.Clear();
+
+  const wdUInt32 uiNumBlocksY = m_pRasterizer->getBlocksY();
 
   for (const Instance& inst : m_Instances)
   {
-    ApplyModelViewProjectionMatrix(inst.m_Transform);
+    if (m_BinnedObjects.GetCount() >= uiMaxObjects)
+      break;
 
-    bool bNeedsClipping;
+    const wdMat4 mMVP = m_mViewProjection * inst.m_Transform.GetAsMat4();
     const Occluder& occluder = inst.m_pObject->m_Occluder;
 
-    if (m_pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping))
+    float fBakedMVP[16];
+    m_pRasterizer->bakeModelViewProjection(mMVP.m_fElementsCM, fBakedMVP);
+
+    Rasterizer::ScreenBounds bounds;
+    if (!m_pRasterizer->computeScreenBounds(fBakedMVP, occluder.m_boundsMin, occluder.m_boundsMax, bounds))
+      continue;
+
+    BinnedObject& bin = m_BinnedObjects.ExpandAndGetRef();
+    wdMemoryUtils::Copy(bin.m_fBakedModelViewProjection, fBakedMVP, 16);
+    bin.m_pObject = inst.m_pObject;
+    bin.m_uiMinX = bounds.minX;
+    bin.m_uiMaxX = bounds.maxX;
+    bin.m_uiMinY = bounds.minY;
+    bin.m_uiMaxY = bounds.maxY;
+    bin.m_uiMinBlockY = bounds.minY / 8;
+    bin.m_uiMaxBlockY = wdMath::Min(bounds.maxY / 8 + 1, uiNumBlocksY);
+    bin.m_uiMaxZ = bounds.maxZ;
+    bin.m_bNeedsClipping = bounds.needsClipping;
+  }
+
+  m_bAnyOccludersRasterized = !m_BinnedObjects.IsEmpty();
+#endif
+}
+
+void wdRasterizerView::RasterizeObjects()
+{
+#if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
+
+  if (m_BinnedObjects.IsEmpty())
+    return;
+
+  WD_PROFILE_SCOPE("Occlusion::RasterizeObjects");
+
+  const wdUInt32 uiNumBlocksY = m_pRasterizer->getBlocksY();
+
+  if (m_BinnedObjects.GetCount() < s_uiMinOccludersForParallelRasterization)
+  {
+    RasterizeTile(0, uiNumBlocksY);
+    return;
+  }
+
+  const wdUInt32 uiNumTiles = (uiNumBlocksY + s_uiOcclusionTileBlockRows - 1) / s_uiOcclusionTileBlockRows;
+
+  wdParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_NestingMode = wdTaskNesting::Maybe;
+
+  wdTaskSystem::ParallelForIndexed(
+    0u, uiNumTiles,
+    [this, uiNumBlocksY](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+      const wdUInt32 uiMinBlockY = uiStartIndex * s_uiOcclusionTileBlockRows;
+      const wdUInt32 uiMaxBlockY = wdMath::Min(uiEndIndex * s_uiOcclusionTileBlockRows, uiNumBlocksY);
+
+      RasterizeTile(uiMinBlockY, uiMaxBlockY);
+    },
+    "Occlusion::RasterizeTiles", params);
+#endif
+}
+
+void wdRasterizerView::RasterizeTile(wdUInt32 uiMinBlockY, wdUInt32 uiMaxBlockY)
+{
+#if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
+
+  const wdUInt32 uiMinPixelY = uiMinBlockY * 8;
+  const wdUInt32 uiMaxPixelY = uiMaxBlockY * 8 - 1;
+
+  // the objects are sorted front to back, so an object that is hidden within this tile doesn't need to be rasterized here
+  for (const BinnedObject& bin : m_BinnedObjects)
+  {
+    if (bin.m_uiMaxBlockY <= uiMinBlockY || bin.m_uiMinBlockY >= uiMaxBlockY)
+      continue;
+
+    const Occluder& occluder = bin.m_pObject->m_Occluder;
+
+    if (bin.m_bNeedsClipping)
+    {
+      m_pRasterizer->rasterize<true>(occluder, bin.m_fBakedModelViewProjection, uiMinBlockY, uiMaxBlockY);
+    }
+    else
     {
-      m_bAnyOccludersRasterized = true;
-
-      if (bNeedsClipping)
-      {
-        m_pRasterizer->rasterize<true>(occluder);
-      }
-      else
-      {
-        m_pRasterizer->rasterize<false>(occluder);
-      }
-
-      if (--uiMaxObjects == 0)
-        return;
+      if (!m_pRasterizer->query2D(bin.m_uiMinX, bin.m_uiMaxX, wdMath::Max(bin.m_uiMinY, uiMinPixelY), wdMath::Min(bin.m_uiMaxY, uiMaxPixelY), bin.m_uiMaxZ))
+        continue;
+
+      m_pRasterizer->rasterize<false>(occluder, bin.m_fBakedModelViewProjection, uiMinBlockY, uiMaxBlockY);
     }
   }
 #endif
@@ -112,14 +200,6 @@ void wdRasterizerView::UpdateViewProjectionMatrix()
   m_mViewProjection = mProjection * m_pCamera->GetViewMatrix();
 }
 
-void wdRasterizerView::ApplyModelViewProjectionMatrix(const wdTransform& modelTransform)
-{
-  const wdMat4 mModel = modelTransform.GetAsMat4();
-  const wdMat4 mMVP = m_mViewProjection * mModel;
-
-  m_pRasterizer->setModelViewProjection(mMVP.m_fElementsCM);
-}
-
 void wdRasterizerView::SortObjectsFrontToBack()
 {
 #if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
@@ -158,6 +238,30 @@ bool wdRasterizerView::IsVisible(const wdSimdBBox& aabb) const
 #endif
 }
 
+wdUInt32 wdRasterizerView::IsVisible(wdArrayPtr<const wdSimdBBox> boxes, wdArrayPtr<bool> out_visible) const
+{
+  WD_ASSERT_DEV(out_visible.GetCount() >= boxes.GetCount(), "Output array is too small.");
+
+#if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
+  if (m_bAnyOccludersRasterized && !boxes.IsEmpty())
+  {
+    WD_PROFILE_SCOPE("Occlusion::IsVisibleBatch");
+
+    // the rasterizer reads the boxes as min / max pairs and ignores W itself
+    WD_CHECK_AT_COMPILETIME(sizeof(wdSimdBBox) == 2 * sizeof(__m128));
+
+    return m_pRasterizer->queryVisibilityBatch(reinterpret_cast<const __m128*>(boxes.GetPtr()), boxes.GetCount(), out_visible.GetPtr());
+  }
+#endif
+
+  for (wdUInt32 i = 0; i < boxes.GetCount(); ++i)
+  {
+    out_visible[i] = true;
+  }
+
+  return boxes.GetCount();
+}
+
 wdRasterizerView* wdRasterizerViewPool::GetRasterizerView(wdUInt32 uiWidth, wdUInt32 uiHeight, float fAspectRatio)
 {
   WD_PROFILE_SCOPE("Occlusion::GetViewFromPool");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Transform.h>
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/ArrayPtr.h>
@@ -30,6 +31,8 @@ public:
   void BeginScene();
 
   /// \brief Finishes rasterizing the scene. Visibility queries only work after this.
+  ///
+  /// The closest occluders are binned into horizontal tiles of the depth buffer, which are then rasterized in parallel.
   void EndScene();
 
   /// \brief Writes an RGBA8 representation of the depth values to targetBuffer.
@@ -56,6 +59,13 @@ public:
   /// Note: This only works after EndScene().
   bool IsVisible(const wdSimdBBox& aabb) const;
 
+  /// \brief Checks a whole batch of boxes at once and writes whether each one is visible into out_visible.
+  ///
+  /// Saves the per box call overhead and loads the view-projection matrix only once, every box is still projected on its own.
+  /// Returns the number of visible boxes.
+  /// Note: This only works after EndScene().
+  wdUInt32 IsVisible(wdArrayPtr<const wdSimdBBox> boxes, wdArrayPtr<bool> out_visible) const;
+
   /// \brief Wether any occluder was actually added and also rasterized. If not, no need to do any visibility checks.
   bool HasRasterizedAnyOccluders() const
   {
@@ -64,9 +74,10 @@ public:
 
 private:
   void SortObjectsFrontToBack();
-  void RasterizeObjects(wdUInt32 uiMaxObjects);
+  void BinObjects(wdUInt32 uiMaxObjects);
+  void RasterizeObjects();
+  void RasterizeTile(wdUInt32 uiMinBlockY, wdUInt32 uiMaxBlockY);
   void UpdateViewProjectionMatrix();
-  void ApplyModelViewProjectionMatrix(const wdTransform& modelTransform);
 
   bool m_bAnyOccludersRasterized = false;
   const wdCamera* m_pCamera = nullptr;
@@ -81,7 +92,25 @@ private:
     const wdRasterizerObject* m_pObject;
   };
 
+  /// An on-screen occluder with its final matrix and the screen area that it may cover.
+  struct BinnedObject
+  {
+    WD_DECLARE_POD_TYPE();
+
+    float m_fBakedModelViewProjection[16];
+    const wdRasterizerObject* m_pObject;
+    wdUInt32 m_uiMinX;
+    wdUInt32 m_uiMaxX;
+    wdUInt32 m_uiMinY;
+    wdUInt32 m_uiMaxY;
+    wdUInt32 m_uiMinBlockY;
+    wdUInt32 m_uiMaxBlockY;
+    wdUInt16 m_uiMaxZ;
+    bool m_bNeedsClipping;
+  };
+
   wdDeque<Instance> m_Instances;
+  wdDynamicArray<BinnedObject> m_BinnedObjects;
   wdMat4 m_mViewProjection;
 };
 
@@ -317,6 +317,18 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _mm_storeu_ps(m_modelViewProjectionRaw + 8, mat2);
   _mm_storeu_ps(m_modelViewProjectionRaw + 12, mat3);
 
+  bakeModelViewProjection(matrix, m_modelViewProjection);
+}
+
+void Rasterizer::bakeModelViewProjection(const float* matrix, float* bakedMatrix) const
+{
+  __m128 mat0 = _mm_loadu_ps(matrix + 0);
+  __m128 mat1 = _mm_loadu_ps(matrix + 4);
+  __m128 mat2 = _mm_loadu_ps(matrix + 8);
+  __m128 mat3 = _mm_loadu_ps(matrix + 12);
+
+  _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
+
   // Bake viewport transform into matrix and 6shift by half a block
   mat0 = _mm_mul_ps(_mm_add_ps(mat0, mat3), _mm_set1_ps(m_width * 0.5f - 4.0f));
   mat1 = _mm_mul_ps(_mm_add_ps(mat1, mat3), _mm_set1_ps(m_height * 0.5f - 4.0f));
@@ -327,10 +339,10 @@ void Rasterizer::setModelViewProjection(const float* matrix)
   _MM_TRANSPOSE4_PS(mat0, mat1, mat2, mat3);
 
   // Store prebaked cols
-  _mm_storeu_ps(m_modelViewProjection + 0, mat0);
-  _mm_storeu_ps(m_modelViewProjection + 4, mat1);
-  _mm_storeu_ps(m_modelViewProjection + 8, mat2);
-  _mm_storeu_ps(m_modelViewProjection + 12, mat3);
+  _mm_storeu_ps(bakedMatrix + 0, mat0);
+  _mm_storeu_ps(bakedMatrix + 4, mat1);
+  _mm_storeu_ps(bakedMatrix + 8, mat2);
+  _mm_storeu_ps(bakedMatrix + 12, mat3);
 }
 
 void Rasterizer::clear()
@@ -350,6 +362,62 @@ void Rasterizer::clear()
 }
 
 bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping)
+{
+  ScreenBounds bounds;
+  if (!computeScreenBounds(m_modelViewProjection, boundsMin, boundsMax, bounds))
+  {
+    needsClipping = false;
+    return false;
+  }
+
+  needsClipping = bounds.needsClipping;
+  if (needsClipping)
+  {
+    return true;
+  }
+
+  return query2D(bounds.minX, bounds.maxX, bounds.minY, bounds.maxY, bounds.maxZ);
+}
+
+uint32_t Rasterizer::queryVisibilityBatch(const __m128* boundsMinMax, uint32_t count, bool* visible) const
+{
+  // The SW rasterizer requires W to be 1
+  const __m128 one = _mm_set1_ps(1.0f);
+
+  // The matrix is the same for all boxes, so it is only loaded once
+  const __m128 bakedCols[4] = {_mm_loadu_ps(m_modelViewProjection + 0), _mm_loadu_ps(m_modelViewProjection + 4), _mm_loadu_ps(m_modelViewProjection + 8), _mm_loadu_ps(m_modelViewProjection + 12)};
+
+  uint32_t numVisible = 0;
+
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    const __m128 boundsMin = _mm_blend_ps(boundsMinMax[2 * i + 0], one, 0x8);
+    const __m128 boundsMax = _mm_blend_ps(boundsMinMax[2 * i + 1], one, 0x8);
+
+    ScreenBounds bounds;
+    bool isVisible = false;
+
+    if (computeScreenBounds(bakedCols, boundsMin, boundsMax, bounds))
+    {
+      isVisible = bounds.needsClipping || query2D(bounds.minX, bounds.maxX, bounds.minY, bounds.maxY, bounds.maxZ);
+    }
+
+    visible[i] = isVisible;
+    numVisible += isVisible ? 1 : 0;
+  }
+
+  return numVisible;
+}
+
+bool Rasterizer::computeScreenBounds(const float* bakedMatrix, __m128 boundsMin, __m128 boundsMax, ScreenBounds& bounds) const
+{
+  // Load prebaked projection matrix
+  const __m128 bakedCols[4] = {_mm_loadu_ps(bakedMatrix + 0), _mm_loadu_ps(bakedMatrix + 4), _mm_loadu_ps(bakedMatrix + 8), _mm_loadu_ps(bakedMatrix + 12)};
+
+  return computeScreenBounds(bakedCols, boundsMin, boundsMax, bounds);
+}
+
+bool Rasterizer::computeScreenBounds(const __m128* bakedCols, __m128 boundsMin, __m128 boundsMax, ScreenBounds& bounds) const
 {
   // Frustum culling is not necessary, because EZ only calls this functions for objects that are definitely inside the frustum
   //
@@ -397,11 +465,10 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   //   return false;
   // }
 
-  // Load prebaked projection matrix
-  __m128 col0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 col1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 col2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 col3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  const __m128 col0 = bakedCols[0];
+  const __m128 col1 = bakedCols[1];
+  const __m128 col2 = bakedCols[2];
+  const __m128 col3 = bakedCols[3];
 
   // Transform edges
   __m128 egde0 = _mm_mul_ps(col0, _mm_broadcastss_ps(extents));
@@ -439,12 +506,15 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   __m128 closeToNearPlane = _mm_or_ps(_mm_cmplt_ps(corners[3], nearPlaneEpsilon), _mm_cmplt_ps(corners[7], nearPlaneEpsilon));
   if (!_mm_testz_ps(closeToNearPlane, closeToNearPlane))
   {
-    needsClipping = true;
+    bounds.minX = 0;
+    bounds.maxX = m_width - 1;
+    bounds.minY = 0;
+    bounds.maxY = m_height - 1;
+    bounds.maxZ = 0xFFFF;
+    bounds.needsClipping = true;
     return true;
   }
 
-  needsClipping = false;
-
   // Perspective division
   corners[3] = _mm_rcp_ps(corners[3]);
   corners[0] = _mm_mul_ps(corners[0], corners[3]);
@@ -487,32 +557,27 @@ bool Rasterizer::queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needs
   __m128i boundsI = _mm_cvttps_epi32(_mm_round_ps(boundsF, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
 
   // Store as scalars
-  int bounds[4];
-  _mm_storeu_si128(reinterpret_cast<__m128i*>(&bounds), boundsI);
+  int boundsI32[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&boundsI32), boundsI);
 
   // Revert the sign change we did for the maxes
-  bounds[1] = -bounds[1];
-  bounds[3] = -bounds[3];
+  boundsI32[1] = -boundsI32[1];
+  boundsI32[3] = -boundsI32[3];
 
   // No intersection between quad and screen area
-  if (bounds[0] >= bounds[1] || bounds[2] >= bounds[3])
+  if (boundsI32[0] >= boundsI32[1] || boundsI32[2] >= boundsI32[3])
   {
     return false;
   }
 
-  uint32_t minX = bounds[0];
-  uint32_t maxX = bounds[1];
-  uint32_t minY = bounds[2];
-  uint32_t maxY = bounds[3];
-
   __m128i depth = packDepthPremultiplied(corners[2], corners[6]);
 
-  uint16_t maxZ = uint16_t(0xFFFF ^ _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(depth, _mm_set1_epi16(-1))), 0));
-
-  if (!query2D(minX, maxX, minY, maxY, maxZ))
-  {
-    return false;
-  }
+  bounds.minX = boundsI32[0];
+  bounds.maxX = boundsI32[1];
+  bounds.minY = boundsI32[2];
+  bounds.maxY = boundsI32[3];
+  bounds.maxZ = uint16_t(0xFFFF ^ _mm_extract_epi16(_mm_minpos_epu16(_mm_xor_si128(depth, _mm_set1_epi16(-1))), 0));
+  bounds.needsClipping = false;
 
   return true;
 }
@@ -854,6 +919,12 @@ void Rasterizer::precomputeRasterizationTable()
 
 template <bool possiblyNearClipped>
 void Rasterizer::rasterize(const Occluder& occluder)
+{
+  rasterize<possiblyNearClipped>(occluder, m_modelViewProjection, 0, m_blocksY);
+}
+
+template <bool possiblyNearClipped>
+void Rasterizer::rasterize(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY)
 {
   const __m256i* vertexData = occluder.m_vertexData;
   size_t packetCount = occluder.m_packetCount;
@@ -862,10 +933,10 @@ void Rasterizer::rasterize(const Occluder& occluder)
   __m256i maskZ = _mm256_set1_epi32(1023);
 
   // Note that unaligned loads do not have a latency penalty on CPUs with SSE4 support
-  __m128 mat0 = _mm_loadu_ps(m_modelViewProjection + 0);
-  __m128 mat1 = _mm_loadu_ps(m_modelViewProjection + 4);
-  __m128 mat2 = _mm_loadu_ps(m_modelViewProjection + 8);
-  __m128 mat3 = _mm_loadu_ps(m_modelViewProjection + 12);
+  __m128 mat0 = _mm_loadu_ps(bakedMatrix + 0);
+  __m128 mat1 = _mm_loadu_ps(bakedMatrix + 4);
+  __m128 mat2 = _mm_loadu_ps(bakedMatrix + 8);
+  __m128 mat3 = _mm_loadu_ps(bakedMatrix + 12);
 
   __m128 boundsMin = occluder.m_refMin;
   __m128 boundsExtents = _mm_sub_ps(occluder.m_refMax, boundsMin);
@@ -1170,9 +1241,9 @@ void Rasterizer::rasterize(const Occluder& occluder)
     // Clamp and round
     __m256i minX, minY, maxX, maxY;
     minX = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFx, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
-    minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_setzero_si256());
+    minY = _mm256_max_epi32(_mm256_cvttps_epi32(_mm256_add_ps(minFy, _mm256_set1_ps(4.9999f / 8.0f))), _mm256_set1_epi32(minBlockY));
     maxX = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFx, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksX));
-    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(m_blocksY));
+    maxY = _mm256_min_epi32(_mm256_cvttps_epi32(_mm256_add_ps(maxFy, _mm256_set1_ps(11.0f / 8.0f))), _mm256_set1_epi32(maxBlockY));
 
     // Check overlap between bounding box and frustum
     __m256i inFrustum = _mm256_and_si256(_mm256_cmpgt_epi32(maxX, minX), _mm256_cmpgt_epi32(maxY, minY));
@@ -1546,6 +1617,8 @@ void Rasterizer::rasterize(const Occluder& occluder)
 // Force template instantiations
 template void Rasterizer::rasterize<true>(const Occluder& occluder);
 template void Rasterizer::rasterize<false>(const Occluder& occluder);
+template void Rasterizer::rasterize<true>(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY);
+template void Rasterizer::rasterize<false>(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY);
 
 #endif
 
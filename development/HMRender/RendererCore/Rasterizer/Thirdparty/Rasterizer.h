@@ -13,17 +13,49 @@ class Rasterizer
 {
 public:
 #if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
+  /// Conservative screen space rectangle (in pixels, inclusive) and maximum depth of a projected bounding box.
+  struct ScreenBounds
+  {
+    uint32_t minX;
+    uint32_t maxX;
+    uint32_t minY;
+    uint32_t maxY;
+    uint16_t maxZ;
+    bool needsClipping;
+  };
+
   Rasterizer(uint32_t width, uint32_t height);
   void setModelViewProjection(const float* matrix);
   void clear();
 
+  /// Converts a column major model-view-projection matrix into the prebaked form that rasterize() and computeScreenBounds() expect.
+  void bakeModelViewProjection(const float* matrix, float* bakedMatrix) const;
+
   template <bool possiblyNearClipped>
   void rasterize(const Occluder& occluder);
 
+  /// Rasterizes only the block rows [minBlockY, maxBlockY) of the occluder. Different threads may rasterize different,
+  /// non-overlapping row ranges at the same time, since each one only reads and writes the depth and Hi-Z data of its own rows.
+  template <bool possiblyNearClipped>
+  void rasterize(const Occluder& occluder, const float* bakedMatrix, uint32_t minBlockY, uint32_t maxBlockY);
+
   bool queryVisibility(__m128 boundsMin, __m128 boundsMax, bool& needsClipping);
 
+  /// Tests count boxes against the current depth buffer, using the matrix from the last setModelViewProjection() call.
+  /// The boxes are given as interleaved min / max pairs, the W components are ignored. Returns the number of visible boxes.
+  /// The matrix is loaded once for the whole batch, each box is then projected with SIMD across its corners like in queryVisibility().
+  uint32_t queryVisibilityBatch(const __m128* boundsMinMax, uint32_t count, bool* visible) const;
+
+  /// Returns false if the box does not overlap the screen. Boxes that need clipping cover the whole screen.
+  bool computeScreenBounds(const float* bakedMatrix, __m128 boundsMin, __m128 boundsMax, ScreenBounds& bounds) const;
+
+  /// Same as above, but takes the four columns of an already loaded prebaked matrix.
+  bool computeScreenBounds(const __m128* bakedCols, __m128 boundsMin, __m128 boundsMax, ScreenBounds& bounds) const;
+
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const;
 
+  uint32_t getBlocksY() const { return m_blocksY; }
+
   void readBackDepth(void* target) const;
 #else
   Rasterizer(uint32_t width, uint32_t height)
@@ -43,6 +75,16 @@ public:
     return true;
   }
 
+  uint32_t queryVisibilityBatch(const void* pBoundsMinMax, uint32_t uiCount, bool* pVisible) const
+  {
+    for (uint32_t i = 0; i < uiCount; ++i)
+    {
+      pVisible[i] = true;
+    }
+
+    return uiCount;
+  }
+
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const
   {
     return true;
@@ -57,6 +57,48 @@ WD_BEGIN_SUBSYSTEM_DECLARATION(RendererCore, RendererContext)
 WD_END_SUBSYSTEM_DECLARATION;
 // clang-format on
 
+namespace
+{
+  // Material state blocks that haven't been used for this many frames are removed from the cache.
+  constexpr wdUInt64 s_uiMaxUnusedStateBlockFrames = 60;
+
+  template <typename T>
+  WD_ALWAYS_INLINE T GetBoundValue(const wdDynamicArray<T>& boundValues, wdShaderBindingSlot slot)
+  {
+    return slot.m_uiIndex < boundValues.GetCount() ? boundValues[slot.m_uiIndex] : T();
+  }
+
+  // Returns false if the value was already bound to the given slot.
+  template <typename T>
+  bool SetBoundValue(wdDynamicArray<T>& ref_boundValues, wdShaderBindingSlot slot, const T& value, wdRenderContext::Statistics& ref_statistics)
+  {
+    WD_ASSERT_DEBUG(slot.IsValid(), "Invalid binding slot");
+
+    ++ref_statistics.m_uiBindCalls;
+
+    if (slot.m_uiIndex >= ref_boundValues.GetCount())
+    {
+      if (value == T())
+      {
+        ++ref_statistics.m_uiRedundantBindCalls;
+        return false;
+      }
+
+      ref_boundValues.SetCount(slot.m_uiIndex + 1);
+    }
+
+    T& boundValue = ref_boundValues[slot.m_uiIndex];
+    if (boundValue == value)
+    {
+      ++ref_statistics.m_uiRedundantBindCalls;
+      return false;
+    }
+
+    boundValue = value;
+    return true;
+  }
+} // namespace
+
 //////////////////////////////////////////////////////////////////////////
 
 wdRenderContext::Statistics::Statistics()
@@ -67,6 +109,15 @@ wdRenderContext::Statistics::Statistics()
 void wdRenderContext::Statistics::Reset()
 {
   m_uiFailedDrawcalls = 0;
+
+  m_uiBindCalls = 0;
+  m_uiRedundantBindCalls = 0;
+  m_uiApplyCalls = 0;
+  m_uiAppliedBindings = 0;
+
+  m_uiStateBlockHits = 0;
+  m_uiStateBlockMisses = 0;
+  m_uiSkippedStateBlocks = 0;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -122,7 +173,7 @@ wdRenderContext::~wdRenderContext()
 wdRenderContext::Statistics wdRenderContext::GetAndResetStatistics()
 {
   wdRenderContext::Statistics ret = m_Statistics;
-  ret.Reset();
+  m_Statistics.Reset();
 
   return ret;
 }
@@ -237,197 +288,182 @@ void wdRenderContext::BindMaterial(const wdMaterialResourceHandle& hMaterial)
 
 void wdRenderContext::BindTexture2D(const wdTempHashedString& sSlotName, const wdTexture2DResourceHandle& hTexture,
   wdResourceAcquireMode acquireMode /*= wdResourceAcquireMode::AllowLoadingFallback*/)
+{
+  BindTexture2D(ResolveBindingSlot(sSlotName), hTexture, acquireMode);
+}
+
+void wdRenderContext::BindTexture3D(const wdTempHashedString& sSlotName, const wdTexture3DResourceHandle& hTexture,
+  wdResourceAcquireMode acquireMode /*= wdResourceAcquireMode::AllowLoadingFallback*/)
+{
+  BindTexture3D(ResolveBindingSlot(sSlotName), hTexture, acquireMode);
+}
+
+void wdRenderContext::BindTextureCube(const wdTempHashedString& sSlotName, const wdTextureCubeResourceHandle& hTexture,
+  wdResourceAcquireMode acquireMode /*= wdResourceAcquireMode::AllowLoadingFallback*/)
+{
+  BindTextureCube(ResolveBindingSlot(sSlotName), hTexture, acquireMode);
+}
+
+void wdRenderContext::BindTexture2D(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+{
+  BindTexture2D(ResolveBindingSlot(sSlotName), hResourceView);
+}
+
+void wdRenderContext::BindTexture3D(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+{
+  BindTexture3D(ResolveBindingSlot(sSlotName), hResourceView);
+}
+
+void wdRenderContext::BindTextureCube(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+{
+  BindTextureCube(ResolveBindingSlot(sSlotName), hResourceView);
+}
+
+void wdRenderContext::BindUAV(const wdTempHashedString& sSlotName, wdGALUnorderedAccessViewHandle hUnorderedAccessView)
+{
+  BindUAV(ResolveBindingSlot(sSlotName), hUnorderedAccessView);
+}
+
+void wdRenderContext::BindSamplerState(const wdTempHashedString& sSlotName, wdGALSamplerStateHandle hSamplerSate)
+{
+  WD_ASSERT_DEBUG(sSlotName != "LinearSampler", "'LinearSampler' is a resevered sampler name and must not be set manually.");
+  WD_ASSERT_DEBUG(sSlotName != "LinearClampSampler", "'LinearClampSampler' is a resevered sampler name and must not be set manually.");
+  WD_ASSERT_DEBUG(sSlotName != "PointSampler", "'PointSampler' is a resevered sampler name and must not be set manually.");
+  WD_ASSERT_DEBUG(sSlotName != "PointClampSampler", "'PointClampSampler' is a resevered sampler name and must not be set manually.");
+
+  BindSamplerState(ResolveBindingSlot(sSlotName), hSamplerSate);
+}
+
+void wdRenderContext::BindBuffer(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+{
+  BindBuffer(ResolveBindingSlot(sSlotName), hResourceView);
+}
+
+void wdRenderContext::BindConstantBuffer(const wdTempHashedString& sSlotName, wdGALBufferHandle hConstantBuffer)
+{
+  BindConstantBuffer(ResolveBindingSlot(sSlotName), hConstantBuffer);
+}
+
+void wdRenderContext::BindConstantBuffer(const wdTempHashedString& sSlotName, wdConstantBufferStorageHandle hConstantBufferStorage)
+{
+  BindConstantBuffer(ResolveBindingSlot(sSlotName), hConstantBufferStorage);
+}
+
+void wdRenderContext::BindTexture2D(wdShaderBindingSlot slot, const wdTexture2DResourceHandle& hTexture,
+  wdResourceAcquireMode acquireMode /*= wdResourceAcquireMode::AllowLoadingFallback*/)
 {
   if (hTexture.IsValid())
   {
     wdResourceLock<wdTexture2DResource> pTexture(hTexture, acquireMode);
-    BindTexture2D(sSlotName, wdGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture()));
-    BindSamplerState(sSlotName, pTexture->GetGALSamplerState());
+    BindTexture2D(slot, wdGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture()));
+    BindSamplerState(slot, pTexture->GetGALSamplerState());
   }
   else
   {
-    BindTexture2D(sSlotName, wdGALResourceViewHandle());
+    BindTexture2D(slot, wdGALResourceViewHandle());
   }
 }
 
-void wdRenderContext::BindTexture3D(const wdTempHashedString& sSlotName, const wdTexture3DResourceHandle& hTexture,
+void wdRenderContext::BindTexture3D(wdShaderBindingSlot slot, const wdTexture3DResourceHandle& hTexture,
   wdResourceAcquireMode acquireMode /*= wdResourceAcquireMode::AllowLoadingFallback*/)
 {
   if (hTexture.IsValid())
   {
     wdResourceLock<wdTexture3DResource> pTexture(hTexture, acquireMode);
-    BindTexture3D(sSlotName, wdGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture()));
-    BindSamplerState(sSlotName, pTexture->GetGALSamplerState());
+    BindTexture3D(slot, wdGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture()));
+    BindSamplerState(slot, pTexture->GetGALSamplerState());
   }
   else
   {
-    BindTexture3D(sSlotName, wdGALResourceViewHandle());
+    BindTexture3D(slot, wdGALResourceViewHandle());
   }
 }
 
-void wdRenderContext::BindTextureCube(const wdTempHashedString& sSlotName, const wdTextureCubeResourceHandle& hTexture,
+void wdRenderContext::BindTextureCube(wdShaderBindingSlot slot, const wdTextureCubeResourceHandle& hTexture,
   wdResourceAcquireMode acquireMode /*= wdResourceAcquireMode::AllowLoadingFallback*/)
 {
   if (hTexture.IsValid())
   {
     wdResourceLock<wdTextureCubeResource> pTexture(hTexture, acquireMode);
-    BindTextureCube(sSlotName, wdGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture()));
-    BindSamplerState(sSlotName, pTexture->GetGALSamplerState());
+    BindTextureCube(slot, wdGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture()));
+    BindSamplerState(slot, pTexture->GetGALSamplerState());
   }
   else
   {
-    BindTextureCube(sSlotName, wdGALResourceViewHandle());
+    BindTextureCube(slot, wdGALResourceViewHandle());
   }
 }
 
-void wdRenderContext::BindTexture2D(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+void wdRenderContext::BindTexture2D(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView)
 {
-  wdGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundTextures2D.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundTextures2D.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundValue(m_BoundTextures2D, slot, hResourceView, m_Statistics))
+    return;
 
+  // the textures that were bound by the last material state block might have been replaced
+  m_uiAppliedStateBlockKey = 0;
   m_StateFlags.Add(wdRenderContextFlags::TextureBindingChanged);
 }
 
-void wdRenderContext::BindTexture3D(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+void wdRenderContext::BindTexture3D(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView)
 {
-  wdGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundTextures3D.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundTextures3D.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundValue(m_BoundTextures3D, slot, hResourceView, m_Statistics))
+    return;
 
   m_StateFlags.Add(wdRenderContextFlags::TextureBindingChanged);
 }
 
-void wdRenderContext::BindTextureCube(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+void wdRenderContext::BindTextureCube(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView)
 {
-  wdGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundTexturesCube.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundTexturesCube.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundValue(m_BoundTexturesCube, slot, hResourceView, m_Statistics))
+    return;
 
+  m_uiAppliedStateBlockKey = 0;
   m_StateFlags.Add(wdRenderContextFlags::TextureBindingChanged);
 }
 
-void wdRenderContext::BindUAV(const wdTempHashedString& sSlotName, wdGALUnorderedAccessViewHandle hUnorderedAccessView)
+void wdRenderContext::BindUAV(wdShaderBindingSlot slot, wdGALUnorderedAccessViewHandle hUnorderedAccessView)
 {
-  wdGALUnorderedAccessViewHandle* pOldResourceView = nullptr;
-  if (m_BoundUAVs.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hUnorderedAccessView)
-      return;
-
-    *pOldResourceView = hUnorderedAccessView;
-  }
-  else
-  {
-    m_BoundUAVs.Insert(sSlotName.GetHash(), hUnorderedAccessView);
-  }
+  if (!SetBoundValue(m_BoundUAVs, slot, hUnorderedAccessView, m_Statistics))
+    return;
 
   m_StateFlags.Add(wdRenderContextFlags::UAVBindingChanged);
 }
 
-
-void wdRenderContext::BindSamplerState(const wdTempHashedString& sSlotName, wdGALSamplerStateHandle hSamplerSate)
+void wdRenderContext::BindSamplerState(wdShaderBindingSlot slot, wdGALSamplerStateHandle hSamplerSate)
 {
-  WD_ASSERT_DEBUG(sSlotName != "LinearSampler", "'LinearSampler' is a resevered sampler name and must not be set manually.");
-  WD_ASSERT_DEBUG(sSlotName != "LinearClampSampler", "'LinearClampSampler' is a resevered sampler name and must not be set manually.");
-  WD_ASSERT_DEBUG(sSlotName != "PointSampler", "'PointSampler' is a resevered sampler name and must not be set manually.");
-  WD_ASSERT_DEBUG(sSlotName != "PointClampSampler", "'PointClampSampler' is a resevered sampler name and must not be set manually.");
-
-  wdGALSamplerStateHandle* pOldSamplerState = nullptr;
-  if (m_BoundSamplers.TryGetValue(sSlotName.GetHash(), pOldSamplerState))
-  {
-    if (*pOldSamplerState == hSamplerSate)
-      return;
-
-    *pOldSamplerState = hSamplerSate;
-  }
-  else
-  {
-    m_BoundSamplers.Insert(sSlotName.GetHash(), hSamplerSate);
-  }
+  if (!SetBoundValue(m_BoundSamplers, slot, hSamplerSate, m_Statistics))
+    return;
 
+  m_uiAppliedStateBlockKey = 0;
   m_StateFlags.Add(wdRenderContextFlags::SamplerBindingChanged);
 }
 
-void wdRenderContext::BindBuffer(const wdTempHashedString& sSlotName, wdGALResourceViewHandle hResourceView)
+void wdRenderContext::BindBuffer(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView)
 {
-  wdGALResourceViewHandle* pOldResourceView = nullptr;
-  if (m_BoundBuffer.TryGetValue(sSlotName.GetHash(), pOldResourceView))
-  {
-    if (*pOldResourceView == hResourceView)
-      return;
-
-    *pOldResourceView = hResourceView;
-  }
-  else
-  {
-    m_BoundBuffer.Insert(sSlotName.GetHash(), hResourceView);
-  }
+  if (!SetBoundValue(m_BoundBuffer, slot, hResourceView, m_Statistics))
+    return;
 
   m_StateFlags.Add(wdRenderContextFlags::BufferBindingChanged);
 }
 
-void wdRenderContext::BindConstantBuffer(const wdTempHashedString& sSlotName, wdGALBufferHandle hConstantBuffer)
+void wdRenderContext::BindConstantBuffer(wdShaderBindingSlot slot, wdGALBufferHandle hConstantBuffer)
 {
-  BoundConstantBuffer* pBoundConstantBuffer = nullptr;
-  if (m_BoundConstantBuffers.TryGetValue(sSlotName.GetHash(), pBoundConstantBuffer))
-  {
-    if (pBoundConstantBuffer->m_hConstantBuffer == hConstantBuffer)
-      return;
+  if (!SetBoundValue(m_BoundConstantBuffers, slot, BoundConstantBuffer(hConstantBuffer), m_Statistics))
+    return;
 
-    pBoundConstantBuffer->m_hConstantBuffer = hConstantBuffer;
-    pBoundConstantBuffer->m_hConstantBufferStorage.Invalidate();
-  }
-  else
-  {
-    m_BoundConstantBuffers.Insert(sSlotName.GetHash(), BoundConstantBuffer(hConstantBuffer));
-  }
+  if (!m_UsedConstantBufferSlots.Contains(slot))
+    m_UsedConstantBufferSlots.PushBack(slot);
 
   m_StateFlags.Add(wdRenderContextFlags::ConstantBufferBindingChanged);
 }
 
-void wdRenderContext::BindConstantBuffer(const wdTempHashedString& sSlotName, wdConstantBufferStorageHandle hConstantBufferStorage)
+void wdRenderContext::BindConstantBuffer(wdShaderBindingSlot slot, wdConstantBufferStorageHandle hConstantBufferStorage)
 {
-  BoundConstantBuffer* pBoundConstantBuffer = nullptr;
-  if (m_BoundConstantBuffers.TryGetValue(sSlotName.GetHash(), pBoundConstantBuffer))
-  {
-    if (pBoundConstantBuffer->m_hConstantBufferStorage == hConstantBufferStorage)
-      return;
+  if (!SetBoundValue(m_BoundConstantBuffers, slot, BoundConstantBuffer(hConstantBufferStorage), m_Statistics))
+    return;
 
-    pBoundConstantBuffer->m_hConstantBuffer.Invalidate();
-    pBoundConstantBuffer->m_hConstantBufferStorage = hConstantBufferStorage;
-  }
-  else
-  {
-    m_BoundConstantBuffers.Insert(sSlotName.GetHash(), BoundConstantBuffer(hConstantBufferStorage));
-  }
+  if (!m_UsedConstantBufferSlots.Contains(slot))
+    m_UsedConstantBufferSlots.PushBack(slot);
 
   m_StateFlags.Add(wdRenderContextFlags::ConstantBufferBindingChanged);
 }
@@ -564,6 +600,8 @@ wdResult wdRenderContext::Dispatch(wdUInt32 uiThreadGroupCountX, wdUInt32 uiThre
 
 wdResult wdRenderContext::ApplyContextStates(bool bForce)
 {
+  ++m_Statistics.m_uiApplyCalls;
+
   // First apply material state since this can modify all other states.
   // Note ApplyMaterialState only returns a valid material pointer if the constant buffer of this material needs to be updated.
   // This needs to be done once we have determined the correct shader permutation.
@@ -598,7 +636,7 @@ wdResult wdRenderContext::ApplyContextStates(bool bForce)
   {
     if ((bForce || m_StateFlags.IsAnySet(wdRenderContextFlags::TextureBindingChanged | wdRenderContextFlags::UAVBindingChanged |
                                          wdRenderContextFlags::SamplerBindingChanged | wdRenderContextFlags::BufferBindingChanged |
-                                         wdRenderContextFlags::ConstantBufferBindingChanged)))
+                                         wdRenderContextFlags::ConstantBufferBindingChanged | wdRenderContextFlags::MaterialTexturesChanged)))
     {
       if (pShaderPermutation == nullptr)
         pShaderPermutation = wdResourceManager::BeginAcquireResource(m_hActiveShaderPermutation, wdResourceAcquireMode::BlockTillLoaded);
@@ -606,77 +644,58 @@ wdResult wdRenderContext::ApplyContextStates(bool bForce)
 
     wdLogBlock applyBindingsBlock("Applying Shader Bindings", pShaderPermutation != nullptr ? pShaderPermutation->GetResourceDescription().GetData() : "");
 
-    if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::UAVBindingChanged))
+    // The material textures depend on the shader permutation, so they can only be bound once the permutation is known.
+    if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::MaterialTexturesChanged))
     {
-      // RWTextures/UAV are usually only supported in compute and pixel shader.
-      if (auto pBin = pShaderPermutation->GetShaderStageBinary(wdGALShaderStage::ComputeShader))
-      {
-        ApplyUAVBindings(pBin);
-      }
-      if (auto pBin = pShaderPermutation->GetShaderStageBinary(wdGALShaderStage::PixelShader))
+      if (m_hMaterial.IsValid())
       {
-        ApplyUAVBindings(pBin);
+        ApplyMaterialStateBlock(pShaderPermutation);
       }
 
+      m_StateFlags.Remove(wdRenderContextFlags::MaterialTexturesChanged);
+    }
+
+    if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::UAVBindingChanged))
+    {
+      ApplyUAVBindings(pShaderPermutation->GetBindingLayout());
+
       m_StateFlags.Remove(wdRenderContextFlags::UAVBindingChanged);
     }
 
     if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::TextureBindingChanged))
     {
-      for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((wdGALShaderStage::Enum)stage))
-        {
-          ApplyTextureBindings((wdGALShaderStage::Enum)stage, pBin);
-        }
-      }
+      ApplyTextureBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(wdRenderContextFlags::TextureBindingChanged);
     }
 
     if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::SamplerBindingChanged))
     {
-      for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((wdGALShaderStage::Enum)stage))
-        {
-          ApplySamplerBindings((wdGALShaderStage::Enum)stage, pBin);
-        }
-      }
+      ApplySamplerBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(wdRenderContextFlags::SamplerBindingChanged);
     }
 
     if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::BufferBindingChanged))
     {
-      for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((wdGALShaderStage::Enum)stage))
-        {
-          ApplyBufferBindings((wdGALShaderStage::Enum)stage, pBin);
-        }
-      }
+      ApplyBufferBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(wdRenderContextFlags::BufferBindingChanged);
     }
 
     if (pMaterial != nullptr)
     {
+      static const wdShaderBindingSlot s_MaterialConstantsSlot = GetBindingSlot("wdMaterialConstants");
+
       pMaterial->UpdateConstantBuffer(pShaderPermutation);
-      BindConstantBuffer("wdMaterialConstants", pMaterial->m_hConstantBufferStorage);
+      BindConstantBuffer(s_MaterialConstantsSlot, pMaterial->m_hConstantBufferStorage);
     }
 
     UploadConstants();
 
     if (bForce || m_StateFlags.IsSet(wdRenderContextFlags::ConstantBufferBindingChanged))
     {
-      for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
-      {
-        if (auto pBin = pShaderPermutation->GetShaderStageBinary((wdGALShaderStage::Enum)stage))
-        {
-          ApplyConstantBufferBindings(pBin);
-        }
-      }
+      ApplyConstantBufferBindings(pShaderPermutation->GetBindingLayout());
 
       m_StateFlags.Remove(wdRenderContextFlags::ConstantBufferBindingChanged);
     }
@@ -746,14 +765,44 @@ void wdRenderContext::ResetContextState()
   m_BoundTexturesCube.Clear();
   m_BoundBuffer.Clear();
 
+  static const wdShaderBindingSlot s_DefaultSamplerSlots[] = {
+    GetBindingSlot("LinearSampler"),
+    GetBindingSlot("LinearClampSampler"),
+    GetBindingSlot("PointSampler"),
+    GetBindingSlot("PointClampSampler"),
+  };
+
   m_BoundSamplers.Clear();
-  m_BoundSamplers.Insert(wdHashingUtils::StringHash("LinearSampler"), GetDefaultSamplerState(wdDefaultSamplerFlags::LinearFiltering));
-  m_BoundSamplers.Insert(wdHashingUtils::StringHash("LinearClampSampler"), GetDefaultSamplerState(wdDefaultSamplerFlags::LinearFiltering | wdDefaultSamplerFlags::Clamp));
-  m_BoundSamplers.Insert(wdHashingUtils::StringHash("PointSampler"), GetDefaultSamplerState(wdDefaultSamplerFlags::PointFiltering));
-  m_BoundSamplers.Insert(wdHashingUtils::StringHash("PointClampSampler"), GetDefaultSamplerState(wdDefaultSamplerFlags::PointFiltering | wdDefaultSamplerFlags::Clamp));
+  BindSamplerState(s_DefaultSamplerSlots[0], GetDefaultSamplerState(wdDefaultSamplerFlags::LinearFiltering));
+  BindSamplerState(s_DefaultSamplerSlots[1], GetDefaultSamplerState(wdDefaultSamplerFlags::LinearFiltering | wdDefaultSamplerFlags::Clamp));
+  BindSamplerState(s_DefaultSamplerSlots[2], GetDefaultSamplerState(wdDefaultSamplerFlags::PointFiltering));
+  BindSamplerState(s_DefaultSamplerSlots[3], GetDefaultSamplerState(wdDefaultSamplerFlags::PointFiltering | wdDefaultSamplerFlags::Clamp));
 
   m_BoundUAVs.Clear();
   m_BoundConstantBuffers.Clear();
+  m_UsedConstantBufferSlots.Clear();
+
+  m_uiAppliedStateBlockKey = 0;
+  m_uiAppliedStateBlockVersion = 0;
+
+  // The state blocks stay valid across frames, since they are validated against the material and shader permutation in ApplyMaterialStateBlock.
+  const wdUInt64 uiFrameCounter = wdRenderWorld::GetFrameCounter();
+  if (m_uiLastStateBlockCleanupFrame != uiFrameCounter)
+  {
+    m_uiLastStateBlockCleanupFrame = uiFrameCounter;
+
+    for (auto it = m_MaterialStateBlocks.GetIterator(); it.IsValid();)
+    {
+      if (it.Value().m_uiLastUsedFrame + s_uiMaxUnusedStateBlockFrames < uiFrameCounter)
+      {
+        it = m_MaterialStateBlocks.Remove(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
 }
 
 wdGlobalConstants& wdRenderContext::WriteGlobalConstants()
@@ -1026,11 +1075,12 @@ wdResult wdRenderContext::BuildVertexDeclaration(wdGALShaderHandle hShader, cons
 
 void wdRenderContext::UploadConstants()
 {
-  BindConstantBuffer("wdGlobalConstants", m_hGlobalConstantBufferStorage);
+  static const wdShaderBindingSlot s_GlobalConstantsSlot = GetBindingSlot("wdGlobalConstants");
+  BindConstantBuffer(s_GlobalConstantsSlot, m_hGlobalConstantBufferStorage);
 
-  for (auto it = m_BoundConstantBuffers.GetIterator(); it.IsValid(); ++it)
+  for (wdShaderBindingSlot slot : m_UsedConstantBufferSlots)
   {
-    wdConstantBufferStorageHandle hConstantBufferStorage = it.Value().m_hConstantBufferStorage;
+    wdConstantBufferStorageHandle hConstantBufferStorage = m_BoundConstantBuffers[slot.m_uiIndex].m_hConstantBufferStorage;
     wdConstantBufferStorageBase* pConstantBufferStorage = nullptr;
     if (TryGetConstantBufferStorage(hConstantBufferStorage, pConstantBufferStorage))
     {
@@ -1067,7 +1117,8 @@ wdShaderPermutationResource* wdRenderContext::ApplyShaderState()
   m_hActiveGALShader.Invalidate();
 
   m_StateFlags.Add(wdRenderContextFlags::TextureBindingChanged | wdRenderContextFlags::SamplerBindingChanged |
-                   wdRenderContextFlags::BufferBindingChanged | wdRenderContextFlags::ConstantBufferBindingChanged);
+                   wdRenderContextFlags::BufferBindingChanged | wdRenderContextFlags::ConstantBufferBindingChanged |
+                   wdRenderContextFlags::MaterialTexturesChanged);
 
   if (!m_hActiveShader.IsValid())
     return nullptr;
@@ -1128,7 +1179,8 @@ wdMaterialResource* wdRenderContext::ApplyMaterialState()
 
     if (!pMaterial->m_hConstantBufferStorage.IsInvalidated())
     {
-      BindConstantBuffer("wdMaterialConstants", pMaterial->m_hConstantBufferStorage);
+      static const wdShaderBindingSlot s_MaterialConstantsSlot = GetBindingSlot("wdMaterialConstants");
+      BindConstantBuffer(s_MaterialConstantsSlot, pMaterial->m_hConstantBufferStorage);
     }
 
     for (auto it = pCachedValues->m_PermutationVars.GetIterator(); it.IsValid(); ++it)
@@ -1136,15 +1188,8 @@ wdMaterialResource* wdRenderContext::ApplyMaterialState()
       SetShaderPermutationVariableInternal(it.Key(), it.Value());
     }
 
-    for (auto it = pCachedValues->m_Texture2DBindings.GetIterator(); it.IsValid(); ++it)
-    {
-      BindTexture2D(it.Key(), it.Value());
-    }
-
-    for (auto it = pCachedValues->m_TextureCubeBindings.GetIterator(); it.IsValid(); ++it)
-    {
-      BindTextureCube(it.Key(), it.Value());
-    }
+    // The textures are bound through a state block once the shader permutation is known, see ApplyMaterialStateBlock.
+    m_StateFlags.Add(wdRenderContextFlags::MaterialTexturesChanged);
 
     m_hMaterial = m_hNewMaterial;
   }
@@ -1162,126 +1207,187 @@ wdMaterialResource* wdRenderContext::ApplyMaterialState()
   return nullptr;
 }
 
-void wdRenderContext::ApplyConstantBufferBindings(const wdShaderStageBinary* pBinary)
+void wdRenderContext::ApplyMaterialStateBlock(const wdShaderPermutationResource* pShaderPermutation)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  wdMaterialResource* pMaterial = wdResourceManager::BeginAcquireResource(m_hMaterial, wdResourceAcquireMode::AllowLoadingFallback);
+  WD_SCOPE_EXIT(wdResourceManager::EndAcquireResource(pMaterial));
+
+  const wdUInt64 uiHashes[] = {m_hActiveShaderPermutation.GetResourceIDHash(), m_hMaterial.GetResourceIDHash()};
+  const wdUInt64 uiKey = wdHashingUtils::xxHash64(uiHashes, sizeof(uiHashes));
+
+  // Modifying the material changes its generation, reloading the material or the shader permutation changes their resource change counter.
+  const wdUInt32 uiVersions[] = {static_cast<wdUInt32>(pMaterial->m_iLastUpdated), pMaterial->GetCurrentResourceChangeCounter(), pShaderPermutation->GetCurrentResourceChangeCounter()};
+  const wdUInt64 uiVersion = wdHashingUtils::xxHash64(uiVersions, sizeof(uiVersions));
+
+  // Nothing has been bound to the texture slots since this state block was applied.
+  if (m_uiAppliedStateBlockKey == uiKey && m_uiAppliedStateBlockVersion == uiVersion)
   {
-    if (binding.m_Type != wdShaderResourceType::ConstantBuffer)
-      continue;
+    ++m_Statistics.m_uiSkippedStateBlocks;
+    return;
+  }
 
-    const wdUInt64 uiResourceHash = binding.m_sName.GetHash();
+  bool bExisted = false;
+  MaterialStateBlock& stateBlock = m_MaterialStateBlocks.FindOrAdd(uiKey, &bExisted);
+  stateBlock.m_uiLastUsedFrame = wdRenderWorld::GetFrameCounter();
+
+  if (bExisted && stateBlock.m_uiContentVersion == uiVersion)
+  {
+    ++m_Statistics.m_uiStateBlockHits;
+  }
+  else
+  {
+    ++m_Statistics.m_uiStateBlockMisses;
+
+    // Only the textures that are actually used by the shader permutation end up in the state block.
+    auto pCachedValues = pMaterial->GetOrUpdateCachedValues();
+    const wdShaderBindingLayout& layout = pShaderPermutation->GetBindingLayout();
 
-    BoundConstantBuffer boundConstantBuffer;
-    if (!m_BoundConstantBuffers.TryGetValue(uiResourceHash, boundConstantBuffer))
+    stateBlock.m_uiContentVersion = uiVersion;
+    stateBlock.m_Textures2D.Clear();
+    stateBlock.m_TexturesCube.Clear();
+
+    for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::Texture2D))
     {
-      // If the shader was compiled with debug info the shader compiler will not strip unused resources and
-      // thus this error would trigger although the shader doesn't actually uses the resource.
-      if (!pBinary->m_bWasCompiledWithDebug)
+      wdTexture2DResourceHandle hTexture;
+      if (pCachedValues->m_Texture2DBindings.TryGetValue(binding.m_sName, hTexture) &&
+          !stateBlock.m_Textures2D.Contains({binding.m_Slot, hTexture}))
       {
-        wdLog::Error("No resource is bound for constant buffer slot '{0}'", binding.m_sName);
+        stateBlock.m_Textures2D.PushBack({binding.m_Slot, hTexture});
       }
-      m_pGALCommandEncoder->SetConstantBuffer(binding.m_iSlot, wdGALBufferHandle());
-      continue;
     }
 
-    if (!boundConstantBuffer.m_hConstantBuffer.IsInvalidated())
-    {
-      m_pGALCommandEncoder->SetConstantBuffer(binding.m_iSlot, boundConstantBuffer.m_hConstantBuffer);
-    }
-    else
+    for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::TextureCube))
     {
-      wdConstantBufferStorageBase* pConstantBufferStorage = nullptr;
-      if (TryGetConstantBufferStorage(boundConstantBuffer.m_hConstantBufferStorage, pConstantBufferStorage))
-      {
-        m_pGALCommandEncoder->SetConstantBuffer(binding.m_iSlot, pConstantBufferStorage->GetGALBufferHandle());
-      }
-      else
+      wdTextureCubeResourceHandle hTexture;
+      if (pCachedValues->m_TextureCubeBindings.TryGetValue(binding.m_sName, hTexture) &&
+          !stateBlock.m_TexturesCube.Contains({binding.m_Slot, hTexture}))
       {
-        wdLog::Error("Invalid constant buffer storage is bound for slot '{0}'", binding.m_sName);
-        m_pGALCommandEncoder->SetConstantBuffer(binding.m_iSlot, wdGALBufferHandle());
+        stateBlock.m_TexturesCube.PushBack({binding.m_Slot, hTexture});
       }
     }
   }
+
+  for (const auto& textureBinding : stateBlock.m_Textures2D)
+  {
+    BindTexture2D(textureBinding.m_Slot, textureBinding.m_hTexture);
+  }
+
+  for (const auto& textureBinding : stateBlock.m_TexturesCube)
+  {
+    BindTextureCube(textureBinding.m_Slot, textureBinding.m_hTexture);
+  }
+
+  // the bind calls above reset the applied key, so it has to be set afterwards
+  m_uiAppliedStateBlockKey = uiKey;
+  m_uiAppliedStateBlockVersion = uiVersion;
 }
 
-void wdRenderContext::ApplyTextureBindings(wdGALShaderStage::Enum stage, const wdShaderStageBinary* pBinary)
+void wdRenderContext::ApplyConstantBufferBindings(const wdShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::ConstantBuffer))
   {
-    // we currently only support 2D and cube textures
+    ++m_Statistics.m_uiAppliedBindings;
 
-    const wdUInt64 uiResourceHash = binding.m_sName.GetHash();
-    wdGALResourceViewHandle hResourceView;
+    const BoundConstantBuffer boundConstantBuffer = GetBoundValue(m_BoundConstantBuffers, binding.m_Slot);
 
-    if (binding.m_Type >= wdShaderResourceType::Texture2D && binding.m_Type <= wdShaderResourceType::Texture2DMSArray)
+    if (!boundConstantBuffer.m_hConstantBuffer.IsInvalidated())
     {
-      m_BoundTextures2D.TryGetValue(uiResourceHash, hResourceView);
-      m_pGALCommandEncoder->SetResourceView(stage, binding.m_iSlot, hResourceView);
+      m_pGALCommandEncoder->SetConstantBuffer(binding.m_uiGALSlot, boundConstantBuffer.m_hConstantBuffer);
     }
-
-    if (binding.m_Type == wdShaderResourceType::Texture3D)
+    else if (!boundConstantBuffer.m_hConstantBufferStorage.IsInvalidated())
     {
-      m_BoundTextures3D.TryGetValue(uiResourceHash, hResourceView);
-      m_pGALCommandEncoder->SetResourceView(stage, binding.m_iSlot, hResourceView);
+      wdConstantBufferStorageBase* pConstantBufferStorage = nullptr;
+      if (TryGetConstantBufferStorage(boundConstantBuffer.m_hConstantBufferStorage, pConstantBufferStorage))
+      {
+        m_pGALCommandEncoder->SetConstantBuffer(binding.m_uiGALSlot, pConstantBufferStorage->GetGALBufferHandle());
+      }
+      else
+      {
+        wdLog::Error("Invalid constant buffer storage is bound for slot '{0}'", binding.m_sName);
+        m_pGALCommandEncoder->SetConstantBuffer(binding.m_uiGALSlot, wdGALBufferHandle());
+      }
     }
-
-    if (binding.m_Type >= wdShaderResourceType::TextureCube && binding.m_Type <= wdShaderResourceType::TextureCubeArray)
+    else
     {
-      m_BoundTexturesCube.TryGetValue(uiResourceHash, hResourceView);
-      m_pGALCommandEncoder->SetResourceView(stage, binding.m_iSlot, hResourceView);
+      // If the shader was compiled with debug info the shader compiler will not strip unused resources and
+      // thus this error would trigger although the shader doesn't actually uses the resource.
+      if (!layout.WasCompiledWithDebug())
+      {
+        wdLog::Error("No resource is bound for constant buffer slot '{0}'", binding.m_sName);
+      }
+      m_pGALCommandEncoder->SetConstantBuffer(binding.m_uiGALSlot, wdGALBufferHandle());
     }
   }
 }
 
-void wdRenderContext::ApplyUAVBindings(const wdShaderStageBinary* pBinary)
+void wdRenderContext::ApplyTextureBindings(const wdShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::Texture2D))
   {
-    if (binding.m_Type != wdShaderResourceType::UAV)
-      continue;
-
-    const wdUInt64 uiResourceHash = binding.m_sName.GetHash();
+    m_pGALCommandEncoder->SetResourceView(binding.m_Stage, binding.m_uiGALSlot, GetBoundValue(m_BoundTextures2D, binding.m_Slot));
+  }
 
-    wdGALUnorderedAccessViewHandle hResourceView;
-    m_BoundUAVs.TryGetValue(uiResourceHash, hResourceView);
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::Texture3D))
+  {
+    m_pGALCommandEncoder->SetResourceView(binding.m_Stage, binding.m_uiGALSlot, GetBoundValue(m_BoundTextures3D, binding.m_Slot));
+  }
 
-    m_pGALCommandEncoder->SetUnorderedAccessView(binding.m_iSlot, hResourceView);
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::TextureCube))
+  {
+    m_pGALCommandEncoder->SetResourceView(binding.m_Stage, binding.m_uiGALSlot, GetBoundValue(m_BoundTexturesCube, binding.m_Slot));
   }
+
+  m_Statistics.m_uiAppliedBindings += layout.GetBindings(wdShaderBindingLayout::BindingType::Texture2D).GetCount() +
+                                      layout.GetBindings(wdShaderBindingLayout::BindingType::Texture3D).GetCount() +
+                                      layout.GetBindings(wdShaderBindingLayout::BindingType::TextureCube).GetCount();
 }
 
-void wdRenderContext::ApplySamplerBindings(wdGALShaderStage::Enum stage, const wdShaderStageBinary* pBinary)
+void wdRenderContext::ApplyUAVBindings(const wdShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::UAV))
   {
-    if (binding.m_Type != wdShaderResourceType::Sampler)
-      continue;
+    m_pGALCommandEncoder->SetUnorderedAccessView(binding.m_uiGALSlot, GetBoundValue(m_BoundUAVs, binding.m_Slot));
+  }
 
-    const wdUInt64 uiResourceHash = binding.m_sName.GetHash();
+  m_Statistics.m_uiAppliedBindings += layout.GetBindings(wdShaderBindingLayout::BindingType::UAV).GetCount();
+}
 
-    wdGALSamplerStateHandle hSamplerState;
-    if (!m_BoundSamplers.TryGetValue(uiResourceHash, hSamplerState))
+void wdRenderContext::ApplySamplerBindings(const wdShaderBindingLayout& layout)
+{
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::Sampler))
+  {
+    wdGALSamplerStateHandle hSamplerState = GetBoundValue(m_BoundSamplers, binding.m_Slot);
+    if (hSamplerState.IsInvalidated())
     {
       hSamplerState = GetDefaultSamplerState(wdDefaultSamplerFlags::LinearFiltering); // Bind a default state to avoid DX11 errors.
     }
 
-    m_pGALCommandEncoder->SetSamplerState(stage, binding.m_iSlot, hSamplerState);
+    m_pGALCommandEncoder->SetSamplerState(binding.m_Stage, binding.m_uiGALSlot, hSamplerState);
   }
+
+  m_Statistics.m_uiAppliedBindings += layout.GetBindings(wdShaderBindingLayout::BindingType::Sampler).GetCount();
 }
 
-void wdRenderContext::ApplyBufferBindings(wdGALShaderStage::Enum stage, const wdShaderStageBinary* pBinary)
+void wdRenderContext::ApplyBufferBindings(const wdShaderBindingLayout& layout)
 {
-  for (const auto& binding : pBinary->m_ShaderResourceBindings)
+  for (const auto& binding : layout.GetBindings(wdShaderBindingLayout::BindingType::Buffer))
   {
-    if (binding.m_Type != wdShaderResourceType::GenericBuffer)
-      continue;
-
-    const wdUInt64 uiResourceHash = binding.m_sName.GetHash();
+    m_pGALCommandEncoder->SetResourceView(binding.m_Stage, binding.m_uiGALSlot, GetBoundValue(m_BoundBuffer, binding.m_Slot));
+  }
 
-    wdGALResourceViewHandle hResourceView;
-    m_BoundBuffer.TryGetValue(uiResourceHash, hResourceView);
+  m_Statistics.m_uiAppliedBindings += layout.GetBindings(wdShaderBindingLayout::BindingType::Buffer).GetCount();
+}
 
-    m_pGALCommandEncoder->SetResourceView(stage, binding.m_iSlot, hResourceView);
+wdShaderBindingSlot wdRenderContext::ResolveBindingSlot(const wdTempHashedString& sSlotName)
+{
+  wdShaderBindingSlot slot;
+  if (!m_BindingSlotCache.TryGetValue(sSlotName.GetHash(), slot))
+  {
+    slot = wdShaderBindingLayout::GetSlot(sSlotName);
+    m_BindingSlotCache.Insert(sSlotName.GetHash(), slot);
   }
+
+  return slot;
 }
 
 void wdRenderContext::SetDefaultTextureFilter(wdTextureFilterSetting::Enum filter)
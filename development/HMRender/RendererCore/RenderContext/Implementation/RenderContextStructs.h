@@ -57,6 +57,7 @@ struct WD_RENDERERCORE_DLL wdRenderContextFlags
     ConstantBufferBindingChanged = WD_BIT(5),
     MeshBufferBindingChanged = WD_BIT(6),
     MaterialBindingChanged = WD_BIT(7),
+    MaterialTexturesChanged = WD_BIT(8),
 
     AllStatesInvalid = ShaderStateChanged | TextureBindingChanged | UAVBindingChanged | SamplerBindingChanged | BufferBindingChanged |
                        ConstantBufferBindingChanged | MeshBufferBindingChanged,
@@ -73,6 +74,7 @@ struct WD_RENDERERCORE_DLL wdRenderContextFlags
     StorageType ConstantBufferBindingChanged : 1;
     StorageType MeshBufferBindingChanged : 1;
     StorageType MaterialBindingChanged : 1;
+    StorageType MaterialTexturesChanged : 1;
   };
 };
 
@@ -8,6 +8,7 @@
 #include <RendererCore/Pipeline/ViewData.h>
 #include <RendererCore/RenderContext/Implementation/RenderContextStructs.h>
 #include <RendererCore/Shader/ConstantBufferStorage.h>
+#include <RendererCore/Shader/ShaderBindingLayout.h>
 #include <RendererCore/Shader/ShaderStageBinary.h>
 #include <RendererCore/ShaderCompiler/PermutationGenerator.h>
 #include <RendererCore/Textures/Texture2DResource.h>
@@ -50,6 +51,15 @@ public:
     void Reset();
 
     wdUInt32 m_uiFailedDrawcalls;
+
+    wdUInt32 m_uiBindCalls;          ///< Number of resource bind calls, including the ones issued for material textures.
+    wdUInt32 m_uiRedundantBindCalls; ///< Bind calls that were ignored because the same resource was already bound.
+    wdUInt32 m_uiApplyCalls;         ///< Number of times the context states were applied, i.e. draw and dispatch calls.
+    wdUInt32 m_uiAppliedBindings;    ///< Number of resource bindings that were passed to the command encoder.
+
+    wdUInt32 m_uiStateBlockHits;     ///< Material state blocks that were taken from the cache.
+    wdUInt32 m_uiStateBlockMisses;   ///< Material state blocks that had to be built from the material and the shader binding layout.
+    wdUInt32 m_uiSkippedStateBlocks; ///< Material state blocks that were not applied since they were already active.
   };
 
   Statistics GetAndResetStatistics();
@@ -146,6 +156,12 @@ public:
 
   void BindMaterial(const wdMaterialResourceHandle& hMaterial);
 
+  /// \brief Returns the binding slot for the given resource name.
+  ///
+  /// All Bind functions are also available with a binding slot instead of a name. Code that binds resources for every draw call
+  /// should look up the slot once and use those overloads, which avoids the name lookup.
+  static wdShaderBindingSlot GetBindingSlot(const wdTempHashedString& sSlotName) { return wdShaderBindingLayout::GetSlot(sSlotName); }
+
   void BindTexture2D(const wdTempHashedString& sSlotName, const wdTexture2DResourceHandle& hTexture, wdResourceAcquireMode acquireMode = wdResourceAcquireMode::AllowLoadingFallback);
   void BindTexture3D(const wdTempHashedString& sSlotName, const wdTexture3DResourceHandle& hTexture, wdResourceAcquireMode acquireMode = wdResourceAcquireMode::AllowLoadingFallback);
   void BindTextureCube(const wdTempHashedString& sSlotName, const wdTextureCubeResourceHandle& hTexture, wdResourceAcquireMode acquireMode = wdResourceAcquireMode::AllowLoadingFallback);
@@ -164,6 +180,23 @@ public:
   void BindConstantBuffer(const wdTempHashedString& sSlotName, wdGALBufferHandle hConstantBuffer);
   void BindConstantBuffer(const wdTempHashedString& sSlotName, wdConstantBufferStorageHandle hConstantBufferStorage);
 
+  void BindTexture2D(wdShaderBindingSlot slot, const wdTexture2DResourceHandle& hTexture, wdResourceAcquireMode acquireMode = wdResourceAcquireMode::AllowLoadingFallback);
+  void BindTexture3D(wdShaderBindingSlot slot, const wdTexture3DResourceHandle& hTexture, wdResourceAcquireMode acquireMode = wdResourceAcquireMode::AllowLoadingFallback);
+  void BindTextureCube(wdShaderBindingSlot slot, const wdTextureCubeResourceHandle& hTexture, wdResourceAcquireMode acquireMode = wdResourceAcquireMode::AllowLoadingFallback);
+
+  void BindTexture2D(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView);
+  void BindTexture3D(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView);
+  void BindTextureCube(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView);
+
+  void BindUAV(wdShaderBindingSlot slot, wdGALUnorderedAccessViewHandle hUnorderedAccessViewHandle);
+
+  void BindSamplerState(wdShaderBindingSlot slot, wdGALSamplerStateHandle hSamplerSate);
+
+  void BindBuffer(wdShaderBindingSlot slot, wdGALResourceViewHandle hResourceView);
+
+  void BindConstantBuffer(wdShaderBindingSlot slot, wdGALBufferHandle hConstantBuffer);
+  void BindConstantBuffer(wdShaderBindingSlot slot, wdConstantBufferStorageHandle hConstantBufferStorage);
+
   /// \brief Sets the currently active shader on the given render context.
   ///
   /// This function has no effect until the next draw or dispatch call on the context.
@@ -293,12 +326,13 @@ private:
   bool m_bAllowAsyncShaderLoading;
   bool m_bStereoRendering = false;
 
-  wdHashTable<wdUInt64, wdGALResourceViewHandle> m_BoundTextures2D;
-  wdHashTable<wdUInt64, wdGALResourceViewHandle> m_BoundTextures3D;
-  wdHashTable<wdUInt64, wdGALResourceViewHandle> m_BoundTexturesCube;
-  wdHashTable<wdUInt64, wdGALUnorderedAccessViewHandle> m_BoundUAVs;
-  wdHashTable<wdUInt64, wdGALSamplerStateHandle> m_BoundSamplers;
-  wdHashTable<wdUInt64, wdGALResourceViewHandle> m_BoundBuffer;
+  // Bound resources are indexed by binding slot, unbound slots contain invalid handles.
+  wdDynamicArray<wdGALResourceViewHandle> m_BoundTextures2D;
+  wdDynamicArray<wdGALResourceViewHandle> m_BoundTextures3D;
+  wdDynamicArray<wdGALResourceViewHandle> m_BoundTexturesCube;
+  wdDynamicArray<wdGALUnorderedAccessViewHandle> m_BoundUAVs;
+  wdDynamicArray<wdGALSamplerStateHandle> m_BoundSamplers;
+  wdDynamicArray<wdGALResourceViewHandle> m_BoundBuffer;
 
   struct BoundConstantBuffer
   {
@@ -314,11 +348,47 @@ private:
     {
     }
 
+    WD_ALWAYS_INLINE bool operator==(const BoundConstantBuffer& other) const
+    {
+      return m_hConstantBuffer == other.m_hConstantBuffer && m_hConstantBufferStorage == other.m_hConstantBufferStorage;
+    }
+
+    WD_ALWAYS_INLINE bool operator!=(const BoundConstantBuffer& other) const { return !(*this == other); }
+
     wdGALBufferHandle m_hConstantBuffer;
     wdConstantBufferStorageHandle m_hConstantBufferStorage;
   };
 
-  wdHashTable<wdUInt64, BoundConstantBuffer> m_BoundConstantBuffers;
+  wdDynamicArray<BoundConstantBuffer> m_BoundConstantBuffers;
+  wdHybridArray<wdShaderBindingSlot, 16> m_UsedConstantBufferSlots; // all slots that a constant buffer has been bound to, for uploading
+
+  // Caches the slots for the name based Bind functions, so that the global slot table doesn't need to be locked.
+  wdHashTable<wdUInt64, wdShaderBindingSlot> m_BindingSlotCache;
+
+  // The material textures that are used by a shader permutation, resolved to binding slots.
+  struct MaterialStateBlock
+  {
+    template <typename T>
+    struct TextureBinding
+    {
+      WD_ALWAYS_INLINE bool operator==(const TextureBinding& other) const { return m_Slot == other.m_Slot && m_hTexture == other.m_hTexture; }
+
+      wdShaderBindingSlot m_Slot;
+      T m_hTexture;
+    };
+
+    wdUInt64 m_uiContentVersion = 0; // see ApplyMaterialStateBlock, changes when the material is modified or either resource is reloaded
+    wdUInt64 m_uiLastUsedFrame = 0;
+    wdDynamicArray<TextureBinding<wdTexture2DResourceHandle>> m_Textures2D;
+    wdDynamicArray<TextureBinding<wdTextureCubeResourceHandle>> m_TexturesCube;
+  };
+
+  // Keyed by the combined hash of shader permutation and material. Kept across frames, state blocks that haven't been used
+  // for a while are removed in ResetContextState so that the textures of materials that aren't rendered anymore are not kept alive.
+  wdHashTable<wdUInt64, MaterialStateBlock> m_MaterialStateBlocks;
+  wdUInt64 m_uiAppliedStateBlockKey = 0;
+  wdUInt64 m_uiAppliedStateBlockVersion = 0;
+  wdUInt64 m_uiLastStateBlockCleanupFrame = 0;
 
   wdConstantBufferStorageHandle m_hGlobalConstantBufferStorage;
 
@@ -369,9 +439,12 @@ private: // Per Renderer States
   void BindShaderInternal(const wdShaderResourceHandle& hShader, wdBitflags<wdShaderBindFlags> flags);
   wdShaderPermutationResource* ApplyShaderState();
   wdMaterialResource* ApplyMaterialState();
-  void ApplyConstantBufferBindings(const wdShaderStageBinary* pBinary);
-  void ApplyTextureBindings(wdGALShaderStage::Enum stage, const wdShaderStageBinary* pBinary);
-  void ApplyUAVBindings(const wdShaderStageBinary* pBinary);
-  void ApplySamplerBindings(wdGALShaderStage::Enum stage, const wdShaderStageBinary* pBinary);
-  void ApplyBufferBindings(wdGALShaderStage::Enum stage, const wdShaderStageBinary* pBinary);
+  void ApplyMaterialStateBlock(const wdShaderPermutationResource* pShaderPermutation);
+  void ApplyConstantBufferBindings(const wdShaderBindingLayout& layout);
+  void ApplyTextureBindings(const wdShaderBindingLayout& layout);
+  void ApplyUAVBindings(const wdShaderBindingLayout& layout);
+  void ApplySamplerBindings(const wdShaderBindingLayout& layout);
+  void ApplyBufferBindings(const wdShaderBindingLayout& layout);
+
+  wdShaderBindingSlot ResolveBindingSlot(const wdTempHashedString& sSlotName);
 };
@@ -258,6 +258,8 @@ void wdRenderWorld::CacheRenderData(const wdView& view, const wdGameObjectHandle
 {
   if (cvar_RenderingCachingStaticObjects)
   {
+    // This is called by multiple extraction threads of the same view at once. Every caller reserves its own slot through the atomic counter
+    // and the slots are only read in UpdateRenderDataCache, after extraction has finished.
     wdUInt32 uiNewEntriesCount = view.m_pRenderDataCache->m_NewEntriesCount;
     if (uiNewEntriesCount >= MaxNumNewCacheEntries)
     {
@@ -86,6 +86,7 @@ WD_STATICLINK_LIBRARY(RendererCore)
   WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshBufferUtils);
   WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshComponent);
   WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshComponentBase);
+  WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshOptimization);
   WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshRenderer);
   WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshResource);
   WD_STATICLINK_REFERENCE(RendererCore_Meshes_Implementation_MeshResourceDescriptor);
@@ -137,6 +138,7 @@ WD_STATICLINK_LIBRARY(RendererCore)
   WD_STATICLINK_REFERENCE(RendererCore_ShaderCompiler_Implementation_ShaderParser);
   WD_STATICLINK_REFERENCE(RendererCore_Shader_Implementation_ConstantBufferStorage);
   WD_STATICLINK_REFERENCE(RendererCore_Shader_Implementation_Helper);
+  WD_STATICLINK_REFERENCE(RendererCore_Shader_Implementation_ShaderBindingLayout);
   WD_STATICLINK_REFERENCE(RendererCore_Shader_Implementation_ShaderPermutationBinary);
   WD_STATICLINK_REFERENCE(RendererCore_Shader_Implementation_ShaderPermutationResource);
   WD_STATICLINK_REFERENCE(RendererCore_Shader_Implementation_ShaderResource);
@@ -0,0 +1,150 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
+#include <RendererCore/Shader/ShaderBindingLayout.h>
+#include <RendererCore/Shader/ShaderStageBinary.h>
+
+namespace
+{
+  struct BindingSlotRegistry
+  {
+    wdMutex m_Mutex;
+    wdHashTable<wdUInt64, wdUInt16, wdHashHelper<wdUInt64>, wdStaticAllocatorWrapper> m_SlotIndices;
+    wdAtomicInteger32 m_iNumSlots;
+  };
+
+  BindingSlotRegistry& GetBindingSlotRegistry()
+  {
+    // slots are never unregistered, since callers are allowed to cache them for the lifetime of the process
+    static BindingSlotRegistry s_Registry;
+    return s_Registry;
+  }
+
+  wdShaderBindingLayout::BindingType::Enum GetBindingType(wdShaderResourceType::Enum type)
+  {
+    // we currently only support 2D, 3D and cube textures
+
+    if (type >= wdShaderResourceType::Texture2D && type <= wdShaderResourceType::Texture2DMSArray)
+      return wdShaderBindingLayout::BindingType::Texture2D;
+
+    if (type == wdShaderResourceType::Texture3D)
+      return wdShaderBindingLayout::BindingType::Texture3D;
+
+    if (type >= wdShaderResourceType::TextureCube && type <= wdShaderResourceType::TextureCubeArray)
+      return wdShaderBindingLayout::BindingType::TextureCube;
+
+    switch (type)
+    {
+      case wdShaderResourceType::UAV:
+        return wdShaderBindingLayout::BindingType::UAV;
+      case wdShaderResourceType::ConstantBuffer:
+        return wdShaderBindingLayout::BindingType::ConstantBuffer;
+      case wdShaderResourceType::GenericBuffer:
+        return wdShaderBindingLayout::BindingType::Buffer;
+      case wdShaderResourceType::Sampler:
+        return wdShaderBindingLayout::BindingType::Sampler;
+      default:
+        return wdShaderBindingLayout::BindingType::ENUM_COUNT;
+    }
+  }
+} // namespace
+
+// static
+wdShaderBindingSlot wdShaderBindingLayout::GetSlot(const wdTempHashedString& sName)
+{
+  BindingSlotRegistry& registry = GetBindingSlotRegistry();
+
+  WD_LOCK(registry.m_Mutex);
+
+  wdShaderBindingSlot slot;
+  if (!registry.m_SlotIndices.TryGetValue(sName.GetHash(), slot.m_uiIndex))
+  {
+    WD_ASSERT_DEV(registry.m_SlotIndices.GetCount() < 0xFFFF, "Too many shader resource names have been registered");
+
+    slot.m_uiIndex = static_cast<wdUInt16>(registry.m_SlotIndices.GetCount());
+    registry.m_SlotIndices.Insert(sName.GetHash(), slot.m_uiIndex);
+    registry.m_iNumSlots.Increment();
+  }
+
+  return slot;
+}
+
+// static
+wdUInt32 wdShaderBindingLayout::GetNumSlots()
+{
+  return static_cast<wdUInt32>(GetBindingSlotRegistry().m_iNumSlots);
+}
+
+void wdShaderBindingLayout::Build(const wdShaderStageBinary* const* pStageBinaries)
+{
+  Clear();
+
+  wdHybridArray<Binding, 16> bindingsPerType[BindingType::ENUM_COUNT];
+
+  for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    const wdShaderStageBinary* pBinary = pStageBinaries[stage];
+    if (pBinary == nullptr)
+      continue;
+
+    m_bWasCompiledWithDebug |= pBinary->m_bWasCompiledWithDebug;
+
+    for (const wdShaderResourceBinding& resourceBinding : pBinary->GetShaderResourceBindings())
+    {
+      const BindingType::Enum type = GetBindingType(resourceBinding.m_Type);
+      if (type == BindingType::ENUM_COUNT)
+        continue;
+
+      // RWTextures/UAV are usually only supported in compute and pixel shader.
+      if (type == BindingType::UAV && stage != wdGALShaderStage::ComputeShader && stage != wdGALShaderStage::PixelShader)
+        continue;
+
+      auto& bindings = bindingsPerType[type];
+
+      // Constant buffers are set for all stages at once, so each GAL slot only needs to be set once.
+      if (type == BindingType::ConstantBuffer)
+      {
+        bool bAlreadyAdded = false;
+        for (const Binding& existing : bindings)
+        {
+          if (existing.m_uiGALSlot == resourceBinding.m_iSlot && existing.m_sName == resourceBinding.m_sName)
+          {
+            bAlreadyAdded = true;
+            break;
+          }
+        }
+
+        if (bAlreadyAdded)
+          continue;
+      }
+
+      Binding& binding = bindings.ExpandAndGetRef();
+      binding.m_sName = resourceBinding.m_sName;
+      binding.m_Slot = GetSlot(resourceBinding.m_sName);
+      binding.m_uiGALSlot = static_cast<wdUInt16>(resourceBinding.m_iSlot);
+      binding.m_Stage = static_cast<wdGALShaderStage::Enum>(stage);
+    }
+  }
+
+  for (wdUInt32 type = 0; type < BindingType::ENUM_COUNT; ++type)
+  {
+    m_uiFirstBinding[type] = static_cast<wdUInt16>(m_Bindings.GetCount());
+    m_Bindings.PushBackRange(bindingsPerType[type]);
+  }
+
+  m_uiFirstBinding[BindingType::ENUM_COUNT] = static_cast<wdUInt16>(m_Bindings.GetCount());
+}
+
+void wdShaderBindingLayout::Clear()
+{
+  m_Bindings.Clear();
+  m_bWasCompiledWithDebug = false;
+
+  for (wdUInt32 i = 0; i <= BindingType::ENUM_COUNT; ++i)
+  {
+    m_uiFirstBinding[i] = 0;
+  }
+}
+
+WD_STATICLINK_FILE(RendererCore, RendererCore_Shader_Implementation_ShaderBindingLayout);
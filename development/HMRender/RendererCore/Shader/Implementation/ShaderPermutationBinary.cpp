@@ -11,6 +11,7 @@ struct wdShaderPermutationBinaryVersion
     Version3 = 3,
     Version4 = 4,
     Version5 = 5,
+    Version6 = 6, // 64 bit stage hashes
 
     // Increase this version number to trigger shader recompilation
 
@@ -38,7 +39,7 @@ wdResult wdShaderPermutationBinary::Write(wdStreamWriter& inout_stream)
 
   for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
   {
-    if (inout_stream.WriteDWordValue(&m_uiShaderStageHashes[stage]).Failed())
+    if (inout_stream.WriteQWordValue(&m_uiShaderStageHashes[stage]).Failed())
       return WD_FAILURE;
   }
 
@@ -70,8 +71,19 @@ wdResult wdShaderPermutationBinary::Read(wdStreamReader& inout_stream, bool& out
 
   for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
   {
-    if (inout_stream.ReadDWordValue(&m_uiShaderStageHashes[stage]).Failed())
-      return WD_FAILURE;
+    if (uiVersion >= wdShaderPermutationBinaryVersion::Version6)
+    {
+      if (inout_stream.ReadQWordValue(&m_uiShaderStageHashes[stage]).Failed())
+        return WD_FAILURE;
+    }
+    else
+    {
+      wdUInt32 uiStageHash = 0;
+      if (inout_stream.ReadDWordValue(&uiStageHash).Failed())
+        return WD_FAILURE;
+
+      m_uiShaderStageHashes[stage] = uiStageHash;
+    }
   }
 
   m_StateDescriptor.Load(inout_stream);
@@ -32,6 +32,8 @@ wdResourceLoadDesc wdShaderPermutationResource::UnloadData(Unload WhatToUnload)
 {
   m_bShaderPermutationValid = false;
 
+  m_BindingLayout.Clear();
+
   auto pDevice = wdGALDevice::GetDefaultDevice();
 
   if (!m_hShader.IsInvalidated())
@@ -108,7 +110,7 @@ wdResourceLoadDesc wdShaderPermutationResource::UpdateContent(wdStreamReader* St
   // iterate over all shader stages, add them to the descriptor
   for (wdUInt32 stage = wdGALShaderStage::VertexShader; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
   {
-    const wdUInt32 uiStageHash = PermutationBinary.m_uiShaderStageHashes[stage];
+    const wdUInt64 uiStageHash = PermutationBinary.m_uiShaderStageHashes[stage];
 
     if (uiStageHash == 0) // not used
       continue;
@@ -144,6 +146,8 @@ wdResourceLoadDesc wdShaderPermutationResource::UpdateContent(wdStreamReader* St
 
   m_PermutationVars = PermutationBinary.m_PermutationVars;
 
+  m_BindingLayout.Build(m_pShaderStageBinaries);
+
   m_bShaderPermutationValid = true;
 
   ModifyMemoryUsage().m_uiMemoryGPU = uiGPUMem;
@@ -337,7 +341,7 @@ wdResourceLoadData wdShaderPermutationResourceLoader::OpenDataStream(const wdRes
 
     for (wdUInt32 stage = wdGALShaderStage::VertexShader; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
     {
-      const wdUInt32 uiStageHash = permutationBinary.m_uiShaderStageHashes[stage];
+      const wdUInt64 uiStageHash = permutationBinary.m_uiShaderStageHashes[stage];
 
       if (uiStageHash == 0) // not used
         continue;
@@ -2,6 +2,8 @@
 
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/Threading/Lock.h>
+#include <Foundation/Threading/Mutex.h>
 #include <RendererCore/Shader/ShaderStageBinary.h>
 #include <RendererCore/Shader/Types.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
@@ -153,7 +155,10 @@ wdShaderResourceBinding::~wdShaderResourceBinding() = default;
 
 //////////////////////////////////////////////////////////////////////////
 
-wdMap<wdUInt32, wdShaderStageBinary> wdShaderStageBinary::s_ShaderStageBinaries[wdGALShaderStage::ENUM_COUNT];
+wdMap<wdUInt64, wdShaderStageBinary> wdShaderStageBinary::s_ShaderStageBinaries[wdGALShaderStage::ENUM_COUNT];
+
+// shaders may be compiled and loaded on several threads at the same time
+static wdMutex s_ShaderStageBinariesMutex;
 
 wdShaderStageBinary::wdShaderStageBinary() = default;
 
@@ -188,7 +193,7 @@ wdResult wdShaderStageBinary::Write(wdStreamWriter& inout_stream) const
   if (inout_stream.WriteBytes(&uiVersion, sizeof(wdUInt8)).Failed())
     return WD_FAILURE;
 
-  if (inout_stream.WriteDWordValue(&m_uiSourceHash).Failed())
+  if (inout_stream.WriteQWordValue(&m_uiSourceHash).Failed())
     return WD_FAILURE;
 
   const wdUInt8 uiStage = (wdUInt8)m_Stage;
@@ -233,8 +238,19 @@ wdResult wdShaderStageBinary::Read(wdStreamReader& inout_stream)
 
   WD_ASSERT_DEV(uiVersion <= wdShaderStageBinary::VersionCurrent, "Wrong Version {0}", uiVersion);
 
-  if (inout_stream.ReadDWordValue(&m_uiSourceHash).Failed())
-    return WD_FAILURE;
+  if (uiVersion >= wdShaderStageBinary::Version6)
+  {
+    if (inout_stream.ReadQWordValue(&m_uiSourceHash).Failed())
+      return WD_FAILURE;
+  }
+  else
+  {
+    wdUInt32 uiSourceHash = 0;
+    if (inout_stream.ReadDWordValue(&uiSourceHash).Failed())
+      return WD_FAILURE;
+
+    m_uiSourceHash = uiSourceHash;
+  }
 
   wdUInt8 uiStage = wdGALShaderStage::ENUM_COUNT;
 
@@ -330,7 +346,10 @@ wdResult wdShaderStageBinary::WriteStageBinary(wdLogInterface* pLog) const
   wdStringBuilder sShaderStageFile = wdShaderManager::GetCacheDirectory();
 
   sShaderStageFile.AppendPath(wdShaderManager::GetActivePlatform().GetData());
-  sShaderStageFile.AppendFormat("/{0}_{1}.wdShaderStage", wdGALShaderStage::Names[m_Stage], wdArgU(m_uiSourceHash, 8, true, 16, true));
+  sShaderStageFile.AppendFormat("/{0}_{1}.wdShaderStage", wdGALShaderStage::Names[m_Stage], wdArgU(m_uiSourceHash, 16, true, 16, true));
+
+  // different permutations may produce the same stage source, don't let them write the same file at the same time
+  WD_LOCK(s_ShaderStageBinariesMutex);
 
   wdFileWriter StageFileOut;
   if (StageFileOut.Open(sShaderStageFile.GetData()).Failed())
@@ -349,8 +368,10 @@ wdResult wdShaderStageBinary::WriteStageBinary(wdLogInterface* pLog) const
 }
 
 // static
-wdShaderStageBinary* wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::Enum Stage, wdUInt32 uiHash)
+wdShaderStageBinary* wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::Enum Stage, wdUInt64 uiHash)
 {
+  WD_LOCK(s_ShaderStageBinariesMutex);
+
   auto itStage = s_ShaderStageBinaries[Stage].Find(uiHash);
 
   if (!itStage.IsValid())
@@ -358,7 +379,7 @@ wdShaderStageBinary* wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::Enum
     wdStringBuilder sShaderStageFile = wdShaderManager::GetCacheDirectory();
 
     sShaderStageFile.AppendPath(wdShaderManager::GetActivePlatform().GetData());
-    sShaderStageFile.AppendFormat("/{0}_{1}.wdShaderStage", wdGALShaderStage::Names[Stage], wdArgU(uiHash, 8, true, 16, true));
+    sShaderStageFile.AppendFormat("/{0}_{1}.wdShaderStage", wdGALShaderStage::Names[Stage], wdArgU(uiHash, 16, true, 16, true));
 
     wdFileReader StageFileIn;
     if (StageFileIn.Open(sShaderStageFile.GetData()).Failed())
@@ -374,6 +395,13 @@ wdShaderStageBinary* wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::Enum
       return nullptr;
     }
 
+    // the file name is only derived from the hash, make sure the file really contains the binary for this source
+    if (shaderStageBinary.m_uiSourceHash != uiHash || shaderStageBinary.m_Stage != Stage)
+    {
+      wdLog::Warning("Shader stage file '{0}' does not match its source hash and is ignored", sShaderStageFile);
+      return nullptr;
+    }
+
     itStage = wdShaderStageBinary::s_ShaderStageBinaries[Stage].Insert(uiHash, shaderStageBinary);
   }
 
@@ -395,6 +423,8 @@ wdShaderStageBinary* wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::Enum
 // static
 void wdShaderStageBinary::OnEngineShutdown()
 {
+  WD_LOCK(s_ShaderStageBinariesMutex);
+
   for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
   {
     s_ShaderStageBinaries[stage].Clear();
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Foundation/Strings/HashedString.h>
+#include <RendererCore/RendererCoreDLL.h>
+#include <RendererFoundation/Descriptors/Descriptors.h>
+
+class wdShaderStageBinary;
+
+/// \brief Identifies a named shader resource binding (texture, buffer, sampler, etc.) by a dense, process-wide index.
+///
+/// Slots are obtained once through wdShaderBindingLayout::GetSlot() and stay valid for the lifetime of the process.
+/// They allow the render context to bind and resolve resources with plain array lookups instead of hashed name lookups.
+struct wdShaderBindingSlot
+{
+  WD_DECLARE_POD_TYPE();
+
+  WD_ALWAYS_INLINE bool IsValid() const { return m_uiIndex != 0xFFFF; }
+
+  WD_ALWAYS_INLINE bool operator==(const wdShaderBindingSlot& other) const { return m_uiIndex == other.m_uiIndex; }
+  WD_ALWAYS_INLINE bool operator!=(const wdShaderBindingSlot& other) const { return m_uiIndex != other.m_uiIndex; }
+
+  wdUInt16 m_uiIndex = 0xFFFF;
+};
+
+/// \brief The resource bindings of all stages of a shader permutation, resolved to binding slots.
+///
+/// The layout is built once when a shader permutation is loaded. The render context iterates over the bindings of one type
+/// when applying state, which avoids filtering the reflection data and looking up resources by name for every draw call.
+class WD_RENDERERCORE_DLL wdShaderBindingLayout
+{
+public:
+  struct BindingType
+  {
+    enum Enum
+    {
+      ConstantBuffer,
+      Texture2D,
+      Texture3D,
+      TextureCube,
+      UAV,
+      Sampler,
+      Buffer,
+
+      ENUM_COUNT
+    };
+  };
+
+  struct Binding
+  {
+    WD_DECLARE_MEM_RELOCATABLE_TYPE();
+
+    wdHashedString m_sName;
+    wdShaderBindingSlot m_Slot;
+    wdUInt16 m_uiGALSlot = 0;
+    wdGALShaderStage::Enum m_Stage = wdGALShaderStage::ENUM_COUNT;
+  };
+
+  /// \brief Returns the slot for the given resource name. Registers a new slot if the name hasn't been seen before.
+  ///
+  /// This function is thread-safe. The returned slot should be cached by the caller, since it requires a lookup in a global table.
+  static wdShaderBindingSlot GetSlot(const wdTempHashedString& sName);
+
+  /// \brief Returns the number of slots that have been registered so far. All slot indices are smaller than this value.
+  static wdUInt32 GetNumSlots();
+
+  /// \brief Builds the layout from the given stage binaries. Stages that are not used may be nullptr.
+  void Build(const wdShaderStageBinary* const* pStageBinaries);
+
+  void Clear();
+
+  /// \brief Returns all bindings of the given type.
+  ///
+  /// Constant buffers are only listed once per GAL slot, since they are set for all stages at once.
+  /// UAVs are only listed for the pixel and compute shader stages.
+  wdArrayPtr<const Binding> GetBindings(BindingType::Enum type) const
+  {
+    return m_Bindings.GetArrayPtr().GetSubArray(m_uiFirstBinding[type], m_uiFirstBinding[type + 1] - m_uiFirstBinding[type]);
+  }
+
+  /// \brief Returns true if any of the stages was compiled with debug information, i.e. unused resources were not stripped.
+  bool WasCompiledWithDebug() const { return m_bWasCompiledWithDebug; }
+
+private:
+  wdDynamicArray<Binding> m_Bindings;
+  wdUInt16 m_uiFirstBinding[BindingType::ENUM_COUNT + 1] = {};
+  bool m_bWasCompiledWithDebug = false;
+};
@@ -26,7 +26,7 @@ public:
   wdResult Write(wdStreamWriter& inout_stream);
   wdResult Read(wdStreamReader& inout_stream, bool& out_bOldVersion);
 
-  wdUInt32 m_uiShaderStageHashes[wdGALShaderStage::ENUM_COUNT];
+  wdUInt64 m_uiShaderStageHashes[wdGALShaderStage::ENUM_COUNT];
 
   wdDependencyFile m_DependencyFile;
 
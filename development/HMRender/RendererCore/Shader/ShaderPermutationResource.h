@@ -4,6 +4,7 @@
 #include <Core/ResourceManager/ResourceTypeLoader.h>
 #include <Foundation/Time/Timestamp.h>
 #include <RendererCore/RendererCoreDLL.h>
+#include <RendererCore/Shader/ShaderBindingLayout.h>
 #include <RendererCore/Shader/ShaderPermutationBinary.h>
 #include <RendererCore/ShaderCompiler/PermutationGenerator.h>
 
@@ -26,6 +27,9 @@ public:
   wdGALShaderHandle GetGALShader() const { return m_hShader; }
   const wdShaderStageBinary* GetShaderStageBinary(wdGALShaderStage::Enum stage) const { return m_pShaderStageBinaries[stage]; }
 
+  /// \brief Returns the resource bindings of all stages, resolved to binding slots when the permutation was loaded.
+  const wdShaderBindingLayout& GetBindingLayout() const { return m_BindingLayout; }
+
   wdGALBlendStateHandle GetBlendState() const { return m_hBlendState; }
   wdGALDepthStencilStateHandle GetDepthStencilState() const { return m_hDepthStencilState; }
   wdGALRasterizerStateHandle GetRasterizerState() const { return m_hRasterizerState; }
@@ -44,6 +48,7 @@ private:
   friend class wdShaderManager;
 
   wdShaderStageBinary* m_pShaderStageBinaries[wdGALShaderStage::ENUM_COUNT];
+  wdShaderBindingLayout m_BindingLayout;
 
   bool m_bShaderPermutationValid;
   wdGALShaderHandle m_hShader;
@@ -99,6 +99,7 @@ public:
     Version3, // Added Material Parameters
     Version4, // Constant buffer layouts
     Version5, // Debug flag
+    Version6, // 64 bit source hash
 
     ENUM_COUNT,
     VersionCurrent = ENUM_COUNT - 1
@@ -118,13 +119,22 @@ public:
 
   wdShaderConstantBufferLayout* CreateConstantBufferLayout() const;
 
+  /// \brief Returns the hash of the preprocessed stage source (and the compiler flags), which addresses this binary in the shader cache.
+  wdUInt64 GetSourceHash() const { return m_uiSourceHash; }
+
+  /// \brief Returns the stage binary with the given source hash, either from memory or from the shader cache on disk.
+  ///
+  /// Returns nullptr if the shader cache has no binary for this hash, or if the stored binary was built from a different source.
+  static wdShaderStageBinary* LoadStageBinary(wdGALShaderStage::Enum Stage, wdUInt64 uiHash);
+
 private:
   friend class wdRenderContext;
+  friend class wdShaderBindingLayout;
   friend class wdShaderCompiler;
   friend class wdShaderPermutationResource;
   friend class wdShaderPermutationResourceLoader;
 
-  wdUInt32 m_uiSourceHash = 0;
+  wdUInt64 m_uiSourceHash = 0;
   wdGALShaderStage::Enum m_Stage = wdGALShaderStage::ENUM_COUNT;
   wdDynamicArray<wdUInt8> m_ByteCode;
   wdScopedRefPointer<wdGALShaderByteCode> m_GALByteCode;
@@ -132,9 +142,8 @@ private:
   bool m_bWasCompiledWithDebug = false;
 
   wdResult WriteStageBinary(wdLogInterface* pLog) const;
-  static wdShaderStageBinary* LoadStageBinary(wdGALShaderStage::Enum Stage, wdUInt32 uiHash);
 
   static void OnEngineShutdown();
 
-  static wdMap<wdUInt32, wdShaderStageBinary> s_ShaderStageBinaries[wdGALShaderStage::ENUM_COUNT];
+  static wdMap<wdUInt64, wdShaderStageBinary> s_ShaderStageBinaries[wdGALShaderStage::ENUM_COUNT];
 };
@@ -3,6 +3,8 @@
 #include <Foundation/IO/FileSystem/DeferredFileWriter.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/LogEntry.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererCore/ShaderCompiler/ShaderParser.h>
@@ -94,7 +96,7 @@ namespace
 
 wdResult wdShaderCompiler::FileOpen(const char* szAbsoluteFile, wdDynamicArray<wdUInt8>& FileContent, wdTimestamp& out_FileModification)
 {
-  if (wdStringUtils::IsEqual(szAbsoluteFile, "ShaderRenderState"))
+  if (m_StateSourceFile == szAbsoluteFile)
   {
     const wdString& sData = m_ShaderData.m_StateSource;
     const wdUInt32 uiCount = sData.GetElementCount();
@@ -129,8 +131,6 @@ wdResult wdShaderCompiler::FileOpen(const char* szAbsoluteFile, wdDynamicArray<w
     }
   }
 
-  m_IncludeFiles.Insert(szAbsoluteFile);
-
   wdFileReader r;
   if (r.Open(szAbsoluteFile).Failed())
   {
@@ -156,6 +156,160 @@ wdResult wdShaderCompiler::FileOpen(const char* szAbsoluteFile, wdDynamicArray<w
   return WD_SUCCESS;
 }
 
+wdResult wdShaderCompiler::FileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, wdPreprocessor::IncludeType incType, wdStringBuilder& out_sAbsoluteFilePath)
+{
+  WD_SUCCEED_OR_RETURN(wdPreprocessor::DefaultFileLocator(szCurAbsoluteFile, szIncludeFile, incType, out_sAbsoluteFilePath));
+
+  // track includes here instead of in FileOpen, which is skipped for files that are already in the (shared) file cache
+  if (incType != wdPreprocessor::MainFile)
+  {
+    m_IncludeFiles.Insert(out_sAbsoluteFilePath);
+  }
+
+  return WD_SUCCESS;
+}
+
+void wdShaderCompiler::SetFileCache(wdTokenizedFileCache* pFileCache)
+{
+  m_pFileCache = pFileCache;
+}
+
+wdResult wdShaderCompiler::CompileShaderPermutationsForPlatforms(const char* szFile, const wdPermutationGenerator& generator, wdLogInterface* pLog, const char* szPlatform)
+{
+  if (pLog == nullptr)
+  {
+    pLog = wdLog::GetThreadLocalLogSystem();
+  }
+
+  WD_LOG_BLOCK(pLog, "Compiling Shader Permutations", szFile);
+
+  wdHybridArray<wdHashedString, 16> usedPermutationVars;
+
+  {
+    wdStringBuilder sFileContent;
+
+    wdFileReader File;
+    if (File.Open(szFile).Failed())
+    {
+      wdLog::Error(pLog, "Could not open shader file '{0}'", szFile);
+      return WD_FAILURE;
+    }
+
+    sFileContent.ReadAll(File);
+
+    wdShaderHelper::wdTextSectionizer Sections;
+    wdShaderHelper::GetShaderSections(sFileContent.GetData(), Sections);
+
+    wdUInt32 uiFirstLine = 0;
+    wdHybridArray<wdPermutationVar, 16> fixedPermutationVars;
+    wdShaderParser::ParsePermutationSection(Sections.GetSectionContent(wdShaderHelper::wdShaderSections::PERMUTATIONS, uiFirstLine), usedPermutationVars, fixedPermutationVars);
+  }
+
+  // the generator usually enumerates the variables of many shaders, reduce every permutation to the variables this shader uses
+  // and skip the ones that end up identical, they would be written to the same permutation file
+  wdDynamicArray<wdHybridArray<wdPermutationVar, 16>> permutations;
+
+  {
+    wdHashSet<wdUInt32> permutationHashes;
+    wdHybridArray<wdPermutationVar, 16> allVars;
+
+    const wdUInt32 uiNumPermutations = generator.GetPermutationCount();
+    for (wdUInt32 uiPermutation = 0; uiPermutation < uiNumPermutations; ++uiPermutation)
+    {
+      generator.GetPermutation(uiPermutation, allVars);
+
+      wdHybridArray<wdPermutationVar, 16> usedVars;
+      for (const wdPermutationVar& var : allVars)
+      {
+        if (usedPermutationVars.Contains(var.m_sName))
+        {
+          usedVars.PushBack(var);
+        }
+      }
+
+      if (permutationHashes.Insert(wdShaderHelper::CalculateHash(usedVars)))
+        continue;
+
+      permutations.PushBack(std::move(usedVars));
+    }
+  }
+
+  struct PermutationLog
+  {
+    wdDynamicArray<wdLogEntry> m_Entries;
+  };
+
+  wdDynamicArray<PermutationLog> logs;
+  logs.SetCount(permutations.GetCount());
+
+  wdTokenizedFileCache fileCache;
+  wdAtomicInteger32 iNumFailed;
+
+  const wdLogMsgType::Enum logLevel = pLog->GetLogLevel();
+
+  wdTaskSystem::ParallelForIndexed(
+    0u, permutations.GetCount(),
+    [&](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+      for (wdUInt32 uiPermutation = uiStartIndex; uiPermutation < uiEndIndex; ++uiPermutation)
+      {
+        wdDynamicArray<wdLogEntry>& entries = logs[uiPermutation].m_Entries;
+
+        // every worker logs into its own buffer, log interfaces are not meant to be written to from several threads
+        wdLogEntryDelegate logger([&entries](wdLogEntry& ref_entry) { entries.PushBack(std::move(ref_entry)); }, logLevel);
+        wdLogSystemScope logScope(&logger);
+
+        wdShaderCompiler compiler;
+        compiler.SetFileCache(&fileCache);
+
+        if (compiler.CompileShaderPermutationForPlatforms(szFile, permutations[uiPermutation], &logger, szPlatform).Failed())
+        {
+          iNumFailed.Increment();
+        }
+      }
+    },
+    "CompileShaderPermutations");
+
+  wdStringBuilder sPermutation;
+
+  for (wdUInt32 uiPermutation = 0; uiPermutation < permutations.GetCount(); ++uiPermutation)
+  {
+    sPermutation.Clear();
+    for (const wdPermutationVar& var : permutations[uiPermutation])
+    {
+      sPermutation.AppendWithSeparator(" ", var.m_sName, "=", var.m_sValue);
+    }
+
+    // the block is only written if the permutation logged anything
+    WD_LOG_BLOCK(pLog, "Permutation", sPermutation);
+
+    wdStringBuilder sMsg;
+    for (const wdLogEntry& entry : logs[uiPermutation].m_Entries)
+    {
+      if (entry.m_Type == wdLogMsgType::BeginGroup || entry.m_Type == wdLogMsgType::EndGroup)
+        continue;
+
+      if (entry.m_sTag.IsEmpty())
+      {
+        sMsg = entry.m_sMsg;
+      }
+      else
+      {
+        sMsg.Set("[", entry.m_sTag, "]", entry.m_sMsg);
+      }
+
+      wdLog::BroadcastLoggingEvent(pLog, entry.m_Type, sMsg);
+    }
+  }
+
+  if (iNumFailed > 0)
+  {
+    wdLog::Error(pLog, "{0} of {1} shader permutations failed to compile", static_cast<wdInt32>(iNumFailed), permutations.GetCount());
+    return WD_FAILURE;
+  }
+
+  return WD_SUCCESS;
+}
+
 wdResult wdShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFile, const wdArrayPtr<const wdPermutationVar>& permutationVars, wdLogInterface* pLog, const char* szPlatform)
 {
   wdStringBuilder sFileContent, sTemp;
@@ -239,6 +393,10 @@ wdResult wdShaderCompiler::CompileShaderPermutationForPlatforms(const char* szFi
   wdStringBuilder tmp = szFile;
   tmp.MakeCleanPath();
 
+  // named after the shader, so that the render state of different shaders never ends up in the same slot of a shared file cache
+  m_StateSourceFile = tmp;
+  m_StateSourceFile.ChangeFileExtension("rs");
+
   m_StageSourceFile[wdGALShaderStage::VertexShader] = tmp;
   m_StageSourceFile[wdGALShaderStage::VertexShader].ChangeFileExtension("vs");
 
@@ -325,9 +483,10 @@ wdResult wdShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       WD_LOG_BLOCK(pLog, "Preprocessing Shader State Source");
 
       wdPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
+      pp.SetCustomFileCache(m_pFileCache != nullptr ? m_pFileCache : &m_FileCache);
       pp.SetLogInterface(wdLog::GetThreadLocalLogSystem());
       pp.SetFileOpenFunction(wdPreprocessor::FileOpenCB(&wdShaderCompiler::FileOpen, this));
+      pp.SetFileLocatorFunction(wdPreprocessor::FileLocatorCB(&wdShaderCompiler::FileLocator, this));
       pp.SetPassThroughPragma(false);
       pp.SetPassThroughLine(false);
 
@@ -347,7 +506,7 @@ wdResult wdShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       });
 
       wdStringBuilder sOutput;
-      if (pp.Process("ShaderRenderState", sOutput, false).Failed() || bFoundUndefinedVars)
+      if (pp.Process(m_StateSourceFile, sOutput, false).Failed() || bFoundUndefinedVars)
       {
         wdLog::Error(pLog, "Preprocessing the Shader State block failed");
         return WD_FAILURE;
@@ -373,9 +532,10 @@ wdResult wdShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
       bool bFoundUndefinedVars = false;
 
       wdPreprocessor pp;
-      pp.SetCustomFileCache(&m_FileCache);
+      pp.SetCustomFileCache(m_pFileCache != nullptr ? m_pFileCache : &m_FileCache);
       pp.SetLogInterface(wdLog::GetThreadLocalLogSystem());
       pp.SetFileOpenFunction(wdPreprocessor::FileOpenCB(&wdShaderCompiler::FileOpen, this));
+      pp.SetFileLocatorFunction(wdPreprocessor::FileLocatorCB(&wdShaderCompiler::FileLocator, this));
       pp.SetPassThroughPragma(true);
       pp.SetPassThroughUnknownCmdsCB(wdMakeDelegate(&wdShaderCompiler::PassThroughUnknownCommandCB, this));
       pp.SetPassThroughLine(false);
@@ -410,7 +570,9 @@ wdResult wdShaderCompiler::RunShaderCompiler(const char* szFile, const char* szP
         uiSourceStringLen = sProcessed[stage].GetElementCount();
       }
 
-      spd.m_StageBinary[stage].m_uiSourceHash = wdHashingUtils::xxHash32(spd.m_szShaderSource[stage], uiSourceStringLen);
+      // the stage binaries in the shader cache are addressed by this hash, so it has to include everything that affects the compiled result
+      // the flags are used as the seed, 64 bits keep accidental collisions between different sources out of the shared cache
+      spd.m_StageBinary[stage].m_uiSourceHash = wdHashingUtils::xxHash64(spd.m_szShaderSource[stage], uiSourceStringLen, spd.m_Flags.GetValue());
 
       if (spd.m_StageBinary[stage].m_uiSourceHash != 0)
       {
@@ -496,7 +658,7 @@ void wdShaderCompiler::WriteFailedShaderSource(wdShaderProgramCompiler::wdShader
       wdStringBuilder sShaderStageFile = wdShaderManager::GetCacheDirectory();
 
       sShaderStageFile.AppendPath(wdShaderManager::GetActivePlatform().GetData());
-      sShaderStageFile.AppendFormat("/_Failed_{0}_{1}.wdShaderSource", wdGALShaderStage::Names[stage], wdArgU(spd.m_StageBinary[stage].m_uiSourceHash, 8, true, 16, true));
+      sShaderStageFile.AppendFormat("/_Failed_{0}_{1}.wdShaderSource", wdGALShaderStage::Names[stage], wdArgU(spd.m_StageBinary[stage].m_uiSourceHash, 16, true, 16, true));
 
       wdFileWriter StageFileOut;
       if (StageFileOut.Open(sShaderStageFile.GetData()).Succeeded())
@@ -4,6 +4,7 @@
 #include <RendererCore/Shader/Implementation/Helper.h>
 #include <RendererCore/Shader/ShaderPermutationResource.h>
 #include <RendererCore/Shader/ShaderResource.h>
+#include <RendererCore/ShaderCompiler/ShaderCompiler.h>
 #include <RendererCore/ShaderCompiler/ShaderManager.h>
 #include <RendererCore/ShaderCompiler/ShaderParser.h>
 
@@ -260,27 +261,63 @@ wdArrayPtr<const wdShaderParser::EnumValue> wdShaderManager::GetPermutationEnumV
 
 void wdShaderManager::PreloadPermutations(wdShaderResourceHandle hShader, const wdHashTable<wdHashedString, wdHashedString>& permVars, wdTime shouldBeAvailableIn)
 {
-  WD_ASSERT_NOT_IMPLEMENTED;
-#if 0
   wdResourceLock<wdShaderResource> pShader(hShader, wdResourceAcquireMode::BlockTillLoaded);
 
   if (!pShader->IsShaderValid())
     return;
 
-  /*wdUInt32 uiPermutationHash = */ FilterPermutationVars(pShader->GetUsedPermutationVars(), permVars);
+  // variables that are not given are preloaded with all their possible values
+  wdPermutationGenerator generator;
+  {
+    wdHybridArray<wdHashedString, 16> values;
+
+    for (const wdHashedString& sName : pShader->GetUsedPermutationVars())
+    {
+      wdHashedString sValue;
+      if (permVars.TryGetValue(sName, sValue))
+      {
+        generator.AddPermutation(sName, sValue);
+        continue;
+      }
+
+      values.Clear();
+      GetPermutationValues(sName, values);
+
+      for (const wdHashedString& sPossibleValue : values)
+      {
+        generator.AddPermutation(sName, sPossibleValue);
+      }
+    }
+  }
 
-  generator.RemoveUnusedPermutations(pShader->GetUsedPermutationVars());
+  if (s_bEnableRuntimeCompilation)
+  {
+    // compile all missing or outdated permutations in parallel up front, the permutation resources then only load the results
+    if (wdShaderCompiler::CompileShaderPermutationsForPlatforms(pShader->GetResourceID(), generator, wdLog::GetThreadLocalLogSystem(), GetActivePlatform()).Failed())
+    {
+      wdLog::Warning("Not all permutations of shader '{0}' could be compiled", pShader->GetResourceID());
+    }
+  }
 
-  wdHybridArray<wdPermutationVar, 16> usedPermVars;
+  wdHybridArray<wdPermutationVar, 16> permutationVars;
+  wdHashTable<wdHashedString, wdHashedString> permutation;
 
   const wdUInt32 uiPermutationCount = generator.GetPermutationCount();
   for (wdUInt32 uiPermutation = 0; uiPermutation < uiPermutationCount; ++uiPermutation)
   {
-    generator.GetPermutation(uiPermutation, usedPermVars);
+    generator.GetPermutation(uiPermutation, permutationVars);
+
+    permutation.Clear();
+    for (const wdPermutationVar& var : permutationVars)
+    {
+      permutation.Insert(var.m_sName, var.m_sValue);
+    }
+
+    wdHybridArray<wdPermutationVar, 64> filteredPermutationVariables(wdFrameAllocator::GetCurrentAllocator());
+    wdUInt32 uiPermutationHash = FilterPermutationVars(pShader->GetUsedPermutationVars(), permutation, filteredPermutationVariables);
 
-    PreloadSingleShaderPermutation(hShader, usedPermVars, tShouldBeAvailableIn);
+    PreloadSinglePermutationInternal(pShader->GetResourceID(), pShader->GetResourceIDHash(), uiPermutationHash, filteredPermutationVariables);
   }
-#endif
 }
 
 wdShaderPermutationResourceHandle wdShaderManager::PreloadSinglePermutation(wdShaderResourceHandle hShader, const wdHashTable<wdHashedString, wdHashedString>& permVars, bool bAllowFallback)
@@ -67,6 +67,21 @@ public:
   wdResult CompileShaderPermutationForPlatforms(
     const char* szFile, const wdArrayPtr<const wdPermutationVar>& permutationVars, wdLogInterface* pLog, const char* szPlatform = "ALL");
 
+  /// \brief Compiles all permutations of \a szFile that \a generator enumerates, in parallel on the task system.
+  ///
+  /// Permutation variables that the shader does not use are ignored, so every distinct permutation of the shader is compiled only once.
+  /// All permutations share one wdTokenizedFileCache, so every include file is read and tokenized only once.
+  /// Stage binaries are looked up in the shader cache by the hash of their preprocessed source and the compiler flags,
+  /// so stages that did not change are loaded from the cache instead of being compiled again.
+  /// The log output of each permutation is buffered and forwarded to \a pLog in order, once all permutations are finished.
+  static wdResult CompileShaderPermutationsForPlatforms(const char* szFile, const wdPermutationGenerator& generator, wdLogInterface* pLog, const char* szPlatform = "ALL");
+
+  /// \brief Makes the compiler store tokenized include files in \a pFileCache instead of its own cache.
+  ///
+  /// This allows to share the cache between several compilers, also on different threads. The cache does not detect file modifications,
+  /// so it must be cleared whenever a source file changes. Passing nullptr switches back to the internal cache.
+  void SetFileCache(wdTokenizedFileCache* pFileCache);
+
 private:
   wdResult RunShaderCompiler(const char* szFile, const char* szPlatform, wdShaderProgramCompiler* pCompiler, wdLogInterface* pLog);
 
@@ -84,10 +99,13 @@ private:
   };
 
   wdResult FileOpen(const char* szAbsoluteFile, wdDynamicArray<wdUInt8>& FileContent, wdTimestamp& out_FileModification);
+  wdResult FileLocator(const char* szCurAbsoluteFile, const char* szIncludeFile, wdPreprocessor::IncludeType incType, wdStringBuilder& out_sAbsoluteFilePath);
 
+  wdStringBuilder m_StateSourceFile;
   wdStringBuilder m_StageSourceFile[wdGALShaderStage::ENUM_COUNT];
 
   wdTokenizedFileCache m_FileCache;
+  wdTokenizedFileCache* m_pFileCache = nullptr;
   wdShaderData m_ShaderData;
 
   wdSet<wdString> m_IncludeFiles;
@@ -28,6 +28,9 @@ public:
   /// E.g. returns TRUE and FALSE for boolean variables.
   static void GetPermutationValues(const wdHashedString& sName, wdDynamicArray<wdHashedString>& out_values);
 
+  /// \brief Preloads all permutations of the shader that match \a permVars. Variables that are not in \a permVars are preloaded with all their values.
+  ///
+  /// With runtime compilation enabled, missing or outdated permutations are compiled in parallel before they are loaded.
   static void PreloadPermutations(
     wdShaderResourceHandle hShader, const wdHashTable<wdHashedString, wdHashedString>& permVars, wdTime shouldBeAvailableIn);
   static wdShaderPermutationResourceHandle PreloadSinglePermutation(
@@ -148,7 +148,7 @@ wdResourceLoadDesc wdTexture2DResource::UpdateContent(wdStreamReader* Stream)
   }
 
   wdTexture2DResourceDescriptor td;
-  wdImage* pImage = nullptr;
+  const wdImage* pImage = nullptr;
   bool bIsFallback = false;
   wdTexFormat texFormat;
 
@@ -413,7 +413,7 @@ wdResourceLoadDesc wdRenderToTexture2DResource::UpdateContent(wdStreamReader* St
   }
 
   wdRenderToTexture2DResourceDescriptor td;
-  wdImage* pImage = nullptr;
+  const wdImage* pImage = nullptr;
   bool bIsFallback = false;
   wdTexFormat texFormat;
 
@@ -137,7 +137,7 @@ wdResourceLoadDesc wdTexture3DResource::UpdateContent(wdStreamReader* Stream)
   }
 
   wdTexture3DResourceDescriptor td;
-  wdImage* pImage = nullptr;
+  const wdImage* pImage = nullptr;
   bool bIsFallback = false;
   wdTexFormat texFormat;
 
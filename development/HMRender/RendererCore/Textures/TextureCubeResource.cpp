@@ -75,7 +75,7 @@ wdResourceLoadDesc wdTextureCubeResource::UpdateContent(wdStreamReader* Stream)
     return res;
   }
 
-  wdImage* pImage = nullptr;
+  const wdImage* pImage = nullptr;
   Stream->ReadBytes(&pImage, sizeof(wdImage*));
 
   bool bIsFallback = false;
@@ -132,7 +132,7 @@ wdResourceLoadDesc wdTextureCubeResource::UpdateContent(wdStreamReader* Stream)
       {
         wdGALSystemMemoryDescription& id = InitData.ExpandAndGetRef();
 
-        id.m_pData = pImage->GetPixelPointer<wdUInt8>(mip, face, array_index);
+        id.m_pData = const_cast<wdUInt8*>(pImage->GetPixelPointer<wdUInt8>(mip, face, array_index));
 
         WD_ASSERT_DEV(pImage->GetDepthPitch(mip) < wdMath::MaxValue<wdUInt32>(), "Depth pitch exceeds wdGAL limits.");
 
@@ -3,7 +3,6 @@
 #include <Core/Assets/AssetFileHeader.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
-#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/OSFile.h>
 #include <RendererCore/Textures/Texture2DResource.h>
 #include <RendererCore/Textures/Texture3DResource.h>
@@ -11,6 +10,7 @@
 #include <RendererCore/Textures/TextureLoader.h>
 #include <RendererCore/Textures/TextureUtils.h>
 #include <Texture/Image/Formats/DdsFileFormat.h>
+#include <Texture/Image/Formats/ImageFileFormat.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/ezTexFormat/ezTexFormat.h>
 
@@ -95,17 +95,22 @@ wdResourceLoadData wdTextureResourceLoader::OpenDataStream(const wdResource* pRe
   }
   else
   {
-    wdFileReader File;
-    if (File.Open(pResource->GetResourceID()).Failed())
+    // The file is opened only once, the pixel data of wdTexture files is uploaded straight from the mapped file.
+    //
+    // If another process truncates a mapped file, accessing the lost pages raises SIGBUS on POSIX systems. The mapping only lives from
+    // OpenDataStream() until CloseDataStream(), so this can only happen if a texture file is overwritten in place while it is being
+    // (re)loaded. Files that are replaced by writing a new file and renaming it are safe.
+    if (pData->m_File.Open(pResource->GetResourceID()).Failed())
       return res;
 
-    const wdStringBuilder sAbsolutePath = File.GetFilePathAbsolute();
-    res.m_sResourceDescription = File.GetFilePathRelative().GetView();
+    const wdStringBuilder sAbsolutePath = pData->m_File.GetFilePathAbsolute();
+    res.m_sResourceDescription = pData->m_File.GetFilePathRelative();
 
 #if WD_ENABLED(WD_SUPPORTS_FILE_STATS)
     {
+      // the path is already resolved, files inside of archives need to be looked up again
       wdFileStats stat;
-      if (wdFileSystem::GetFileStats(pResource->GetResourceID(), stat).Succeeded())
+      if (wdOSFile::GetFileStats(sAbsolutePath, stat).Succeeded() || wdFileSystem::GetFileStats(pResource->GetResourceID(), stat).Succeeded())
       {
         res.m_LoadedFileModificationDate = stat.m_LastModificationTime;
       }
@@ -118,16 +123,31 @@ wdResourceLoadData wdTextureResourceLoader::OpenDataStream(const wdResource* pRe
 
     if (sAbsolutePath.HasExtension("wdTexture2D") || sAbsolutePath.HasExtension("wdTexture3D") || sAbsolutePath.HasExtension("wdTextureCube") || sAbsolutePath.HasExtension("wdRenderTarget") || sAbsolutePath.HasExtension("wdLUT"))
     {
-      if (LoadTexFile(File, *pData).Failed())
+      if (LoadTexFile(pData->m_File.GetData(), *pData).Failed())
         return res;
     }
     else
     {
       // read whatever format, as long as wdImage supports it
-      File.Close();
+      const wdStringView sExtension = wdPathUtils::GetFileExtension(sAbsolutePath);
+      const wdStringBuilder sExtensionZeroTerminated = sExtension;
 
-      if (pData->m_Image.LoadFrom(pResource->GetResourceID()).Failed())
+      wdImageFileFormat* pFormat = wdImageFileFormat::GetReaderFormat(sExtensionZeroTerminated);
+      if (pFormat == nullptr)
+      {
+        wdLog::Warning("No known image file format for extension '{0}'", sExtension);
+        return res;
+      }
+
+      wdRawMemoryStreamReader reader(pData->m_File.GetData().GetPtr(), pData->m_File.GetData().GetCount());
+      if (pFormat->ReadImage(reader, pData->m_Image, sExtensionZeroTerminated).Failed())
+      {
+        wdLog::Warning("Failed to read image file '{0}'", wdArgSensitive(sAbsolutePath, "File"));
         return res;
+      }
+
+      // the image has its own copy of the pixel data
+      pData->m_File.Close();
 
       if (pData->m_Image.GetImageFormat() == wdImageFormat::B8G8R8_UNORM)
       {
@@ -208,6 +228,40 @@ wdResult wdTextureResourceLoader::LoadTexFile(wdStreamReader& inout_stream, Load
   }
 }
 
+wdResult wdTextureResourceLoader::LoadTexFile(wdArrayPtr<const wdUInt8> fileData, LoadedData& ref_data)
+{
+  wdRawMemoryStreamReader reader(fileData.GetPtr(), fileData.GetCount());
+
+  // read the hash, ignore it
+  wdAssetFileHeader AssetHash;
+  WD_SUCCEED_OR_RETURN(AssetHash.Read(reader));
+
+  ref_data.m_TexFormat.ReadHeader(reader);
+
+  if (ref_data.m_TexFormat.m_iRenderTargetResolutionX != 0)
+    return WD_SUCCESS;
+
+  wdImageHeader imageHeader;
+  wdDdsFileFormat fmt;
+  WD_SUCCEED_OR_RETURN(fmt.ReadImageHeader(reader, imageHeader, "dds"));
+
+  // the DDS payload has the same layout as wdImage, so the image can use it as is
+  const wdUInt64 uiDataOffset = reader.GetReadPosition();
+  const wdUInt64 uiDataSize = imageHeader.ComputeDataSize();
+
+  if (uiDataOffset + uiDataSize > fileData.GetCount())
+  {
+    wdLog::Error("Failed to read image data.");
+    return WD_FAILURE;
+  }
+
+  // The mapped file is read-only. The texture resources only get a const wdImage from the load stream and never convert it.
+  wdUInt8* pImageData = const_cast<wdUInt8*>(fileData.GetPtr() + uiDataOffset);
+  ref_data.m_Image.ResetAndUseExternalStorage(imageHeader, wdByteBlobPtr(pImageData, uiDataSize));
+
+  return WD_SUCCESS;
+}
+
 void wdTextureResourceLoader::WriteTextureLoadStream(wdStreamWriter& w, const LoadedData& data)
 {
   const wdImage* pImage = &data.m_Image;
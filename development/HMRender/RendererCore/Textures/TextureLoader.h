@@ -2,6 +2,7 @@
 
 #include <Core/ResourceManager/Resource.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
+#include <Foundation/IO/FileSystem/MappedFileContent.h>
 #include <RendererCore/RenderContext/Implementation/RenderContextStructs.h>
 #include <RendererCore/RendererCoreDLL.h>
 #include <RendererFoundation/RendererFoundationDLL.h>
@@ -20,6 +21,7 @@ public:
 
     wdContiguousMemoryStreamStorage m_Storage;
     wdMemoryStreamReader m_Reader;
+    wdMappedFileContent m_File;
     wdImage m_Image;
 
     bool m_bIsFallback = false;
@@ -31,5 +33,8 @@ public:
   virtual bool IsResourceOutdated(const wdResource* pResource) const override;
 
   static wdResult LoadTexFile(wdStreamReader& inout_stream, LoadedData& ref_data);
+
+  /// \brief Reads a texture asset from memory. The image references the pixel data in \a fileData instead of copying it, so the data has to stay alive as long as the image.
+  static wdResult LoadTexFile(wdArrayPtr<const wdUInt8> fileData, LoadedData& ref_data);
   static void WriteTextureLoadStream(wdStreamWriter& inout_stream, const LoadedData& data);
 };
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <RendererFoundation/CommandEncoder/CommandEncoderPlatformInterface.h>
+
+class wdGALDeviceNull;
+
+/// \brief Platform command encoder of the null device, which discards all commands and only counts them in the device's statistics.
+class wdGALCommandEncoderImplNull : public wdGALCommandEncoderCommonPlatformInterface, public wdGALCommandEncoderRenderPlatformInterface, public wdGALCommandEncoderComputePlatformInterface
+{
+public:
+  wdGALCommandEncoderImplNull(wdGALDeviceNull& ref_deviceNull);
+  ~wdGALCommandEncoderImplNull();
+
+  // wdGALCommandEncoderCommonPlatformInterface
+  // State setting functions
+
+  virtual void SetShaderPlatform(const wdGALShader* pShader) override;
+
+  virtual void SetConstantBufferPlatform(wdUInt32 uiSlot, const wdGALBuffer* pBuffer) override;
+  virtual void SetSamplerStatePlatform(wdGALShaderStage::Enum stage, wdUInt32 uiSlot, const wdGALSamplerState* pSamplerState) override;
+  virtual void SetResourceViewPlatform(wdGALShaderStage::Enum stage, wdUInt32 uiSlot, const wdGALResourceView* pResourceView) override;
+  virtual void SetUnorderedAccessViewPlatform(wdUInt32 uiSlot, const wdGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Query functions
+
+  virtual void BeginQueryPlatform(const wdGALQuery* pQuery) override;
+  virtual void EndQueryPlatform(const wdGALQuery* pQuery) override;
+  virtual wdResult GetQueryResultPlatform(const wdGALQuery* pQuery, wdUInt64& ref_uiQueryResult) override;
+
+  // Timestamp functions
+
+  virtual void InsertTimestampPlatform(wdGALTimestampHandle hTimestamp) override;
+
+  // Resource update functions
+
+  virtual void ClearUnorderedAccessViewPlatform(const wdGALUnorderedAccessView* pUnorderedAccessView, wdVec4 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const wdGALUnorderedAccessView* pUnorderedAccessView, wdVec4U32 vClearValues) override;
+
+  virtual void CopyBufferPlatform(const wdGALBuffer* pDestination, const wdGALBuffer* pSource) override;
+  virtual void CopyBufferRegionPlatform(const wdGALBuffer* pDestination, wdUInt32 uiDestOffset, const wdGALBuffer* pSource, wdUInt32 uiSourceOffset, wdUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(const wdGALBuffer* pDestination, wdUInt32 uiDestOffset, wdArrayPtr<const wdUInt8> sourceData, wdGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const wdGALTexture* pDestination, const wdGALTexture* pSource) override;
+  virtual void CopyTextureRegionPlatform(const wdGALTexture* pDestination, const wdGALTextureSubresource& destinationSubResource, const wdVec3U32& vDestinationPoint, const wdGALTexture* pSource, const wdGALTextureSubresource& sourceSubResource, const wdBoundingBoxu32& box) override;
+
+  virtual void UpdateTexturePlatform(const wdGALTexture* pDestination, const wdGALTextureSubresource& destinationSubResource, const wdBoundingBoxu32& destinationBox, const wdGALSystemMemoryDescription& sourceData) override;
+
+  virtual void ResolveTexturePlatform(const wdGALTexture* pDestination, const wdGALTextureSubresource& destinationSubResource, const wdGALTexture* pSource, const wdGALTextureSubresource& sourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const wdGALTexture* pTexture) override;
+
+  virtual void CopyTextureReadbackResultPlatform(const wdGALTexture* pTexture, wdArrayPtr<wdGALTextureSubresource> sourceSubResource, wdArrayPtr<wdGALSystemMemoryDescription> targetData) override;
+
+  virtual void GenerateMipMapsPlatform(const wdGALResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+  virtual void PopMarkerPlatform() override;
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+  // wdGALCommandEncoderRenderPlatformInterface
+  // Draw functions
+
+  virtual void ClearPlatform(const wdColor& clearColor, wdUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, wdUInt8 uiStencilClear) override;
+
+  virtual void DrawPlatform(wdUInt32 uiVertexCount, wdUInt32 uiStartVertex) override;
+  virtual void DrawIndexedPlatform(wdUInt32 uiIndexCount, wdUInt32 uiStartIndex) override;
+  virtual void DrawIndexedInstancedPlatform(wdUInt32 uiIndexCountPerInstance, wdUInt32 uiInstanceCount, wdUInt32 uiStartIndex) override;
+  virtual void DrawIndexedInstancedIndirectPlatform(const wdGALBuffer* pIndirectArgumentBuffer, wdUInt32 uiArgumentOffsetInBytes) override;
+  virtual void DrawInstancedPlatform(wdUInt32 uiVertexCountPerInstance, wdUInt32 uiInstanceCount, wdUInt32 uiStartVertex) override;
+  virtual void DrawInstancedIndirectPlatform(const wdGALBuffer* pIndirectArgumentBuffer, wdUInt32 uiArgumentOffsetInBytes) override;
+  virtual void DrawAutoPlatform() override;
+
+  virtual void BeginStreamOutPlatform() override;
+  virtual void EndStreamOutPlatform() override;
+
+  // State functions
+
+  virtual void SetIndexBufferPlatform(const wdGALBuffer* pIndexBuffer) override;
+  virtual void SetVertexBufferPlatform(wdUInt32 uiSlot, const wdGALBuffer* pVertexBuffer) override;
+  virtual void SetVertexDeclarationPlatform(const wdGALVertexDeclaration* pVertexDeclaration) override;
+  virtual void SetPrimitiveTopologyPlatform(wdGALPrimitiveTopology::Enum topology) override;
+
+  virtual void SetBlendStatePlatform(const wdGALBlendState* pBlendState, const wdColor& blendFactor, wdUInt32 uiSampleMask) override;
+  virtual void SetDepthStencilStatePlatform(const wdGALDepthStencilState* pDepthStencilState, wdUInt8 uiStencilRefValue) override;
+  virtual void SetRasterizerStatePlatform(const wdGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const wdRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+  virtual void SetScissorRectPlatform(const wdRectU32& rect) override;
+
+  virtual void SetStreamOutBufferPlatform(wdUInt32 uiSlot, const wdGALBuffer* pBuffer, wdUInt32 uiOffset) override;
+
+  // wdGALCommandEncoderComputePlatformInterface
+  // Dispatch
+
+  virtual void DispatchPlatform(wdUInt32 uiThreadGroupCountX, wdUInt32 uiThreadGroupCountY, wdUInt32 uiThreadGroupCountZ) override;
+  virtual void DispatchIndirectPlatform(const wdGALBuffer* pIndirectArgumentBuffer, wdUInt32 uiArgumentOffsetInBytes) override;
+
+private:
+  wdGALDeviceNull& m_Device;
+};
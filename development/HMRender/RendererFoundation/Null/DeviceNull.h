@@ -0,0 +1,156 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Device.h>
+
+class wdGALPassNull;
+
+/// \brief Counts the work that was submitted to a wdGALDeviceNull.
+///
+/// Only calls that reach the platform layer are counted, i.e. redundant state changes that are filtered out by the
+/// platform independent command encoder are not included.
+struct wdGALDeviceNullStatistics
+{
+  wdUInt32 m_uiPipelines = 0;
+  wdUInt32 m_uiPasses = 0;
+  wdUInt32 m_uiRenderingScopes = 0;
+  wdUInt32 m_uiComputeScopes = 0;
+
+  wdUInt32 m_uiDrawCalls = 0;
+  wdUInt32 m_uiDispatchCalls = 0;
+  wdUInt32 m_uiClears = 0;
+
+  wdUInt32 m_uiShaderChanges = 0;
+  wdUInt32 m_uiConstantBufferChanges = 0;
+  wdUInt32 m_uiSamplerStateChanges = 0;
+  wdUInt32 m_uiResourceViewChanges = 0;
+  wdUInt32 m_uiUnorderedAccessViewChanges = 0;
+  wdUInt32 m_uiVertexBufferChanges = 0;
+  wdUInt32 m_uiIndexBufferChanges = 0;
+  wdUInt32 m_uiVertexDeclarationChanges = 0;
+  wdUInt32 m_uiPrimitiveTopologyChanges = 0;
+  wdUInt32 m_uiRenderStateChanges = 0; ///< Blend, depth stencil and rasterizer states.
+  wdUInt32 m_uiViewportChanges = 0;    ///< Viewports and scissor rects.
+
+  wdUInt32 m_uiBufferUpdates = 0;
+  wdUInt64 m_uiBufferUpdateBytes = 0;
+  wdUInt32 m_uiTextureUpdates = 0;
+  wdUInt32 m_uiCopies = 0;
+
+  wdUInt32 m_uiCreatedBuffers = 0;
+  wdUInt32 m_uiCreatedTextures = 0;
+  wdUInt32 m_uiCreatedViews = 0;
+  wdUInt32 m_uiCreatedStates = 0;
+  wdUInt32 m_uiCreatedShaders = 0;
+};
+
+/// \brief A GAL device that doesn't use any graphics API.
+///
+/// All resources are created without backing GPU memory and all commands are discarded after they have been counted.
+/// This allows to run and profile the CPU side of the renderer on machines without a GPU, e.g. on build agents.
+/// The device is registered as "Null" with the wdGALDeviceFactory. It reuses the DX11 shader model, so that existing
+/// compiled shaders can be loaded.
+class WD_RENDERERFOUNDATION_DLL wdGALDeviceNull : public wdGALDevice
+{
+private:
+  friend wdInternal::NewInstance<wdGALDevice> CreateNullDevice(wdAllocatorBase* pAllocator, const wdGALDeviceCreationDescription& description);
+  wdGALDeviceNull(const wdGALDeviceCreationDescription& Description);
+
+public:
+  virtual ~wdGALDeviceNull();
+
+  /// \brief Returns the work that was submitted since the last call to ResetStatistics().
+  const wdGALDeviceNullStatistics& GetStatistics() const { return m_Statistics; }
+
+  void ResetStatistics();
+
+protected:
+  // Init & shutdown functions
+
+  virtual wdResult InitPlatform() override;
+  virtual wdResult ShutdownPlatform() override;
+
+  // Pipeline & Pass functions
+
+  virtual void BeginPipelinePlatform(const char* szName, wdGALSwapChain* pSwapChain) override;
+  virtual void EndPipelinePlatform(wdGALSwapChain* pSwapChain) override;
+
+  virtual wdGALPass* BeginPassPlatform(const char* szName) override;
+  virtual void EndPassPlatform(wdGALPass* pPass) override;
+
+  // State creation functions
+
+  virtual wdGALBlendState* CreateBlendStatePlatform(const wdGALBlendStateCreationDescription& Description) override;
+  virtual void DestroyBlendStatePlatform(wdGALBlendState* pBlendState) override;
+
+  virtual wdGALDepthStencilState* CreateDepthStencilStatePlatform(const wdGALDepthStencilStateCreationDescription& Description) override;
+  virtual void DestroyDepthStencilStatePlatform(wdGALDepthStencilState* pDepthStencilState) override;
+
+  virtual wdGALRasterizerState* CreateRasterizerStatePlatform(const wdGALRasterizerStateCreationDescription& Description) override;
+  virtual void DestroyRasterizerStatePlatform(wdGALRasterizerState* pRasterizerState) override;
+
+  virtual wdGALSamplerState* CreateSamplerStatePlatform(const wdGALSamplerStateCreationDescription& Description) override;
+  virtual void DestroySamplerStatePlatform(wdGALSamplerState* pSamplerState) override;
+
+  // Resource creation functions
+
+  virtual wdGALShader* CreateShaderPlatform(const wdGALShaderCreationDescription& Description) override;
+  virtual void DestroyShaderPlatform(wdGALShader* pShader) override;
+
+  virtual wdGALBuffer* CreateBufferPlatform(const wdGALBufferCreationDescription& Description, wdArrayPtr<const wdUInt8> pInitialData) override;
+  virtual void DestroyBufferPlatform(wdGALBuffer* pBuffer) override;
+
+  virtual wdGALTexture* CreateTexturePlatform(const wdGALTextureCreationDescription& Description, wdArrayPtr<wdGALSystemMemoryDescription> pInitialData) override;
+  virtual void DestroyTexturePlatform(wdGALTexture* pTexture) override;
+
+  virtual wdGALResourceView* CreateResourceViewPlatform(wdGALResourceBase* pResource, const wdGALResourceViewCreationDescription& Description) override;
+  virtual void DestroyResourceViewPlatform(wdGALResourceView* pResourceView) override;
+
+  virtual wdGALRenderTargetView* CreateRenderTargetViewPlatform(wdGALTexture* pTexture, const wdGALRenderTargetViewCreationDescription& Description) override;
+  virtual void DestroyRenderTargetViewPlatform(wdGALRenderTargetView* pRenderTargetView) override;
+
+  virtual wdGALUnorderedAccessView* CreateUnorderedAccessViewPlatform(wdGALResourceBase* pResource, const wdGALUnorderedAccessViewCreationDescription& Description) override;
+  virtual void DestroyUnorderedAccessViewPlatform(wdGALUnorderedAccessView* pUnorderedAccessView) override;
+
+  // Other rendering creation functions
+
+  virtual wdGALQuery* CreateQueryPlatform(const wdGALQueryCreationDescription& Description) override;
+  virtual void DestroyQueryPlatform(wdGALQuery* pQuery) override;
+
+  virtual wdGALVertexDeclaration* CreateVertexDeclarationPlatform(const wdGALVertexDeclarationCreationDescription& Description) override;
+  virtual void DestroyVertexDeclarationPlatform(wdGALVertexDeclaration* pVertexDeclaration) override;
+
+  // Timestamp functions
+
+  virtual wdGALTimestampHandle GetTimestampPlatform() override;
+  virtual wdResult GetTimestampResultPlatform(wdGALTimestampHandle hTimestamp, wdTime& result) override;
+
+  // Misc functions
+
+  virtual void BeginFramePlatform(const wdUInt64 uiRenderFrame) override;
+  virtual void EndFramePlatform() override;
+
+  virtual void FillCapabilitiesPlatform() override;
+
+  virtual void WaitIdlePlatform() override;
+
+private:
+  friend class wdGALCommandEncoderImplNull;
+  friend class wdGALPassNull;
+
+  void InsertTimestamp(wdGALTimestampHandle hTimestamp);
+
+  wdUniquePtr<wdGALPassNull> m_pDefaultPass;
+
+  wdGALDeviceNullStatistics m_Statistics;
+
+  // there is no GPU, so timestamps are taken on the CPU when they are inserted into the command stream
+  wdDynamicArray<wdTime> m_Timestamps;
+  wdUInt32 m_uiNextTimestamp = 0;
+  wdUInt64 m_uiFrameCounter = 0;
+
+#if WD_ENABLED(WD_USE_PROFILING)
+  struct GPUTimingScope* m_pPipelineTimingScope = nullptr;
+  struct GPUTimingScope* m_pPassTimingScope = nullptr;
+#endif
+};
@@ -0,0 +1,237 @@
+#include <RendererFoundation/RendererFoundationPCH.h>
+
+#include <RendererFoundation/Null/CommandEncoderImplNull.h>
+#include <RendererFoundation/Null/DeviceNull.h>
+
+wdGALCommandEncoderImplNull::wdGALCommandEncoderImplNull(wdGALDeviceNull& ref_deviceNull)
+  : m_Device(ref_deviceNull)
+{
+}
+
+wdGALCommandEncoderImplNull::~wdGALCommandEncoderImplNull() = default;
+
+// State setting functions
+
+void wdGALCommandEncoderImplNull::SetShaderPlatform(const wdGALShader* pShader)
+{
+  ++m_Device.m_Statistics.m_uiShaderChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetConstantBufferPlatform(wdUInt32 uiSlot, const wdGALBuffer* pBuffer)
+{
+  ++m_Device.m_Statistics.m_uiConstantBufferChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetSamplerStatePlatform(wdGALShaderStage::Enum stage, wdUInt32 uiSlot, const wdGALSamplerState* pSamplerState)
+{
+  ++m_Device.m_Statistics.m_uiSamplerStateChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetResourceViewPlatform(wdGALShaderStage::Enum stage, wdUInt32 uiSlot, const wdGALResourceView* pResourceView)
+{
+  ++m_Device.m_Statistics.m_uiResourceViewChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(wdUInt32 uiSlot, const wdGALUnorderedAccessView* pUnorderedAccessView)
+{
+  ++m_Device.m_Statistics.m_uiUnorderedAccessViewChanges;
+}
+
+// Query functions
+
+void wdGALCommandEncoderImplNull::BeginQueryPlatform(const wdGALQuery* pQuery) {}
+
+void wdGALCommandEncoderImplNull::EndQueryPlatform(const wdGALQuery* pQuery) {}
+
+wdResult wdGALCommandEncoderImplNull::GetQueryResultPlatform(const wdGALQuery* pQuery, wdUInt64& ref_uiQueryResult)
+{
+  ref_uiQueryResult = 0;
+  return WD_SUCCESS;
+}
+
+// Timestamp functions
+
+void wdGALCommandEncoderImplNull::InsertTimestampPlatform(wdGALTimestampHandle hTimestamp)
+{
+  m_Device.InsertTimestamp(hTimestamp);
+}
+
+// Resource update functions
+
+void wdGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const wdGALUnorderedAccessView* pUnorderedAccessView, wdVec4 vClearValues)
+{
+  ++m_Device.m_Statistics.m_uiClears;
+}
+
+void wdGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const wdGALUnorderedAccessView* pUnorderedAccessView, wdVec4U32 vClearValues)
+{
+  ++m_Device.m_Statistics.m_uiClears;
+}
+
+void wdGALCommandEncoderImplNull::CopyBufferPlatform(const wdGALBuffer* pDestination, const wdGALBuffer* pSource)
+{
+  ++m_Device.m_Statistics.m_uiCopies;
+}
+
+void wdGALCommandEncoderImplNull::CopyBufferRegionPlatform(const wdGALBuffer* pDestination, wdUInt32 uiDestOffset, const wdGALBuffer* pSource, wdUInt32 uiSourceOffset, wdUInt32 uiByteCount)
+{
+  ++m_Device.m_Statistics.m_uiCopies;
+}
+
+void wdGALCommandEncoderImplNull::UpdateBufferPlatform(const wdGALBuffer* pDestination, wdUInt32 uiDestOffset, wdArrayPtr<const wdUInt8> sourceData, wdGALUpdateMode::Enum updateMode)
+{
+  ++m_Device.m_Statistics.m_uiBufferUpdates;
+  m_Device.m_Statistics.m_uiBufferUpdateBytes += sourceData.GetCount();
+}
+
+void wdGALCommandEncoderImplNull::CopyTexturePlatform(const wdGALTexture* pDestination, const wdGALTexture* pSource)
+{
+  ++m_Device.m_Statistics.m_uiCopies;
+}
+
+void wdGALCommandEncoderImplNull::CopyTextureRegionPlatform(const wdGALTexture* pDestination, const wdGALTextureSubresource& destinationSubResource, const wdVec3U32& vDestinationPoint, const wdGALTexture* pSource, const wdGALTextureSubresource& sourceSubResource, const wdBoundingBoxu32& box)
+{
+  ++m_Device.m_Statistics.m_uiCopies;
+}
+
+void wdGALCommandEncoderImplNull::UpdateTexturePlatform(const wdGALTexture* pDestination, const wdGALTextureSubresource& destinationSubResource, const wdBoundingBoxu32& destinationBox, const wdGALSystemMemoryDescription& sourceData)
+{
+  ++m_Device.m_Statistics.m_uiTextureUpdates;
+}
+
+void wdGALCommandEncoderImplNull::ResolveTexturePlatform(const wdGALTexture* pDestination, const wdGALTextureSubresource& destinationSubResource, const wdGALTexture* pSource, const wdGALTextureSubresource& sourceSubResource)
+{
+  ++m_Device.m_Statistics.m_uiCopies;
+}
+
+void wdGALCommandEncoderImplNull::ReadbackTexturePlatform(const wdGALTexture* pTexture)
+{
+  ++m_Device.m_Statistics.m_uiCopies;
+}
+
+void wdGALCommandEncoderImplNull::CopyTextureReadbackResultPlatform(const wdGALTexture* pTexture, wdArrayPtr<wdGALTextureSubresource> sourceSubResource, wdArrayPtr<wdGALSystemMemoryDescription> targetData)
+{
+  // there is no texture memory, the target data is left untouched
+}
+
+void wdGALCommandEncoderImplNull::GenerateMipMapsPlatform(const wdGALResourceView* pResourceView) {}
+
+// Misc
+
+void wdGALCommandEncoderImplNull::FlushPlatform() {}
+
+// Debug helper functions
+
+void wdGALCommandEncoderImplNull::PushMarkerPlatform(const char* szMarker) {}
+
+void wdGALCommandEncoderImplNull::PopMarkerPlatform() {}
+
+void wdGALCommandEncoderImplNull::InsertEventMarkerPlatform(const char* szMarker) {}
+
+//////////////////////////////////////////////////////////////////////////
+
+void wdGALCommandEncoderImplNull::ClearPlatform(const wdColor& clearColor, wdUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, wdUInt8 uiStencilClear)
+{
+  ++m_Device.m_Statistics.m_uiClears;
+}
+
+void wdGALCommandEncoderImplNull::DrawPlatform(wdUInt32 uiVertexCount, wdUInt32 uiStartVertex)
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::DrawIndexedPlatform(wdUInt32 uiIndexCount, wdUInt32 uiStartIndex)
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::DrawIndexedInstancedPlatform(wdUInt32 uiIndexCountPerInstance, wdUInt32 uiInstanceCount, wdUInt32 uiStartIndex)
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::DrawIndexedInstancedIndirectPlatform(const wdGALBuffer* pIndirectArgumentBuffer, wdUInt32 uiArgumentOffsetInBytes)
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::DrawInstancedPlatform(wdUInt32 uiVertexCountPerInstance, wdUInt32 uiInstanceCount, wdUInt32 uiStartVertex)
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::DrawInstancedIndirectPlatform(const wdGALBuffer* pIndirectArgumentBuffer, wdUInt32 uiArgumentOffsetInBytes)
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::DrawAutoPlatform()
+{
+  ++m_Device.m_Statistics.m_uiDrawCalls;
+}
+
+void wdGALCommandEncoderImplNull::BeginStreamOutPlatform() {}
+
+void wdGALCommandEncoderImplNull::EndStreamOutPlatform() {}
+
+void wdGALCommandEncoderImplNull::SetIndexBufferPlatform(const wdGALBuffer* pIndexBuffer)
+{
+  ++m_Device.m_Statistics.m_uiIndexBufferChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetVertexBufferPlatform(wdUInt32 uiSlot, const wdGALBuffer* pVertexBuffer)
+{
+  ++m_Device.m_Statistics.m_uiVertexBufferChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetVertexDeclarationPlatform(const wdGALVertexDeclaration* pVertexDeclaration)
+{
+  ++m_Device.m_Statistics.m_uiVertexDeclarationChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetPrimitiveTopologyPlatform(wdGALPrimitiveTopology::Enum topology)
+{
+  ++m_Device.m_Statistics.m_uiPrimitiveTopologyChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetBlendStatePlatform(const wdGALBlendState* pBlendState, const wdColor& blendFactor, wdUInt32 uiSampleMask)
+{
+  ++m_Device.m_Statistics.m_uiRenderStateChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetDepthStencilStatePlatform(const wdGALDepthStencilState* pDepthStencilState, wdUInt8 uiStencilRefValue)
+{
+  ++m_Device.m_Statistics.m_uiRenderStateChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetRasterizerStatePlatform(const wdGALRasterizerState* pRasterizerState)
+{
+  ++m_Device.m_Statistics.m_uiRenderStateChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetViewportPlatform(const wdRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  ++m_Device.m_Statistics.m_uiViewportChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetScissorRectPlatform(const wdRectU32& rect)
+{
+  ++m_Device.m_Statistics.m_uiViewportChanges;
+}
+
+void wdGALCommandEncoderImplNull::SetStreamOutBufferPlatform(wdUInt32 uiSlot, const wdGALBuffer* pBuffer, wdUInt32 uiOffset) {}
+
+//////////////////////////////////////////////////////////////////////////
+
+void wdGALCommandEncoderImplNull::DispatchPlatform(wdUInt32 uiThreadGroupCountX, wdUInt32 uiThreadGroupCountY, wdUInt32 uiThreadGroupCountZ)
+{
+  ++m_Device.m_Statistics.m_uiDispatchCalls;
+}
+
+void wdGALCommandEncoderImplNull::DispatchIndirectPlatform(const wdGALBuffer* pIndirectArgumentBuffer, wdUInt32 uiArgumentOffsetInBytes)
+{
+  ++m_Device.m_Statistics.m_uiDispatchCalls;
+}
+
+
+WD_STATICLINK_FILE(RendererFoundation, RendererFoundation_Null_Implementation_CommandEncoderImplNull);
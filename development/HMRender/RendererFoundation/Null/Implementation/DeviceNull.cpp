@@ -0,0 +1,466 @@
+#include <RendererFoundation/RendererFoundationPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Logging/Log.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererFoundation/Null/CommandEncoderImplNull.h>
+#include <RendererFoundation/Null/DeviceNull.h>
+#include <RendererFoundation/Null/PassNull.h>
+#include <RendererFoundation/Null/ResourcesNull.h>
+#include <RendererFoundation/Profiling/Profiling.h>
+
+wdInternal::NewInstance<wdGALDevice> CreateNullDevice(wdAllocatorBase* pAllocator, const wdGALDeviceCreationDescription& description)
+{
+  return WD_NEW(pAllocator, wdGALDeviceNull, description);
+}
+
+// clang-format off
+WD_BEGIN_SUBSYSTEM_DECLARATION(RendererFoundation, DeviceFactoryNull)
+
+ON_CORESYSTEMS_STARTUP
+{
+  wdGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "DX11_SM50", "wdShaderCompilerHLSL");
+}
+
+ON_CORESYSTEMS_SHUTDOWN
+{
+  wdGALDeviceFactory::UnregisterCreatorFunc("Null");
+}
+
+WD_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+wdGALDeviceNull::wdGALDeviceNull(const wdGALDeviceCreationDescription& Description)
+  : wdGALDevice(Description)
+{
+}
+
+wdGALDeviceNull::~wdGALDeviceNull() = default;
+
+void wdGALDeviceNull::ResetStatistics()
+{
+  m_Statistics = wdGALDeviceNullStatistics();
+}
+
+// Init & shutdown functions
+
+wdResult wdGALDeviceNull::InitPlatform()
+{
+  WD_LOG_BLOCK("wdGALDeviceNull::InitPlatform");
+
+  m_Timestamps.SetCount(1024);
+
+  m_pDefaultPass = WD_NEW(&m_Allocator, wdGALPassNull, *this);
+
+  wdLog::Success("Initialized null graphics device, no rendering output will be produced.");
+
+  return WD_SUCCESS;
+}
+
+wdResult wdGALDeviceNull::ShutdownPlatform()
+{
+  m_pDefaultPass = nullptr;
+
+  return WD_SUCCESS;
+}
+
+// Pipeline & Pass functions
+
+void wdGALDeviceNull::BeginPipelinePlatform(const char* szName, wdGALSwapChain* pSwapChain)
+{
+  ++m_Statistics.m_uiPipelines;
+
+#if WD_ENABLED(WD_USE_PROFILING)
+  m_pPipelineTimingScope = wdProfilingScopeAndMarker::Start(m_pDefaultPass->m_pRenderCommandEncoder.Borrow(), szName);
+#endif
+
+  if (pSwapChain)
+  {
+    pSwapChain->AcquireNextRenderTarget(this);
+  }
+}
+
+void wdGALDeviceNull::EndPipelinePlatform(wdGALSwapChain* pSwapChain)
+{
+  if (pSwapChain)
+  {
+    pSwapChain->PresentRenderTarget(this);
+  }
+
+#if WD_ENABLED(WD_USE_PROFILING)
+  wdProfilingScopeAndMarker::Stop(m_pDefaultPass->m_pRenderCommandEncoder.Borrow(), m_pPipelineTimingScope);
+#endif
+}
+
+wdGALPass* wdGALDeviceNull::BeginPassPlatform(const char* szName)
+{
+  ++m_Statistics.m_uiPasses;
+
+#if WD_ENABLED(WD_USE_PROFILING)
+  m_pPassTimingScope = wdProfilingScopeAndMarker::Start(m_pDefaultPass->m_pRenderCommandEncoder.Borrow(), szName);
+#endif
+
+  return m_pDefaultPass.Borrow();
+}
+
+void wdGALDeviceNull::EndPassPlatform(wdGALPass* pPass)
+{
+  WD_ASSERT_DEV(m_pDefaultPass.Borrow() == pPass, "Invalid pass");
+
+#if WD_ENABLED(WD_USE_PROFILING)
+  wdProfilingScopeAndMarker::Stop(m_pDefaultPass->m_pRenderCommandEncoder.Borrow(), m_pPassTimingScope);
+#endif
+}
+
+// State creation functions
+
+wdGALBlendState* wdGALDeviceNull::CreateBlendStatePlatform(const wdGALBlendStateCreationDescription& Description)
+{
+  wdGALBlendStateNull* pState = WD_NEW(&m_Allocator, wdGALBlendStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedStates;
+    return pState;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyBlendStatePlatform(wdGALBlendState* pBlendState)
+{
+  wdGALBlendStateNull* pState = static_cast<wdGALBlendStateNull*>(pBlendState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pState);
+}
+
+wdGALDepthStencilState* wdGALDeviceNull::CreateDepthStencilStatePlatform(const wdGALDepthStencilStateCreationDescription& Description)
+{
+  wdGALDepthStencilStateNull* pState = WD_NEW(&m_Allocator, wdGALDepthStencilStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedStates;
+    return pState;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyDepthStencilStatePlatform(wdGALDepthStencilState* pDepthStencilState)
+{
+  wdGALDepthStencilStateNull* pState = static_cast<wdGALDepthStencilStateNull*>(pDepthStencilState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pState);
+}
+
+wdGALRasterizerState* wdGALDeviceNull::CreateRasterizerStatePlatform(const wdGALRasterizerStateCreationDescription& Description)
+{
+  wdGALRasterizerStateNull* pState = WD_NEW(&m_Allocator, wdGALRasterizerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedStates;
+    return pState;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyRasterizerStatePlatform(wdGALRasterizerState* pRasterizerState)
+{
+  wdGALRasterizerStateNull* pState = static_cast<wdGALRasterizerStateNull*>(pRasterizerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pState);
+}
+
+wdGALSamplerState* wdGALDeviceNull::CreateSamplerStatePlatform(const wdGALSamplerStateCreationDescription& Description)
+{
+  wdGALSamplerStateNull* pState = WD_NEW(&m_Allocator, wdGALSamplerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedStates;
+    return pState;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroySamplerStatePlatform(wdGALSamplerState* pSamplerState)
+{
+  wdGALSamplerStateNull* pState = static_cast<wdGALSamplerStateNull*>(pSamplerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pState);
+}
+
+// Resource creation functions
+
+wdGALShader* wdGALDeviceNull::CreateShaderPlatform(const wdGALShaderCreationDescription& Description)
+{
+  wdGALShaderNull* pShader = WD_NEW(&m_Allocator, wdGALShaderNull, Description);
+
+  if (pShader->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedShaders;
+    return pShader;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyShaderPlatform(wdGALShader* pShader)
+{
+  wdGALShaderNull* pShaderNull = static_cast<wdGALShaderNull*>(pShader);
+  pShaderNull->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pShaderNull);
+}
+
+wdGALBuffer* wdGALDeviceNull::CreateBufferPlatform(const wdGALBufferCreationDescription& Description, wdArrayPtr<const wdUInt8> pInitialData)
+{
+  wdGALBufferNull* pBuffer = WD_NEW(&m_Allocator, wdGALBufferNull, Description);
+
+  if (pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedBuffers;
+    return pBuffer;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyBufferPlatform(wdGALBuffer* pBuffer)
+{
+  wdGALBufferNull* pBufferNull = static_cast<wdGALBufferNull*>(pBuffer);
+  pBufferNull->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pBufferNull);
+}
+
+wdGALTexture* wdGALDeviceNull::CreateTexturePlatform(const wdGALTextureCreationDescription& Description, wdArrayPtr<wdGALSystemMemoryDescription> pInitialData)
+{
+  wdGALTextureNull* pTexture = WD_NEW(&m_Allocator, wdGALTextureNull, Description);
+
+  if (pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedTextures;
+    return pTexture;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyTexturePlatform(wdGALTexture* pTexture)
+{
+  wdGALTextureNull* pTextureNull = static_cast<wdGALTextureNull*>(pTexture);
+  pTextureNull->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pTextureNull);
+}
+
+wdGALResourceView* wdGALDeviceNull::CreateResourceViewPlatform(wdGALResourceBase* pResource, const wdGALResourceViewCreationDescription& Description)
+{
+  wdGALResourceViewNull* pView = WD_NEW(&m_Allocator, wdGALResourceViewNull, pResource, Description);
+
+  if (pView->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedViews;
+    return pView;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pView);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyResourceViewPlatform(wdGALResourceView* pResourceView)
+{
+  wdGALResourceViewNull* pView = static_cast<wdGALResourceViewNull*>(pResourceView);
+  pView->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pView);
+}
+
+wdGALRenderTargetView* wdGALDeviceNull::CreateRenderTargetViewPlatform(wdGALTexture* pTexture, const wdGALRenderTargetViewCreationDescription& Description)
+{
+  wdGALRenderTargetViewNull* pView = WD_NEW(&m_Allocator, wdGALRenderTargetViewNull, pTexture, Description);
+
+  if (pView->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedViews;
+    return pView;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pView);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyRenderTargetViewPlatform(wdGALRenderTargetView* pRenderTargetView)
+{
+  wdGALRenderTargetViewNull* pView = static_cast<wdGALRenderTargetViewNull*>(pRenderTargetView);
+  pView->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pView);
+}
+
+wdGALUnorderedAccessView* wdGALDeviceNull::CreateUnorderedAccessViewPlatform(wdGALResourceBase* pResource, const wdGALUnorderedAccessViewCreationDescription& Description)
+{
+  wdGALUnorderedAccessViewNull* pView = WD_NEW(&m_Allocator, wdGALUnorderedAccessViewNull, pResource, Description);
+
+  if (pView->InitPlatform(this).Succeeded())
+  {
+    ++m_Statistics.m_uiCreatedViews;
+    return pView;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pView);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyUnorderedAccessViewPlatform(wdGALUnorderedAccessView* pUnorderedAccessView)
+{
+  wdGALUnorderedAccessViewNull* pView = static_cast<wdGALUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pView->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pView);
+}
+
+// Other rendering creation functions
+
+wdGALQuery* wdGALDeviceNull::CreateQueryPlatform(const wdGALQueryCreationDescription& Description)
+{
+  wdGALQueryNull* pQuery = WD_NEW(&m_Allocator, wdGALQueryNull, Description);
+
+  if (pQuery->InitPlatform(this).Succeeded())
+  {
+    return pQuery;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pQuery);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyQueryPlatform(wdGALQuery* pQuery)
+{
+  wdGALQueryNull* pQueryNull = static_cast<wdGALQueryNull*>(pQuery);
+  pQueryNull->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pQueryNull);
+}
+
+wdGALVertexDeclaration* wdGALDeviceNull::CreateVertexDeclarationPlatform(const wdGALVertexDeclarationCreationDescription& Description)
+{
+  wdGALVertexDeclarationNull* pDeclaration = WD_NEW(&m_Allocator, wdGALVertexDeclarationNull, Description);
+
+  if (pDeclaration->InitPlatform(this).Succeeded())
+  {
+    return pDeclaration;
+  }
+  else
+  {
+    WD_DELETE(&m_Allocator, pDeclaration);
+    return nullptr;
+  }
+}
+
+void wdGALDeviceNull::DestroyVertexDeclarationPlatform(wdGALVertexDeclaration* pVertexDeclaration)
+{
+  wdGALVertexDeclarationNull* pDeclaration = static_cast<wdGALVertexDeclarationNull*>(pVertexDeclaration);
+  pDeclaration->DeInitPlatform(this).IgnoreResult();
+  WD_DELETE(&m_Allocator, pDeclaration);
+}
+
+// Timestamp functions
+
+wdGALTimestampHandle wdGALDeviceNull::GetTimestampPlatform()
+{
+  wdUInt32 uiIndex = m_uiNextTimestamp;
+  m_uiNextTimestamp = (m_uiNextTimestamp + 1) % m_Timestamps.GetCount();
+  return {uiIndex, m_uiFrameCounter};
+}
+
+wdResult wdGALDeviceNull::GetTimestampResultPlatform(wdGALTimestampHandle hTimestamp, wdTime& result)
+{
+  result = m_Timestamps[static_cast<wdUInt32>(hTimestamp.m_uiIndex)];
+  return WD_SUCCESS;
+}
+
+void wdGALDeviceNull::InsertTimestamp(wdGALTimestampHandle hTimestamp)
+{
+  m_Timestamps[static_cast<wdUInt32>(hTimestamp.m_uiIndex)] = wdTime::Now();
+}
+
+// Misc functions
+
+void wdGALDeviceNull::BeginFramePlatform(const wdUInt64 uiRenderFrame)
+{
+  m_uiFrameCounter = uiRenderFrame;
+}
+
+void wdGALDeviceNull::EndFramePlatform()
+{
+}
+
+void wdGALDeviceNull::FillCapabilitiesPlatform()
+{
+  // report everything as supported, so that the renderer takes the same code paths as on a modern GPU
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+  m_Capabilities.m_bMultithreadedResourceCreation = true;
+  m_Capabilities.m_bNoOverwriteBufferUpdate = true;
+  m_Capabilities.m_bB5G6R5Textures = true;
+
+  for (wdUInt32 i = 0; i < wdGALShaderStage::ENUM_COUNT; ++i)
+  {
+    m_Capabilities.m_bShaderStageSupported[i] = true;
+  }
+
+  m_Capabilities.m_bInstancing = true;
+  m_Capabilities.m_b32BitIndices = true;
+  m_Capabilities.m_bIndirectDraw = true;
+  m_Capabilities.m_bStreamOut = true;
+  m_Capabilities.m_uiMaxConstantBuffers = 14;
+  m_Capabilities.m_bTextureArrays = true;
+  m_Capabilities.m_bCubemapArrays = true;
+  m_Capabilities.m_uiMaxTextureDimension = 16384;
+  m_Capabilities.m_uiMaxCubemapDimension = 16384;
+  m_Capabilities.m_uiMax3DTextureDimension = 2048;
+  m_Capabilities.m_uiMaxAnisotropy = 16;
+  m_Capabilities.m_uiMaxRendertargets = 8;
+  m_Capabilities.m_uiUAVCount = 64;
+  m_Capabilities.m_bAlphaToCoverage = true;
+  m_Capabilities.m_bConservativeRasterization = true;
+  m_Capabilities.m_bVertexShaderRenderTargetArrayIndex = true;
+}
+
+void wdGALDeviceNull::WaitIdlePlatform()
+{
+  DestroyDeadObjects();
+}
+
+
+WD_STATICLINK_FILE(RendererFoundation, RendererFoundation_Null_Implementation_DeviceNull);
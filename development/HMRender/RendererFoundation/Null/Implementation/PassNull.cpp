@@ -0,0 +1,53 @@
+#include <RendererFoundation/RendererFoundationPCH.h>
+
+#include <RendererFoundation/CommandEncoder/CommandEncoderState.h>
+#include <RendererFoundation/CommandEncoder/ComputeCommandEncoder.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererFoundation/Null/CommandEncoderImplNull.h>
+#include <RendererFoundation/Null/DeviceNull.h>
+#include <RendererFoundation/Null/PassNull.h>
+#include <RendererFoundation/Resources/RenderTargetSetup.h>
+
+wdGALPassNull::wdGALPassNull(wdGALDevice& device)
+  : wdGALPass(device)
+{
+  m_pCommandEncoderState = WD_DEFAULT_NEW(wdGALCommandEncoderRenderState);
+  m_pCommandEncoderImpl = WD_DEFAULT_NEW(wdGALCommandEncoderImplNull, static_cast<wdGALDeviceNull&>(device));
+
+  m_pRenderCommandEncoder = WD_DEFAULT_NEW(wdGALRenderCommandEncoder, device, *m_pCommandEncoderState, *m_pCommandEncoderImpl, *m_pCommandEncoderImpl);
+  m_pComputeCommandEncoder = WD_DEFAULT_NEW(wdGALComputeCommandEncoder, device, *m_pCommandEncoderState, *m_pCommandEncoderImpl, *m_pCommandEncoderImpl);
+}
+
+wdGALPassNull::~wdGALPassNull() = default;
+
+wdGALRenderCommandEncoder* wdGALPassNull::BeginRenderingPlatform(const wdGALRenderingSetup& renderingSetup, const char* szName)
+{
+  ++static_cast<wdGALDeviceNull&>(m_Device).m_Statistics.m_uiRenderingScopes;
+
+  if (renderingSetup.m_uiRenderTargetClearMask != 0 || renderingSetup.m_bClearDepth || renderingSetup.m_bClearStencil)
+  {
+    m_pCommandEncoderImpl->ClearPlatform(renderingSetup.m_ClearColor, renderingSetup.m_uiRenderTargetClearMask, renderingSetup.m_bClearDepth, renderingSetup.m_bClearStencil, renderingSetup.m_fDepthClear, renderingSetup.m_uiStencilClear);
+  }
+
+  return m_pRenderCommandEncoder.Borrow();
+}
+
+void wdGALPassNull::EndRenderingPlatform(wdGALRenderCommandEncoder* pCommandEncoder)
+{
+  WD_ASSERT_DEV(m_pRenderCommandEncoder.Borrow() == pCommandEncoder, "Invalid command encoder");
+}
+
+wdGALComputeCommandEncoder* wdGALPassNull::BeginComputePlatform(const char* szName)
+{
+  ++static_cast<wdGALDeviceNull&>(m_Device).m_Statistics.m_uiComputeScopes;
+
+  return m_pComputeCommandEncoder.Borrow();
+}
+
+void wdGALPassNull::EndComputePlatform(wdGALComputeCommandEncoder* pCommandEncoder)
+{
+  WD_ASSERT_DEV(m_pComputeCommandEncoder.Borrow() == pCommandEncoder, "Invalid command encoder");
+}
+
+
+WD_STATICLINK_FILE(RendererFoundation, RendererFoundation_Null_Implementation_PassNull);
@@ -0,0 +1,242 @@
+#include <RendererFoundation/RendererFoundationPCH.h>
+
+#include <RendererFoundation/Null/ResourcesNull.h>
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALBufferNull::wdGALBufferNull(const wdGALBufferCreationDescription& Description)
+  : wdGALBuffer(Description)
+{
+}
+
+wdGALBufferNull::~wdGALBufferNull() = default;
+
+wdResult wdGALBufferNull::InitPlatform(wdGALDevice* pDevice, wdArrayPtr<const wdUInt8> pInitialData)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALBufferNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+void wdGALBufferNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALTextureNull::wdGALTextureNull(const wdGALTextureCreationDescription& Description)
+  : wdGALTexture(Description)
+{
+}
+
+wdGALTextureNull::~wdGALTextureNull() = default;
+
+wdResult wdGALTextureNull::InitPlatform(wdGALDevice* pDevice, wdArrayPtr<wdGALSystemMemoryDescription> pInitialData)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALTextureNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+void wdGALTextureNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALResourceViewNull::wdGALResourceViewNull(wdGALResourceBase* pResource, const wdGALResourceViewCreationDescription& Description)
+  : wdGALResourceView(pResource, Description)
+{
+}
+
+wdGALResourceViewNull::~wdGALResourceViewNull() = default;
+
+wdResult wdGALResourceViewNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALResourceViewNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALRenderTargetViewNull::wdGALRenderTargetViewNull(wdGALTexture* pTexture, const wdGALRenderTargetViewCreationDescription& Description)
+  : wdGALRenderTargetView(pTexture, Description)
+{
+}
+
+wdGALRenderTargetViewNull::~wdGALRenderTargetViewNull() = default;
+
+wdResult wdGALRenderTargetViewNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALRenderTargetViewNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALUnorderedAccessViewNull::wdGALUnorderedAccessViewNull(wdGALResourceBase* pResource, const wdGALUnorderedAccessViewCreationDescription& Description)
+  : wdGALUnorderedAccessView(pResource, Description)
+{
+}
+
+wdGALUnorderedAccessViewNull::~wdGALUnorderedAccessViewNull() = default;
+
+wdResult wdGALUnorderedAccessViewNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALUnorderedAccessViewNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALQueryNull::wdGALQueryNull(const wdGALQueryCreationDescription& Description)
+  : wdGALQuery(Description)
+{
+}
+
+wdGALQueryNull::~wdGALQueryNull() = default;
+
+wdResult wdGALQueryNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALQueryNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+void wdGALQueryNull::SetDebugNamePlatform(const char* szName) const {}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALShaderNull::wdGALShaderNull(const wdGALShaderCreationDescription& Description)
+  : wdGALShader(Description)
+{
+}
+
+wdGALShaderNull::~wdGALShaderNull() = default;
+
+void wdGALShaderNull::SetDebugName(const char* szName) const {}
+
+wdResult wdGALShaderNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALShaderNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALVertexDeclarationNull::wdGALVertexDeclarationNull(const wdGALVertexDeclarationCreationDescription& Description)
+  : wdGALVertexDeclaration(Description)
+{
+}
+
+wdGALVertexDeclarationNull::~wdGALVertexDeclarationNull() = default;
+
+wdResult wdGALVertexDeclarationNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALVertexDeclarationNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALBlendStateNull::wdGALBlendStateNull(const wdGALBlendStateCreationDescription& Description)
+  : wdGALBlendState(Description)
+{
+}
+
+wdGALBlendStateNull::~wdGALBlendStateNull() = default;
+
+wdResult wdGALBlendStateNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALBlendStateNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALDepthStencilStateNull::wdGALDepthStencilStateNull(const wdGALDepthStencilStateCreationDescription& Description)
+  : wdGALDepthStencilState(Description)
+{
+}
+
+wdGALDepthStencilStateNull::~wdGALDepthStencilStateNull() = default;
+
+wdResult wdGALDepthStencilStateNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALDepthStencilStateNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALRasterizerStateNull::wdGALRasterizerStateNull(const wdGALRasterizerStateCreationDescription& Description)
+  : wdGALRasterizerState(Description)
+{
+}
+
+wdGALRasterizerStateNull::~wdGALRasterizerStateNull() = default;
+
+wdResult wdGALRasterizerStateNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALRasterizerStateNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+wdGALSamplerStateNull::wdGALSamplerStateNull(const wdGALSamplerStateCreationDescription& Description)
+  : wdGALSamplerState(Description)
+{
+}
+
+wdGALSamplerStateNull::~wdGALSamplerStateNull() = default;
+
+wdResult wdGALSamplerStateNull::InitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+wdResult wdGALSamplerStateNull::DeInitPlatform(wdGALDevice* pDevice)
+{
+  return WD_SUCCESS;
+}
+
+
+WD_STATICLINK_FILE(RendererFoundation, RendererFoundation_Null_Implementation_ResourcesNull);
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Foundation/Types/UniquePtr.h>
+#include <RendererFoundation/Device/Pass.h>
+
+struct wdGALCommandEncoderRenderState;
+class wdGALRenderCommandEncoder;
+class wdGALComputeCommandEncoder;
+
+class wdGALCommandEncoderImplNull;
+
+class wdGALPassNull : public wdGALPass
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALPassNull(wdGALDevice& device);
+  virtual ~wdGALPassNull();
+
+  virtual wdGALRenderCommandEncoder* BeginRenderingPlatform(const wdGALRenderingSetup& renderingSetup, const char* szName) override;
+  virtual void EndRenderingPlatform(wdGALRenderCommandEncoder* pCommandEncoder) override;
+
+  virtual wdGALComputeCommandEncoder* BeginComputePlatform(const char* szName) override;
+  virtual void EndComputePlatform(wdGALComputeCommandEncoder* pCommandEncoder) override;
+
+private:
+  wdUniquePtr<wdGALCommandEncoderRenderState> m_pCommandEncoderState;
+  wdUniquePtr<wdGALCommandEncoderImplNull> m_pCommandEncoderImpl;
+
+  wdUniquePtr<wdGALRenderCommandEncoder> m_pRenderCommandEncoder;
+  wdUniquePtr<wdGALComputeCommandEncoder> m_pComputeCommandEncoder;
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <RendererFoundation/Resources/Buffer.h>
+#include <RendererFoundation/Resources/Query.h>
+#include <RendererFoundation/Resources/RenderTargetView.h>
+#include <RendererFoundation/Resources/ResourceView.h>
+#include <RendererFoundation/Resources/Texture.h>
+#include <RendererFoundation/Resources/UnorderedAccesView.h>
+#include <RendererFoundation/Shader/Shader.h>
+#include <RendererFoundation/Shader/VertexDeclaration.h>
+#include <RendererFoundation/State/State.h>
+
+// The GAL objects of the null device don't own any API objects, they only carry the platform independent description.
+
+class wdGALBufferNull : public wdGALBuffer
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALBufferNull(const wdGALBufferCreationDescription& Description);
+  ~wdGALBufferNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice, wdArrayPtr<const wdUInt8> pInitialData) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class wdGALTextureNull : public wdGALTexture
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALTextureNull(const wdGALTextureCreationDescription& Description);
+  ~wdGALTextureNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice, wdArrayPtr<wdGALSystemMemoryDescription> pInitialData) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class wdGALResourceViewNull : public wdGALResourceView
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALResourceViewNull(wdGALResourceBase* pResource, const wdGALResourceViewCreationDescription& Description);
+  ~wdGALResourceViewNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALRenderTargetViewNull : public wdGALRenderTargetView
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALRenderTargetViewNull(wdGALTexture* pTexture, const wdGALRenderTargetViewCreationDescription& Description);
+  ~wdGALRenderTargetViewNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALUnorderedAccessViewNull : public wdGALUnorderedAccessView
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALUnorderedAccessViewNull(wdGALResourceBase* pResource, const wdGALUnorderedAccessViewCreationDescription& Description);
+  ~wdGALUnorderedAccessViewNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALQueryNull : public wdGALQuery
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALQueryNull(const wdGALQueryCreationDescription& Description);
+  ~wdGALQueryNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+  virtual void SetDebugNamePlatform(const char* szName) const override;
+};
+
+class wdGALShaderNull : public wdGALShader
+{
+public:
+  virtual void SetDebugName(const char* szName) const override;
+
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALShaderNull(const wdGALShaderCreationDescription& Description);
+  ~wdGALShaderNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALVertexDeclarationNull : public wdGALVertexDeclaration
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALVertexDeclarationNull(const wdGALVertexDeclarationCreationDescription& Description);
+  ~wdGALVertexDeclarationNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALBlendStateNull : public wdGALBlendState
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALBlendStateNull(const wdGALBlendStateCreationDescription& Description);
+  ~wdGALBlendStateNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALDepthStencilStateNull : public wdGALDepthStencilState
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALDepthStencilStateNull(const wdGALDepthStencilStateCreationDescription& Description);
+  ~wdGALDepthStencilStateNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALRasterizerStateNull : public wdGALRasterizerState
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALRasterizerStateNull(const wdGALRasterizerStateCreationDescription& Description);
+  ~wdGALRasterizerStateNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
+
+class wdGALSamplerStateNull : public wdGALSamplerState
+{
+protected:
+  friend class wdGALDeviceNull;
+  friend class wdMemoryUtils;
+
+  wdGALSamplerStateNull(const wdGALSamplerStateCreationDescription& Description);
+  ~wdGALSamplerStateNull();
+
+  virtual wdResult InitPlatform(wdGALDevice* pDevice) override;
+  virtual wdResult DeInitPlatform(wdGALDevice* pDevice) override;
+};
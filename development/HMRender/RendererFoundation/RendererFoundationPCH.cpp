@@ -15,6 +15,10 @@ WD_STATICLINK_LIBRARY(RendererFoundation)
   WD_STATICLINK_REFERENCE(RendererFoundation_Device_Implementation_DeviceFactory);
   WD_STATICLINK_REFERENCE(RendererFoundation_Device_Implementation_Pass);
   WD_STATICLINK_REFERENCE(RendererFoundation_Device_Implementation_SwapChain);
+  WD_STATICLINK_REFERENCE(RendererFoundation_Null_Implementation_CommandEncoderImplNull);
+  WD_STATICLINK_REFERENCE(RendererFoundation_Null_Implementation_DeviceNull);
+  WD_STATICLINK_REFERENCE(RendererFoundation_Null_Implementation_PassNull);
+  WD_STATICLINK_REFERENCE(RendererFoundation_Null_Implementation_ResourcesNull);
   WD_STATICLINK_REFERENCE(RendererFoundation_Profiling_Implementation_Profiling);
   WD_STATICLINK_REFERENCE(RendererFoundation_Resources_Implementation_Buffer);
   WD_STATICLINK_REFERENCE(RendererFoundation_Resources_Implementation_ProxyTexture);
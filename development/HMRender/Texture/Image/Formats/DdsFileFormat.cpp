@@ -258,6 +258,15 @@ static wdResult ReadImageData(wdStreamReader& inout_stream, wdImageHeader& ref_i
     ref_imageHeader.SetDepth(ref_ddsHeader.m_uiDepth);
   }
 
+  const bool bPitch = (ref_ddsHeader.m_uiFlags & wdDdsdFlags::PITCH) != 0;
+
+  // If pitch is specified, it must match the computed value
+  if (bPitch && ref_imageHeader.GetRowPitch(0) != ref_ddsHeader.m_uiPitchOrLinearSize)
+  {
+    wdLog::Error("The row pitch specified in the header doesn't match the expected pitch.");
+    return WD_FAILURE;
+  }
+
   return WD_SUCCESS;
 }
 
@@ -279,15 +288,6 @@ wdResult wdDdsFileFormat::ReadImage(wdStreamReader& inout_stream, wdImage& ref_i
 
   ref_image.ResetAndAlloc(imageHeader);
 
-  const bool bPitch = (ddsHeader.m_uiFlags & wdDdsdFlags::PITCH) != 0;
-
-  // If pitch is specified, it must match the computed value
-  if (bPitch && ref_image.GetRowPitch(0) != ddsHeader.m_uiPitchOrLinearSize)
-  {
-    wdLog::Error("The row pitch specified in the header doesn't match the expected pitch.");
-    return WD_FAILURE;
-  }
-
   wdUInt64 uiDataSize = ref_image.GetByteBlobPtr().GetCount();
 
   if (inout_stream.ReadBytes(ref_image.GetByteBlobPtr().GetPtr(), uiDataSize) != uiDataSize)
@@ -52,4 +52,66 @@ WD_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       WD_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "RadixSort")
+  {
+    struct Item
+    {
+      WD_DECLARE_POD_TYPE();
+
+      wdUInt64 m_uiPrimary;
+      wdUInt32 m_uiSecondary;
+      wdUInt32 m_uiOriginalIndex;
+    };
+
+    wdDynamicArray<Item> items;
+    for (wdUInt32 i = 0; i < a1.GetCount(); ++i)
+    {
+      // only a few different primary keys, so that stability matters, and some keys that need the upper bytes
+      const wdUInt64 uiHigh = (i % 3 == 0) ? (static_cast<wdUInt64>(a1[i] % 7) << 40) : 0;
+      items.PushBack({uiHigh | (a1[i] % 50), static_cast<wdUInt32>(rand() % 1000), i});
+    }
+
+    wdDynamicArray<Item> scratch;
+    scratch.SetCount(items.GetCount());
+
+    wdSorting::RadixSort(items.GetArrayPtr(), scratch.GetArrayPtr(), [](const Item& item) { return item.m_uiSecondary; });
+    wdSorting::RadixSort(items.GetArrayPtr(), scratch.GetArrayPtr(), [](const Item& item) { return item.m_uiPrimary; });
+
+    for (wdUInt32 i = 1; i < items.GetCount(); ++i)
+    {
+      const Item& prev = items[i - 1];
+      const Item& cur = items[i];
+
+      WD_TEST_BOOL(prev.m_uiPrimary <= cur.m_uiPrimary);
+
+      if (prev.m_uiPrimary == cur.m_uiPrimary)
+      {
+        WD_TEST_BOOL(prev.m_uiSecondary <= cur.m_uiSecondary);
+
+        if (prev.m_uiSecondary == cur.m_uiSecondary)
+        {
+          WD_TEST_BOOL(prev.m_uiOriginalIndex < cur.m_uiOriginalIndex);
+        }
+      }
+    }
+
+    // same result as a comparison sort
+    wdDynamicArray<wdInt32> a2 = a1;
+    wdDynamicArray<wdInt32> a3 = a1;
+    wdDynamicArray<wdInt32> intScratch;
+    intScratch.SetCount(a1.GetCount());
+
+    wdSorting::RadixSort(a2.GetArrayPtr(), intScratch.GetArrayPtr(), [](wdInt32 i) { return static_cast<wdUInt32>(i); });
+    wdSorting::QuickSort(a3, wdCompareHelper<wdInt32>());
+
+    WD_TEST_BOOL(a2 == a3);
+
+    // all keys identical, nothing to do
+    wdDynamicArray<wdInt32> a4;
+    a4.SetCount(100, 5);
+    wdSorting::RadixSort(a4.GetArrayPtr(), intScratch.GetArrayPtr(), [](wdInt32 i) { return static_cast<wdUInt8>(i); });
+    WD_TEST_INT(a4[0], 5);
+    WD_TEST_INT(a4[99], 5);
+  }
 }
@@ -6,6 +6,7 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/FileSystem/MappedFileContent.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
@@ -148,6 +149,25 @@ WD_CREATE_SIMPLE_TEST(IO, Archive)
       WD_TEST_FILES(sFileSrc, sFileDst, "Unpacked file should be identical");
     }
 
+    // uncompressed entries are accessed directly in the mapped archive, compressed ones are decompressed
+    for (wdUInt32 uiFileIdx : {1, 2})
+    {
+      sFileSrc.Set(":output/", szTestData, "/", szFileList[uiFileIdx]);
+      sFileDst.Set(":archive/", szFileList[uiFileIdx]);
+
+      wdMappedFileContent src;
+      wdMappedFileContent dst;
+      if (!WD_TEST_BOOL(src.Open(sFileSrc).Succeeded() && dst.Open(sFileDst).Succeeded()))
+        continue;
+
+      WD_TEST_BOOL(dst.IsMapped() == (uiFileIdx == 1));
+
+      if (WD_TEST_INT(dst.GetData().GetCount(), src.GetData().GetCount()))
+      {
+        WD_TEST_BOOL(wdMemoryUtils::IsEqual(dst.GetData().GetPtr(), src.GetData().GetPtr(), src.GetData().GetCount()));
+      }
+    }
+
     // mount a second time
     if (!WD_TEST_BOOL(wdFileSystem::AddDataDirectory(sArchiveFile, "Clear", "archive2", wdFileSystem::ReadOnly) == WD_SUCCESS))
       return;
@@ -0,0 +1,87 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/FileSystem/MappedFileContent.h>
+
+WD_CREATE_SIMPLE_TEST(IO, MappedFileContent)
+{
+  wdStringBuilder sOutputFolder = wdTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("IO", "MappedFileContent");
+  sOutputFolder.MakeCleanPath();
+
+  wdOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!WD_TEST_BOOL(wdFileSystem::AddDataDirectory(sOutputFolder, "MappedFileContent", "output", wdFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  const wdUInt32 uiSmallFileValues = 16;
+  const wdUInt32 uiLargeFileValues = static_cast<wdUInt32>(wdMappedFileContent::s_uiMinMappedFileSize / sizeof(wdUInt32)) * 4;
+
+  auto WriteFile = [](const char* szFile, wdUInt32 uiNumValues) {
+    wdFileWriter file;
+    if (file.Open(szFile).Failed())
+      return false;
+
+    for (wdUInt32 i = 0; i < uiNumValues; ++i)
+    {
+      file << i;
+    }
+
+    return true;
+  };
+
+  auto CheckContent = [](const wdMappedFileContent& content, wdUInt32 uiNumValues) {
+    if (!WD_TEST_INT(content.GetData().GetCount(), uiNumValues * sizeof(wdUInt32)))
+      return;
+
+    const wdUInt32* pValues = reinterpret_cast<const wdUInt32*>(content.GetData().GetPtr());
+    for (wdUInt32 i = 0; i < uiNumValues; ++i)
+    {
+      if (pValues[i] != i)
+      {
+        WD_TEST_FAILURE("Wrong file content", "Value {} is {}", i, pValues[i]);
+        return;
+      }
+    }
+  };
+
+  WD_TEST_BOOL(WriteFile(":output/Small.dat", uiSmallFileValues));
+  WD_TEST_BOOL(WriteFile(":output/Large.dat", uiLargeFileValues));
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Small File")
+  {
+    wdMappedFileContent content;
+    WD_TEST_BOOL(content.Open(":output/Small.dat").Succeeded());
+
+    // too small to be worth mapping
+    WD_TEST_BOOL(!content.IsMapped());
+    WD_TEST_BOOL(content.GetFilePathRelative() == "Small.dat");
+    CheckContent(content, uiSmallFileValues);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Large File")
+  {
+    wdMappedFileContent content;
+    WD_TEST_BOOL(content.Open(":output/Large.dat").Succeeded());
+
+#if WD_ENABLED(WD_SUPPORTS_MEMORY_MAPPED_FILE)
+    WD_TEST_BOOL(content.IsMapped());
+#endif
+
+    CheckContent(content, uiLargeFileValues);
+
+    content.Close();
+    WD_TEST_BOOL(content.GetData().IsEmpty());
+    WD_TEST_BOOL(!content.IsMapped());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Missing File")
+  {
+    wdMappedFileContent content;
+    WD_TEST_BOOL(content.Open(":output/DoesNotExist.dat").Failed());
+    WD_TEST_BOOL(content.GetData().IsEmpty());
+  }
+
+  wdFileSystem::RemoveDataDirectoryGroup("MappedFileContent");
+}
@@ -340,6 +340,31 @@ WD_CREATE_SIMPLE_TEST(IO, StreamOperation)
       WD_TEST_STRING(szRead0, szRead4);
       WD_TEST_STRING(szRead1, szRead5);
     }
+
+    // Read them again through a context that shares the string table
+    {
+      wdMemoryStreamReader StreamReader(&StreamStorageDeduplicated);
+
+      wdStringDeduplicationReadContext StringDeduplicationReadContext(StreamReader);
+      StringDeduplicationReadContext.SetActive(false);
+
+      wdMemoryStreamReader SharedStreamReader(&StreamStorageDeduplicated);
+      SharedStreamReader.SetReadPosition(StreamReader.GetReadPosition());
+
+      wdStringDeduplicationReadContext SharedReadContext(&StringDeduplicationReadContext);
+
+      wdStringBuilder szRead0, szRead1, szRead2, szRead3;
+
+      SharedStreamReader >> szRead0;
+      SharedStreamReader >> szRead1;
+      SharedStreamReader >> szRead2;
+      SharedStreamReader >> szRead3;
+
+      WD_TEST_STRING(szRead0, str1);
+      WD_TEST_STRING(szRead1, str2);
+      WD_TEST_STRING(szRead2, str1);
+      WD_TEST_STRING(szRead3, str3);
+    }
   }
 
   WD_TEST_BLOCK(wdTestBlock::Enabled, "Array Serialization Performance (bytes)")
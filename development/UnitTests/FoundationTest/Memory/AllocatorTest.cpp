@@ -3,6 +3,9 @@
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/StackAllocator.h>
+#include <Foundation/Memory/ThreadLocalStackAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
 
 struct alignas(WD_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -37,6 +40,39 @@ struct alignas(16) AlignedVector
   float w;
 };
 
+struct AtomicDestructionCounter
+{
+  ~AtomicDestructionCounter() { s_iDestructions.Increment(); }
+
+  wdUInt32 m_uiData = 0;
+
+  static wdAtomicInteger32 s_iDestructions;
+};
+
+wdAtomicInteger32 AtomicDestructionCounter::s_iDestructions;
+
+namespace
+{
+  class ThreadLocalStackAllocatorTestThread : public wdThread
+  {
+  public:
+    ThreadLocalStackAllocatorTestThread(wdThreadLocalStackAllocator* pAllocator)
+      : wdThread("ThreadLocalStackAllocatorTest")
+      , m_pAllocator(pAllocator)
+    {
+    }
+
+  private:
+    virtual wdUInt32 Run() override
+    {
+      m_pAllocator->Allocate(64, 16, nullptr);
+      return 0;
+    }
+
+    wdThreadLocalStackAllocator* m_pAllocator;
+  };
+} // namespace
+
 template <typename T>
 void TestAlignmentHelper(size_t uiExpectedAlignment)
 {
@@ -90,6 +126,28 @@ WD_CREATE_SIMPLE_TEST(Memory, Allocator)
     TestAlignmentHelper<AlignedVector>(16);
   }
 
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "ProxyAllocator")
+  {
+    // the proxy and its parent both track the same addresses
+    wdProxyAllocator allocator("TestProxyAllocator", wdFoundation::GetDefaultAllocator());
+
+    wdDynamicArray<wdUInt64> values(&allocator);
+    for (wdUInt64 i = 0; i < 1000; ++i)
+    {
+      values.PushBack(i);
+    }
+
+    WD_TEST_INT(values[999], 999);
+
+    values.Clear();
+    values.Compact();
+
+    wdAllocatorBase::Stats stats = allocator.GetStats();
+    WD_TEST_BOOL(stats.m_uiNumAllocations > 1);
+    WD_TEST_BOOL(stats.m_uiNumAllocations == stats.m_uiNumDeallocations);
+    WD_TEST_INT(stats.m_uiAllocationSize, 0);
+  }
+
   WD_TEST_BLOCK(wdTestBlock::Enabled, "LargeBlockAllocator")
   {
     enum
@@ -240,4 +298,119 @@ WD_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     WD_TEST_BOOL(wdConstructionCounter::HasDestructed(50));
   }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "ThreadLocalStackAllocator")
+  {
+    wdThreadLocalStackAllocator allocator("TestThreadLocalStackAllocator", wdFoundation::GetAlignedAllocator());
+
+    size_t sizes[] = {128, 128, 4096, 1024, 1024, 16000, 512, 512, 768, 768, 16000, 16000, 16000, 16000};
+    void* allocs[WD_ARRAY_SIZE(sizes)];
+    for (size_t i = 0; i < WD_ARRAY_SIZE(sizes); i++)
+    {
+      allocs[i] = allocator.Allocate(sizes[i], 16, nullptr);
+      WD_TEST_BOOL(allocs[i] != nullptr);
+      WD_TEST_BOOL(wdMemoryUtils::IsAligned(allocs[i], 16));
+    }
+
+    allocator.Reset();
+
+    // the memory is reused after a reset
+    void* pFirst = allocator.Allocate(8, sizeof(void*), nullptr);
+    WD_TEST_BOOL(pFirst == allocs[0]);
+
+    wdDynamicArray<wdThreadLocalStackAllocator::ThreadStats> stats;
+    allocator.GetThreadStats(stats);
+    if (WD_TEST_INT(stats.GetCount(), 1))
+    {
+      WD_TEST_INT(stats[0].m_uiNumAllocations, 1);
+      WD_TEST_INT(stats[0].m_uiUsedMemory, wdThreadLocalStackAllocator::HeaderSize + 16);
+      WD_TEST_BOOL(stats[0].m_uiPeakUsedMemory >= 16000 * 5);
+    }
+
+    allocator.Reset();
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "ThreadLocalStackAllocator AllocatedSize and Alignment")
+  {
+    wdThreadLocalStackAllocator allocator("TestThreadLocalStackAllocator", wdFoundation::GetAlignedAllocator());
+
+    for (size_t uiAlign = 1; uiAlign <= 256; uiAlign *= 2)
+    {
+      void* pPtr = allocator.Allocate(20, uiAlign, nullptr);
+      WD_TEST_BOOL(wdMemoryUtils::IsAligned(pPtr, uiAlign));
+      WD_TEST_BOOL(allocator.AllocatedSize(pPtr) >= 20);
+
+      // larger than the current chunk
+      pPtr = allocator.Allocate(10000, uiAlign, nullptr);
+      WD_TEST_BOOL(wdMemoryUtils::IsAligned(pPtr, uiAlign));
+      WD_TEST_BOOL(allocator.AllocatedSize(pPtr) >= 10000);
+    }
+
+    WD_TEST_INT(allocator.AllocatedSize(nullptr), 0);
+
+    allocator.Reset();
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "ThreadLocalStackAllocator with many threads")
+  {
+    wdThreadLocalStackAllocator allocator("TestThreadLocalStackAllocator", wdFoundation::GetAlignedAllocator());
+
+    // far more threads than arenas over time, but only one at a time, so every thread gets the arena of a thread that has exited
+    for (wdUInt32 i = 0; i < wdThreadLocalStackAllocator::MaxThreadArenas * 2; ++i)
+    {
+      ThreadLocalStackAllocatorTestThread thread(&allocator);
+      thread.Start();
+      thread.Join();
+    }
+
+    wdDynamicArray<wdThreadLocalStackAllocator::ThreadStats> stats;
+    allocator.GetThreadStats(stats);
+
+    wdUInt64 uiNumAllocations = 0;
+    for (const auto& threadStats : stats)
+    {
+      WD_TEST_BOOL(threadStats.m_uiArenaIndex < wdThreadLocalStackAllocator::MaxThreadArenas);
+      uiNumAllocations += threadStats.m_uiNumAllocations;
+    }
+
+    WD_TEST_BOOL(stats.GetCount() < wdThreadLocalStackAllocator::MaxThreadArenas);
+    WD_TEST_INT(uiNumAllocations, wdThreadLocalStackAllocator::MaxThreadArenas * 2);
+
+    allocator.Reset();
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "ThreadLocalStackAllocator on multiple threads")
+  {
+    wdThreadLocalStackAllocator allocator("TestThreadLocalStackAllocator", wdFoundation::GetAlignedAllocator());
+
+    wdDynamicArray<AtomicDestructionCounter*> objects;
+    objects.SetCount(1000);
+
+    AtomicDestructionCounter::s_iDestructions = 0;
+
+    wdParallelForParams params;
+    params.m_uiBinSize = 10;
+
+    wdTaskSystem::ParallelForIndexed(
+      0u, objects.GetCount(), [&](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex)
+      {
+        for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          objects[i] = WD_NEW(&allocator, AtomicDestructionCounter);
+        }
+      },
+      "ThreadLocalStackAllocatorTest", params);
+
+    // deallocating memory that was allocated on another thread must prevent the destructor from running again
+    for (wdUInt32 i = 0; i < 500; ++i)
+    {
+      WD_DELETE(&allocator, objects[i * 2]);
+    }
+
+    WD_TEST_INT(AtomicDestructionCounter::s_iDestructions, 500);
+
+    allocator.Reset();
+
+    WD_TEST_INT(AtomicDestructionCounter::s_iDestructions, 1000);
+  }
 }
@@ -0,0 +1,124 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define WD_ARCHIVEBUILDER_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+WD_CREATE_SIMPLE_TEST(Performance, ArchiveBuilder)
+{
+  const wdUInt32 uiMaxWorkers = wdMath::Max<wdUInt32>(wdSystemInformation::Get().GetCPUCoreCount(), 1);
+
+  WD_TEST_BLOCK(WD_ARCHIVEBUILDER_PERFORMANCE_TESTS_STATE, "Compression Throughput")
+  {
+    wdStringBuilder sOutputFolder = wdTestFramework::GetInstance()->GetAbsOutputPath();
+    sOutputFolder.AppendPath("ArchiveBuilderPerf");
+    sOutputFolder.MakeCleanPath();
+
+    wdOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+    wdOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+    if (!WD_TEST_BOOL(wdFileSystem::AddDataDirectory(sOutputFolder, "ArchiveBuilderPerf", "perf").Succeeded()))
+      return;
+
+    const wdUInt32 uiNumFiles = 64;
+    const wdUInt32 uiFileSize = 1024 * 1024 * 2;
+
+    wdArchiveBuilder builder;
+    wdUInt64 uiTotalBytes = 0;
+
+    // semi-compressible data: runs of repeated random bytes
+    {
+      wdRandom rng;
+      rng.Initialize(42);
+
+      wdDynamicArray<wdUInt8> data;
+      data.SetCountUninitialized(uiFileSize);
+
+      wdStringBuilder sFile;
+
+      for (wdUInt32 uiFile = 0; uiFile < uiNumFiles; ++uiFile)
+      {
+        for (wdUInt32 i = 0; i < uiFileSize;)
+        {
+          const wdUInt8 uiValue = static_cast<wdUInt8>(rng.UInt());
+          const wdUInt32 uiRun = wdMath::Min(1 + rng.UIntInRange(8), uiFileSize - i);
+
+          for (wdUInt32 r = 0; r < uiRun; ++r)
+          {
+            data[i++] = uiValue;
+          }
+        }
+
+        sFile.Format("{}/File{}.bin", sOutputFolder, uiFile);
+
+        wdOSFile file;
+        if (!WD_TEST_BOOL(file.Open(sFile, wdFileOpenMode::Write).Succeeded()))
+          return;
+
+        WD_TEST_BOOL(file.Write(data.GetData(), data.GetCount()).Succeeded());
+        file.Close();
+
+        auto& entry = builder.m_Entries.ExpandAndGetRef();
+        entry.m_sAbsSourcePath = sFile;
+        entry.m_sRelTargetPath = sFile.GetFileNameAndExtension();
+        entry.m_CompressionMode = wdArchiveCompressionMode::Compressed_zstd;
+
+        uiTotalBytes += uiFileSize;
+      }
+    }
+
+    wdDynamicArray<wdUInt8> reference;
+
+    const wdUInt32 uiPrevShortWorkers = wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::ShortTasks);
+    const wdUInt32 uiPrevLongWorkers = wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::LongTasks);
+
+    for (wdUInt32 uiWorkers = 1; uiWorkers <= uiMaxWorkers; uiWorkers *= 2)
+    {
+      wdTaskSystem::SetWorkerThreadCount(-1, uiWorkers);
+
+      wdDynamicArray<wdUInt8> archive;
+      archive.Reserve((wdUInt32)uiTotalBytes);
+
+      wdMemoryStreamContainerWrapperStorage<wdDynamicArray<wdUInt8>> storage(&archive);
+      wdMemoryStreamWriter writer(&storage);
+
+      const wdTime tStart = wdTime::Now();
+
+      WD_TEST_BOOL(builder.WriteArchive(writer).Succeeded());
+
+      const wdTime tDiff = wdTime::Now() - tStart;
+
+      wdLog::Info("[test]ArchiveBuilder Compression ({0} long running workers): {1} MB/s", uiWorkers,
+        wdArgF(uiTotalBytes / (1024.0 * 1024.0) / tDiff.GetSeconds(), 1));
+
+      if (reference.IsEmpty())
+      {
+        reference = archive;
+      }
+      else
+      {
+        // the archive must not depend on how many entries were compressed at the same time
+        WD_TEST_BOOL(archive == reference);
+      }
+    }
+
+    wdFileSystem::RemoveDataDirectoryGroup("ArchiveBuilderPerf");
+    wdOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+
+    // restore the previous configuration
+    wdTaskSystem::SetWorkerThreadCount(uiPrevShortWorkers, uiPrevLongWorkers);
+  }
+}
+
+#endif
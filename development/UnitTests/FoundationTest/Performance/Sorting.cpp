@@ -0,0 +1,191 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define WD_SORTING_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+namespace
+{
+  constexpr wdUInt32 s_uiNumCategories = 8;
+  constexpr wdUInt32 s_uiNumItemsPerCategory = 1024 * 48;
+  constexpr wdUInt32 s_uiNumIterations = 20;
+
+  // Mimics what wdExtractedRenderData sorts: a pointer to the render data, which holds the batch id, and a 64 bit sorting key.
+  struct Payload
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdUInt32 m_uiBatchId;
+  };
+
+  struct SortableItem
+  {
+    WD_DECLARE_POD_TYPE();
+
+    const Payload* m_pPayload;
+    wdUInt64 m_uiSortingKey;
+  };
+
+  struct ItemComparer
+  {
+    WD_FORCE_INLINE bool Less(const SortableItem& a, const SortableItem& b) const
+    {
+      if (a.m_uiSortingKey == b.m_uiSortingKey)
+      {
+        return a.m_pPayload->m_uiBatchId < b.m_pPayload->m_uiBatchId;
+      }
+
+      return a.m_uiSortingKey < b.m_uiSortingKey;
+    }
+  };
+
+  void RadixSortItems(wdDynamicArray<SortableItem>& ref_items, wdDynamicArray<SortableItem>& ref_scratch)
+  {
+    ref_scratch.SetCountUninitialized(ref_items.GetCount());
+
+    wdSorting::RadixSort(ref_items.GetArrayPtr(), ref_scratch.GetArrayPtr(), [](const SortableItem& item) { return item.m_pPayload->m_uiBatchId; });
+    wdSorting::RadixSort(ref_items.GetArrayPtr(), ref_scratch.GetArrayPtr(), [](const SortableItem& item) { return item.m_uiSortingKey; });
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(Performance, Sorting)
+{
+  wdRandom rng;
+  rng.Initialize(42);
+
+  wdDynamicArray<Payload> payloads;
+  payloads.SetCountUninitialized(s_uiNumCategories * s_uiNumItemsPerCategory);
+
+  wdDynamicArray<SortableItem> input[s_uiNumCategories];
+
+  for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+  {
+    for (wdUInt32 i = 0; i < s_uiNumItemsPerCategory; ++i)
+    {
+      Payload& payload = payloads[uiCategory * s_uiNumItemsPerCategory + i];
+      payload.m_uiBatchId = rng.UIntInRange(512);
+
+      // like a typical sorting key: a few bits of state in the upper half, the quantized distance in the lower half
+      auto& item = input[uiCategory].ExpandAndGetRef();
+      item.m_pPayload = &payload;
+      item.m_uiSortingKey = (static_cast<wdUInt64>(rng.UIntInRange(64)) << 32) | rng.UIntInRange(1 << 16);
+    }
+  }
+
+  wdDynamicArray<SortableItem> reference[s_uiNumCategories];
+  wdDynamicArray<SortableItem> sorted[s_uiNumCategories];
+  wdDynamicArray<SortableItem> scratch[s_uiNumCategories];
+
+  WD_TEST_BLOCK(WD_SORTING_PERFORMANCE_TESTS_STATE, "QuickSort")
+  {
+    wdTime tTotal;
+
+    for (wdUInt32 uiIteration = 0; uiIteration < s_uiNumIterations; ++uiIteration)
+    {
+      for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+      {
+        sorted[uiCategory] = input[uiCategory];
+      }
+
+      const wdTime tStart = wdTime::Now();
+
+      for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+      {
+        sorted[uiCategory].Sort(ItemComparer());
+      }
+
+      tTotal += wdTime::Now() - tStart;
+    }
+
+    for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+    {
+      reference[uiCategory] = sorted[uiCategory];
+    }
+
+    wdLog::Info("[test]QuickSort {0} x {1} items: {2}ms", s_uiNumCategories, s_uiNumItemsPerCategory,
+      wdArgF(tTotal.GetMilliseconds() / s_uiNumIterations, 3));
+  }
+
+  WD_TEST_BLOCK(WD_SORTING_PERFORMANCE_TESTS_STATE, "RadixSort")
+  {
+    wdTime tTotal;
+
+    for (wdUInt32 uiIteration = 0; uiIteration < s_uiNumIterations; ++uiIteration)
+    {
+      for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+      {
+        sorted[uiCategory] = input[uiCategory];
+      }
+
+      const wdTime tStart = wdTime::Now();
+
+      for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+      {
+        RadixSortItems(sorted[uiCategory], scratch[uiCategory]);
+      }
+
+      tTotal += wdTime::Now() - tStart;
+    }
+
+    wdLog::Info("[test]RadixSort {0} x {1} items: {2}ms", s_uiNumCategories, s_uiNumItemsPerCategory,
+      wdArgF(tTotal.GetMilliseconds() / s_uiNumIterations, 3));
+
+    // items may only differ in their payload pointer if both keys are equal, so compare the keys
+    bool bSameOrder = true;
+    for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+    {
+      for (wdUInt32 i = 0; i < sorted[uiCategory].GetCount(); ++i)
+      {
+        bSameOrder &= sorted[uiCategory][i].m_uiSortingKey == reference[uiCategory][i].m_uiSortingKey;
+        bSameOrder &= sorted[uiCategory][i].m_pPayload->m_uiBatchId == reference[uiCategory][i].m_pPayload->m_uiBatchId;
+      }
+    }
+
+    WD_TEST_BOOL(bSameOrder);
+  }
+
+  WD_TEST_BLOCK(WD_SORTING_PERFORMANCE_TESTS_STATE, "RadixSort - Parallel Categories")
+  {
+    wdTime tTotal;
+
+    for (wdUInt32 uiIteration = 0; uiIteration < s_uiNumIterations; ++uiIteration)
+    {
+      for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+      {
+        sorted[uiCategory] = input[uiCategory];
+      }
+
+      const wdTime tStart = wdTime::Now();
+
+      wdTaskSystem::ParallelForIndexed(0u, s_uiNumCategories, [&](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+        for (wdUInt32 uiCategory = uiStartIndex; uiCategory < uiEndIndex; ++uiCategory)
+        {
+          RadixSortItems(sorted[uiCategory], scratch[uiCategory]);
+        }
+      });
+
+      tTotal += wdTime::Now() - tStart;
+    }
+
+    wdLog::Info("[test]RadixSort (parallel categories) {0} x {1} items: {2}ms", s_uiNumCategories, s_uiNumItemsPerCategory,
+      wdArgF(tTotal.GetMilliseconds() / s_uiNumIterations, 3));
+
+    bool bSameOrder = true;
+    for (wdUInt32 uiCategory = 0; uiCategory < s_uiNumCategories; ++uiCategory)
+    {
+      for (wdUInt32 i = 0; i < sorted[uiCategory].GetCount(); ++i)
+      {
+        bSameOrder &= sorted[uiCategory][i].m_uiSortingKey == reference[uiCategory][i].m_uiSortingKey;
+        bSameOrder &= sorted[uiCategory][i].m_pPayload->m_uiBatchId == reference[uiCategory][i].m_pPayload->m_uiBatchId;
+      }
+    }
+
+    WD_TEST_BOOL(bSameOrder);
+  }
+}
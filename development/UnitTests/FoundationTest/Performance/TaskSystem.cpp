@@ -0,0 +1,133 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Logging/Log.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define WD_TASKSYSTEM_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+namespace
+{
+  class wdEmptyPerfTask final : public wdTask
+  {
+  public:
+    wdEmptyPerfTask() { ConfigureTask("EmptyPerfTask", wdTaskNesting::Never); }
+
+  private:
+    virtual void Execute() override {}
+  };
+
+  /// Fans out many tiny tasks from within a task, which is the typical pattern of ParallelFor inside world updates.
+  class wdFanOutPerfTask final : public wdTask
+  {
+  public:
+    wdFanOutPerfTask(wdUInt32 uiNumSubTasks, wdAtomicInteger32* pCounter)
+      : m_uiNumSubTasks(uiNumSubTasks)
+      , m_pCounter(pCounter)
+    {
+      ConfigureTask("FanOutPerfTask", wdTaskNesting::Maybe);
+    }
+
+  private:
+    virtual void Execute() override
+    {
+      wdParallelForParams params;
+      params.m_uiBinSize = 1;
+      params.m_uiMaxTasksPerThread = m_uiNumSubTasks;
+
+      wdAtomicInteger32* pCounter = m_pCounter;
+      wdTaskSystem::ParallelForIndexed(
+        0, m_uiNumSubTasks, [pCounter](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex)
+        { pCounter->Add(uiEndIndex - uiStartIndex); },
+        "FanOutPerfTask.SubTask", params);
+    }
+
+    wdUInt32 m_uiNumSubTasks;
+    wdAtomicInteger32* m_pCounter;
+  };
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(Performance, TaskSystem)
+{
+  const wdUInt32 uiMaxWorkers = wdMath::Max<wdUInt32>(wdSystemInformation::Get().GetCPUCoreCount(), 1);
+
+  // the test changes the number of worker threads, other tests must not be affected by that
+  const wdUInt32 uiPrevShortWorkers = wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::ShortTasks);
+  const wdUInt32 uiPrevLongWorkers = wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::LongTasks);
+
+  WD_TEST_BLOCK(WD_TASKSYSTEM_PERFORMANCE_TESTS_STATE, "Throughput")
+  {
+    const wdUInt32 uiNumOuterTasks = 64;
+    const wdUInt32 uiNumSubTasks = 256;
+    const wdUInt32 uiNumRounds = 20;
+
+    for (wdUInt32 uiWorkers = 1; uiWorkers <= uiMaxWorkers; uiWorkers *= 2)
+    {
+      wdTaskSystem::SetWorkerThreadCount(uiWorkers, 1);
+
+      wdAtomicInteger32 iCounter = 0;
+      wdDynamicArray<wdSharedPtr<wdTask>> tasks;
+      for (wdUInt32 i = 0; i < uiNumOuterTasks; ++i)
+      {
+        tasks.PushBack(WD_DEFAULT_NEW(wdFanOutPerfTask, uiNumSubTasks, &iCounter));
+      }
+
+      const wdTime tStart = wdTime::Now();
+
+      for (wdUInt32 round = 0; round < uiNumRounds; ++round)
+      {
+        wdTaskGroupID group = wdTaskSystem::CreateTaskGroup(wdTaskPriority::EarlyThisFrame);
+
+        for (const auto& pTask : tasks)
+        {
+          wdTaskSystem::AddTaskToGroup(group, pTask);
+        }
+
+        wdTaskSystem::StartTaskGroup(group);
+        wdTaskSystem::WaitForGroup(group);
+      }
+
+      const wdTime tDiff = wdTime::Now() - tStart;
+      const double fNumTasks = (double)uiNumRounds * uiNumOuterTasks * (uiNumSubTasks + 1);
+
+      WD_TEST_INT(iCounter, uiNumRounds * uiNumOuterTasks * uiNumSubTasks);
+
+      wdLog::Info("[test]TaskSystem Throughput ({0} workers): {1} tasks/s", uiWorkers, wdArgF(fNumTasks / tDiff.GetSeconds(), 0));
+    }
+  }
+
+  WD_TEST_BLOCK(WD_TASKSYSTEM_PERFORMANCE_TESTS_STATE, "Scheduling Latency")
+  {
+    const wdUInt32 uiNumSamples = 2000;
+
+    for (wdUInt32 uiWorkers = 1; uiWorkers <= uiMaxWorkers; uiWorkers *= 2)
+    {
+      wdTaskSystem::SetWorkerThreadCount(uiWorkers, 1);
+
+      wdSharedPtr<wdTask> pTask = WD_DEFAULT_NEW(wdEmptyPerfTask);
+
+      wdTime tTotal;
+      wdTime tMax;
+
+      for (wdUInt32 i = 0; i < uiNumSamples; ++i)
+      {
+        const wdTime tStart = wdTime::Now();
+
+        wdTaskGroupID group = wdTaskSystem::StartSingleTask(pTask, wdTaskPriority::EarlyThisFrame);
+        wdTaskSystem::WaitForGroup(group);
+
+        const wdTime tDiff = wdTime::Now() - tStart;
+        tTotal += tDiff;
+        tMax = wdMath::Max(tMax, tDiff);
+      }
+
+      wdLog::Info("[test]TaskSystem Scheduling Latency ({0} workers): avg {1}us, max {2}us", uiWorkers,
+        wdArgF(tTotal.GetMicroseconds() / uiNumSamples, 2), wdArgF(tMax.GetMicroseconds(), 2));
+    }
+  }
+
+  // restore the previous configuration
+  wdTaskSystem::SetWorkerThreadCount(uiPrevShortWorkers, uiPrevLongWorkers);
+}
@@ -2,8 +2,11 @@
 
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
 
 namespace
 {
@@ -52,4 +55,132 @@ WD_CREATE_SIMPLE_TEST(Profiling, Profiling)
 
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
+
+#if WD_ENABLED(WD_USE_PROFILING)
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Trace Stream")
+  {
+    const wdTime discardThreshold = wdTime::Milliseconds(0.1);
+    wdProfilingSystem::SetDiscardThreshold(wdTime::Zero());
+
+    wdDefaultMemoryStreamStorage storage;
+    wdMemoryStreamWriter writer(&storage);
+
+    WD_TEST_BOOL(wdProfilingSystem::StartTraceStream(&writer, 1024 * 1024, wdTime::Milliseconds(1)).Succeeded());
+    WD_TEST_BOOL(wdProfilingSystem::IsTraceStreamActive());
+
+    // only one stream at a time
+    WD_TEST_BOOL(wdProfilingSystem::StartTraceStream(&writer).Failed());
+
+    const wdUInt32 uiNumIterations = 1000;
+    for (wdUInt32 i = 0; i < uiNumIterations; ++i)
+    {
+      WD_PROFILE_SCOPE("Streamed scope");
+      WD_PROFILE_COUNTER("Streamed counter", i);
+    }
+
+    wdTaskSystem::ParallelForIndexed(
+      0u, 64u, [](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+        for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          WD_PROFILE_SCOPE("Streamed task scope");
+        }
+      },
+      "Streamed tasks");
+
+    wdProfilingSystem::StopTraceStream();
+    WD_TEST_BOOL(!wdProfilingSystem::IsTraceStreamActive());
+
+    // not recorded anymore
+    {
+      WD_PROFILE_SCOPE("Streamed scope");
+      WD_PROFILE_COUNTER("Streamed counter", 0);
+    }
+
+    wdProfilingSystem::SetDiscardThreshold(discardThreshold);
+
+    wdMemoryStreamReader reader(&storage);
+    wdProfilingSystem::ProfilingData profilingData;
+    WD_TEST_BOOL(profilingData.ReadTraceStream(reader).Succeeded());
+
+    wdUInt32 uiNumScopes = 0;
+    wdUInt32 uiNumTaskScopes = 0;
+    for (const auto& eventBuffer : profilingData.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        if (wdStringUtils::IsEqual(scope.m_szName, "Streamed scope"))
+        {
+          ++uiNumScopes;
+          WD_TEST_BOOL(scope.m_EndTime >= scope.m_BeginTime);
+          WD_TEST_BOOL(scope.m_szFunctionName != nullptr);
+        }
+        else if (wdStringUtils::IsEqual(scope.m_szName, "Streamed task scope"))
+        {
+          ++uiNumTaskScopes;
+        }
+      }
+    }
+
+    WD_TEST_INT(uiNumScopes, uiNumIterations);
+    WD_TEST_INT(uiNumTaskScopes, 64);
+
+    WD_TEST_INT(profilingData.m_CounterSamples.GetCount(), uiNumIterations);
+    for (wdUInt32 i = 0; i < profilingData.m_CounterSamples.GetCount(); ++i)
+    {
+      WD_TEST_STRING(profilingData.m_CounterSamples[i].m_sName, "Streamed counter");
+      WD_TEST_DOUBLE(profilingData.m_CounterSamples[i].m_fValue, (double)i, 0.0);
+    }
+
+    // the task group that ParallelForIndexed started is linked to its tasks, every flow is terminated
+    wdHashTable<wdUInt64, wdUInt32> flowBegins;
+    wdHashTable<wdUInt64, wdUInt32> flowEnds;
+    for (const auto& flow : profilingData.m_FlowEvents)
+    {
+      if (flow.m_Type == wdProfilingSystem::FlowEventType::Begin)
+        ++flowBegins[flow.m_uiFlowId];
+      else if (flow.m_Type == wdProfilingSystem::FlowEventType::End)
+        ++flowEnds[flow.m_uiFlowId];
+    }
+
+    WD_TEST_BOOL(!flowBegins.IsEmpty());
+    WD_TEST_INT(flowEnds.GetCount(), flowBegins.GetCount());
+    for (auto it = flowBegins.GetIterator(); it.IsValid(); ++it)
+    {
+      wdUInt32 uiNumEnds = 0;
+      flowEnds.TryGetValue(it.Key(), uiNumEnds);
+
+      WD_TEST_INT(it.Value(), 1);
+      WD_TEST_INT(uiNumEnds, 1);
+    }
+
+    wdDefaultMemoryStreamStorage jsonStorage;
+    wdMemoryStreamWriter jsonWriter(&jsonStorage);
+    WD_TEST_BOOL(profilingData.Write(jsonWriter).Succeeded());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Corrupt Trace Stream")
+  {
+    wdDefaultMemoryStreamStorage storage;
+    wdMemoryStreamWriter writer(&storage);
+
+    WD_TEST_BOOL(wdProfilingSystem::StartTraceStream(&writer, 1024 * 1024, wdTime::Milliseconds(1)).Succeeded());
+    wdProfilingSystem::StopTraceStream();
+
+    // replace the end block with a string block that would need a huge string table
+    writer.SetWritePosition(storage.GetStorageSize32() - 1);
+    writer << static_cast<wdUInt8>(1);
+    writer << static_cast<wdUInt32>(1);
+    writer << static_cast<wdUInt32>(0xFFFFFFF0);
+    writer.WriteString("Corrupt").IgnoreResult();
+
+    wdTestLogInterface log;
+    wdTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("Invalid string ID 4294967280 in profiling trace.", wdLogMsgType::ErrorMsg);
+
+    wdMemoryStreamReader reader(&storage);
+    wdProfilingSystem::ProfilingData profilingData;
+    WD_TEST_BOOL(profilingData.ReadTraceStream(reader).Failed());
+    WD_TEST_BOOL(profilingData.m_TraceStrings.GetCount() < 16);
+  }
+#endif
 }
@@ -97,6 +97,11 @@ WD_CREATE_SIMPLE_TEST(SimdMath, SimdVec4b)
     WD_TEST_BOOL(a.AllSet<1>());
     WD_TEST_BOOL(b.NoneSet<1>());
 
+    WD_TEST_INT(a.GetMask(), 0b0101);
+    WD_TEST_INT(b.GetMask(), 0b0110);
+    WD_TEST_INT(wdSimdVec4b(true).GetMask(), 0b1111);
+    WD_TEST_INT(wdSimdVec4b(false).GetMask(), 0);
+
     wdSimdVec4b cmp(false, true, false, true);
     c = wdSimdVec4b::Select(cmp, a, b);
     WD_TEST_BOOL(!c.x() && !c.y() && c.z() && !c.w());
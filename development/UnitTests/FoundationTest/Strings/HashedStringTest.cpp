@@ -1,6 +1,7 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Strings/HashedString.h>
+#include <Foundation/Threading/TaskSystem.h>
 
 WD_CREATE_SIMPLE_TEST(Strings, HashedString)
 {
@@ -185,6 +186,85 @@ WD_CREATE_SIMPLE_TEST(Strings, HashedString)
     WD_TEST_STRING(s3.GetString().GetData(), "tut");
   }
 
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "PreInternStrings")
+  {
+    wdDynamicArray<wdString> strings;
+    for (wdUInt32 i = 0; i < 2000; ++i)
+    {
+      wdStringBuilder sb;
+      sb.Format("PreInterned_{}", i % 1500); // some duplicates
+      strings.PushBack(sb);
+    }
+
+    wdDynamicArray<wdStringView> views;
+    for (const wdString& s : strings)
+    {
+      views.PushBack(s);
+    }
+
+    wdDynamicArray<wdHashedString> hashed;
+    hashed.SetCount(views.GetCount());
+
+    wdHashedString::PreInternStrings(views, hashed);
+
+    for (wdUInt32 i = 0; i < views.GetCount(); ++i)
+    {
+      WD_TEST_BOOL(hashed[i].GetView() == views[i]);
+      WD_TEST_INT(hashed[i].GetHash(), wdHashingUtils::StringHash(views[i]));
+
+      wdHashedString s;
+      s.Assign(views[i]);
+      WD_TEST_BOOL(s == hashed[i]);
+    }
+
+    WD_TEST_BOOL(hashed[0] == hashed[1500]);
+
+    // interning without output and again the same strings
+    wdHashedString::PreInternStrings(views);
+    wdHashedString::PreInternStrings(views, hashed);
+    WD_TEST_BOOL(hashed[1].GetView() == "PreInterned_1");
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Multithreaded")
+  {
+    constexpr wdUInt32 uiNumHashedStrings = 4000;
+
+    wdDynamicArray<wdString> strings;
+    for (wdUInt32 i = 0; i < uiNumHashedStrings; ++i)
+    {
+      wdStringBuilder sb;
+      sb.Format("Threaded_{}", i);
+      strings.PushBack(sb);
+    }
+
+    wdDynamicArray<wdHashedString> first;
+    first.SetCount(uiNumHashedStrings);
+
+    wdDynamicArray<wdHashedString> second;
+    second.SetCount(uiNumHashedStrings);
+
+    wdParallelForParams params;
+    params.m_uiBinSize = 64;
+
+    // both passes race to add the same new strings, they must end up with the same entries
+    wdTaskSystem::ParallelForIndexed(
+      0u, uiNumHashedStrings * 2, [&](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+        for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          const wdUInt32 uiString = (i & 1) ? uiNumHashedStrings - 1 - i / 2 : i / 2;
+          auto& target = (i & 1) ? second : first;
+          target[uiString].Assign(strings[uiString]);
+        }
+      },
+      "HashedStringTest", params);
+
+    for (wdUInt32 i = 0; i < uiNumHashedStrings; ++i)
+    {
+      WD_TEST_BOOL(first[i] == second[i]);
+      WD_TEST_BOOL(first[i].GetString() == strings[i]);
+    }
+  }
+
 #if WD_ENABLED(WD_HASHED_STRING_REF_COUNTING)
   WD_TEST_BLOCK(wdTestBlock::Enabled, "ClearUnusedStrings")
   {
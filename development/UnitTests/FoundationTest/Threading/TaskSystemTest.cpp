@@ -66,6 +66,42 @@ private:
   }
 };
 
+class wdBuriedTaskTestTask final : public wdTask
+{
+public:
+  wdBuriedTaskTestTask() { ConfigureTask("Buried Task Test", wdTaskNesting::Maybe); }
+
+  wdSharedPtr<wdTestTask> m_pBuriedTask;
+  wdSharedPtr<wdTestTask> m_OtherTasks[32];
+  wdTaskGroupID m_OtherGroups[32];
+  bool m_bBuriedTaskDone = false;
+
+private:
+  virtual void Execute() override
+  {
+    // this runs on a worker thread, so all tasks scheduled here go into its local queue, the buried task at the very bottom
+    m_pBuriedTask = WD_DEFAULT_NEW(wdTestTask);
+    m_pBuriedTask->ConfigureTask("Buried Task", wdTaskNesting::Maybe);
+    m_pBuriedTask->m_uiIterations = 1;
+
+    wdTaskGroupID buriedGroup = wdTaskSystem::StartSingleTask(m_pBuriedTask, wdTaskPriority::ThisFrame);
+
+    for (wdUInt32 i = 0; i < WD_ARRAY_SIZE(m_OtherTasks); ++i)
+    {
+      m_OtherTasks[i] = WD_DEFAULT_NEW(wdTestTask);
+      m_OtherTasks[i]->ConfigureTask("Other Task", wdTaskNesting::Maybe);
+      m_OtherTasks[i]->m_uiIterations = 1;
+
+      m_OtherGroups[i] = wdTaskSystem::StartSingleTask(m_OtherTasks[i], wdTaskPriority::ThisFrame);
+    }
+
+    // while waiting, this thread may only execute the buried task, all others may wait themselves
+    wdTaskSystem::WaitForGroup(buriedGroup);
+
+    m_bBuriedTaskDone = m_pBuriedTask->IsDone();
+  }
+};
+
 class TaskCallbacks
 {
 public:
@@ -550,6 +586,21 @@ WD_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     WD_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Waiting for Buried Local Tasks")
+  {
+    wdSharedPtr<wdBuriedTaskTestTask> pTask = WD_DEFAULT_NEW(wdBuriedTaskTestTask);
+
+    wdTaskSystem::WaitForGroup(wdTaskSystem::StartSingleTask(pTask, wdTaskPriority::ThisFrame));
+
+    WD_TEST_BOOL(pTask->m_bBuriedTaskDone);
+
+    for (wdUInt32 i = 0; i < WD_ARRAY_SIZE(pTask->m_OtherTasks); ++i)
+    {
+      wdTaskSystem::WaitForGroup(pTask->m_OtherGroups[i]);
+      WD_TEST_BOOL(pTask->m_OtherTasks[i]->IsDone());
+    }
+  }
+
   // capture profiling info for testing
   /*wdStringBuilder sOutputPath = wdTestFramework::GetInstance()->GetAbsOutputPath();
 
@@ -0,0 +1,328 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Physics/SurfaceResourceDescriptor.h>
+#include <Core/World/World.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/AnimationSystem/AnimPoseGenerator.h>
+#include <RendererCore/AnimationSystem/AnimPoseGeneratorWorldModule.h>
+#include <RendererCore/AnimationSystem/AnimationClipResource.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+#include <RendererCore/AnimationSystem/SkeletonComponent.h>
+#include <RendererCore/AnimationSystem/SkeletonBuilder.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
+
+// Enable when needed
+#define WD_ANIM_POSE_GENERATOR_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+namespace
+{
+  struct AnimPoseTestResources
+  {
+    wdSkeletonResourceHandle m_hSkeleton;
+    wdAnimationClipResourceHandle m_hClip;
+  };
+
+  AnimPoseTestResources CreateAnimPoseTestResources(const char* szName, wdUInt16 uiNumJoints)
+  {
+    AnimPoseTestResources res;
+
+    wdSkeletonBuilder skeletonBuilder;
+    wdAnimationClipResourceDescriptor clipDesc;
+
+    wdStringBuilder sJointName;
+
+    for (wdUInt16 i = 0; i < uiNumJoints; ++i)
+    {
+      sJointName.Format("Joint{}", i);
+
+      const wdTransform bindPose(wdVec3(0, 0, 0.5f));
+      skeletonBuilder.AddJoint(sJointName, bindPose, i == 0 ? wdInvalidJointIndex : i - 1);
+
+      wdHashedString sHashedJointName;
+      sHashedJointName.Assign(sJointName);
+      clipDesc.CreateJoint(sHashedJointName, 2, 2, 1);
+    }
+
+    clipDesc.AllocateJointTransforms();
+    clipDesc.SetDuration(wdTime::Seconds(1));
+
+    for (wdUInt16 i = 0; i < uiNumJoints; ++i)
+    {
+      sJointName.Format("Joint{}", i);
+      const auto* pJointInfo = clipDesc.GetJointInfo(wdTempHashedString(sJointName));
+
+      auto positions = clipDesc.GetPositionKeyframes(*pJointInfo);
+      positions[0] = {0.0f, wdVec3(0, 0, 0.5f)};
+      positions[1] = {1.0f, wdVec3(0.1f * i, 0, 0.5f)};
+
+      wdQuat qRotation;
+      qRotation.SetFromAxisAndAngle(wdVec3(0, 1, 0), wdAngle::Degree(30.0f));
+
+      auto rotations = clipDesc.GetRotationKeyframes(*pJointInfo);
+      rotations[0] = {0.0f, wdQuat::IdentityQuaternion()};
+      rotations[1] = {1.0f, qRotation};
+
+      auto scales = clipDesc.GetScaleKeyframes(*pJointInfo);
+      scales[0] = {0.0f, wdVec3(1.0f)};
+    }
+
+    wdSkeletonResourceDescriptor skeletonDesc;
+    skeletonBuilder.BuildSkeleton(skeletonDesc.m_Skeleton);
+
+    wdStringBuilder sResourceID;
+    sResourceID.Format("{}Skeleton", szName);
+    res.m_hSkeleton = wdResourceManager::CreateResource<wdSkeletonResource>(sResourceID, std::move(skeletonDesc));
+
+    sResourceID.Format("{}Clip", szName);
+    res.m_hClip = wdResourceManager::CreateResource<wdAnimationClipResource>(sResourceID, std::move(clipDesc));
+
+    return res;
+  }
+
+  void SetupSamplingCommands(wdAnimPoseGenerator& ref_poseGenerator, const wdSkeletonResource* pSkeleton, const wdAnimationClipResourceHandle& hClip, float fSamplePos)
+  {
+    ref_poseGenerator.Reset(pSkeleton);
+
+    auto& sampleCmd = ref_poseGenerator.AllocCommandSampleTrack(0);
+    sampleCmd.m_hAnimationClip = hClip;
+    sampleCmd.m_fNormalizedSamplePos = fSamplePos;
+    sampleCmd.m_fPreviousNormalizedSamplePos = fSamplePos;
+
+    auto& localToModelCmd = ref_poseGenerator.AllocCommandLocalToModelPose();
+    localToModelCmd.m_Inputs.PushBack(sampleCmd.GetCommandID());
+
+    auto& outputCmd = ref_poseGenerator.AllocCommandModelPoseToOutput();
+    outputCmd.m_Inputs.PushBack(localToModelCmd.GetCommandID());
+  }
+
+  float GetSamplePos(wdUInt32 uiIndex, wdUInt32 uiCount)
+  {
+    return (float)uiIndex / (float)uiCount;
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST_GROUP(AnimationSystem);
+
+WD_CREATE_SIMPLE_TEST(AnimationSystem, AnimPoseGeneratorWorldModule)
+{
+  constexpr wdUInt32 uiNumSkeletons = 64;
+  constexpr wdUInt16 uiNumJoints = 32;
+
+  const AnimPoseTestResources res = CreateAnimPoseTestResources("AnimPoseGeneratorTest", uiNumJoints);
+
+  wdResourceLock<wdSkeletonResource> pSkeleton(res.m_hSkeleton, wdResourceAcquireMode::BlockTillLoaded);
+  WD_TEST_BOOL(pSkeleton.GetAcquireResult() == wdResourceAcquireResult::Final);
+
+  wdDynamicArray<wdDynamicArray<wdMat4>> referencePoses;
+  referencePoses.SetCount(uiNumSkeletons);
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Serial")
+  {
+    for (wdUInt32 i = 0; i < uiNumSkeletons; ++i)
+    {
+      wdAnimPoseGenerator poseGenerator;
+      SetupSamplingCommands(poseGenerator, pSkeleton.GetPointer(), res.m_hClip, GetSamplePos(i, uiNumSkeletons));
+
+      WD_TEST_BOOL(poseGenerator.CanGeneratePoseDeferred());
+
+      const wdArrayPtr<wdMat4> pose = poseGenerator.GeneratePose(nullptr);
+      WD_TEST_INT(pose.GetCount(), uiNumJoints);
+
+      referencePoses[i] = pose;
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Created By Skeleton Component")
+  {
+    wdWorldDesc worldDesc("AnimPoseGeneratorTest");
+    wdWorld world(worldDesc);
+    WD_LOCK(world.GetWriteMarker());
+
+    WD_TEST_BOOL(world.GetModule<wdAnimPoseGeneratorWorldModule>() == nullptr);
+
+    wdGameObjectDesc objectDesc;
+    wdGameObject* pObject = nullptr;
+    world.CreateObject(objectDesc, pObject);
+
+    wdSkeletonComponent* pSkeletonComponent = nullptr;
+    wdSkeletonComponent::CreateComponent(pObject, pSkeletonComponent);
+    pSkeletonComponent->SetSkeleton(res.m_hSkeleton);
+
+    // components are initialized and start simulating during the update
+    world.Update();
+
+    WD_TEST_BOOL(world.GetModule<wdAnimPoseGeneratorWorldModule>() != nullptr);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Parallel")
+  {
+    wdWorldDesc worldDesc("AnimPoseGeneratorTest");
+    wdWorld world(worldDesc);
+    WD_LOCK(world.GetWriteMarker());
+
+    wdAnimPoseGeneratorWorldModule* pModule = world.GetOrCreateModule<wdAnimPoseGeneratorWorldModule>();
+    WD_TEST_BOOL(pModule != nullptr);
+
+    wdDynamicArray<wdAnimPoseGenerator> poseGenerators;
+    poseGenerators.SetCount(uiNumSkeletons);
+
+    for (wdUInt32 i = 0; i < uiNumSkeletons; ++i)
+    {
+      wdGameObjectDesc objectDesc;
+      wdGameObject* pObject = nullptr;
+      world.CreateObject(objectDesc, pObject);
+
+      SetupSamplingCommands(poseGenerators[i], pSkeleton.GetPointer(), res.m_hClip, GetSamplePos(i, uiNumSkeletons));
+      pModule->QueuePoseGeneration(poseGenerators[i], pObject, res.m_hSkeleton);
+
+      // queuing twice must not add a second entry
+      pModule->QueuePoseGeneration(poseGenerators[i], pObject, res.m_hSkeleton);
+    }
+
+    WD_TEST_INT(pModule->GetNumQueuedPoses(), uiNumSkeletons);
+
+    // cancelled generators are skipped
+    pModule->CancelPoseGeneration(poseGenerators[0]);
+
+    pModule->GenerateQueuedPoses();
+    WD_TEST_INT(pModule->GetNumQueuedPoses(), 0);
+
+    for (wdUInt32 i = 1; i < uiNumSkeletons; ++i)
+    {
+      // all commands have been executed by the module already, so this only returns the generated pose
+      const wdArrayPtr<wdMat4> pose = poseGenerators[i].GeneratePose(nullptr);
+      WD_TEST_INT(pose.GetCount(), uiNumJoints);
+
+      for (wdUInt32 j = 0; j < pose.GetCount(); ++j)
+      {
+        WD_TEST_BOOL(pose[j].IsEqual(referencePoses[i][j], 0.0001f));
+      }
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Interpolated Pose")
+  {
+    wdWorldDesc worldDesc("AnimPoseGeneratorTest");
+    wdWorld world(worldDesc);
+    WD_LOCK(world.GetWriteMarker());
+
+    wdAnimPoseGeneratorWorldModule* pModule = world.GetOrCreateModule<wdAnimPoseGeneratorWorldModule>();
+
+    wdGameObjectDesc objectDesc;
+    wdGameObject* pObject = nullptr;
+    world.CreateObject(objectDesc, pObject);
+
+    const wdTime frameTime = wdTime::Milliseconds(10);
+    const wdVec3 vReference(0, 0, 0);
+
+    wdAnimationLodSettings settings;
+    settings.m_Levels.PushBack({wdMath::HighValue<float>(), 4});
+
+    wdAnimationLodState lodState;
+
+    wdMat4 poseA[1];
+    poseA[0].SetIdentity();
+
+    wdMat4 poseB[1];
+    poseB[0].SetTranslationMatrix(wdVec3(4, 0, 0));
+
+    WD_TEST_BOOL(lodState.Update(settings, frameTime, pObject, &vReference));
+    lodState.AddGeneratedPose(wdMakeArrayPtr(poseA));
+
+    while (!lodState.Update(settings, frameTime, pObject, &vReference))
+    {
+    }
+
+    // starts blending from poseA to poseB
+    lodState.AddGeneratedPose(wdMakeArrayPtr(poseB));
+
+    // a skipped frame only queues the interpolated pose, the generator has no commands
+    WD_TEST_BOOL(!lodState.Update(settings, frameTime, pObject, &vReference));
+
+    wdAnimPoseGenerator poseGenerator;
+    pModule->QueueInterpolatedPose(poseGenerator, pObject, res.m_hSkeleton, lodState);
+    WD_TEST_INT(pModule->GetNumQueuedPoses(), 1);
+
+    pModule->GenerateQueuedPoses();
+    WD_TEST_INT(pModule->GetNumQueuedPoses(), 0);
+
+    // the module has consumed the interpolated pose of the skipped frame, so the next frame continues from there
+    WD_TEST_BOOL(!lodState.Update(settings, frameTime, pObject, &vReference));
+
+    const wdArrayPtr<const wdMat4> pose = lodState.GetInterpolatedPose();
+    if (WD_TEST_INT(pose.GetCount(), 1))
+    {
+      WD_TEST_VEC3(pose[0].GetTranslationVector(), wdVec3(3, 0, 0), 0.0001f);
+    }
+  }
+}
+
+WD_CREATE_SIMPLE_TEST(AnimationSystem, AnimPoseGeneratorPerformance)
+{
+  constexpr wdUInt32 uiNumSkeletons = 1024;
+  constexpr wdUInt16 uiNumJoints = 64;
+  constexpr wdUInt32 uiNumFrames = 32;
+
+  WD_TEST_BLOCK(WD_ANIM_POSE_GENERATOR_PERFORMANCE_TESTS_STATE, "Serial vs. Parallel")
+  {
+    const AnimPoseTestResources res = CreateAnimPoseTestResources("AnimPoseGeneratorPerformance", uiNumJoints);
+
+    wdResourceLock<wdSkeletonResource> pSkeleton(res.m_hSkeleton, wdResourceAcquireMode::BlockTillLoaded);
+
+    wdWorldDesc worldDesc("AnimPoseGeneratorPerformance");
+    wdWorld world(worldDesc);
+    WD_LOCK(world.GetWriteMarker());
+
+    wdAnimPoseGeneratorWorldModule* pModule = world.GetOrCreateModule<wdAnimPoseGeneratorWorldModule>();
+
+    wdDynamicArray<wdGameObject*> objects;
+    for (wdUInt32 i = 0; i < uiNumSkeletons; ++i)
+    {
+      wdGameObjectDesc objectDesc;
+      world.CreateObject(objectDesc, objects.ExpandAndGetRef());
+    }
+
+    wdDynamicArray<wdAnimPoseGenerator> poseGenerators;
+    poseGenerators.SetCount(uiNumSkeletons);
+
+    wdTime tSerial;
+    wdTime tParallel;
+
+    for (wdUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      for (wdUInt32 i = 0; i < uiNumSkeletons; ++i)
+      {
+        SetupSamplingCommands(poseGenerators[i], pSkeleton.GetPointer(), res.m_hClip, GetSamplePos((i + uiFrame) % uiNumSkeletons, uiNumSkeletons));
+      }
+
+      {
+        const wdTime tStart = wdTime::Now();
+
+        for (wdUInt32 i = 0; i < uiNumSkeletons; ++i)
+        {
+          poseGenerators[i].GeneratePose(nullptr);
+        }
+
+        tSerial += wdTime::Now() - tStart;
+      }
+
+      for (wdUInt32 i = 0; i < uiNumSkeletons; ++i)
+      {
+        SetupSamplingCommands(poseGenerators[i], pSkeleton.GetPointer(), res.m_hClip, GetSamplePos((i + uiFrame) % uiNumSkeletons, uiNumSkeletons));
+        pModule->QueuePoseGeneration(poseGenerators[i], objects[i], res.m_hSkeleton);
+      }
+
+      {
+        const wdTime tStart = wdTime::Now();
+
+        pModule->GenerateQueuedPoses();
+
+        tParallel += wdTime::Now() - tStart;
+      }
+    }
+
+    wdLog::Info("[test]{0} skeletons with {1} joints: {2}ms serial, {3}ms parallel per frame", uiNumSkeletons, uiNumJoints,
+      wdArgF(tSerial.GetMilliseconds() / uiNumFrames, 3), wdArgF(tParallel.GetMilliseconds() / uiNumFrames, 3));
+  }
+}
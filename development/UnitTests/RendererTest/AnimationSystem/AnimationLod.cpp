@@ -0,0 +1,147 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <RendererCore/AnimationSystem/AnimationLod.h>
+
+WD_CREATE_SIMPLE_TEST(AnimationSystem, AnimationLod)
+{
+  wdWorldDesc worldDesc("AnimationLodTest");
+  wdWorld world(worldDesc);
+  WD_LOCK(world.GetWriteMarker());
+
+  wdGameObjectDesc objectDesc;
+  objectDesc.m_LocalPosition.Set(100, 0, 0);
+
+  wdGameObject* pObject = nullptr;
+  world.CreateObject(objectDesc, pObject);
+
+  const wdTime frameTime = wdTime::Milliseconds(10);
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Disabled")
+  {
+    wdAnimationLodSettings settings;
+    wdAnimationLodState state;
+
+    const wdVec3 vReference(0, 0, 0);
+
+    for (wdUInt32 i = 0; i < 10; ++i)
+    {
+      WD_TEST_BOOL(state.Update(settings, frameTime, pObject, &vReference));
+      WD_TEST_BOOL(state.ShouldGeneratePose());
+      WD_TEST_BOOL(state.GetStepTime() == frameTime);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Distance Levels")
+  {
+    wdAnimationLodSettings settings;
+    settings.m_Levels.PushBack({50.0f, 1});
+    settings.m_Levels.PushBack({200.0f, 4});
+    settings.m_bInterpolatePoses = false;
+
+    wdAnimationLodState state;
+
+    const wdVec3 vReference(0, 0, 0);
+
+    // the first update always happens
+    WD_TEST_BOOL(state.Update(settings, frameTime, pObject, &vReference));
+    WD_TEST_INT(state.GetUpdateInterval(), 4);
+
+    wdUInt32 uiNumUpdates = 0;
+    wdTime totalStepTime;
+
+    for (wdUInt32 i = 0; i < 40; ++i)
+    {
+      if (state.Update(settings, frameTime, pObject, &vReference))
+      {
+        ++uiNumUpdates;
+        totalStepTime += state.GetStepTime();
+      }
+    }
+
+    WD_TEST_INT(uiNumUpdates, 10);
+    WD_TEST_BOOL(totalStepTime <= frameTime * 40.0 && totalStepTime >= frameTime * 36.0);
+
+    // without reference position the distance levels are ignored
+    for (wdUInt32 i = 0; i < 5; ++i)
+    {
+      WD_TEST_BOOL(state.Update(settings, frameTime, pObject, nullptr));
+    }
+
+    // close to the reference position, the finest level is used
+    const wdVec3 vCloseReference(90, 0, 0);
+    WD_TEST_BOOL(state.Update(settings, frameTime, pObject, &vCloseReference));
+    WD_TEST_INT(state.GetUpdateInterval(), 1);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Interpolation")
+  {
+    wdAnimationLodSettings settings;
+    settings.m_Levels.PushBack({wdMath::HighValue<float>(), 4});
+
+    wdAnimationLodState state;
+
+    const wdVec3 vReference(0, 0, 0);
+
+    wdMat4 poseA[1];
+    poseA[0].SetIdentity();
+
+    wdMat4 poseB[1];
+    poseB[0].SetTranslationMatrix(wdVec3(4, 0, 0));
+
+    // run until the first regular update
+    WD_TEST_BOOL(state.Update(settings, frameTime, pObject, &vReference));
+    WD_TEST_INT(state.AddGeneratedPose(wdMakeArrayPtr(poseA)).GetCount(), 1);
+
+    while (!state.Update(settings, frameTime, pObject, &vReference))
+    {
+      WD_TEST_BOOL(state.GetInterpolatedPose().IsEmpty());
+    }
+
+    // the new pose is blended in over the update interval
+    wdArrayPtr<const wdMat4> pose = state.AddGeneratedPose(wdMakeArrayPtr(poseB));
+    WD_TEST_VEC3(pose[0].GetTranslationVector(), wdVec3(1, 0, 0), 0.0001f);
+
+    for (wdUInt32 i = 2; i <= 4; ++i)
+    {
+      WD_TEST_BOOL(!state.Update(settings, frameTime, pObject, &vReference));
+
+      pose = state.GetInterpolatedPose();
+      WD_TEST_VEC3(pose[0].GetTranslationVector(), wdVec3((float)i, 0, 0), 0.0001f);
+    }
+
+    // the target pose has been reached
+    WD_TEST_BOOL(state.GetInterpolatedPose().IsEmpty());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Serialization")
+  {
+    wdAnimationLodSettings settings;
+    settings.m_Levels.PushBack({50.0f, 1});
+    settings.m_Levels.PushBack({200.0f, 4});
+    settings.m_uiInvisibleUpdateInterval = 8;
+    settings.m_uiNumFramesBeforeInvisible = 3;
+    settings.m_bSkipPoseWhenInvisible = true;
+    settings.m_bInterpolatePoses = false;
+
+    wdDefaultMemoryStreamStorage storage;
+    wdMemoryStreamWriter writer(&storage);
+    WD_TEST_BOOL(settings.Serialize(writer).Succeeded());
+
+    wdAnimationLodSettings settings2;
+    wdMemoryStreamReader reader(&storage);
+    WD_TEST_BOOL(settings2.Deserialize(reader).Succeeded());
+
+    if (WD_TEST_INT(settings2.m_Levels.GetCount(), 2))
+    {
+      WD_TEST_FLOAT(settings2.m_Levels[1].m_fMaxDistance, 200.0f, 0.0f);
+      WD_TEST_INT(settings2.m_Levels[1].m_uiUpdateInterval, 4);
+    }
+
+    WD_TEST_INT(settings2.m_uiInvisibleUpdateInterval, 8);
+    WD_TEST_INT(settings2.m_uiNumFramesBeforeInvisible, 3);
+    WD_TEST_BOOL(settings2.m_bSkipPoseWhenInvisible);
+    WD_TEST_BOOL(!settings2.m_bInterpolatePoses);
+  }
+}
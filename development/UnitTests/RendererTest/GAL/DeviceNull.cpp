@@ -0,0 +1,370 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Core/Graphics/Geometry.h>
+#include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/GPUResourcePool/GPUResourcePool.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererCore/Meshes/MeshResource.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/Passes/OpaqueForwardRenderPass.h>
+#include <RendererCore/Pipeline/Passes/SourcePass.h>
+#include <RendererCore/Pipeline/Passes/TargetPass.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererFoundation/CommandEncoder/ComputeCommandEncoder.h>
+#include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererFoundation/Device/Pass.h>
+#include <RendererFoundation/Null/DeviceNull.h>
+#include <RendererFoundation/Resources/RenderTargetSetup.h>
+
+// Measures the CPU cost of extracting, rendering and submitting a synthetic world without any graphics API overhead.
+#define WD_NULL_DEVICE_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+WD_CREATE_SIMPLE_TEST_GROUP(GAL);
+
+namespace
+{
+  wdMeshResourceHandle CreateBenchmarkMesh()
+  {
+    // there is no material asset in the unit test data, an empty material keeps the mesh from waiting on a missing file
+    wdResourceManager::GetOrCreateResource<wdMaterialResource>("NullDeviceBenchmarkMaterial", wdMaterialResourceDescriptor(), "NullDeviceBenchmarkMaterial");
+
+    wdGeometry geom;
+    geom.AddBox(wdVec3(1), false);
+    geom.TriangulatePolygons();
+    geom.ComputeTangents();
+
+    wdMeshResourceDescriptor desc;
+    desc.SetMaterial(0, "NullDeviceBenchmarkMaterial");
+
+    desc.MeshBufferDesc().AddCommonStreams();
+    desc.MeshBufferDesc().AllocateStreamsFromGeometry(geom, wdGALPrimitiveTopology::Triangles);
+
+    desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+
+    desc.ComputeBounds();
+
+    return wdResourceManager::GetOrCreateResource<wdMeshResource>("NullDeviceBenchmarkMesh", std::move(desc), "NullDeviceBenchmarkMesh");
+  }
+
+  // The default forward pipeline lives in the base data, which the unit tests don't have, so the relevant part of it is built in code.
+  wdRenderPipelineResourceHandle CreateBenchmarkPipeline()
+  {
+    wdUniquePtr<wdRenderPipeline> pRenderPipeline = WD_DEFAULT_NEW(wdRenderPipeline);
+
+    wdSourcePass* pColorSourcePass = nullptr;
+    {
+      wdUniquePtr<wdSourcePass> pPass = WD_DEFAULT_NEW(wdSourcePass, "ColorSource");
+      pColorSourcePass = pPass.Borrow();
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    wdSourcePass* pDepthSourcePass = nullptr;
+    {
+      wdUniquePtr<wdSourcePass> pPass = WD_DEFAULT_NEW(wdSourcePass, "DepthStencil");
+      pDepthSourcePass = pPass.Borrow();
+
+      auto pFormatProp = static_cast<wdAbstractMemberProperty*>(pDepthSourcePass->GetDynamicRTTI()->FindPropertyByName("Format"));
+      wdReflectionUtils::SetMemberPropertyValue(pFormatProp, pDepthSourcePass, (wdInt64)wdGALResourceFormat::D24S8);
+
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    wdOpaqueForwardRenderPass* pOpaquePass = nullptr;
+    {
+      wdUniquePtr<wdOpaqueForwardRenderPass> pPass = WD_DEFAULT_NEW(wdOpaqueForwardRenderPass);
+      pOpaquePass = pPass.Borrow();
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    wdTargetPass* pTargetPass = nullptr;
+    {
+      wdUniquePtr<wdTargetPass> pPass = WD_DEFAULT_NEW(wdTargetPass);
+      pTargetPass = pPass.Borrow();
+      pRenderPipeline->AddPass(std::move(pPass));
+    }
+
+    WD_VERIFY(pRenderPipeline->Connect(pColorSourcePass, "Output", pOpaquePass, "Color"), "Connect failed!");
+    WD_VERIFY(pRenderPipeline->Connect(pDepthSourcePass, "Output", pOpaquePass, "DepthStencil"), "Connect failed!");
+    WD_VERIFY(pRenderPipeline->Connect(pOpaquePass, "Color", pTargetPass, "Color0"), "Connect failed!");
+    WD_VERIFY(pRenderPipeline->Connect(pOpaquePass, "DepthStencil", pTargetPass, "DepthStencil"), "Connect failed!");
+
+    pRenderPipeline->AddExtractor(WD_DEFAULT_NEW(wdVisibleObjectsExtractor));
+
+    wdRenderPipelineResourceDescriptor desc;
+    desc.CreateFromRenderPipeline(pRenderPipeline.Borrow());
+
+    return wdResourceManager::GetOrCreateResource<wdRenderPipelineResource>("NullDeviceBenchmarkPipeline", std::move(desc), "NullDeviceBenchmarkPipeline");
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(GAL, DeviceNull)
+{
+  wdGALDeviceCreationDescription deviceDesc;
+  wdGALDeviceNull* pDevice = static_cast<wdGALDeviceNull*>(wdGALDeviceFactory::CreateDevice("Null", wdFoundation::GetDefaultAllocator(), deviceDesc).m_pInstance);
+
+  if (!WD_TEST_BOOL(pDevice != nullptr))
+    return;
+
+  WD_TEST_BOOL(pDevice->Init().Succeeded());
+  WD_TEST_BOOL(pDevice->GetCapabilities().m_sAdapterName == "Null Device");
+
+  wdGALBufferHandle hVertexBuffer = pDevice->CreateVertexBuffer(sizeof(wdVec3), 3);
+  wdGALBufferHandle hIndexBuffer = pDevice->CreateIndexBuffer(wdGALIndexType::UShort, 3);
+  wdGALBufferHandle hConstantBuffer = pDevice->CreateConstantBuffer(sizeof(wdVec4));
+
+  wdGALTextureCreationDescription textureDesc;
+  textureDesc.SetAsRenderTarget(64, 64, wdGALResourceFormat::RGBAUByteNormalized);
+  wdGALTextureHandle hTexture = pDevice->CreateTexture(textureDesc);
+
+  WD_TEST_BOOL(!hVertexBuffer.IsInvalidated());
+  WD_TEST_BOOL(!hIndexBuffer.IsInvalidated());
+  WD_TEST_BOOL(!hConstantBuffer.IsInvalidated());
+  WD_TEST_BOOL(!hTexture.IsInvalidated());
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Resources")
+  {
+    WD_TEST_INT(pDevice->GetStatistics().m_uiCreatedBuffers, 3);
+    WD_TEST_INT(pDevice->GetStatistics().m_uiCreatedTextures, 1);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Frame")
+  {
+    pDevice->ResetStatistics();
+
+    pDevice->BeginFrame(1);
+    pDevice->BeginPipeline("NullDeviceTest", wdGALSwapChainHandle());
+
+    wdGALPass* pPass = pDevice->BeginPass("Pass");
+
+    wdGALRenderingSetup renderingSetup;
+    renderingSetup.m_RenderTargetSetup.SetRenderTarget(0, pDevice->GetDefaultRenderTargetView(hTexture));
+    renderingSetup.m_uiRenderTargetClearMask = 0xFFFFFFFF;
+
+    wdGALRenderCommandEncoder* pRenderEncoder = pPass->BeginRendering(renderingSetup, "Rendering");
+
+    const wdGALTimestampHandle hTimestamp = pRenderEncoder->InsertTimestamp();
+
+    pRenderEncoder->SetVertexBuffer(0, hVertexBuffer);
+    pRenderEncoder->SetIndexBuffer(hIndexBuffer);
+    pRenderEncoder->SetPrimitiveTopology(wdGALPrimitiveTopology::Triangles);
+
+    // redundant state changes are filtered before they reach the device
+    pRenderEncoder->SetVertexBuffer(0, hVertexBuffer);
+
+    const wdVec4 vData(1, 2, 3, 4);
+    for (wdUInt32 i = 0; i < 10; ++i)
+    {
+      pRenderEncoder->UpdateBuffer(hConstantBuffer, 0, wdMakeArrayPtr(reinterpret_cast<const wdUInt8*>(&vData), sizeof(vData)));
+      pRenderEncoder->DrawIndexed(3, 0);
+    }
+
+    pPass->EndRendering(pRenderEncoder);
+
+    wdGALComputeCommandEncoder* pComputeEncoder = pPass->BeginCompute("Compute");
+    pComputeEncoder->Dispatch(1, 1, 1);
+    pComputeEncoder->Dispatch(8, 8, 1);
+    pPass->EndCompute(pComputeEncoder);
+
+    pDevice->EndPass(pPass);
+    pDevice->EndPipeline(wdGALSwapChainHandle());
+    pDevice->EndFrame();
+
+    const wdGALDeviceNullStatistics& stats = pDevice->GetStatistics();
+    WD_TEST_INT(stats.m_uiPipelines, 1);
+    WD_TEST_INT(stats.m_uiPasses, 1);
+    WD_TEST_INT(stats.m_uiRenderingScopes, 1);
+    WD_TEST_INT(stats.m_uiComputeScopes, 1);
+    WD_TEST_INT(stats.m_uiClears, 1);
+    WD_TEST_INT(stats.m_uiDrawCalls, 10);
+    WD_TEST_INT(stats.m_uiDispatchCalls, 2);
+    WD_TEST_INT(stats.m_uiVertexBufferChanges, 1);
+    WD_TEST_INT(stats.m_uiIndexBufferChanges, 1);
+    WD_TEST_INT(stats.m_uiPrimitiveTopologyChanges, 1);
+    WD_TEST_INT(stats.m_uiBufferUpdates, 10);
+    WD_TEST_INT(stats.m_uiBufferUpdateBytes, 10 * sizeof(wdVec4));
+
+    wdTime timestamp;
+    WD_TEST_BOOL(pDevice->GetTimestampResult(hTimestamp, timestamp).Succeeded());
+    WD_TEST_BOOL(timestamp.IsPositive());
+  }
+
+  WD_TEST_BLOCK(WD_NULL_DEVICE_PERFORMANCE_TESTS_STATE, "Draw Call Submission")
+  {
+    constexpr wdUInt32 uiNumFrames = 100;
+    constexpr wdUInt32 uiNumObjectsPerAxis = 32;
+    constexpr wdUInt32 uiNumObjects = uiNumObjectsPerAxis * uiNumObjectsPerAxis;
+
+    // extraction and rendering are timed separately, so both have to run on this thread within the same frame
+    wdCVarBool* pMultithreading = static_cast<wdCVarBool*>(wdCVar::FindCVarByName("Rendering.Multithreading"));
+    const bool bMultithreading = *pMultithreading;
+    *pMultithreading = false;
+
+    wdGALDevice::SetDefaultDevice(pDevice);
+    wdGPUResourcePool::SetDefaultInstance(WD_DEFAULT_NEW(wdGPUResourcePool));
+    wdStartup::StartupHighLevelSystems();
+
+    wdTime tExtraction;
+    wdTime tPipeline;
+    wdTime tSubmission;
+    wdUInt32 uiPipelineDrawCalls = 0;
+
+    {
+      wdMeshResourceHandle hMesh = CreateBenchmarkMesh();
+      wdRenderPipelineResourceHandle hPipeline = CreateBenchmarkPipeline();
+
+      wdWorldDesc worldDesc("NullDeviceBenchmark");
+      wdWorld world(worldDesc);
+
+      {
+        WD_LOCK(world.GetWriteMarker());
+
+        for (wdUInt32 y = 0; y < uiNumObjectsPerAxis; ++y)
+        {
+          for (wdUInt32 x = 0; x < uiNumObjectsPerAxis; ++x)
+          {
+            wdGameObjectDesc objectDesc;
+            objectDesc.m_LocalPosition.Set(x * 2.0f, y * 2.0f, 0.0f);
+
+            wdGameObject* pObject = nullptr;
+            world.CreateObject(objectDesc, pObject);
+
+            wdMeshComponent* pMeshComponent = nullptr;
+            wdMeshComponent::CreateComponent(pObject, pMeshComponent);
+            pMeshComponent->SetMesh(hMesh);
+          }
+        }
+      }
+
+      wdGALTextureCreationDescription depthDesc;
+      depthDesc.SetAsRenderTarget(64, 64, wdGALResourceFormat::D24S8);
+      wdGALTextureHandle hDepthTexture = pDevice->CreateTexture(depthDesc);
+
+      wdGALRenderTargets renderTargets;
+      renderTargets.m_hRTs[0] = hTexture;
+      renderTargets.m_hDSTarget = hDepthTexture;
+
+      const float fCenter = uiNumObjectsPerAxis - 1.0f;
+
+      wdCamera camera;
+      camera.SetCameraMode(wdCameraMode::PerspectiveFixedFovY, 90.0f, 0.1f, 1000.0f);
+      camera.LookAt(wdVec3(fCenter, fCenter, 50.0f), wdVec3(fCenter, fCenter, 0.0f), wdVec3(0, 1, 0));
+
+      wdView* pView = nullptr;
+      wdViewHandle hView = wdRenderWorld::CreateView("NullDeviceBenchmark", pView);
+      pView->SetCameraUsageHint(wdCameraUsageHint::MainView);
+      pView->SetRenderTargets(renderTargets);
+      pView->SetViewport(wdRectFloat(0.0f, 0.0f, 64.0f, 64.0f));
+      pView->SetRenderPipelineResource(hPipeline);
+      pView->SetWorld(&world);
+      pView->SetCamera(&camera);
+
+      wdRenderWorld::AddMainView(hView);
+
+      // the raw GAL replay below must only touch the device between BeginFrame and EndFrame
+      wdGALRenderingSetup renderingSetup;
+      renderingSetup.m_RenderTargetSetup.SetRenderTarget(0, pDevice->GetDefaultRenderTargetView(hTexture));
+
+      wdUInt64 uiRenderFrame = 2;
+
+      // one warm-up frame so that pipeline creation and resource loading are not part of the measurement
+      for (wdUInt32 uiFrame = 0; uiFrame <= uiNumFrames; ++uiFrame)
+      {
+        const bool bMeasure = uiFrame > 0;
+
+        wdRenderWorld::BeginFrame();
+        pDevice->BeginFrame(uiRenderFrame++);
+
+        {
+          WD_LOCK(world.GetWriteMarker());
+          world.Update();
+        }
+
+        pDevice->ResetStatistics();
+
+        wdStopwatch sw;
+
+        wdRenderWorld::ExtractMainViews();
+        const wdTime tFrameExtraction = sw.Checkpoint();
+
+        wdRenderWorld::Render(wdRenderContext::GetDefaultInstance());
+        const wdTime tFramePipeline = sw.Checkpoint();
+
+        const wdUInt32 uiFrameDrawCalls = pDevice->GetStatistics().m_uiDrawCalls;
+
+        // replay one draw per object straight on the GAL to see how much of the pipeline time is pure submission
+        {
+          pDevice->BeginPipeline("NullDeviceBenchmarkSubmission", wdGALSwapChainHandle());
+          wdGALPass* pPass = pDevice->BeginPass("Submission");
+          wdGALRenderCommandEncoder* pRenderEncoder = pPass->BeginRendering(renderingSetup);
+
+          sw.Checkpoint();
+
+          for (wdUInt32 i = 0; i < uiNumObjects; ++i)
+          {
+            pRenderEncoder->SetVertexBuffer(0, hVertexBuffer);
+            pRenderEncoder->SetIndexBuffer(hIndexBuffer);
+            pRenderEncoder->DrawIndexed(3, 0);
+          }
+
+          const wdTime tFrameSubmission = sw.Checkpoint();
+
+          pPass->EndRendering(pRenderEncoder);
+          pDevice->EndPass(pPass);
+          pDevice->EndPipeline(wdGALSwapChainHandle());
+
+          WD_TEST_INT(pDevice->GetStatistics().m_uiDrawCalls, uiFrameDrawCalls + uiNumObjects);
+
+          if (bMeasure)
+          {
+            tExtraction += tFrameExtraction;
+            tPipeline += tFramePipeline;
+            tSubmission += tFrameSubmission;
+            uiPipelineDrawCalls += uiFrameDrawCalls;
+          }
+        }
+
+        pDevice->EndFrame();
+        wdRenderWorld::EndFrame();
+      }
+
+      wdRenderWorld::RemoveMainView(hView);
+      wdRenderWorld::DeleteView(hView);
+
+      pDevice->DestroyTexture(hDepthTexture);
+    }
+
+    wdResourceManager::FreeAllUnusedResources();
+
+    wdStartup::ShutdownHighLevelSystems();
+    wdGPUResourcePool::SetDefaultInstance(nullptr);
+    wdGALDevice::SetDefaultDevice(nullptr);
+
+    *pMultithreading = bMultithreading;
+
+    // without compiled shaders (no shader cache in the unit test data) the pipeline skips its mesh draws,
+    // in that case the pipeline time is pure extraction, sorting and render context overhead
+    wdLog::Info("[test]Null device: {} objects, per frame: extraction {}ms, pipeline {}ms ({} draw calls), GAL submission {}ms ({}ns per draw call)", uiNumObjects,
+      wdArgF(tExtraction.GetMilliseconds() / uiNumFrames, 3), wdArgF(tPipeline.GetMilliseconds() / uiNumFrames, 3), uiPipelineDrawCalls / uiNumFrames,
+      wdArgF(tSubmission.GetMilliseconds() / uiNumFrames, 3), wdArgF(tSubmission.GetNanoseconds() / (uiNumFrames * uiNumObjects), 1));
+  }
+
+  pDevice->DestroyTexture(hTexture);
+  pDevice->DestroyBuffer(hConstantBuffer);
+  pDevice->DestroyBuffer(hIndexBuffer);
+  pDevice->DestroyBuffer(hVertexBuffer);
+
+  WD_TEST_BOOL(pDevice->Shutdown().Succeeded());
+
+  WD_DEFAULT_DELETE(pDevice);
+}
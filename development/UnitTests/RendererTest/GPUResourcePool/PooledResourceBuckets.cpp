@@ -0,0 +1,257 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <RendererCore/GPUResourcePool/PooledResourceBuckets.h>
+#include <RendererFoundation/RendererFoundationDLL.h>
+
+WD_CREATE_SIMPLE_TEST_GROUP(GPUResourcePool);
+
+namespace
+{
+  wdGALTextureHandle MakeTexture(wdUInt32 uiIndex)
+  {
+    return wdGALTextureHandle(wdGAL::wd18_14Id(uiIndex, 1));
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(GPUResourcePool, PooledResourceBuckets)
+{
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Push / Pop")
+  {
+    wdPooledResourceBuckets<wdGALTextureHandle> buckets(16, 8);
+    WD_TEST_INT(buckets.GetNumBuckets(), 16);
+
+    wdGALTextureHandle hTexture;
+    WD_TEST_BOOL(!buckets.Pop(42, hTexture));
+
+    WD_TEST_BOOL(buckets.Push(42, MakeTexture(1), 100, 0));
+    WD_TEST_BOOL(buckets.Push(42, MakeTexture(2), 100, 1));
+    WD_TEST_BOOL(buckets.Push(7, MakeTexture(3), 50, 1));
+
+    // small hashes are used internally to mark free buckets
+    WD_TEST_BOOL(buckets.Push(1, MakeTexture(5), 10, 1));
+    WD_TEST_BOOL(buckets.Push(0, MakeTexture(4), 10, 1));
+
+    WD_TEST_INT(buckets.GetCount(), 5);
+    WD_TEST_INT(buckets.GetMemory(), 270);
+
+    // the most recently returned resource comes first
+    WD_TEST_BOOL(buckets.Pop(42, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(2));
+    WD_TEST_BOOL(buckets.Pop(42, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(1));
+    WD_TEST_BOOL(!buckets.Pop(42, hTexture));
+
+    WD_TEST_BOOL(buckets.Pop(0, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(4));
+    WD_TEST_BOOL(!buckets.Pop(0, hTexture));
+
+    WD_TEST_BOOL(buckets.Pop(1, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(5));
+
+    WD_TEST_BOOL(buckets.Pop(7, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(3));
+
+    WD_TEST_INT(buckets.GetCount(), 0);
+    WD_TEST_INT(buckets.GetMemory(), 0);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Full")
+  {
+    wdPooledResourceBuckets<wdGALTextureHandle> buckets(2, 3);
+
+    WD_TEST_BOOL(buckets.Push(1, MakeTexture(1), 1, 0));
+    WD_TEST_BOOL(buckets.Push(2, MakeTexture(2), 1, 0));
+
+    // out of buckets
+    WD_TEST_BOOL(!buckets.Push(3, MakeTexture(3), 1, 0));
+
+    // out of entries
+    WD_TEST_BOOL(buckets.Push(1, MakeTexture(3), 1, 0));
+    WD_TEST_BOOL(!buckets.Push(1, MakeTexture(4), 1, 0));
+
+    wdGALTextureHandle hTexture;
+    WD_TEST_BOOL(buckets.Pop(2, hTexture));
+    WD_TEST_BOOL(buckets.Push(1, MakeTexture(4), 1, 0));
+    WD_TEST_INT(buckets.GetCount(), 3);
+
+    // the bucket of hash 2 is empty now and gets released, which makes room for another hash
+    auto evictFunc = [](wdGALTextureHandle, wdUInt64) {};
+    WD_TEST_INT(buckets.Evict(1, 10, 0, buckets.GetNumBuckets(), evictFunc), 0);
+
+    WD_TEST_BOOL(buckets.Pop(1, hTexture));
+    WD_TEST_BOOL(buckets.Push(3, MakeTexture(5), 1, 0));
+    WD_TEST_BOOL(buckets.Pop(3, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(5));
+    WD_TEST_BOOL(!buckets.Pop(2, hTexture));
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Reuse Buckets")
+  {
+    wdPooledResourceBuckets<wdGALTextureHandle> buckets(16, 64);
+
+    auto evictFunc = [](wdGALTextureHandle, wdUInt64) {};
+
+    // far more distinct hashes than buckets over time, as long as old ones get evicted, new ones can always be pooled
+    for (wdUInt32 uiFrame = 0; uiFrame < 100; ++uiFrame)
+    {
+      for (wdUInt32 i = 0; i < 8; ++i)
+      {
+        const wdUInt32 uiHash = uiFrame * 8 + i;
+        WD_TEST_BOOL(buckets.Push(uiHash, MakeTexture(uiHash), 1, uiFrame));
+        WD_TEST_BOOL(buckets.Push(uiHash, MakeTexture(uiHash + 1000), 1, uiFrame));
+      }
+
+      // the hashes of the previous frame are still found
+      if (uiFrame > 0)
+      {
+        wdGALTextureHandle hTexture;
+        WD_TEST_BOOL(buckets.Pop((uiFrame - 1) * 8, hTexture));
+        WD_TEST_BOOL(hTexture == MakeTexture((uiFrame - 1) * 8 + 1000));
+        WD_TEST_BOOL(buckets.Push((uiFrame - 1) * 8, hTexture, 1, uiFrame - 1));
+      }
+
+      buckets.Evict(uiFrame, 1, 0, buckets.GetNumBuckets(), evictFunc);
+      WD_TEST_INT(buckets.GetCount(), 16);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Evict")
+  {
+    wdPooledResourceBuckets<wdGALTextureHandle> buckets(8, 64);
+
+    for (wdUInt32 i = 0; i < 16; ++i)
+    {
+      WD_TEST_BOOL(buckets.Push(i % 4, MakeTexture(i), 10, i));
+    }
+
+    wdDynamicArray<wdGALTextureHandle> evicted;
+    auto evictFunc = [&](wdGALTextureHandle hTexture, wdUInt64 uiMemory) {
+      WD_TEST_INT(uiMemory, 10);
+      evicted.PushBack(hTexture);
+    };
+
+    // nothing is old enough
+    WD_TEST_INT(buckets.Evict(16, 20, 0, buckets.GetNumBuckets(), evictFunc), 0);
+
+    // incrementally, one bucket at a time: everything that was last used before frame 8, i.e. is at least 9 frames old
+    wdUInt32 uiNumEvicted = 0;
+    for (wdUInt32 b = 0; b < buckets.GetNumBuckets(); ++b)
+    {
+      uiNumEvicted += buckets.Evict(16, 9, b, 1, evictFunc);
+    }
+
+    WD_TEST_INT(uiNumEvicted, 8);
+    WD_TEST_INT(evicted.GetCount(), 8);
+    WD_TEST_INT(buckets.GetCount(), 8);
+    WD_TEST_INT(buckets.GetMemory(), 80);
+
+    for (wdGALTextureHandle hTexture : evicted)
+    {
+      WD_TEST_BOOL(hTexture.GetInternalID().m_InstanceIndex < 8);
+    }
+
+    // the remaining resources keep their order
+    wdGALTextureHandle hTexture;
+    WD_TEST_BOOL(buckets.Pop(1, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(13));
+    WD_TEST_BOOL(buckets.Pop(1, hTexture));
+    WD_TEST_BOOL(hTexture == MakeTexture(9));
+    WD_TEST_BOOL(!buckets.Pop(1, hTexture));
+
+    // the range wraps around
+    evicted.Clear();
+    WD_TEST_INT(buckets.Evict(100, 0, buckets.GetNumBuckets() - 1, buckets.GetNumBuckets(), evictFunc), 6);
+    WD_TEST_INT(buckets.GetCount(), 0);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Multi-threaded")
+  {
+    constexpr wdUInt32 uiNumResources = 256;
+    constexpr wdUInt32 uiNumHashes = 8;
+
+    // some room for the transient resources
+    wdPooledResourceBuckets<wdGALTextureHandle> buckets(64, uiNumResources + 64);
+
+    for (wdUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      buckets.Push(i % uiNumHashes, MakeTexture(i), 1, 0);
+    }
+
+    // every task repeatedly takes resources out and returns them, no resource may get lost or handed out twice
+    wdAtomicInteger32 iNumFailed;
+    wdTaskSystem::ParallelForIndexed(0u, 1024u, [&](wdUInt32 uiStartIndex, wdUInt32 uiEndIndex) {
+      for (wdUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        const wdUInt32 uiHash = i % uiNumHashes;
+
+        wdGALTextureHandle hTextures[4];
+        wdUInt32 uiNumTaken = 0;
+
+        for (wdUInt32 j = 0; j < WD_ARRAY_SIZE(hTextures); ++j)
+        {
+          if (buckets.Pop(uiHash, hTextures[uiNumTaken]))
+          {
+            if (hTextures[uiNumTaken].GetInternalID().m_InstanceIndex % uiNumHashes != uiHash)
+            {
+              iNumFailed.Increment();
+            }
+
+            ++uiNumTaken;
+          }
+        }
+
+        for (wdUInt32 j = 0; j < uiNumTaken; ++j)
+        {
+          if (!buckets.Push(uiHash, hTextures[j], 1, i))
+          {
+            iNumFailed.Increment();
+          }
+        }
+
+        if ((i % 64) == 0)
+        {
+          buckets.Evict(0, 1, uiHash, 1, [&](wdGALTextureHandle, wdUInt64) { iNumFailed.Increment(); });
+        }
+
+        // buckets of hashes that are never pooled for long are released and claimed again all the time
+        const wdUInt32 uiTransientHash = uiNumHashes + (i % 16);
+        if (buckets.Push(uiTransientHash, MakeTexture(uiNumResources + i), 1, 0))
+        {
+          wdGALTextureHandle hTexture;
+          while (buckets.Pop(uiTransientHash, hTexture))
+          {
+            if (hTexture.GetInternalID().m_InstanceIndex < uiNumResources)
+            {
+              iNumFailed.Increment();
+            }
+          }
+        }
+
+        buckets.Evict(0, 1000, i, 4, [&](wdGALTextureHandle, wdUInt64) { iNumFailed.Increment(); });
+      }
+    });
+
+    WD_TEST_INT(iNumFailed, 0);
+    WD_TEST_INT(buckets.GetCount(), uiNumResources);
+    WD_TEST_INT(buckets.GetMemory(), uiNumResources);
+
+    wdDynamicArray<bool> found;
+    found.SetCount(uiNumResources);
+
+    wdUInt32 uiNumFound = 0;
+    for (wdUInt32 uiHash = 0; uiHash < uiNumHashes; ++uiHash)
+    {
+      wdGALTextureHandle hTexture;
+      while (buckets.Pop(uiHash, hTexture))
+      {
+        const wdUInt32 uiIndex = hTexture.GetInternalID().m_InstanceIndex;
+        WD_TEST_BOOL(!found[uiIndex]);
+        found[uiIndex] = true;
+        ++uiNumFound;
+      }
+    }
+
+    WD_TEST_INT(uiNumFound, uiNumResources);
+  }
+}
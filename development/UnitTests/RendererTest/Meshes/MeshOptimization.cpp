@@ -0,0 +1,538 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Meshes/MeshBufferResource.h>
+#include <RendererCore/Meshes/MeshOptimization.h>
+#include <RendererCore/Meshes/MeshResourceDescriptor.h>
+
+// Optimizes a large mesh and reports how long it takes.
+#define WD_MESH_OPTIMIZATION_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+namespace
+{
+  /// Creates a flat grid in the XY plane whose vertices and triangles are stored in random order, which is the worst case for the vertex pipeline.
+  /// One additional vertex is not referenced by any triangle.
+  void CreateShuffledGrid(wdMeshBufferResourceDescriptor& ref_desc, wdUInt32 uiQuadsPerSide, wdUInt64 uiSeed)
+  {
+    const wdUInt32 uiVerticesPerSide = uiQuadsPerSide + 1;
+    const wdUInt32 uiNumGridVertices = uiVerticesPerSide * uiVerticesPerSide;
+    const wdUInt32 uiNumTriangles = uiQuadsPerSide * uiQuadsPerSide * 2;
+
+    wdRandom rnd;
+    rnd.Initialize(uiSeed);
+
+    wdDynamicArray<wdUInt32> vertexOrder;
+    for (wdUInt32 i = 0; i < uiNumGridVertices; ++i)
+    {
+      vertexOrder.PushBack(i);
+    }
+
+    for (wdUInt32 i = uiNumGridVertices - 1; i > 0; --i)
+    {
+      wdMath::Swap(vertexOrder[i], vertexOrder[rnd.UIntInRange(i + 1)]);
+    }
+
+    ref_desc.Clear();
+    ref_desc.AddStream(wdGALVertexAttributeSemantic::Position, wdGALResourceFormat::XYZFloat);
+    ref_desc.AddStream(wdGALVertexAttributeSemantic::TexCoord0, wdGALResourceFormat::UVFloat);
+    ref_desc.AddStream(wdGALVertexAttributeSemantic::Normal, wdGALResourceFormat::XYZFloat);
+    ref_desc.AddStream(wdGALVertexAttributeSemantic::Tangent, wdGALResourceFormat::XYZWFloat);
+    ref_desc.AllocateStreams(uiNumGridVertices + 1, wdGALPrimitiveTopology::Triangles, uiNumTriangles, true);
+
+    for (wdUInt32 y = 0; y < uiVerticesPerSide; ++y)
+    {
+      for (wdUInt32 x = 0; x < uiVerticesPerSide; ++x)
+      {
+        const wdUInt32 v = vertexOrder[y * uiVerticesPerSide + x];
+
+        ref_desc.SetVertexData<wdVec3>(0, v, wdVec3((float)x, (float)y, 0.0f));
+        ref_desc.SetVertexData<wdVec2>(1, v, wdVec2((float)x, (float)y) / (float)uiQuadsPerSide);
+        wdMeshBufferUtils::EncodeNormal(wdVec3(0, 0, 1), ref_desc.GetVertexData(2, v), wdGALResourceFormat::XYZFloat).IgnoreResult();
+        wdMeshBufferUtils::EncodeTangent(wdVec3(1, 0, 0), 1.0f, ref_desc.GetVertexData(3, v), wdGALResourceFormat::XYZWFloat).IgnoreResult();
+      }
+    }
+
+    // the unreferenced vertex
+    ref_desc.SetVertexData<wdVec3>(0, uiNumGridVertices, wdVec3(-1.0f));
+
+    wdDynamicArray<wdUInt32> triangleOrder;
+    for (wdUInt32 i = 0; i < uiNumTriangles; ++i)
+    {
+      triangleOrder.PushBack(i);
+    }
+
+    for (wdUInt32 i = uiNumTriangles - 1; i > 0; --i)
+    {
+      wdMath::Swap(triangleOrder[i], triangleOrder[rnd.UIntInRange(i + 1)]);
+    }
+
+    for (wdUInt32 y = 0; y < uiQuadsPerSide; ++y)
+    {
+      for (wdUInt32 x = 0; x < uiQuadsPerSide; ++x)
+      {
+        const wdUInt32 v00 = vertexOrder[y * uiVerticesPerSide + x];
+        const wdUInt32 v10 = vertexOrder[y * uiVerticesPerSide + x + 1];
+        const wdUInt32 v01 = vertexOrder[(y + 1) * uiVerticesPerSide + x];
+        const wdUInt32 v11 = vertexOrder[(y + 1) * uiVerticesPerSide + x + 1];
+
+        const wdUInt32 uiQuad = y * uiQuadsPerSide + x;
+        ref_desc.SetTriangleIndices(triangleOrder[uiQuad * 2 + 0], v00, v10, v11);
+        ref_desc.SetTriangleIndices(triangleOrder[uiQuad * 2 + 1], v00, v11, v01);
+      }
+    }
+  }
+
+  wdUInt32 GetTriangleIndex(const wdMeshBufferResourceDescriptor& desc, wdUInt32 uiIndex)
+  {
+    if (desc.Uses32BitIndices())
+      return reinterpret_cast<const wdUInt32*>(desc.GetIndexBufferData().GetPtr())[uiIndex];
+
+    return reinterpret_cast<const wdUInt16*>(desc.GetIndexBufferData().GetPtr())[uiIndex];
+  }
+
+  wdVec3 GetTriangleCenter(const wdMeshBufferResourceDescriptor& desc, wdUInt32 uiTriangle)
+  {
+    const wdVec3* pPositions = nullptr;
+    wdUInt32 uiStride = 0;
+    wdMeshBufferUtils::GetPositionStream(desc, pPositions, uiStride).IgnoreResult();
+
+    wdVec3 vCenter = wdVec3::ZeroVector();
+    for (wdUInt32 i = 0; i < 3; ++i)
+    {
+      const wdUInt32 uiVertex = GetTriangleIndex(desc, uiTriangle * 3 + i);
+      vCenter += *wdMemoryUtils::AddByteOffset(pPositions, uiVertex * uiStride);
+    }
+
+    return vCenter / 3.0f;
+  }
+
+  /// The signed area of all triangles projected onto the XY plane. Stays the same as long as no triangle is lost or flipped.
+  float ComputeArea(const wdMeshBufferResourceDescriptor& desc)
+  {
+    const wdVec3* pPositions = nullptr;
+    wdUInt32 uiStride = 0;
+    wdMeshBufferUtils::GetPositionStream(desc, pPositions, uiStride).IgnoreResult();
+
+    float fArea = 0.0f;
+    for (wdUInt32 t = 0; t < desc.GetPrimitiveCount(); ++t)
+    {
+      const wdVec3 a = *wdMemoryUtils::AddByteOffset(pPositions, GetTriangleIndex(desc, t * 3 + 0) * uiStride);
+      const wdVec3 b = *wdMemoryUtils::AddByteOffset(pPositions, GetTriangleIndex(desc, t * 3 + 1) * uiStride);
+      const wdVec3 c = *wdMemoryUtils::AddByteOffset(pPositions, GetTriangleIndex(desc, t * 3 + 2) * uiStride);
+
+      fArea += (b - a).CrossRH(c - a).z * 0.5f;
+    }
+
+    return fArea;
+  }
+
+  /// Turns the flat grid into a wavy surface, so that simplifying it introduces an error.
+  void DisplaceGrid(wdMeshBufferResourceDescriptor& ref_desc)
+  {
+    for (wdUInt32 v = 0; v < ref_desc.GetVertexCount(); ++v)
+    {
+      wdVec3& vPos = *reinterpret_cast<wdVec3*>(ref_desc.GetVertexData(0, v).GetPtr());
+      vPos.z = wdMath::Sin(wdAngle::Radian(vPos.x * 0.2f)) * wdMath::Cos(wdAngle::Radian(vPos.y * 0.3f)) * 2.0f;
+    }
+  }
+
+  void LogStatistics(const char* szName, const wdMeshOptimizationStatistics& stats)
+  {
+    wdLog::Info("[test]{}: ACMR {}, ATVR {}, overdraw {}, vertex fetch {} bytes (overfetch {}), VB {} bytes, IB {} bytes", szName, wdArgF(stats.m_fACMR, 3),
+      wdArgF(stats.m_fATVR, 3), wdArgF(stats.m_fOverdraw, 3), stats.m_uiVertexFetchBytes, wdArgF(stats.m_fVertexFetchOverfetch, 3), stats.m_uiVertexBufferBytes,
+      stats.m_uiIndexBufferBytes);
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST_GROUP(Meshes);
+
+WD_CREATE_SIMPLE_TEST(Meshes, MeshOptimization)
+{
+  constexpr wdUInt32 uiQuadsPerSide = 64;
+  constexpr wdUInt32 uiNumGridVertices = (uiQuadsPerSide + 1) * (uiQuadsPerSide + 1);
+  constexpr wdUInt32 uiNumTriangles = uiQuadsPerSide * uiQuadsPerSide * 2;
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Vertex Cache and Vertex Fetch")
+  {
+    wdMeshBufferResourceDescriptor desc;
+    CreateShuffledGrid(desc, uiQuadsPerSide, 42);
+
+    wdMeshOptimizationStatistics before;
+    WD_TEST_BOOL(wdMeshOptimization::Analyze(desc, before).Succeeded());
+
+    wdMeshOptimizationSettings settings;
+    WD_TEST_BOOL(wdMeshOptimization::Optimize(desc, settings).Succeeded());
+
+    wdMeshOptimizationStatistics after;
+    WD_TEST_BOOL(wdMeshOptimization::Analyze(desc, after).Succeeded());
+
+    LogStatistics("Shuffled grid", before);
+    LogStatistics("Optimized grid", after);
+
+    // the unreferenced vertex is removed, all triangles are kept
+    WD_TEST_INT(desc.GetVertexCount(), uiNumGridVertices);
+    WD_TEST_INT(desc.GetPrimitiveCount(), uiNumTriangles);
+    WD_TEST_FLOAT(ComputeArea(desc), (float)(uiQuadsPerSide * uiQuadsPerSide), 0.01f);
+
+    WD_TEST_BOOL(after.m_fACMR < before.m_fACMR * 0.5f);
+    WD_TEST_BOOL(after.m_fATVR < before.m_fATVR * 0.5f);
+    WD_TEST_BOOL(after.m_uiVertexFetchBytes < before.m_uiVertexFetchBytes);
+    WD_TEST_BOOL(after.m_fVertexFetchOverfetch <= before.m_fVertexFetchOverfetch);
+    WD_TEST_BOOL(after.m_uiVertexBufferBytes < before.m_uiVertexBufferBytes);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Sub-Meshes")
+  {
+    wdMeshResourceDescriptor mesh;
+    CreateShuffledGrid(mesh.MeshBufferDesc(), uiQuadsPerSide, 7);
+
+    // sort the triangles into the left and the right half of the grid
+    {
+      wdMeshBufferResourceDescriptor& desc = mesh.MeshBufferDesc();
+
+      wdDynamicArray<wdUInt32> left;
+      wdDynamicArray<wdUInt32> right;
+      for (wdUInt32 t = 0; t < uiNumTriangles; ++t)
+      {
+        wdDynamicArray<wdUInt32>& target = GetTriangleCenter(desc, t).x < uiQuadsPerSide * 0.5f ? left : right;
+        target.PushBack(GetTriangleIndex(desc, t * 3 + 0));
+        target.PushBack(GetTriangleIndex(desc, t * 3 + 1));
+        target.PushBack(GetTriangleIndex(desc, t * 3 + 2));
+      }
+
+      left.PushBackRange(right);
+      for (wdUInt32 t = 0; t < uiNumTriangles; ++t)
+      {
+        desc.SetTriangleIndices(t, left[t * 3 + 0], left[t * 3 + 1], left[t * 3 + 2]);
+      }
+
+      mesh.AddSubMesh(uiNumTriangles / 2, 0, 0);
+      mesh.AddSubMesh(uiNumTriangles / 2, uiNumTriangles / 2, 1);
+    }
+
+    wdMeshOptimizationSettings settings;
+    WD_TEST_BOOL(wdMeshOptimization::Optimize(mesh, settings).Succeeded());
+
+    const wdMeshBufferResourceDescriptor& desc = mesh.MeshBufferDesc();
+    WD_TEST_INT(desc.GetPrimitiveCount(), uiNumTriangles);
+
+    // triangles must not move between sub-meshes
+    for (wdUInt32 t = 0; t < uiNumTriangles; ++t)
+    {
+      const bool bLeft = GetTriangleCenter(desc, t).x < uiQuadsPerSide * 0.5f;
+      if (bLeft != (t < uiNumTriangles / 2))
+      {
+        WD_TEST_FAILURE("Triangle was moved to another sub-mesh", "Triangle {}", t);
+        break;
+      }
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Quantization")
+  {
+    wdMeshBufferResourceDescriptor desc;
+    CreateShuffledGrid(desc, uiQuadsPerSide, 42);
+
+    wdMeshOptimizationSettings settings;
+    settings.m_bQuantizeStreams = true;
+    settings.m_NormalPrecision = wdMeshNormalPrecision::_10Bit;
+    settings.m_TexCoordPrecision = wdMeshTexCoordPrecision::_16Bit;
+    WD_TEST_BOOL(wdMeshOptimization::Optimize(desc, settings).Succeeded());
+
+    const auto& streams = desc.GetVertexDeclaration().m_VertexStreams;
+    if (WD_TEST_INT(streams.GetCount(), 4))
+    {
+      WD_TEST_BOOL(streams[0].m_Format == wdGALResourceFormat::XYZFloat);
+      WD_TEST_BOOL(streams[1].m_Format == wdGALResourceFormat::UVHalf);
+      WD_TEST_BOOL(streams[2].m_Format == wdGALResourceFormat::RGB10A2UIntNormalized);
+      WD_TEST_BOOL(streams[3].m_Format == wdGALResourceFormat::RGB10A2UIntNormalized);
+    }
+
+    WD_TEST_INT(desc.GetVertexDataSize(), 12 + 4 + 4 + 4);
+
+    for (wdUInt32 v = 0; v < desc.GetVertexCount(); ++v)
+    {
+      wdVec3 vNormal;
+      wdVec3 vTangent;
+      float fBiTangentSign;
+      WD_TEST_BOOL(wdMeshBufferUtils::DecodeNormal(desc.GetVertexData(2, v), streams[2].m_Format, vNormal).Succeeded());
+      WD_TEST_BOOL(wdMeshBufferUtils::DecodeTangent(desc.GetVertexData(3, v), streams[3].m_Format, vTangent, fBiTangentSign).Succeeded());
+      WD_TEST_VEC3(vNormal, wdVec3(0, 0, 1), 0.01f);
+      WD_TEST_VEC3(vTangent, wdVec3(1, 0, 0), 0.01f);
+      WD_TEST_FLOAT(fBiTangentSign, 1.0f, 0.01f);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Meshlets")
+  {
+    wdMeshBufferResourceDescriptor desc;
+    CreateShuffledGrid(desc, uiQuadsPerSide, 42);
+
+    wdMeshOptimizationSettings settings;
+    settings.m_bGenerateMeshlets = true;
+    settings.m_uiMaxMeshletVertices = 64;
+    settings.m_uiMaxMeshletTriangles = 124;
+
+    wdMeshletData meshlets;
+    WD_TEST_BOOL(wdMeshOptimization::Optimize(desc, settings, &meshlets).Succeeded());
+    WD_TEST_BOOL(!meshlets.m_Meshlets.IsEmpty());
+
+    wdUInt32 uiNumMeshletTriangles = 0;
+    for (const wdMeshlet& meshlet : meshlets.m_Meshlets)
+    {
+      WD_TEST_BOOL(meshlet.m_uiVertexCount <= 64);
+      WD_TEST_BOOL(meshlet.m_uiTriangleCount <= 124);
+      WD_TEST_INT(meshlet.m_uiSubMeshIndex, 0);
+      WD_TEST_BOOL(meshlet.m_uiFirstVertex + meshlet.m_uiVertexCount <= meshlets.m_Vertices.GetCount());
+      WD_TEST_BOOL((meshlet.m_uiFirstTriangle + meshlet.m_uiTriangleCount) * 3 <= meshlets.m_Triangles.GetCount());
+
+      for (wdUInt32 i = 0; i < meshlet.m_uiTriangleCount * 3u; ++i)
+      {
+        WD_TEST_BOOL(meshlets.m_Triangles[meshlet.m_uiFirstTriangle * 3 + i] < meshlet.m_uiVertexCount);
+      }
+
+      uiNumMeshletTriangles += meshlet.m_uiTriangleCount;
+    }
+
+    WD_TEST_INT(uiNumMeshletTriangles, uiNumTriangles);
+
+    for (wdUInt32 uiVertex : meshlets.m_Vertices)
+    {
+      WD_TEST_BOOL(uiVertex < desc.GetVertexCount());
+    }
+  }
+
+  WD_TEST_BLOCK(WD_MESH_OPTIMIZATION_PERFORMANCE_TESTS_STATE, "Large Mesh")
+  {
+    // more than 64k vertices, so 32 bit indices are used
+    wdMeshBufferResourceDescriptor desc;
+    CreateShuffledGrid(desc, 300, 42);
+
+    wdMeshOptimizationStatistics before;
+    WD_TEST_BOOL(wdMeshOptimization::Analyze(desc, before).Succeeded());
+
+    wdMeshOptimizationSettings settings;
+    settings.m_bQuantizeStreams = true;
+
+    wdStopwatch sw;
+    WD_TEST_BOOL(wdMeshOptimization::Optimize(desc, settings).Succeeded());
+    const wdTime tOptimize = sw.GetRunningTotal();
+
+    wdMeshOptimizationStatistics after;
+    WD_TEST_BOOL(wdMeshOptimization::Analyze(desc, after).Succeeded());
+
+    LogStatistics("Shuffled large grid", before);
+    LogStatistics("Optimized large grid", after);
+    wdLog::Info("[test]Optimizing {} triangles took {}ms", desc.GetPrimitiveCount(), wdArgF(tOptimize.GetMilliseconds(), 1));
+  }
+}
+
+WD_CREATE_SIMPLE_TEST(Meshes, MeshLod)
+{
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "SelectLod")
+  {
+    wdMeshResourceDescriptor desc;
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.1f, wdInvalidIndex, 0.1f), 0);
+
+    desc.AddLod(0, 1, 0.5f);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.1f, wdInvalidIndex, 0.1f), 0);
+
+    desc.AddLod(1, 1, 0.2f);
+    desc.AddLod(2, 1, 0.0f);
+    WD_TEST_INT(desc.GetLods().GetCount(), 3);
+
+    // without a previous LOD, the thresholds are used as is
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 1.0f, wdInvalidIndex, 0.1f), 0);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.5f, wdInvalidIndex, 0.1f), 0);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.3f, wdInvalidIndex, 0.1f), 1);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.1f, wdInvalidIndex, 0.1f), 2);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.0f, wdInvalidIndex, 0.1f), 2);
+
+    // hysteresis keeps the current LOD close to the thresholds
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.52f, 1, 0.1f), 1);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.56f, 1, 0.1f), 0);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.48f, 0, 0.1f), 0);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.44f, 0, 0.1f), 1);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.19f, 1, 0.1f), 1);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.17f, 1, 0.1f), 2);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.21f, 2, 0.1f), 2);
+    WD_TEST_INT(wdMeshResourceDescriptor::SelectLod(desc.GetLods(), 0.6f, 2, 0.1f), 0);
+
+    desc.Clear();
+    WD_TEST_BOOL(desc.GetLods().IsEmpty());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "GenerateLods")
+  {
+    constexpr wdUInt32 uiQuadsPerSide = 64;
+
+    wdMeshResourceDescriptor desc;
+    CreateShuffledGrid(desc.MeshBufferDesc(), uiQuadsPerSide, 42);
+    DisplaceGrid(desc.MeshBufferDesc());
+
+    const wdUInt32 uiNumTriangles = desc.MeshBufferDesc().GetPrimitiveCount();
+
+    // sort the triangles into a left and a right half, one sub-mesh each
+    {
+      wdDynamicArray<wdUInt32> left, right;
+      for (wdUInt32 t = 0; t < uiNumTriangles; ++t)
+      {
+        auto& target = GetTriangleCenter(desc.MeshBufferDesc(), t).x < uiQuadsPerSide * 0.5f ? left : right;
+        for (wdUInt32 i = 0; i < 3; ++i)
+        {
+          target.PushBack(GetTriangleIndex(desc.MeshBufferDesc(), t * 3 + i));
+        }
+      }
+
+      left.PushBackRange(right);
+      for (wdUInt32 t = 0; t < uiNumTriangles; ++t)
+      {
+        desc.MeshBufferDesc().SetTriangleIndices(t, left[t * 3 + 0], left[t * 3 + 1], left[t * 3 + 2]);
+      }
+    }
+
+    desc.SetMaterial(0, "A");
+    desc.SetMaterial(1, "B");
+    desc.AddSubMesh(uiNumTriangles / 2, 0, 0);
+    desc.AddSubMesh(uiNumTriangles / 2, uiNumTriangles / 2, 1);
+
+    wdMeshLodSettings settings;
+    WD_TEST_BOOL(wdMeshOptimization::GenerateLods(desc, settings).Succeeded());
+
+    const wdMeshBufferResourceDescriptor& meshBuffer = desc.MeshBufferDesc();
+    auto lods = desc.GetLods();
+    auto subMeshes = desc.GetSubMeshes();
+
+    WD_TEST_BOOL(lods.GetCount() > 1 && lods.GetCount() <= settings.m_uiMaxLods);
+    WD_TEST_INT(lods[0].m_uiFirstSubMesh, 0);
+    WD_TEST_INT(lods[0].m_uiSubMeshCount, 2);
+    WD_TEST_FLOAT(lods[lods.GetCount() - 1].m_fMinScreenSize, 0.0f, 0.0f);
+
+    wdUInt32 uiPrevTriangles = wdMath::MaxValue<wdUInt32>();
+    wdUInt32 uiNextSubMesh = 0;
+
+    for (wdUInt32 uiLod = 0; uiLod < lods.GetCount(); ++uiLod)
+    {
+      const auto& lod = lods[uiLod];
+
+      WD_TEST_INT(lod.m_uiFirstSubMesh, uiNextSubMesh);
+      WD_TEST_BOOL(lod.m_uiSubMeshCount > 0);
+      uiNextSubMesh = lod.m_uiFirstSubMesh + lod.m_uiSubMeshCount;
+
+      if (uiLod > 0)
+      {
+        WD_TEST_BOOL(lod.m_fMinScreenSize < lods[uiLod - 1].m_fMinScreenSize);
+      }
+
+      wdUInt32 uiTriangles = 0;
+      for (wdUInt32 i = lod.m_uiFirstSubMesh; i < uiNextSubMesh; ++i)
+      {
+        const auto& subMesh = subMeshes[i];
+        WD_TEST_BOOL(subMesh.m_uiFirstPrimitive + subMesh.m_uiPrimitiveCount <= meshBuffer.GetPrimitiveCount());
+        WD_TEST_BOOL(subMesh.m_uiMaterialIndex < 2);
+
+        uiTriangles += subMesh.m_uiPrimitiveCount;
+      }
+
+      WD_TEST_BOOL(uiTriangles <= uiPrevTriangles * settings.m_fMinReduction);
+      uiPrevTriangles = uiTriangles;
+
+      wdLog::Info("[test]LOD {}: {} triangles, min screen size {}", uiLod, uiTriangles, wdArgF(lod.m_fMinScreenSize, 4));
+    }
+
+    WD_TEST_INT(uiNextSubMesh, subMeshes.GetCount());
+
+    // all LODs share the vertex buffer
+    for (wdUInt32 i = 0; i < meshBuffer.GetPrimitiveCount() * 3; ++i)
+    {
+      WD_TEST_BOOL(GetTriangleIndex(meshBuffer, i) < meshBuffer.GetVertexCount());
+    }
+
+    // CollapseSubMeshes() keeps the most detailed LOD only
+    {
+      wdMeshResourceDescriptor collapsed;
+      collapsed.MeshBufferDesc() = meshBuffer;
+      collapsed.SetMaterial(0, "A");
+      collapsed.SetMaterial(1, "B");
+      for (const auto& subMesh : subMeshes)
+      {
+        collapsed.AddSubMesh(subMesh.m_uiPrimitiveCount, subMesh.m_uiFirstPrimitive, subMesh.m_uiMaterialIndex);
+      }
+      for (const auto& lod : lods)
+      {
+        collapsed.AddLod(lod.m_uiFirstSubMesh, lod.m_uiSubMeshCount, lod.m_fMinScreenSize);
+      }
+
+      collapsed.CollapseSubMeshes();
+      WD_TEST_BOOL(collapsed.GetLods().IsEmpty());
+      WD_TEST_INT(collapsed.GetSubMeshes().GetCount(), 1);
+      WD_TEST_INT(collapsed.GetSubMeshes()[0].m_uiPrimitiveCount, uiNumTriangles);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Save and Load")
+  {
+    wdMeshResourceDescriptor desc;
+    CreateShuffledGrid(desc.MeshBufferDesc(), 16, 42);
+    DisplaceGrid(desc.MeshBufferDesc());
+    desc.SetMaterial(0, "A");
+
+    WD_TEST_BOOL(wdMeshOptimization::GenerateLods(desc, wdMeshLodSettings()).Succeeded());
+
+    wdDefaultMemoryStreamStorage storage;
+    wdMemoryStreamWriter writer(&storage);
+    desc.Save(writer);
+
+    wdMeshResourceDescriptor loaded;
+    wdMemoryStreamReader reader(&storage);
+    WD_TEST_BOOL(loaded.Load(reader).Succeeded());
+
+    if (WD_TEST_INT(loaded.GetLods().GetCount(), desc.GetLods().GetCount()))
+    {
+      for (wdUInt32 i = 0; i < desc.GetLods().GetCount(); ++i)
+      {
+        WD_TEST_INT(loaded.GetLods()[i].m_uiFirstSubMesh, desc.GetLods()[i].m_uiFirstSubMesh);
+        WD_TEST_INT(loaded.GetLods()[i].m_uiSubMeshCount, desc.GetLods()[i].m_uiSubMeshCount);
+        WD_TEST_FLOAT(loaded.GetLods()[i].m_fMinScreenSize, desc.GetLods()[i].m_fMinScreenSize, 0.0f);
+      }
+    }
+
+    WD_TEST_INT(loaded.GetSubMeshes().GetCount(), desc.GetSubMeshes().GetCount());
+    WD_TEST_INT(loaded.MeshBufferDesc().GetPrimitiveCount(), desc.MeshBufferDesc().GetPrimitiveCount());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Load Invalid LODs")
+  {
+    wdMeshResourceDescriptor desc;
+    CreateShuffledGrid(desc.MeshBufferDesc(), 4, 42);
+    desc.SetMaterial(0, "A");
+    desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
+    desc.AddLod(0, 1, 0.5f);
+    desc.AddLod(1, 1, 0.0f);
+
+    wdDefaultMemoryStreamStorage storage;
+    wdMemoryStreamWriter writer(&storage);
+    desc.Save(writer);
+
+    // the second LOD references a sub-mesh that doesn't exist
+    wdMeshResourceDescriptor loaded;
+    wdMemoryStreamReader reader(&storage);
+    WD_TEST_BOOL(loaded.Load(reader).Succeeded());
+    WD_TEST_INT(loaded.GetSubMeshes().GetCount(), 1);
+    WD_TEST_BOOL(loaded.GetLods().IsEmpty());
+
+    // more LODs than sub-meshes are rejected before they are allocated
+    desc.AddLod(0, 1, 0.0f);
+
+    wdDefaultMemoryStreamStorage storage2;
+    wdMemoryStreamWriter writer2(&storage2);
+    desc.Save(writer2);
+
+    wdMeshResourceDescriptor loaded2;
+    wdMemoryStreamReader reader2(&storage2);
+    WD_TEST_BOOL(loaded2.Load(reader2).Succeeded());
+    WD_TEST_BOOL(loaded2.GetLods().IsEmpty());
+  }
+}
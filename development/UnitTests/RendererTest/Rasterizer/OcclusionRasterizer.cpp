@@ -0,0 +1,182 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Color8UNorm.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Time.h>
+#include <RendererCore/Rasterizer/RasterizerObject.h>
+#include <RendererCore/Rasterizer/RasterizerView.h>
+
+// Enable when needed
+#define WD_OCCLUSION_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+WD_CREATE_SIMPLE_TEST_GROUP(Performance);
+
+#if WD_ENABLED(WD_RASTERIZER_SUPPORTED)
+
+namespace
+{
+  constexpr wdUInt32 s_uiOcclusionResolution = 512;
+  constexpr wdUInt32 s_uiNumOccluders = 256;
+  constexpr wdUInt32 s_uiNumQueries = 1024 * 16;
+  constexpr wdUInt32 s_uiNumOcclusionIterations = 20;
+
+  struct OccluderInstance
+  {
+    wdSharedPtr<const wdRasterizerObject> m_pObject;
+    wdTransform m_Transform;
+  };
+
+  void RasterizeOccluders(wdRasterizerView& ref_view, const wdDynamicArray<OccluderInstance>& occluders)
+  {
+    ref_view.BeginScene();
+
+    for (const OccluderInstance& occluder : occluders)
+    {
+      ref_view.AddObject(occluder.m_pObject.Borrow(), occluder.m_Transform);
+    }
+
+    ref_view.EndScene();
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(Performance, OcclusionRasterizer)
+{
+  const wdUInt32 uiMaxWorkers = wdMath::Max<wdUInt32>(wdSystemInformation::Get().GetCPUCoreCount(), 1);
+
+  // a city-like field of boxes in front of the camera, walls close by and a lot of smaller objects farther away
+  wdCamera camera;
+  camera.LookAt(wdVec3(0, 0, 2), wdVec3(1, 0, 2), wdVec3(0, 0, 1));
+  camera.SetCameraMode(wdCameraMode::PerspectiveFixedFovX, 90.0f, 0.1f, 1000.0f);
+
+  wdRandom rng;
+  rng.Initialize(42);
+
+  wdDynamicArray<OccluderInstance> occluders;
+
+  for (wdUInt32 i = 0; i < s_uiNumOccluders; ++i)
+  {
+    // only a few different sizes, the rasterizer objects are shared between all boxes of the same size
+    const wdVec3 vExtents(1.0f + rng.UIntInRange(4) * 2.0f, 1.0f + rng.UIntInRange(8) * 2.0f, 2.0f + rng.UIntInRange(4) * 4.0f);
+    const float fDistance = (float)rng.DoubleMinMax(5.0, 150.0);
+
+    OccluderInstance& occluder = occluders.ExpandAndGetRef();
+    occluder.m_pObject = wdRasterizerObject::CreateBox(vExtents);
+    occluder.m_Transform.SetIdentity();
+    occluder.m_Transform.m_vPosition.Set(fDistance, (float)rng.DoubleMinMax(-fDistance, fDistance), vExtents.z * 0.5f);
+  }
+
+  wdDynamicArray<wdSimdBBox, wdAlignedAllocatorWrapper> queries;
+  queries.SetCount(s_uiNumQueries);
+
+  for (wdSimdBBox& box : queries)
+  {
+    const float fDistance = (float)rng.DoubleMinMax(5.0, 200.0);
+    const wdVec3 vCenter(fDistance, (float)rng.DoubleMinMax(-fDistance, fDistance), (float)rng.DoubleMinMax(0.0, 10.0));
+    const wdVec3 vHalfExtents((float)rng.DoubleMinMax(0.25, 2.0));
+
+    box.SetCenterAndHalfExtents(wdSimdConversion::ToVec3(vCenter), wdSimdConversion::ToVec3(vHalfExtents));
+  }
+
+  wdRasterizerView view;
+  view.SetResolution(s_uiOcclusionResolution, s_uiOcclusionResolution, 1.0f);
+  view.SetCamera(&camera);
+
+  WD_TEST_BLOCK(WD_OCCLUSION_PERFORMANCE_TESTS_STATE, "Rasterize Scene")
+  {
+    wdDynamicArray<wdColorLinearUB> reference;
+    wdDynamicArray<wdColorLinearUB> frame;
+    frame.SetCountUninitialized(s_uiOcclusionResolution * s_uiOcclusionResolution);
+
+    const wdUInt32 uiPrevShortWorkers = wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::ShortTasks);
+    const wdUInt32 uiPrevLongWorkers = wdTaskSystem::GetWorkerThreadCount(wdWorkerThreadType::LongTasks);
+
+    for (wdUInt32 uiWorkers = 1; uiWorkers <= uiMaxWorkers; uiWorkers *= 2)
+    {
+      wdTaskSystem::SetWorkerThreadCount(uiWorkers, 2);
+
+      const wdTime tStart = wdTime::Now();
+
+      for (wdUInt32 uiIteration = 0; uiIteration < s_uiNumOcclusionIterations; ++uiIteration)
+      {
+        RasterizeOccluders(view, occluders);
+      }
+
+      const wdTime tDiff = wdTime::Now() - tStart;
+
+      wdLog::Info("[test]Occlusion Rasterization ({0} short task workers): {1}ms", uiWorkers,
+        wdArgF(tDiff.GetMilliseconds() / s_uiNumOcclusionIterations, 3));
+
+      view.ReadBackFrame(frame);
+
+      if (reference.IsEmpty())
+      {
+        reference = frame;
+      }
+      else
+      {
+        // tiles must not influence each other, so the result has to be the same for any number of threads
+        WD_TEST_BOOL(frame == reference);
+      }
+    }
+
+    // restore the previous configuration
+    wdTaskSystem::SetWorkerThreadCount(uiPrevShortWorkers, uiPrevLongWorkers);
+  }
+
+  WD_TEST_BLOCK(WD_OCCLUSION_PERFORMANCE_TESTS_STATE, "Visibility Queries")
+  {
+    RasterizeOccluders(view, occluders);
+
+    if (!WD_TEST_BOOL(view.HasRasterizedAnyOccluders()))
+      return;
+
+    wdDynamicArray<bool> visibleSingle;
+    visibleSingle.SetCountUninitialized(s_uiNumQueries);
+
+    wdDynamicArray<bool> visibleBatched;
+    visibleBatched.SetCountUninitialized(s_uiNumQueries);
+
+    wdUInt32 uiNumVisible = 0;
+
+    {
+      const wdTime tStart = wdTime::Now();
+
+      for (wdUInt32 uiIteration = 0; uiIteration < s_uiNumOcclusionIterations; ++uiIteration)
+      {
+        for (wdUInt32 i = 0; i < s_uiNumQueries; ++i)
+        {
+          visibleSingle[i] = view.IsVisible(queries[i]);
+        }
+      }
+
+      const wdTime tDiff = wdTime::Now() - tStart;
+
+      wdLog::Info("[test]Occlusion IsVisible, {0} single queries: {1}ms", s_uiNumQueries,
+        wdArgF(tDiff.GetMilliseconds() / s_uiNumOcclusionIterations, 3));
+    }
+
+    {
+      const wdTime tStart = wdTime::Now();
+
+      for (wdUInt32 uiIteration = 0; uiIteration < s_uiNumOcclusionIterations; ++uiIteration)
+      {
+        uiNumVisible = view.IsVisible(queries.GetArrayPtr(), visibleBatched.GetArrayPtr());
+      }
+
+      const wdTime tDiff = wdTime::Now() - tStart;
+
+      wdLog::Info("[test]Occlusion IsVisible, {0} batched queries: {1}ms ({2} visible)", s_uiNumQueries,
+        wdArgF(tDiff.GetMilliseconds() / s_uiNumOcclusionIterations, 3), uiNumVisible);
+    }
+
+    WD_TEST_BOOL(visibleSingle == visibleBatched);
+  }
+}
+
+#endif
@@ -0,0 +1 @@
+#include <RendererTest/RendererTestPCH.h>
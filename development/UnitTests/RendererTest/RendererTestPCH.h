@@ -0,0 +1,8 @@
+#include <TestFramework/Framework/TestFramework.h>
+#include <TestFramework/Utilities/ConstructionCounter.h>
+
+#include <Foundation/Basics.h>
+#include <Foundation/Basics/Assert.h>
+#include <Foundation/Types/Types.h>
+
+#include <Foundation/Math/Declarations.h>
@@ -0,0 +1,341 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/ResourceManager/Implementation/ResourceLoadingQueue.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Types/UniquePtr.h>
+#include <Foundation/Utilities/Stats.h>
+
+WD_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
+
+class wdLoadingQueueTestResource : public wdResource
+{
+  WD_ADD_DYNAMIC_REFLECTION(wdLoadingQueueTestResource, wdResource);
+
+public:
+  wdLoadingQueueTestResource()
+    : wdResource(DoUpdate::OnAnyThread, 1)
+  {
+  }
+
+  ~wdLoadingQueueTestResource() = default;
+
+private:
+  virtual wdResourceLoadDesc UnloadData(Unload WhatToUnload) override { return wdResourceLoadDesc(); }
+  virtual wdResourceLoadDesc UpdateContent(wdStreamReader* pStream) override { return wdResourceLoadDesc(); }
+  virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override {}
+  virtual bool HasResourceTypeLoadingFallback() const override { return false; }
+};
+
+// clang-format off
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdLoadingQueueTestResource, 1, wdRTTINoAllocator)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+/// Only used to have a second resource type, which has no budget.
+class wdLoadingQueueTestResource2 : public wdLoadingQueueTestResource
+{
+  WD_ADD_DYNAMIC_REFLECTION(wdLoadingQueueTestResource2, wdLoadingQueueTestResource);
+};
+
+// clang-format off
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdLoadingQueueTestResource2, 1, wdRTTINoAllocator)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  /// \brief Brute force version of wdResourceLoadingQueue without budgets, every Pop searches all entries.
+  class ReferenceLoadingQueue
+  {
+  public:
+    void Push(wdResource* pResource, float fPriority, bool bFirstInLine)
+    {
+      Entry& entry = m_Entries.ExpandAndGetRef();
+      entry.m_pResource = pResource;
+      entry.m_fPriority = fPriority;
+      entry.m_iSequence = bFirstInLine ? m_iNextFirstInLineSequence-- : m_iNextSequence++;
+    }
+
+    bool Remove(wdResource* pResource)
+    {
+      const wdUInt32 uiIndex = Find(pResource);
+      if (uiIndex == wdInvalidIndex)
+        return false;
+
+      m_Entries.RemoveAtAndSwap(uiIndex);
+      return true;
+    }
+
+    void UpdatePriority(wdResource* pResource, float fPriority) { m_Entries[Find(pResource)].m_fPriority = fPriority; }
+
+    wdResource* Pop()
+    {
+      if (m_Entries.IsEmpty())
+        return nullptr;
+
+      wdUInt32 uiBest = 0;
+      for (wdUInt32 i = 1; i < m_Entries.GetCount(); ++i)
+      {
+        const Entry& entry = m_Entries[i];
+        const Entry& best = m_Entries[uiBest];
+
+        if (entry.m_fPriority < best.m_fPriority || (entry.m_fPriority == best.m_fPriority && entry.m_iSequence < best.m_iSequence))
+        {
+          uiBest = i;
+        }
+      }
+
+      wdResource* pResource = m_Entries[uiBest].m_pResource;
+      m_Entries.RemoveAtAndSwap(uiBest);
+      return pResource;
+    }
+
+    bool Contains(const wdResource* pResource) const { return Find(pResource) != wdInvalidIndex; }
+    wdUInt32 GetCount() const { return m_Entries.GetCount(); }
+
+  private:
+    struct Entry
+    {
+      WD_DECLARE_POD_TYPE();
+
+      wdResource* m_pResource;
+      float m_fPriority;
+      wdInt64 m_iSequence;
+    };
+
+    wdUInt32 Find(const wdResource* pResource) const
+    {
+      for (wdUInt32 i = 0; i < m_Entries.GetCount(); ++i)
+      {
+        if (m_Entries[i].m_pResource == pResource)
+          return i;
+      }
+
+      return wdInvalidIndex;
+    }
+
+    wdDynamicArray<Entry> m_Entries;
+    wdInt64 m_iNextSequence = 0;
+    wdInt64 m_iNextFirstInLineSequence = -1;
+  };
+
+  template <typename ResourceType>
+  void CreateLoadingQueueTestResources(wdUInt32 uiCount, wdDynamicArray<wdUniquePtr<wdLoadingQueueTestResource>>& out_resources)
+  {
+    for (wdUInt32 i = 0; i < uiCount; ++i)
+    {
+      out_resources.PushBack(WD_DEFAULT_NEW(ResourceType));
+    }
+  }
+
+  template <typename T>
+  T GetLoadingQueueStat(const char* szName)
+  {
+    return wdStats::GetStat(szName).ConvertTo<T>();
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(ResourceManager, ResourceLoadingQueue)
+{
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Push / Remove / UpdatePriority")
+  {
+    wdDynamicArray<wdUniquePtr<wdLoadingQueueTestResource>> resources;
+    CreateLoadingQueueTestResources<wdLoadingQueueTestResource>(9, resources);
+
+    wdResourceLoadingQueue queue;
+    WD_TEST_BOOL(queue.IsEmpty());
+    WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == nullptr);
+
+    for (wdUInt32 i = 0; i < 8; ++i)
+    {
+      queue.Push(resources[i].Borrow(), (float)i, false, wdTime::Zero());
+    }
+
+    // same priority as resources[4], but taken before it
+    queue.Push(resources[8].Borrow(), 4.0f, true, wdTime::Zero());
+
+    WD_TEST_INT(queue.GetCount(), 9);
+    WD_TEST_BOOL(queue.Contains(resources[3].Borrow()));
+
+    // from the middle of the heap
+    WD_TEST_BOOL(queue.Remove(resources[3].Borrow()));
+    WD_TEST_BOOL(!queue.Contains(resources[3].Borrow()));
+    WD_TEST_BOOL(!queue.Remove(resources[3].Borrow()));
+    WD_TEST_INT(queue.GetCount(), 8);
+
+    queue.UpdatePriority(resources[7].Borrow(), -1.0f);
+    queue.UpdatePriority(resources[0].Borrow(), 10.0f);
+
+    const wdUInt32 expectedOrder[] = {7, 1, 2, 8, 4, 5, 6, 0};
+    for (wdUInt32 uiExpected : expectedOrder)
+    {
+      WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == resources[uiExpected].Borrow());
+      WD_TEST_BOOL(!queue.Contains(resources[uiExpected].Borrow()));
+    }
+
+    WD_TEST_BOOL(queue.IsEmpty());
+    WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == nullptr);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Compare With Reference")
+  {
+    constexpr wdUInt32 uiNumResources = 64;
+
+    wdDynamicArray<wdUniquePtr<wdLoadingQueueTestResource>> resources;
+    CreateLoadingQueueTestResources<wdLoadingQueueTestResource>(uiNumResources, resources);
+
+    wdResourceLoadingQueue queue;
+    ReferenceLoadingQueue reference;
+
+    wdRandom rng;
+    rng.Initialize(42);
+
+    // only counts the mismatches, to not report thousands of test results
+    wdUInt32 uiNumMismatches = 0;
+
+    for (wdUInt32 uiStep = 0; uiStep < 10000; ++uiStep)
+    {
+      wdResource* pResource = resources[rng.UIntInRange(uiNumResources)].Borrow();
+
+      // few distinct priorities, so that the queue order often decides
+      const float fPriority = (float)rng.IntMinMax(0, 15);
+
+      switch (rng.UIntInRange(4))
+      {
+        case 0:
+          if (!reference.Contains(pResource))
+          {
+            const bool bFirstInLine = rng.UIntInRange(8) == 0;
+            queue.Push(pResource, fPriority, bFirstInLine, wdTime::Zero());
+            reference.Push(pResource, fPriority, bFirstInLine);
+          }
+          break;
+
+        case 1:
+          uiNumMismatches += (queue.Remove(pResource) != reference.Remove(pResource)) ? 1 : 0;
+          break;
+
+        case 2:
+          // moves the resource up or down, depending on its old priority
+          if (reference.Contains(pResource))
+          {
+            queue.UpdatePriority(pResource, fPriority);
+            reference.UpdatePriority(pResource, fPriority);
+          }
+          break;
+
+        case 3:
+          uiNumMismatches += (queue.Pop(wdTime::Zero()) != reference.Pop()) ? 1 : 0;
+          break;
+      }
+
+      uiNumMismatches += (queue.GetCount() != reference.GetCount()) ? 1 : 0;
+      uiNumMismatches += (queue.GetHeapCount() != reference.GetCount()) ? 1 : 0;
+
+      for (const auto& pTestResource : resources)
+      {
+        uiNumMismatches += (queue.Contains(pTestResource.Borrow()) != reference.Contains(pTestResource.Borrow())) ? 1 : 0;
+      }
+    }
+
+    WD_TEST_INT(uiNumMismatches, 0);
+
+    while (!queue.IsEmpty())
+    {
+      WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == reference.Pop());
+    }
+
+    WD_TEST_INT(reference.GetCount(), 0);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Pop With Budget")
+  {
+    wdDynamicArray<wdUniquePtr<wdLoadingQueueTestResource>> resources;
+    CreateLoadingQueueTestResources<wdLoadingQueueTestResource>(5, resources);
+    CreateLoadingQueueTestResources<wdLoadingQueueTestResource2>(3, resources);
+
+    wdResourceLoadingQueue queue;
+    queue.SetTypeBudget(wdGetStaticRTTI<wdLoadingQueueTestResource>(), 2);
+
+    // budgeted type at priorities 0 to 4, the other type at 0.5, 1.5 and 2.5
+    for (wdUInt32 i = 0; i < 5; ++i)
+    {
+      queue.Push(resources[i].Borrow(), (float)i, false, wdTime::Zero());
+    }
+
+    for (wdUInt32 i = 0; i < 3; ++i)
+    {
+      queue.Push(resources[5 + i].Borrow(), i + 0.5f, false, wdTime::Zero());
+    }
+
+    const wdUInt32 expectedOrder[] = {0, 5, 1, 6, 7};
+    for (wdUInt32 uiExpected : expectedOrder)
+    {
+      WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == resources[uiExpected].Borrow());
+    }
+
+    // resources 2 to 4 are over budget, but still queued
+    WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == nullptr);
+    WD_TEST_INT(queue.GetCount(), 3);
+    WD_TEST_INT(queue.GetHeapCount(), 0);
+    WD_TEST_BOOL(queue.Contains(resources[2].Borrow()));
+
+    queue.UpdateStats();
+    WD_TEST_INT(GetLoadingQueueStat<wdUInt32>("ResourceManager/Loading Queue/Queued"), 3);
+    WD_TEST_INT(GetLoadingQueueStat<wdUInt32>("ResourceManager/Loading Queue/Over Budget"), 3);
+
+    queue.UpdatePriority(resources[4].Borrow(), -1.0f);
+    WD_TEST_BOOL(queue.Remove(resources[3].Borrow()));
+    WD_TEST_INT(queue.GetCount(), 2);
+
+    WD_TEST_BOOL(queue.StartNewFrame());
+    WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == resources[4].Borrow());
+    WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == resources[2].Borrow());
+    WD_TEST_BOOL(queue.IsEmpty());
+    WD_TEST_BOOL(!queue.StartNewFrame());
+
+    // resources that are queued first in line ignore the budget
+    for (wdUInt32 i = 0; i < 3; ++i)
+    {
+      queue.Push(resources[i].Borrow(), 0.0f, true, wdTime::Zero());
+    }
+
+    for (wdUInt32 i = 0; i < 3; ++i)
+    {
+      WD_TEST_BOOL(queue.Pop(wdTime::Zero()) == resources[2 - i].Borrow());
+    }
+
+    WD_TEST_BOOL(queue.IsEmpty());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Statistics")
+  {
+    wdDynamicArray<wdUniquePtr<wdLoadingQueueTestResource>> resources;
+    CreateLoadingQueueTestResources<wdLoadingQueueTestResource>(110, resources);
+
+    wdResourceLoadingQueue queue;
+
+    for (wdUInt32 i = 0; i < resources.GetCount(); ++i)
+    {
+      queue.Push(resources[i].Borrow(), (float)i, false, wdTime::Zero());
+    }
+
+    // the n-th resource spends n milliseconds in the queue
+    for (wdUInt32 i = 1; i <= 100; ++i)
+    {
+      WD_TEST_BOOL(queue.Pop(wdTime::Milliseconds(i)) == resources[i - 1].Borrow());
+    }
+
+    queue.UpdateStats();
+
+    WD_TEST_INT(GetLoadingQueueStat<wdUInt32>("ResourceManager/Loading Queue/Queued"), 10);
+    WD_TEST_INT(GetLoadingQueueStat<wdUInt32>("ResourceManager/Loading Queue/Over Budget"), 0);
+    WD_TEST_FLOAT(GetLoadingQueueStat<float>("ResourceManager/Loading Queue/Time In Queue P50 (ms)"), 50.0f, 0.001f);
+    WD_TEST_FLOAT(GetLoadingQueueStat<float>("ResourceManager/Loading Queue/Time In Queue P90 (ms)"), 90.0f, 0.001f);
+    WD_TEST_FLOAT(GetLoadingQueueStat<float>("ResourceManager/Loading Queue/Time In Queue P99 (ms)"), 99.0f, 0.001f);
+
+    queue.Clear();
+    WD_TEST_BOOL(queue.IsEmpty());
+    WD_TEST_BOOL(!queue.Contains(resources[100].Borrow()));
+  }
+}
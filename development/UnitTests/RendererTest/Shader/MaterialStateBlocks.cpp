@@ -0,0 +1,197 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <RendererCore/GPUResourcePool/GPUResourcePool.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/RenderContext/RenderContext.h>
+#include <RendererCore/Shader/ShaderPermutationResource.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererFoundation/Device/Pass.h>
+#include <RendererFoundation/Null/DeviceNull.h>
+
+namespace
+{
+  wdMaterialResourceHandle CreateStateBlockTestMaterial(const char* szName, const wdShaderResourceHandle& hShader)
+  {
+    wdMaterialResourceDescriptor desc;
+    desc.m_hShader = hShader;
+
+    return wdResourceManager::GetOrCreateResource<wdMaterialResource>(szName, std::move(desc), szName);
+  }
+
+  void ExpectStateBlockStatistics(wdRenderContext* pContext, wdUInt32 uiHits, wdUInt32 uiMisses, wdUInt32 uiSkipped)
+  {
+    const wdRenderContext::Statistics stats = pContext->GetAndResetStatistics();
+
+    WD_TEST_INT(stats.m_uiStateBlockHits, uiHits);
+    WD_TEST_INT(stats.m_uiStateBlockMisses, uiMisses);
+    WD_TEST_INT(stats.m_uiSkippedStateBlocks, uiSkipped);
+    WD_TEST_INT(stats.m_uiFailedDrawcalls, 0);
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(Shader, MaterialStateBlocks)
+{
+  const wdString sPrevPlatform = wdShaderManager::GetActivePlatform();
+  const wdString sPrevCacheDirectory = wdShaderManager::GetCacheDirectory();
+  const wdString sPrevPermVarSubDirectory = wdShaderManager::GetPermutationVarSubDirectory();
+  const bool bPrevRuntimeCompilation = wdShaderManager::IsRuntimeCompilationEnabled();
+
+  wdStringBuilder sOutputDir = wdTestFramework::GetInstance()->GetAbsOutputPath();
+
+  wdStringBuilder sTestDir = sOutputDir;
+  sTestDir.AppendPath("MaterialStateBlocksTest");
+  wdOSFile::DeleteFolder(sTestDir).IgnoreResult();
+
+  if (!WD_TEST_BOOL(wdFileSystem::AddDataDirectory(sOutputDir, "MaterialStateBlocksTest", "output", wdFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  // the permutations are compiled by wdShaderCacheTestCompiler, see ShaderCache.cpp, which the null device accepts as byte code
+  wdShaderManager::Configure("SHADERCACHETEST", true, ":output/MaterialStateBlocksTest/Cache");
+
+  {
+    const char* szSource = "[PLATFORMS]\nALL\n\n[PERMUTATIONS]\n\n[RENDERSTATE]\n\n[VERTEXSHADER]\nvoid main() { }\n\n[PIXELSHADER]\nvoid main() { }\n";
+
+    wdFileWriter file;
+    if (WD_TEST_BOOL(file.Open(":output/MaterialStateBlocksTest/Test.wdShader").Succeeded()))
+    {
+      file.WriteBytes(szSource, wdStringUtils::GetStringElementCount(szSource)).IgnoreResult();
+    }
+  }
+
+  wdGALDeviceCreationDescription deviceDesc;
+  wdGALDeviceNull* pDevice = static_cast<wdGALDeviceNull*>(wdGALDeviceFactory::CreateDevice("Null", wdFoundation::GetDefaultAllocator(), deviceDesc).m_pInstance);
+
+  if (!WD_TEST_BOOL(pDevice != nullptr))
+    return;
+
+  WD_TEST_BOOL(pDevice->Init().Succeeded());
+
+  wdGALDevice::SetDefaultDevice(pDevice);
+  wdGPUResourcePool::SetDefaultInstance(WD_DEFAULT_NEW(wdGPUResourcePool));
+  wdStartup::StartupHighLevelSystems();
+
+  wdGALTextureCreationDescription textureDesc;
+  textureDesc.SetAsRenderTarget(64, 64, wdGALResourceFormat::RGBAUByteNormalized);
+  wdGALTextureHandle hTexture = pDevice->CreateTexture(textureDesc);
+
+  {
+    wdShaderResourceHandle hShader = wdResourceManager::LoadResource<wdShaderResource>("MaterialStateBlocksTest/Test.wdShader");
+    wdMaterialResourceHandle hMaterialA = CreateStateBlockTestMaterial("MaterialStateBlocksTestA", hShader);
+    wdMaterialResourceHandle hMaterialB = CreateStateBlockTestMaterial("MaterialStateBlocksTestB", hShader);
+
+    wdRenderContext* pContext = wdRenderContext::CreateInstance();
+
+    pDevice->BeginFrame(1);
+    pDevice->BeginPipeline("MaterialStateBlocksTest", wdGALSwapChainHandle());
+
+    wdGALPass* pPass = pDevice->BeginPass("MaterialStateBlocksTest");
+
+    wdGALRenderingSetup renderingSetup;
+    renderingSetup.m_RenderTargetSetup.SetRenderTarget(0, pDevice->GetDefaultRenderTargetView(hTexture));
+
+    pContext->BeginRendering(pPass, renderingSetup, wdRectFloat(0.0f, 0.0f, 64.0f, 64.0f));
+    pContext->GetAndResetStatistics();
+
+    WD_TEST_BLOCK(wdTestBlock::Enabled, "Miss")
+    {
+      pContext->BindMaterial(hMaterialA);
+      WD_TEST_BOOL(pContext->ApplyContextStates().Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 0, 1, 0);
+    }
+
+    WD_TEST_BLOCK(wdTestBlock::Enabled, "Skip")
+    {
+      // nothing has been bound to the material texture slots since, so the active state block isn't applied again
+      WD_TEST_BOOL(pContext->ApplyContextStates(true).Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 0, 0, 1);
+
+      // without state changes the material isn't looked at at all
+      WD_TEST_BOOL(pContext->ApplyContextStates().Succeeded());
+
+      const wdRenderContext::Statistics stats = pContext->GetAndResetStatistics();
+      WD_TEST_INT(stats.m_uiApplyCalls, 1);
+      WD_TEST_INT(stats.m_uiStateBlockHits + stats.m_uiStateBlockMisses + stats.m_uiSkippedStateBlocks, 0);
+    }
+
+    WD_TEST_BLOCK(wdTestBlock::Enabled, "Hit")
+    {
+      pContext->BindMaterial(hMaterialB);
+      WD_TEST_BOOL(pContext->ApplyContextStates().Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 0, 1, 0);
+
+      pContext->BindMaterial(hMaterialA);
+      WD_TEST_BOOL(pContext->ApplyContextStates().Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 1, 0, 0);
+    }
+
+    WD_TEST_BLOCK(wdTestBlock::Enabled, "Reset Context State")
+    {
+      // the state blocks are kept when the pipeline resets the context at the end of a frame
+      pContext->ResetContextState();
+
+      pContext->BindMaterial(hMaterialA);
+      WD_TEST_BOOL(pContext->ApplyContextStates().Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 1, 0, 0);
+    }
+
+    WD_TEST_BLOCK(wdTestBlock::Enabled, "Material Modified")
+    {
+      {
+        wdResourceLock<wdMaterialResource> pMaterial(hMaterialA, wdResourceAcquireMode::BlockTillLoaded);
+        pMaterial->SetParameter("MaterialStateBlocksTestParameter", 1.0f);
+      }
+
+      pContext->BindMaterial(hMaterialA);
+      WD_TEST_BOOL(pContext->ApplyContextStates().Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 0, 1, 0);
+    }
+
+    WD_TEST_BLOCK(wdTestBlock::Enabled, "Shader Reloaded")
+    {
+      wdShaderPermutationResourceHandle hPermutation = wdShaderManager::PreloadSinglePermutation(hShader, wdHashTable<wdHashedString, wdHashedString>(), false);
+
+      if (WD_TEST_BOOL(hPermutation.IsValid()))
+      {
+        // a reload increases the change counter as well
+        wdResourceLock<wdShaderPermutationResource> pPermutation(hPermutation, wdResourceAcquireMode::BlockTillLoaded);
+        pPermutation->IncResourceChangeCounter();
+      }
+
+      WD_TEST_BOOL(pContext->ApplyContextStates(true).Succeeded());
+
+      ExpectStateBlockStatistics(pContext, 0, 1, 0);
+    }
+
+    pContext->EndRendering();
+
+    pDevice->EndPass(pPass);
+    pDevice->EndPipeline(wdGALSwapChainHandle());
+    pDevice->EndFrame();
+
+    wdRenderContext::DestroyInstance(pContext);
+  }
+
+  wdResourceManager::FreeAllUnusedResources();
+
+  pDevice->DestroyTexture(hTexture);
+
+  wdStartup::ShutdownHighLevelSystems();
+  wdGPUResourcePool::SetDefaultInstance(nullptr);
+  wdGALDevice::SetDefaultDevice(nullptr);
+
+  WD_TEST_BOOL(pDevice->Shutdown().Succeeded());
+  WD_DEFAULT_DELETE(pDevice);
+
+  wdShaderManager::Configure(sPrevPlatform, bPrevRuntimeCompilation, sPrevCacheDirectory, sPrevPermVarSubDirectory);
+  wdFileSystem::RemoveDataDirectoryGroup("MaterialStateBlocksTest");
+}
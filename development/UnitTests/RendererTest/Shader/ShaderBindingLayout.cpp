@@ -0,0 +1,113 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <RendererCore/Shader/ShaderBindingLayout.h>
+#include <RendererCore/Shader/ShaderStageBinary.h>
+
+namespace
+{
+  void AddTestBinding(wdShaderStageBinary& ref_binary, wdShaderResourceType::Enum type, wdInt32 iSlot, const char* szName)
+  {
+    wdShaderResourceBinding binding;
+    binding.m_Type = type;
+    binding.m_iSlot = iSlot;
+    binding.m_sName.Assign(szName);
+
+    ref_binary.AddShaderResourceBinding(binding);
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST_GROUP(Shader);
+
+WD_CREATE_SIMPLE_TEST(Shader, ShaderBindingLayout)
+{
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Slots")
+  {
+    const wdShaderBindingSlot slotA = wdShaderBindingLayout::GetSlot("ShaderBindingLayoutTest_A");
+    const wdShaderBindingSlot slotB = wdShaderBindingLayout::GetSlot("ShaderBindingLayoutTest_B");
+
+    WD_TEST_BOOL(slotA.IsValid());
+    WD_TEST_BOOL(slotB.IsValid());
+    WD_TEST_BOOL(slotA != slotB);
+    WD_TEST_BOOL(wdShaderBindingLayout::GetSlot("ShaderBindingLayoutTest_A") == slotA);
+    WD_TEST_BOOL(slotA.m_uiIndex < wdShaderBindingLayout::GetNumSlots());
+    WD_TEST_BOOL(slotB.m_uiIndex < wdShaderBindingLayout::GetNumSlots());
+
+    WD_TEST_BOOL(!wdShaderBindingSlot().IsValid());
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Build")
+  {
+    wdShaderStageBinary vertexShader;
+    AddTestBinding(vertexShader, wdShaderResourceType::ConstantBuffer, 0, "wdGlobalConstants");
+    AddTestBinding(vertexShader, wdShaderResourceType::ConstantBuffer, 1, "wdObjectConstants");
+    AddTestBinding(vertexShader, wdShaderResourceType::GenericBuffer, 0, "perInstanceData");
+    AddTestBinding(vertexShader, wdShaderResourceType::Texture2D, 0, "BaseTexture");
+    AddTestBinding(vertexShader, wdShaderResourceType::UAV, 0, "VertexShaderOutput");
+
+    wdShaderStageBinary pixelShader;
+    AddTestBinding(pixelShader, wdShaderResourceType::ConstantBuffer, 0, "wdGlobalConstants");
+    AddTestBinding(pixelShader, wdShaderResourceType::Texture2D, 0, "BaseTexture");
+    AddTestBinding(pixelShader, wdShaderResourceType::TextureCube, 1, "ReflectionTexture");
+    AddTestBinding(pixelShader, wdShaderResourceType::Sampler, 0, "BaseTexture");
+    AddTestBinding(pixelShader, wdShaderResourceType::UAV, 1, "PixelShaderOutput");
+
+    const wdShaderStageBinary* stageBinaries[wdGALShaderStage::ENUM_COUNT] = {};
+    stageBinaries[wdGALShaderStage::VertexShader] = &vertexShader;
+    stageBinaries[wdGALShaderStage::PixelShader] = &pixelShader;
+
+    wdShaderBindingLayout layout;
+    layout.Build(stageBinaries);
+
+    WD_TEST_BOOL(!layout.WasCompiledWithDebug());
+
+    // constant buffers are only listed once per GAL slot
+    auto constantBuffers = layout.GetBindings(wdShaderBindingLayout::BindingType::ConstantBuffer);
+    if (WD_TEST_INT(constantBuffers.GetCount(), 2))
+    {
+      WD_TEST_BOOL(constantBuffers[0].m_Slot == wdShaderBindingLayout::GetSlot("wdGlobalConstants"));
+      WD_TEST_INT(constantBuffers[0].m_uiGALSlot, 0);
+      WD_TEST_BOOL(constantBuffers[1].m_Slot == wdShaderBindingLayout::GetSlot("wdObjectConstants"));
+      WD_TEST_INT(constantBuffers[1].m_uiGALSlot, 1);
+    }
+
+    auto textures2D = layout.GetBindings(wdShaderBindingLayout::BindingType::Texture2D);
+    if (WD_TEST_INT(textures2D.GetCount(), 2))
+    {
+      WD_TEST_BOOL(textures2D[0].m_Slot == textures2D[1].m_Slot);
+      WD_TEST_BOOL(textures2D[0].m_Stage == wdGALShaderStage::VertexShader);
+      WD_TEST_BOOL(textures2D[1].m_Stage == wdGALShaderStage::PixelShader);
+      WD_TEST_BOOL(textures2D[0].m_sName == wdTempHashedString("BaseTexture"));
+    }
+
+    auto texturesCube = layout.GetBindings(wdShaderBindingLayout::BindingType::TextureCube);
+    if (WD_TEST_INT(texturesCube.GetCount(), 1))
+    {
+      WD_TEST_INT(texturesCube[0].m_uiGALSlot, 1);
+    }
+
+    WD_TEST_INT(layout.GetBindings(wdShaderBindingLayout::BindingType::Texture3D).GetCount(), 0);
+    WD_TEST_INT(layout.GetBindings(wdShaderBindingLayout::BindingType::Buffer).GetCount(), 1);
+
+    // textures and their samplers share the same binding slot
+    auto samplers = layout.GetBindings(wdShaderBindingLayout::BindingType::Sampler);
+    if (WD_TEST_INT(samplers.GetCount(), 1))
+    {
+      WD_TEST_BOOL(samplers[0].m_Slot == wdShaderBindingLayout::GetSlot("BaseTexture"));
+    }
+
+    // UAVs are only used in the pixel and compute shader stages
+    auto uavs = layout.GetBindings(wdShaderBindingLayout::BindingType::UAV);
+    if (WD_TEST_INT(uavs.GetCount(), 1))
+    {
+      WD_TEST_BOOL(uavs[0].m_Stage == wdGALShaderStage::PixelShader);
+      WD_TEST_INT(uavs[0].m_uiGALSlot, 1);
+    }
+
+    layout.Clear();
+
+    for (wdUInt32 type = 0; type < wdShaderBindingLayout::BindingType::ENUM_COUNT; ++type)
+    {
+      WD_TEST_INT(layout.GetBindings((wdShaderBindingLayout::BindingType::Enum)type).GetCount(), 0);
+    }
+  }
+}
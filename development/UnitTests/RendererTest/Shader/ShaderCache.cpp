@@ -0,0 +1,170 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
+#include <RendererCore/Shader/ShaderPermutationBinary.h>
+#include <RendererCore/Shader/ShaderStageBinary.h>
+#include <RendererCore/ShaderCompiler/ShaderCompiler.h>
+#include <RendererCore/ShaderCompiler/ShaderManager.h>
+
+namespace
+{
+  wdUInt32 s_uiShaderCacheTestCompiledStages = 0;
+  wdUInt32 s_uiShaderCacheTestCachedStages = 0;
+
+  void WriteShaderCacheTestShader(const char* szFile, const char* szPixelShaderBody)
+  {
+    wdStringBuilder sSource;
+    sSource.Append("[PLATFORMS]\nALL\n\n[PERMUTATIONS]\n\n[RENDERSTATE]\n\n");
+    sSource.Append("[VERTEXSHADER]\nvoid main() { }\n\n");
+    sSource.Append("[PIXELSHADER]\nvoid main() { ", szPixelShaderBody, " }\n");
+
+    wdFileWriter file;
+    if (WD_TEST_BOOL(file.Open(szFile).Succeeded()))
+    {
+      file.WriteBytes(sSource.GetData(), sSource.GetElementCount()).IgnoreResult();
+    }
+  }
+
+  void ResetShaderCacheTestCounters()
+  {
+    s_uiShaderCacheTestCompiledStages = 0;
+    s_uiShaderCacheTestCachedStages = 0;
+  }
+} // namespace
+
+/// Pretends to compile every stage by storing its preprocessed source as byte code, and counts compiled and cached stages.
+class wdShaderCacheTestCompiler : public wdShaderProgramCompiler
+{
+  WD_ADD_DYNAMIC_REFLECTION(wdShaderCacheTestCompiler, wdShaderProgramCompiler);
+
+public:
+  virtual void GetSupportedPlatforms(wdHybridArray<wdString, 4>& ref_platforms) override { ref_platforms.PushBack("SHADERCACHETEST"); }
+
+  virtual wdResult Compile(wdShaderProgramData& inout_data, wdLogInterface* pLog) override
+  {
+    for (wdUInt32 stage = 0; stage < wdGALShaderStage::ENUM_COUNT; ++stage)
+    {
+      if (inout_data.m_szShaderSource[stage] == nullptr)
+        continue;
+
+      wdDynamicArray<wdUInt8>& byteCode = inout_data.m_StageBinary[stage].GetByteCode();
+
+      // stages that were found in the shader cache already have their byte code
+      if (!byteCode.IsEmpty())
+      {
+        ++s_uiShaderCacheTestCachedStages;
+        continue;
+      }
+
+      ++s_uiShaderCacheTestCompiledStages;
+
+      const wdStringView sSource = inout_data.m_szShaderSource[stage];
+      byteCode.PushBackRange(wdMakeArrayPtr(reinterpret_cast<const wdUInt8*>(sSource.GetStartPointer()), sSource.GetElementCount()));
+    }
+
+    return WD_SUCCESS;
+  }
+};
+
+// clang-format off
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdShaderCacheTestCompiler, 1, wdRTTIDefaultAllocator<wdShaderCacheTestCompiler>)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+WD_CREATE_SIMPLE_TEST(Shader, ShaderCache)
+{
+  const wdString sPrevPlatform = wdShaderManager::GetActivePlatform();
+  const wdString sPrevCacheDirectory = wdShaderManager::GetCacheDirectory();
+  const wdString sPrevPermVarSubDirectory = wdShaderManager::GetPermutationVarSubDirectory();
+  const bool bPrevRuntimeCompilation = wdShaderManager::IsRuntimeCompilationEnabled();
+
+  wdStringBuilder sOutputDir = wdTestFramework::GetInstance()->GetAbsOutputPath();
+
+  wdStringBuilder sTestDir = sOutputDir;
+  sTestDir.AppendPath("ShaderCacheTest");
+  wdOSFile::DeleteFolder(sTestDir).IgnoreResult();
+
+  if (!WD_TEST_BOOL(wdFileSystem::AddDataDirectory(sOutputDir, "ShaderCacheTest", "output", wdFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  wdShaderManager::Configure("SHADERCACHETEST", true, ":output/ShaderCacheTest/Cache");
+
+  // the shader is looked up through the data directories, the cache paths are derived from this relative path
+  const char* szShaderFile = "ShaderCacheTest/Test.wdShader";
+  const char* szShaderOutputFile = ":output/ShaderCacheTest/Test.wdShader";
+
+  wdPermutationGenerator generator;
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Miss")
+  {
+    WriteShaderCacheTestShader(szShaderOutputFile, "");
+
+    ResetShaderCacheTestCounters();
+    WD_TEST_BOOL(wdShaderCompiler::CompileShaderPermutationsForPlatforms(szShaderFile, generator, nullptr, "SHADERCACHETEST").Succeeded());
+
+    WD_TEST_INT(s_uiShaderCacheTestCompiledStages, 2);
+    WD_TEST_INT(s_uiShaderCacheTestCachedStages, 0);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Hit")
+  {
+    ResetShaderCacheTestCounters();
+    WD_TEST_BOOL(wdShaderCompiler::CompileShaderPermutationsForPlatforms(szShaderFile, generator, nullptr, "SHADERCACHETEST").Succeeded());
+
+    WD_TEST_INT(s_uiShaderCacheTestCompiledStages, 0);
+    WD_TEST_INT(s_uiShaderCacheTestCachedStages, 2);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Changed Stage")
+  {
+    // only the pixel shader changes, the vertex shader binary is still valid
+    WriteShaderCacheTestShader(szShaderOutputFile, "return;");
+
+    ResetShaderCacheTestCounters();
+    WD_TEST_BOOL(wdShaderCompiler::CompileShaderPermutationsForPlatforms(szShaderFile, generator, nullptr, "SHADERCACHETEST").Succeeded());
+
+    WD_TEST_INT(s_uiShaderCacheTestCompiledStages, 1);
+    WD_TEST_INT(s_uiShaderCacheTestCachedStages, 1);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Verify Source Hash")
+  {
+    wdStringBuilder sPermutationFile(":output/ShaderCacheTest/Cache/SHADERCACHETEST/ShaderCacheTest/Test");
+    sPermutationFile.AppendFormat("_{0}.wdPermutation", wdArgU(wdShaderHelper::CalculateHash(wdArrayPtr<wdPermutationVar>()), 8, true, 16, true));
+
+    wdShaderPermutationBinary permutationBinary;
+    {
+      wdFileReader file;
+      WD_TEST_BOOL(file.Open(sPermutationFile).Succeeded());
+
+      bool bOldVersion = false;
+      WD_TEST_BOOL(permutationBinary.Read(file, bOldVersion).Succeeded());
+      WD_TEST_BOOL(!bOldVersion);
+    }
+
+    const wdUInt64 uiHash = permutationBinary.m_uiShaderStageHashes[wdGALShaderStage::VertexShader];
+    const wdUInt64 uiWrongHash = uiHash ^ 1;
+
+    wdShaderStageBinary* pBinary = wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::VertexShader, uiHash);
+    if (WD_TEST_BOOL(pBinary != nullptr))
+    {
+      WD_TEST_BOOL(pBinary->GetSourceHash() == uiHash);
+    }
+
+    // a cache entry whose file name does not match its content must not be used
+    wdStringBuilder sStageDir = sTestDir;
+    sStageDir.AppendPath("Cache/SHADERCACHETEST");
+
+    wdStringBuilder sStageFile, sWrongStageFile;
+    sStageFile.Format("{0}/VertexShader_{1}.wdShaderStage", sStageDir, wdArgU(uiHash, 16, true, 16, true));
+    sWrongStageFile.Format("{0}/VertexShader_{1}.wdShaderStage", sStageDir, wdArgU(uiWrongHash, 16, true, 16, true));
+
+    WD_TEST_BOOL(wdOSFile::CopyFile(sStageFile, sWrongStageFile).Succeeded());
+    WD_TEST_BOOL(wdShaderStageBinary::LoadStageBinary(wdGALShaderStage::VertexShader, uiWrongHash) == nullptr);
+  }
+
+  wdShaderManager::Configure(sPrevPlatform, bPrevRuntimeCompilation, sPrevCacheDirectory, sPrevPermVarSubDirectory);
+  wdFileSystem::RemoveDataDirectoryGroup("ShaderCacheTest");
+}
@@ -0,0 +1,346 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/World/SpatialSystem_LooseOctree.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Math/Frustum.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Time.h>
+
+// Enable when needed
+#define WD_SPATIAL_SYSTEM_PERFORMANCE_TESTS_STATE wdTestBlock::DisabledNoWarning
+
+namespace
+{
+  constexpr wdUInt32 s_uiNumSpatialQueries = 64;
+
+  struct SpatialTestObject
+  {
+    wdBoundingSphere m_Sphere;
+    wdSpatialDataHandle m_hGrid;
+    wdSpatialDataHandle m_hOctree;
+  };
+
+  // the spatial systems never dereference the object pointers, so any unique value will do
+  wdGameObject* GetFakeObject(wdUInt32 uiIndex)
+  {
+    return reinterpret_cast<wdGameObject*>(static_cast<std::uintptr_t>(uiIndex + 1) << 4);
+  }
+
+  wdUInt32 GetObjectIndex(const wdGameObject* pObject)
+  {
+    return static_cast<wdUInt32>((reinterpret_cast<std::uintptr_t>(pObject) >> 4) - 1);
+  }
+
+  wdVec3 RandomPosition(wdRandom& ref_rng, bool bClustered, float fWorldHalfSize)
+  {
+    if (!bClustered)
+    {
+      return wdVec3((float)ref_rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize), (float)ref_rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize),
+        (float)ref_rng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize));
+    }
+
+    // a few dense towns in a mostly empty landscape
+    constexpr wdUInt32 uiNumClusters = 8;
+    const wdUInt32 uiCluster = ref_rng.UIntInRange(uiNumClusters);
+
+    wdRandom clusterRng;
+    clusterRng.Initialize(uiCluster + 1);
+    const wdVec3 vClusterCenter((float)clusterRng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize),
+      (float)clusterRng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize), (float)clusterRng.DoubleMinMax(-fWorldHalfSize, fWorldHalfSize));
+
+    const float fClusterSize = fWorldHalfSize * 0.05f;
+    const wdVec3 vOffset((float)ref_rng.DoubleVarianceAroundZero(fClusterSize), (float)ref_rng.DoubleVarianceAroundZero(fClusterSize),
+      (float)ref_rng.DoubleVarianceAroundZero(fClusterSize));
+
+    return vClusterCenter + vOffset;
+  }
+
+  wdSimdBBoxSphere ToSimdBounds(const wdBoundingSphere& sphere)
+  {
+    return wdSimdConversion::ToBBoxSphere(wdBoundingBoxSphere(sphere));
+  }
+
+  void CreateObjects(wdRandom& ref_rng, bool bClustered, float fWorldHalfSize, wdUInt32 uiNumObjects, wdSpatialData::Category category,
+    wdSpatialSystem& ref_grid, wdSpatialSystem& ref_octree, wdDynamicArray<SpatialTestObject>& out_objects)
+  {
+    const wdUInt32 uiCategoryBitmask = category.GetBitmask();
+
+    out_objects.SetCount(uiNumObjects);
+    for (wdUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      SpatialTestObject& obj = out_objects[i];
+      obj.m_Sphere.SetElements(RandomPosition(ref_rng, bClustered, fWorldHalfSize), (float)ref_rng.DoubleMinMax(0.25, 8.0));
+
+      const wdSimdBBoxSphere bounds = ToSimdBounds(obj.m_Sphere);
+      obj.m_hGrid = ref_grid.CreateSpatialData(bounds, GetFakeObject(i), uiCategoryBitmask, wdTagSet());
+      obj.m_hOctree = ref_octree.CreateSpatialData(bounds, GetFakeObject(i), uiCategoryBitmask, wdTagSet());
+    }
+  }
+
+  wdFrustum RandomFrustum(wdRandom& ref_rng, float fWorldHalfSize, float fFarPlane)
+  {
+    const wdVec3 vPosition = RandomPosition(ref_rng, false, fWorldHalfSize);
+    wdVec3 vForward((float)ref_rng.DoubleMinMax(-1.0, 1.0), (float)ref_rng.DoubleMinMax(-1.0, 1.0), (float)ref_rng.DoubleMinMax(-0.2, 0.2));
+    vForward.NormalizeIfNotZero(wdVec3(1, 0, 0)).IgnoreResult();
+
+    wdFrustum frustum;
+    frustum.SetFrustum(vPosition, vForward, wdVec3(0, 0, 1), wdAngle::Degree(90.0f), wdAngle::Degree(60.0f), 0.1f, fFarPlane);
+    return frustum;
+  }
+
+  template <typename Shape>
+  void FindObjects(const wdSpatialSystem& system, const Shape& shape, const wdSpatialSystem::QueryParams& queryParams, wdDynamicArray<wdUInt32>& out_indices)
+  {
+    wdDynamicArray<wdGameObject*> objects;
+    if constexpr (std::is_same_v<Shape, wdBoundingSphere>)
+    {
+      system.FindObjectsInSphere(shape, queryParams, objects);
+    }
+    else
+    {
+      system.FindObjectsInBox(shape, queryParams, objects);
+    }
+
+    out_indices.Clear();
+    for (const wdGameObject* pObject : objects)
+    {
+      out_indices.PushBack(GetObjectIndex(pObject));
+    }
+    out_indices.Sort();
+  }
+
+  void FindVisibleObjects(const wdSpatialSystem& system, const wdFrustum& frustum, const wdSpatialSystem::QueryParams& queryParams, wdDynamicArray<wdUInt32>& out_indices)
+  {
+    wdDynamicArray<const wdGameObject*> objects;
+    system.FindVisibleObjects(frustum, queryParams, objects, {}, wdVisibilityState::Direct);
+
+    out_indices.Clear();
+    for (const wdGameObject* pObject : objects)
+    {
+      out_indices.PushBack(GetObjectIndex(pObject));
+    }
+    out_indices.Sort();
+  }
+
+  template <typename Shape>
+  void FindObjectsBruteForce(const wdDynamicArray<SpatialTestObject>& objects, const Shape& shape, wdDynamicArray<wdUInt32>& out_indices)
+  {
+    out_indices.Clear();
+    for (wdUInt32 i = 0; i < objects.GetCount(); ++i)
+    {
+      if (!objects[i].m_hOctree.IsInvalidated() && shape.Overlaps(objects[i].m_Sphere))
+      {
+        out_indices.PushBack(i);
+      }
+    }
+  }
+
+  void CompareQueries(wdRandom& ref_rng, float fWorldHalfSize, const wdSpatialSystem& grid, const wdSpatialSystem& octree,
+    const wdDynamicArray<SpatialTestObject>& objects, const wdSpatialSystem::QueryParams& queryParams)
+  {
+    wdDynamicArray<wdUInt32> expected;
+    wdDynamicArray<wdUInt32> gridResult;
+    wdDynamicArray<wdUInt32> octreeResult;
+
+    for (wdUInt32 i = 0; i < s_uiNumSpatialQueries; ++i)
+    {
+      const wdBoundingSphere sphere(RandomPosition(ref_rng, false, fWorldHalfSize), (float)ref_rng.DoubleMinMax(1.0, fWorldHalfSize * 0.25));
+
+      FindObjectsBruteForce(objects, sphere, expected);
+      FindObjects(grid, sphere, queryParams, gridResult);
+      FindObjects(octree, sphere, queryParams, octreeResult);
+
+      WD_TEST_BOOL(gridResult == expected);
+      WD_TEST_BOOL(octreeResult == expected);
+    }
+
+    for (wdUInt32 i = 0; i < s_uiNumSpatialQueries; ++i)
+    {
+      const wdVec3 vCenter = RandomPosition(ref_rng, false, fWorldHalfSize);
+      const wdVec3 vHalfExtents((float)ref_rng.DoubleMinMax(1.0, fWorldHalfSize * 0.25), (float)ref_rng.DoubleMinMax(1.0, fWorldHalfSize * 0.25),
+        (float)ref_rng.DoubleMinMax(1.0, fWorldHalfSize * 0.25));
+      const wdBoundingBox box(vCenter - vHalfExtents, vCenter + vHalfExtents);
+
+      FindObjectsBruteForce(objects, box, expected);
+      FindObjects(grid, box, queryParams, gridResult);
+      FindObjects(octree, box, queryParams, octreeResult);
+
+      WD_TEST_BOOL(gridResult == expected);
+      WD_TEST_BOOL(octreeResult == expected);
+    }
+
+    for (wdUInt32 i = 0; i < s_uiNumSpatialQueries; ++i)
+    {
+      // both systems use the same culling code per object, so the results have to be identical
+      const wdFrustum frustum = RandomFrustum(ref_rng, fWorldHalfSize, fWorldHalfSize);
+
+      FindVisibleObjects(grid, frustum, queryParams, gridResult);
+      FindVisibleObjects(octree, frustum, queryParams, octreeResult);
+
+      WD_TEST_BOOL(octreeResult == gridResult);
+    }
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST_GROUP(SpatialSystem);
+
+WD_CREATE_SIMPLE_TEST(SpatialSystem, LooseOctree)
+{
+  constexpr float fWorldHalfSize = 1000.0f;
+  constexpr wdUInt32 uiNumObjects = 4096;
+
+  const wdSpatialData::Category category = wdSpatialData::RegisterCategory("SpatialSystemTest", wdSpatialData::Flags::None);
+
+  wdSpatialSystem::QueryParams queryParams;
+  queryParams.m_uiCategoryBitmask = category.GetBitmask();
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Split")
+  {
+    constexpr wdUInt32 uiSplitThreshold = 4;
+
+    wdSpatialSystem_LooseOctree octree(1024.0f, 1.0f, uiSplitThreshold);
+    wdSpatialSystem& octreeBase = octree;
+
+    wdDynamicArray<wdSpatialDataHandle> handles;
+    for (wdUInt32 i = 0; i <= uiSplitThreshold; ++i)
+    {
+      const wdBoundingSphere sphere(wdVec3(100.0f + i * 0.1f, 100.0f, 100.0f), 0.25f);
+      handles.PushBack(octreeBase.CreateSpatialData(ToSimdBounds(sphere), GetFakeObject(i), category.GetBitmask(), wdTagSet()));
+    }
+
+    // the objects that were added before the root node went over the threshold are moved down as well
+    wdBoundingBox firstNodeBox;
+    wdBoundingBox lastNodeBox;
+    WD_TEST_BOOL(octree.GetNodeBoxForSpatialData(handles[0], firstNodeBox).Succeeded());
+    WD_TEST_BOOL(octree.GetNodeBoxForSpatialData(handles.PeekBack(), lastNodeBox).Succeeded());
+
+    WD_TEST_BOOL(firstNodeBox.IsEqual(lastNodeBox));
+    WD_TEST_FLOAT(firstNodeBox.GetHalfExtents().x, 1.0f, 0.0001f);
+
+    wdDynamicArray<wdUInt32> found;
+    FindObjects(octreeBase, wdBoundingSphere(wdVec3(100.0f, 100.0f, 100.0f), 1.0f), queryParams, found);
+    WD_TEST_INT(found.GetCount(), uiSplitThreshold + 1);
+  }
+
+  for (bool bClustered : {false, true})
+  {
+    WD_TEST_BLOCK(wdTestBlock::Enabled, bClustered ? "Clustered" : "Uniform")
+    {
+      wdRandom rng;
+      rng.Initialize(bClustered ? 7 : 42);
+
+      // a small world size for the octree, so that some objects end up outside of the root node
+      wdSpatialSystem_RegularGrid grid(64);
+      wdSpatialSystem_LooseOctree octree(fWorldHalfSize * 1.5f, 8.0f, 16);
+
+      wdDynamicArray<SpatialTestObject> objects;
+      CreateObjects(rng, bClustered, fWorldHalfSize, uiNumObjects, category, grid, octree, objects);
+
+      CompareQueries(rng, fWorldHalfSize, grid, octree, objects, queryParams);
+
+      // move some objects around, some of them only a little so that they can stay in their node
+      for (wdUInt32 i = 0; i < uiNumObjects; i += 3)
+      {
+        SpatialTestObject& obj = objects[i];
+        if (i % 2 == 0)
+        {
+          obj.m_Sphere.m_vCenter += wdVec3((float)rng.DoubleVarianceAroundZero(1.0), (float)rng.DoubleVarianceAroundZero(1.0), 0.0f);
+        }
+        else
+        {
+          obj.m_Sphere.m_vCenter = RandomPosition(rng, bClustered, fWorldHalfSize);
+        }
+
+        const wdSimdBBoxSphere bounds = ToSimdBounds(obj.m_Sphere);
+        static_cast<wdSpatialSystem&>(grid).UpdateSpatialDataBounds(obj.m_hGrid, bounds);
+        static_cast<wdSpatialSystem&>(octree).UpdateSpatialDataBounds(obj.m_hOctree, bounds);
+      }
+
+      // and delete some, which also removes empty nodes again
+      for (wdUInt32 i = 0; i < uiNumObjects; i += 4)
+      {
+        SpatialTestObject& obj = objects[i];
+        static_cast<wdSpatialSystem&>(grid).DeleteSpatialData(obj.m_hGrid);
+        static_cast<wdSpatialSystem&>(octree).DeleteSpatialData(obj.m_hOctree);
+        obj.m_hGrid.Invalidate();
+        obj.m_hOctree.Invalidate();
+      }
+
+      CompareQueries(rng, fWorldHalfSize, grid, octree, objects, queryParams);
+
+      // the visibility is tracked per object
+      const wdSpatialSystem& octreeBase = octree;
+      octree.StartNewFrame();
+
+      wdDynamicArray<wdUInt32> visible;
+      FindVisibleObjects(octreeBase, RandomFrustum(rng, fWorldHalfSize, fWorldHalfSize), queryParams, visible);
+
+      for (wdUInt32 i = 0; i < uiNumObjects; ++i)
+      {
+        if (objects[i].m_hOctree.IsInvalidated())
+          continue;
+
+        const wdVisibilityState expectedState = visible.Contains(i) ? wdVisibilityState::Direct : wdVisibilityState::Invisible;
+        WD_TEST_BOOL(octreeBase.GetVisibilityState(objects[i].m_hOctree, 0) == expectedState);
+      }
+    }
+  }
+}
+
+WD_CREATE_SIMPLE_TEST(SpatialSystem, Performance)
+{
+  constexpr float fWorldHalfSize = 8000.0f;
+  constexpr wdUInt32 uiNumObjects = 1024 * 128;
+  constexpr wdUInt32 uiNumQueries = 256;
+
+  const wdSpatialData::Category category = wdSpatialData::RegisterCategory("SpatialSystemTest", wdSpatialData::Flags::None);
+
+  wdSpatialSystem::QueryParams queryParams;
+  queryParams.m_uiCategoryBitmask = category.GetBitmask();
+
+  for (bool bClustered : {false, true})
+  {
+    WD_TEST_BLOCK(WD_SPATIAL_SYSTEM_PERFORMANCE_TESTS_STATE, bClustered ? "Clustered" : "Uniform")
+    {
+      wdRandom rng;
+      rng.Initialize(1234);
+
+      wdSpatialSystem_RegularGrid grid;
+      wdSpatialSystem_LooseOctree octree;
+
+      wdDynamicArray<SpatialTestObject> objects;
+      CreateObjects(rng, bClustered, fWorldHalfSize, uiNumObjects, category, grid, octree, objects);
+
+      wdDynamicArray<wdFrustum> frustums;
+      for (wdUInt32 i = 0; i < uiNumQueries; ++i)
+      {
+        frustums.PushBack(RandomFrustum(rng, fWorldHalfSize, 2000.0f));
+      }
+
+      const wdSpatialSystem* systems[] = {&grid, &octree};
+      const char* szNames[] = {"Regular Grid", "Loose Octree"};
+
+      for (wdUInt32 s = 0; s < WD_ARRAY_SIZE(systems); ++s)
+      {
+        wdDynamicArray<const wdGameObject*> visibleObjects;
+        wdUInt32 uiNumVisible = 0;
+
+        const wdTime tStart = wdTime::Now();
+
+        for (const wdFrustum& frustum : frustums)
+        {
+          visibleObjects.Clear();
+          systems[s]->FindVisibleObjects(frustum, queryParams, visibleObjects, {}, wdVisibilityState::Direct);
+          uiNumVisible += visibleObjects.GetCount();
+        }
+
+        const wdTime tDiff = wdTime::Now() - tStart;
+
+        wdLog::Info("[test]{0} ({1}), {2} objects: {3}ms per frustum query ({4} visible on average)", szNames[s], bClustered ? "clustered" : "uniform",
+          uiNumObjects, wdArgF(tDiff.GetMilliseconds() / uiNumQueries, 3), uiNumVisible / uiNumQueries);
+      }
+    }
+  }
+}
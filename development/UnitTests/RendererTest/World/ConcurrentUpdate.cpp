@@ -0,0 +1,235 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Threading/Mutex.h>
+
+WD_CREATE_SIMPLE_TEST_GROUP(World);
+
+namespace
+{
+  enum ConcurrentUpdateFunction
+  {
+    MultiplyValue,
+    AddToValue,
+    ReadValue,
+    WriteOtherValue,
+    DependsOnOtherValue,
+    WriteTransforms,
+    ReadTransforms,
+    NumConcurrentUpdateFunctions
+  };
+
+  bool s_bRegisterConcurrently = true;
+} // namespace
+
+class wdConcurrentUpdateTestModule : public wdWorldModule
+{
+  WD_DECLARE_WORLD_MODULE();
+  WD_ADD_DYNAMIC_REFLECTION(wdConcurrentUpdateTestModule, wdWorldModule);
+
+public:
+  wdConcurrentUpdateTestModule(wdWorld* pWorld)
+    : wdWorldModule(pWorld)
+  {
+  }
+
+  virtual void Initialize() override
+  {
+    SUPER::Initialize();
+
+    // registered in order of decreasing priority, which is the regular execution order
+    float fPriority = 100.0f;
+    auto Register = [&](UpdateFunctionDesc desc, wdBitflags<wdUpdateFunctionDataAccess> dataAccess, const wdRTTI* pReadType, const wdRTTI* pWriteType)
+    {
+      desc.m_Phase = UpdateFunctionDesc::Phase::PreAsync;
+      desc.m_fPriority = fPriority;
+      desc.m_bCanRunConcurrently = s_bRegisterConcurrently;
+      desc.m_DataAccess = dataAccess;
+
+      if (pReadType != nullptr)
+        desc.m_ReadComponentTypes.PushBack(pReadType);
+      if (pWriteType != nullptr)
+        desc.m_WriteComponentTypes.PushBack(pWriteType);
+
+      fPriority -= 1.0f;
+      return desc;
+    };
+
+    const wdRTTI* pValueType = wdGetStaticRTTI<wdVec3>();
+    const wdRTTI* pOtherValueType = wdGetStaticRTTI<wdQuat>();
+
+    RegisterUpdateFunction(Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::MultiplyValueFunc, this), {}, nullptr, pValueType));
+    RegisterUpdateFunction(Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::AddToValueFunc, this), {}, nullptr, pValueType));
+    RegisterUpdateFunction(Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::ReadValueFunc, this), {}, pValueType, nullptr));
+    RegisterUpdateFunction(Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::WriteOtherValueFunc, this), {}, nullptr, pOtherValueType));
+
+    {
+      // no declared data access at all, only an explicit dependency
+      UpdateFunctionDesc desc = Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::DependsOnOtherValueFunc, this), {}, nullptr, nullptr);
+      desc.m_DependsOn.PushBack(wdMakeHashedString("wdConcurrentUpdateTestModule::WriteOtherValueFunc"));
+      RegisterUpdateFunction(desc);
+    }
+
+    RegisterUpdateFunction(Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::WriteTransformsFunc, this), wdUpdateFunctionDataAccess::WriteTransforms, nullptr, nullptr));
+    RegisterUpdateFunction(Register(WD_CREATE_MODULE_UPDATE_FUNCTION_DESC(wdConcurrentUpdateTestModule::ReadTransformsFunc, this), wdUpdateFunctionDataAccess::ReadTransforms, nullptr, nullptr));
+  }
+
+  void BeginFrame()
+  {
+    m_iNextSequenceNumber = 0;
+    m_ExecutionOrder.Clear();
+  }
+
+  wdUInt64 m_uiValue = 1;
+  wdUInt64 m_uiValueSeenByReader = 0;
+  wdUInt64 m_uiOtherValue = 0;
+  wdUInt64 m_uiOtherValueSeenByDependent = 0;
+
+  wdInt32 m_SequenceNumbers[NumConcurrentUpdateFunctions] = {};
+  wdHybridArray<wdUInt32, NumConcurrentUpdateFunctions> m_ExecutionOrder;
+
+private:
+  void Record(ConcurrentUpdateFunction function)
+  {
+    m_SequenceNumbers[function] = m_iNextSequenceNumber.PostIncrement();
+
+    WD_LOCK(m_Mutex);
+    m_ExecutionOrder.PushBack(function);
+  }
+
+  void MultiplyValueFunc(const UpdateContext&)
+  {
+    // give the functions that don't conflict a chance to overtake this one
+    wdThreadUtils::Sleep(wdTime::Milliseconds(1));
+    m_uiValue *= 3;
+    Record(MultiplyValue);
+  }
+
+  void AddToValueFunc(const UpdateContext&)
+  {
+    m_uiValue += 7;
+    Record(AddToValue);
+  }
+
+  void ReadValueFunc(const UpdateContext&)
+  {
+    m_uiValueSeenByReader = m_uiValue;
+    Record(ReadValue);
+  }
+
+  void WriteOtherValueFunc(const UpdateContext&)
+  {
+    wdThreadUtils::Sleep(wdTime::Milliseconds(1));
+    ++m_uiOtherValue;
+    Record(WriteOtherValue);
+  }
+
+  void DependsOnOtherValueFunc(const UpdateContext&)
+  {
+    m_uiOtherValueSeenByDependent = m_uiOtherValue;
+    Record(DependsOnOtherValue);
+  }
+
+  void WriteTransformsFunc(const UpdateContext&)
+  {
+    wdThreadUtils::Sleep(wdTime::Milliseconds(1));
+    Record(WriteTransforms);
+  }
+
+  void ReadTransformsFunc(const UpdateContext&) { Record(ReadTransforms); }
+
+  wdAtomicInteger32 m_iNextSequenceNumber;
+  wdMutex m_Mutex;
+};
+
+// clang-format off
+WD_IMPLEMENT_WORLD_MODULE(wdConcurrentUpdateTestModule);
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdConcurrentUpdateTestModule, 1, wdRTTINoAllocator)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+WD_CREATE_SIMPLE_TEST(World, ConcurrentUpdate)
+{
+  constexpr wdUInt32 uiNumFrames = 16;
+
+  wdUInt64 serialValues[uiNumFrames] = {};
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Serial")
+  {
+    s_bRegisterConcurrently = false;
+
+    wdWorldDesc worldDesc("ConcurrentUpdateTest");
+    wdWorld world(worldDesc);
+    WD_LOCK(world.GetWriteMarker());
+
+    wdConcurrentUpdateTestModule* pModule = world.GetOrCreateModule<wdConcurrentUpdateTestModule>();
+
+    for (wdUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      pModule->BeginFrame();
+      world.Update();
+
+      // without concurrency, everything runs in priority order
+      WD_TEST_INT(pModule->m_ExecutionOrder.GetCount(), NumConcurrentUpdateFunctions);
+      for (wdUInt32 i = 0; i < pModule->m_ExecutionOrder.GetCount(); ++i)
+      {
+        WD_TEST_INT(pModule->m_ExecutionOrder[i], i);
+      }
+
+      serialValues[uiFrame] = pModule->m_uiValueSeenByReader;
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Conflicting Writes")
+  {
+    s_bRegisterConcurrently = true;
+
+    wdWorldDesc worldDesc("ConcurrentUpdateTest");
+    wdWorld world(worldDesc);
+    WD_LOCK(world.GetWriteMarker());
+
+    wdConcurrentUpdateTestModule* pModule = world.GetOrCreateModule<wdConcurrentUpdateTestModule>();
+
+    for (wdUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      pModule->BeginFrame();
+      world.Update();
+
+      WD_TEST_INT(pModule->m_ExecutionOrder.GetCount(), NumConcurrentUpdateFunctions);
+
+      const wdInt32* pSequence = pModule->m_SequenceNumbers;
+
+      // functions that write the same data, or read what another one writes, keep their regular order
+      WD_TEST_BOOL(pSequence[MultiplyValue] < pSequence[AddToValue]);
+      WD_TEST_BOOL(pSequence[AddToValue] < pSequence[ReadValue]);
+      WD_TEST_BOOL(pSequence[WriteTransforms] < pSequence[ReadTransforms]);
+
+      // explicit dependencies are kept as well
+      WD_TEST_BOOL(pSequence[WriteOtherValue] < pSequence[DependsOnOtherValue]);
+      WD_TEST_INT(pModule->m_uiOtherValueSeenByDependent, uiFrame + 1);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Deterministic Results")
+  {
+    s_bRegisterConcurrently = true;
+
+    // the order of unrelated functions may differ from run to run, but the results must always be the same as in the serial run
+    for (wdUInt32 uiRun = 0; uiRun < 4; ++uiRun)
+    {
+      wdWorldDesc worldDesc("ConcurrentUpdateTest");
+      wdWorld world(worldDesc);
+      WD_LOCK(world.GetWriteMarker());
+
+      wdConcurrentUpdateTestModule* pModule = world.GetOrCreateModule<wdConcurrentUpdateTestModule>();
+
+      for (wdUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        pModule->BeginFrame();
+        world.Update();
+
+        WD_TEST_INT(pModule->m_uiValueSeenByReader, serialValues[uiFrame]);
+      }
+    }
+  }
+}
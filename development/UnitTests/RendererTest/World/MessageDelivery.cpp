@@ -0,0 +1,364 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/Thread.h>
+
+struct wdMsgDeliveryTest : public wdMessage
+{
+  WD_DECLARE_MESSAGE_TYPE(wdMsgDeliveryTest, wdMessage);
+
+  virtual wdInt32 GetSortingKey() const override { return m_iSortingKey; }
+
+  wdInt32 m_iSortingKey = 0;
+  wdUInt32 m_uiRemainingReposts = 0;
+};
+
+// clang-format off
+WD_IMPLEMENT_MESSAGE_TYPE(wdMsgDeliveryTest);
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdMsgDeliveryTest, 1, wdRTTIDefaultAllocator<wdMsgDeliveryTest>)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+struct wdMsgDeliveryTestOther : public wdMessage
+{
+  WD_DECLARE_MESSAGE_TYPE(wdMsgDeliveryTestOther, wdMessage);
+};
+
+// clang-format off
+WD_IMPLEMENT_MESSAGE_TYPE(wdMsgDeliveryTestOther);
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdMsgDeliveryTestOther, 1, wdRTTIDefaultAllocator<wdMsgDeliveryTestOther>)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+struct wdMsgDeliveryTestParallel : public wdMessage
+{
+  WD_DECLARE_MESSAGE_TYPE(wdMsgDeliveryTestParallel, wdMessage);
+
+  virtual bool CanBeDeliveredInParallel() const override { return true; }
+
+  wdUInt32 m_uiValue = 0;
+  bool m_bPostFollowUp = false;
+};
+
+// clang-format off
+WD_IMPLEMENT_MESSAGE_TYPE(wdMsgDeliveryTestParallel);
+WD_BEGIN_DYNAMIC_REFLECTED_TYPE(wdMsgDeliveryTestParallel, 1, wdRTTIDefaultAllocator<wdMsgDeliveryTestParallel>)
+WD_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  struct DeliveredMessage
+  {
+    WD_DECLARE_POD_TYPE();
+
+    wdInt32 m_iSortingKey;
+    wdUInt32 m_uiReceiverIndex;
+    bool m_bOtherType;
+  };
+
+  wdMutex s_DeliveredMessagesMutex;
+  wdDynamicArray<DeliveredMessage> s_DeliveredMessages;
+} // namespace
+
+using wdMessageDeliveryTestComponentManager = wdComponentManager<class wdMessageDeliveryTestComponent, wdBlockStorageType::Compact>;
+
+class wdMessageDeliveryTestComponent : public wdComponent
+{
+  WD_DECLARE_COMPONENT_TYPE(wdMessageDeliveryTestComponent, wdComponent, wdMessageDeliveryTestComponentManager);
+
+public:
+  wdUInt32 m_uiReceiverIndex = 0;
+  wdUInt32 m_uiNumParallelMessages = 0;
+  wdUInt32 m_uiParallelValueSum = 0;
+
+protected:
+  void OnMsgDeliveryTest(wdMsgDeliveryTest& ref_msg)
+  {
+    {
+      WD_LOCK(s_DeliveredMessagesMutex);
+      s_DeliveredMessages.PushBack({ref_msg.m_iSortingKey, m_uiReceiverIndex, false});
+    }
+
+    if (ref_msg.m_uiRemainingReposts > 0)
+    {
+      wdMsgDeliveryTest msg;
+      msg.m_iSortingKey = ref_msg.m_iSortingKey;
+      msg.m_uiRemainingReposts = ref_msg.m_uiRemainingReposts - 1;
+      GetWorld()->PostMessage(GetHandle(), msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+    }
+  }
+
+  void OnMsgDeliveryTestOther(wdMsgDeliveryTestOther& ref_msg)
+  {
+    WD_LOCK(s_DeliveredMessagesMutex);
+    s_DeliveredMessages.PushBack({ref_msg.GetSortingKey(), m_uiReceiverIndex, true});
+  }
+
+  void OnMsgDeliveryTestParallel(wdMsgDeliveryTestParallel& ref_msg)
+  {
+    // not synchronized, all messages to the same receiver must be delivered by the same thread
+    ++m_uiNumParallelMessages;
+    m_uiParallelValueSum += ref_msg.m_uiValue;
+
+    if (ref_msg.m_bPostFollowUp)
+    {
+      wdMsgDeliveryTest msg;
+      GetWorld()->PostMessage(GetHandle(), msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+    }
+  }
+};
+
+// clang-format off
+WD_BEGIN_COMPONENT_TYPE(wdMessageDeliveryTestComponent, 1, wdComponentMode::Static)
+{
+  WD_BEGIN_MESSAGEHANDLERS
+  {
+    WD_MESSAGE_HANDLER(wdMsgDeliveryTest, OnMsgDeliveryTest),
+    WD_MESSAGE_HANDLER(wdMsgDeliveryTestOther, OnMsgDeliveryTestOther),
+    WD_MESSAGE_HANDLER(wdMsgDeliveryTestParallel, OnMsgDeliveryTestParallel),
+  }
+  WD_END_MESSAGEHANDLERS;
+}
+WD_END_COMPONENT_TYPE
+// clang-format on
+
+namespace
+{
+  class MessageDeliveryTestThread : public wdThread
+  {
+  public:
+    MessageDeliveryTestThread(const wdWorld* pWorld, wdArrayPtr<const wdComponentHandle> receivers, wdAtomicInteger32* pNumThreadsDone, wdInt32 iNumThreads)
+      : wdThread("MessageDeliveryTest")
+      , m_pWorld(pWorld)
+      , m_Receivers(receivers)
+      , m_pNumThreadsDone(pNumThreadsDone)
+      , m_iNumThreads(iNumThreads)
+    {
+    }
+
+  private:
+    virtual wdUInt32 Run() override
+    {
+      for (wdUInt32 i = 0; i < m_Receivers.GetCount(); ++i)
+      {
+        wdMsgDeliveryTest msg;
+        msg.m_iSortingKey = static_cast<wdInt32>(i % 3);
+        m_pWorld->PostMessage(m_Receivers[i], msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+      }
+
+      // stay alive until all threads have posted, so that they all need a post buffer at the same time
+      m_pNumThreadsDone->Increment();
+      while (*m_pNumThreadsDone < m_iNumThreads)
+      {
+        wdThreadUtils::YieldTimeSlice();
+      }
+
+      return 0;
+    }
+
+    const wdWorld* m_pWorld;
+    wdArrayPtr<const wdComponentHandle> m_Receivers;
+    wdAtomicInteger32* m_pNumThreadsDone;
+    wdInt32 m_iNumThreads;
+  };
+
+  void CreateMessageDeliveryTestComponents(wdWorld& ref_world, wdUInt32 uiNumComponents, wdDynamicArray<wdComponentHandle>& out_components)
+  {
+    for (wdUInt32 i = 0; i < uiNumComponents; ++i)
+    {
+      wdGameObjectDesc desc;
+      wdGameObject* pObject = nullptr;
+      ref_world.CreateObject(desc, pObject);
+
+      wdMessageDeliveryTestComponent* pComponent = nullptr;
+      out_components.PushBack(wdMessageDeliveryTestComponent::CreateComponent(pObject, pComponent));
+      pComponent->m_uiReceiverIndex = i;
+    }
+
+    // initializes the components, messages to uninitialized components are discarded
+    ref_world.Update();
+  }
+
+  bool IsDeliveredInOrder(wdArrayPtr<const DeliveredMessage> messages)
+  {
+    for (wdUInt32 i = 1; i < messages.GetCount(); ++i)
+    {
+      const DeliveredMessage& prev = messages[i - 1];
+      const DeliveredMessage& cur = messages[i];
+
+      // components of one type are ordered by their index, which follows the creation order here
+      if (prev.m_iSortingKey > cur.m_iSortingKey || (prev.m_iSortingKey == cur.m_iSortingKey && prev.m_uiReceiverIndex > cur.m_uiReceiverIndex))
+        return false;
+    }
+
+    return true;
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(World, MessageDelivery)
+{
+  wdWorldDesc worldDesc("MessageDeliveryTest");
+  wdWorld world(worldDesc);
+  WD_LOCK(world.GetWriteMarker());
+
+  wdDynamicArray<wdComponentHandle> components;
+  CreateMessageDeliveryTestComponents(world, 128, components);
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Sorted Delivery")
+  {
+    s_DeliveredMessages.Clear();
+
+    // posted in reverse order of receivers and sorting keys
+    for (wdUInt32 i = components.GetCount(); i-- > 0;)
+    {
+      for (wdInt32 iKey = 3; iKey >= -3; --iKey)
+      {
+        wdMsgDeliveryTest msg;
+        msg.m_iSortingKey = iKey;
+        world.PostMessage(components[i], msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+      }
+    }
+
+    world.Update();
+
+    WD_TEST_INT(s_DeliveredMessages.GetCount(), components.GetCount() * 7);
+    WD_TEST_BOOL(IsDeliveredInOrder(s_DeliveredMessages));
+
+    if (!s_DeliveredMessages.IsEmpty())
+    {
+      WD_TEST_INT(s_DeliveredMessages[0].m_iSortingKey, -3);
+      WD_TEST_INT(s_DeliveredMessages[0].m_uiReceiverIndex, 0);
+      WD_TEST_INT(s_DeliveredMessages.PeekBack().m_iSortingKey, 3);
+      WD_TEST_INT(s_DeliveredMessages.PeekBack().m_uiReceiverIndex, components.GetCount() - 1);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Grouped By Receiver")
+  {
+    s_DeliveredMessages.Clear();
+
+    // two message types with the same sorting key, posted type by type
+    for (const wdComponentHandle& hComponent : components)
+    {
+      wdMsgDeliveryTest msg;
+      world.PostMessage(hComponent, msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+    }
+
+    for (const wdComponentHandle& hComponent : components)
+    {
+      wdMsgDeliveryTestOther msg;
+      world.PostMessage(hComponent, msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+    }
+
+    world.Update();
+
+    WD_TEST_INT(s_DeliveredMessages.GetCount(), components.GetCount() * 2);
+    WD_TEST_BOOL(IsDeliveredInOrder(s_DeliveredMessages));
+
+    // both messages to one receiver are delivered next to each other, always in the same type order
+    for (wdUInt32 i = 0; i + 1 < s_DeliveredMessages.GetCount(); i += 2)
+    {
+      WD_TEST_INT(s_DeliveredMessages[i].m_uiReceiverIndex, i / 2);
+      WD_TEST_INT(s_DeliveredMessages[i + 1].m_uiReceiverIndex, i / 2);
+      WD_TEST_BOOL(s_DeliveredMessages[i].m_bOtherType != s_DeliveredMessages[i + 1].m_bOtherType);
+      WD_TEST_BOOL(s_DeliveredMessages[i].m_bOtherType == s_DeliveredMessages[0].m_bOtherType);
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Messages Posted During Delivery")
+  {
+    s_DeliveredMessages.Clear();
+
+    for (const wdComponentHandle& hComponent : components)
+    {
+      wdMsgDeliveryTest msg;
+      msg.m_uiRemainingReposts = 3;
+      world.PostMessage(hComponent, msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+    }
+
+    world.Update();
+
+    // the reposted messages are still delivered in the same phase
+    WD_TEST_INT(s_DeliveredMessages.GetCount(), components.GetCount() * 4);
+
+    s_DeliveredMessages.Clear();
+    world.Update();
+
+    WD_TEST_INT(s_DeliveredMessages.GetCount(), 0);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "More Posting Threads Than Buffers")
+  {
+    // more threads than there are post buffers, the remaining ones fall back to the locked message queues
+    constexpr wdUInt32 uiNumThreads = 80;
+    constexpr wdUInt32 uiMessagesPerThread = 16;
+
+    // run twice, the second time the threads take over the slots of the exited ones
+    for (wdUInt32 uiRound = 0; uiRound < 2; ++uiRound)
+    {
+      s_DeliveredMessages.Clear();
+
+      wdAtomicInteger32 iNumThreadsDone;
+      wdDynamicArray<wdUniquePtr<MessageDeliveryTestThread>> threads;
+
+      for (wdUInt32 i = 0; i < uiNumThreads; ++i)
+      {
+        const wdUInt32 uiFirstReceiver = (i * uiMessagesPerThread) % (components.GetCount() - uiMessagesPerThread);
+        threads.PushBack(WD_DEFAULT_NEW(MessageDeliveryTestThread, &world, components.GetArrayPtr().GetSubArray(uiFirstReceiver, uiMessagesPerThread), &iNumThreadsDone, uiNumThreads));
+      }
+
+      for (auto& pThread : threads)
+      {
+        pThread->Start();
+      }
+
+      for (auto& pThread : threads)
+      {
+        pThread->Join();
+      }
+
+      world.Update();
+
+      WD_TEST_INT(s_DeliveredMessages.GetCount(), uiNumThreads * uiMessagesPerThread);
+      WD_TEST_BOOL(IsDeliveredInOrder(s_DeliveredMessages));
+    }
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Parallel Delivery")
+  {
+    s_DeliveredMessages.Clear();
+
+    constexpr wdUInt32 uiMessagesPerReceiver = 8;
+
+    for (wdUInt32 uiValue = 1; uiValue <= uiMessagesPerReceiver; ++uiValue)
+    {
+      for (const wdComponentHandle& hComponent : components)
+      {
+        wdMsgDeliveryTestParallel msg;
+        msg.m_uiValue = uiValue;
+        msg.m_bPostFollowUp = (uiValue == 1);
+        world.PostMessage(hComponent, msg, wdTime::Zero(), wdObjectMsgQueueType::PostAsync);
+      }
+    }
+
+    world.Update();
+
+    for (const wdComponentHandle& hComponent : components)
+    {
+      wdMessageDeliveryTestComponent* pComponent = nullptr;
+      WD_TEST_BOOL(world.TryGetComponent(hComponent, pComponent));
+
+      WD_TEST_INT(pComponent->m_uiNumParallelMessages, uiMessagesPerReceiver);
+      WD_TEST_INT(pComponent->m_uiParallelValueSum, uiMessagesPerReceiver * (uiMessagesPerReceiver + 1) / 2);
+    }
+
+    // the messages that were posted from the parallel handlers are delivered in the same phase
+    WD_TEST_INT(s_DeliveredMessages.GetCount(), components.GetCount());
+    WD_TEST_BOOL(IsDeliveredInOrder(s_DeliveredMessages));
+  }
+
+  s_DeliveredMessages.Clear();
+  s_DeliveredMessages.Compact();
+}
@@ -0,0 +1,290 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Utilities/Progress.h>
+#include <RendererCore/Lights/PointLightComponent.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererCore/Textures/TextureCubeResource.h>
+
+using wdWorldReaderTestComponentManager = wdComponentManager<class wdWorldReaderTestComponent, wdBlockStorageType::Compact>;
+
+class wdWorldReaderTestComponent : public wdComponent
+{
+  WD_DECLARE_COMPONENT_TYPE(wdWorldReaderTestComponent, wdComponent, wdWorldReaderTestComponentManager);
+
+public:
+  virtual void SerializeComponent(wdWorldWriter& inout_stream) const override
+  {
+    SUPER::SerializeComponent(inout_stream);
+    wdStreamWriter& s = inout_stream.GetStream();
+
+    s << m_uiValue;
+    s << m_sName;
+    inout_stream.WriteGameObjectHandle(m_hTarget);
+  }
+
+  virtual void DeserializeComponent(wdWorldReader& inout_stream) override
+  {
+    SUPER::DeserializeComponent(inout_stream);
+    wdStreamReader& s = inout_stream.GetStream();
+
+    s >> m_uiValue;
+    s >> m_sName;
+    m_hTarget = inout_stream.ReadGameObjectHandle();
+  }
+
+  virtual bool CanBeDeserializedInParallel() const override { return GetDynamicRTTI() == GetStaticRTTI(); }
+
+  wdUInt32 m_uiValue = 0;
+  wdString m_sName;
+  wdGameObjectHandle m_hTarget;
+};
+
+// clang-format off
+WD_BEGIN_COMPONENT_TYPE(wdWorldReaderTestComponent, 1, wdComponentMode::Static)
+WD_END_COMPONENT_TYPE
+// clang-format on
+
+using wdWorldReaderDerivedTestComponentManager = wdComponentManager<class wdWorldReaderDerivedTestComponent, wdBlockStorageType::Compact>;
+
+/// Does not opt in itself, so it has to be deserialized on the calling thread.
+class wdWorldReaderDerivedTestComponent : public wdWorldReaderTestComponent
+{
+  WD_DECLARE_COMPONENT_TYPE(wdWorldReaderDerivedTestComponent, wdWorldReaderTestComponent, wdWorldReaderDerivedTestComponentManager);
+};
+
+// clang-format off
+WD_BEGIN_COMPONENT_TYPE(wdWorldReaderDerivedTestComponent, 1, wdComponentMode::Static)
+WD_END_COMPONENT_TYPE
+// clang-format on
+
+namespace
+{
+  void CreateWorldReaderTestScene(wdWorld& ref_world, wdUInt32 uiNumObjects)
+  {
+    WD_LOCK(ref_world.GetWriteMarker());
+
+    wdDynamicArray<wdGameObjectHandle> objects;
+
+    for (wdUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      wdStringBuilder sName;
+      sName.Format("Object{0}", i);
+
+      wdGameObjectDesc desc;
+      desc.m_sName.Assign(sName);
+
+      wdGameObject* pObject = nullptr;
+      objects.PushBack(ref_world.CreateObject(desc, pObject));
+
+      wdWorldReaderTestComponent* pComponent = nullptr;
+      wdWorldReaderTestComponent::CreateComponent(pObject, pComponent);
+      pComponent->m_uiValue = i;
+      pComponent->m_sName = (i % 2) == 0 ? "Even" : "Odd"; // deduplicated strings
+      pComponent->m_hTarget = objects[i / 2];
+
+      if ((i % 4) == 0)
+      {
+        wdWorldReaderDerivedTestComponent* pDerived = nullptr;
+        wdWorldReaderDerivedTestComponent::CreateComponent(pObject, pDerived);
+        pDerived->m_uiValue = i * 3;
+        pDerived->m_sName = "Derived";
+        pDerived->m_hTarget = objects[0];
+      }
+
+      // the resources don't exist, the components are inactive so that they never get loaded
+      if ((i % 3) == 0)
+      {
+        wdStringBuilder sResource;
+
+        wdMeshComponent* pMesh = nullptr;
+        wdMeshComponent::CreateComponent(pObject, pMesh);
+        pMesh->SetActiveFlag(false);
+        pMesh->SetColor(wdColor::Red);
+
+        sResource.Format("WorldReaderTest/Mesh{0}.wdMesh", i % 5);
+        pMesh->SetMesh(wdResourceManager::LoadResource<wdMeshResource>(sResource));
+
+        sResource.Format("WorldReaderTest/Material{0}.wdMaterial", i % 7);
+        pMesh->SetMaterial(1, wdResourceManager::LoadResource<wdMaterialResource>(sResource));
+
+        wdPointLightComponent* pLight = nullptr;
+        wdPointLightComponent::CreateComponent(pObject, pLight);
+        pLight->SetActiveFlag(false);
+        pLight->SetRange(static_cast<float>(i));
+
+        sResource.Format("WorldReaderTest/Texture{0}.wdTexture", i % 2);
+        pLight->SetProjectedTexture(wdResourceManager::LoadResource<wdTextureCubeResource>(sResource));
+      }
+    }
+  }
+
+  void GetWorldReaderRenderTestResult(wdWorld& ref_world, wdStringBuilder& out_sResult)
+  {
+    WD_LOCK(ref_world.GetReadMarker());
+
+    out_sResult.Clear();
+
+    if (const auto* pManager = ref_world.GetComponentManager<wdMeshComponentManager>())
+    {
+      for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+      {
+        const wdMaterialResourceHandle hMaterial0 = it->GetMaterial(0);
+        const wdMaterialResourceHandle hMaterial1 = it->GetMaterial(1);
+
+        out_sResult.AppendFormat("{0}:{1}:{2}:{3}:{4};", it->GetOwner()->GetName(), it->GetMesh().IsValid() ? it->GetMesh().GetResourceID() : "<none>",
+          hMaterial0.IsValid() ? hMaterial0.GetResourceID() : "<none>", hMaterial1.IsValid() ? hMaterial1.GetResourceID() : "<none>", it->GetColor().r);
+      }
+    }
+
+    if (const auto* pManager = ref_world.GetComponentManager<wdPointLightComponentManager>())
+    {
+      for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+      {
+        out_sResult.AppendFormat("{0}:{1}:{2};", it->GetOwner()->GetName(), it->GetRange(), it->GetProjectedTextureFile());
+      }
+    }
+  }
+
+  template <typename ComponentType>
+  void GetWorldReaderTestResult(wdWorld& ref_world, wdStringBuilder& out_sResult)
+  {
+    WD_LOCK(ref_world.GetReadMarker());
+
+    out_sResult.Clear();
+
+    const auto* pManager = ref_world.GetComponentManager<typename ComponentType::ComponentManagerType>();
+    if (pManager == nullptr)
+      return;
+
+    for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+    {
+      const wdGameObject* pTarget = nullptr;
+      const bool bHasTarget = ref_world.TryGetObject(it->m_hTarget, pTarget);
+
+      out_sResult.AppendFormat("{0}:{1}:{2}:{3};", it->GetOwner()->GetName(), it->m_uiValue, it->m_sName, bHasTarget ? pTarget->GetName() : "<none>");
+    }
+  }
+
+  void InstantiateWorldReaderTestScene(wdWorldReader& ref_reader, wdWorld& ref_world, bool bParallel, wdTime maxStepTime, wdProgress* pProgress = nullptr)
+  {
+    wdPrefabInstantiationOptions options;
+    options.m_bParallelComponentDeserialization = bParallel;
+    options.m_MaxStepTime = maxStepTime;
+    options.m_pProgress = pProgress;
+
+    wdUniquePtr<wdWorldReader::InstantiationContextBase> pContext = ref_reader.InstantiatePrefab(ref_world, wdTransform::IdentityTransform(), options);
+
+    while (pContext != nullptr && pContext->Step() != wdWorldReader::InstantiationContextBase::StepResult::Finished)
+    {
+      // initializes the next component batch
+      WD_LOCK(ref_world.GetWriteMarker());
+      ref_world.Update();
+    }
+  }
+} // namespace
+
+WD_CREATE_SIMPLE_TEST(World, WorldReader)
+{
+  const wdUInt32 uiNumObjects = 256;
+
+  wdDefaultMemoryStreamStorage storage;
+
+  {
+    wdWorldDesc worldDesc("WorldReaderSource");
+    wdWorld world(worldDesc);
+    CreateWorldReaderTestScene(world, uiNumObjects);
+
+    WD_LOCK(world.GetReadMarker());
+
+    wdMemoryStreamWriter writer(&storage);
+    wdWorldWriter worldWriter;
+    worldWriter.WriteWorld(writer, world);
+  }
+
+  wdWorldReader reader;
+  {
+    wdMemoryStreamReader streamReader(&storage);
+    WD_TEST_BOOL(reader.ReadWorldDescription(streamReader).Succeeded());
+  }
+
+  wdStringBuilder sSerialResult, sSerialDerivedResult, sSerialRenderResult;
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Serial")
+  {
+    wdWorldDesc worldDesc("WorldReaderSerial");
+    wdWorld world(worldDesc);
+    InstantiateWorldReaderTestScene(reader, world, false, wdTime::Zero());
+
+    GetWorldReaderTestResult<wdWorldReaderTestComponent>(world, sSerialResult);
+    GetWorldReaderTestResult<wdWorldReaderDerivedTestComponent>(world, sSerialDerivedResult);
+    GetWorldReaderRenderTestResult(world, sSerialRenderResult);
+
+    WD_TEST_BOOL(sSerialResult.FindSubString("Object255:255:Odd:Object127;") != nullptr);
+    WD_TEST_BOOL(sSerialDerivedResult.FindSubString("Object4:12:Derived:Object0;") != nullptr);
+    WD_TEST_BOOL(sSerialRenderResult.FindSubString("Object9:WorldReaderTest/Mesh4.wdMesh:<none>:WorldReaderTest/Material2.wdMaterial:") != nullptr);
+    WD_TEST_BOOL(sSerialRenderResult.FindSubString(":WorldReaderTest/Texture1.wdTexture;") != nullptr);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Parallel")
+  {
+    wdWorldDesc worldDesc("WorldReaderParallel");
+    wdWorld world(worldDesc);
+    InstantiateWorldReaderTestScene(reader, world, true, wdTime::Zero());
+
+    wdStringBuilder sResult, sDerivedResult, sRenderResult;
+    GetWorldReaderTestResult<wdWorldReaderTestComponent>(world, sResult);
+    GetWorldReaderTestResult<wdWorldReaderDerivedTestComponent>(world, sDerivedResult);
+    GetWorldReaderRenderTestResult(world, sRenderResult);
+
+    WD_TEST_STRING(sResult, sSerialResult);
+    WD_TEST_STRING(sDerivedResult, sSerialDerivedResult);
+    WD_TEST_STRING(sRenderResult, sSerialRenderResult);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Parallel Time Sliced")
+  {
+    wdWorldDesc worldDesc("WorldReaderParallelTimeSliced");
+    wdWorld world(worldDesc);
+
+    // every step only deserializes a few components per type
+    InstantiateWorldReaderTestScene(reader, world, true, wdTime::Microseconds(1));
+
+    wdStringBuilder sResult, sDerivedResult, sRenderResult;
+    GetWorldReaderTestResult<wdWorldReaderTestComponent>(world, sResult);
+    GetWorldReaderTestResult<wdWorldReaderDerivedTestComponent>(world, sDerivedResult);
+    GetWorldReaderRenderTestResult(world, sRenderResult);
+
+    WD_TEST_STRING(sResult, sSerialResult);
+    WD_TEST_STRING(sDerivedResult, sSerialDerivedResult);
+    WD_TEST_STRING(sRenderResult, sSerialRenderResult);
+  }
+
+  WD_TEST_BLOCK(wdTestBlock::Enabled, "Phase Timings")
+  {
+    wdStringBuilder sFinalStepText;
+
+    wdProgress progress;
+    progress.m_Events.AddEventHandler([&](const wdProgressEvent& e) {
+      if (e.m_Type == wdProgressEvent::Type::ProgressEnded)
+      {
+        sFinalStepText = e.m_pProgressbar->GetStepDisplayText();
+      }
+    });
+
+    wdWorldDesc worldDesc("WorldReaderPhaseTimings");
+    wdWorld world(worldDesc);
+    InstantiateWorldReaderTestScene(reader, world, true, wdTime::Microseconds(1), &progress);
+
+    // the last step lists the time spent in every phase
+    WD_TEST_BOOL(sFinalStepText.StartsWith("Finished | CreateRootObjects: "));
+    WD_TEST_BOOL(sFinalStepText.FindSubString(", DeserializeComponents: ") != nullptr);
+    WD_TEST_BOOL(sFinalStepText.FindSubString(", InitComponents: ") != nullptr);
+    WD_TEST_BOOL(sFinalStepText.EndsWith(" ms"));
+  }
+
+  wdResourceManager::FreeAllUnusedResources();
+}